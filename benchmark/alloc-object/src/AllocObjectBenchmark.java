@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class AllocObjectBenchmark {
+    public void timeAllocSmallObject(int count) {
+        Object[] keep = this.keep;
+        for (int i = 0; i < count; ++i) {
+            // Store into a small array so the allocation is not optimized away
+            // while most objects still die young.
+            keep[i & 63] = new SmallObject();
+        }
+    }
+
+    public void timeAllocLargerObject(int count) {
+        Object[] keep = this.keep;
+        for (int i = 0; i < count; ++i) {
+            keep[i & 63] = new LargerObject();
+        }
+    }
+
+    public void timeAllocFinalizableObject(int count) {
+        Object[] keep = this.keep;
+        for (int i = 0; i < count; ++i) {
+            keep[i & 63] = new FinalizableObject();
+        }
+    }
+
+    public void timeAllocObjectArray(int count) {
+        Object[] keep = this.keep;
+        for (int i = 0; i < count; ++i) {
+            keep[i & 63] = new Object[8];
+        }
+    }
+
+    public void timeAllocIntArray(int count) {
+        Object[] keep = this.keep;
+        for (int i = 0; i < count; ++i) {
+            keep[i & 63] = new int[8];
+        }
+    }
+
+    Object[] keep = new Object[64];
+}
+
+class SmallObject {
+    int field0;
+}
+
+class LargerObject {
+    long field0;
+    long field1;
+    long field2;
+    long field3;
+    long field4;
+    long field5;
+    long field6;
+    long field7;
+}
+
+class FinalizableObject {
+    int field0;
+
+    protected void finalize() {}
+}
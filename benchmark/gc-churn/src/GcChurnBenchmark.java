@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Generates allocation graphs with different lifetime distributions so that
+ * collector changes can be compared with reproducible load. Pause histograms,
+ * copied bytes and throughput for a run are available from the runtime's GC
+ * performance dump (e.g. SIGQUIT or VMDebug runtime stats).
+ */
+public class GcChurnBenchmark {
+    private static final int RING_SIZE = 64 * 1024;
+    private static final int LONG_LIVED_SIZE = 16 * 1024;
+
+    public void timeShortLivedAllocation(int count) {
+        // All objects die young; measures allocation and young reclamation.
+        for (int i = 0; i < count; ++i) {
+            junk = new Node(i);
+        }
+    }
+
+    public void timeMediumLivedAllocation(int count) {
+        // Objects survive RING_SIZE further allocations before becoming
+        // garbage, so a fraction of each region is live when it is collected.
+        Node[] ring = this.ring;
+        for (int i = 0; i < count; ++i) {
+            ring[i & (RING_SIZE - 1)] = new Node(i);
+        }
+    }
+
+    public void timeMixedSizeAllocation(int count) {
+        // Cycle through size classes from 16 bytes to 4 KiB.
+        Object[] keep = this.keep;
+        for (int i = 0; i < count; ++i) {
+            keep[i & 63] = new byte[16 << (i % 9)];
+        }
+    }
+
+    public void timeLongLivedMutation(int count) {
+        // Rewrites references inside a stable old graph; measures the write
+        // barrier and remembered set / mod union table churn rather than
+        // allocation.
+        Node[] nodes = this.longLived;
+        for (int i = 0; i < count; ++i) {
+            nodes[i & (LONG_LIVED_SIZE - 1)].next = nodes[(i * 31) & (LONG_LIVED_SIZE - 1)];
+        }
+    }
+
+    public void timeAllocationWithMutation(int count) {
+        // Mixed load: fresh allocations linked into the long-lived graph.
+        Node[] nodes = this.longLived;
+        for (int i = 0; i < count; ++i) {
+            Node fresh = new Node(i);
+            fresh.next = nodes[i & (LONG_LIVED_SIZE - 1)];
+            nodes[(i * 17) & (LONG_LIVED_SIZE - 1)].next = fresh;
+        }
+    }
+
+    private static Node[] createGraph(int length) {
+        Node[] nodes = new Node[length];
+        for (int i = 0; i < length; ++i) {
+            nodes[i] = new Node(i);
+        }
+        for (int i = 0; i < length; ++i) {
+            nodes[i].next = nodes[(i + 1) % length];
+        }
+        return nodes;
+    }
+
+    Node[] ring = new Node[RING_SIZE];
+    Node[] longLived = createGraph(LONG_LIVED_SIZE);
+    Object[] keep = new Object[64];
+    Object junk;
+}
+
+class Node {
+    Node(int value) {
+        this.value = value;
+    }
+
+    Node next;
+    int value;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class MonitorBenchmark {
+    public void timeSynchronizedBlock(int count) {
+        Object lock = this.lock;
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            synchronized (lock) {
+                ++sum;
+            }
+        }
+        result = sum;
+    }
+
+    public void timeNestedSynchronizedBlock(int count) {
+        Object lock = this.lock;
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            synchronized (lock) {
+                synchronized (lock) {
+                    ++sum;
+                }
+            }
+        }
+        result = sum;
+    }
+
+    public void timeSynchronizedMethod(int count) {
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            sum += synchronizedIncrement(sum);
+        }
+        result = sum;
+    }
+
+    public void timeAlternatingLocks(int count) {
+        // Alternate between two locks so the thin lock owner check does not
+        // stay on a single hot lock word.
+        Object lock0 = this.lock;
+        Object lock1 = this.lock2;
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            synchronized ((i & 1) == 0 ? lock0 : lock1) {
+                ++sum;
+            }
+        }
+        result = sum;
+    }
+
+    private synchronized int synchronizedIncrement(int value) {
+        return value + 1;
+    }
+
+    Object lock = new Object();
+    Object lock2 = new Object();
+    int result;
+}
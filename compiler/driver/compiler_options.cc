@@ -72,6 +72,7 @@ CompilerOptions::CompilerOptions()
       init_failure_output_(nullptr),
       dump_cfg_file_name_(""),
       dump_cfg_append_(false),
+      dump_compile_profile_file_name_(""),
       force_determinism_(false),
       deduplicate_code_(true),
       count_hotness_in_compiled_code_(false),
@@ -307,6 +307,10 @@ class CompilerOptions final {
     return dump_cfg_append_;
   }
 
+  const std::string& GetDumpCompileProfileFileName() const {
+    return dump_compile_profile_file_name_;
+  }
+
   bool IsForceDeterminism() const {
     return force_determinism_;
   }
@@ -427,6 +431,10 @@ class CompilerOptions final {
   std::string dump_cfg_file_name_;
   bool dump_cfg_append_;
 
+  // File to write a machine-readable compile profile to (one JSON object per
+  // method with per-pass times and arena bytes), empty if disabled.
+  std::string dump_compile_profile_file_name_;
+
   // Whether the compiler should trade performance for determinism to guarantee exactly reproducible
   // outcomes.
   bool force_determinism_;
@@ -68,6 +68,7 @@ inline bool ReadCompilerOptions(Base& map, CompilerOptions* options, std::string
   if (map.Exists(Base::DumpCFGAppend)) {
     options->dump_cfg_append_ = true;
   }
+  map.AssignIfExists(Base::DumpCompileProfile, &options->dump_compile_profile_file_name_);
   if (map.Exists(Base::RegisterAllocationStrategy)) {
     if (!options->ParseRegisterAllocationStrategy(*map.Get(Base::DumpInitFailures), error_msg)) {
       return false;
@@ -184,6 +185,10 @@ inline void AddCompilerOptionsArgumentParserOptions(Builder& b) {
       .Define("--dump-cfg-append")
           .IntoKey(Map::DumpCFGAppend)
 
+      .Define("--dump-compile-profile=_")
+          .template WithType<std::string>()
+          .IntoKey(Map::DumpCompileProfile)
+
       .Define("--register-allocation-strategy=_")
           .template WithType<std::string>()
           .IntoKey(Map::RegisterAllocationStrategy)
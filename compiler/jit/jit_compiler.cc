@@ -70,6 +70,11 @@ void JitCompiler::ParseCompilerOptions() {
   } else {
     DCHECK_EQ(instruction_set, kRuntimeISA);
   }
+
+  // Suspend checks are implicit only on arm64; the other architectures lack the
+  // code generator and fault handler support. This matches the runtime, which
+  // only installs a SuspensionHandler on arm64.
+  compiler_options_->implicit_suspend_checks_ = (instruction_set == InstructionSet::kArm64);
   std::unique_ptr<const InstructionSetFeatures> instruction_set_features;
   for (const std::string& option : runtime->GetCompilerOptions()) {
     VLOG(compiler) << "JIT compiler option " << option;
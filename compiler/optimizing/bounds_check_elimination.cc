@@ -17,6 +17,7 @@
 #include "bounds_check_elimination.h"
 
 #include <limits>
+#include <utility>
 
 #include "base/scoped_arena_allocator.h"
 #include "base/scoped_arena_containers.h"
@@ -232,6 +233,30 @@ class ValueBound : public ValueObject {
     return bound1.IsRelatedToArrayLength() ? bound1 : bound2;
   }
 
+  // Merge two lower bounds at a control-flow join. Unlike narrowing, merging
+  // must be conservative: if the bounds are not comparable the result is Min().
+  static ValueBound MergeLowerBound(ValueBound bound1, ValueBound bound2) {
+    if (bound1.LessThanOrEqualTo(bound2)) {
+      return bound1;
+    }
+    if (bound2.LessThanOrEqualTo(bound1)) {
+      return bound2;
+    }
+    return Min();
+  }
+
+  // Merge two upper bounds at a control-flow join. Unlike narrowing, merging
+  // must be conservative: if the bounds are not comparable the result is Max().
+  static ValueBound MergeUpperBound(ValueBound bound1, ValueBound bound2) {
+    if (bound1.GreaterThanOrEqualTo(bound2)) {
+      return bound1;
+    }
+    if (bound2.GreaterThanOrEqualTo(bound1)) {
+      return bound2;
+    }
+    return Max();
+  }
+
   // Add a constant to a ValueBound.
   // `overflow` or `underflow` will return whether the resulting bound may
   // overflow or underflow an int.
@@ -517,7 +542,7 @@ class BCEVisitor : public HGraphVisitor {
                   std::less<int>(),
                   allocator_.Adapter(kArenaAllocBoundsCheckElimination)),
               allocator_.Adapter(kArenaAllocBoundsCheckElimination)),
-        first_index_bounds_check_map_(std::less<int>(),
+        first_index_bounds_check_map_(std::less<std::pair<int, int>>(),
                                       allocator_.Adapter(kArenaAllocBoundsCheckElimination)),
         early_exit_loop_(std::less<uint32_t>(),
                          allocator_.Adapter(kArenaAllocBoundsCheckElimination)),
@@ -920,12 +945,13 @@ class BCEVisitor : public HGraphVisitor {
         return;
       }
       // Otherwise, prepare dominator-based dynamic elimination.
-      if (first_index_bounds_check_map_.find(array_length->GetId()) ==
-          first_index_bounds_check_map_.end()) {
-        // Remember the first bounds check against each array_length. That bounds check
-        // instruction has an associated HEnvironment where we may add an HDeoptimize
-        // to eliminate subsequent bounds checks against the same array_length.
-        first_index_bounds_check_map_.Put(array_length->GetId(), bounds_check);
+      const std::pair<int, int> key = BoundsCheckKey(array_length, index);
+      if (first_index_bounds_check_map_.find(key) == first_index_bounds_check_map_.end()) {
+        // Remember the first bounds check against each array_length and index base. That
+        // bounds check instruction has an associated HEnvironment where we may add an
+        // HDeoptimize to eliminate subsequent bounds checks against the same array_length
+        // with indices off the same base.
+        first_index_bounds_check_map_.Put(key, bounds_check);
       }
     }
   }
@@ -991,7 +1017,90 @@ class BCEVisitor : public HGraphVisitor {
           AssignRange(phi->GetBlock(), phi, range);
         }
       }
+    } else if (!phi->IsLoopHeaderPhi() &&
+               !phi->IsCatchPhi() &&
+               (phi->GetType() == DataType::Type::kInt32)) {
+      MergeValueRangesForPhi(phi);
+    }
+  }
+
+  // Returns the bounds known for `instruction` at the end of `basic_block`,
+  // falling back to a constant or array.length+c singleton range when no
+  // range has been recorded. Returns false if nothing useful is known.
+  bool LookupBoundsForMerge(HInstruction* instruction,
+                            HBasicBlock* basic_block,
+                            /* out */ ValueBound* lower,
+                            /* out */ ValueBound* upper) {
+    ValueRange* range = LookupValueRange(instruction, basic_block);
+    if (range != nullptr && !range->IsMonotonicValueRange()) {
+      *lower = range->GetLower();
+      *upper = range->GetUpper();
+      return true;
+    }
+    bool found;
+    ValueBound bound = ValueBound::DetectValueBoundFromValue(instruction, &found);
+    if (!found) {
+      return false;
+    }
+    *lower = bound;
+    *upper = bound;
+    return true;
+  }
+
+  // For a phi at a control-flow merge, the range of the phi is the union of
+  // the ranges its inputs have along the corresponding predecessor edges.
+  // This keeps range information alive across the diamonds that inlined
+  // bodies typically create around array accesses.
+  void MergeValueRangesForPhi(HPhi* phi) {
+    HBasicBlock* block = phi->GetBlock();
+    ValueBound lower = ValueBound::Min();
+    ValueBound upper = ValueBound::Max();
+    for (size_t i = 0; i < phi->InputCount(); ++i) {
+      ValueBound input_lower = ValueBound::Min();
+      ValueBound input_upper = ValueBound::Max();
+      if (!LookupBoundsForMerge(phi->InputAt(i),
+                                block->GetPredecessors()[i],
+                                &input_lower,
+                                &input_upper)) {
+        return;
+      }
+      if (i == 0u) {
+        lower = input_lower;
+        upper = input_upper;
+      } else {
+        lower = ValueBound::MergeLowerBound(lower, input_lower);
+        upper = ValueBound::MergeUpperBound(upper, input_upper);
+      }
+    }
+    if (lower.Equals(ValueBound::Min()) && upper.Equals(ValueBound::Max())) {
+      // Nothing useful was learned.
+      return;
     }
+    AssignRange(block, phi, new (&allocator_) ValueRange(&allocator_, lower, upper));
+  }
+
+  void VisitSelect(HSelect* select) override {
+    if (select->GetType() != DataType::Type::kInt32) {
+      return;
+    }
+    // Like a merge phi, a select yields the union of the ranges of its two
+    // input values, except that both are evaluated in the select's own block.
+    HBasicBlock* block = select->GetBlock();
+    ValueBound true_lower = ValueBound::Min();
+    ValueBound true_upper = ValueBound::Max();
+    ValueBound false_lower = ValueBound::Min();
+    ValueBound false_upper = ValueBound::Max();
+    if (!LookupBoundsForMerge(select->GetTrueValue(), block, &true_lower, &true_upper) ||
+        !LookupBoundsForMerge(select->GetFalseValue(), block, &false_lower, &false_upper)) {
+      return;
+    }
+    ValueBound lower = ValueBound::MergeLowerBound(true_lower, false_lower);
+    ValueBound upper = ValueBound::MergeUpperBound(true_upper, false_upper);
+    if (lower.Equals(ValueBound::Min()) && upper.Equals(ValueBound::Max())) {
+      // Nothing useful was learned.
+      return;
+    }
+    AssignRange(block, select, new (&allocator_) ValueRange(&allocator_, lower, upper));
   }
 
   void VisitIf(HIf* instruction) override {
@@ -1260,12 +1369,18 @@ class BCEVisitor : public HGraphVisitor {
   }
 
   /** Performs dominator-based dynamic elimination on suitable set of bounds checks. */
+  // Key used to partition bounds checks for dominator-based dynamic elimination
+  // by checked array length and index base (see first_index_bounds_check_map_).
+  static std::pair<int, int> BoundsCheckKey(HInstruction* array_length, HInstruction* index) {
+    HInstruction* base = ValueBound::AsValueBound(index).GetInstruction();
+    return std::make_pair(array_length->GetId(), base == nullptr ? -1 : base->GetId());
+  }
+
   void AddCompareWithDeoptimization(HBasicBlock* block,
+                                    HBoundsCheck* bounds_check,
                                     HInstruction* array_length,
                                     HInstruction* base,
                                     int32_t min_c, int32_t max_c) {
-    HBoundsCheck* bounds_check =
-        first_index_bounds_check_map_.Get(array_length->GetId())->AsBoundsCheck();
     // Construct deoptimization on single or double bounds on range [base-min_c,base+max_c],
     // for example either for a[0]..a[3] just 3 or for a[base-1]..a[base+3] both base-1
     // and base+3, since we made the assumption any in between value may occur too.
@@ -1304,10 +1419,8 @@ class BCEVisitor : public HGraphVisitor {
         continue;  // disregard phis and constants
       }
       // Collect all bounds checks that are still there and that are related as "a[base + constant]"
-      // for a base instruction (possibly absent) and various constants. Note that no attempt
-      // is made to partition the set into matching subsets (viz. a[0], a[1] and a[base+1] and
-      // a[base+2] are considered as one set).
-      // TODO: would such a partitioning be worthwhile?
+      // for the base instruction (possibly absent) of this entry and various constants. Checks
+      // with a different base are handled by their own map entry.
       ValueBound value = ValueBound::AsValueBound(index);
       HInstruction* base = value.GetInstruction();
       int32_t min_c = base == nullptr ? 0 : value.GetConstant();
@@ -1369,7 +1482,7 @@ class BCEVisitor : public HGraphVisitor {
       if (candidates.size() >= threshold &&
           (base != nullptr || min_c >= 0) &&  // reject certain OOB
            distance <= kMaxLengthForAddingDeoptimize) {  // reject likely/certain deopt
-        AddCompareWithDeoptimization(block, array_length, base, min_c, max_c);
+        AddCompareWithDeoptimization(block, bounds_check, array_length, base, min_c, max_c);
         for (HBoundsCheck* other_bounds_check : candidates) {
           // Only replace if still in the graph. This avoids visiting the same
           // bounds check twice if it occurred multiple times in the use list.
@@ -1909,9 +2022,12 @@ class BCEVisitor : public HGraphVisitor {
   // A set of maps, one per basic block, from instruction to range.
   ScopedArenaVector<ScopedArenaSafeMap<int, ValueRange*>> maps_;
 
-  // Map an HArrayLength instruction's id to the first HBoundsCheck instruction
-  // in a block that checks an index against that HArrayLength.
-  ScopedArenaSafeMap<int, HBoundsCheck*> first_index_bounds_check_map_;
+  // Map the pair of an HArrayLength instruction's id and the id of the base of
+  // the checked index (-1 for a constant index) to the first HBoundsCheck
+  // instruction in a block that checks such an index against that HArrayLength.
+  // Keying on the base as well partitions "a[base + constant]" accesses with
+  // different bases into their own check-combining candidate sets.
+  ScopedArenaSafeMap<std::pair<int, int>, HBoundsCheck*> first_index_bounds_check_map_;
 
   // Early-exit loop bookkeeping.
   ScopedArenaSafeMap<uint32_t, bool> early_exit_loop_;
@@ -452,6 +452,33 @@ class CodeGenerator : public DeletableArenaObject<kArenaAllocCodeGenerator> {
     return InstanceOfNeedsReadBarrier(instance_of) ? kWithReadBarrier : kWithoutReadBarrier;
   }
 
+  static bool FieldLoadNeedsReadBarrier(HInstruction* load) {
+    DCHECK(load->IsInstanceFieldGet() || load->IsStaticFieldGet());
+    if (!kEmitCompilerReadBarrier || load->GetType() != DataType::Type::kReference) {
+      return false;
+    }
+    if (!kUseBakerReadBarrier) {
+      // Slow path based read barriers are emitted unconditionally after the load.
+      return true;
+    }
+    // If the loaded reference is only ever compared against null, it doesn't matter
+    // whether we compare the from-space or the to-space reference, the result is the
+    // same, so the gray-check can be elided. The reference must not be part of any
+    // environment, as environments are visible to the runtime.
+    if (load->HasEnvironmentUses()) {
+      return true;
+    }
+    for (const HUseListNode<HInstruction*>& use : load->GetUses()) {
+      HInstruction* user = use.GetUser();
+      if ((user->IsEqual() || user->IsNotEqual()) &&
+          user->InputAt(1u - use.GetIndex())->IsNullConstant()) {
+        continue;
+      }
+      return true;
+    }
+    return false;
+  }
+
   static bool IsTypeCheckSlowPathFatal(HCheckCast* check_cast) {
     switch (check_cast->GetTypeCheckKind()) {
       case TypeCheckKind::kExactCheck:
@@ -570,7 +597,7 @@ class CodeGenerator : public DeletableArenaObject<kArenaAllocCodeGenerator> {
 
   void GenerateInvokeUnresolvedRuntimeCall(HInvokeUnresolved* invoke);
 
-  void GenerateInvokePolymorphicCall(HInvokePolymorphic* invoke);
+  void GenerateInvokePolymorphicCall(HInvokePolymorphic* invoke, SlowPathCode* slow_path = nullptr);
 
   void GenerateInvokeCustomCall(HInvokeCustom* invoke);
 
@@ -1871,6 +1871,28 @@ void CodeGeneratorARM64::GenerateMemoryBarrier(MemBarrierKind kind) {
 
 void InstructionCodeGeneratorARM64::GenerateSuspendCheck(HSuspendCheck* instruction,
                                                          HBasicBlock* successor) {
+  if (codegen_->GetCompilerOptions().GetImplicitSuspendChecks()) {
+    // Load through the suspend trigger. The trigger points to itself while the
+    // thread may run and is cleared to request a suspension, making the second
+    // load fault; SuspensionHandler then diverts to art_quick_implicit_suspend,
+    // which saves everything and returns to the instruction after the load.
+    UseScratchRegisterScope temps(codegen_->GetVIXLAssembler());
+    Register temp = temps.AcquireX();
+    __ Ldr(temp,
+           MemOperand(tr, Thread::ThreadSuspendTriggerOffset<kArm64PointerSize>().SizeValue()));
+    {
+      // No pools between the faulting load and the stack map: the fault handler
+      // resumes at the next instruction and the runtime walks the stack with it.
+      ExactAssemblyScope eas(GetVIXLAssembler(), kInstructionSize, CodeBufferCheckScope::kExactSize);
+      __ ldr(temp, MemOperand(temp));
+      codegen_->RecordPcInfo(instruction, instruction->GetDexPc());
+    }
+    if (successor != nullptr) {
+      __ B(codegen_->GetLabelOf(successor));
+    }
+    return;
+  }
+
   SuspendCheckSlowPathARM64* slow_path =
       down_cast<SuspendCheckSlowPathARM64*>(instruction->GetSlowPath());
   if (slow_path == nullptr) {
@@ -1933,8 +1955,7 @@ void LocationsBuilderARM64::HandleFieldGet(HInstruction* instruction,
                                            const FieldInfo& field_info) {
   DCHECK(instruction->IsInstanceFieldGet() || instruction->IsStaticFieldGet());
 
-  bool object_field_get_with_read_barrier =
-      kEmitCompilerReadBarrier && (instruction->GetType() == DataType::Type::kReference);
+  bool object_field_get_with_read_barrier = CodeGenerator::FieldLoadNeedsReadBarrier(instruction);
   LocationSummary* locations =
       new (GetGraph()->GetAllocator()) LocationSummary(instruction,
                                                        object_field_get_with_read_barrier
@@ -1974,8 +1995,7 @@ void InstructionCodeGeneratorARM64::HandleFieldGet(HInstruction* instruction,
   DataType::Type load_type = instruction->GetType();
   MemOperand field = HeapOperand(InputRegisterAt(instruction, 0), field_info.GetFieldOffset());
 
-  if (kEmitCompilerReadBarrier && kUseBakerReadBarrier &&
-      load_type == DataType::Type::kReference) {
+  if (kUseBakerReadBarrier && CodeGenerator::FieldLoadNeedsReadBarrier(instruction)) {
     // Object FieldGet with Baker's read barrier case.
     // /* HeapReference<Object> */ out = *(base + offset)
     Register base = RegisterFrom(base_loc, DataType::Type::kReference);
@@ -2006,10 +2026,17 @@ void InstructionCodeGeneratorARM64::HandleFieldGet(HInstruction* instruction,
       codegen_->MaybeRecordImplicitNullCheck(instruction);
     }
     if (load_type == DataType::Type::kReference) {
-      // If read barriers are enabled, emit read barriers other than
-      // Baker's using a slow path (and also unpoison the loaded
-      // reference, if heap poisoning is enabled).
-      codegen_->MaybeGenerateReadBarrierSlow(instruction, out, out, base_loc, offset);
+      if (kEmitCompilerReadBarrier && kUseBakerReadBarrier) {
+        // Baker read barrier elided: the loaded reference is only compared against
+        // null, so the from-space reference serves just as well.
+        DCHECK(!CodeGenerator::FieldLoadNeedsReadBarrier(instruction));
+        GetAssembler()->MaybeUnpoisonHeapReference(WRegisterFrom(out));
+      } else {
+        // If read barriers are enabled, emit read barriers other than
+        // Baker's using a slow path (and also unpoison the loaded
+        // reference, if heap poisoning is enabled).
+        codegen_->MaybeGenerateReadBarrierSlow(instruction, out, out, base_loc, offset);
+      }
     }
   }
 }
@@ -4347,10 +4374,20 @@ void CodeGeneratorARM64::GenerateVirtualCall(
 }
 
 void LocationsBuilderARM64::VisitInvokePolymorphic(HInvokePolymorphic* invoke) {
+  IntrinsicLocationsBuilderARM64 intrinsic(GetGraph()->GetAllocator(), codegen_);
+  if (intrinsic.TryDispatch(invoke)) {
+    return;
+  }
+
   HandleInvoke(invoke);
 }
 
 void InstructionCodeGeneratorARM64::VisitInvokePolymorphic(HInvokePolymorphic* invoke) {
+  if (TryGenerateIntrinsicCode(invoke, codegen_)) {
+    codegen_->MaybeGenerateMarkingRegisterCheck(/* code= */ __LINE__);
+    return;
+  }
+
   codegen_->GenerateInvokePolymorphicCall(invoke);
   codegen_->MaybeGenerateMarkingRegisterCheck(/* code= */ __LINE__);
 }
@@ -5282,8 +5282,7 @@ void CodeGeneratorX86::MarkGCCard(Register temp,
 void LocationsBuilderX86::HandleFieldGet(HInstruction* instruction, const FieldInfo& field_info) {
   DCHECK(instruction->IsInstanceFieldGet() || instruction->IsStaticFieldGet());
 
-  bool object_field_get_with_read_barrier =
-      kEmitCompilerReadBarrier && (instruction->GetType() == DataType::Type::kReference);
+  bool object_field_get_with_read_barrier = CodeGenerator::FieldLoadNeedsReadBarrier(instruction);
   LocationSummary* locations =
       new (GetGraph()->GetAllocator()) LocationSummary(instruction,
                                                        kEmitCompilerReadBarrier
@@ -5359,7 +5358,7 @@ void InstructionCodeGeneratorX86::HandleFieldGet(HInstruction* instruction,
 
     case DataType::Type::kReference: {
       // /* HeapReference<Object> */ out = *(base + offset)
-      if (kEmitCompilerReadBarrier && kUseBakerReadBarrier) {
+      if (kUseBakerReadBarrier && CodeGenerator::FieldLoadNeedsReadBarrier(instruction)) {
         // Note that a potential implicit null check is handled in this
         // CodeGeneratorX86::GenerateFieldLoadWithBakerReadBarrier call.
         codegen_->GenerateFieldLoadWithBakerReadBarrier(
@@ -5373,10 +5372,17 @@ void InstructionCodeGeneratorX86::HandleFieldGet(HInstruction* instruction,
         if (is_volatile) {
           codegen_->GenerateMemoryBarrier(MemBarrierKind::kLoadAny);
         }
-        // If read barriers are enabled, emit read barriers other than
-        // Baker's using a slow path (and also unpoison the loaded
-        // reference, if heap poisoning is enabled).
-        codegen_->MaybeGenerateReadBarrierSlow(instruction, out, out, base_loc, offset);
+        if (kEmitCompilerReadBarrier && kUseBakerReadBarrier) {
+          // Baker read barrier elided: the loaded reference is only compared against
+          // null, so the from-space reference serves just as well.
+          DCHECK(!CodeGenerator::FieldLoadNeedsReadBarrier(instruction));
+          __ MaybeUnpoisonHeapReference(out.AsRegister<Register>());
+        } else {
+          // If read barriers are enabled, emit read barriers other than
+          // Baker's using a slow path (and also unpoison the loaded
+          // reference, if heap poisoning is enabled).
+          codegen_->MaybeGenerateReadBarrierSlow(instruction, out, out, base_loc, offset);
+        }
       }
       break;
     }
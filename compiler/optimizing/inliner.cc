@@ -68,6 +68,10 @@ static constexpr size_t kMaximumNumberOfRecursiveCalls = 4;
 // Controls the use of inline caches in AOT mode.
 static constexpr bool kUseAOTInlineCaches = true;
 
+// Scale factor applied to kMaximumNumberOfTotalInstructions for methods a
+// profile marks as hot.
+static constexpr size_t kHotMethodTotalInstructionBudgetScale = 2;
+
 // We check for line numbers to make sure the DepthString implementation
 // aligns the output nicely.
 #define LOG_INTERNAL(msg) \
@@ -115,14 +119,32 @@ static size_t CountNumberOfInstructions(HGraph* graph) {
   return number_of_instructions;
 }
 
+size_t HInliner::ComputeTotalInstructionBudget() const {
+  const ProfileCompilationInfo* pci = codegen_->GetCompilerOptions().GetProfileCompilationInfo();
+  if (pci != nullptr) {
+    ProfileCompilationInfo::MethodHotness hotness = pci->GetMethodHotness(
+        MethodReference(&outermost_graph_->GetDexFile(), outermost_graph_->GetMethodIdx()));
+    if (hotness.IsHot()) {
+      // A hot call graph benefits from deeper inlining; let the method grow
+      // further before we fall back to small-method-only inlining.
+      return kMaximumNumberOfTotalInstructions * kHotMethodTotalInstructionBudgetScale;
+    }
+    // The profile knows the method is not hot (e.g. startup-only): restrict
+    // inlining to small methods like getters, keeping the generated code
+    // compact without hurting the paths that matter.
+    return kMaximumNumberOfInstructionsForSmallMethod;
+  }
+  return kMaximumNumberOfTotalInstructions;
+}
+
 void HInliner::UpdateInliningBudget() {
-  if (total_number_of_instructions_ >= kMaximumNumberOfTotalInstructions) {
+  if (total_number_of_instructions_ >= total_instruction_budget_) {
     // Always try to inline small methods.
     inlining_budget_ = kMaximumNumberOfInstructionsForSmallMethod;
   } else {
     inlining_budget_ = std::max(
         kMaximumNumberOfInstructionsForSmallMethod,
-        kMaximumNumberOfTotalInstructions - total_number_of_instructions_);
+        total_instruction_budget_ - total_number_of_instructions_);
   }
 }
 
@@ -144,6 +166,7 @@ bool HInliner::Run() {
     total_number_of_instructions_ = CountNumberOfInstructions(graph_);
   }
 
+  total_instruction_budget_ = ComputeTotalInstructionBudget();
   UpdateInliningBudget();
   DCHECK_NE(total_number_of_instructions_, 0u);
   DCHECK_NE(inlining_budget_, 0u);
@@ -1789,6 +1812,14 @@ static bool CanEncodeInlinedMethodInStackMap(const DexFile& caller_dex_file, Art
   if (IsSameDexFile(caller_dex_file, *callee->GetDexFile())) {
     return true;
   }
+  // Methods from the boot classpath can be encoded: their dex file identity
+  // and method indices are the same in every runtime using this boot image,
+  // so stack maps can record which boot classpath dex file to resolve the
+  // method index against.
+  if (ContainsElement(Runtime::Current()->GetClassLinker()->GetBootClassPath(),
+                      callee->GetDexFile())) {
+    return true;
+  }
   // TODO(ngeoffray): Support more AOT cases for inlining:
   // - methods in multidex
   // - methods in boot image for on-device non-PIC compilation.
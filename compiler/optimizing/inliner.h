@@ -53,6 +53,7 @@ class HInliner : public HOptimization {
         total_number_of_instructions_(total_number_of_instructions),
         parent_(parent),
         depth_(depth),
+        total_instruction_budget_(0),
         inlining_budget_(0),
         handles_(handles),
         inline_stats_(nullptr) {}
@@ -315,6 +316,12 @@ class HInliner : public HOptimization {
   // Update the inlining budget based on `total_number_of_instructions_`.
   void UpdateInliningBudget();
 
+  // Compute the maximum total number of instructions this compilation may grow
+  // to through inlining. With a profile, methods it marks hot get a scaled-up
+  // budget while methods it considers cold keep only the small-method budget;
+  // without profile information the static budget applies.
+  size_t ComputeTotalInstructionBudget() const;
+
   // Count the number of calls of `method` being inlined recursively.
   size_t CountRecursiveCallsOf(ArtMethod* method) const;
 
@@ -333,6 +340,10 @@ class HInliner : public HOptimization {
   const HInliner* const parent_;
   const size_t depth_;
 
+  // Maximum total number of instructions for this compilation, see
+  // ComputeTotalInstructionBudget. Set once in Run().
+  size_t total_instruction_budget_;
+
   // The budget left for inlining, in number of instructions.
   size_t inlining_budget_;
   VariableSizedHandleScope* const handles_;
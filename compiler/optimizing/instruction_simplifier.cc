@@ -2514,10 +2514,34 @@ static bool TryReplaceStringBuilderAppend(HInvoke* invoke) {
       DCHECK(!seen_constructor);
       DCHECK(!seen_constructor_fence);
       StringBuilderAppend::Argument arg;
+      HInstruction* arg_instruction = as_invoke_virtual->InputAt(1u);
       switch (as_invoke_virtual->GetIntrinsic()) {
-        case Intrinsics::kStringBuilderAppendObject:
-          // TODO: Unimplemented, needs to call String.valueOf().
+        case Intrinsics::kStringBuilderAppendObject: {
+          ReferenceTypeInfo rti = arg_instruction->GetReferenceTypeInfo();
+          if (rti.IsValid()) {
+            ScopedObjectAccess soa(Thread::Current());
+            Handle<mirror::Class> input_type = rti.GetTypeHandle();
+            DCHECK(input_type != nullptr);
+            if (input_type.Get() == GetClassRoot<mirror::String>()) {
+              // String is final and String.toString() returns `this`, and a null argument
+              // appends "null" just like for append(String), so we can treat the argument
+              // as a String. (RTI gives an upper bound on the dynamic type.)
+              arg = StringBuilderAppend::Argument::kString;
+              break;
+            }
+          }
+          if (arg_instruction->IsInvokeStaticOrDirect() &&
+              arg_instruction->AsInvokeStaticOrDirect()->GetIntrinsic() ==
+                  Intrinsics::kIntegerValueOf) {
+            // A boxed `int` coming from the Integer.valueOf() intrinsic is known to be
+            // a non-null Integer, so we can append the unboxed value directly.
+            arg = StringBuilderAppend::Argument::kInt;
+            arg_instruction = arg_instruction->InputAt(0u);
+            break;
+          }
+          // TODO: Unimplemented for other types, needs to call String.valueOf().
           return false;
+        }
         case Intrinsics::kStringBuilderAppendString:
           arg = StringBuilderAppend::Argument::kString;
           break;
@@ -2571,7 +2595,7 @@ static bool TryReplaceStringBuilderAppend(HInvoke* invoke) {
         return false;
       }
       format = (format << StringBuilderAppend::kBitsPerArg) | static_cast<uint32_t>(arg);
-      args[num_args] = as_invoke_virtual->InputAt(1u);
+      args[num_args] = arg_instruction;
       ++num_args;
     } else if (user->IsInvokeStaticOrDirect() &&
                user->AsInvokeStaticOrDirect()->GetResolvedMethod() != nullptr &&
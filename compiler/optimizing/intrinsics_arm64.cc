@@ -17,6 +17,7 @@
 #include "intrinsics_arm64.h"
 
 #include "arch/arm64/instruction_set_features_arm64.h"
+#include "art_field.h"
 #include "art_method.h"
 #include "code_generator_arm64.h"
 #include "common_arm64.h"
@@ -25,9 +26,11 @@
 #include "intrinsics.h"
 #include "lock_word.h"
 #include "mirror/array-inl.h"
+#include "mirror/class-inl.h"
 #include "mirror/object_array-inl.h"
 #include "mirror/reference.h"
 #include "mirror/string-inl.h"
+#include "mirror/var_handle.h"
 #include "scoped_thread_state_change-inl.h"
 #include "thread-current-inl.h"
 #include "utils/arm64/assembler_arm64.h"
@@ -128,6 +131,8 @@ class IntrinsicSlowPathARM64 : public SlowPathCodeARM64 {
       if (invoke_->IsInvokeStaticOrDirect()) {
         codegen->GenerateStaticOrDirectCall(
             invoke_->AsInvokeStaticOrDirect(), LocationFrom(kArtMethodRegister), this);
+      } else if (invoke_->IsInvokePolymorphic()) {
+        codegen->GenerateInvokePolymorphicCall(invoke_->AsInvokePolymorphic(), this);
       } else {
         codegen->GenerateVirtualCall(
             invoke_->AsInvokeVirtual(), LocationFrom(kArtMethodRegister), this);
@@ -2203,6 +2208,58 @@ static void GenSystemArrayCopyAddresses(MacroAssembler* masm,
   }
 }
 
+// Copy the raw memory range [`src_curr_addr`, `src_stop_addr`) to `dst_curr_addr`, loading
+// and storing 16 bytes at a time while a full chunk remains and finishing with a per-element
+// remainder loop. The data is copied as-is, without poisoning/unpoisoning. All three address
+// registers are clobbered. (Unaligned ldp/stp is acceptable here and not worth inlining extra
+// code to rectify, same as in VisitStringGetCharsNoCheck.)
+static void GenSystemArrayCopyChunkedCopy(MacroAssembler* masm,
+                                          DataType::Type type,
+                                          const Register& src_curr_addr,
+                                          const Register& dst_curr_addr,
+                                          const Register& src_stop_addr,
+                                          const Register& tmp1,
+                                          const Register& tmp2) {
+  DCHECK(type == DataType::Type::kReference || type == DataType::Type::kUint16)
+      << "Unexpected element type: " << type;
+  DCHECK(tmp1.IsX());
+  DCHECK(tmp2.IsX());
+  const int32_t element_size = DataType::Size(type);
+  const int32_t chunk_size = 2 * static_cast<int32_t>(kXRegSizeInBytes);
+  vixl::aarch64::Label chunked_loop, remainder, remainder_loop, done;
+
+  // Lower the stop address so that a single comparison tells whether a full chunk remains.
+  __ Sub(src_stop_addr, src_stop_addr, chunk_size - element_size);
+  __ Cmp(src_curr_addr, src_stop_addr);
+  __ B(&remainder, hs);
+
+  // Main loop loads and stores two X registers (16 bytes) at a time.
+  __ Bind(&chunked_loop);
+  __ Ldp(tmp1, tmp2, MemOperand(src_curr_addr, chunk_size, PostIndex));
+  __ Stp(tmp1, tmp2, MemOperand(dst_curr_addr, chunk_size, PostIndex));
+  __ Cmp(src_curr_addr, src_stop_addr);
+  __ B(&chunked_loop, lo);
+
+  // Remainder loop copies the up to `chunk_size - element_size` trailing bytes one
+  // element at a time.
+  __ Bind(&remainder);
+  __ Add(src_stop_addr, src_stop_addr, chunk_size - element_size);
+  __ Cmp(src_curr_addr, src_stop_addr);
+  __ B(&done, eq);
+  __ Bind(&remainder_loop);
+  if (type == DataType::Type::kUint16) {
+    __ Ldrh(tmp1.W(), MemOperand(src_curr_addr, element_size, PostIndex));
+    __ Strh(tmp1.W(), MemOperand(dst_curr_addr, element_size, PostIndex));
+  } else {
+    __ Ldr(tmp1.W(), MemOperand(src_curr_addr, element_size, PostIndex));
+    __ Str(tmp1.W(), MemOperand(dst_curr_addr, element_size, PostIndex));
+  }
+  __ Cmp(src_curr_addr, src_stop_addr);
+  __ B(&remainder_loop, ne);
+
+  __ Bind(&done);
+}
+
 void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopyChar(HInvoke* invoke) {
   MacroAssembler* masm = GetVIXLAssembler();
   LocationSummary* locations = invoke->GetLocations();
@@ -2274,22 +2331,185 @@ void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopyChar(HInvoke* invoke) {
                               dst_curr_addr,
                               src_stop_addr);
 
-  // Iterate over the arrays and do a raw copy of the chars.
-  const int32_t char_size = DataType::Size(DataType::Type::kUint16);
+  // Iterate over the arrays and do a raw copy of the chars, in 16-byte chunks where possible.
   UseScratchRegisterScope temps(masm);
-  Register tmp = temps.AcquireW();
-  vixl::aarch64::Label loop, done;
-  __ Bind(&loop);
-  __ Cmp(src_curr_addr, src_stop_addr);
-  __ B(&done, eq);
-  __ Ldrh(tmp, MemOperand(src_curr_addr, char_size, PostIndex));
-  __ Strh(tmp, MemOperand(dst_curr_addr, char_size, PostIndex));
-  __ B(&loop);
-  __ Bind(&done);
+  Register tmp1 = temps.AcquireX();
+  Register tmp2 = temps.AcquireX();
+  GenSystemArrayCopyChunkedCopy(masm,
+                                DataType::Type::kUint16,
+                                src_curr_addr,
+                                dst_curr_addr,
+                                src_stop_addr,
+                                tmp1,
+                                tmp2);
 
   __ Bind(slow_path->GetExitLabel());
 }
 
+void IntrinsicLocationsBuilderARM64::VisitArraysFillInt(HInvoke* invoke) {
+  LocationSummary* locations =
+      new (allocator_) LocationSummary(invoke, LocationSummary::kCallOnSlowPath, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysFillInt(HInvoke* invoke) {
+  MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  const size_t element_size = DataType::Size(DataType::Type::kInt32);
+  const uint32_t data_offset = mirror::Array::DataOffset(element_size).Uint32Value();
+  const int32_t length_offset = mirror::Array::LengthOffset().Int32Value();
+
+  Register array = XRegisterFrom(locations->InAt(0));
+  Register value = WRegisterFrom(locations->InAt(1));
+  Register ptr = XRegisterFrom(locations->GetTemp(0));
+  Register count = WRegisterFrom(locations->GetTemp(1));
+
+  // Bail out to the runtime on a null array; the library method throws the NPE.
+  SlowPathCodeARM64* slow_path =
+      new (codegen_->GetScopedAllocator()) IntrinsicSlowPathARM64(invoke);
+  codegen_->AddSlowPath(slow_path);
+  __ Cbz(array, slow_path->GetEntryLabel());
+
+  UseScratchRegisterScope temps(masm);
+  VRegister vvalue = temps.AcquireVRegisterOfSize(kQRegSize);
+
+  vixl::aarch64::Label vector_loop;
+  vixl::aarch64::Label remainder;
+  vixl::aarch64::Label remainder_loop;
+  vixl::aarch64::Label done;
+
+  __ Ldr(count, MemOperand(array, length_offset));
+  __ Add(ptr, array, data_offset);
+
+  // Main loop stores eight replicated elements (two Q registers) per iteration.
+  // (The data start is not 16-byte aligned, but unaligned stores to normal
+  // memory are acceptable here and not worth inlining extra code to rectify.)
+  __ Dup(vvalue.V4S(), value);
+  __ Subs(count, count, 8);
+  __ B(lt, &remainder);
+  __ Bind(&vector_loop);
+  __ Stp(vvalue, vvalue, MemOperand(ptr, 8 * element_size, PostIndex));
+  __ Subs(count, count, 8);
+  __ B(ge, &vector_loop);
+
+  // Store the remaining 0-7 elements one at a time.
+  __ Bind(&remainder);
+  __ Adds(count, count, 8);
+  __ B(eq, &done);
+  __ Bind(&remainder_loop);
+  __ Str(value, MemOperand(ptr, element_size, PostIndex));
+  __ Subs(count, count, 1);
+  __ B(gt, &remainder_loop);
+
+  __ Bind(&done);
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderARM64::VisitArraysHashCodeInt(HInvoke* invoke) {
+  LocationSummary* locations =
+      new (allocator_) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  // The output is written before the array register dies on the null path.
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysHashCodeInt(HInvoke* invoke) {
+  MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  const size_t element_size = DataType::Size(DataType::Type::kInt32);
+  const uint32_t data_offset = mirror::Array::DataOffset(element_size).Uint32Value();
+  const int32_t length_offset = mirror::Array::LengthOffset().Int32Value();
+
+  // Element i of a four-element block contributes with weight 31^(3-i) and
+  // each whole block shifts the previously accumulated value by 31^4.
+  constexpr int32_t kPow1 = 31;
+  constexpr int32_t kPow2 = 31 * 31;
+  constexpr int32_t kPow3 = 31 * 31 * 31;
+  constexpr int32_t kPow4 = 31 * 31 * 31 * 31;
+
+  Register array = XRegisterFrom(locations->InAt(0));
+  Register out = WRegisterFrom(locations->Out());
+  Register ptr = XRegisterFrom(locations->GetTemp(0));
+  Register count = WRegisterFrom(locations->GetTemp(1));
+  VRegister vacc = QRegisterFrom(locations->GetTemp(2));
+  VRegister vcoef = QRegisterFrom(locations->GetTemp(3));
+  VRegister vdata = QRegisterFrom(locations->GetTemp(4));
+
+  UseScratchRegisterScope temps(masm);
+  Register tmp = temps.AcquireW();
+  Register tmp2 = temps.AcquireW();
+
+  vixl::aarch64::Label vector_loop;
+  vixl::aarch64::Label tail;
+  vixl::aarch64::Label tail_loop;
+  vixl::aarch64::Label done;
+
+  // Arrays.hashCode(null) is zero, not a NullPointerException.
+  __ Mov(out, 0);
+  __ Cbz(array, &done);
+
+  __ Ldr(count, MemOperand(array, length_offset));
+  __ Add(ptr, array, data_offset);
+  __ Mov(out, 1);
+  __ Subs(count, count, 4);
+  __ B(lt, &tail);
+
+  // Process four elements per iteration: acc = acc * 31^4 + data. Seeding
+  // lane 3 with the initial hash value of 1 makes the final reduction yield
+  // the leading 31^length term for free.
+  __ Mov(tmp, kPow4);
+  __ Dup(vcoef.V4S(), tmp);
+  __ Movi(vacc.V2D(), 0);
+  __ Mov(tmp, 1);
+  __ Mov(vacc.V4S(), 3, tmp);
+
+  __ Bind(&vector_loop);
+  __ Ldr(vdata, MemOperand(ptr, 4 * element_size, PostIndex));
+  __ Mul(vacc.V4S(), vacc.V4S(), vcoef.V4S());
+  __ Add(vacc.V4S(), vacc.V4S(), vdata.V4S());
+  __ Subs(count, count, 4);
+  __ B(ge, &vector_loop);
+
+  // Reduce: out = dot(acc, {31^3, 31^2, 31, 1}). The lane multiplications
+  // wrap modulo 2^32 exactly like Java's int arithmetic.
+  __ Mov(tmp, kPow3);
+  __ Mov(vcoef.V4S(), 0, tmp);
+  __ Mov(tmp, kPow2);
+  __ Mov(vcoef.V4S(), 1, tmp);
+  __ Mov(tmp, kPow1);
+  __ Mov(vcoef.V4S(), 2, tmp);
+  __ Mov(tmp, 1);
+  __ Mov(vcoef.V4S(), 3, tmp);
+  __ Mul(vacc.V4S(), vacc.V4S(), vcoef.V4S());
+  __ Addv(vacc.S(), vacc.V4S());
+  __ Umov(out, vacc.V4S(), 0);
+
+  // Fold in the remaining 0-3 elements sequentially.
+  __ Bind(&tail);
+  __ Adds(count, count, 4);
+  __ B(eq, &done);
+  __ Mov(tmp2, 31);
+  __ Bind(&tail_loop);
+  __ Ldr(tmp, MemOperand(ptr, element_size, PostIndex));
+  __ Madd(out, out, tmp2, tmp);
+  __ Subs(count, count, 1);
+  __ B(gt, &tail_loop);
+
+  __ Bind(&done);
+}
+
 // We can choose to use the native implementation there for longer copy lengths.
 static constexpr int32_t kSystemArrayCopyThreshold = 128;
 
@@ -2351,19 +2571,15 @@ void IntrinsicLocationsBuilderARM64::VisitSystemArrayCopy(HInvoke* invoke) {
 
   locations->AddTemp(Location::RequiresRegister());
   locations->AddTemp(Location::RequiresRegister());
-  if (kEmitCompilerReadBarrier && kUseBakerReadBarrier) {
-    // Temporary register IP0, obtained from the VIXL scratch register
-    // pool, cannot be used in ReadBarrierSystemArrayCopySlowPathARM64
-    // (because that register is clobbered by ReadBarrierMarkRegX
-    // entry points). It cannot be used in calls to
-    // CodeGeneratorARM64::GenerateFieldLoadWithBakerReadBarrier
-    // either. For these reasons, get a third extra temporary register
-    // from the register allocator.
-    locations->AddTemp(Location::RequiresRegister());
-  } else {
-    // Cases other than Baker read barriers: the third temporary will
-    // be acquired from the VIXL scratch register pool.
-  }
+  // With Baker read barriers, temporary register IP0, obtained from the VIXL
+  // scratch register pool, cannot be used in
+  // ReadBarrierSystemArrayCopySlowPathARM64 (because that register is
+  // clobbered by ReadBarrierMarkRegX entry points). It cannot be used in calls
+  // to CodeGeneratorARM64::GenerateFieldLoadWithBakerReadBarrier either. In
+  // other cases it could be used but the copy loop wants both VIXL scratch
+  // registers for itself. For these reasons, get a third extra temporary
+  // register from the register allocator.
+  locations->AddTemp(Location::RequiresRegister());
 }
 
 void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopy(HInvoke* invoke) {
@@ -2474,14 +2690,8 @@ void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopy(HInvoke* invoke) {
     // We use a block to end the scratch scope before the write barrier, thus
     // freeing the temporary registers so they can be used in `MarkGCCard`.
     UseScratchRegisterScope temps(masm);
-    Location temp3_loc;  // Used only for Baker read barrier.
-    Register temp3;
-    if (kEmitCompilerReadBarrier && kUseBakerReadBarrier) {
-      temp3_loc = locations->GetTemp(2);
-      temp3 = WRegisterFrom(temp3_loc);
-    } else {
-      temp3 = temps.AcquireW();
-    }
+    Location temp3_loc = locations->GetTemp(2);
+    Register temp3 = WRegisterFrom(temp3_loc);
 
     if (!optimizations.GetDoesNotNeedTypeCheck()) {
       // Check whether all elements of the source array are assignable to the component
@@ -2693,7 +2903,6 @@ void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopy(HInvoke* invoke) {
       Register src_stop_addr = temp3.X();
       vixl::aarch64::Label done;
       const DataType::Type type = DataType::Type::kReference;
-      const int32_t element_size = DataType::Size(type);
 
       if (length.IsRegister()) {
         // Don't enter the copy loop if the length is null.
@@ -2778,14 +2987,19 @@ void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopy(HInvoke* invoke) {
         __ Tbnz(tmp, LockWord::kReadBarrierStateShift, read_barrier_slow_path->GetEntryLabel());
 
         // Fast-path copy.
-        // Iterate over the arrays and do a raw copy of the objects. We don't need to
-        // poison/unpoison.
-        vixl::aarch64::Label loop;
-        __ Bind(&loop);
-        __ Ldr(tmp, MemOperand(src_curr_addr, element_size, PostIndex));
-        __ Str(tmp, MemOperand(dst_curr_addr, element_size, PostIndex));
-        __ Cmp(src_curr_addr, src_stop_addr);
-        __ B(&loop, ne);
+        // Iterate over the arrays and do a raw copy of the objects, in 16-byte chunks
+        // where possible. We don't need to poison/unpoison. The read barrier slow path
+        // is only entered by the Tbnz above, before any copying, so IP0 can be used as
+        // a second temporary here.
+        Register tmp2 = temps.AcquireX();
+        GenSystemArrayCopyChunkedCopy(masm,
+                                      type,
+                                      src_curr_addr,
+                                      dst_curr_addr,
+                                      src_stop_addr,
+                                      tmp.X(),
+                                      tmp2);
+        temps.Release(tmp2);
 
         __ Bind(read_barrier_slow_path->GetExitLabel());
       } else {
@@ -2803,17 +3017,19 @@ void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopy(HInvoke* invoke) {
                                     src_curr_addr,
                                     dst_curr_addr,
                                     src_stop_addr);
-        // Iterate over the arrays and do a raw copy of the objects. We don't need to
-        // poison/unpoison.
-        vixl::aarch64::Label loop;
-        __ Bind(&loop);
-        {
-          Register tmp = temps.AcquireW();
-          __ Ldr(tmp, MemOperand(src_curr_addr, element_size, PostIndex));
-          __ Str(tmp, MemOperand(dst_curr_addr, element_size, PostIndex));
-        }
-        __ Cmp(src_curr_addr, src_stop_addr);
-        __ B(&loop, ne);
+        // Iterate over the arrays and do a raw copy of the objects, in 16-byte chunks
+        // where possible. We don't need to poison/unpoison.
+        Register tmp1 = temps.AcquireX();
+        Register tmp2 = temps.AcquireX();
+        GenSystemArrayCopyChunkedCopy(masm,
+                                      type,
+                                      src_curr_addr,
+                                      dst_curr_addr,
+                                      src_stop_addr,
+                                      tmp1,
+                                      tmp2);
+        temps.Release(tmp2);
+        temps.Release(tmp1);
       }
       __ Bind(&done);
     }
@@ -3402,6 +3618,417 @@ void IntrinsicCodeGeneratorARM64::VisitFP16LessEquals(HInvoke* invoke) {
   GenerateFP16Compare(invoke, codegen_, masm, ls);
 }
 
+void IntrinsicLocationsBuilderARM64::VisitFP16Compare(HInvoke* invoke) {
+  if (!codegen_->GetInstructionSetFeatures().HasFP16()) {
+    return;
+  }
+
+  CreateIntIntToIntLocations(allocator_, invoke);
+  invoke->GetLocations()->AddTemp(Location::RequiresFpuRegister());
+  invoke->GetLocations()->AddTemp(Location::RequiresFpuRegister());
+}
+
+void IntrinsicCodeGeneratorARM64::VisitFP16Compare(HInvoke* invoke) {
+  DCHECK(codegen_->GetInstructionSetFeatures().HasFP16());
+  MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+  Register out = WRegisterFrom(locations->Out());
+  Register in0 = WRegisterFrom(locations->InAt(0));
+  Register in1 = WRegisterFrom(locations->InAt(1));
+  VRegister half0 = HRegisterFrom(locations->GetTemp(0));
+  VRegister half1 = HRegisterFrom(locations->GetTemp(1));
+  vixl::aarch64::Label compare;
+  vixl::aarch64::Label nan;
+  vixl::aarch64::Label in0_is_nan;
+  vixl::aarch64::Label end;
+  __ Fmov(half0, in0);
+  __ Fmov(half1, in1);
+  __ Fcmp(half0, half1);
+  __ B(vs, &nan);      // At least one of the inputs is NaN.
+  __ B(ne, &compare);  // Strictly ordered; the FP flags give the answer.
+  // The values compare equal. This covers bit-identical inputs as well as
+  // +0 and -0, which FP16.compare() orders as -0 < +0. Ordering the raw
+  // (sign-extended) bits handles both: -0 (0xffff8000) sorts below +0 (0).
+  __ Cmp(in0, in1);
+  __ Bind(&compare);
+  __ Cset(out, gt);
+  __ Csinv(out, out, wzr, ge);  // out = -1 for less than.
+  __ B(&end);
+  // NaN compares greater than every other value and equal to itself.
+  __ Bind(&nan);
+  __ Fcmp(half0, half0);
+  __ B(vs, &in0_is_nan);
+  __ Mov(out, -1);  // Only in1 is NaN.
+  __ B(&end);
+  __ Bind(&in0_is_nan);
+  __ Fcmp(half1, half1);
+  __ Cset(out, vc);  // 1 if only in0 is NaN, 0 if both are.
+  __ Bind(&end);
+}
+
+static void GenerateFP16MinMax(HInvoke* invoke,
+                               CodeGeneratorARM64* codegen,
+                               MacroAssembler* masm,
+                               bool is_min) {
+  DCHECK(codegen->GetInstructionSetFeatures().HasFP16());
+  LocationSummary* locations = invoke->GetLocations();
+  Register out = WRegisterFrom(locations->Out());
+  Register in0 = WRegisterFrom(locations->InAt(0));
+  Register in1 = WRegisterFrom(locations->InAt(1));
+  VRegister half0 = HRegisterFrom(locations->GetTemp(0));
+  VRegister half1 = HRegisterFrom(locations->GetTemp(1));
+  vixl::aarch64::Label equal;
+  vixl::aarch64::Label nan;
+  vixl::aarch64::Label end;
+  __ Fmov(half0, in0);
+  __ Fmov(half1, in1);
+  __ Fcmp(half0, half1);
+  __ B(vs, &nan);    // At least one of the inputs is NaN.
+  __ B(eq, &equal);  // Equal values, possibly zeros of opposite signs.
+  __ Csel(out, in0, in1, is_min ? mi : gt);
+  __ B(&end);
+  __ Bind(&equal);
+  // Merge the sign bits so that min(-0, +0) is -0 and max(-0, +0) is +0.
+  // For bit-identical inputs this reproduces the input.
+  if (is_min) {
+    __ Orr(out, in0, in1);
+  } else {
+    __ And(out, in0, in1);
+  }
+  __ B(&end);
+  __ Bind(&nan);
+  // Both FP16.min() and FP16.max() return the canonical NaN, not the input one.
+  __ Mov(out, 0x7e00);  // libcore.util.FP16.NaN
+  __ Bind(&end);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitFP16Min(HInvoke* invoke) {
+  if (!codegen_->GetInstructionSetFeatures().HasFP16()) {
+    return;
+  }
+
+  CreateIntIntToIntLocations(allocator_, invoke);
+  invoke->GetLocations()->AddTemp(Location::RequiresFpuRegister());
+  invoke->GetLocations()->AddTemp(Location::RequiresFpuRegister());
+}
+
+void IntrinsicCodeGeneratorARM64::VisitFP16Min(HInvoke* invoke) {
+  MacroAssembler* masm = GetVIXLAssembler();
+  GenerateFP16MinMax(invoke, codegen_, masm, /*is_min=*/ true);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitFP16Max(HInvoke* invoke) {
+  if (!codegen_->GetInstructionSetFeatures().HasFP16()) {
+    return;
+  }
+
+  CreateIntIntToIntLocations(allocator_, invoke);
+  invoke->GetLocations()->AddTemp(Location::RequiresFpuRegister());
+  invoke->GetLocations()->AddTemp(Location::RequiresFpuRegister());
+}
+
+void IntrinsicCodeGeneratorARM64::VisitFP16Max(HInvoke* invoke) {
+  MacroAssembler* masm = GetVIXLAssembler();
+  GenerateFP16MinMax(invoke, codegen_, masm, /*is_min=*/ false);
+}
+
+// The VarHandle fast paths below support only static fields of 32-bit and 64-bit
+// integral types with a callsite that matches the field type exactly. Everything
+// else takes the slow path, i.e. the regular invoke-polymorphic runtime call,
+// which also covers the argument and return value conversions and the exception
+// throwing required by the VarHandle contract.
+static bool IsVarHandleFieldTypeSupported(DataType::Type type) {
+  return type == DataType::Type::kInt32 || type == DataType::Type::kInt64;
+}
+
+static void CreateVarHandleStaticFieldLocations(ArenaAllocator* allocator, HInvoke* invoke) {
+  // The only read barrier implementation supporting the VarHandle intrinsics is
+  // the Baker-style read barriers (needed for the GC root load of the declaring
+  // class); see GenerateGcRootFieldLoad().
+  if (kEmitCompilerReadBarrier && !kUseBakerReadBarrier) {
+    return;
+  }
+
+  LocationSummary* locations =
+      new (allocator) LocationSummary(invoke, LocationSummary::kCallOnSlowPath, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  for (uint32_t i = 1u; i != invoke->GetNumberOfArguments(); ++i) {
+    locations->SetInAt(i, Location::RequiresRegister());
+  }
+  // Temporaries for the declaring class and the ArtField.
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  if (invoke->GetType() != DataType::Type::kVoid) {
+    locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+  }
+}
+
+// Check that the VarHandle references a static field of the expected primitive type
+// and load the field's declaring class to `object` (W register) and the ArtField to
+// `field` (X register). All unsupported cases branch to `slow_path`.
+static void GenerateVarHandleStaticFieldTarget(HInvoke* invoke,
+                                               DataType::Type type,
+                                               mirror::VarHandle::AccessMode access_mode,
+                                               CodeGeneratorARM64* codegen,
+                                               SlowPathCodeARM64* slow_path,
+                                               Register object,
+                                               Register field) {
+  Arm64Assembler* assembler = codegen->GetAssembler();
+  MacroAssembler* masm = assembler->GetVIXLAssembler();
+  Register varhandle = WRegisterFrom(invoke->GetLocations()->InAt(0));
+  DCHECK(object.IsW());
+  DCHECK(field.IsX());
+
+  {
+    UseScratchRegisterScope temps(masm);
+    Register temp = temps.AcquireW();
+
+    // A null VarHandle takes the slow path, which throws the NullPointerException.
+    __ Cbz(varhandle, slow_path->GetEntryLabel());
+
+    // Check that the access mode is supported, e.g. `set` on a final field is not.
+    __ Ldr(temp, HeapOperand(varhandle, mirror::VarHandle::AccessModesBitMaskOffset()));
+    __ Tbz(temp, static_cast<int>(access_mode), slow_path->GetEntryLabel());
+
+    // Only static field VarHandles have no coordinate types; a null coordinate
+    // type 0 implies a null coordinate type 1, so one check is sufficient.
+    // (Heap reference poisoning preserves null, so the raw value can be tested.)
+    __ Ldr(temp, HeapOperand(varhandle, mirror::VarHandle::CoordinateType0Offset()));
+    __ Cbnz(temp, slow_path->GetEntryLabel());
+
+    // Check that the variable type matches the callsite type exactly, so that no
+    // conversions are needed. The primitive type can be read even off a from-space
+    // Class reference as the field is immutable.
+    Primitive::Type primitive_type =
+        (type == DataType::Type::kInt64) ? Primitive::kPrimLong : Primitive::kPrimInt;
+    __ Ldr(temp, HeapOperand(varhandle, mirror::VarHandle::VarTypeOffset()));
+    assembler->MaybeUnpoisonHeapReference(temp);
+    __ Ldrh(temp, HeapOperand(temp, mirror::Class::PrimitiveTypeOffset()));
+    __ Cmp(temp, static_cast<uint16_t>(primitive_type));
+    __ B(ne, slow_path->GetEntryLabel());
+  }
+
+  // Load the ArtField and the declaring class, which is the object to access.
+  __ Ldr(field, HeapOperand(varhandle, mirror::FieldVarHandle::ArtFieldOffset()));
+  codegen->GenerateGcRootFieldLoad(invoke,
+                                   LocationFrom(object),
+                                   field,
+                                   ArtField::DeclaringClassOffset().Int32Value(),
+                                   /* fixup_label= */ nullptr,
+                                   kCompilerReadBarrierOption);
+
+  // The declaring class of a static field must be visibly initialized; the slow
+  // path takes care of triggering the initialization.
+  {
+    UseScratchRegisterScope temps(masm);
+    Register temp = temps.AcquireW();
+    constexpr size_t status_lsb_position = SubtypeCheckBits::BitStructSizeOf();
+    const size_t status_byte_offset =
+        mirror::Class::StatusOffset().SizeValue() + (status_lsb_position / kBitsPerByte);
+    constexpr uint32_t shifted_visibly_initialized_value =
+        enum_cast<uint32_t>(ClassStatus::kVisiblyInitialized)
+            << (status_lsb_position % kBitsPerByte);
+    __ Ldrb(temp, HeapOperand(object, status_byte_offset));
+    __ Cmp(temp, shifted_visibly_initialized_value);
+    __ B(lo, slow_path->GetEntryLabel());
+  }
+}
+
+void IntrinsicLocationsBuilderARM64::VisitVarHandleGet(HInvoke* invoke) {
+  if (invoke->GetNumberOfArguments() != 1u ||
+      !IsVarHandleFieldTypeSupported(invoke->GetType())) {
+    return;
+  }
+
+  CreateVarHandleStaticFieldLocations(allocator_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitVarHandleGet(HInvoke* invoke) {
+  DataType::Type type = invoke->GetType();
+  LocationSummary* locations = invoke->GetLocations();
+  MacroAssembler* masm = GetVIXLAssembler();
+  SlowPathCodeARM64* slow_path =
+      new (codegen_->GetScopedAllocator()) IntrinsicSlowPathARM64(invoke);
+  codegen_->AddSlowPath(slow_path);
+
+  Register object = WRegisterFrom(locations->GetTemp(0));
+  Register field = XRegisterFrom(locations->GetTemp(1));
+  GenerateVarHandleStaticFieldTarget(
+      invoke, type, mirror::VarHandle::AccessMode::kGet, codegen_, slow_path, object, field);
+
+  UseScratchRegisterScope temps(masm);
+  Register offset = temps.AcquireX();
+  __ Ldr(offset.W(), MemOperand(field, ArtField::OffsetOffset().Int32Value()));
+  __ Ldr(RegisterFrom(locations->Out(), type), MemOperand(object.X(), offset));
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderARM64::VisitVarHandleSet(HInvoke* invoke) {
+  if (invoke->GetNumberOfArguments() != 2u ||
+      invoke->GetType() != DataType::Type::kVoid ||
+      !IsVarHandleFieldTypeSupported(invoke->InputAt(1)->GetType())) {
+    return;
+  }
+
+  CreateVarHandleStaticFieldLocations(allocator_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitVarHandleSet(HInvoke* invoke) {
+  DataType::Type type = invoke->InputAt(1)->GetType();
+  LocationSummary* locations = invoke->GetLocations();
+  MacroAssembler* masm = GetVIXLAssembler();
+  SlowPathCodeARM64* slow_path =
+      new (codegen_->GetScopedAllocator()) IntrinsicSlowPathARM64(invoke);
+  codegen_->AddSlowPath(slow_path);
+
+  Register object = WRegisterFrom(locations->GetTemp(0));
+  Register field = XRegisterFrom(locations->GetTemp(1));
+  GenerateVarHandleStaticFieldTarget(
+      invoke, type, mirror::VarHandle::AccessMode::kSet, codegen_, slow_path, object, field);
+
+  UseScratchRegisterScope temps(masm);
+  Register offset = temps.AcquireX();
+  __ Ldr(offset.W(), MemOperand(field, ArtField::OffsetOffset().Int32Value()));
+  __ Str(RegisterFrom(locations->InAt(1), type), MemOperand(object.X(), offset));
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderARM64::VisitVarHandleCompareAndSet(HInvoke* invoke) {
+  if (invoke->GetNumberOfArguments() != 3u ||
+      invoke->GetType() != DataType::Type::kBool ||
+      invoke->InputAt(1)->GetType() != invoke->InputAt(2)->GetType() ||
+      !IsVarHandleFieldTypeSupported(invoke->InputAt(1)->GetType())) {
+    return;
+  }
+
+  CreateVarHandleStaticFieldLocations(allocator_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitVarHandleCompareAndSet(HInvoke* invoke) {
+  DataType::Type type = invoke->InputAt(1)->GetType();
+  LocationSummary* locations = invoke->GetLocations();
+  MacroAssembler* masm = GetVIXLAssembler();
+  SlowPathCodeARM64* slow_path =
+      new (codegen_->GetScopedAllocator()) IntrinsicSlowPathARM64(invoke);
+  codegen_->AddSlowPath(slow_path);
+
+  Register object = WRegisterFrom(locations->GetTemp(0));
+  Register field = XRegisterFrom(locations->GetTemp(1));
+  GenerateVarHandleStaticFieldTarget(invoke,
+                                     type,
+                                     mirror::VarHandle::AccessMode::kCompareAndSet,
+                                     codegen_,
+                                     slow_path,
+                                     object,
+                                     field);
+
+  Register out = WRegisterFrom(locations->Out());
+  Register expected = RegisterFrom(locations->InAt(1), type);
+  Register value = RegisterFrom(locations->InAt(2), type);
+
+  UseScratchRegisterScope temps(masm);
+  Register tmp_ptr = temps.AcquireX();
+  __ Ldr(tmp_ptr.W(), MemOperand(field, ArtField::OffsetOffset().Int32Value()));
+  __ Add(tmp_ptr, object.X(), tmp_ptr);
+  // The ArtField is no longer needed, reuse its register for the old value.
+  Register old_value = (type == DataType::Type::kInt64) ? field : field.W();
+
+  // do {
+  //   old_value = [tmp_ptr];
+  // } while (old_value == expected && failure([tmp_ptr] <- value));
+  // result = old_value == expected;
+
+  vixl::aarch64::Label loop_head;
+  vixl::aarch64::Label exit_loop;
+  __ Bind(&loop_head);
+  __ Ldaxr(old_value, MemOperand(tmp_ptr));
+  __ Cmp(old_value, expected);
+  __ B(&exit_loop, ne);
+  __ Stlxr(old_value.W(), value, MemOperand(tmp_ptr));  // Reuse `old_value` for the STLXR result.
+  __ Cbnz(old_value.W(), &loop_head);
+  __ Bind(&exit_loop);
+  __ Cset(out, eq);
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderARM64::VisitVarHandleGetAndAdd(HInvoke* invoke) {
+  if (invoke->GetNumberOfArguments() != 2u ||
+      invoke->GetType() != invoke->InputAt(1)->GetType() ||
+      !IsVarHandleFieldTypeSupported(invoke->GetType())) {
+    return;
+  }
+
+  CreateVarHandleStaticFieldLocations(allocator_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitVarHandleGetAndAdd(HInvoke* invoke) {
+  DataType::Type type = invoke->GetType();
+  LocationSummary* locations = invoke->GetLocations();
+  MacroAssembler* masm = GetVIXLAssembler();
+  SlowPathCodeARM64* slow_path =
+      new (codegen_->GetScopedAllocator()) IntrinsicSlowPathARM64(invoke);
+  codegen_->AddSlowPath(slow_path);
+
+  Register object = WRegisterFrom(locations->GetTemp(0));
+  Register field = XRegisterFrom(locations->GetTemp(1));
+  GenerateVarHandleStaticFieldTarget(invoke,
+                                     type,
+                                     mirror::VarHandle::AccessMode::kGetAndAdd,
+                                     codegen_,
+                                     slow_path,
+                                     object,
+                                     field);
+
+  Register out = RegisterFrom(locations->Out(), type);
+  Register arg = RegisterFrom(locations->InAt(1), type);
+
+  UseScratchRegisterScope temps(masm);
+  Register tmp_ptr = temps.AcquireX();
+  __ Ldr(tmp_ptr.W(), MemOperand(field, ArtField::OffsetOffset().Int32Value()));
+  __ Add(tmp_ptr, object.X(), tmp_ptr);
+  Register new_value = temps.AcquireSameSizeAs(arg);
+  // The ArtField is no longer needed, reuse its register for the STLXR result.
+  Register store_result = field.W();
+
+  vixl::aarch64::Label loop_head;
+  __ Bind(&loop_head);
+  __ Ldaxr(out, MemOperand(tmp_ptr));
+  __ Add(new_value, out, arg);
+  __ Stlxr(store_result, new_value, MemOperand(tmp_ptr));
+  __ Cbnz(store_result, &loop_head);
+  __ Bind(slow_path->GetExitLabel());
+}
+
+UNIMPLEMENTED_INTRINSIC(ARM64, MethodHandleInvokeExact)
+UNIMPLEMENTED_INTRINSIC(ARM64, MethodHandleInvoke)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleCompareAndExchange)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleCompareAndExchangeAcquire)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleCompareAndExchangeRelease)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleGetAcquire)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleGetAndAddAcquire)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleGetAndAddRelease)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleGetAndBitwiseAnd)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleGetAndBitwiseAndAcquire)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleGetAndBitwiseAndRelease)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleGetAndBitwiseOr)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleGetAndBitwiseOrAcquire)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleGetAndBitwiseOrRelease)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleGetAndBitwiseXor)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleGetAndBitwiseXorAcquire)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleGetAndBitwiseXorRelease)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleGetAndSet)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleGetAndSetAcquire)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleGetAndSetRelease)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleGetOpaque)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleGetVolatile)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleSetOpaque)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleSetRelease)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleSetVolatile)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleWeakCompareAndSet)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleWeakCompareAndSetAcquire)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleWeakCompareAndSetPlain)
+UNIMPLEMENTED_INTRINSIC(ARM64, VarHandleWeakCompareAndSetRelease)
+
 UNIMPLEMENTED_INTRINSIC(ARM64, ReferenceGetReferent)
 
 UNIMPLEMENTED_INTRINSIC(ARM64, StringStringIndexOf);
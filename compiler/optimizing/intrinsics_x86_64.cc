@@ -1369,6 +1369,81 @@ static void CreateStringIndexOfLocations(HInvoke* invoke,
   locations->AddTemp(Location::RegisterLocation(RCX));
   // Need another temporary to be able to compute the result.
   locations->AddTemp(Location::RequiresRegister());
+  // Vector temporaries for the SIMD scan: the broadcast search character and a data chunk.
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+}
+
+// Emit a vectorized scan for `search_value` over the string data `string_obj` points to.
+// The string is scanned in 16-byte chunks for as long as a full chunk of characters remains,
+// so the vector loads never read past the end of the string data; the short tail is finished
+// with the old repne scas{b,w} sequence. On entry `counter` holds the number of characters
+// to scan and `string_length` the length of the whole string; `string_obj` has already been
+// advanced to the first character to scan. Jumps to `done_label` with the result in `out` on
+// a match, and to `not_found_label` otherwise.
+static void GenerateStringIndexOfVectorScan(X86_64Assembler* assembler,
+                                            bool compressed,
+                                            CpuRegister string_obj,
+                                            CpuRegister search_value,
+                                            CpuRegister counter,
+                                            CpuRegister string_length,
+                                            CpuRegister out,
+                                            XmmRegister search_vec,
+                                            XmmRegister data_vec,
+                                            Label* not_found_label,
+                                            Label* done_label) {
+  const int32_t chars_per_chunk = compressed ? 16 : 8;
+
+  // Broadcast the search character to all lanes of `search_vec`.
+  __ imull(CpuRegister(TMP), search_value, Immediate(compressed ? 0x01010101 : 0x00010001));
+  __ movd(search_vec, CpuRegister(TMP), /* is64bit= */ false);
+  __ pshufd(search_vec, search_vec, Immediate(0));
+
+  NearLabel loop, found, tail;
+  __ Bind(&loop);
+  __ cmpl(counter, Immediate(chars_per_chunk));
+  __ j(kBelow, &tail);
+  __ movdqu(data_vec, Address(string_obj, 0));
+  if (compressed) {
+    __ pcmpeqb(data_vec, search_vec);
+  } else {
+    __ pcmpeqw(data_vec, search_vec);
+  }
+  __ pmovmskb(CpuRegister(TMP), data_vec);
+  __ testl(CpuRegister(TMP), CpuRegister(TMP));
+  __ j(kNotZero, &found);
+  __ addq(string_obj, Immediate(16));
+  __ subl(counter, Immediate(chars_per_chunk));
+  __ jmp(&loop);
+
+  // A match is somewhere in the current chunk; `TMP` holds a bit per matching byte.
+  __ Bind(&found);
+  __ bsfl(CpuRegister(TMP), CpuRegister(TMP));
+  if (!compressed) {
+    // Convert the byte offset of the match into a character offset.
+    __ shrl(CpuRegister(TMP), Immediate(1));
+  }
+  // The chunk starts at character index string_length - counter within the string.
+  __ subl(string_length, counter);
+  __ leal(out, Address(string_length, CpuRegister(TMP), ScaleFactor::TIMES_1, 0));
+  __ jmp(done_label);
+
+  // Fewer characters remain than fit in a chunk. A zero count would leave the flags stale
+  // after repne scas{b,w}, so check for it explicitly.
+  __ Bind(&tail);
+  __ testl(counter, counter);
+  __ j(kEqual, not_found_label);
+  if (compressed) {
+    __ repne_scasb();
+  } else {
+    __ repne_scasw();
+  }
+  __ j(kNotEqual, not_found_label);
+
+  // Matched: scas has consumed the matching character and decremented the counter.
+  __ subl(string_length, counter);
+  __ leal(out, Address(string_length, -1));
+  __ jmp(done_label);
 }
 
 static void GenerateStringIndexOf(HInvoke* invoke,
@@ -1426,7 +1501,7 @@ static void GenerateStringIndexOf(HInvoke* invoke,
 
   // Do a zero-length check. Even with string compression `count == 0` means empty.
   // TODO: Support jecxz.
-  NearLabel not_found_label;
+  Label not_found_label;
   __ testl(string_length, string_length);
   __ j(kEqual, &not_found_label);
 
@@ -1472,35 +1547,57 @@ static void GenerateStringIndexOf(HInvoke* invoke,
     __ leaq(counter, Address(string_length, counter, ScaleFactor::TIMES_1, 0));
   }
 
+  XmmRegister search_vec = locations->GetTemp(2).AsFpuRegister<XmmRegister>();
+  XmmRegister data_vec = locations->GetTemp(3).AsFpuRegister<XmmRegister>();
+
+  Label done;
   if (mirror::kUseStringCompression) {
     NearLabel uncompressed_string_comparison;
-    NearLabel comparison_done;
     __ testl(CpuRegister(TMP), Immediate(1));
     __ j(kNotZero, &uncompressed_string_comparison);
     // Check if RAX (search_value) is ASCII.
     __ cmpl(search_value, Immediate(127));
     __ j(kGreater, &not_found_label);
-    // Comparing byte-per-byte.
-    __ repne_scasb();
-    __ jmp(&comparison_done);
-    // Everything is set up for repne scasw:
+    // Scan byte-per-byte.
+    GenerateStringIndexOfVectorScan(assembler,
+                                    /* compressed= */ true,
+                                    string_obj,
+                                    search_value,
+                                    counter,
+                                    string_length,
+                                    out,
+                                    search_vec,
+                                    data_vec,
+                                    &not_found_label,
+                                    &done);
+    // Everything is set up for the char scan:
     //   * Comparison address in RDI.
     //   * Counter in ECX.
     __ Bind(&uncompressed_string_comparison);
-    __ repne_scasw();
-    __ Bind(&comparison_done);
+    GenerateStringIndexOfVectorScan(assembler,
+                                    /* compressed= */ false,
+                                    string_obj,
+                                    search_value,
+                                    counter,
+                                    string_length,
+                                    out,
+                                    search_vec,
+                                    data_vec,
+                                    &not_found_label,
+                                    &done);
   } else {
-    __ repne_scasw();
+    GenerateStringIndexOfVectorScan(assembler,
+                                    /* compressed= */ false,
+                                    string_obj,
+                                    search_value,
+                                    counter,
+                                    string_length,
+                                    out,
+                                    search_vec,
+                                    data_vec,
+                                    &not_found_label,
+                                    &done);
   }
-  // Did we find a match?
-  __ j(kNotEqual, &not_found_label);
-
-  // Yes, we matched.  Compute the index of the result.
-  __ subl(string_length, counter);
-  __ leal(out, Address(string_length, -1));
-
-  NearLabel done;
-  __ jmp(&done);
 
   // Failed to match; return -1.
   __ Bind(&not_found_label);
@@ -2742,6 +2839,8 @@ void IntrinsicLocationsBuilderX86_64::VisitReachabilityFence(HInvoke* invoke) {
 
 void IntrinsicCodeGeneratorX86_64::VisitReachabilityFence(HInvoke* invoke ATTRIBUTE_UNUSED) { }
 
+UNIMPLEMENTED_INTRINSIC(X86_64, ArraysFillInt)
+UNIMPLEMENTED_INTRINSIC(X86_64, ArraysHashCodeInt)
 UNIMPLEMENTED_INTRINSIC(X86_64, ReferenceGetReferent)
 UNIMPLEMENTED_INTRINSIC(X86_64, FloatIsInfinite)
 UNIMPLEMENTED_INTRINSIC(X86_64, DoubleIsInfinite)
@@ -2757,6 +2856,9 @@ UNIMPLEMENTED_INTRINSIC(X86_64, FP16Greater)
 UNIMPLEMENTED_INTRINSIC(X86_64, FP16GreaterEquals)
 UNIMPLEMENTED_INTRINSIC(X86_64, FP16Less)
 UNIMPLEMENTED_INTRINSIC(X86_64, FP16LessEquals)
+UNIMPLEMENTED_INTRINSIC(X86_64, FP16Compare)
+UNIMPLEMENTED_INTRINSIC(X86_64, FP16Min)
+UNIMPLEMENTED_INTRINSIC(X86_64, FP16Max)
 
 UNIMPLEMENTED_INTRINSIC(X86_64, StringStringIndexOf);
 UNIMPLEMENTED_INTRINSIC(X86_64, StringStringIndexOfAfter);
@@ -2783,6 +2885,40 @@ UNIMPLEMENTED_INTRINSIC(X86_64, UnsafeGetAndSetInt)
 UNIMPLEMENTED_INTRINSIC(X86_64, UnsafeGetAndSetLong)
 UNIMPLEMENTED_INTRINSIC(X86_64, UnsafeGetAndSetObject)
 
+UNIMPLEMENTED_INTRINSIC(X86_64, MethodHandleInvokeExact)
+UNIMPLEMENTED_INTRINSIC(X86_64, MethodHandleInvoke)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleCompareAndExchange)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleCompareAndExchangeAcquire)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleCompareAndExchangeRelease)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleCompareAndSet)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGet)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGetAcquire)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGetAndAdd)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGetAndAddAcquire)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGetAndAddRelease)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGetAndBitwiseAnd)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGetAndBitwiseAndAcquire)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGetAndBitwiseAndRelease)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGetAndBitwiseOr)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGetAndBitwiseOrAcquire)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGetAndBitwiseOrRelease)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGetAndBitwiseXor)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGetAndBitwiseXorAcquire)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGetAndBitwiseXorRelease)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGetAndSet)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGetAndSetAcquire)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGetAndSetRelease)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGetOpaque)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleGetVolatile)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleSet)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleSetOpaque)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleSetRelease)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleSetVolatile)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleWeakCompareAndSet)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleWeakCompareAndSetAcquire)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleWeakCompareAndSetPlain)
+UNIMPLEMENTED_INTRINSIC(X86_64, VarHandleWeakCompareAndSetRelease)
+
 UNREACHABLE_INTRINSICS(X86_64)
 
 #undef __
@@ -16,10 +16,15 @@
 
 #include "licm.h"
 
+#include "load_store_analysis.h"
 #include "side_effects_analysis.h"
 
 namespace art {
 
+// A cap for the number of heap locations to prevent pathological time/space
+// consumption, mirroring the limit used by load/store elimination.
+static constexpr size_t kMaxNumberOfHeapLocations = 32;
+
 static bool IsPhiOf(HInstruction* instruction, HBasicBlock* block) {
   return instruction->IsPhi() && instruction->GetBlock() == block;
 }
@@ -61,6 +66,52 @@ static bool InputsAreDefinedBeforeLoop(HInstruction* instruction) {
   return true;
 }
 
+/**
+ * Returns whether any write inside the loop may alias the heap location read
+ * by the given invariant instance field get. The coarse per-type side effects
+ * block hoisting whenever any field of the same type is written in the loop;
+ * heap locations can often prove that those writes never touch the field of
+ * this receiver, e.g. when the receiver does not escape.
+ */
+static bool MayLoopWritesAliasFieldGet(const HeapLocationCollector& heap_location_collector,
+                                       HLoopInformation* loop_info,
+                                       HInstruction* instruction) {
+  size_t read_location = heap_location_collector.GetFieldHeapLocation(
+      instruction->InputAt(0), &instruction->AsInstanceFieldGet()->GetFieldInfo());
+  if (read_location == HeapLocationCollector::kHeapLocationNotFound) {
+    return true;
+  }
+  for (HBlocksInLoopIterator it_loop(*loop_info); !it_loop.Done(); it_loop.Advance()) {
+    for (HInstructionIterator inst_it(it_loop.Current()->GetInstructions());
+         !inst_it.Done();
+         inst_it.Advance()) {
+      HInstruction* write = inst_it.Current();
+      if (!write->DoesAnyWrite()) {
+        continue;
+      }
+      size_t write_location = HeapLocationCollector::kHeapLocationNotFound;
+      if (write->IsInstanceFieldSet()) {
+        write_location = heap_location_collector.GetFieldHeapLocation(
+            write->InputAt(0), &write->AsInstanceFieldSet()->GetFieldInfo());
+      } else if (write->IsStaticFieldSet()) {
+        write_location = heap_location_collector.GetFieldHeapLocation(
+            write->InputAt(0), &write->AsStaticFieldSet()->GetFieldInfo());
+      } else if (write->IsArraySet()) {
+        // An array element never overlaps an instance field.
+        continue;
+      } else {
+        // An unanalyzable write, e.g. an invoke.
+        return true;
+      }
+      if (write_location == HeapLocationCollector::kHeapLocationNotFound ||
+          heap_location_collector.MayAlias(read_location, write_location)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 /**
  * If `environment` has a loop header phi, we replace it with its first input.
  */
@@ -82,6 +133,31 @@ bool LICM::Run() {
   bool didLICM = false;
   DCHECK(side_effects_.HasRun());
 
+  // Heap locations are collected lazily, only when the first candidate field
+  // get is blocked by the coarse side effects. Volatile accesses and monitor
+  // operations impose ordering on unrelated locations, so no refinement is
+  // attempted in their presence (same restriction as load/store elimination).
+  HeapLocationCollector heap_location_collector(graph_);
+  bool heap_locations_computed = false;
+  bool heap_locations_usable = false;
+  auto ensure_heap_locations = [&]() {
+    if (!heap_locations_computed) {
+      heap_locations_computed = true;
+      for (HBasicBlock* b : graph_->GetReversePostOrder()) {
+        heap_location_collector.VisitBasicBlock(b);
+      }
+      if (heap_location_collector.GetNumberOfHeapLocations() <= kMaxNumberOfHeapLocations &&
+          !heap_location_collector.HasVolatile() &&
+          !heap_location_collector.HasMonitorOps()) {
+        heap_location_collector.BuildAliasingMatrix();
+        heap_locations_usable = true;
+      } else {
+        heap_location_collector.CleanUp();
+      }
+    }
+    return heap_locations_usable;
+  };
+
   // Only used during debug.
   ArenaBitVector* visited = nullptr;
   if (kIsDebugBuild) {
@@ -146,6 +222,12 @@ bool LICM::Run() {
             }
           } else if (!instruction->GetSideEffects().MayDependOn(loop_effects)) {
             can_move = true;
+          } else if (instruction->IsInstanceFieldGet() &&
+                     ensure_heap_locations() &&
+                     !MayLoopWritesAliasFieldGet(heap_location_collector, loop_info, instruction)) {
+            // The loop writes memory of the same coarse type, but heap
+            // locations prove none of the writes can alias this field.
+            can_move = true;
           }
         }
         if (can_move) {
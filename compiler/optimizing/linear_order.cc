@@ -54,6 +54,18 @@ static void AddToListForLinearization(ScopedArenaVector<HBasicBlock*>* worklist,
   worklist->insert(insert_pos.base(), block);
 }
 
+// Returns whether `block` is only executed when an exception has been thrown
+// or is about to be thrown. Such blocks are given the lowest priority once
+// ready, so they sink towards the end of the method and hot code stays dense
+// in the instruction cache. Blocks in loops keep their position: loop blocks
+// must remain consecutive in the linear order.
+static bool IsColdBlock(HBasicBlock* block) {
+  if (IsLoop(block->GetLoopInformation())) {
+    return false;
+  }
+  return block->IsCatchBlock() || block->GetLastInstruction()->IsThrow();
+}
+
 // Helper method to validate linear order.
 static bool IsLinearOrderWellFormed(const HGraph* graph, ArrayRef<HBasicBlock*> linear_order) {
   for (HBasicBlock* header : graph->GetBlocks()) {
@@ -120,7 +132,15 @@ void LinearizeGraphInternal(const HGraph* graph, ArrayRef<HBasicBlock*> linear_o
       int block_id = successor->GetBlockId();
       size_t number_of_remaining_predecessors = forward_predecessors[block_id];
       if (number_of_remaining_predecessors == 1) {
-        AddToListForLinearization(&worklist, successor);
+        if (IsColdBlock(successor)) {
+          // The front of the worklist is processed last, so cold blocks are
+          // emitted as late as the blocks depending on them allow. This keeps
+          // the resulting order a valid topological order: a block is only
+          // ever delayed, never emitted before one of its predecessors.
+          worklist.insert(worklist.begin(), successor);
+        } else {
+          AddToListForLinearization(&worklist, successor);
+        }
       }
       forward_predecessors[block_id] = number_of_remaining_predecessors - 1;
     }
@@ -103,7 +103,8 @@ class LSEVisitor : public HGraphDelegateVisitor {
         removed_loads_(allocator_.Adapter(kArenaAllocLSE)),
         substitute_instructions_for_loads_(allocator_.Adapter(kArenaAllocLSE)),
         possibly_removed_stores_(allocator_.Adapter(kArenaAllocLSE)),
-        singleton_new_instances_(allocator_.Adapter(kArenaAllocLSE)) {
+        singleton_new_instances_(allocator_.Adapter(kArenaAllocLSE)),
+        created_merge_phis_(allocator_.Adapter(kArenaAllocLSE)) {
   }
 
   void VisitBasicBlock(HBasicBlock* block) override {
@@ -239,6 +240,17 @@ class LSEVisitor : public HGraphDelegateVisitor {
       store->GetBlock()->RemoveInstruction(store);
     }
 
+    // Prune merge phis that did not end up substituting any load. Iterate in
+    // reverse creation order so that removing a dead phi can make an earlier
+    // phi it uses dead as well.
+    for (auto it = created_merge_phis_.rbegin(); it != created_merge_phis_.rend(); ++it) {
+      HPhi* phi = *it;
+      DCHECK(!phi->HasEnvironmentUses());
+      if (!phi->HasUses()) {
+        phi->GetBlock()->RemovePhi(phi);
+      }
+    }
+
     // Eliminate singleton-classified instructions:
     //   * - Constructor fences (they never escape this thread).
     //   * - Allocations (if they are unused).
@@ -251,11 +263,43 @@ class LSEVisitor : public HGraphDelegateVisitor {
       if (!new_instance->HasNonEnvironmentUses()) {
         new_instance->RemoveEnvironmentUsers();
         new_instance->GetBlock()->RemoveInstruction(new_instance);
+        MaybeRecordStat(stats_, MethodCompilationStat::kRemovedAllocation);
+      } else if (OnlyUsedByStoresIntoSingleton(new_instance)) {
+        // The allocation is kept alive only by stores into itself, e.g. stores
+        // that were conservatively kept because their values merge at a loop
+        // header. All loads from the singleton have been substituted at this
+        // point and the reference never escapes the method, so neither the
+        // stores nor the allocation can be observed; remove them all.
+        while (new_instance->HasNonEnvironmentUses()) {
+          HInstruction* store = new_instance->GetUses().front().GetUser();
+          store->GetBlock()->RemoveInstruction(store);
+        }
+        new_instance->RemoveEnvironmentUsers();
+        new_instance->GetBlock()->RemoveInstruction(new_instance);
+        MaybeRecordStat(stats_, MethodCompilationStat::kRemovedAllocation);
       }
     }
   }
 
  private:
+  // Returns whether all non-environment uses of `new_instance` are stores into
+  // `new_instance` itself. Since `new_instance` is a removable singleton, such
+  // stores can never be observed once all loads from the singleton have been
+  // substituted: the reference neither escapes the method nor is visible to
+  // HDeoptimize. Stores that may throw or carry an environment are excluded.
+  static bool OnlyUsedByStoresIntoSingleton(HInstruction* new_instance) {
+    for (const HUseListNode<HInstruction*>& use : new_instance->GetUses()) {
+      HInstruction* user = use.GetUser();
+      if (!IsStore(user) ||
+          use.GetIndex() != 0u ||
+          user->CanThrow() ||
+          user->HasEnvironment()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   static bool IsLoad(const HInstruction* instruction) {
     if (instruction == kUnknownHeapValue || instruction == kDefaultHeapValue) {
       return false;
@@ -506,14 +550,58 @@ class LSEVisitor : public HGraphDelegateVisitor {
                merged_value->GetBlock()->Dominates(block));
         if (merged_value != kUnknownHeapValue) {
           heap_values[i] = merged_value;
-        } else {
+        } else if (merged_store_value != kUnknownHeapValue) {
           // Stores in different predecessors may be storing the same value.
           heap_values[i] = merged_store_value;
+        } else {
+          // The predecessors know different values for the location. If every
+          // predecessor still knows a value, merge them with a phi so loads
+          // dominated by this block can be eliminated even though the location
+          // is only overwritten on some of the incoming paths. The stores have
+          // been kept above, so memory stays consistent for any load that
+          // cannot be eliminated.
+          heap_values[i] = TryMergePredecessorValuesAsPhi(block, i);
         }
       }
     }
   }
 
+  // Create a phi merging the values the predecessors of `block` know for heap
+  // location `idx`, or return kUnknownHeapValue if some predecessor does not
+  // know the value, or if a phi cannot be safely created here.
+  HInstruction* TryMergePredecessorValuesAsPhi(HBasicBlock* block, size_t idx) {
+    DataType::Type type = heap_location_collector_.GetHeapLocation(idx)->GetType();
+    if (type == DataType::Type::kReference) {
+      // A new reference phi would lack reference type information.
+      return kUnknownHeapValue;
+    }
+    if (block->IsCatchBlock() || block->IsLoopHeader()) {
+      // Catch phis take vreg inputs, and values coming from back edges are
+      // not known when the loop header is merged.
+      return kUnknownHeapValue;
+    }
+    ArrayRef<HBasicBlock* const> predecessors(block->GetPredecessors());
+    for (HBasicBlock* predecessor : predecessors) {
+      HInstruction* pred_value =
+          GetRealHeapValue(heap_values_for_[predecessor->GetBlockId()][idx]);
+      if (pred_value == kUnknownHeapValue || pred_value == kDefaultHeapValue) {
+        return kUnknownHeapValue;
+      }
+    }
+    ArenaAllocator* allocator = GetGraph()->GetAllocator();
+    HPhi* phi = new (allocator) HPhi(
+        allocator, kNoRegNumber, predecessors.size(), HPhi::ToPhiType(type));
+    for (size_t i = 0; i < predecessors.size(); i++) {
+      HInstruction* pred_value =
+          GetRealHeapValue(heap_values_for_[predecessors[i]->GetBlockId()][idx]);
+      DCHECK(pred_value->GetBlock()->Dominates(predecessors[i]));
+      phi->SetRawInputAt(i, pred_value);
+    }
+    block->AddPhi(phi);
+    created_merge_phis_.push_back(phi);
+    return phi;
+  }
+
   // `instruction` is being removed. Try to see if the null check on it
   // can be removed. This can happen if the same value is set in two branches
   // but not in dominators. Such as:
@@ -920,6 +1008,11 @@ class LSEVisitor : public HGraphDelegateVisitor {
 
   ScopedArenaVector<HInstruction*> singleton_new_instances_;
 
+  // Phis created to merge heap values at control-flow joins where the
+  // location is only overwritten on some incoming paths. Phis that end up
+  // without users are pruned again in RemoveInstructions().
+  ScopedArenaVector<HPhi*> created_merge_phis_;
+
   DISALLOW_COPY_AND_ASSIGN(LSEVisitor);
 };
 
@@ -31,6 +31,9 @@ namespace art {
 // Enables vectorization (SIMDization) in the loop optimizer.
 static constexpr bool kEnableVectorization = true;
 
+// Enables interchange of two-deep rectangular loop nests in the loop optimizer.
+static constexpr bool kEnableLoopInterchange = true;
+
 //
 // Static helpers.
 //
@@ -81,6 +84,155 @@ static bool IsEarlyExit(HLoopInformation* loop_info) {
   return false;
 }
 
+// Representation of the control of a simple counted loop in a candidate nest
+// for interchange, viz. i = init; if (!(i condition bound)) exit; .. i += step.
+struct InterchangeLoopControl {
+  HLoopInformation* loop_info;  // the loop itself
+  HPhi* phi;                    // loop induction
+  HInstruction* add;            // induction update i += step
+  HInstruction* step;           // constant step
+  HCondition* condition;        // loop control condition
+  size_t bound_index;           // input index of the bound within the condition
+  HInstruction* init;           // initial induction value
+  HInstruction* bound;          // loop bound
+};
+
+// Detects a single back-edge loop with a single int32 induction phi and a
+// typical loop header (SuspendCheck; Condition(phi, bound); If), and fills in
+// the control representation used by loop interchange. The induction update
+// must be an add of a constant step used only by the phi itself.
+static bool TrySetInterchangeableLoop(HLoopInformation* loop_info,
+                                      /*out*/ InterchangeLoopControl* control) {
+  if (loop_info->NumberOfBackEdges() != 1) {
+    return false;
+  }
+  HBasicBlock* header = loop_info->GetHeader();
+  HInstruction* first_phi = header->GetFirstPhi();
+  if (first_phi == nullptr || first_phi->GetNext() != nullptr) {
+    return false;
+  }
+  HPhi* phi = first_phi->AsPhi();
+  if (phi->GetType() != DataType::Type::kInt32 || phi->InputCount() != 2u) {
+    return false;
+  }
+  HInstruction* add = phi->InputAt(1);
+  if (!add->IsAdd() ||
+      add->InputAt(0) != phi ||
+      !add->InputAt(1)->IsIntConstant() ||
+      !loop_info->Contains(*add->GetBlock()) ||
+      !add->GetUses().HasExactlyOneElement() ||
+      add->GetUses().front().GetUser() != phi ||
+      add->HasEnvironmentUses()) {
+    return false;
+  }
+  HInstruction* s = header->GetFirstInstruction();
+  if (s == nullptr || !s->IsSuspendCheck()) {
+    return false;
+  }
+  HInstruction* c = s->GetNext();
+  if (c == nullptr ||
+      !c->IsCondition() ||
+      !c->GetUses().HasExactlyOneElement() ||  // only used for termination
+      c->HasEnvironmentUses()) {  // unlikely, but not impossible
+    return false;
+  }
+  HInstruction* i = c->GetNext();
+  if (i == nullptr || !i->IsIf() || i->InputAt(0) != c || i != header->GetLastInstruction()) {
+    return false;
+  }
+  HCondition* condition = c->AsCondition();
+  size_t bound_index = 0;
+  if (condition->InputAt(0) == phi) {
+    bound_index = 1;
+  } else if (condition->InputAt(1) != phi) {
+    return false;
+  }
+  control->loop_info = loop_info;
+  control->phi = phi;
+  control->add = add;
+  control->step = add->InputAt(1);
+  control->condition = condition;
+  control->bound_index = bound_index;
+  control->init = phi->InputAt(0);
+  control->bound = condition->InputAt(bound_index);
+  return true;
+}
+
+// Detects a row selection base[row] feeding two-dimensional accesses, where
+// base is defined outside the nest and row is the inner induction or also
+// defined outside the nest. Such a get only reads row references out of an
+// invariant array and may only be consumed as the array operand of element
+// accesses within the nest.
+static bool IsInterchangeableRowSelect(HInstruction* access,
+                                       HLoopInformation* outer,
+                                       HPhi* inner_phi) {
+  if (!access->IsArrayGet() || access->GetType() != DataType::Type::kReference) {
+    return false;
+  }
+  HInstruction* array = access->InputAt(0);
+  HInstruction* index = access->InputAt(1);
+  if (outer->Contains(*array->GetBlock()) ||
+      (index != inner_phi && outer->Contains(*index->GetBlock())) ||
+      access->HasEnvironmentUses()) {
+    return false;
+  }
+  for (const HUseListNode<HInstruction*>& use : access->GetUses()) {
+    HInstruction* user = use.GetUser();
+    if (!(user->IsArrayGet() || user->IsArraySet()) ||
+        use.GetIndex() != 0u ||
+        !outer->Contains(*user->GetBlock())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Checks whether an array access in the inner loop body has a shape that keeps
+// interchange of the nest legal. Accepted shapes are base[column] and
+// base[row][column] for a non-reference element type, where base is invariant
+// in the nest, row is the inner induction or invariant, and column is the
+// outer induction itself. Any two such element accesses that can touch the
+// same memory then agree on the outer induction value, so no dependence in the
+// nest can have its direction reversed by the interchange. Accesses through a
+// row that varies with the inner induction currently stride across rows and
+// become unit stride once interchanged; their presence is returned in
+// found_strided_access to establish profitability.
+static bool IsInterchangeableArrayAccess(HInstruction* access,
+                                         HLoopInformation* outer,
+                                         HPhi* outer_phi,
+                                         HPhi* inner_phi,
+                                         /*out*/ bool* found_strided_access) {
+  DCHECK(access->IsArrayGet() || access->IsArraySet());
+  if (access->IsArrayGet() && access->GetType() == DataType::Type::kReference) {
+    // A reference-typed get may only be the row selection of an access chain.
+    return IsInterchangeableRowSelect(access, outer, inner_phi);
+  }
+  if (access->IsArrayGet() && access->AsArrayGet()->IsStringCharAt()) {
+    return false;
+  }
+  if (access->IsArraySet() &&
+      access->AsArraySet()->GetComponentType() == DataType::Type::kReference) {
+    // A stored row reference could make the base array alias a row.
+    return false;
+  }
+  // The element access must step along the same column in every row: the
+  // column index is the outer induction itself.
+  if (access->InputAt(1) != outer_phi) {
+    return false;
+  }
+  HInstruction* array = access->InputAt(0);
+  if (!outer->Contains(*array->GetBlock())) {
+    return true;  // one-dimensional access of an invariant array
+  }
+  if (IsInterchangeableRowSelect(array, outer, inner_phi)) {
+    if (array->InputAt(1) == inner_phi) {
+      *found_strided_access = true;  // inner loop currently strides across rows
+    }
+    return true;
+  }
+  return false;
+}
+
 // Forward declaration.
 static bool IsZeroExtensionAndGet(HInstruction* instruction,
                                   DataType::Type type,
@@ -611,6 +763,14 @@ void HLoopOptimization::RemoveLoop(LoopNode* node) {
 bool HLoopOptimization::TraverseLoopsInnerToOuter(LoopNode* node) {
   bool changed = false;
   for ( ; node != nullptr; node = node->next) {
+    // Try to interchange a two-deep perfect nest before the inner loop is
+    // optimized, so that a unit-stride array walk carried by the outer loop
+    // ends up innermost where the vectorizer can exploit it.
+    if (TryLoopInterchange(node)) {
+      induction_range_.ReVisit(node->inner->loop_info);
+      induction_range_.ReVisit(node->loop_info);
+      changed = true;
+    }
     // Visit inner loops first. Recompute induction information for this
     // loop if the induction of any inner loop has changed.
     if (TraverseLoopsInnerToOuter(node->inner)) {
@@ -781,6 +941,162 @@ bool HLoopOptimization::OptimizeInnerLoop(LoopNode* node) {
   return TryOptimizeInnerLoopFinite(node) || TryPeelingAndUnrolling(node);
 }
 
+//
+// Loop interchange.
+//
+
+bool HLoopOptimization::TryLoopInterchange(LoopNode* node) {
+  // Candidate must be a two-deep nest: exactly one inner loop, itself innermost.
+  if (!kEnableLoopInterchange ||
+      node->inner == nullptr ||
+      node->inner->next != nullptr ||
+      node->inner->inner != nullptr) {
+    return false;
+  }
+  // Interchange reorders the iterations of the nest. Resuming interpretation
+  // somewhere in the middle of an interchanged nest would repeat and skip
+  // iterations, so debuggable and OSR compilations are excluded, and the nest
+  // itself may not contain any throwing instructions or deoptimization points.
+  if (graph_->IsDebuggable() || graph_->IsCompilingOsr()) {
+    return false;
+  }
+  HLoopInformation* outer = node->loop_info;
+  HLoopInformation* inner = node->inner->loop_info;
+  InterchangeLoopControl outer_control;
+  InterchangeLoopControl inner_control;
+  if (!TrySetInterchangeableLoop(outer, &outer_control) ||
+      !TrySetInterchangeableLoop(inner, &inner_control)) {
+    return false;
+  }
+  // Requiring the same condition kind and operand order keeps the loop
+  // controls valid once the bounds are exchanged.
+  if (outer_control.condition->GetCondition() != inner_control.condition->GetCondition() ||
+      outer_control.bound_index != inner_control.bound_index) {
+    return false;
+  }
+  // The nest must be rectangular: the inner iteration range may not depend on
+  // anything computed inside the outer loop.
+  if (outer->Contains(*inner_control.init->GetBlock()) ||
+      outer->Contains(*inner_control.bound->GetBlock())) {
+    return false;
+  }
+  // The nest must be perfect. The inner loop consists of its header and a
+  // single body block, and the outer loop contributes nothing but glue blocks
+  // around the inner loop that only advance its own induction.
+  HBasicBlock* inner_body = nullptr;
+  for (HBlocksInLoopIterator it(*inner); !it.Done(); it.Advance()) {
+    if (it.Current() != inner->GetHeader()) {
+      if (inner_body != nullptr) {
+        return false;
+      }
+      inner_body = it.Current();
+    }
+  }
+  if (inner_body == nullptr || !inner_body->GetPhis().IsEmpty()) {
+    return false;
+  }
+  for (HBlocksInLoopIterator it(*outer); !it.Done(); it.Advance()) {
+    HBasicBlock* block = it.Current();
+    if (block == outer->GetHeader() || inner->Contains(*block)) {
+      continue;
+    }
+    if (!block->GetPhis().IsEmpty()) {
+      return false;
+    }
+    for (HInstructionIterator inst_it(block->GetInstructions()); !inst_it.Done();
+         inst_it.Advance()) {
+      HInstruction* instruction = inst_it.Current();
+      if (!instruction->IsGoto() && instruction != outer_control.add) {
+        return false;
+      }
+    }
+  }
+  // Scan the inner loop body. Only straight-line side-effect free code and
+  // array accesses that keep every dependence direction non-negative under
+  // interchange are accepted (see IsInterchangeableArrayAccess). At least one
+  // access must actually stride across rows for the interchange to pay off.
+  bool found_strided_access = false;
+  for (HInstructionIterator it(inner_body->GetInstructions()); !it.Done(); it.Advance()) {
+    HInstruction* instruction = it.Current();
+    if (instruction->IsGoto() || instruction == inner_control.add) {
+      continue;
+    }
+    if (instruction->CanThrow() || instruction->HasEnvironment()) {
+      return false;
+    }
+    if (instruction->IsArrayGet() || instruction->IsArraySet()) {
+      if (!IsInterchangeableArrayAccess(instruction,
+                                        outer,
+                                        outer_control.phi,
+                                        inner_control.phi,
+                                        &found_strided_access)) {
+        return false;
+      }
+    } else if (!instruction->GetSideEffects().DoesNothing()) {
+      return false;
+    }
+  }
+  if (!found_strided_access) {
+    return false;
+  }
+  // Snapshot all remaining regular uses of the two inductions before any
+  // rewriting, and reject inductions that are live beyond the nest, since
+  // their final values change under interchange. Environment uses within the
+  // nest (only the suspend checks of the two headers can hold them here) are
+  // left in place: the recorded induction values become stale, which is not
+  // observable without deoptimization, which is excluded above.
+  ScopedArenaVector<std::pair<HInstruction*, size_t>> outer_phi_uses(
+      loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+  ScopedArenaVector<std::pair<HInstruction*, size_t>> inner_phi_uses(
+      loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+  for (const HUseListNode<HInstruction*>& use : outer_control.phi->GetUses()) {
+    HInstruction* user = use.GetUser();
+    if (user != outer_control.add && user != outer_control.condition) {
+      if (!outer->Contains(*user->GetBlock())) {
+        return false;
+      }
+      outer_phi_uses.emplace_back(user, use.GetIndex());
+    }
+  }
+  for (const HUseListNode<HInstruction*>& use : inner_control.phi->GetUses()) {
+    HInstruction* user = use.GetUser();
+    if (user != inner_control.add && user != inner_control.condition) {
+      if (!outer->Contains(*user->GetBlock())) {
+        return false;
+      }
+      inner_phi_uses.emplace_back(user, use.GetIndex());
+    }
+  }
+  for (const HUseListNode<HEnvironment*>& use : outer_control.phi->GetEnvUses()) {
+    if (!outer->Contains(*use.GetUser()->GetHolder()->GetBlock())) {
+      return false;
+    }
+  }
+  for (const HUseListNode<HEnvironment*>& use : inner_control.phi->GetEnvUses()) {
+    if (!outer->Contains(*use.GetUser()->GetHolder()->GetBlock())) {
+      return false;
+    }
+  }
+  // Perform the interchange as a renaming: exchange the iteration ranges of
+  // the two inductions and then exchange all remaining uses of the two phis.
+  // The control flow graph itself is unchanged; the outer loop now runs the
+  // inner iteration space and vice versa.
+  outer_control.phi->ReplaceInput(inner_control.init, 0u);
+  inner_control.phi->ReplaceInput(outer_control.init, 0u);
+  outer_control.add->ReplaceInput(inner_control.step, 1u);
+  inner_control.add->ReplaceInput(outer_control.step, 1u);
+  outer_control.condition->ReplaceInput(inner_control.bound, outer_control.bound_index);
+  inner_control.condition->ReplaceInput(outer_control.bound, inner_control.bound_index);
+  for (const std::pair<HInstruction*, size_t>& use : outer_phi_uses) {
+    use.first->ReplaceInput(inner_control.phi, use.second);
+  }
+  for (const std::pair<HInstruction*, size_t>& use : inner_phi_uses) {
+    use.first->ReplaceInput(outer_control.phi, use.second);
+  }
+  MaybeRecordStat(stats_, MethodCompilationStat::kLoopInterchanged);
+  return true;
+}
+
 
 
 //
@@ -144,6 +144,12 @@ class HLoopOptimization : public HOptimization {
   // Performs optimizations specific to inner loop. Returns true if anything changed.
   bool OptimizeInnerLoop(LoopNode* node);
 
+  // Tries to interchange the loops of a perfect two-deep rectangular nest rooted
+  // at node, so that a unit-stride array walk carried by the outer loop becomes
+  // the innermost loop where vectorization can exploit it. Returns whether the
+  // loops were interchanged.
+  bool TryLoopInterchange(LoopNode* node);
+
   // Tries to apply loop unrolling for branch penalty reduction and better instruction scheduling
   // opportunities. Returns whether transformation happened. 'generate_code' determines whether the
   // optimization should be actually applied.
@@ -3242,11 +3242,12 @@ static inline IntrinsicExceptions GetExceptionsIntrinsic(Intrinsics i) {
 }
 
 void HInvoke::SetResolvedMethod(ArtMethod* method) {
-  // TODO: b/65872996 The intent is that polymorphic signature methods should
-  // be compiler intrinsics. At present, they are only interpreter intrinsics.
+  // Signature-polymorphic methods are intrinsics only when reached through their
+  // dedicated invoke-polymorphic instruction; a plain invoke to such a method
+  // (e.g. through reflection) must keep the default dispatch.
   if (method != nullptr &&
       method->IsIntrinsic() &&
-      !method->IsPolymorphicSignature()) {
+      (!method->IsPolymorphicSignature() || IsInvokePolymorphic())) {
     Intrinsics intrinsic = static_cast<Intrinsics>(method->GetIntrinsic());
     SetIntrinsic(intrinsic,
                  NeedsEnvironmentOrCacheIntrinsic(intrinsic),
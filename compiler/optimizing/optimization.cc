@@ -55,6 +55,7 @@
 #include "select_generator.h"
 #include "sharpening.h"
 #include "side_effects_analysis.h"
+#include "superword_vectorization.h"
 
 // Decide between default or alternative pass name.
 
@@ -96,6 +97,8 @@ const char* OptimizationPassName(OptimizationPass pass) {
       return ConstructorFenceRedundancyElimination::kCFREPassName;
     case OptimizationPass::kScheduling:
       return HInstructionScheduling::kInstructionSchedulingPassName;
+    case OptimizationPass::kSuperwordVectorization:
+      return HSuperwordVectorization::kSuperwordVectorizationPassName;
 #ifdef ART_ENABLE_CODEGEN_arm
     case OptimizationPass::kInstructionSimplifierArm:
       return arm::InstructionSimplifierArm::kInstructionSimplifierArmPassName;
@@ -144,6 +147,7 @@ OptimizationPass OptimizationPassByName(const std::string& pass_name) {
   X(OptimizationPass::kScheduling);
   X(OptimizationPass::kSelectGenerator);
   X(OptimizationPass::kSideEffectsAnalysis);
+  X(OptimizationPass::kSuperwordVectorization);
 #ifdef ART_ENABLE_CODEGEN_arm
   X(OptimizationPass::kInstructionSimplifierArm);
 #endif
@@ -271,6 +275,10 @@ ArenaVector<HOptimization*> ConstructOptimizations(
         opt = new (allocator) HInstructionScheduling(
             graph, codegen->GetCompilerOptions().GetInstructionSet(), codegen, pass_name);
         break;
+      case OptimizationPass::kSuperwordVectorization:
+        opt = new (allocator) HSuperwordVectorization(
+            graph, &codegen->GetCompilerOptions(), stats, pass_name);
+        break;
       //
       // Arch-specific passes.
       //
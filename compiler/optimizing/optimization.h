@@ -83,6 +83,7 @@ enum class OptimizationPass {
   kScheduling,
   kSelectGenerator,
   kSideEffectsAnalysis,
+  kSuperwordVectorization,
 #ifdef ART_ENABLE_CODEGEN_arm
   kInstructionSimplifierArm,
 #endif
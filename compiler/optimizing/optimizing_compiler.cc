@@ -30,6 +30,7 @@
 #include "base/macros.h"
 #include "base/mutex.h"
 #include "base/scoped_arena_allocator.h"
+#include "base/time_utils.h"
 #include "base/timing_logger.h"
 #include "builder.h"
 #include "class_root.h"
@@ -107,6 +108,7 @@ class PassObserver : public ValueObject {
   PassObserver(HGraph* graph,
                CodeGenerator* codegen,
                std::ostream* visualizer_output,
+               std::ostream* compile_profile_output,
                const CompilerOptions& compiler_options,
                Mutex& dump_mutex)
       : graph_(graph),
@@ -120,6 +122,12 @@ class PassObserver : public ValueObject {
         visualizer_enabled_(!compiler_options.GetDumpCfgFileName().empty()),
         visualizer_(&visualizer_oss_, graph, *codegen),
         visualizer_dump_mutex_(dump_mutex),
+        compile_profile_oss_(),
+        compile_profile_output_(compile_profile_output),
+        compile_profile_enabled_(compile_profile_output != nullptr),
+        method_start_ns_(compile_profile_enabled_ ? NanoTime() : 0u),
+        pass_start_ns_(0u),
+        pass_start_arena_bytes_(0u),
         graph_in_bad_state_(false) {
     if (timing_logger_enabled_ || visualizer_enabled_) {
       if (!IsVerboseMethod(compiler_options, GetMethodName())) {
@@ -137,6 +145,9 @@ class PassObserver : public ValueObject {
       LOG(INFO) << "TIMINGS " << GetMethodName();
       LOG(INFO) << Dumpable<TimingLogger>(timing_logger_);
     }
+    if (compile_profile_enabled_) {
+      FlushCompileProfile();
+    }
     if (visualizer_enabled_) {
       FlushVisualizer();
     }
@@ -169,6 +180,10 @@ class PassObserver : public ValueObject {
     if (timing_logger_enabled_) {
       timing_logger_.StartTiming(pass_name);
     }
+    if (compile_profile_enabled_) {
+      pass_start_ns_ = NanoTime();
+      pass_start_arena_bytes_ = graph_->GetAllocator()->BytesAllocated();
+    }
   }
 
   void FlushVisualizer() REQUIRES(!visualizer_dump_mutex_) {
@@ -179,11 +194,34 @@ class PassObserver : public ValueObject {
     visualizer_oss_.clear();
   }
 
+  // Write out this method's compile profile record as one JSON object per line
+  // so that the artifact can be processed with line-oriented tools.
+  void FlushCompileProfile() REQUIRES(!visualizer_dump_mutex_) {
+    uint64_t total_ns = NanoTime() - method_start_ns_;
+    size_t arena_bytes = graph_->GetAllocator()->BytesAllocated();
+    MutexLock mu(Thread::Current(), visualizer_dump_mutex_);
+    *compile_profile_output_ << "{\"method\":\"" << GetMethodName() << "\""
+                             << ",\"total_ns\":" << total_ns
+                             << ",\"arena_bytes\":" << arena_bytes
+                             << ",\"passes\":[" << compile_profile_oss_.str() << "]}\n";
+    compile_profile_output_->flush();
+  }
+
   void EndPass(const char* pass_name, bool pass_change) {
     // Pause timer first, then dump graph.
     if (timing_logger_enabled_) {
       timing_logger_.EndTiming();
     }
+    if (compile_profile_enabled_) {
+      uint64_t pass_ns = NanoTime() - pass_start_ns_;
+      size_t pass_arena_bytes = graph_->GetAllocator()->BytesAllocated() - pass_start_arena_bytes_;
+      if (compile_profile_oss_.tellp() != 0) {
+        compile_profile_oss_ << ",";
+      }
+      compile_profile_oss_ << "{\"name\":\"" << pass_name << "\""
+                           << ",\"ns\":" << pass_ns
+                           << ",\"arena_bytes\":" << pass_arena_bytes << "}";
+    }
     if (visualizer_enabled_) {
       visualizer_.DumpGraph(pass_name, /* is_after_pass= */ true, graph_in_bad_state_);
     }
@@ -233,6 +271,13 @@ class PassObserver : public ValueObject {
   HGraphVisualizer visualizer_;
   Mutex& visualizer_dump_mutex_;
 
+  std::ostringstream compile_profile_oss_;
+  std::ostream* compile_profile_output_;
+  bool compile_profile_enabled_;
+  uint64_t method_start_ns_;
+  uint64_t pass_start_ns_;
+  size_t pass_start_arena_bytes_;
+
   // Flag to be set by the compiler if the pass failed and the graph is not
   // expected to validate.
   bool graph_in_bad_state_;
@@ -412,7 +457,9 @@ class OptimizingCompiler final : public Compiler {
 
   std::unique_ptr<std::ostream> visualizer_output_;
 
-  mutable Mutex dump_mutex_;  // To synchronize visualizer writing.
+  std::unique_ptr<std::ostream> compile_profile_output_;
+
+  mutable Mutex dump_mutex_;  // To synchronize visualizer and compile profile writing.
 
   DISALLOW_COPY_AND_ASSIGN(OptimizingCompiler);
 };
@@ -430,6 +477,11 @@ OptimizingCompiler::OptimizingCompiler(const CompilerOptions& compiler_options,
         compiler_options.GetDumpCfgAppend() ? std::ofstream::app : std::ofstream::out;
     visualizer_output_.reset(new std::ofstream(cfg_file_name, cfg_file_mode));
   }
+  // Enable structured compile profile output.
+  const std::string& compile_profile_file_name = compiler_options.GetDumpCompileProfileFileName();
+  if (!compile_profile_file_name.empty()) {
+    compile_profile_output_.reset(new std::ofstream(compile_profile_file_name));
+  }
   if (compiler_options.GetDumpStats()) {
     compilation_stats_.reset(new OptimizingCompilerStats());
   }
@@ -545,7 +597,8 @@ bool OptimizingCompiler::RunArchOptimizations(HGraph* graph,
         OptDef(OptimizationPass::kInstructionSimplifierX86_64),
         OptDef(OptimizationPass::kSideEffectsAnalysis),
         OptDef(OptimizationPass::kGlobalValueNumbering, "GVN$after_arch"),
-        OptDef(OptimizationPass::kX86MemoryOperandGeneration)
+        OptDef(OptimizationPass::kX86MemoryOperandGeneration),
+        OptDef(OptimizationPass::kScheduling)
       };
       return RunOptimizations(graph,
                               codegen,
@@ -656,6 +709,7 @@ void OptimizingCompiler::RunOptimizations(HGraph* graph,
     OptDef(OptimizationPass::kInductionVarAnalysis),
     OptDef(OptimizationPass::kBoundsCheckElimination),
     OptDef(OptimizationPass::kLoopOptimization),
+    OptDef(OptimizationPass::kSuperwordVectorization),
     // Simplification.
     OptDef(OptimizationPass::kConstantFolding,
            "constant_folding$after_bce"),
@@ -826,6 +880,7 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* allocator,
   PassObserver pass_observer(graph,
                              codegen.get(),
                              visualizer_output_.get(),
+                             compile_profile_output_.get(),
                              compiler_options,
                              dump_mutex_);
 
@@ -951,6 +1006,7 @@ CodeGenerator* OptimizingCompiler::TryCompileIntrinsic(
   PassObserver pass_observer(graph,
                              codegen.get(),
                              visualizer_output_.get(),
+                             compile_profile_output_.get(),
                              compiler_options,
                              dump_mutex_);
 
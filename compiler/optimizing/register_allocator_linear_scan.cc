@@ -1024,7 +1024,11 @@ bool RegisterAllocatorLinearScan::AllocateBlockedReg(LiveInterval* current) {
           size_t next_intersection = inactive->FirstIntersectionWith(current);
           if (next_intersection != kNoLifetime) {
             if (inactive->IsFixed()) {
-              LiveInterval* split = Split(current, next_intersection);
+              // Split before the intersection, not at it: SplitBetween moves
+              // the split to a loop boundary when the intersection is inside
+              // a loop `current` enters, so the resolution moves end up
+              // outside the loop body.
+              LiveInterval* split = SplitBetween(current, current->GetStart(), next_intersection);
               DCHECK_NE(split, current);
               AddSorted(unhandled_, split);
             } else {
@@ -34,6 +34,10 @@
 #include "scheduler_arm.h"
 #endif
 
+#ifdef ART_ENABLE_CODEGEN_x86_64
+#include "scheduler_x86_64.h"
+#endif
+
 namespace art {
 
 // Return all combinations of ISA and code generator that are executable on
@@ -417,6 +421,20 @@ TEST_F(SchedulerTest, ArrayAccessAliasingARM) {
 }
 #endif
 
+#if defined(ART_ENABLE_CODEGEN_x86_64)
+TEST_F(SchedulerTest, DependencyGraphAndSchedulerX86_64) {
+  CriticalPathSchedulingNodeSelector critical_path_selector;
+  x86_64::HSchedulerX86_64 scheduler(&critical_path_selector);
+  TestBuildDependencyGraphAndSchedule(&scheduler);
+}
+
+TEST_F(SchedulerTest, ArrayAccessAliasingX86_64) {
+  CriticalPathSchedulingNodeSelector critical_path_selector;
+  x86_64::HSchedulerX86_64 scheduler(&critical_path_selector);
+  TestDependencyGraphOnAliasingArrayAccesses(&scheduler);
+}
+#endif
+
 TEST_F(SchedulerTest, RandomScheduling) {
   //
   // Java source: crafted code to make sure (random) scheduling should get correct result.
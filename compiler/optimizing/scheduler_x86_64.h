@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_SCHEDULER_X86_64_H_
+#define ART_COMPILER_OPTIMIZING_SCHEDULER_X86_64_H_
+
+#include "scheduler.h"
+
+namespace art {
+namespace x86_64 {
+
+// x86-64 instruction latency.
+// We currently assume that all x86-64 CPUs share the same instruction latency list.
+// The values are typical for recent out-of-order cores; as with the other
+// architectures they only need to be accurate relative to each other.
+static constexpr uint32_t kX86_64IntegerOpLatency = 1;
+static constexpr uint32_t kX86_64FloatingPointOpLatency = 4;
+static constexpr uint32_t kX86_64MemoryLoadLatency = 5;
+static constexpr uint32_t kX86_64MemoryStoreLatency = 3;
+
+static constexpr uint32_t kX86_64CallInternalLatency = 10;
+static constexpr uint32_t kX86_64CallLatency = 5;
+
+static constexpr uint32_t kX86_64DivDoubleLatency = 20;
+static constexpr uint32_t kX86_64DivFloatLatency = 14;
+static constexpr uint32_t kX86_64DivIntegerLatency = 26;
+static constexpr uint32_t kX86_64LoadStringInternalLatency = 7;
+static constexpr uint32_t kX86_64MulFloatingPointLatency = 4;
+static constexpr uint32_t kX86_64MulIntegerLatency = 3;
+static constexpr uint32_t kX86_64TypeConversionFloatingPointIntegerLatency = 6;
+
+class SchedulingLatencyVisitorX86_64 : public SchedulingLatencyVisitor {
+ public:
+  // Default visitor for instructions not handled specifically below.
+  void VisitInstruction(HInstruction* ATTRIBUTE_UNUSED) override {
+    last_visited_latency_ = kX86_64IntegerOpLatency;
+  }
+
+// We add a second unused parameter to be able to use this macro like the others
+// defined in `nodes.h`.
+#define FOR_EACH_SCHEDULED_X86_64_INSTRUCTION(M) \
+  M(ArrayGet             , unused)               \
+  M(ArrayLength          , unused)               \
+  M(ArraySet             , unused)               \
+  M(BoundsCheck          , unused)               \
+  M(Div                  , unused)               \
+  M(InstanceFieldGet     , unused)               \
+  M(InstanceOf           , unused)               \
+  M(LoadString           , unused)               \
+  M(Mul                  , unused)               \
+  M(NewArray             , unused)               \
+  M(NewInstance          , unused)               \
+  M(Rem                  , unused)               \
+  M(StaticFieldGet       , unused)               \
+  M(SuspendCheck         , unused)               \
+  M(TypeConversion       , unused)
+
+#define FOR_EACH_SCHEDULED_X86_64_ABSTRACT_INSTRUCTION(M) \
+  M(BinaryOperation      , unused)                        \
+  M(Invoke               , unused)
+
+#define DECLARE_VISIT_INSTRUCTION(type, unused)  \
+  void Visit##type(H##type* instruction) override;
+
+  FOR_EACH_SCHEDULED_X86_64_INSTRUCTION(DECLARE_VISIT_INSTRUCTION)
+  FOR_EACH_SCHEDULED_X86_64_ABSTRACT_INSTRUCTION(DECLARE_VISIT_INSTRUCTION)
+  FOR_EACH_CONCRETE_INSTRUCTION_X86_COMMON(DECLARE_VISIT_INSTRUCTION)
+
+#undef DECLARE_VISIT_INSTRUCTION
+};
+
+class HSchedulerX86_64 : public HScheduler {
+ public:
+  explicit HSchedulerX86_64(SchedulingNodeSelector* selector)
+      : HScheduler(&x86_64_latency_visitor_, selector) {}
+  ~HSchedulerX86_64() override {}
+
+  bool IsSchedulable(const HInstruction* instruction) const override {
+#define CASE_INSTRUCTION_KIND(type, unused) case \
+  HInstruction::InstructionKind::k##type:
+    switch (instruction->GetKind()) {
+      FOR_EACH_CONCRETE_INSTRUCTION_X86_COMMON(CASE_INSTRUCTION_KIND)
+        return true;
+      default:
+        // Note that vector instructions are not listed as schedulable: without
+        // a notion of SIMD register in the compiler we would have to treat
+        // most of them as scheduling barriers (see scheduler_arm64.h), which
+        // defeats the purpose in the vectorized loops they appear in.
+        return HScheduler::IsSchedulable(instruction);
+    }
+#undef CASE_INSTRUCTION_KIND
+  }
+
+ private:
+  SchedulingLatencyVisitorX86_64 x86_64_latency_visitor_;
+  DISALLOW_COPY_AND_ASSIGN(HSchedulerX86_64);
+};
+
+}  // namespace x86_64
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_SCHEDULER_X86_64_H_
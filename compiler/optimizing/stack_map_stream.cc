@@ -16,10 +16,12 @@
 
 #include "stack_map_stream.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "art_method-inl.h"
 #include "base/stl_util.h"
+#include "class_linker.h"
 #include "dex/dex_file_types.h"
 #include "optimizing/optimizing_compiler.h"
 #include "runtime.h"
@@ -197,12 +199,30 @@ void StackMapStream::BeginInlineInfoEntry(ArtMethod* method,
     entry[InlineInfo::kArtMethodHi] = High32Bits(reinterpret_cast<uintptr_t>(method));
     entry[InlineInfo::kArtMethodLo] = Low32Bits(reinterpret_cast<uintptr_t>(method));
   } else {
-    if (dex_pc != static_cast<uint32_t>(-1) && kIsDebugBuild) {
+    uint32_t dex_method_index = method->GetDexMethodIndex();
+    uint32_t dex_file_index_kind = MethodInfo::kSameDexFile;
+    uint32_t dex_file_index = 0u;
+    {
       ScopedObjectAccess soa(Thread::Current());
-      DCHECK(IsSameDexFile(*outer_dex_file, *method->GetDexFile()));
+      if (!IsSameDexFile(*outer_dex_file, *method->GetDexFile())) {
+        // The inliner only allows cross-dex callees from the boot classpath,
+        // whose identity is stable in every runtime using this boot image.
+        // Record which boot classpath dex file the method index refers to.
+        const std::vector<const DexFile*>& boot_class_path =
+            Runtime::Current()->GetClassLinker()->GetBootClassPath();
+        auto it = std::find_if(
+            boot_class_path.begin(),
+            boot_class_path.end(),
+            [&](const DexFile* dex_file) { return IsSameDexFile(*dex_file, *method->GetDexFile()); });
+        DCHECK(dex_pc == static_cast<uint32_t>(-1) || it != boot_class_path.end());
+        if (it != boot_class_path.end()) {
+          dex_file_index_kind = MethodInfo::kBootClassPath;
+          dex_file_index = std::distance(boot_class_path.begin(), it);
+        }
+      }
     }
-    uint32_t dex_method_index = method->GetDexMethodIndex();
-    entry[InlineInfo::kMethodInfoIndex] = method_infos_.Dedup({dex_method_index});
+    entry[InlineInfo::kMethodInfoIndex] =
+        method_infos_.Dedup({dex_method_index, dex_file_index_kind, dex_file_index});
   }
   current_inline_infos_.push_back(entry);
 
@@ -0,0 +1,425 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "superword_vectorization.h"
+
+#include "base/scoped_arena_allocator.h"
+#include "base/scoped_arena_containers.h"
+#include "driver/compiler_options.h"
+
+namespace art {
+
+// Number of lanes packed into one vector. Matches the 128-bit NEON Q registers
+// used by the arm64 vector code generator for 32-bit element types.
+static constexpr size_t kNumberOfLanes = 4;
+
+// Packed element types currently handled. Narrower integral types are computed
+// in int32 with explicit conversions in HIR, which this pass does not unpack.
+static bool IsSupportedPackedType(DataType::Type type) {
+  return type == DataType::Type::kInt32 || type == DataType::Type::kFloat32;
+}
+
+// Element-wise operations currently handled for the given packed type.
+static bool IsSupportedOperation(HInstruction* instruction, DataType::Type type) {
+  if (instruction->GetType() != type) {
+    return false;
+  }
+  switch (instruction->GetKind()) {
+    case HInstruction::kAdd:
+    case HInstruction::kSub:
+    case HInstruction::kMul:
+      return true;
+    case HInstruction::kAnd:
+    case HInstruction::kOr:
+    case HInstruction::kXor:
+      return type == DataType::Type::kInt32;
+    default:
+      return false;
+  }
+}
+
+// Decomposes an array index into an optional non-constant part and a constant
+// offset, viz. i + c, i and c itself.
+static void DecomposeIndex(HInstruction* index,
+                           /*out*/ HInstruction** base,
+                           /*out*/ int64_t* offset) {
+  if (index->IsIntConstant()) {
+    *base = nullptr;
+    *offset = index->AsIntConstant()->GetValue();
+  } else if (index->IsAdd() && index->InputAt(1)->IsIntConstant()) {
+    *base = index->InputAt(0);
+    *offset = index->InputAt(1)->AsIntConstant()->GetValue();
+  } else {
+    *base = index;
+    *offset = 0;
+  }
+}
+
+// One operand position of a packed operation: either a contiguous pack of
+// single-use adjacent loads, or a single scalar replicated into all lanes.
+struct OperandPack {
+  HArrayGet* loads[kNumberOfLanes];  // valid when broadcast is null
+  HInstruction* broadcast;           // scalar replicated into all lanes
+  HInstruction* index_base;          // non-constant part of the lane 0 index
+  int64_t offset;                    // constant part of the lane 0 index
+};
+
+// Matches the given lane operands either as one scalar appearing in every lane
+// or as adjacent single-use loads of a supported type from the same array,
+// with lane k reading offset + k.
+static bool TryMatchOperandPack(HInstruction* const* operands,
+                                HBasicBlock* block,
+                                DataType::Type type,
+                                /*out*/ OperandPack* pack) {
+  bool all_same = true;
+  for (size_t k = 1; k < kNumberOfLanes; k++) {
+    all_same = all_same && operands[k] == operands[0];
+  }
+  if (all_same) {
+    pack->broadcast = operands[0];
+    return true;
+  }
+  pack->broadcast = nullptr;
+  HInstruction* array = nullptr;
+  for (size_t k = 0; k < kNumberOfLanes; k++) {
+    HInstruction* operand = operands[k];
+    if (!operand->IsArrayGet() ||
+        operand->AsArrayGet()->IsStringCharAt() ||
+        operand->GetType() != type ||
+        operand->GetBlock() != block ||
+        !operand->GetUses().HasExactlyOneElement() ||
+        operand->HasEnvironmentUses()) {
+      return false;
+    }
+    HInstruction* index_base = nullptr;
+    int64_t offset = 0;
+    DecomposeIndex(operand->InputAt(1), &index_base, &offset);
+    if (k == 0) {
+      array = operand->InputAt(0);
+      pack->index_base = index_base;
+      pack->offset = offset;
+    } else if (operand->InputAt(0) != array ||
+               index_base != pack->index_base ||
+               offset != pack->offset + static_cast<int64_t>(k)) {
+      return false;
+    }
+    pack->loads[k] = operand->AsArrayGet();
+  }
+  return true;
+}
+
+// Checks that packing the loads does not reorder them across a store of a
+// possibly aliasing element. With the same non-constant index part, identical
+// offset ranges pair each load with the store of its own lane and disjoint
+// ranges cannot overlap even when the arrays alias. Otherwise all loads must
+// already precede the first store.
+static bool IsLoadPackSafe(const OperandPack& pack,
+                           HInstruction* store_index_base,
+                           int64_t store_offset,
+                           HInstruction* first_store) {
+  if (pack.broadcast != nullptr) {
+    return true;
+  }
+  if (pack.index_base == store_index_base) {
+    int64_t lanes = static_cast<int64_t>(kNumberOfLanes);
+    if (pack.offset == store_offset ||
+        pack.offset + lanes <= store_offset ||
+        store_offset + lanes <= pack.offset) {
+      return true;
+    }
+  }
+  for (size_t k = 0; k < kNumberOfLanes; k++) {
+    if (!pack.loads[k]->StrictlyDominates(first_store)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+HSuperwordVectorization::HSuperwordVectorization(HGraph* graph,
+                                                 const CompilerOptions* compiler_options,
+                                                 OptimizingCompilerStats* stats,
+                                                 const char* name)
+    : HOptimization(graph, name, stats),
+      compiler_options_(compiler_options) {}
+
+bool HSuperwordVectorization::Run() {
+  // Only arm64 is wired up for now; NEON is always available there and the
+  // vector code generator supports all emitted operations.
+  if (compiler_options_ == nullptr ||
+      compiler_options_->GetInstructionSet() != InstructionSet::kArm64) {
+    return false;
+  }
+  bool changed = false;
+  for (HBasicBlock* block : graph_->GetReversePostOrder()) {
+    changed = VectorizeBlock(block) || changed;
+  }
+  return changed;
+}
+
+bool HSuperwordVectorization::VectorizeBlock(HBasicBlock* block) {
+  bool changed = false;
+  while (TryVectorizeOnePack(block)) {
+    changed = true;
+  }
+  return changed;
+}
+
+bool HSuperwordVectorization::TryVectorizeOnePack(HBasicBlock* block) {
+  ScopedArenaAllocator allocator(graph_->GetArenaStack());
+
+  // Collect candidate stores of a supported packed type, in block order.
+  ScopedArenaVector<HArraySet*> candidates(
+      allocator.Adapter(kArenaAllocSuperwordVectorization));
+  for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+    HInstruction* instruction = it.Current();
+    if (instruction->IsArraySet() &&
+        !instruction->CanThrow() &&
+        IsSupportedPackedType(instruction->AsArraySet()->GetComponentType())) {
+      candidates.push_back(instruction->AsArraySet());
+    }
+  }
+  if (candidates.size() < kNumberOfLanes) {
+    return false;
+  }
+
+  // Try each candidate as lane 0 of a pack of stores into array[offset + k].
+  for (HArraySet* lane0 : candidates) {
+    DataType::Type type = lane0->GetComponentType();
+    HInstruction* array = lane0->InputAt(0);
+    HInstruction* index_base = nullptr;
+    int64_t offset = 0;
+    DecomposeIndex(lane0->InputAt(1), &index_base, &offset);
+    HArraySet* stores[kNumberOfLanes] = { lane0 };
+    bool found = true;
+    for (size_t k = 1; found && k < kNumberOfLanes; k++) {
+      stores[k] = nullptr;
+      for (HArraySet* other : candidates) {
+        if (other->GetComponentType() != type || other->InputAt(0) != array) {
+          continue;
+        }
+        HInstruction* other_base = nullptr;
+        int64_t other_offset = 0;
+        DecomposeIndex(other->InputAt(1), &other_base, &other_offset);
+        if (other_base == index_base && other_offset == offset + static_cast<int64_t>(k)) {
+          if (stores[k] != nullptr) {
+            stores[k] = nullptr;  // ambiguous lane, e.g. two stores into a[i+1]
+            break;
+          }
+          stores[k] = other;
+        }
+      }
+      found = stores[k] != nullptr;
+    }
+    if (!found) {
+      continue;
+    }
+
+    // Match the stored values: either adjacent loads (a plain copy), a scalar
+    // in every lane, or one supported element-wise operation over packs.
+    HInstruction* values[kNumberOfLanes];
+    for (size_t k = 0; k < kNumberOfLanes; k++) {
+      values[k] = stores[k]->InputAt(2);
+    }
+    OperandPack value_pack;
+    OperandPack left_pack;
+    OperandPack right_pack;
+    bool is_operation = false;
+    if (!TryMatchOperandPack(values, block, type, &value_pack)) {
+      is_operation = true;
+      HInstruction::InstructionKind kind = values[0]->GetKind();
+      bool matched = true;
+      for (size_t k = 0; matched && k < kNumberOfLanes; k++) {
+        matched = IsSupportedOperation(values[k], type) &&
+                  values[k]->GetKind() == kind &&
+                  values[k]->GetBlock() == block &&
+                  values[k]->GetUses().HasExactlyOneElement() &&
+                  !values[k]->HasEnvironmentUses();
+      }
+      if (!matched) {
+        continue;
+      }
+      HInstruction* lefts[kNumberOfLanes];
+      HInstruction* rights[kNumberOfLanes];
+      for (size_t k = 0; k < kNumberOfLanes; k++) {
+        lefts[k] = values[k]->InputAt(0);
+        rights[k] = values[k]->InputAt(1);
+      }
+      if (!TryMatchOperandPack(lefts, block, type, &left_pack) ||
+          !TryMatchOperandPack(rights, block, type, &right_pack)) {
+        continue;
+      }
+    }
+
+    // Determine the first and last pack member in block order and check that
+    // nothing in between observes memory or the iteration: only pack members
+    // and pure non-throwing code may separate the packed accesses.
+    ScopedArenaSet<HInstruction*> members(
+        std::less<HInstruction*>(), allocator.Adapter(kArenaAllocSuperwordVectorization));
+    for (size_t k = 0; k < kNumberOfLanes; k++) {
+      members.insert(stores[k]);
+      if (is_operation) {
+        members.insert(values[k]);
+        if (left_pack.broadcast == nullptr) {
+          members.insert(left_pack.loads[k]);
+        }
+        if (right_pack.broadcast == nullptr) {
+          members.insert(right_pack.loads[k]);
+        }
+      } else if (value_pack.broadcast == nullptr) {
+        members.insert(value_pack.loads[k]);
+      }
+    }
+    HInstruction* first = nullptr;
+    HInstruction* last = nullptr;
+    HInstruction* first_store = nullptr;
+    HInstruction* last_store = nullptr;
+    for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+      HInstruction* instruction = it.Current();
+      if (members.find(instruction) != members.end()) {
+        if (first == nullptr) {
+          first = instruction;
+        }
+        last = instruction;
+        if (instruction->IsArraySet()) {
+          if (first_store == nullptr) {
+            first_store = instruction;
+          }
+          last_store = instruction;
+        }
+      }
+    }
+    bool window_is_pure = true;
+    for (HInstruction* instruction = first; instruction != last;
+         instruction = instruction->GetNext()) {
+      if (members.find(instruction) == members.end() &&
+          (instruction->CanThrow() ||
+           instruction->HasEnvironment() ||
+           !instruction->GetSideEffects().DoesNothing())) {
+        window_is_pure = false;
+        break;
+      }
+    }
+    if (!window_is_pure) {
+      continue;
+    }
+
+    // Packing moves all loads before all stores; make sure no load thereby
+    // moves across a store of a possibly aliasing element.
+    if (is_operation) {
+      if (!IsLoadPackSafe(left_pack, index_base, offset, first_store) ||
+          !IsLoadPackSafe(right_pack, index_base, offset, first_store)) {
+        continue;
+      }
+    } else if (!IsLoadPackSafe(value_pack, index_base, offset, first_store)) {
+      continue;
+    }
+
+    // Synthesize the vector operations right before the last store, where all
+    // scalar inputs are available, then remove the scalar pack.
+    ArenaAllocator* global_allocator = graph_->GetAllocator();
+    uint32_t dex_pc = last_store->GetDexPc();
+    auto generate_vector_operand = [&](const OperandPack& pack) {
+      HInstruction* vector;
+      if (pack.broadcast != nullptr) {
+        vector = new (global_allocator) HVecReplicateScalar(
+            global_allocator, pack.broadcast, type, kNumberOfLanes, dex_pc);
+      } else {
+        HArrayGet* lane0_load = pack.loads[0];
+        vector = new (global_allocator) HVecLoad(global_allocator,
+                                                 lane0_load->InputAt(0),
+                                                 lane0_load->InputAt(1),
+                                                 type,
+                                                 lane0_load->GetSideEffects(),
+                                                 kNumberOfLanes,
+                                                 /*is_string_char_at=*/ false,
+                                                 dex_pc);
+      }
+      block->InsertInstructionBefore(vector, last_store);
+      return vector;
+    };
+    HInstruction* vector_value;
+    if (is_operation) {
+      HInstruction* vector_left = generate_vector_operand(left_pack);
+      HInstruction* vector_right = generate_vector_operand(right_pack);
+      switch (values[0]->GetKind()) {
+        case HInstruction::kAdd:
+          vector_value = new (global_allocator) HVecAdd(
+              global_allocator, vector_left, vector_right, type, kNumberOfLanes, dex_pc);
+          break;
+        case HInstruction::kSub:
+          vector_value = new (global_allocator) HVecSub(
+              global_allocator, vector_left, vector_right, type, kNumberOfLanes, dex_pc);
+          break;
+        case HInstruction::kMul:
+          vector_value = new (global_allocator) HVecMul(
+              global_allocator, vector_left, vector_right, type, kNumberOfLanes, dex_pc);
+          break;
+        case HInstruction::kAnd:
+          vector_value = new (global_allocator) HVecAnd(
+              global_allocator, vector_left, vector_right, type, kNumberOfLanes, dex_pc);
+          break;
+        case HInstruction::kOr:
+          vector_value = new (global_allocator) HVecOr(
+              global_allocator, vector_left, vector_right, type, kNumberOfLanes, dex_pc);
+          break;
+        case HInstruction::kXor:
+          vector_value = new (global_allocator) HVecXor(
+              global_allocator, vector_left, vector_right, type, kNumberOfLanes, dex_pc);
+          break;
+        default:
+          LOG(FATAL) << "Unsupported SIMD operation";
+          UNREACHABLE();
+      }
+      block->InsertInstructionBefore(vector_value, last_store);
+    } else {
+      vector_value = generate_vector_operand(value_pack);
+    }
+    HInstruction* vector_store = new (global_allocator) HVecStore(global_allocator,
+                                                                 array,
+                                                                 stores[0]->InputAt(1),
+                                                                 vector_value,
+                                                                 type,
+                                                                 stores[0]->GetSideEffects(),
+                                                                 kNumberOfLanes,
+                                                                 dex_pc);
+    block->InsertInstructionBefore(vector_store, last_store);
+    for (size_t k = 0; k < kNumberOfLanes; k++) {
+      block->RemoveInstruction(stores[k]);
+    }
+    for (size_t k = 0; is_operation && k < kNumberOfLanes; k++) {
+      block->RemoveInstruction(values[k]);
+    }
+    for (size_t k = 0; k < kNumberOfLanes; k++) {
+      if (is_operation) {
+        if (left_pack.broadcast == nullptr) {
+          block->RemoveInstruction(left_pack.loads[k]);
+        }
+        if (right_pack.broadcast == nullptr) {
+          block->RemoveInstruction(right_pack.loads[k]);
+        }
+      } else if (value_pack.broadcast == nullptr) {
+        block->RemoveInstruction(value_pack.loads[k]);
+      }
+    }
+    graph_->SetHasSIMD(true);  // flag SIMD usage
+    MaybeRecordStat(stats_, MethodCompilationStat::kSuperwordVectorized);
+    return true;
+  }
+  return false;
+}
+
+}  // namespace art
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_SUPERWORD_VECTORIZATION_H_
+#define ART_COMPILER_OPTIMIZING_SUPERWORD_VECTORIZATION_H_
+
+#include "nodes.h"
+#include "optimization.h"
+
+namespace art {
+
+class CompilerOptions;
+
+/**
+ * Superword level parallelism (SLP). Packs adjacent scalar array accesses and
+ * element-wise arithmetic in straight-line code, such as manually unrolled
+ * kernels, into the same SIMD instructions used by the loop vectorizer.
+ */
+class HSuperwordVectorization : public HOptimization {
+ public:
+  HSuperwordVectorization(HGraph* graph,
+                          const CompilerOptions* compiler_options,
+                          OptimizingCompilerStats* stats,
+                          const char* name = kSuperwordVectorizationPassName);
+
+  bool Run() override;
+
+  static constexpr const char* kSuperwordVectorizationPassName = "superword_vectorization";
+
+ private:
+  // Repeatedly packs groups of adjacent accesses in the given block until no
+  // further group is found. Returns true if anything changed.
+  bool VectorizeBlock(HBasicBlock* block);
+
+  // Finds and replaces one group of adjacent scalar array stores, together
+  // with the loads and arithmetic feeding them, by vector instructions.
+  // Returns whether a replacement was made.
+  bool TryVectorizeOnePack(HBasicBlock* block);
+
+  // Compiler options (to query ISA features).
+  const CompilerOptions* compiler_options_;
+
+  DISALLOW_COPY_AND_ASSIGN(HSuperwordVectorization);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_SUPERWORD_VECTORIZATION_H_
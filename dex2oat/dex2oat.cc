@@ -65,6 +65,7 @@
 #include "compiler_callbacks.h"
 #include "debug/elf_debug_writer.h"
 #include "debug/method_debug_info.h"
+#include "dex/art_dex_file_loader.h"
 #include "dex/descriptors_names.h"
 #include "dex/dex_file-inl.h"
 #include "dex/dex_file_loader.h"
@@ -374,6 +375,11 @@ NO_RETURN static void Usage(const char* fmt, ...) {
   UsageError("  --dump-pass-timings: display a breakdown of time spent in optimization");
   UsageError("      passes for each compiled method.");
   UsageError("");
+  UsageError("  --dump-compile-profile=<file>: write a machine-readable compile profile to the");
+  UsageError("      specified file, one JSON object per compiled method recording per-pass");
+  UsageError("      times and arena allocator bytes.");
+  UsageError("      Example: --dump-compile-profile=compile-profile.json");
+  UsageError("");
   UsageError("  -g");
   UsageError("  --generate-debug-info: Generate debug information for native debugging,");
   UsageError("      such as stack unwinding information, ELF symbols and DWARF sections.");
@@ -445,6 +451,11 @@ NO_RETURN static void Usage(const char* fmt, ...) {
   UsageError("");
   UsageError("  --force-determinism: force the compiler to emit a deterministic output.");
   UsageError("");
+  UsageError("  --incremental: skip compilation entirely if the oat file at the output location");
+  UsageError("      already records matching checksums for all input dex files and was compiled");
+  UsageError("      with the same compiler filter for the same instruction set. Only applies");
+  UsageError("      when compiling an app to an oat file addressed by filename.");
+  UsageError("");
   UsageError("  --dump-cfg=<cfg-file>: dump control-flow graphs (CFGs) to specified file.");
   UsageError("      Example: --dump-cfg=output.cfg");
   UsageError("");
@@ -517,7 +528,7 @@ NO_RETURN static void Usage(const char* fmt, ...) {
   UsageError("      Example: --compilation-reason=install");
   UsageError("");
   UsageError("  --resolve-startup-const-strings=true|false: If true, the compiler eagerly");
-  UsageError("      resolves strings referenced from const-string of startup methods.");
+  UsageError("      resolves strings referenced from const-string of startup and hot methods.");
   UsageError("");
   UsageError("  --max-image-block-size=<size>: Maximum solid block size for compressed images.");
   UsageError("");
@@ -1086,9 +1097,15 @@ class Dex2Oat final {
     // Checks are all explicit until we know the architecture.
     // Set the compilation target's implicit checks options.
     switch (compiler_options_->GetInstructionSet()) {
+      case InstructionSet::kArm64:
+        compiler_options_->implicit_null_checks_ = true;
+        compiler_options_->implicit_so_checks_ = true;
+        // Suspend checks are implicit only on arm64; the other architectures
+        // lack the code generator and fault handler support.
+        compiler_options_->implicit_suspend_checks_ = true;
+        break;
       case InstructionSet::kArm:
       case InstructionSet::kThumb2:
-      case InstructionSet::kArm64:
       case InstructionSet::kX86:
       case InstructionSet::kX86_64:
         compiler_options_->implicit_null_checks_ = true;
@@ -1367,6 +1384,10 @@ class Dex2Oat final {
       force_determinism_ = true;
     }
 
+    if (args.Exists(M::Incremental)) {
+      incremental_ = true;
+    }
+
     if (args.Exists(M::Base)) {
       ParseBase(*args.Get(M::Base));
     }
@@ -1433,6 +1454,62 @@ class Dex2Oat final {
     InsertCompileOptions(argc, argv);
   }
 
+  // Check whether a previously compiled oat file at the output location is still up to date,
+  // i.e. whether it records matching checksums for all input dex files and was compiled with
+  // the same compiler filter for the same instruction set. Used by --incremental to elide
+  // recompilation entirely; must be called before OpenFile() truncates the existing output.
+  // The check is restricted to the plain app case (a single oat output addressed by filename,
+  // no image output): reusing individual compiled code sections from a partially stale oat
+  // file would require relocating them, which the oat file format does not support.
+  bool ExistingOatFileIsUpToDate() {
+    DCHECK(incremental_);
+    if (oat_fd_ != -1 ||
+        zip_fd_ != -1 ||
+        oat_filenames_.size() != 1u ||
+        IsImage() ||
+        dex_filenames_.empty()) {
+      return false;
+    }
+    const std::string& oat_filename = oat_filenames_[0];
+    std::string error_msg;
+    std::unique_ptr<OatFile> oat_file(OatFile::Open(/*zip_fd=*/ -1,
+                                                    oat_filename,
+                                                    oat_filename,
+                                                    /*executable=*/ false,
+                                                    /*low_4gb=*/ false,
+                                                    &error_msg));
+    if (oat_file == nullptr) {
+      VLOG(compiler) << "Could not open existing oat file " << oat_filename << ": " << error_msg;
+      return false;
+    }
+    if (oat_file->GetOatHeader().GetInstructionSet() != compiler_options_->GetInstructionSet() ||
+        oat_file->GetCompilerFilter() != compiler_options_->GetCompilerFilter()) {
+      return false;
+    }
+    // All input dex files, including multidex entries, must be recorded in the oat file
+    // with matching checksums, and the oat file must not reference any other dex file.
+    DCHECK_EQ(dex_filenames_.size(), dex_locations_.size());
+    const ArtDexFileLoader dex_file_loader;
+    size_t number_of_dex_files = 0u;
+    for (size_t i = 0; i != dex_filenames_.size(); ++i) {
+      std::vector<uint32_t> checksums;
+      if (!dex_file_loader.GetMultiDexChecksums(dex_filenames_[i].c_str(),
+                                                &checksums,
+                                                &error_msg)) {
+        LOG(WARNING) << "Failed to get checksums for " << dex_filenames_[i] << ": " << error_msg;
+        return false;
+      }
+      for (size_t j = 0; j != checksums.size(); ++j) {
+        std::string location = DexFileLoader::GetMultiDexLocation(j, dex_locations_[i].c_str());
+        if (oat_file->GetOatDexFile(location.c_str(), &checksums[j]) == nullptr) {
+          return false;
+        }
+      }
+      number_of_dex_files += checksums.size();
+    }
+    return oat_file->GetOatDexFiles().size() == number_of_dex_files;
+  }
+
   // Check whether the oat output files are writable, and open them for later. Also open a swap
   // file, if a name is given.
   bool OpenFile() {
@@ -2257,7 +2334,8 @@ class Dex2Oat final {
                                                   oat_filenames_,
                                                   dex_file_oat_index_map_,
                                                   class_loader,
-                                                  dirty_image_objects_.get()));
+                                                  dirty_image_objects_.get(),
+                                                  thread_count_));
 
       // We need to prepare method offsets in the image address space for resolving linker patches.
       TimingLogger::ScopedTiming t2("dex2oat Prepare image address space", timings_);
@@ -2528,6 +2606,10 @@ class Dex2Oat final {
     return profile_file_fd_ != -1 || !profile_file_.empty();
   }
 
+  bool IsIncremental() const {
+    return incremental_;
+  }
+
   bool DoProfileGuidedOptimizations() const {
     return UseProfile();
   }
@@ -3086,6 +3168,10 @@ class Dex2Oat final {
   // Whether the given input vdex is also the output.
   bool update_input_vdex_ = false;
 
+  // Whether --incremental was passed: skip compilation entirely when the
+  // existing oat output is already up to date.
+  bool incremental_ = false;
+
   // By default, copy the dex to the vdex file only if dex files are
   // compressed in APK.
   linker::CopyOption copy_dex_files_ = linker::CopyOption::kOnlyIfCompressed;
@@ -3241,6 +3327,13 @@ static dex2oat::ReturnCode Dex2oat(int argc, char** argv) {
   }
 
 
+  // When requested, skip compilation entirely if the existing output is already up to
+  // date. This must happen before OpenFile() truncates the previous oat file.
+  if (dex2oat->IsIncremental() && dex2oat->ExistingOatFileIsUpToDate()) {
+    LOG(INFO) << "Existing oat file is up to date, skipping compilation";
+    return dex2oat::ReturnCode::kNoFailure;
+  }
+
   // Check early that the result of compilation can be written
   if (!dex2oat->OpenFile()) {
     return dex2oat::ReturnCode::kOther;
@@ -22,6 +22,7 @@
 #include <malloc.h>  // For mallinfo
 #endif
 
+#include <algorithm>
 #include <string_view>
 #include <unordered_set>
 #include <vector>
@@ -35,6 +36,7 @@
 #include "base/arena_allocator.h"
 #include "base/array_ref.h"
 #include "base/bit_vector.h"
+#include "base/casts.h"
 #include "base/enums.h"
 #include "base/logging.h"  // For VLOG
 #include "base/stl_util.h"
@@ -714,7 +716,11 @@ void CompilerDriver::ResolveConstStrings(const std::vector<const DexFile*>& dex_
         if (profile_compilation_info != nullptr && !is_startup_clinit) {
           ProfileCompilationInfo::MethodHotness hotness =
               profile_compilation_info->GetMethodHotness(method.GetReference());
-          if (added_preresolved_string_array ? !hotness.IsStartup() : !hotness.IsInProfile()) {
+          // When the preresolved strings array was added, also pre-intern the const-strings of
+          // hot methods: their strings end up in the app image intern table and the preresolved
+          // array turns first use into an indexed load instead of a resolution call.
+          if (added_preresolved_string_array ? (!hotness.IsStartup() && !hotness.IsHot())
+                                             : !hotness.IsInProfile()) {
             continue;
           }
         }
@@ -2658,8 +2664,30 @@ static void CompileDexFile(CompilerDriver* driver,
                                      dex_files,
                                      thread_pool);
 
-  auto compile = [&context, &compile_fn](size_t class_def_index) {
+  // Compilation is parallelized at method granularity: a work unit is one
+  // method, identified by its flat position across all class defs. This keeps
+  // all workers busy towards the end of a dex file even when a single class
+  // contains thousands of methods. The mapping from work unit to class def is
+  // done with a prefix sum over the per-class method counts, which only needs
+  // the class data headers and not a walk over the methods themselves.
+  std::vector<uint32_t> class_first_unit(dex_file.NumClassDefs() + 1u, 0u);
+  for (uint32_t i = 0; i < dex_file.NumClassDefs(); ++i) {
+    ClassAccessor accessor(dex_file, i);
+    class_first_unit[i + 1u] =
+        class_first_unit[i] + accessor.NumDirectMethods() + accessor.NumVirtualMethods();
+  }
+  const uint32_t number_of_units = class_first_unit.back();
+  if (number_of_units == 0u) {
+    return;
+  }
+
+  auto compile = [&context, &compile_fn, &class_first_unit](size_t unit_index) {
     const DexFile& dex_file = *context.GetDexFile();
+    const uint32_t class_def_index = static_cast<uint32_t>(
+        std::upper_bound(class_first_unit.begin(), class_first_unit.end(), unit_index) -
+        class_first_unit.begin() - 1u);
+    const uint32_t method_position = dchecked_integral_cast<uint32_t>(
+        unit_index - class_first_unit[class_def_index]);
     SCOPED_TRACE << "compile " << dex_file.GetLocation() << "@" << class_def_index;
     ClassLinker* class_linker = context.GetClassLinker();
     jobject jclass_loader = context.GetClassLoader();
@@ -2692,11 +2720,6 @@ static void CompileDexFile(CompilerDriver* driver,
       dex_cache = hs.NewHandle(klass->GetDexCache());
     }
 
-    // Avoid suspension if there are no methods to compile.
-    if (accessor.NumDirectMethods() + accessor.NumVirtualMethods() == 0) {
-      return;
-    }
-
     // Go to native so that we don't block GC during compilation.
     ScopedThreadSuspension sts(soa.Self(), kNative);
 
@@ -2704,16 +2727,22 @@ static void CompileDexFile(CompilerDriver* driver,
     optimizer::DexToDexCompiler::CompilationLevel dex_to_dex_compilation_level =
         GetDexToDexCompilationLevel(soa.Self(), *driver, jclass_loader, dex_file, class_def);
 
-    // Compile direct and virtual methods.
+    // Compile the method this work unit refers to. The walk to the method's
+    // position only decodes the small encoded method headers before it.
+    uint32_t position = 0u;
     int64_t previous_method_idx = -1;
     for (const ClassAccessor::Method& method : accessor.GetMethods()) {
       const uint32_t method_idx = method.GetIndex();
-      if (method_idx == previous_method_idx) {
+      const bool duplicate = (method_idx == previous_method_idx);
+      previous_method_idx = method_idx;
+      if (position++ != method_position) {
+        continue;
+      }
+      if (duplicate) {
         // smali can create dex files with two encoded_methods sharing the same method_idx
         // http://code.google.com/p/smali/issues/detail?id=119
-        continue;
+        break;
       }
-      previous_method_idx = method_idx;
       compile_fn(soa.Self(),
                  driver,
                  method.GetCodeItem(),
@@ -2725,9 +2754,10 @@ static void CompileDexFile(CompilerDriver* driver,
                  dex_file,
                  dex_to_dex_compilation_level,
                  dex_cache);
+      break;
     }
   };
-  context.ForAllLambda(0, dex_file.NumClassDefs(), compile, thread_count);
+  context.ForAllLambda(0, number_of_units, compile, thread_count);
 }
 
 void CompilerDriver::Compile(jobject class_loader,
@@ -2892,7 +2922,7 @@ std::string CompilerDriver::GetMemoryUsageString(bool extended) const {
 void CompilerDriver::InitializeThreadPools() {
   size_t parallel_count = parallel_thread_count_ > 0 ? parallel_thread_count_ - 1 : 0;
   parallel_thread_pool_.reset(
-      new ThreadPool("Compiler driver thread pool", parallel_count));
+      new WorkStealingThreadPool("Compiler driver thread pool", parallel_count));
   single_thread_pool_.reset(new ThreadPool("Single-threaded Compiler driver thread pool", 0));
 }
 
@@ -80,6 +80,7 @@
 #include "runtime.h"
 #include "scoped_thread_state_change-inl.h"
 #include "subtype_check.h"
+#include "thread_pool.h"
 #include "utils/dex_cache_arrays_layout-inl.h"
 #include "well_known_classes.h"
 
@@ -2966,7 +2967,9 @@ void ImageWriter::CopyAndFixupObject(Object* obj) {
   DCHECK_LT(offset, image_info.image_end_);
   const auto* src = reinterpret_cast<const uint8_t*>(obj);
 
-  image_info.image_bitmap_.Set(dst);  // Mark the obj as live.
+  // Mark the obj as live. Objects are copied in parallel, so use the atomic
+  // test-and-set to avoid losing bits set by another thread in the same word.
+  image_info.image_bitmap_.AtomicTestAndSet(dst);
 
   const size_t n = obj->SizeOf();
 
@@ -3031,11 +3034,44 @@ class ImageWriter::FixupVisitor {
 };
 
 void ImageWriter::CopyAndFixupObjects() {
-  auto visitor = [&](Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+  // Collect the objects first; VisitObjects() must not be called concurrently
+  // and the vector lets us hand out contiguous batches to the thread pool.
+  std::vector<Object*> objects;
+  auto collector = [&](Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
     DCHECK(obj != nullptr);
-    CopyAndFixupObject(obj);
+    objects.push_back(obj);
   };
-  Runtime::Current()->GetHeap()->VisitObjects(visitor);
+  Runtime::Current()->GetHeap()->VisitObjects(collector);
+  // Copying an object only writes to its preallocated location in the image and
+  // reads data shared between objects (bin slots in lock words, native object
+  // relocations, saved hash codes), so objects can be copied and fixed up in
+  // parallel. The result does not depend on the order in which they are copied.
+  // Batches are sized so that each worker gets several of them, to even out
+  // imbalance from objects of different sizes.
+  const size_t batch_size = std::max<size_t>(objects.size() / (4u * thread_count_), 1u);
+  if (thread_count_ == 1u || objects.size() <= batch_size) {
+    for (Object* obj : objects) {
+      CopyAndFixupObject(obj);
+    }
+  } else {
+    Thread* const self = Thread::Current();
+    ThreadPool pool("Image writer thread pool", thread_count_ - 1u);
+    for (size_t begin = 0u, size = objects.size(); begin < size; begin += batch_size) {
+      const size_t end = std::min(begin + batch_size, size);
+      pool.AddTask(self, new FunctionTask([this, &objects, begin, end](Thread* task_self) {
+        ScopedObjectAccess soa(task_self);
+        for (size_t i = begin; i != end; ++i) {
+          CopyAndFixupObject(objects[i]);
+        }
+      }));
+    }
+    pool.StartWorkers(self);
+    // Process remaining tasks on the current thread as well; it already holds
+    // the mutator lock, hence `may_hold_locks`.
+    pool.Wait(self, /*do_work=*/ true, /*may_hold_locks=*/ true);
+  }
+  // All pointer arrays have been fixed up now, see FixupObject().
+  pointer_arrays_.clear();
   // Fill the padding objects since they are required for in order traversal of the image space.
   for (ImageInfo& image_info : image_infos_) {
     for (const size_t start_offset : image_info.padding_offsets_) {
@@ -3184,9 +3220,11 @@ void ImageWriter::FixupObject(Object* orig, Object* copy) {
     // Is this a native pointer array?
     auto it = pointer_arrays_.find(down_cast<mirror::PointerArray*>(orig));
     if (it != pointer_arrays_.end()) {
-      // Should only need to fixup every pointer array exactly once.
+      // Every pointer array is visited exactly once, so there is no need to
+      // remove the entry here. The map must not be modified while objects are
+      // being fixed up in parallel; it is cleared by CopyAndFixupObjects()
+      // when all objects have been copied.
       FixupPointerArray(copy, down_cast<mirror::PointerArray*>(orig), it->second);
-      pointer_arrays_.erase(it);
       return;
     }
   }
@@ -3619,7 +3657,8 @@ ImageWriter::ImageWriter(
     const std::vector<std::string>& oat_filenames,
     const std::unordered_map<const DexFile*, size_t>& dex_file_oat_index_map,
     jobject class_loader,
-    const HashSet<std::string>* dirty_image_objects)
+    const HashSet<std::string>* dirty_image_objects,
+    size_t thread_count)
     : compiler_options_(compiler_options),
       boot_image_begin_(Runtime::Current()->GetHeap()->GetBootImagesStartAddress()),
       boot_image_size_(Runtime::Current()->GetHeap()->GetBootImagesSize()),
@@ -3634,7 +3673,8 @@ ImageWriter::ImageWriter(
       image_storage_mode_(image_storage_mode),
       oat_filenames_(oat_filenames),
       dex_file_oat_index_map_(dex_file_oat_index_map),
-      dirty_image_objects_(dirty_image_objects) {
+      dirty_image_objects_(dirty_image_objects),
+      thread_count_(std::max(thread_count, static_cast<size_t>(1u))) {
   DCHECK(compiler_options.IsBootImage() ||
          compiler_options.IsBootImageExtension() ||
          compiler_options.IsAppImage());
@@ -84,7 +84,8 @@ class ImageWriter final {
               const std::vector<std::string>& oat_filenames,
               const std::unordered_map<const DexFile*, size_t>& dex_file_oat_index_map,
               jobject class_loader,
-              const HashSet<std::string>* dirty_image_objects);
+              const HashSet<std::string>* dirty_image_objects,
+              size_t thread_count = 1u);
 
   /*
    * Modifies the heap and collects information about objects and code so that
@@ -725,6 +726,9 @@ class ImageWriter final {
   // Set of objects known to be dirty in the image. Can be nullptr if there are none.
   const HashSet<std::string>* dirty_image_objects_;
 
+  // Number of threads to use for the copy and fixup phase.
+  const size_t thread_count_;
+
   // Objects are guaranteed to not cross the region size boundary.
   size_t region_size_ = 0u;
 
@@ -726,7 +726,7 @@ bool OatWriter::StartRoData(const std::vector<const DexFile*>& dex_files,
 }
 
 // Initialize the writer with the given parameters.
-void OatWriter::Initialize(const CompilerDriver* compiler_driver,
+void OatWriter::Initialize(CompilerDriver* compiler_driver,
                            ImageWriter* image_writer,
                            const std::vector<const DexFile*>& dex_files) {
   CHECK(write_state_ == WriteState::kInitialize);
@@ -1360,6 +1360,18 @@ class OatWriter::LayoutReserveOffsetCodeMethodVisitor : public OrderedMethodVisi
       // Update offsets. (Checksum is updated when writing.)
       offset_ += sizeof(*method_header);  // Method header is prepended before code.
       offset_ += code_size;
+
+      // Track the extent of code placed for startup-flagged methods. The sort
+      // order in LayoutCodeMethodVisitor groups profile-flagged methods
+      // together, so this range stays tight; the runtime prefetches it when
+      // the oat file is loaded. Deduplicated methods are skipped as their code
+      // may have been placed by a method from any bin.
+      if (method_data.method_hotness.IsStartup()) {
+        if (startup_code_begin_ == 0u) {
+          startup_code_begin_ = code_offset;
+        }
+        startup_code_end_ = std::max<uint32_t>(startup_code_end_, code_offset + code_size);
+      }
     }
 
     // Exclude quickened dex methods (code_size == 0) since they have no native code.
@@ -1402,6 +1414,14 @@ class OatWriter::LayoutReserveOffsetCodeMethodVisitor : public OrderedMethodVisi
     return offset_;
   }
 
+  uint32_t GetStartupCodeBegin() const {
+    return startup_code_begin_;
+  }
+
+  uint32_t GetStartupCodeEnd() const {
+    return startup_code_end_;
+  }
+
  private:
   LayoutReserveOffsetCodeMethodVisitor(OatWriter* writer,
                                        size_t offset,
@@ -1418,22 +1438,52 @@ class OatWriter::LayoutReserveOffsetCodeMethodVisitor : public OrderedMethodVisi
 
   struct CodeOffsetsKeyComparator {
     bool operator()(const CompiledMethod* lhs, const CompiledMethod* rhs) const {
-      // Code is deduplicated by CompilerDriver, compare only data pointers.
+      // Code and tables are deduplicated by content in CompiledMethodStorage, so
+      // equal pointers imply equal contents. Compare by content rather than by
+      // pointer so that identical blobs compiled for methods in different dex
+      // files share a single copy even when the storage did not canonicalize
+      // them to the same allocation. Methods with equal code but different
+      // patches must not alias; their bytes diverge once the patches are
+      // applied.
       if (lhs->GetQuickCode().data() != rhs->GetQuickCode().data()) {
-        return lhs->GetQuickCode().data() < rhs->GetQuickCode().data();
+        int cmp = CompareBytes(lhs->GetQuickCode(), rhs->GetQuickCode());
+        if (cmp != 0) {
+          return cmp < 0;
+        }
       }
       // If the code is the same, all other fields are likely to be the same as well.
       if (UNLIKELY(lhs->GetVmapTable().data() != rhs->GetVmapTable().data())) {
-        return lhs->GetVmapTable().data() < rhs->GetVmapTable().data();
+        int cmp = CompareBytes(lhs->GetVmapTable(), rhs->GetVmapTable());
+        if (cmp != 0) {
+          return cmp < 0;
+        }
       }
       if (UNLIKELY(lhs->GetPatches().data() != rhs->GetPatches().data())) {
-        return lhs->GetPatches().data() < rhs->GetPatches().data();
+        ArrayRef<const LinkerPatch> lhs_patches = lhs->GetPatches();
+        ArrayRef<const LinkerPatch> rhs_patches = rhs->GetPatches();
+        if (lhs_patches.size() != rhs_patches.size()) {
+          return lhs_patches.size() < rhs_patches.size();
+        }
+        for (size_t i = 0, size = lhs_patches.size(); i != size; ++i) {
+          if (!(lhs_patches[i] == rhs_patches[i])) {
+            return lhs_patches[i] < rhs_patches[i];
+          }
+        }
       }
       if (UNLIKELY(lhs->IsIntrinsic() != rhs->IsIntrinsic())) {
         return rhs->IsIntrinsic();
       }
       return false;
     }
+
+   private:
+    static int CompareBytes(const ArrayRef<const uint8_t>& lhs,
+                            const ArrayRef<const uint8_t>& rhs) {
+      if (lhs.size() != rhs.size()) {
+        return lhs.size() < rhs.size() ? -1 : 1;
+      }
+      return memcmp(lhs.data(), rhs.data(), lhs.size());
+    }
   };
 
   uint32_t NewQuickCodeOffset(CompiledMethod* compiled_method,
@@ -1455,6 +1505,10 @@ class OatWriter::LayoutReserveOffsetCodeMethodVisitor : public OrderedMethodVisi
   // so we can simply compare the pointers to find out if things are duplicated.
   SafeMap<const CompiledMethod*, uint32_t, CodeOffsetsKeyComparator> dedupe_map_;
 
+  // Range of code placed for startup-flagged methods, see VisitMethod().
+  uint32_t startup_code_begin_ = 0u;
+  uint32_t startup_code_end_ = 0u;
+
   // Cache writer_'s members and compiler options.
   MultiOatRelativePatcher* relative_patcher_;
   uint32_t executable_offset_;
@@ -1864,6 +1918,21 @@ class OatWriter::WriteCodeMethodVisitor : public OrderedMethodVisitor {
     }
     DCHECK_OFFSET_();
 
+    if (!writer_->GetCompilerOptions().GenerateAnyDebugInfo()) {
+      // The compiled method is not needed anymore: its stack map was emitted by an
+      // earlier pass and its code has just been written (or was deduplicated against
+      // code written earlier). Release its storage now rather than when the driver is
+      // destroyed, so that peak memory while writing large oat files is bounded by the
+      // methods not yet written. Deduplicated data is reference counted, so this is
+      // safe even when other methods share data with this one. When debug info is
+      // generated, MethodDebugInfo keeps pointers into the compiled method, so the
+      // storage must be kept until the debug info has been written.
+      CompiledMethod* released = writer_->compiler_driver_->RemoveCompiledMethod(method_ref);
+      DCHECK_EQ(released, compiled_method);
+      CompiledMethod::ReleaseSwapAllocatedCompiledMethod(
+          writer_->compiler_driver_->GetCompiledMethodStorage(), released);
+    }
+
     return true;
   }
 
@@ -2264,6 +2333,12 @@ size_t OatWriter::InitOatCodeDexFiles(size_t offset) {
     DCHECK(success);
     offset = layout_reserve_code_visitor.GetOffset();
 
+    // Record the startup code range so the runtime can prefetch it at load time.
+    if (layout_reserve_code_visitor.GetStartupCodeEnd() != 0u) {
+      oat_header_->SetStartupCodeRange(layout_reserve_code_visitor.GetStartupCodeBegin(),
+                                       layout_reserve_code_visitor.GetStartupCodeEnd());
+    }
+
     // Save the method order because the WriteCodeMethodVisitor will need this
     // order again.
     DCHECK(ordered_methods_ == nullptr);
@@ -3479,6 +3554,11 @@ bool OatWriter::LayoutAndWriteDexFile(OutputStream* out, OatDexFile* oat_dex_fil
   Options options;
   options.compact_dex_level_ = compact_dex_level_;
   options.update_checksum_ = true;
+  // Multidex APKs share many identical code items (e.g. synthetic accessors) between
+  // their dex files, so deduplicate code items across the dex files of the shared data
+  // section. This is only safe when no quickening takes place: quickening rewrites code
+  // items in place, which would corrupt the view of another dex file sharing the item.
+  options.dedupe_code_items_interdex_ = !GetCompilerOptions().IsQuickeningCompilationEnabled();
   DexLayout dex_layout(options, profile_compilation_info_, /*file*/ nullptr, /*header*/ nullptr);
   const uint8_t* dex_src = nullptr;
   {
@@ -182,7 +182,7 @@ class OatWriter {
                    OutputStream* oat_rodata,
                    SafeMap<std::string, std::string>* key_value_store);
   // Initialize the writer with the given parameters.
-  void Initialize(const CompilerDriver* compiler_driver,
+  void Initialize(CompilerDriver* compiler_driver,
                   ImageWriter* image_writer,
                   const std::vector<const DexFile*>& dex_files);
   bool WriteQuickeningInfo(OutputStream* vdex_out);
@@ -381,7 +381,8 @@ class OatWriter {
 
   std::vector<uint8_t> code_info_data_;
 
-  const CompilerDriver* compiler_driver_;
+  // Non-const so that compiled methods can be released as their code is written.
+  CompilerDriver* compiler_driver_;
   const CompilerOptions& compiler_options_;
   ImageWriter* image_writer_;
   // Whether the dex files being compiled are going to be extracted to the vdex.
@@ -37,14 +37,20 @@
 #include <inttypes.h>
 #include <stdio.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include "android-base/file.h"
 #include "android-base/logging.h"
 #include "android-base/stringprintf.h"
 
+#include "dex/art_dex_file_loader.h"
 #include "dex/class_accessor-inl.h"
 #include "dex/code_item_accessors-inl.h"
 #include "dex/dex_file-inl.h"
@@ -1852,41 +1858,53 @@ static void processDexFile(const char* fileName,
 /*
  * Processes a single file (either direct .dex or indirect .zip/.jar/.apk).
  */
-int processFile(const char* fileName) {
-  if (gOptions.verbose) {
-    fprintf(gOutFile, "Processing '%s'...\n", fileName);
-  }
-
+/*
+ * Opens all dex files from the given container file. In the default mode the
+ * whole file is read into `content`, which must then outlive `dex_files`.
+ * With -m the file is instead mapped read-only, which avoids the copy and
+ * lets the kernel page the mapping in and out while working through a large
+ * corpus of files.
+ */
+static bool openDexFiles(const char* fileName,
+                         std::string* content,
+                         std::vector<std::unique_ptr<const DexFile>>* dex_files,
+                         std::string* error_msg) {
   const bool kVerifyChecksum = !gOptions.ignoreBadChecksum;
   const bool kVerify = !gOptions.disableVerifier;
-  std::string content;
+  if (gOptions.mapFile) {
+    const ArtDexFileLoader dex_file_loader;
+    return dex_file_loader.Open(fileName,
+                                fileName,
+                                kVerify,
+                                kVerifyChecksum,
+                                error_msg,
+                                dex_files);
+  }
   // If the file is not a .dex file, the function tries .zip/.jar/.apk files,
   // all of which are Zip archives with "classes.dex" inside.
   // TODO: add an api to android::base to read a std::vector<uint8_t>.
-  if (!android::base::ReadFileToString(fileName, &content)) {
-    LOG(ERROR) << "ReadFileToString failed";
-    return -1;
+  if (!android::base::ReadFileToString(fileName, content)) {
+    *error_msg = "ReadFileToString failed";
+    return false;
   }
   const DexFileLoader dex_file_loader;
   DexFileLoaderErrorCode error_code;
-  std::string error_msg;
-  std::vector<std::unique_ptr<const DexFile>> dex_files;
-  if (!dex_file_loader.OpenAll(reinterpret_cast<const uint8_t*>(content.data()),
-                               content.size(),
-                               fileName,
-                               kVerify,
-                               kVerifyChecksum,
-                               &error_code,
-                               &error_msg,
-                               &dex_files)) {
-    // Display returned error message to user. Note that this error behavior
-    // differs from the error messages shown by the original Dalvik dexdump.
-    LOG(ERROR) << error_msg;
-    return -1;
-  }
+  return dex_file_loader.OpenAll(reinterpret_cast<const uint8_t*>(content->data()),
+                                 content->size(),
+                                 fileName,
+                                 kVerify,
+                                 kVerifyChecksum,
+                                 &error_code,
+                                 error_msg,
+                                 dex_files);
+}
 
-  // Success. Either report checksum verification or process
-  // all dex files found in given file.
+/*
+ * Either reports checksum verification or processes all dex files found in
+ * the given file.
+ */
+static void dumpDexFiles(const char* fileName,
+                         const std::vector<std::unique_ptr<const DexFile>>& dex_files) {
   if (gOptions.checksumOnly) {
     fprintf(gOutFile, "Checksum verified\n");
   } else {
@@ -1894,7 +1912,111 @@ int processFile(const char* fileName) {
       processDexFile(fileName, dex_files[i].get(), i, n);
     }
   }
+}
+
+int processFile(const char* fileName) {
+  if (gOptions.verbose) {
+    fprintf(gOutFile, "Processing '%s'...\n", fileName);
+  }
+
+  std::string content;
+  std::vector<std::unique_ptr<const DexFile>> dex_files;
+  std::string error_msg;
+  if (!openDexFiles(fileName, &content, &dex_files, &error_msg)) {
+    // Display returned error message to user. Note that this error behavior
+    // differs from the error messages shown by the original Dalvik dexdump.
+    LOG(ERROR) << error_msg;
+    return -1;
+  }
+
+  dumpDexFiles(fileName, dex_files);
   return 0;
 }
 
+/*
+ * Processes all the given files, fanning file opening and verification out to
+ * -t worker threads. Output is still written strictly in input order: the
+ * workers only open and verify dex files, and the main thread dumps each file
+ * as soon as its result is available. Workers are throttled to a bounded
+ * read-ahead window so that at most a few opened files are held at a time.
+ */
+int processFiles(const std::vector<const char*>& fileNames) {
+  const size_t numThreads =
+      std::min(static_cast<size_t>(std::max(gOptions.numThreads, 1)), fileNames.size());
+  if (numThreads <= 1u) {
+    int result = 0;
+    for (const char* fileName : fileNames) {
+      result |= processFile(fileName);
+    }
+    return result;
+  }
+
+  struct OpenResult {
+    std::string content;
+    std::vector<std::unique_ptr<const DexFile>> dex_files;
+    std::string error_msg;
+    bool success = false;
+    bool done = false;
+  };
+  std::vector<OpenResult> results(fileNames.size());
+  std::atomic<size_t> next_file(0u);
+  std::mutex results_mutex;
+  std::condition_variable results_cv;
+  size_t next_to_dump = 0u;  // Guarded by results_mutex.
+
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < numThreads; ++t) {
+    workers.emplace_back([&]() {
+      for (size_t i = next_file++; i < fileNames.size(); i = next_file++) {
+        {
+          // Cap the read-ahead window to bound the number of mapped files.
+          std::unique_lock<std::mutex> lock(results_mutex);
+          results_cv.wait(lock, [&]() { return i < next_to_dump + 2u * numThreads; });
+        }
+        // Filling in results[i] needs no lock: each index belongs to exactly
+        // one worker and the main thread reads it only after `done` is set.
+        OpenResult& result = results[i];
+        result.success =
+            openDexFiles(fileNames[i], &result.content, &result.dex_files, &result.error_msg);
+        {
+          std::lock_guard<std::mutex> lock(results_mutex);
+          result.done = true;
+        }
+        results_cv.notify_all();
+      }
+    });
+  }
+
+  int result = 0;
+  for (size_t i = 0; i < fileNames.size(); ++i) {
+    {
+      std::unique_lock<std::mutex> lock(results_mutex);
+      results_cv.wait(lock, [&]() { return results[i].done; });
+    }
+    // Safe without the lock: no worker touches results[i] once it is done.
+    OpenResult& opened = results[i];
+    if (gOptions.verbose) {
+      fprintf(gOutFile, "Processing '%s'...\n", fileNames[i]);
+    }
+    if (!opened.success) {
+      LOG(ERROR) << opened.error_msg;
+      result = -1;
+    } else {
+      dumpDexFiles(fileNames[i], opened.dex_files);
+    }
+    // Release the dex files and backing storage before advancing the window.
+    opened.dex_files.clear();
+    opened.content.clear();
+    {
+      std::lock_guard<std::mutex> lock(results_mutex);
+      ++next_to_dump;
+    }
+    results_cv.notify_all();
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  return result;
+}
+
 }  // namespace art
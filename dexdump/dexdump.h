@@ -28,6 +28,8 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include <vector>
+
 namespace art {
 
 /* Supported output formats. */
@@ -43,6 +45,7 @@ struct Options {
   bool exportsOnly;
   bool ignoreBadChecksum;
   bool disableVerifier;
+  bool mapFile;
   bool showAnnotations;
   bool showCfg;
   bool showFileHeaders;
@@ -50,12 +53,14 @@ struct Options {
   bool verbose;
   OutputFormat outputFormat;
   const char* outputFileName;
+  int numThreads;
 };
 
 /* Prototypes. */
 extern struct Options gOptions;
 extern FILE* gOutFile;
 int processFile(const char* fileName);
+int processFiles(const std::vector<const char*>& fileNames);
 
 }  // namespace art
 
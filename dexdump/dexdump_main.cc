@@ -25,11 +25,14 @@
 #include "dexdump.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
 #include <android-base/logging.h>
 
+#include "base/mem_map.h"
+
 namespace art {
 
 static const char* gProgName = "dexdump";
@@ -39,8 +42,8 @@ static const char* gProgName = "dexdump";
  */
 static void usage() {
   LOG(ERROR) << "Copyright (C) 2007 The Android Open Source Project\n";
-  LOG(ERROR) << gProgName << ": [-a] [-c] [-d] [-e] [-f] [-h] [-i] [-j] [-l layout] [-o outfile]"
-                  " dexfile...\n";
+  LOG(ERROR) << gProgName << ": [-a] [-c] [-d] [-e] [-f] [-h] [-i] [-j] [-l layout] [-m]"
+                  " [-o outfile] [-t threads] dexfile...\n";
   LOG(ERROR) << " -a : display annotations";
   LOG(ERROR) << " -c : verify checksum and exit";
   LOG(ERROR) << " -d : disassemble code sections";
@@ -51,7 +54,9 @@ static void usage() {
   LOG(ERROR) << " -i : ignore checksum failures";
   LOG(ERROR) << " -j : disable dex file verification";
   LOG(ERROR) << " -l : output layout, either 'plain' or 'xml'";
+  LOG(ERROR) << " -m : map input files read-only instead of reading them into memory";
   LOG(ERROR) << " -o : output file name (defaults to stdout)";
+  LOG(ERROR) << " -t : number of threads opening and verifying input files";
 }
 
 /*
@@ -65,7 +70,7 @@ int dexdumpDriver(int argc, char** argv) {
 
   // Parse all arguments.
   while (true) {
-    const int ic = getopt(argc, argv, "acdefghijl:o:");
+    const int ic = getopt(argc, argv, "acdefghijl:mo:t:");
     if (ic < 0) {
       break;  // done
     }
@@ -107,9 +112,18 @@ int dexdumpDriver(int argc, char** argv) {
           wantUsage = true;
         }
         break;
+      case 'm':  // map files read-only
+        gOptions.mapFile = true;
+        break;
       case 'o':  // output file
         gOptions.outputFileName = optarg;
         break;
+      case 't':  // number of file-opening threads
+        gOptions.numThreads = atoi(optarg);
+        if (gOptions.numThreads <= 0) {
+          wantUsage = true;
+        }
+        break;
       default:
         wantUsage = true;
         break;
@@ -139,12 +153,17 @@ int dexdumpDriver(int argc, char** argv) {
     }
   }
 
+  // Mapping files requires MemMap.
+  if (gOptions.mapFile) {
+    MemMap::Init();
+  }
+
   // Process all files supplied on command line.
-  int result = 0;
+  std::vector<const char*> fileNames;
   while (optind < argc) {
-    result |= processFile(argv[optind++]);
+    fileNames.push_back(argv[optind++]);
   }  // while
-  return result != 0 ? 1 : 0;
+  return processFiles(fileNames) != 0 ? 1 : 0;
 }
 
 }  // namespace art
@@ -71,6 +71,17 @@ TEST_F(DexDumpTest, FullPlainOutput) {
     dex_file_}, &error_msg)) << error_msg;
 }
 
+TEST_F(DexDumpTest, MappedInput) {
+  std::string error_msg;
+  ASSERT_TRUE(Exec({"-m", "-d", "-o", "/dev/null", dex_file_}, &error_msg)) << error_msg;
+}
+
+TEST_F(DexDumpTest, MultiThreaded) {
+  std::string error_msg;
+  ASSERT_TRUE(Exec({"-t", "2", "-o", "/dev/null", dex_file_, dex_file_},
+                   &error_msg)) << error_msg;
+}
+
 TEST_F(DexDumpTest, XMLOutput) {
   std::string error_msg;
   ASSERT_TRUE(Exec({"-l", "xml", "-o", "/dev/null",
@@ -521,10 +521,13 @@ bool CompactDexWriter::Write(DexContainer* output, std::string* error_msg)  {
     WriteHeader(main_stream);
   }
 
-  // Clear the dedupe to prevent interdex code item deduping. This does not currently work well with
-  // dex2oat's class unloading. The issue is that verification encounters quickened opcodes after
-  // the first dex gets unloaded.
-  code_item_dedupe_->Clear();
+  // Unless requested, clear the dedupe to prevent interdex code item deduping. Interdex
+  // deduping does not currently work well with dex2oat's class unloading when quickening
+  // is enabled: verification encounters quickened opcodes in shared code items after the
+  // first dex gets unloaded. The oat writer only requests it when nothing is quickened.
+  if (!dex_layout_->GetOptions().dedupe_code_items_interdex_) {
+    code_item_dedupe_->Clear();
+  }
 
   return true;
 }
@@ -1733,6 +1733,10 @@ void DexLayout::LayoutCodeItems(const DexFile* dex_file) {
 
   std::unordered_map<dex_ir::CodeItem*, LayoutType>& code_item_layout =
       layout_hotness_info_.code_item_layout_;
+  // Whether a code item belongs to a method executed during startup. Used as a
+  // secondary sort key so that, within each layout category, the startup
+  // working set forms a contiguous prefix of the section.
+  std::unordered_map<dex_ir::CodeItem*, bool> code_item_used_in_startup;
 
   // Assign hotness flags to all code items.
   for (InvokeType invoke_type : invoke_types) {
@@ -1778,6 +1782,9 @@ void DexLayout::LayoutCodeItems(const DexFile* dex_file) {
           // Already exists, merge the hotness.
           layout_type = MergeLayoutType(layout_type, state);
         }
+        const bool is_startup =
+            is_startup_clinit || (hotness.GetFlags() & Hotness::kFlagStartup) != 0;
+        code_item_used_in_startup[code_item] |= is_startup;
       }
     }
   }
@@ -1797,6 +1804,9 @@ void DexLayout::LayoutCodeItems(const DexFile* dex_file) {
 
   // Sort the code items vector by new layout. The writing process will take care of calculating
   // all the offsets. Stable sort to preserve any existing locality that might be there.
+  // Within a layout category, startup code comes first, so the pages touched by
+  // interpreted startup code are adjacent rather than interleaved with methods
+  // only executed after startup.
   std::stable_sort(code_items.begin(),
                    code_items.end(),
                    [&](const std::unique_ptr<dex_ir::CodeItem>& a,
@@ -1807,7 +1817,14 @@ void DexLayout::LayoutCodeItems(const DexFile* dex_file) {
     DCHECK(it_b != code_item_layout.end());
     const LayoutType layout_type_a = it_a->second;
     const LayoutType layout_type_b = it_b->second;
-    return layout_type_a < layout_type_b;
+    if (layout_type_a != layout_type_b) {
+      return layout_type_a < layout_type_b;
+    }
+    auto startup_it_a = code_item_used_in_startup.find(a.get());
+    auto startup_it_b = code_item_used_in_startup.find(b.get());
+    DCHECK(startup_it_a != code_item_used_in_startup.end());
+    DCHECK(startup_it_b != code_item_used_in_startup.end());
+    return startup_it_a->second > startup_it_b->second;
   });
 }
 
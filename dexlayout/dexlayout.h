@@ -68,6 +68,10 @@ class Options {
   bool update_checksum_ = false;
   CompactDexLevel compact_dex_level_ = CompactDexLevel::kCompactDexLevelNone;
   bool dedupe_code_items_ = true;
+  // Keep the code item dedupe state across the dex files sharing one compact dex
+  // container, so that identical code items are stored once in the shared data
+  // section. Must stay disabled when code items may be quickened in place.
+  bool dedupe_code_items_interdex_ = false;
   OutputFormat output_format_ = kOutputPlain;
   const char* output_dex_directory_ = nullptr;
   const char* output_file_name_ = nullptr;
@@ -18,6 +18,7 @@
 #include <string>
 #include <string_view>
 
+#include "android-base/file.h"
 #include "android-base/stringprintf.h"
 #include "android-base/strings.h"
 #include "base/file_utils.h"
@@ -50,6 +51,11 @@ enum ReturnCodes {
   // code to communicate that the flattening code path was taken.
   kFlattenClassLoaderContextSuccess = 50,
 
+  // Success return code when executed with --batch-file. The per-dex-file
+  // results are printed to standard output instead of being returned in the
+  // exit code.
+  kBatchModeSuccess = 51,
+
   kErrorInvalidArguments = 101,
   kErrorCannotCreateRuntime = 102,
   kErrorUnknownDexOptNeeded = 103
@@ -133,6 +139,12 @@ NO_RETURN static void Usage(const char *fmt, ...) {
   UsageError("      print a colon-separated list of its dex files to standard output. Dexopt");
   UsageError("      needed analysis is not performed when this option is set.");
   UsageError("");
+  UsageError("  --batch-file=<filename>: a file with one dex file path per line. All listed");
+  UsageError("      dex files are analyzed in a single process, sharing one runtime and one");
+  UsageError("      loaded boot image. The result for each dex file is printed to standard");
+  UsageError("      output as '<dex-file>:<return code>'. Incompatible with --dex-file and");
+  UsageError("      the file descriptor options.");
+  UsageError("");
   UsageError("Return code:");
   UsageError("  To make it easier to integrate with the internal tools this command will make");
   UsageError("    available its result (dexoptNeeded) as the exit/return code. i.e. it will not");
@@ -236,11 +248,25 @@ class DexoptAnalyzer final {
         }
       } else if (option == "--flatten-class-loader-context") {
         only_flatten_context_ = true;
+      } else if (StartsWith(option, "--batch-file=")) {
+        batch_file_ = std::string(option.substr(strlen("--batch-file=")));
       } else {
         Usage("Unknown argument '%s'", raw_option);
       }
     }
 
+    if (!batch_file_.empty()) {
+      if (!dex_file_.empty()) {
+        Usage("--batch-file is incompatible with --dex-file");
+      }
+      if (oat_fd_ != -1 || vdex_fd_ != -1 || zip_fd_ != -1) {
+        Usage("--batch-file is incompatible with the file descriptor options");
+      }
+      if (only_flatten_context_) {
+        Usage("--batch-file is incompatible with --flatten-class-loader-context");
+      }
+    }
+
     if (image_.empty()) {
       // If we don't receive the image, try to use the default one.
       // Tests may specify a different image (e.g. core image).
@@ -287,25 +313,12 @@ class DexoptAnalyzer final {
     return true;
   }
 
-  int GetDexOptNeeded() const {
-    if (!CreateRuntime()) {
-      return kErrorCannotCreateRuntime;
-    }
-    std::unique_ptr<Runtime> runtime(Runtime::Current());
-
-    // Only when the runtime is created can we create the class loader context: the
-    // class loader context will open dex file and use the MemMap global lock that the
-    // runtime owns.
-    std::unique_ptr<ClassLoaderContext> class_loader_context;
-    if (!context_str_.empty()) {
-      class_loader_context = ClassLoaderContext::Create(context_str_);
-      if (class_loader_context == nullptr) {
-        Usage("Invalid --class-loader-context '%s'", context_str_.c_str());
-      }
-    }
-
+  // Analyzes a single dex file with an already created runtime and returns the
+  // dexoptanalyzer return code for it.
+  int AnalyzeDexFile(const std::string& dex_file,
+                     ClassLoaderContext* class_loader_context) const {
     std::unique_ptr<OatFileAssistant> oat_file_assistant;
-    oat_file_assistant = std::make_unique<OatFileAssistant>(dex_file_.c_str(),
+    oat_file_assistant = std::make_unique<OatFileAssistant>(dex_file.c_str(),
                                                             isa_,
                                                             /*load_executable=*/ false,
                                                             /*only_load_system_executable=*/ false,
@@ -319,7 +332,7 @@ class DexoptAnalyzer final {
     }
 
     int dexoptNeeded = oat_file_assistant->GetDexOptNeeded(compiler_filter_,
-                                                           class_loader_context.get(),
+                                                           class_loader_context,
                                                            context_fds_,
                                                            assume_profile_changed_,
                                                            downgrade_);
@@ -339,6 +352,58 @@ class DexoptAnalyzer final {
     }
   }
 
+  // Only when the runtime is created can we create the class loader context: the
+  // class loader context will open dex file and use the MemMap global lock that the
+  // runtime owns.
+  std::unique_ptr<ClassLoaderContext> CreateClassLoaderContext() const {
+    std::unique_ptr<ClassLoaderContext> class_loader_context;
+    if (!context_str_.empty()) {
+      class_loader_context = ClassLoaderContext::Create(context_str_);
+      if (class_loader_context == nullptr) {
+        Usage("Invalid --class-loader-context '%s'", context_str_.c_str());
+      }
+    }
+    return class_loader_context;
+  }
+
+  int GetDexOptNeeded() const {
+    if (!CreateRuntime()) {
+      return kErrorCannotCreateRuntime;
+    }
+    std::unique_ptr<Runtime> runtime(Runtime::Current());
+
+    std::unique_ptr<ClassLoaderContext> class_loader_context = CreateClassLoaderContext();
+    return AnalyzeDexFile(dex_file_, class_loader_context.get());
+  }
+
+  int RunBatch() const {
+    std::string batch_contents;
+    if (!android::base::ReadFileToString(batch_file_, &batch_contents)) {
+      LOG(ERROR) << "Unable to read batch file '" << batch_file_ << "'";
+      return kErrorInvalidArguments;
+    }
+
+    // Create the runtime (and with it the boot image) once and reuse it for all
+    // the dex files in the batch. Booting the runtime dominates the cost of a
+    // single-file invocation, so this turns N runtime starts into one.
+    if (!CreateRuntime()) {
+      return kErrorCannotCreateRuntime;
+    }
+    std::unique_ptr<Runtime> runtime(Runtime::Current());
+
+    std::unique_ptr<ClassLoaderContext> class_loader_context = CreateClassLoaderContext();
+
+    for (const std::string& line : android::base::Split(batch_contents, "\n")) {
+      std::string dex_file = android::base::Trim(line);
+      if (dex_file.empty()) {
+        continue;
+      }
+      int result = AnalyzeDexFile(dex_file, class_loader_context.get());
+      std::cout << dex_file << ":" << result << std::endl;
+    }
+    return kBatchModeSuccess;
+  }
+
   int FlattenClassLoaderContext() const {
     DCHECK(only_flatten_context_);
     if (context_str_.empty()) {
@@ -357,6 +422,8 @@ class DexoptAnalyzer final {
   int Run() const {
     if (only_flatten_context_) {
       return FlattenClassLoaderContext();
+    } else if (!batch_file_.empty()) {
+      return RunBatch();
     } else {
       return GetDexOptNeeded();
     }
@@ -367,6 +434,7 @@ class DexoptAnalyzer final {
   InstructionSet isa_;
   CompilerFilter::Filter compiler_filter_;
   std::string context_str_;
+  std::string batch_file_;
   bool only_flatten_context_;
   bool assume_profile_changed_;
   bool downgrade_;
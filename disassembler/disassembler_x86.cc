@@ -1209,6 +1209,18 @@ DISASSEMBLER_ENTRY(cmp,
           opcode1 = opcode_tmp.c_str();
         }
         break;
+      case 0xD7:
+        if (prefix[2] == 0x66) {
+          opcode1 = "pmovmskb";
+          prefix[2] = 0;  // clear prefix now it's served its purpose as part of the opcode
+          src_reg_file = SSE;
+          has_modrm = true;
+          load = true;
+        } else {
+          opcode_tmp = StringPrintf("unknown opcode '0F %02X'", *instr);
+          opcode1 = opcode_tmp.c_str();
+        }
+        break;
       case 0xD8:
       case 0xD9:
       case 0xDA:
@@ -17,6 +17,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <algorithm>
 #include <fstream>
 #include <functional>
 #include <iostream>
@@ -29,6 +30,7 @@
 
 #include <android-base/parseint.h>
 #include "android-base/stringprintf.h"
+#include "android-base/strings.h"
 
 #include "art_field-inl.h"
 #include "art_method-inl.h"
@@ -92,6 +94,21 @@ struct MappingData {
   std::set<size_t> dirty_page_set;
 };
 
+// Dirty-object statistics aggregated by class across all diffed processes.
+// Keyed by class descriptor so results from different processes can be merged
+// and reports from different devices can be diffed by tooling.
+struct DirtyClassReport {
+  struct ClassStats {
+    // Number of diffed processes in which at least one object of this class was dirty.
+    size_t process_count = 0;
+    size_t dirty_object_count = 0;
+    // Byte-per-byte dirtiness summed over all processes. When a zygote pid was
+    // given these are private-dirty bytes; otherwise private or shared dirty.
+    size_t dirty_object_byte_count = 0;
+  };
+  std::map<std::string, ClassStats> classes;
+};
+
 static std::string GetClassDescriptor(mirror::Class* klass)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   CHECK(klass != nullptr);
@@ -382,10 +399,12 @@ class RegionSpecializedBase<mirror::Object> : public RegionCommon<mirror::Object
                         ArrayRef<uint8_t> zygote_contents,
                         const backtrace_map_t& boot_map,
                         const ImageHeader& image_header,
-                        bool dump_dirty_objects)
+                        bool dump_dirty_objects,
+                        DirtyClassReport* dirty_class_report)
       : RegionCommon<mirror::Object>(os, remote_contents, zygote_contents, boot_map, image_header),
         os_(*os),
-        dump_dirty_objects_(dump_dirty_objects) { }
+        dump_dirty_objects_(dump_dirty_objects),
+        dirty_class_report_(dirty_class_report) { }
 
   // Define a common public type name for use by RegionData.
   using VisitorClass = ImgObjectVisitor;
@@ -535,6 +554,12 @@ class RegionSpecializedBase<mirror::Object> : public RegionCommon<mirror::Object
           class_data.dirty_object_byte_count * 1.0f / object_sizes;
       float avg_object_size = object_sizes * 1.0f / dirty_object_count;
       const std::string& descriptor = class_data.descriptor;
+      if (dirty_class_report_ != nullptr) {
+        DirtyClassReport::ClassStats& stats = dirty_class_report_->classes[descriptor];
+        ++stats.process_count;
+        stats.dirty_object_count += dirty_object_count;
+        stats.dirty_object_byte_count += class_data.dirty_object_byte_count;
+      }
       os_ << "    " << mirror::Class::PrettyClass(klass) << " ("
           << "objects: " << dirty_object_count << ", "
           << "avg dirty bytes: " << avg_dirty_bytes_per_class << ", "
@@ -650,6 +675,8 @@ class RegionSpecializedBase<mirror::Object> : public RegionCommon<mirror::Object
 
   std::ostream& os_;
   bool dump_dirty_objects_;
+  // If non-null, dirty-object statistics are also merged into this report.
+  DirtyClassReport* dirty_class_report_;
   std::unordered_set<mirror::Object*> dirty_objects_;
   std::map<mirror::Class*, ClassData> class_data_;
 
@@ -710,7 +737,8 @@ class RegionSpecializedBase<ArtMethod> : public RegionCommon<ArtMethod> {
                         ArrayRef<uint8_t> zygote_contents,
                         const backtrace_map_t& boot_map,
                         const ImageHeader& image_header,
-                        bool dump_dirty_objects ATTRIBUTE_UNUSED)
+                        bool dump_dirty_objects ATTRIBUTE_UNUSED,
+                        DirtyClassReport* dirty_class_report ATTRIBUTE_UNUSED)
       : RegionCommon<ArtMethod>(os, remote_contents, zygote_contents, boot_map, image_header),
         os_(*os) {
     // Prepare the table for offset to member lookups.
@@ -950,13 +978,15 @@ class RegionData : public RegionSpecializedBase<T> {
              ArrayRef<uint8_t> zygote_contents,
              const backtrace_map_t& boot_map,
              const ImageHeader& image_header,
-             bool dump_dirty_objects)
+             bool dump_dirty_objects,
+             DirtyClassReport* dirty_class_report)
       : RegionSpecializedBase<T>(os,
                                  remote_contents,
                                  zygote_contents,
                                  boot_map,
                                  image_header,
-                                 dump_dirty_objects),
+                                 dump_dirty_objects,
+                                 dirty_class_report),
         os_(*os) {
     CHECK(!remote_contents.empty());
   }
@@ -1116,11 +1146,13 @@ class ImgDiagDumper {
   explicit ImgDiagDumper(std::ostream* os,
                          pid_t image_diff_pid,
                          pid_t zygote_diff_pid,
-                         bool dump_dirty_objects)
+                         bool dump_dirty_objects,
+                         DirtyClassReport* dirty_class_report)
       : os_(os),
         image_diff_pid_(image_diff_pid),
         zygote_diff_pid_(zygote_diff_pid),
         dump_dirty_objects_(dump_dirty_objects),
+        dirty_class_report_(dirty_class_report),
         zygote_pid_only_(false) {}
 
   bool Init() {
@@ -1595,7 +1627,8 @@ class ImgDiagDumper {
                                                   zygote_contents,
                                                   boot_map,
                                                   image_header,
-                                                  dump_dirty_objects_);
+                                                  dump_dirty_objects_,
+                                                  dirty_class_report_);
     object_region_data.ProcessRegion(mapping_data,
                                      remotes,
                                      image_begin_unaligned);
@@ -1606,7 +1639,8 @@ class ImgDiagDumper {
                                                 zygote_contents,
                                                 boot_map,
                                                 image_header,
-                                                dump_dirty_objects_);
+                                                dump_dirty_objects_,
+                                                dirty_class_report_);
     artmethod_region_data.ProcessRegion(mapping_data,
                                         remotes,
                                         image_begin_unaligned);
@@ -1797,6 +1831,7 @@ class ImgDiagDumper {
   pid_t image_diff_pid_;  // Dump image diff against boot.art if pid is non-negative
   pid_t zygote_diff_pid_;  // Dump image diff against zygote boot.art if pid is non-negative
   bool dump_dirty_objects_;  // Adds dumping of objects that are dirty.
+  DirtyClassReport* dirty_class_report_;  // If non-null, merge per-class dirty stats into this.
   bool zygote_pid_only_;  // The user only specified a pid for the zygote.
 
   // BacktraceMap used for finding the memory mapping of the image file.
@@ -1823,30 +1858,73 @@ class ImgDiagDumper {
   DISALLOW_COPY_AND_ASSIGN(ImgDiagDumper);
 };
 
+// Write the aggregated dirty-class report as CSV, ranked by dirty bytes so the
+// biggest fleet-wide contributors to shared page loss come first.
+static bool WriteDirtyClassReport(const DirtyClassReport& report,
+                                  const char* file_name,
+                                  std::ostream& os) {
+  std::ofstream csv(file_name);
+  if (!csv) {
+    os << "Failed to open dirty class report file '" << file_name << "'\n";
+    return false;
+  }
+  std::vector<const std::pair<const std::string, DirtyClassReport::ClassStats>*> sorted;
+  sorted.reserve(report.classes.size());
+  for (const auto& entry : report.classes) {
+    sorted.push_back(&entry);
+  }
+  std::sort(sorted.begin(), sorted.end(), [](const auto* lhs, const auto* rhs) {
+    return lhs->second.dirty_object_byte_count > rhs->second.dirty_object_byte_count;
+  });
+  csv << "class_descriptor,processes,dirty_objects,dirty_bytes\n";
+  for (const auto* entry : sorted) {
+    csv << entry->first << ','
+        << entry->second.process_count << ','
+        << entry->second.dirty_object_count << ','
+        << entry->second.dirty_object_byte_count << '\n';
+  }
+  os << "Dirty class report written to '" << file_name << "'\n";
+  return true;
+}
+
 static int DumpImage(Runtime* runtime,
                      std::ostream* os,
-                     pid_t image_diff_pid,
+                     const std::vector<pid_t>& image_diff_pids,
                      pid_t zygote_diff_pid,
-                     bool dump_dirty_objects) {
+                     bool dump_dirty_objects,
+                     const char* dirty_class_report_file) {
   ScopedObjectAccess soa(Thread::Current());
   gc::Heap* heap = runtime->GetHeap();
   const std::vector<gc::space::ImageSpace*>& image_spaces = heap->GetBootImageSpaces();
   CHECK(!image_spaces.empty());
-  ImgDiagDumper img_diag_dumper(os,
-                                image_diff_pid,
-                                zygote_diff_pid,
-                                dump_dirty_objects);
-  if (!img_diag_dumper.Init()) {
-    return EXIT_FAILURE;
-  }
-  for (gc::space::ImageSpace* image_space : image_spaces) {
-    const ImageHeader& image_header = image_space->GetImageHeader();
-    if (!image_header.IsValid()) {
-      fprintf(stderr, "Invalid image header %s\n", image_space->GetImageLocation().c_str());
+  DirtyClassReport dirty_class_report;
+  for (pid_t image_diff_pid : image_diff_pids) {
+    if (image_diff_pids.size() > 1u) {
+      *os << "======== PROCESS " << image_diff_pid << " ========\n\n";
+    }
+    ImgDiagDumper img_diag_dumper(os,
+                                  image_diff_pid,
+                                  zygote_diff_pid,
+                                  dump_dirty_objects,
+                                  dirty_class_report_file != nullptr ? &dirty_class_report
+                                                                     : nullptr);
+    if (!img_diag_dumper.Init()) {
       return EXIT_FAILURE;
     }
+    for (gc::space::ImageSpace* image_space : image_spaces) {
+      const ImageHeader& image_header = image_space->GetImageHeader();
+      if (!image_header.IsValid()) {
+        fprintf(stderr, "Invalid image header %s\n", image_space->GetImageLocation().c_str());
+        return EXIT_FAILURE;
+      }
 
-    if (!img_diag_dumper.Dump(image_header, image_space->GetImageLocation())) {
+      if (!img_diag_dumper.Dump(image_header, image_space->GetImageLocation())) {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  if (dirty_class_report_file != nullptr) {
+    if (!WriteDirtyClassReport(dirty_class_report, dirty_class_report_file, *os)) {
       return EXIT_FAILURE;
     }
   }
@@ -1876,6 +1954,16 @@ struct ImgDiagArgs : public CmdlineArgs {
         *error_msg = "Image diff pid out of range";
         return kParseError;
       }
+    } else if (StartsWith(option, "--image-diff-pids=")) {
+      const char* image_diff_pids = raw_option + strlen("--image-diff-pids=");
+      for (const std::string& pid_str : android::base::Split(image_diff_pids, ",")) {
+        pid_t pid;
+        if (!android::base::ParseInt(pid_str.c_str(), &pid)) {
+          *error_msg = "Image diff pid out of range";
+          return kParseError;
+        }
+        image_diff_pids_.push_back(pid);
+      }
     } else if (StartsWith(option, "--zygote-diff-pid=")) {
       const char* zygote_diff_pid = raw_option + strlen("--zygote-diff-pid=");
 
@@ -1885,6 +1973,8 @@ struct ImgDiagArgs : public CmdlineArgs {
       }
     } else if (option == "--dump-dirty-objects") {
       dump_dirty_objects_ = true;
+    } else if (StartsWith(option, "--dirty-class-report=")) {
+      dirty_class_report_file_ = raw_option + strlen("--dirty-class-report=");
     } else {
       return kParseUnknownArgument;
     }
@@ -1901,6 +1991,17 @@ struct ImgDiagArgs : public CmdlineArgs {
 
     // Perform our own checks.
 
+    for (pid_t pid : image_diff_pids_) {
+      if (kill(pid, /*sig*/0) != 0) {  // No signal is sent, perform error-checking only.
+        if (errno == ESRCH) {
+          *error_msg = StringPrintf("Process %d specified does not exist", pid);
+        } else {
+          *error_msg = StringPrintf("Failed to check process status: %s", strerror(errno));
+        }
+        return kParseError;
+      }
+    }
+
     if (kill(image_diff_pid_,
              /*sig*/0) != 0) {  // No signal is sent, perform error-checking only.
       // Check if the pid exists before proceeding.
@@ -1934,10 +2035,17 @@ struct ImgDiagArgs : public CmdlineArgs {
     usage +=  // Optional.
         "  --image-diff-pid=<pid>: provide the PID of a process whose boot.art you want to diff.\n"
         "      Example: --image-diff-pid=$(pid zygote)\n"
+        "  --image-diff-pids=<pid,pid,...>: diff the boot.art of several processes in one run,\n"
+        "      aggregating per-class dirty statistics across all of them.\n"
+        "      Example: --image-diff-pids=$(pidof com.android.systemui com.android.phone)\n"
         "  --zygote-diff-pid=<pid>: provide the PID of the zygote whose boot.art you want to diff "
         "against.\n"
         "      Example: --zygote-diff-pid=$(pid zygote)\n"
         "  --dump-dirty-objects: additionally output dirty objects of interest.\n"
+        "  --dirty-class-report=<file.csv>: write a machine-readable report ranking classes by\n"
+        "      dirty bytes, aggregated over all diffed processes. With --zygote-diff-pid the\n"
+        "      counted bytes are private dirty.\n"
+        "      Example: --image-diff-pids=1234,5678 --dirty-class-report=dirty_classes.csv\n"
         "\n";
 
     return usage;
@@ -1945,19 +2053,32 @@ struct ImgDiagArgs : public CmdlineArgs {
 
  public:
   pid_t image_diff_pid_ = -1;
+  std::vector<pid_t> image_diff_pids_;
   pid_t zygote_diff_pid_ = -1;
   bool dump_dirty_objects_ = false;
+  const char* dirty_class_report_file_ = nullptr;
 };
 
 struct ImgDiagMain : public CmdlineMain<ImgDiagArgs> {
   bool ExecuteWithRuntime(Runtime* runtime) override {
     CHECK(args_ != nullptr);
 
+    // Merge the single-pid and multi-pid options; fall back to the single
+    // (possibly unset) pid so that the zygote-only invocation keeps working.
+    std::vector<pid_t> image_diff_pids = args_->image_diff_pids_;
+    if (args_->image_diff_pid_ >= 0) {
+      image_diff_pids.insert(image_diff_pids.begin(), args_->image_diff_pid_);
+    }
+    if (image_diff_pids.empty()) {
+      image_diff_pids.push_back(args_->image_diff_pid_);
+    }
+
     return DumpImage(runtime,
                      args_->os_,
-                     args_->image_diff_pid_,
+                     image_diff_pids,
                      args_->zygote_diff_pid_,
-                     args_->dump_dirty_objects_) == EXIT_SUCCESS;
+                     args_->dump_dirty_objects_,
+                     args_->dirty_class_report_file_) == EXIT_SUCCESS;
   }
 };
 
@@ -95,6 +95,7 @@ const char* const ArenaAllocatorStatsImpl<kCount>::kAllocNames[] = {
   "Scheduler    ",
   "Profile      ",
   "SBCloner     ",
+  "Superword    ",
 };
 
 template <bool kCount>
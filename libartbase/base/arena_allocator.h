@@ -104,6 +104,7 @@ enum ArenaAllocKind {
   kArenaAllocScheduler,
   kArenaAllocProfile,
   kArenaAllocSuperblockCloner,
+  kArenaAllocSuperwordVectorization,
   kNumArenaAllocKinds
 };
 
@@ -637,16 +637,24 @@ class HashSet {
   size_t FindIndexImpl(const K& element, size_t hash, FailFn fail_fn) const {
     DCHECK_NE(NumBuckets(), 0u);
     DCHECK_EQ(hashfn_(element), hash);
+    // Hoist the storage pointer and bucket count into locals. The empty check and the
+    // predicate are opaque calls for some instantiations (e.g. the class table compares
+    // descriptors through heap references), so the compiler would otherwise have to
+    // reload the members through `this` on every probe.
+    const T* const data = data_;
+    const size_t num_buckets = num_buckets_;
     size_t index = IndexForHash(hash);
     while (true) {
-      const T& slot = ElementForIndex(index);
+      const T& slot = data[index];
       if (emptyfn_.IsEmpty(slot)) {
         return fail_fn(index);
       }
       if (pred_(slot, element)) {
         return index;
       }
-      index = NextIndex(index);
+      if (UNLIKELY(++index >= num_buckets)) {
+        index = 0;
+      }
     }
   }
 
@@ -716,11 +724,16 @@ class HashSet {
 
   ALWAYS_INLINE size_t FirstAvailableSlot(size_t index) const {
     DCHECK_LT(index, NumBuckets());  // Don't try to get a slot out of range.
+    // See FindIndexImpl for why the members are hoisted into locals.
+    const T* const data = data_;
+    const size_t num_buckets = num_buckets_;
     size_t non_empty_count = 0;
-    while (!emptyfn_.IsEmpty(data_[index])) {
-      index = NextIndex(index);
+    while (!emptyfn_.IsEmpty(data[index])) {
+      if (UNLIKELY(++index >= num_buckets)) {
+        index = 0;
+      }
       non_empty_count++;
-      DCHECK_LE(non_empty_count, NumBuckets());  // Don't loop forever.
+      DCHECK_LE(non_empty_count, num_buckets);  // Don't loop forever.
     }
     return index;
   }
@@ -60,6 +60,11 @@ template <class Value> class Histogram {
   double Mean() const;
   double Variance() const;
   double Percentile(double per, const CumulativeData& data) const;
+  // Factor that values added through AdjustAndAddValue were divided by; multiply recorded
+  // values by this to convert back to the original unit.
+  double AdjustFactor() const {
+    return kAdjust;
+  }
   void PrintConfidenceIntervals(std::ostream& os, double interval,
                                 const CumulativeData& data) const;
   void PrintMemoryUse(std::ostream& os) const;
@@ -106,9 +106,13 @@ Arena* MallocArenaPool::AllocArena(size_t size) {
   Arena* ret = nullptr;
   {
     std::lock_guard<std::mutex> lock(lock_);
-    if (free_arenas_ != nullptr && LIKELY(free_arenas_->Size() >= size)) {
-      ret = free_arenas_;
-      free_arenas_ = free_arenas_->next_;
+    // First-fit scan of the retained arenas, see MemMapArenaPool::AllocArena.
+    for (Arena** before = &free_arenas_; *before != nullptr; before = &(*before)->next_) {
+      if (LIKELY((*before)->Size() >= size)) {
+        ret = *before;
+        *before = ret->next_;
+        break;
+      }
     }
   }
   if (ret == nullptr) {
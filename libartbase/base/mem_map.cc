@@ -831,6 +831,18 @@ void MemMap::MadviseDontNeedAndZero() {
   }
 }
 
+int MemMap::Madvise(int advice) {
+#ifdef _WIN32
+  UNUSED(advice);
+  return 0;
+#else
+  if (base_begin_ == nullptr && base_size_ == 0) {
+    return 0;
+  }
+  return madvise(base_begin_, base_size_, advice);
+#endif
+}
+
 int MemMap::MadviseDontFork() {
 #if defined(__linux__)
   if (base_begin_ != nullptr || base_size_ != 0) {
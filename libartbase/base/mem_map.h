@@ -232,6 +232,9 @@ class MemMap {
 
   void MadviseDontNeedAndZero();
   int MadviseDontFork();
+  // Apply an arbitrary madvise advice to the whole mapping. Returns 0 on platforms
+  // without madvise, where any advice is a no-op hint.
+  int Madvise(int advice);
 
   int GetProtect() const {
     return prot_;
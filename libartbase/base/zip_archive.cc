@@ -45,6 +45,17 @@ uint32_t ZipEntry::GetCrc32() {
   return zip_entry_->crc32;
 }
 
+void ZipEntry::Prefetch() {
+#ifdef __linux__
+  int zip_fd = GetFileDescriptor(handle_);
+  if (zip_fd < 0) {
+    return;  // In-memory archive, nothing to read ahead.
+  }
+  // Best effort; ignore failures (e.g. fds on which fadvise is not supported).
+  posix_fadvise(zip_fd, zip_entry_->offset, zip_entry_->compressed_length, POSIX_FADV_WILLNEED);
+#endif
+}
+
 bool ZipEntry::IsUncompressed() {
   return zip_entry_->method == kCompressStored;
 }
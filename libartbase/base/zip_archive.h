@@ -65,6 +65,11 @@ class ZipEntry {
   uint32_t GetUncompressedLength();
   uint32_t GetCrc32();
 
+  // Ask the kernel to read ahead the compressed bytes of this entry. Useful
+  // to overlap I/O with extraction when several entries of a cold archive are
+  // about to be opened. Best effort; a no-op if the archive is not file-backed.
+  void Prefetch();
+
   bool IsUncompressed();
   bool IsAlignedTo(size_t alignment) const;
 
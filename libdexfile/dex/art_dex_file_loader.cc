@@ -18,6 +18,9 @@
 
 #include <sys/stat.h>
 
+#include <atomic>
+#include <thread>
+
 #include "android-base/stringprintf.h"
 
 #include "base/file_magic.h"
@@ -477,6 +480,57 @@ std::unique_ptr<const DexFile> ArtDexFileLoader::OpenOneDexFileFromZip(
 // seems an excessive number.
 static constexpr size_t kWarnOnManyDexFilesThreshold = 100;
 
+// Verify the given dex files, using one worker thread per dex file (capped at the number
+// of cores). Verification of one dex file does not depend on the others, so the expensive
+// first-open verification of a multidex APK parallelizes at dex file granularity. Returns
+// true if all dex files verified; otherwise stores the index and error message of the
+// first failing dex file.
+static bool VerifyDexFiles(const std::vector<std::unique_ptr<const DexFile>>& dex_files,
+                           bool verify_checksum,
+                           /*out*/ size_t* first_failed_index,
+                           /*out*/ std::string* error_msg) {
+  std::vector<std::string> error_msgs(dex_files.size());
+  std::vector<uint8_t> failed(dex_files.size(), 0u);
+  std::atomic<size_t> next_index(0u);
+  auto verify_worker = [&]() {
+    for (size_t i = next_index.fetch_add(1u, std::memory_order_relaxed);
+         i < dex_files.size();
+         i = next_index.fetch_add(1u, std::memory_order_relaxed)) {
+      const DexFile* dex_file = dex_files[i].get();
+      if (!dex::Verify(dex_file,
+                       dex_file->Begin(),
+                       dex_file->Size(),
+                       dex_file->GetLocation().c_str(),
+                       verify_checksum,
+                       &error_msgs[i])) {
+        failed[i] = 1u;
+      }
+    }
+  };
+  size_t num_threads = std::min<size_t>(dex_files.size(), std::thread::hardware_concurrency());
+  if (num_threads > 1u) {
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1u);
+    for (size_t i = 1u; i != num_threads; ++i) {
+      threads.emplace_back(verify_worker);
+    }
+    verify_worker();  // Participate with the current thread.
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  } else {
+    verify_worker();
+  }
+  for (size_t i = 0u; i != dex_files.size(); ++i) {
+    if (failed[i] != 0u) {
+      *first_failed_index = i;
+      *error_msg = std::move(error_msgs[i]);
+      return false;
+    }
+  }
+  return true;
+}
+
 bool ArtDexFileLoader::OpenAllDexFilesFromZip(
     const ZipArchive& zip_archive,
     const std::string& location,
@@ -487,10 +541,24 @@ bool ArtDexFileLoader::OpenAllDexFilesFromZip(
   ScopedTrace trace("Dex file open from Zip " + std::string(location));
   DCHECK(dex_files != nullptr) << "DexFile::OpenFromZip: out-param is nullptr";
   DexFileLoaderErrorCode error_code;
+  // Issue readahead for all dex entries up front so that on a cold archive the
+  // kernel fetches the later entries while we extract the earlier ones.
+  for (size_t i = 0; ; ++i) {
+    std::string name = GetMultiDexClassesDexName(i);
+    std::string prefetch_error_msg;
+    std::unique_ptr<ZipEntry> zip_entry(zip_archive.Find(name.c_str(), &prefetch_error_msg));
+    if (zip_entry == nullptr) {
+      break;
+    }
+    zip_entry->Prefetch();
+  }
+  // Open all dex files unverified first; the deferred verification below can then
+  // process them in parallel.
+  std::vector<std::unique_ptr<const DexFile>> opened_dex_files;
   std::unique_ptr<const DexFile> dex_file(OpenOneDexFileFromZip(zip_archive,
                                                                 kClassesDex,
                                                                 location,
-                                                                verify,
+                                                                /*verify=*/ false,
                                                                 verify_checksum,
                                                                 error_msg,
                                                                 &error_code));
@@ -498,7 +566,7 @@ bool ArtDexFileLoader::OpenAllDexFilesFromZip(
     return false;
   } else {
     // Had at least classes.dex.
-    dex_files->push_back(std::move(dex_file));
+    opened_dex_files.push_back(std::move(dex_file));
 
     // Now try some more.
 
@@ -511,7 +579,7 @@ bool ArtDexFileLoader::OpenAllDexFilesFromZip(
       std::unique_ptr<const DexFile> next_dex_file(OpenOneDexFileFromZip(zip_archive,
                                                                          name.c_str(),
                                                                          fake_location,
-                                                                         verify,
+                                                                         /*verify=*/ false,
                                                                          verify_checksum,
                                                                          error_msg,
                                                                          &error_code));
@@ -521,7 +589,7 @@ bool ArtDexFileLoader::OpenAllDexFilesFromZip(
         }
         break;
       } else {
-        dex_files->push_back(std::move(next_dex_file));
+        opened_dex_files.push_back(std::move(next_dex_file));
       }
 
       if (i == kWarnOnManyDexFilesThreshold) {
@@ -536,6 +604,24 @@ bool ArtDexFileLoader::OpenAllDexFilesFromZip(
       }
     }
 
+    if (verify) {
+      size_t first_failed_index;
+      std::string verify_error_msg;
+      if (!VerifyDexFiles(opened_dex_files, verify_checksum, &first_failed_index,
+                          &verify_error_msg)) {
+        if (first_failed_index == 0u) {
+          *error_msg = std::move(verify_error_msg);
+          return false;
+        }
+        // Match the serial behavior: keep the dex files preceding the first failure.
+        LOG(WARNING) << "Zip open failed: " << verify_error_msg;
+        opened_dex_files.resize(first_failed_index);
+      }
+    }
+
+    for (std::unique_ptr<const DexFile>& opened_dex_file : opened_dex_files) {
+      dex_files->push_back(std::move(opened_dex_file));
+    }
     return true;
   }
 }
@@ -179,24 +179,30 @@ inline IterationRange<ClassAccessor::DataIterator<ClassAccessor::Field>>
 // Return an iteration range for the first <count> methods.
 inline IterationRange<ClassAccessor::DataIterator<ClassAccessor::Method>>
     ClassAccessor::GetMethodsInternal(size_t count) const {
-  // Skip over the fields.
-  Field field(dex_file_, ptr_pos_, hiddenapi_ptr_pos_);
-  VisitMembers(NumFields(), VoidFunctor(), &field);
+  if (method_section_ptr_pos_ == nullptr) {
+    // Skip over the fields. Memoize where the method section starts, so that callers
+    // iterating methods multiple times (e.g. direct methods and then virtual methods)
+    // decode the field section only once.
+    Field field(dex_file_, ptr_pos_, hiddenapi_ptr_pos_);
+    VisitMembers(NumFields(), VoidFunctor(), &field);
+    method_section_ptr_pos_ = field.ptr_pos_;
+    method_section_hiddenapi_ptr_pos_ = field.hiddenapi_ptr_pos_;
+  }
   // Return the iterator pair.
   return {
       DataIterator<Method>(dex_file_,
                            0u,
                            num_direct_methods_,
                            count,
-                           field.ptr_pos_,
-                           field.hiddenapi_ptr_pos_),
+                           method_section_ptr_pos_,
+                           method_section_hiddenapi_ptr_pos_),
       DataIterator<Method>(dex_file_,
                            count,
                            num_direct_methods_,
                            count,
                            // The following pointers are bogus but unused in the `end` iterator.
-                           field.ptr_pos_,
-                           field.hiddenapi_ptr_pos_) };
+                           method_section_ptr_pos_,
+                           method_section_hiddenapi_ptr_pos_) };
 }
 
 inline IterationRange<ClassAccessor::DataIterator<ClassAccessor::Field>> ClassAccessor::GetFields()
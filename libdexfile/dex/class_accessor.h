@@ -390,6 +390,10 @@ class ClassAccessor {
   const uint32_t num_instance_fields_ = 0u;
   const uint32_t num_direct_methods_ = 0u;
   const uint32_t num_virtual_methods_ = 0u;
+  // Start of the method section, memoized on first method iteration so that
+  // repeated iteration does not decode the field section again.
+  mutable const uint8_t* method_section_ptr_pos_ = nullptr;
+  mutable const uint8_t* method_section_hiddenapi_ptr_pos_ = nullptr;
 
   friend class dex::DexFileVerifier;
 };
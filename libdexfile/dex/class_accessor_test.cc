@@ -87,4 +87,24 @@ TEST_F(ClassAccessorTest, TestVisiting) {
   }
 }
 
+TEST_F(ClassAccessorTest, TestRepeatedMethodIteration) {
+  std::vector<std::unique_ptr<const DexFile>> dex_files(
+      OpenDexFiles(GetLibCoreDexFileNames()[0].c_str()));
+  ASSERT_GT(dex_files.size(), 0u);
+  for (const std::unique_ptr<const DexFile>& dex_file : dex_files) {
+    for (ClassAccessor accessor : dex_file->GetClasses()) {
+      // The second GetMethods() call uses the memoized method section start.
+      auto methods = accessor.GetMethods();
+      auto method_it = methods.begin();
+      for (const ClassAccessor::Method& method : accessor.GetMethods()) {
+        EXPECT_EQ(method.GetIndex(), method_it->GetIndex());
+        EXPECT_EQ(method.GetAccessFlags(), method_it->GetAccessFlags());
+        EXPECT_EQ(method.GetCodeItemOffset(), method_it->GetCodeItemOffset());
+        ++method_it;
+      }
+      ASSERT_TRUE(method_it == methods.end());
+    }
+  }
+}
+
 }  // namespace art
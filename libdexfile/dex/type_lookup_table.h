@@ -72,6 +72,19 @@ class TypeLookupTable {
   // If no data found then the method returns dex::kDexNoIndex.
   uint32_t Lookup(const char* str, uint32_t hash) const;
 
+  // Visit all classes in the table. The `visitor` is called with the class descriptor
+  // and the class def index of each entry, in unspecified order.
+  template <typename Visitor>
+  void Visit(Visitor&& visitor) const {
+    DCHECK(Valid());
+    for (uint32_t i = 0u, size = Size(); i != size; ++i) {
+      const Entry& entry = entries_[i];
+      if (!entry.IsEmpty()) {
+        visitor(GetStringData(entry), entry.GetClassDefIdx(mask_bits_));
+      }
+    }
+  }
+
   // Method returns pointer to binary data of lookup table. Used by the oat writer.
   const uint8_t* RawData() const {
     DCHECK(Valid());
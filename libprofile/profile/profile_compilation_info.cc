@@ -17,6 +17,7 @@
 #include "profile_compilation_info.h"
 
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -1202,6 +1203,27 @@ ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::OpenSource(
     /*out*/ std::unique_ptr<ProfileSource>* source,
     /*out*/ std::string* error) {
   if (IsProfileFile(fd)) {
+    struct stat stat_buffer;
+    if (fstat(fd, &stat_buffer) == 0 && stat_buffer.st_size > 0) {
+      // Map regular profile files instead of streaming them through read(2). The parser then
+      // works directly against the page cache, which removes the per-chunk copy syscalls and
+      // lets the kernel reclaim clean pages under memory pressure instead of keeping heap
+      // buffers alive while e.g. profman merges many profiles.
+      std::string map_error;
+      MemMap map = MemMap::MapFile(stat_buffer.st_size,
+                                   PROT_READ,
+                                   MAP_PRIVATE,
+                                   fd,
+                                   /*start=*/ 0,
+                                   /*low_4gb=*/ false,
+                                   /*filename=*/ "profile file",
+                                   &map_error);
+      if (map.IsValid()) {
+        source->reset(ProfileSource::Create(std::move(map)));
+        return kProfileLoadSuccess;
+      }
+      // Fall back to fd-based reading if the file cannot be mapped (e.g. not a regular file).
+    }
     source->reset(ProfileSource::Create(fd));
     return kProfileLoadSuccess;
   } else {
@@ -1248,10 +1270,8 @@ ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::ProfileSource:
     if (mem_map_cur_ + byte_count > mem_map_.Size()) {
       return kProfileLoadBadData;
     }
-    for (size_t i = 0; i < byte_count; i++) {
-      buffer[i] = *(mem_map_.Begin() + mem_map_cur_);
-      mem_map_cur_++;
-    }
+    memcpy(buffer, mem_map_.Begin() + mem_map_cur_, byte_count);
+    mem_map_cur_ += byte_count;
   } else {
     while (byte_count > 0) {
       int bytes_read = TEMP_FAILURE_RETRY(read(fd_, buffer, byte_count));;
@@ -2296,7 +2316,24 @@ FlattenProfileData::ItemMetadata::ItemMetadata() :
 
 FlattenProfileData::ItemMetadata::ItemMetadata(const ItemMetadata& other) :
     flags_(other.flags_),
-    annotations_(other.annotations_) {
+    annotations_(other.annotations_),
+    inline_caches_(other.inline_caches_) {
+}
+
+void FlattenProfileData::ItemMetadata::MergeInlineCaches(
+    const InlineCacheAggregationMap& other) {
+  auto create_inline_cache_fn = []() { return InlineCacheInfo(); };
+  auto create_count_fn = []() { return 0u; };
+  for (const auto& dex_pc_it : other) {
+    InlineCacheInfo& inline_cache =
+        inline_caches_.GetOrCreate(dex_pc_it.first, create_inline_cache_fn);
+    inline_cache.missing_types_count += dex_pc_it.second.missing_types_count;
+    inline_cache.megamorphic_count += dex_pc_it.second.megamorphic_count;
+    for (const auto& receiver_it : dex_pc_it.second.receivers) {
+      inline_cache.receivers.GetOrCreate(receiver_it.first, create_count_fn) +=
+          receiver_it.second;
+    }
+  }
 }
 
 std::unique_ptr<FlattenProfileData> ProfileCompilationInfo::ExtractProfileData(
@@ -2305,6 +2342,22 @@ std::unique_ptr<FlattenProfileData> ProfileCompilationInfo::ExtractProfileData(
   std::unique_ptr<FlattenProfileData> result(new FlattenProfileData());
 
   auto create_metadata_fn = []() { return FlattenProfileData::ItemMetadata(); };
+  auto create_inline_cache_fn = []() { return FlattenProfileData::ItemMetadata::InlineCacheInfo(); };
+  auto create_count_fn = []() { return 0u; };
+
+  // Map the profile indices to the given dex files so that inline cache receiver types
+  // can be resolved to descriptors. Dex files which were not passed in (e.g. receivers
+  // from outside the given classpath) stay null and are treated as missing types.
+  std::vector<const DexFile*> profile_index_to_dex_file(info_.size(), nullptr);
+  for (const DexFileData* dex_data : info_) {
+    for (const std::unique_ptr<const DexFile>& dex_file : dex_files) {
+      if (GetBaseKeyFromAugmentedKey(dex_data->profile_key) == dex_file->GetLocation() &&
+          dex_data->checksum == dex_file->GetLocationChecksum()) {
+        profile_index_to_dex_file[dex_data->profile_index] = dex_file.get();
+        break;
+      }
+    }
+  }
 
   // Iterate through all the dex files, find the methods/classes associated with each of them,
   // and add them to the flatten result.
@@ -2331,6 +2384,37 @@ std::unique_ptr<FlattenProfileData> ProfileCompilationInfo::ExtractProfileData(
             result->method_metadata_.GetOrCreate(ref, create_metadata_fn);
         metadata.flags_ |= hotness.flags_;
         metadata.annotations_.push_back(annotation);
+        // Aggregate the inline cache receiver types of hot methods so that consumers
+        // (e.g. boot image profile generation) can preserve them.
+        const auto method_map_it = dex_data->method_map.find(method_idx);
+        if (method_map_it != dex_data->method_map.end()) {
+          for (const auto& dex_pc_it : method_map_it->second) {
+            const DexPcData& dex_pc_data = dex_pc_it.second;
+            FlattenProfileData::ItemMetadata::InlineCacheInfo& inline_cache =
+                metadata.inline_caches_.GetOrCreate(dex_pc_it.first, create_inline_cache_fn);
+            if (dex_pc_data.is_missing_types) {
+              ++inline_cache.missing_types_count;
+            } else if (dex_pc_data.is_megamorphic) {
+              ++inline_cache.megamorphic_count;
+            } else {
+              bool missing_receiver_types = false;
+              for (const ClassReference& class_ref : dex_pc_data.classes) {
+                const DexFile* class_dex_file =
+                    profile_index_to_dex_file[class_ref.dex_profile_index];
+                if (class_dex_file == nullptr) {
+                  missing_receiver_types = true;
+                  continue;
+                }
+                const std::string descriptor(class_dex_file->GetTypeDescriptor(
+                    class_dex_file->GetTypeId(class_ref.type_index)));
+                ++inline_cache.receivers.GetOrCreate(descriptor, create_count_fn);
+              }
+              if (missing_receiver_types) {
+                ++inline_cache.missing_types_count;
+              }
+            }
+          }
+        }
         // Update the max aggregation counter for methods.
         // This is essentially a cache, to avoid traversing all the methods just to find out
         // this value.
@@ -2369,6 +2453,7 @@ void FlattenProfileData::MergeData(const FlattenProfileData& other) {
     metadata.flags_ |= otherData.GetFlags();
     metadata.annotations_.insert(
         metadata.annotations_.end(), other_annotations.begin(), other_annotations.end());
+    metadata.MergeInlineCaches(otherData.GetInlineCaches());
 
     max_aggregation_for_methods_ = std::max(
           max_aggregation_for_methods_,
@@ -982,6 +982,21 @@ class FlattenProfileData {
  public:
   class ItemMetadata {
    public:
+    // The aggregated inline cache data for a single call site. Receiver types are
+    // stored as descriptors because the flatten data outlives the profiles (and their
+    // dex references) it was extracted from.
+    struct InlineCacheInfo {
+      // The number of profiles in which the call site had missing types.
+      uint32_t missing_types_count = 0;
+      // The number of profiles in which the call site was megamorphic.
+      uint32_t megamorphic_count = 0;
+      // Maps the receiver type descriptor to the number of profiles that observed it.
+      SafeMap<std::string, uint32_t> receivers;
+    };
+
+    // Maps the dex pc of a call site to its aggregated inline cache data.
+    using InlineCacheAggregationMap = SafeMap<uint16_t, InlineCacheInfo>;
+
     ItemMetadata();
     ItemMetadata(const ItemMetadata& other);
 
@@ -993,6 +1008,10 @@ class FlattenProfileData {
       return annotations_;
     }
 
+    const InlineCacheAggregationMap& GetInlineCaches() const {
+      return inline_caches_;
+    }
+
     void AddFlag(ProfileCompilationInfo::MethodHotness::Flag flag) {
       flags_ |= flag;
     }
@@ -1002,11 +1021,17 @@ class FlattenProfileData {
     }
 
    private:
+    // Folds the given inline cache aggregation into this one, summing the counters.
+    void MergeInlineCaches(const InlineCacheAggregationMap& other);
+
     // will be 0 for classes and MethodHotness::Flags for methods.
     uint16_t flags_;
     // This is a list that may contain duplicates after a merge operation.
     // It represents that a method was used multiple times across different devices.
     std::list<ProfileCompilationInfo::ProfileSampleAnnotation> annotations_;
+    // The aggregated inline caches of the method (empty for classes and for methods
+    // that are not hot). The receiver counts are bounded by the annotation count.
+    InlineCacheAggregationMap inline_caches_;
 
     friend class ProfileCompilationInfo;
     friend class FlattenProfileData;
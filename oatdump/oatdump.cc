@@ -55,6 +55,7 @@
 #include "dex/descriptors_names.h"
 #include "dex/dex_file-inl.h"
 #include "dex/dex_instruction-inl.h"
+#include "dex/method_reference.h"
 #include "dex/string_reference.h"
 #include "dex/type_lookup_table.h"
 #include "dexlayout.h"
@@ -76,6 +77,7 @@
 #include "oat.h"
 #include "oat_file-inl.h"
 #include "oat_file_manager.h"
+#include "profile/profile_compilation_info.h"
 #include "scoped_thread_state_change-inl.h"
 #include "stack.h"
 #include "stack_map.h"
@@ -342,10 +344,13 @@ class OatDumperOptions {
                    bool list_classes,
                    bool list_methods,
                    bool dump_header_only,
+                   bool dump_code_size_by_package,
                    const char* export_dex_location,
                    const char* app_image,
                    const char* app_oat,
-                   uint32_t addr2instr)
+                   uint32_t addr2instr,
+                   const char* method_info_file,
+                   const char* profile_file)
     : dump_vmap_(dump_vmap),
       dump_code_info_stack_maps_(dump_code_info_stack_maps),
       disassemble_code_(disassemble_code),
@@ -355,10 +360,13 @@ class OatDumperOptions {
       list_classes_(list_classes),
       list_methods_(list_methods),
       dump_header_only_(dump_header_only),
+      dump_code_size_by_package_(dump_code_size_by_package),
       export_dex_location_(export_dex_location),
       app_image_(app_image),
       app_oat_(app_oat),
       addr2instr_(addr2instr),
+      method_info_file_(method_info_file),
+      profile_file_(profile_file),
       class_loader_(nullptr) {}
 
   const bool dump_vmap_;
@@ -370,10 +378,13 @@ class OatDumperOptions {
   const bool list_classes_;
   const bool list_methods_;
   const bool dump_header_only_;
+  const bool dump_code_size_by_package_;
   const char* const export_dex_location_;
   const char* const app_image_;
   const char* const app_oat_;
   uint32_t addr2instr_;
+  const char* const method_info_file_;
+  const char* const profile_file_;
   Handle<mirror::ClassLoader>* class_loader_;
 };
 
@@ -550,6 +561,21 @@ class OatDumper {
       }
     }
 
+    // Emit the per-method analysis CSV if requested. This is independent of the
+    // text dump so regression tooling can combine it with --header-only.
+    if (options_.method_info_file_ != nullptr) {
+      if (!DumpMethodInfo(os)) {
+        success = false;
+      }
+    }
+
+    // The per-package aggregation is also compact enough for --header-only use.
+    if (options_.dump_code_size_by_package_) {
+      if (!DumpCodeSizeByPackage(os)) {
+        success = false;
+      }
+    }
+
     if (!options_.dump_header_only_) {
       VariableIndentationOutputStream vios(&os);
       VdexFile::VerifierDepsHeader vdex_header = oat_file_.GetVdexFile()->GetVerifierDepsHeader();
@@ -952,6 +978,162 @@ class OatDumper {
     return success;
   }
 
+  // Write one CSV row per method to the file given with --dump-method-info: compiled
+  // code size, CodeInfo size, whether the code is deduplicated against an earlier
+  // method, and (if --profile was given) the profile hotness flags. The output is
+  // meant for size/performance regression tooling rather than for humans, so rows
+  // use raw descriptors and signatures instead of PrettyMethod (no embedded commas).
+  bool DumpMethodInfo(std::ostream& os) {
+    std::ofstream csv(options_.method_info_file_);
+    if (!csv) {
+      os << "Failed to open method info file '" << options_.method_info_file_ << "'\n";
+      return false;
+    }
+
+    std::unique_ptr<ProfileCompilationInfo> profile;
+    if (options_.profile_file_ != nullptr) {
+      profile.reset(new ProfileCompilationInfo());
+      if (!profile->Load(options_.profile_file_, /*clear_if_invalid=*/ false)) {
+        os << "Failed to load profile file '" << options_.profile_file_ << "'\n";
+        return false;
+      }
+    }
+
+    csv << "dex_location,class_descriptor,method_name,signature,dex_method_idx,"
+           "code_offset,code_size,code_info_size,deduped,hot,startup,post_startup\n";
+
+    bool success = true;
+    std::unordered_set<uint32_t> seen_code_offsets;
+    for (const OatDexFile* oat_dex_file : oat_dex_files_) {
+      CHECK(oat_dex_file != nullptr);
+      std::string error_msg;
+      const DexFile* const dex_file = OpenDexFile(oat_dex_file, &error_msg);
+      if (dex_file == nullptr) {
+        os << "Failed to open dex file '" << oat_dex_file->GetDexFileLocation() << "': "
+           << error_msg;
+        success = false;
+        continue;
+      }
+      for (ClassAccessor accessor : dex_file->GetClasses()) {
+        const char* descriptor = accessor.GetDescriptor();
+        if (DescriptorToDot(descriptor).find(options_.class_filter_) == std::string::npos) {
+          continue;
+        }
+        const OatFile::OatClass oat_class = oat_dex_file->GetOatClass(accessor.GetClassDefIndex());
+        uint32_t class_method_index = 0;
+        for (const ClassAccessor::Method& method : accessor.GetMethods()) {
+          const OatFile::OatMethod oat_method = oat_class.GetOatMethod(class_method_index);
+          ++class_method_index;
+          uint32_t dex_method_idx = method.GetIndex();
+          std::string method_name = dex_file->GetMethodName(dex_file->GetMethodId(dex_method_idx));
+          if (method_name.find(options_.method_filter_) == std::string::npos) {
+            continue;
+          }
+          uint32_t code_offset = AlignCodeOffset(oat_method.GetCodeOffset());
+          uint32_t code_size = oat_method.GetQuickCodeSize();
+          // The CodeInfo size can only be measured for optimizing-compiled methods;
+          // for dex-to-dex methods the vmap table holds quicken info of unknown size.
+          size_t code_info_size = 0u;
+          CodeItemDataAccessor code_item_accessor(*dex_file, method.GetCodeItem());
+          if (IsMethodGeneratedByOptimizingCompiler(oat_method, code_item_accessor)) {
+            size_t num_read_bits = 0u;
+            CodeInfo code_info(oat_method.GetVmapTable(), &num_read_bits);
+            code_info_size = BitsToBytesRoundUp(num_read_bits);
+          }
+          // Identical method bodies share one code offset; count only the first
+          // occurrence as taking up space.
+          bool deduped = code_size != 0u && !seen_code_offsets.insert(code_offset).second;
+          csv << dex_file->GetLocation() << ','
+              << descriptor << ','
+              << method_name << ','
+              << dex_file->GetMethodSignature(dex_file->GetMethodId(dex_method_idx)).ToString()
+              << ','
+              << dex_method_idx << ','
+              << StringPrintf("0x%08x", code_offset) << ','
+              << code_size << ','
+              << code_info_size << ','
+              << (deduped ? 1 : 0);
+          if (profile != nullptr) {
+            ProfileCompilationInfo::MethodHotness hotness =
+                profile->GetMethodHotness(MethodReference(dex_file, dex_method_idx));
+            csv << ',' << (hotness.IsHot() ? 1 : 0)
+                << ',' << (hotness.IsStartup() ? 1 : 0)
+                << ',' << (hotness.IsPostStartup() ? 1 : 0);
+          } else {
+            csv << ",,,";
+          }
+          csv << '\n';
+        }
+      }
+    }
+    os << "Method info written to '" << options_.method_info_file_ << "'\n\n";
+    os << std::flush;
+    return success;
+  }
+
+  // Aggregate compiled code size by the Java package of the declaring class and
+  // print one row per package, largest first. Deduplicated method bodies are
+  // attributed to their first occurrence only, so the totals add up to the
+  // space the packages actually occupy in the executable section.
+  bool DumpCodeSizeByPackage(std::ostream& os) {
+    struct PackageStats {
+      size_t code_size = 0u;
+      size_t method_count = 0u;
+    };
+    std::map<std::string, PackageStats> packages;
+    std::unordered_set<uint32_t> seen_code_offsets;
+    bool success = true;
+    for (const OatDexFile* oat_dex_file : oat_dex_files_) {
+      CHECK(oat_dex_file != nullptr);
+      std::string error_msg;
+      const DexFile* const dex_file = OpenDexFile(oat_dex_file, &error_msg);
+      if (dex_file == nullptr) {
+        os << "Failed to open dex file '" << oat_dex_file->GetDexFileLocation() << "': "
+           << error_msg;
+        success = false;
+        continue;
+      }
+      for (ClassAccessor accessor : dex_file->GetClasses()) {
+        const std::string dot_name = DescriptorToDot(accessor.GetDescriptor());
+        const size_t last_dot = dot_name.rfind('.');
+        const std::string package =
+            (last_dot == std::string::npos) ? "(default package)" : dot_name.substr(0, last_dot);
+        PackageStats& stats = packages[package];
+        const OatFile::OatClass oat_class = oat_dex_file->GetOatClass(accessor.GetClassDefIndex());
+        for (uint32_t i = 0, num_methods = accessor.NumMethods(); i != num_methods; ++i) {
+          const OatFile::OatMethod oat_method = oat_class.GetOatMethod(i);
+          const uint32_t code_size = oat_method.GetQuickCodeSize();
+          if (code_size == 0u) {
+            continue;
+          }
+          // Identical method bodies share one code offset; count only the first
+          // occurrence as taking up space.
+          const uint32_t code_offset = AlignCodeOffset(oat_method.GetCodeOffset());
+          if (!seen_code_offsets.insert(code_offset).second) {
+            continue;
+          }
+          stats.code_size += code_size;
+          ++stats.method_count;
+        }
+      }
+    }
+
+    std::vector<std::pair<std::string, PackageStats>> sorted(packages.begin(), packages.end());
+    std::sort(sorted.begin(),
+              sorted.end(),
+              [](const auto& lhs, const auto& rhs) {
+                return lhs.second.code_size > rhs.second.code_size;
+              });
+    os << "CODE SIZE BY PACKAGE (bytes / methods / package):\n";
+    for (const auto& entry : sorted) {
+      os << entry.second.code_size << " " << entry.second.method_count << " "
+         << entry.first << "\n";
+    }
+    os << "\n";
+    os << std::flush;
+    return success;
+  }
+
   // Backwards compatible Dex file export. If dex_file is nullptr (valid Vdex file not present) the
   // Dex resource is extracted from the oat_dex_file and its checksum is repaired since it's not
   // unquickened. Otherwise the dex_file has been fully unquickened and is expected to verify the
@@ -3455,6 +3637,12 @@ struct OatdumpArgs : public CmdlineArgs {
       app_image_ = raw_option + strlen("--app-image=");
     } else if (StartsWith(option, "--app-oat=")) {
       app_oat_ = raw_option + strlen("--app-oat=");
+    } else if (StartsWith(option, "--dump-method-info=")) {
+      method_info_file_ = raw_option + strlen("--dump-method-info=");
+    } else if (option == "--dump-code-size-by-package") {
+      dump_code_size_by_package_ = true;
+    } else if (StartsWith(option, "--profile=")) {
+      profile_file_ = raw_option + strlen("--profile=");
     } else if (StartsWith(option, "--dump-imt=")) {
       imt_dump_ = std::string(option.substr(strlen("--dump-imt=")));
     } else if (option == "--dump-imt-stats") {
@@ -3556,6 +3744,20 @@ struct OatdumpArgs : public CmdlineArgs {
         "                          address (e.g. PC from crash dump)\n"
         "      Example: --addr2instr=0x00001a3b\n"
         "\n"
+        "  --dump-method-info=<file.csv>: output one CSV row per method with compiled\n"
+        "                                 code size, CodeInfo size, dedup status and,\n"
+        "                                 with --profile, profile hotness flags. Can be\n"
+        "                                 combined with --header-only and the filters.\n"
+        "      Example: --dump-method-info=methods.csv\n"
+        "\n"
+        "  --profile=<file.prof>: a profile to cross-reference in --dump-method-info.\n"
+        "      Example: --dump-method-info=methods.csv --profile=primary.prof\n"
+        "\n"
+        "  --dump-code-size-by-package: aggregate compiled code size by the Java package\n"
+        "                               of the declaring class, one row per package,\n"
+        "                               largest first. Can be combined with --header-only.\n"
+        "      Example: --dump-code-size-by-package\n"
+        "\n"
         "  --dump-imt=<file.txt>: output IMT collisions (if any) for the given receiver\n"
         "                         types and interface methods in the given file. The file\n"
         "                         is read line-wise, where each line should either be a class\n"
@@ -3591,6 +3793,9 @@ struct OatdumpArgs : public CmdlineArgs {
   const char* export_dex_location_ = nullptr;
   const char* app_image_ = nullptr;
   const char* app_oat_ = nullptr;
+  const char* method_info_file_ = nullptr;
+  const char* profile_file_ = nullptr;
+  bool dump_code_size_by_package_ = false;
 };
 
 struct OatdumpMain : public CmdlineMain<OatdumpArgs> {
@@ -3610,10 +3815,13 @@ struct OatdumpMain : public CmdlineMain<OatdumpArgs> {
         args_->list_classes_,
         args_->list_methods_,
         args_->dump_header_only_,
+        args_->dump_code_size_by_package_,
         args_->export_dex_location_,
         args_->app_image_,
         args_->app_oat_,
-        args_->addr2instr_));
+        args_->addr2instr_,
+        args_->method_info_file_,
+        args_->profile_file_));
 
     return (args_->boot_image_location_ != nullptr ||
             args_->image_location_ != nullptr ||
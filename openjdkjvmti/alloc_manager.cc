@@ -90,6 +90,11 @@ void JvmtiAllocationListener::ObjectAllocated(art::Thread* self,
   if (cb != nullptr && manager_->callback_enabled_.load(std::memory_order_seq_cst)) {
     cb->ObjectAllocated(self, obj, cnt);
   }
+  auto index_cb = manager_->heap_index_callback_;
+  if (index_cb != nullptr &&
+      manager_->heap_index_callback_enabled_.load(std::memory_order_seq_cst)) {
+    index_cb->ObjectAllocated(self, obj, cnt);
+  }
 }
 
 bool JvmtiAllocationListener::HasPreAlloc() const {
@@ -140,6 +145,18 @@ void AllocationManager::RemoveAllocListener() {
   callback_ = nullptr;
 }
 
+void AllocationManager::SetHeapIndexCallback(AllocationCallback* callback) {
+  CHECK(heap_index_callback_ == nullptr) << "Already setup!";
+  heap_index_callback_ = callback;
+}
+
+void AllocationManager::EnableHeapIndexCallback(art::Thread* self) {
+  // Once enabled the listener install is never given back; see the class comment.
+  if (!heap_index_callback_enabled_.exchange(true, std::memory_order_seq_cst)) {
+    IncrListenerInstall(self);
+  }
+}
+
 void AllocationManager::DecrListenerInstall(art::Thread* self) {
   art::ScopedThreadSuspension sts(self, art::ThreadState::kSuspended);
   art::MutexLock mu(self, alloc_listener_mutex_);
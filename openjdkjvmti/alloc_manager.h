@@ -84,6 +84,13 @@ class AllocationManager {
   void SetAllocListener(AllocationCallback* callback);
   void RemoveAllocListener();
 
+  // A secondary callback used by the per-class heap instance index (see ti_heap). Unlike the
+  // event callback it is never removed; once enabled the underlying allocation listener stays
+  // installed for the lifetime of the runtime (see the comment in PauseAllocations for why
+  // uninstalling listeners is fraught).
+  void SetHeapIndexCallback(AllocationCallback* callback);
+  void EnableHeapIndexCallback(art::Thread* self) REQUIRES_SHARED(art::Locks::mutator_lock_);
+
   static AllocationManager* Get();
 
   void PauseAllocations(art::Thread* self) REQUIRES_SHARED(art::Locks::mutator_lock_);
@@ -99,6 +106,8 @@ class AllocationManager {
   void DecrListenerInstall(art::Thread* self) REQUIRES_SHARED(art::Locks::mutator_lock_);
 
   AllocationCallback* callback_ = nullptr;
+  AllocationCallback* heap_index_callback_ = nullptr;
+  std::atomic<bool> heap_index_callback_enabled_ = false;
   uint32_t listener_refcount_ GUARDED_BY(alloc_listener_mutex_) = 0;
   std::atomic<bool> allocations_paused_ever_ = false;
   std::atomic<art::Thread*> allocations_paused_thread_ = nullptr;
@@ -36,6 +36,7 @@
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <jni.h>
 
@@ -95,6 +96,13 @@ struct ArtJvmTiEnv : public jvmtiEnv {
   std::unordered_set<art::ArtField*> access_watched_fields GUARDED_BY(event_info_mutex_);
   std::unordered_set<art::ArtField*> modify_watched_fields GUARDED_BY(event_info_mutex_);
 
+  // The methods that were individually deoptimized for each watched field (because their bytecode
+  // accesses the field), so they can be re-optimized when the watch is cleared. See ti_field.
+  std::unordered_map<art::ArtField*, std::vector<art::ArtMethod*>> access_watch_deopt_methods
+      GUARDED_BY(event_info_mutex_);
+  std::unordered_map<art::ArtField*, std::vector<art::ArtMethod*>> modify_watch_deopt_methods
+      GUARDED_BY(event_info_mutex_);
+
   // Set of breakpoints is unique to each jvmtiEnv.
   std::unordered_set<Breakpoint> breakpoints GUARDED_BY(event_info_mutex_);
   std::unordered_set<const art::ShadowFrame*> notify_frames GUARDED_BY(event_info_mutex_);
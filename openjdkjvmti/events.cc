@@ -1142,14 +1142,19 @@ static DeoptRequirement GetDeoptRequirement(ArtJvmtiEvent event, jthread thread)
     case ArtJvmtiEvent::kBreakpoint:
     case ArtJvmtiEvent::kException:
       return DeoptRequirement::kLimited;
+    // Field watch events only need the methods whose bytecode accesses a watched field to run in
+    // the interpreter. Those methods are deoptimized individually when the watch is installed and
+    // whenever a class is prepared while a watch is active (see ti_field), the same way
+    // breakpoints deoptimize only the method they are placed in.
+    case ArtJvmtiEvent::kFieldModification:
+    case ArtJvmtiEvent::kFieldAccess:
+      return DeoptRequirement::kLimited;
     // TODO MethodEntry is needed due to inconsistencies between the interpreter and the trampoline
     // in how to handle exceptions.
     case ArtJvmtiEvent::kMethodEntry:
     case ArtJvmtiEvent::kExceptionCatch:
       return DeoptRequirement::kFull;
     case ArtJvmtiEvent::kMethodExit:
-    case ArtJvmtiEvent::kFieldModification:
-    case ArtJvmtiEvent::kFieldAccess:
     case ArtJvmtiEvent::kSingleStep:
     case ArtJvmtiEvent::kFramePop:
     case ArtJvmtiEvent::kForceEarlyReturnUpdateReturnValue:
@@ -1235,9 +1240,11 @@ void EventHandler::SetupTraceListener(JvmtiMethodTraceListener* listener,
   if (new_events == 0) {
     return;
   }
-  art::ScopedThreadStateChange stsc(art::Thread::Current(), art::ThreadState::kNative);
+  // Listener slots are updated atomically, so toggling a listener only needs the shared mutator
+  // lock; any stub or deoptimization changes the event needs are handled separately through the
+  // DeoptManager (see HandleEventDeopt).
+  art::ScopedObjectAccess soa(art::Thread::Current());
   art::instrumentation::Instrumentation* instr = art::Runtime::Current()->GetInstrumentation();
-  art::ScopedSuspendAll ssa("jvmti method tracing installation");
   if (enable) {
     instr->AddListener(listener, new_events);
   } else {
@@ -30,17 +30,26 @@
  */
 
 #include "ti_field.h"
+#include <atomic>
+#include <cstring>
 #include <unordered_map>
+#include <vector>
 
 #include "android-base/thread_annotations.h"
 #include "art_field-inl.h"
 #include "art_field.h"
 #include "art_jvmti.h"
+#include "art_method-inl.h"
 #include "base/enums.h"
 #include "base/locks.h"
+#include "class_linker.h"
+#include "deopt_manager.h"
+#include "dex/code_item_accessors-inl.h"
 #include "dex/dex_file_annotations.h"
+#include "dex/dex_instruction-inl.h"
 #include "dex/modifiers.h"
 #include "jni/jni_internal.h"
+#include "mirror/class-inl.h"
 #include "mirror/object_array-inl.h"
 #include "reflective_value_visitor.h"
 #include "runtime.h"
@@ -108,22 +117,6 @@ struct FieldReflectiveValueCallback : public art::ReflectiveValueVisitCallback {
 
 static FieldReflectiveValueCallback gReflectiveValueCallback;
 
-void FieldUtil::Register(EventHandler* eh) {
-  gReflectiveValueCallback.event_handler = eh;
-  art::ScopedThreadStateChange stsc(art::Thread::Current(),
-                                    art::ThreadState::kWaitingForDebuggerToAttach);
-  art::ScopedSuspendAll ssa("Add reflective value visit callback");
-  art::RuntimeCallbacks* callbacks = art::Runtime::Current()->GetRuntimeCallbacks();
-  callbacks->AddReflectiveValueVisitCallback(&gReflectiveValueCallback);
-}
-
-void FieldUtil::Unregister() {
-  art::ScopedThreadStateChange stsc(art::Thread::Current(),
-                                    art::ThreadState::kWaitingForDebuggerToAttach);
-  art::ScopedSuspendAll ssa("Remove reflective value visit callback");
-  art::RuntimeCallbacks* callbacks = art::Runtime::Current()->GetRuntimeCallbacks();
-  callbacks->RemoveReflectiveValueVisitCallback(&gReflectiveValueCallback);
-}
 // Note: For all these functions, we could do a check that the field actually belongs to the given
 //       class. But the spec seems to assume a certain encoding of the field ID, and so doesn't
 //       specify any errors.
@@ -268,71 +261,337 @@ jvmtiError FieldUtil::IsFieldSynthetic(jvmtiEnv* env ATTRIBUTE_UNUSED,
   return ERR(NONE);
 }
 
+namespace {
+
+// Collects the loaded methods whose bytecode contains an access of the given field. Only these
+// methods need to be pushed into the interpreter for a field watch; the rest of the app keeps
+// running compiled code. Classes prepared after the watch is installed are scanned the same way
+// by gFieldWatchClassCallback below, so their field-accessing methods are deoptimized before any
+// of their code can be compiled and run.
+class FieldAccessMethodVisitor : public art::ClassVisitor {
+ public:
+  FieldAccessMethodVisitor(art::ArtField* field, std::vector<art::ArtMethod*>* out)
+      : field_(field), out_(out) {}
+
+  bool operator()(art::ObjPtr<art::mirror::Class> klass)
+      override REQUIRES_SHARED(art::Locks::mutator_lock_) {
+    if (!klass->IsLoaded()) {
+      // Skip classes that aren't loaded since they might not have fully allocated and
+      // initialized their methods, and they cannot have code running yet.
+      return true;
+    }
+    for (art::ArtMethod& m : klass->GetMethods(art::kRuntimePointerSize)) {
+      if (m.IsNative() || m.IsAbstract() || m.IsProxyMethod()) {
+        continue;
+      }
+      art::CodeItemInstructionAccessor accessor = m.DexInstructions();
+      if (!accessor.HasCodeItem()) {
+        continue;
+      }
+      for (const art::DexInstructionPcPair& pair : accessor) {
+        const art::Instruction& inst = pair.Inst();
+        bool is_iget_iput = inst.Opcode() >= art::Instruction::IGET &&
+                            inst.Opcode() <= art::Instruction::IPUT_SHORT;
+        bool is_sget_sput = inst.Opcode() >= art::Instruction::SGET &&
+                            inst.Opcode() <= art::Instruction::SPUT_SHORT;
+        if (!is_iget_iput && !is_sget_sput) {
+          continue;
+        }
+        uint32_t field_idx = is_iget_iput ? inst.VRegC_22c() : inst.VRegB_21c();
+        if (MatchesField(&m, field_idx, is_sget_sput)) {
+          out_->push_back(&m);
+          break;
+        }
+      }
+    }
+    return true;
+  }
+
+ private:
+  bool MatchesField(art::ArtMethod* referrer, uint32_t field_idx, bool is_static)
+      REQUIRES_SHARED(art::Locks::mutator_lock_) {
+    art::ArtField* f =
+        art::Runtime::Current()->GetClassLinker()->LookupResolvedField(field_idx,
+                                                                       referrer,
+                                                                       is_static);
+    if (f != nullptr) {
+      return f == field_;
+    }
+    // The reference has not been resolved from this dex file yet. Compare the name and type
+    // descriptor textually; matching without the declaring class errs on the side of
+    // deoptimizing too many methods, which is safe.
+    const art::DexFile* dex_file = referrer->GetDexFile();
+    const art::dex::FieldId& field_id = dex_file->GetFieldId(field_idx);
+    return strcmp(dex_file->GetFieldName(field_id), field_->GetName()) == 0 &&
+           strcmp(dex_file->GetFieldTypeDescriptor(field_id), field_->GetTypeDescriptor()) == 0;
+  }
+
+  art::ArtField* const field_;
+  std::vector<art::ArtMethod*>* const out_;
+};
+
+std::vector<art::ArtMethod*> CollectFieldAccessMethods(art::ArtField* field)
+    REQUIRES_SHARED(art::Locks::mutator_lock_) {
+  std::vector<art::ArtMethod*> methods;
+  FieldAccessMethodVisitor visitor(field, &methods);
+  art::Runtime::Current()->GetClassLinker()->VisitClasses(&visitor);
+  return methods;
+}
+
+std::vector<art::ArtMethod*> CollectFieldAccessMethodsInClass(art::ObjPtr<art::mirror::Class> klass,
+                                                              art::ArtField* field)
+    REQUIRES_SHARED(art::Locks::mutator_lock_) {
+  std::vector<art::ArtMethod*> methods;
+  FieldAccessMethodVisitor visitor(field, &methods);
+  visitor(klass);
+  return methods;
+}
+
+// Number of field watches currently installed, across all environments. Lets the class-prepare
+// callback below return immediately in the common case where no agent is watching any field.
+std::atomic<size_t> gWatchedFieldCount(0);
+
+// Keeps field watches complete for classes prepared after a watch was installed. SetField*Watch
+// only scans the classes loaded when the watch is set; without this callback a later-loaded
+// class could get its field-accessing methods compiled and silently stop generating the
+// FieldAccess/FieldModification events the spec requires. Matching methods are deoptimized and
+// recorded in the per-field bookkeeping so ClearField*Watch re-optimizes them as well.
+struct FieldWatchClassCallback : public art::ClassLoadCallback {
+  void ClassLoad(art::Handle<art::mirror::Class> klass ATTRIBUTE_UNUSED) override
+      REQUIRES_SHARED(art::Locks::mutator_lock_) {}
+
+  void ClassPrepare(art::Handle<art::mirror::Class> temp_klass ATTRIBUTE_UNUSED,
+                    art::Handle<art::mirror::Class> klass) override
+      REQUIRES_SHARED(art::Locks::mutator_lock_) {
+    if (gWatchedFieldCount.load(std::memory_order_acquire) == 0u) {
+      return;
+    }
+    art::Thread* self = art::Thread::Current();
+    event_handler->ForEachEnv(self, [&](ArtJvmTiEnv* env) {
+      DeoptimizeWatchedFieldAccessors(self, env, klass, /*modification=*/false);
+      DeoptimizeWatchedFieldAccessors(self, env, klass, /*modification=*/true);
+    });
+  }
+
+  EventHandler* event_handler = nullptr;
+
+ private:
+  // Deoptimizes the methods of the newly prepared class that access a field in the env's watched
+  // set. Takes env->event_info_mutex_ manually, so no static analysis.
+  static void DeoptimizeWatchedFieldAccessors(art::Thread* self,
+                                              ArtJvmTiEnv* env,
+                                              art::Handle<art::mirror::Class> klass,
+                                              bool modification) NO_THREAD_SAFETY_ANALYSIS {
+    auto& watched_fields = modification ? env->modify_watched_fields : env->access_watched_fields;
+    auto& deopt_methods =
+        modification ? env->modify_watch_deopt_methods : env->access_watch_deopt_methods;
+    // Snapshot the watched fields; AddMethodBreakpoint may suspend all threads and so cannot be
+    // called with event_info_mutex_ held.
+    std::vector<art::ArtField*> fields;
+    {
+      art::ReaderMutexLock mu(self, env->event_info_mutex_);
+      fields.assign(watched_fields.begin(), watched_fields.end());
+    }
+    for (art::ArtField* field : fields) {
+      std::vector<art::ArtMethod*> accessors =
+          CollectFieldAccessMethodsInClass(klass.Get(), field);
+      if (accessors.empty()) {
+        continue;
+      }
+      for (art::ArtMethod* m : accessors) {
+        DeoptManager::Get()->AddMethodBreakpoint(m);
+      }
+      bool still_watched = false;
+      {
+        art::WriterMutexLock mu(self, env->event_info_mutex_);
+        if (watched_fields.find(field) != watched_fields.end()) {
+          still_watched = true;
+          std::vector<art::ArtMethod*>& deopted = deopt_methods[field];
+          deopted.insert(deopted.end(), accessors.begin(), accessors.end());
+        }
+      }
+      if (!still_watched) {
+        // The watch was cleared while we were deoptimizing; undo our additions.
+        for (art::ArtMethod* m : accessors) {
+          DeoptManager::Get()->RemoveMethodBreakpoint(m);
+        }
+      }
+    }
+  }
+};
+
+FieldWatchClassCallback gFieldWatchClassCallback;
+
+}  // namespace
+
+void FieldUtil::Register(EventHandler* eh) {
+  gReflectiveValueCallback.event_handler = eh;
+  gFieldWatchClassCallback.event_handler = eh;
+  art::ScopedThreadStateChange stsc(art::Thread::Current(),
+                                    art::ThreadState::kWaitingForDebuggerToAttach);
+  art::ScopedSuspendAll ssa("Add field callbacks");
+  art::RuntimeCallbacks* callbacks = art::Runtime::Current()->GetRuntimeCallbacks();
+  callbacks->AddReflectiveValueVisitCallback(&gReflectiveValueCallback);
+  callbacks->AddClassLoadCallback(&gFieldWatchClassCallback);
+}
+
+void FieldUtil::Unregister() {
+  art::ScopedThreadStateChange stsc(art::Thread::Current(),
+                                    art::ThreadState::kWaitingForDebuggerToAttach);
+  art::ScopedSuspendAll ssa("Remove field callbacks");
+  art::RuntimeCallbacks* callbacks = art::Runtime::Current()->GetRuntimeCallbacks();
+  callbacks->RemoveReflectiveValueVisitCallback(&gReflectiveValueCallback);
+  callbacks->RemoveClassLoadCallback(&gFieldWatchClassCallback);
+}
+
 jvmtiError FieldUtil::SetFieldModificationWatch(jvmtiEnv* jenv, jclass klass, jfieldID field) {
   ArtJvmTiEnv* env = ArtJvmTiEnv::AsArtJvmTiEnv(jenv);
-  art::WriterMutexLock lk(art::Thread::Current(), env->event_info_mutex_);
   if (klass == nullptr) {
     return ERR(INVALID_CLASS);
   }
   if (field == nullptr) {
     return ERR(INVALID_FIELDID);
   }
-  auto res_pair = env->modify_watched_fields.insert(art::jni::DecodeArtField(field));
-  if (!res_pair.second) {
-    // Didn't get inserted because it's already present!
-    return ERR(DUPLICATE);
+  art::ScopedObjectAccess soa(art::Thread::Current());
+  art::ArtField* art_field = art::jni::DecodeArtField(field);
+  {
+    art::WriterMutexLock lk(art::Thread::Current(), env->event_info_mutex_);
+    auto res_pair = env->modify_watched_fields.insert(art_field);
+    if (!res_pair.second) {
+      // Didn't get inserted because it's already present!
+      return ERR(DUPLICATE);
+    }
+  }
+  // Publish the watch before scanning: classes prepared from here on are covered by
+  // gFieldWatchClassCallback, classes already loaded by the scan below, and classes preparing
+  // concurrently possibly by both — the duplicated breakpoints are balanced by the duplicated
+  // records, so ClearFieldModificationWatch removes them all.
+  gWatchedFieldCount.fetch_add(1, std::memory_order_release);
+  // Deoptimize only the methods that contain accesses of the watched field, like breakpoints do,
+  // instead of forcing the whole process into the interpreter.
+  std::vector<art::ArtMethod*> accessors = CollectFieldAccessMethods(art_field);
+  for (art::ArtMethod* m : accessors) {
+    DeoptManager::Get()->AddMethodBreakpoint(m);
+  }
+  bool still_watched = false;
+  {
+    art::WriterMutexLock lk(art::Thread::Current(), env->event_info_mutex_);
+    if (env->modify_watched_fields.find(art_field) != env->modify_watched_fields.end()) {
+      still_watched = true;
+      std::vector<art::ArtMethod*>& deopted = env->modify_watch_deopt_methods[art_field];
+      deopted.insert(deopted.end(), accessors.begin(), accessors.end());
+    }
+  }
+  if (!still_watched) {
+    // The watch was already cleared again; drop the breakpoints we just added.
+    for (art::ArtMethod* m : accessors) {
+      DeoptManager::Get()->RemoveMethodBreakpoint(m);
+    }
   }
   return OK;
 }
 
 jvmtiError FieldUtil::ClearFieldModificationWatch(jvmtiEnv* jenv, jclass klass, jfieldID field) {
   ArtJvmTiEnv* env = ArtJvmTiEnv::AsArtJvmTiEnv(jenv);
-  art::WriterMutexLock lk(art::Thread::Current(), env->event_info_mutex_);
   if (klass == nullptr) {
     return ERR(INVALID_CLASS);
   }
   if (field == nullptr) {
     return ERR(INVALID_FIELDID);
   }
-  auto pos = env->modify_watched_fields.find(art::jni::DecodeArtField(field));
-  if (pos == env->modify_watched_fields.end()) {
-    return ERR(NOT_FOUND);
+  art::ScopedObjectAccess soa(art::Thread::Current());
+  art::ArtField* art_field = art::jni::DecodeArtField(field);
+  std::vector<art::ArtMethod*> deopted;
+  {
+    art::WriterMutexLock lk(art::Thread::Current(), env->event_info_mutex_);
+    auto pos = env->modify_watched_fields.find(art_field);
+    if (pos == env->modify_watched_fields.end()) {
+      return ERR(NOT_FOUND);
+    }
+    env->modify_watched_fields.erase(pos);
+    auto deopt_it = env->modify_watch_deopt_methods.find(art_field);
+    if (deopt_it != env->modify_watch_deopt_methods.end()) {
+      deopted = std::move(deopt_it->second);
+      env->modify_watch_deopt_methods.erase(deopt_it);
+    }
+  }
+  gWatchedFieldCount.fetch_sub(1, std::memory_order_release);
+  for (art::ArtMethod* m : deopted) {
+    DeoptManager::Get()->RemoveMethodBreakpoint(m);
   }
-  env->modify_watched_fields.erase(pos);
   return OK;
 }
 
 jvmtiError FieldUtil::SetFieldAccessWatch(jvmtiEnv* jenv, jclass klass, jfieldID field) {
   ArtJvmTiEnv* env = ArtJvmTiEnv::AsArtJvmTiEnv(jenv);
-  art::WriterMutexLock lk(art::Thread::Current(), env->event_info_mutex_);
   if (klass == nullptr) {
     return ERR(INVALID_CLASS);
   }
   if (field == nullptr) {
     return ERR(INVALID_FIELDID);
   }
-  auto res_pair = env->access_watched_fields.insert(art::jni::DecodeArtField(field));
-  if (!res_pair.second) {
-    // Didn't get inserted because it's already present!
-    return ERR(DUPLICATE);
+  art::ScopedObjectAccess soa(art::Thread::Current());
+  art::ArtField* art_field = art::jni::DecodeArtField(field);
+  // See SetFieldModificationWatch.
+  {
+    art::WriterMutexLock lk(art::Thread::Current(), env->event_info_mutex_);
+    auto res_pair = env->access_watched_fields.insert(art_field);
+    if (!res_pair.second) {
+      // Didn't get inserted because it's already present!
+      return ERR(DUPLICATE);
+    }
+  }
+  gWatchedFieldCount.fetch_add(1, std::memory_order_release);
+  std::vector<art::ArtMethod*> accessors = CollectFieldAccessMethods(art_field);
+  for (art::ArtMethod* m : accessors) {
+    DeoptManager::Get()->AddMethodBreakpoint(m);
+  }
+  bool still_watched = false;
+  {
+    art::WriterMutexLock lk(art::Thread::Current(), env->event_info_mutex_);
+    if (env->access_watched_fields.find(art_field) != env->access_watched_fields.end()) {
+      still_watched = true;
+      std::vector<art::ArtMethod*>& deopted = env->access_watch_deopt_methods[art_field];
+      deopted.insert(deopted.end(), accessors.begin(), accessors.end());
+    }
+  }
+  if (!still_watched) {
+    // The watch was already cleared again; drop the breakpoints we just added.
+    for (art::ArtMethod* m : accessors) {
+      DeoptManager::Get()->RemoveMethodBreakpoint(m);
+    }
   }
   return OK;
 }
 
 jvmtiError FieldUtil::ClearFieldAccessWatch(jvmtiEnv* jenv, jclass klass, jfieldID field) {
   ArtJvmTiEnv* env = ArtJvmTiEnv::AsArtJvmTiEnv(jenv);
-  art::WriterMutexLock lk(art::Thread::Current(), env->event_info_mutex_);
   if (klass == nullptr) {
     return ERR(INVALID_CLASS);
   }
   if (field == nullptr) {
     return ERR(INVALID_FIELDID);
   }
-  auto pos = env->access_watched_fields.find(art::jni::DecodeArtField(field));
-  if (pos == env->access_watched_fields.end()) {
-    return ERR(NOT_FOUND);
+  art::ScopedObjectAccess soa(art::Thread::Current());
+  art::ArtField* art_field = art::jni::DecodeArtField(field);
+  std::vector<art::ArtMethod*> deopted;
+  {
+    art::WriterMutexLock lk(art::Thread::Current(), env->event_info_mutex_);
+    auto pos = env->access_watched_fields.find(art_field);
+    if (pos == env->access_watched_fields.end()) {
+      return ERR(NOT_FOUND);
+    }
+    env->access_watched_fields.erase(pos);
+    auto deopt_it = env->access_watch_deopt_methods.find(art_field);
+    if (deopt_it != env->access_watch_deopt_methods.end()) {
+      deopted = std::move(deopt_it->second);
+      env->access_watch_deopt_methods.erase(deopt_it);
+    }
+  }
+  gWatchedFieldCount.fetch_sub(1, std::memory_order_release);
+  for (art::ArtMethod* m : deopted) {
+    DeoptManager::Get()->RemoveMethodBreakpoint(m);
   }
-  env->access_watched_fields.erase(pos);
   return OK;
 }
 
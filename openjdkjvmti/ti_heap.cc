@@ -17,13 +17,18 @@
 #include "ti_heap.h"
 
 #include <ios>
+#include <memory>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "android-base/logging.h"
 #include "android-base/thread_annotations.h"
+#include "alloc_manager.h"
 #include "arch/context.h"
 #include "art_field-inl.h"
 #include "art_jvmti.h"
+#include "base/casts.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/mutex.h"
@@ -38,6 +43,7 @@
 #include "gc/heap-visit-objects-inl.h"
 #include "gc/heap-inl.h"
 #include "gc/scoped_gc_critical_section.h"
+#include "gc/system_weak.h"
 #include "gc_root-inl.h"
 #include "handle.h"
 #include "handle_scope.h"
@@ -90,6 +96,176 @@ using IndexCachingTable = JvmtiWeakTable<IndexCache>;
 
 static IndexCachingTable gIndexCachingTable;
 
+// An optional per-class instance index to speed up repeated IterateOverInstancesOfClass queries.
+// The first query for a class registers the class here and seeds its index from the full heap
+// walk that query has to perform anyway; afterwards newly allocated instances are fed in through
+// the AllocationManager's listener and dead or moved instances are fixed up when the GC sweeps
+// system weaks, so later queries for the same class only visit actual instances. At most
+// kMaxIndexedClasses classes are indexed to bound the per-allocation cost; queries for further
+// classes keep using full heap walks.
+class HeapInstanceIndex : public art::gc::SystemWeakHolder,
+                          public AllocationManager::AllocationCallback {
+ public:
+  static constexpr size_t kMaxIndexedClasses = 16;
+
+  HeapInstanceIndex() : art::gc::SystemWeakHolder(art::kTaggingLockLevel) {}
+
+  // Returns whether a (not yet indexed) class can still be indexed.
+  bool CanIndex(art::Thread* self, art::ObjPtr<art::mirror::Class> klass)
+      REQUIRES_SHARED(art::Locks::mutator_lock_)
+      REQUIRES(!allow_disallow_lock_) {
+    art::MutexLock mu(self, allow_disallow_lock_);
+    Wait(self);
+    return classes_.size() < kMaxIndexedClasses && Find(klass) == nullptr;
+  }
+
+  // Creates an incomplete index entry for klass. The caller must feed every matching object of
+  // its subsequent heap walk into RecordInstance and finish with MarkComplete. Returns false if
+  // another thread won the race for this class or capacity ran out.
+  bool StartIndexing(art::Thread* self, art::ObjPtr<art::mirror::Class> klass)
+      REQUIRES_SHARED(art::Locks::mutator_lock_)
+      REQUIRES(!allow_disallow_lock_) {
+    art::MutexLock mu(self, allow_disallow_lock_);
+    Wait(self);
+    if (classes_.size() >= kMaxIndexedClasses || Find(klass) != nullptr) {
+      return false;
+    }
+    classes_.emplace_back();
+    ClassIndex& index = classes_.back();
+    index.klass = art::GcRoot<art::mirror::Class>(klass);
+    index.populating.reset(new std::unordered_set<art::mirror::Object*>());
+    return true;
+  }
+
+  void RecordInstance(art::Thread* self,
+                      art::ObjPtr<art::mirror::Class> klass,
+                      art::mirror::Object* obj)
+      REQUIRES_SHARED(art::Locks::mutator_lock_)
+      REQUIRES(!allow_disallow_lock_) {
+    art::MutexLock mu(self, allow_disallow_lock_);
+    Wait(self);
+    ClassIndex* index = Find(klass);
+    DCHECK(index != nullptr);
+    if (index->populating == nullptr || index->populating->insert(obj).second) {
+      index->instances.push_back(art::GcRoot<art::mirror::Object>(obj));
+    }
+  }
+
+  void MarkComplete(art::Thread* self, art::ObjPtr<art::mirror::Class> klass)
+      REQUIRES_SHARED(art::Locks::mutator_lock_)
+      REQUIRES(!allow_disallow_lock_) {
+    art::MutexLock mu(self, allow_disallow_lock_);
+    Wait(self);
+    ClassIndex* index = Find(klass);
+    DCHECK(index != nullptr);
+    index->complete = true;
+    index->populating.reset();
+  }
+
+  // Fills out with the live instances of klass (including instances of subclasses) and returns
+  // true if the index for klass is complete. The returned pointers are only valid while the
+  // caller stays runnable.
+  bool GetInstances(art::Thread* self,
+                    art::ObjPtr<art::mirror::Class> klass,
+                    std::vector<art::ObjPtr<art::mirror::Object>>* out)
+      REQUIRES_SHARED(art::Locks::mutator_lock_)
+      REQUIRES(!allow_disallow_lock_) {
+    art::MutexLock mu(self, allow_disallow_lock_);
+    Wait(self);
+    ClassIndex* index = Find(klass);
+    if (index == nullptr || !index->complete) {
+      return false;
+    }
+    out->reserve(index->instances.size());
+    for (art::GcRoot<art::mirror::Object>& root : index->instances) {
+      art::mirror::Object* obj = root.Read();
+      if (obj != nullptr) {
+        out->push_back(obj);
+      }
+    }
+    return true;
+  }
+
+  void ObjectAllocated(art::Thread* self,
+                       art::ObjPtr<art::mirror::Object>* obj,
+                       size_t byte_count ATTRIBUTE_UNUSED) override
+      REQUIRES_SHARED(art::Locks::mutator_lock_) {
+    art::MutexLock mu(self, allow_disallow_lock_);
+    Wait(self);
+    if (classes_.empty()) {
+      return;
+    }
+    art::ObjPtr<art::mirror::Class> klass = (*obj)->GetClass();
+    for (ClassIndex& index : classes_) {
+      art::ObjPtr<art::mirror::Class> index_klass = index.klass.Read();
+      if (index_klass != nullptr && index_klass->IsAssignableFrom(klass)) {
+        if (index.populating != nullptr && !index.populating->insert(obj->Ptr()).second) {
+          // The walk populating this index already recorded the object.
+          continue;
+        }
+        index.instances.push_back(art::GcRoot<art::mirror::Object>(*obj));
+      }
+    }
+  }
+
+  void Sweep(art::IsMarkedVisitor* visitor) override
+      REQUIRES_SHARED(art::Locks::mutator_lock_)
+      REQUIRES(!allow_disallow_lock_) {
+    art::MutexLock mu(art::Thread::Current(), allow_disallow_lock_);
+    for (auto it = classes_.begin(); it != classes_.end();) {
+      art::mirror::Class* klass = it->klass.Read<art::kWithoutReadBarrier>();
+      art::mirror::Object* new_klass = visitor->IsMarked(klass);
+      if (new_klass == nullptr) {
+        // The class was unloaded, so all of its instances are dead as well.
+        it = classes_.erase(it);
+        continue;
+      }
+      if (new_klass != klass) {
+        it->klass = art::GcRoot<art::mirror::Class>(art::down_cast<art::mirror::Class*>(new_klass));
+      }
+      // Compact out dead instances and update moved ones. A concurrently moving collector can
+      // leave stale pointers in a populating set; that only causes a duplicate entry for an
+      // object recorded by both the walk and the allocation callback, never a missed one.
+      std::vector<art::GcRoot<art::mirror::Object>>& instances = it->instances;
+      auto out = instances.begin();
+      for (art::GcRoot<art::mirror::Object>& root : instances) {
+        art::mirror::Object* old_obj = root.Read<art::kWithoutReadBarrier>();
+        art::mirror::Object* new_obj = visitor->IsMarked(old_obj);
+        if (new_obj != nullptr) {
+          *out++ = art::GcRoot<art::mirror::Object>(new_obj);
+        }
+      }
+      instances.erase(out, instances.end());
+      ++it;
+    }
+  }
+
+ private:
+  struct ClassIndex {
+    art::GcRoot<art::mirror::Class> klass;
+    bool complete = false;
+    std::vector<art::GcRoot<art::mirror::Object>> instances;
+    // Dedups the initial heap walk against concurrently recorded allocations; only present while
+    // the index is being populated.
+    std::unique_ptr<std::unordered_set<art::mirror::Object*>> populating;
+  };
+
+  ClassIndex* Find(art::ObjPtr<art::mirror::Class> klass)
+      REQUIRES_SHARED(art::Locks::mutator_lock_)
+      REQUIRES(allow_disallow_lock_) {
+    for (ClassIndex& index : classes_) {
+      if (index.klass.Read() == klass) {
+        return &index;
+      }
+    }
+    return nullptr;
+  }
+
+  std::vector<ClassIndex> classes_ GUARDED_BY(allow_disallow_lock_);
+};
+
+static HeapInstanceIndex gHeapInstanceIndex;
+
 // Report the contents of a string, if a callback is set.
 jint ReportString(art::ObjPtr<art::mirror::Object> obj,
                   jvmtiEnv* env,
@@ -678,10 +854,13 @@ struct HeapFilter {
 
 void HeapUtil::Register() {
   art::Runtime::Current()->AddSystemWeakHolder(&gIndexCachingTable);
+  art::Runtime::Current()->AddSystemWeakHolder(&gHeapInstanceIndex);
+  AllocationManager::Get()->SetHeapIndexCallback(&gHeapInstanceIndex);
 }
 
 void HeapUtil::Unregister() {
   art::Runtime::Current()->RemoveSystemWeakHolder(&gIndexCachingTable);
+  art::Runtime::Current()->RemoveSystemWeakHolder(&gHeapInstanceIndex);
 }
 
 jvmtiError HeapUtil::IterateOverInstancesOfClass(jvmtiEnv* env,
@@ -738,7 +917,34 @@ jvmtiError HeapUtil::IterateOverInstancesOfClass(jvmtiEnv* env,
       tag_table->Set(obj, tag);
     }
   };
-  art::Runtime::Current()->GetHeap()->VisitObjects(visitor);
+
+  // Serve repeated queries for the same class from the instance index instead of a full walk.
+  std::vector<art::ObjPtr<art::mirror::Object>> instances;
+  if (gHeapInstanceIndex.GetInstances(self, filter_klass.Get(), &instances)) {
+    for (art::ObjPtr<art::mirror::Object> instance : instances) {
+      visitor(instance.Ptr());
+    }
+    return OK;
+  }
+
+  // Index miss: start indexing this class (if capacity remains) and seed its index from the walk
+  // below. The allocation callback must be live before the index entry exists so that nothing
+  // allocated between the entry's creation and the walk is missed.
+  bool indexing = false;
+  if (gHeapInstanceIndex.CanIndex(self, filter_klass.Get())) {
+    AllocationManager::Get()->EnableHeapIndexCallback(self);
+    indexing = gHeapInstanceIndex.StartIndexing(self, filter_klass.Get());
+  }
+  auto walk_visitor = [&](art::mirror::Object* obj) REQUIRES_SHARED(art::Locks::mutator_lock_) {
+    if (indexing && filter_klass->IsAssignableFrom(obj->GetClass())) {
+      gHeapInstanceIndex.RecordInstance(self, filter_klass.Get(), obj);
+    }
+    visitor(obj);
+  };
+  art::Runtime::Current()->GetHeap()->VisitObjects(walk_visitor);
+  if (indexing) {
+    gHeapInstanceIndex.MarkComplete(self, filter_klass.Get());
+  }
 
   return OK;
 }
@@ -1580,6 +1786,32 @@ jvmtiError HeapExtensions::GetHeapName(jvmtiEnv* env, jint heap_id, char** heap_
   }
 }
 
+jvmtiError HeapExtensions::GetObjectTags(
+    jvmtiEnv* env, jint count, jobject* objects, jlong* tags, ...) {
+  if (objects == nullptr || tags == nullptr) {
+    return ERR(NULL_POINTER);
+  }
+  if (count < 0) {
+    return ERR(ILLEGAL_ARGUMENT);
+  }
+
+  art::Thread* self = art::Thread::Current();
+  art::ScopedObjectAccess soa(self);
+  ObjectTagTable* tag_table = ArtJvmTiEnv::AsArtJvmTiEnv(env)->object_tag_table.get();
+  // Debugger agents resolve the ids of every element when a large collection is inspected; taking
+  // the tag-table lock once for the whole batch amortizes the per-lookup cost. We stay runnable
+  // for the duration, so the decoded references remain valid across the loop.
+  tag_table->Lock();
+  for (jint i = 0; i != count; ++i) {
+    art::ObjPtr<art::mirror::Object> obj = soa.Decode<art::mirror::Object>(objects[i]);
+    if (obj == nullptr || !tag_table->GetTagLocked(obj, &tags[i])) {
+      tags[i] = 0;
+    }
+  }
+  tag_table->Unlock();
+  return ERR(NONE);
+}
+
 jvmtiError HeapExtensions::IterateThroughHeapExt(jvmtiEnv* env,
                                                  jint heap_filter,
                                                  jclass klass,
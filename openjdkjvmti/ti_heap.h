@@ -82,6 +82,8 @@ class HeapExtensions {
 
   static jvmtiError JNICALL GetObjectHeapId(jvmtiEnv* env, jlong tag, jint* heap_id, ...);
   static jvmtiError JNICALL GetHeapName(jvmtiEnv* env, jint heap_id, char** heap_name, ...);
+  static jvmtiError JNICALL GetObjectTags(
+      jvmtiEnv* env, jint count, jobject* objects, jlong* tags, ...);
 
   static jvmtiError JNICALL IterateThroughHeapExt(jvmtiEnv* env,
                                                   jint heap_filter,
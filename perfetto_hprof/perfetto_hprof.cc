@@ -566,10 +566,54 @@ void DumpPerfetto(art::Thread* self) {
             std::unique_ptr<protozero::PackedVarInt> reference_object_ids(
                 new protozero::PackedVarInt);
 
-            art::Runtime::Current()->GetHeap()->VisitObjectsPaused(
-                [&writer, &interned_fields, &interned_locations,
-                &reference_field_ids, &reference_object_ids, &interned_classes](
-                    art::mirror::Object* obj) REQUIRES_SHARED(art::Locks::mutator_lock_) {
+            // The expensive per-object work (reading reference fields and prettifying their
+            // names) is sharded across worker threads: the heap walk batches raw object
+            // pointers, the workers analyze a batch in parallel, and this thread serializes
+            // the results. The packet sequence itself stays single-writer, as the protozero
+            // TraceContext must not be shared between threads. This is safe for the same
+            // reason the raw Object* pointers are: nothing mutates the heap in the forked
+            // child.
+            struct ObjectAnalysis {
+              uint64_t self_size;
+              std::vector<std::pair<std::string, art::mirror::Object*>> referred_objects;
+            };
+            constexpr size_t kAnalysisBatchSize = 64 * 1024;
+            const size_t num_workers =
+                std::max(1u, std::min(std::thread::hardware_concurrency(), 8u));
+            std::vector<art::mirror::Object*> batch;
+            batch.reserve(kAnalysisBatchSize);
+            std::vector<ObjectAnalysis> analyses;
+
+            auto analyze_batch = [&batch, &analyses, num_workers]() NO_THREAD_SAFETY_ANALYSIS {
+              analyses.clear();
+              analyses.resize(batch.size());
+              std::vector<std::thread> workers;
+              const size_t chunk_size = (batch.size() + num_workers - 1) / num_workers;
+              for (size_t w = 0; w != num_workers; ++w) {
+                const size_t begin = std::min(w * chunk_size, batch.size());
+                const size_t end = std::min(begin + chunk_size, batch.size());
+                if (begin == end) {
+                  break;
+                }
+                workers.emplace_back([&batch, &analyses, begin, end]()
+                                         NO_THREAD_SAFETY_ANALYSIS {
+                  for (size_t i = begin; i != end; ++i) {
+                    art::mirror::Object* obj = batch[i];
+                    analyses[i].self_size = obj->SizeOf();
+                    ReferredObjectsFinder objf(&analyses[i].referred_objects);
+                    obj->VisitReferences(objf, art::VoidFunctor());
+                  }
+                });
+              }
+              for (std::thread& worker : workers) {
+                worker.join();
+              }
+            };
+
+            auto emit_batch = [&]() NO_THREAD_SAFETY_ANALYSIS {
+              analyze_batch();
+              for (size_t i = 0; i != batch.size(); ++i) {
+                  art::mirror::Object* obj = batch[i];
                   if (obj->IsClass()) {
                     art::mirror::Class* klass = obj->AsClass().Ptr();
                     perfetto::protos::pbzero::HeapGraphType* type_proto =
@@ -606,13 +650,9 @@ void DumpPerfetto(art::Thread* self) {
                     writer.GetHeapGraph()->add_objects();
                   object_proto->set_id(GetObjectId(obj));
                   object_proto->set_type_id(class_id);
-                  object_proto->set_self_size(obj->SizeOf());
+                  object_proto->set_self_size(analyses[i].self_size);
 
-                  std::vector<std::pair<std::string, art::mirror::Object*>>
-                      referred_objects;
-                  ReferredObjectsFinder objf(&referred_objects);
-                  obj->VisitReferences(objf, art::VoidFunctor());
-                  for (const auto& p : referred_objects) {
+                  for (const auto& p : analyses[i].referred_objects) {
                     reference_field_ids->Append(FindOrAppend(&interned_fields, p.first));
                     reference_object_ids->Append(GetObjectId(p.second));
                   }
@@ -620,7 +660,19 @@ void DumpPerfetto(art::Thread* self) {
                   object_proto->set_reference_object_id(*reference_object_ids);
                   reference_field_ids->Reset();
                   reference_object_ids->Reset();
+              }
+              batch.clear();
+            };
+
+            art::Runtime::Current()->GetHeap()->VisitObjectsPaused(
+                [&batch, &emit_batch](art::mirror::Object* obj)
+                    REQUIRES_SHARED(art::Locks::mutator_lock_) {
+                  batch.push_back(obj);
+                  if (batch.size() == kAnalysisBatchSize) {
+                    emit_batch();
+                  }
                 });
+            emit_batch();
 
             for (const auto& p : interned_fields) {
               const std::string& str = p.first;
@@ -22,6 +22,7 @@
 #include "android-base/file.h"
 #include "base/unix_file/fd_file.h"
 #include "dex/class_accessor-inl.h"
+#include "dex/code_item_accessors-inl.h"
 #include "dex/descriptors_names.h"
 #include "dex/dex_file-inl.h"
 #include "dex/method_reference.h"
@@ -34,6 +35,8 @@ using Hotness = ProfileCompilationInfo::MethodHotness;
 
 static const std::string kMethodSep = "->";  // NOLINT [runtime/string] [4]
 static const std::string kPackageUseDelim = "@";  // NOLINT [runtime/string] [4]
+static const std::string kInlineCacheDelim = "+";  // NOLINT [runtime/string] [4]
+static const std::string kInlineCacheTypeSep = ",";  // NOLINT [runtime/string] [4]
 static constexpr char kMethodFlagStringHot = 'H';
 static constexpr char kMethodFlagStringStartup = 'S';
 static constexpr char kMethodFlagStringPostStartup = 'P';
@@ -80,6 +83,87 @@ static std::string GetPackageUseString(const FlattenProfileData::ItemMetadata& m
       : result.substr(0, result.size() - 1);
 }
 
+// Returns true iff the method has exactly one virtual invoke, in which case its dex pc
+// is stored in the out argument. The profile text format does not encode dex pcs, so
+// only the inline caches of single-invoke methods can be represented (the parser
+// re-derives the dex pc from the code item, see profman's HasSingleInvoke).
+static bool HasSingleInvoke(const MethodReference& ref, /*out*/ uint32_t* dex_pc) {
+  const DexFile* dex_file = ref.dex_file;
+  const dex::ClassDef* class_def = dex_file->FindClassDef(ref.GetMethodId().class_idx_);
+  if (class_def == nullptr) {
+    return false;
+  }
+  ClassAccessor accessor(*dex_file, *class_def);
+  for (const ClassAccessor::Method& method : accessor.GetMethods()) {
+    if (method.GetIndex() != ref.index) {
+      continue;
+    }
+    if (method.GetCodeItemOffset() == 0u) {
+      return false;
+    }
+    const dex::CodeItem* code_item = dex_file->GetCodeItem(method.GetCodeItemOffset());
+    bool found_invoke = false;
+    for (const DexInstructionPcPair& inst : CodeItemInstructionAccessor(*dex_file, code_item)) {
+      if (inst->Opcode() == Instruction::INVOKE_VIRTUAL ||
+          inst->Opcode() == Instruction::INVOKE_VIRTUAL_RANGE) {
+        if (found_invoke) {
+          return false;
+        }
+        found_invoke = true;
+        *dex_pc = inst.DexPc();
+      }
+    }
+    return found_invoke;
+  }
+  return false;
+}
+
+// Returns the inline cache suffix used in the text format of the boot image profile
+// (e.g. "+Lreceiver1;,Lreceiver2;"), or an empty string if the receiver types of the
+// method cannot be preserved: either the call site cannot be encoded in the text
+// format, or it was megamorphic or lost its types in some profile, or no receiver
+// type passes the aggregation threshold.
+static std::string GetInlineCacheRepresentation(
+    const MethodReference& ref,
+    const FlattenProfileData::ItemMetadata& metadata,
+    const BootImageOptions& options) {
+  const FlattenProfileData::ItemMetadata::InlineCacheAggregationMap& inline_caches =
+      metadata.GetInlineCaches();
+  if (inline_caches.size() != 1u) {
+    return "";
+  }
+  const FlattenProfileData::ItemMetadata::InlineCacheInfo& inline_cache =
+      inline_caches.begin()->second;
+  if (inline_cache.megamorphic_count != 0u || inline_cache.missing_types_count != 0u) {
+    // The call site is not monomorphic-ish everywhere; speculating on it is not safe.
+    return "";
+  }
+  // Keep only the receiver types that enough profiles agree on. The aggregation
+  // counter of a receiver is bounded by the number of profiles that have the method.
+  const uint32_t method_count = metadata.GetAnnotations().size();
+  std::string receivers;
+  size_t receiver_count = 0;
+  for (const auto& it : inline_cache.receivers) {
+    float receiver_percent = it.second / static_cast<float>(method_count);
+    if (receiver_percent >= (options.inline_cache_threshold / 100.f)) {
+      if (receiver_count != 0) {
+        receivers += kInlineCacheTypeSep;
+      }
+      receivers += it.first;
+      receiver_count++;
+    }
+  }
+  if (receiver_count == 0 ||
+      receiver_count >= ProfileCompilationInfo::kIndividualInlineCacheSize) {
+    return "";
+  }
+  uint32_t dex_pc = 0;
+  if (!HasSingleInvoke(ref, &dex_pc) || dex_pc != inline_caches.begin()->first) {
+    return "";
+  }
+  return kInlineCacheDelim + receivers;
+}
+
 // Converts a method representation to its final profile format.
 static std::string MethodToProfileFormat(
     const std::string& method,
@@ -234,7 +318,13 @@ bool GenerateBootImageProfile(
           && ((metadata.GetFlags() & Hotness::Flag::kFlagStartup) != 0)) {
         metadata.AddFlag(Hotness::Flag::kFlagHot);
       }
-      profile_methods.Put(BootImageRepresentation(it.first), metadata);
+      std::string representation = BootImageRepresentation(it.first);
+      if (metadata.HasFlagSet(Hotness::kFlagHot)) {
+        // Preserve the receiver types of stable call sites so that the compiler can
+        // speculatively devirtualize them. Only hot methods get inline caches.
+        representation += GetInlineCacheRepresentation(it.first, it.second, options);
+      }
+      profile_methods.Put(representation, metadata);
     }
   }
 
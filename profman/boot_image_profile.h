@@ -51,6 +51,13 @@ struct BootImageOptions {
   // before it gets added to the boot profile.
   uint32_t method_threshold = 10;
 
+  // Threshold for preserving the inline cache receiver types of a hot method. The
+  // threshold specifies, as percentage of the number of profiles that aggregated the
+  // method, how many profiles need to agree on a receiver type before it gets written
+  // to the boot profile. Only call sites which stay monomorphic-ish across profiles
+  // survive this, which is what the compiler can speculatively devirtualize.
+  uint32_t inline_cache_threshold = 90;
+
   // Whether or not we should upgrade the startup methods to hot.
   bool upgrade_startup_to_hot = true;
 
@@ -16,6 +16,10 @@
 
 #include "profile_assistant.h"
 
+#include <atomic>
+#include <memory>
+#include <thread>
+
 #include "base/os.h"
 #include "base/unix_file/fd_file.h"
 
@@ -28,6 +32,10 @@ static constexpr const uint32_t kMinNewMethodsPercentChangeForCompilation = 2;
 static constexpr const uint32_t kMinNewClassesForCompilation = 50;
 static constexpr const uint32_t kMinNewClassesPercentChangeForCompilation = 2;
 
+// Below this many input profiles the thread startup overhead isn't worth it; installd typically
+// hands profman only a few profiles per app, while cloud profile aggregation merges thousands.
+static constexpr const size_t kMinProfilesForParallelMerge = 8;
+
 
 ProfileAssistant::ProcessingResult ProfileAssistant::ProcessProfilesInternal(
         const std::vector<ScopedFlock>& profile_files,
@@ -54,37 +62,97 @@ ProfileAssistant::ProcessingResult ProfileAssistant::ProcessProfilesInternal(
   uint32_t number_of_classes = info.GetNumberOfResolvedClasses();
 
   // Merge all current profiles.
-  for (size_t i = 0; i < profile_files.size(); i++) {
-    ProfileCompilationInfo cur_info;
-    if (!cur_info.Load(profile_files[i]->Fd(), /*merge_classes=*/ true, filter_fn)) {
-      LOG(WARNING) << "Could not load profile file at index " << i;
-      if (options.IsForceMerge()) {
-        // If we have to merge forcefully, ignore load failures.
-        // This is useful for boot image profiles to ignore stale profiles which are
-        // cleared lazily.
-        continue;
+  const size_t num_threads = std::min<size_t>(
+      std::max<size_t>(std::thread::hardware_concurrency(), 1u), profile_files.size());
+  if (num_threads > 1 && profile_files.size() >= kMinProfilesForParallelMerge) {
+    // Parallel reduction: worker threads pull input profiles off a shared index, load them and
+    // merge them into per-worker accumulators, which are then folded into the reference profile
+    // sequentially. The per-profile load and merge work dominates when thousands of device
+    // profiles are aggregated, so this scales close to linearly with cores.
+    std::vector<std::unique_ptr<ProfileCompilationInfo>> accumulators(num_threads);
+    std::vector<ProcessingResult> statuses(num_threads, kSuccess);
+    std::atomic<size_t> next_index(0u);
+    auto work = [&](size_t worker_index) {
+      std::unique_ptr<ProfileCompilationInfo>& accumulator = accumulators[worker_index];
+      for (size_t i = next_index.fetch_add(1u); i < profile_files.size();
+           i = next_index.fetch_add(1u)) {
+        std::unique_ptr<ProfileCompilationInfo> cur_info(new ProfileCompilationInfo());
+        if (!cur_info->Load(profile_files[i]->Fd(), /*merge_classes=*/ true, filter_fn)) {
+          LOG(WARNING) << "Could not load profile file at index " << i;
+          if (options.IsForceMerge()) {
+            // See the sequential path below: forced merges ignore stale profiles.
+            continue;
+          }
+          statuses[worker_index] = kErrorBadProfiles;
+          return;
+        }
+        if (!info.SameVersion(*cur_info)) {
+          if (options.IsForceMerge()) {
+            continue;
+          }
+          statuses[worker_index] = kErrorDifferentVersions;
+          return;
+        }
+        if (accumulator == nullptr) {
+          accumulator = std::move(cur_info);
+        } else if (!accumulator->MergeWith(*cur_info)) {
+          LOG(WARNING) << "Could not merge profile file at index " << i;
+          statuses[worker_index] = kErrorBadProfiles;
+          return;
+        }
       }
-      return kErrorBadProfiles;
+    };
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; t++) {
+      threads.emplace_back(work, t);
     }
-
-    // Check version mismatch.
-    // This may happen during profile analysis if one profile is regular and
-    // the other one is for the boot image. For example when switching on-off
-    // the boot image profiles.
-    if (!info.SameVersion(cur_info)) {
-      if (options.IsForceMerge()) {
-        // If we have to merge forcefully, ignore the current profile and
-        // continue to the next one.
-        continue;
-      } else {
-        // Otherwise, return an error.
-        return kErrorDifferentVersions;
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    for (ProcessingResult status : statuses) {
+      if (status != kSuccess) {
+        return status;
+      }
+    }
+    for (const std::unique_ptr<ProfileCompilationInfo>& accumulator : accumulators) {
+      if (accumulator != nullptr && !info.MergeWith(*accumulator)) {
+        LOG(WARNING) << "Could not merge per-thread profile accumulator";
+        return kErrorBadProfiles;
       }
     }
+  } else {
+    for (size_t i = 0; i < profile_files.size(); i++) {
+      ProfileCompilationInfo cur_info;
+      if (!cur_info.Load(profile_files[i]->Fd(), /*merge_classes=*/ true, filter_fn)) {
+        LOG(WARNING) << "Could not load profile file at index " << i;
+        if (options.IsForceMerge()) {
+          // If we have to merge forcefully, ignore load failures.
+          // This is useful for boot image profiles to ignore stale profiles which are
+          // cleared lazily.
+          continue;
+        }
+        return kErrorBadProfiles;
+      }
 
-    if (!info.MergeWith(cur_info)) {
-      LOG(WARNING) << "Could not merge profile file at index " << i;
-      return kErrorBadProfiles;
+      // Check version mismatch.
+      // This may happen during profile analysis if one profile is regular and
+      // the other one is for the boot image. For example when switching on-off
+      // the boot image profiles.
+      if (!info.SameVersion(cur_info)) {
+        if (options.IsForceMerge()) {
+          // If we have to merge forcefully, ignore the current profile and
+          // continue to the next one.
+          continue;
+        } else {
+          // Otherwise, return an error.
+          return kErrorDifferentVersions;
+        }
+      }
+
+      if (!info.MergeWith(cur_info)) {
+        LOG(WARNING) << "Could not merge profile file at index " << i;
+        return kErrorBadProfiles;
+      }
     }
   }
 
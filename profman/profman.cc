@@ -34,6 +34,7 @@
 #include "android-base/strings.h"
 
 #include "base/dumpable.h"
+#include "base/globals.h"
 #include "base/logging.h"  // For InitLogging.
 #include "base/mem_map.h"
 #include "base/scoped_flock.h"
@@ -139,6 +140,12 @@ NO_RETURN static void Usage(const char *fmt, ...) {
   UsageError("  --create-profile-from=<filename>: creates a profile from a list of classes and");
   UsageError("      methods.");
   UsageError("");
+  UsageError("  --import-page-access-profile=<filename>: marks the methods whose code items lie");
+  UsageError("      on the dex file pages recorded in the given page-access profile (dumped by");
+  UsageError("      the runtime when -verbose:startup is enabled) as startup methods in the");
+  UsageError("      reference profile, so that a subsequent profile guided compilation lays the");
+  UsageError("      dex files out according to the access order measured on this device.");
+  UsageError("");
   UsageError("  --dex-location=<string>: location string to use with corresponding");
   UsageError("      apk-fd to find dex files");
   UsageError("");
@@ -158,6 +165,10 @@ NO_RETURN static void Usage(const char *fmt, ...) {
   UsageError("  --clean-class-threshold=percentage between 0 and 100");
   UsageError("      what threshold to apply to the clean classes when deciding whether or not to");
   UsageError("      include it in the final profile.");
+  UsageError("  --inline-cache-threshold=percentage between 0 and 100");
+  UsageError("      what threshold to apply to the inline cache receiver types of a hot");
+  UsageError("      method when deciding whether or not to preserve them in the final");
+  UsageError("      profile. Only call sites that stay monomorphic are preserved.");
   UsageError("  --preloaded-class-threshold=percentage between 0 and 100");
   UsageError("      what threshold to apply to the classes when deciding whether or not to");
   UsageError("      include it in the final preloaded classes.");
@@ -315,6 +326,9 @@ class ProfMan final {
         dump_classes_and_methods_ = true;
       } else if (StartsWith(option, "--create-profile-from=")) {
         create_profile_from_file_ = std::string(option.substr(strlen("--create-profile-from=")));
+      } else if (StartsWith(option, "--import-page-access-profile=")) {
+        import_page_access_profile_file_ =
+            std::string(option.substr(strlen("--import-page-access-profile=")));
       } else if (StartsWith(option, "--dump-output-to-fd=")) {
         ParseUintOption(raw_option, "--dump-output-to-fd=", &dump_output_to_fd_);
       } else if (option == "--generate-boot-profile") {
@@ -339,6 +353,12 @@ class ProfMan final {
                         &boot_image_options_.image_class_clean_threshold,
                         0u,
                         100u);
+      } else if (StartsWith(option, "--inline-cache-threshold=")) {
+        ParseUintOption(raw_option,
+                        "--inline-cache-threshold=",
+                        &boot_image_options_.inline_cache_threshold,
+                        0u,
+                        100u);
       } else if (StartsWith(option, "--preloaded-class-threshold=")) {
         ParseUintOption(raw_option,
                         "--preloaded-class-threshold=",
@@ -1334,6 +1354,125 @@ class ProfMan final {
     return 0;
   }
 
+  bool ShouldImportPageAccessProfile() const {
+    return !import_page_access_profile_file_.empty();
+  }
+
+  // Parses a dex file line of the page-access profile dumped by the runtime
+  // when -verbose:startup is enabled, e.g.:
+  //   /data/app/test/base.apk (dex): 3/40 pages resident: [0,2) [9,10)
+  // Returns true and fills the location and the page index ranges on success.
+  // Image, oat and vdex mapping lines are skipped; only the dex file lines can
+  // be mapped back to dex item offsets without knowing the container layout.
+  static bool ParsePageAccessLine(const std::string& line,
+                                  /*out*/ std::string* location,
+                                  /*out*/ std::vector<std::pair<uint32_t, uint32_t>>* ranges) {
+    static const char kDexMarker[] = " (dex): ";
+    const size_t marker = line.find(kDexMarker);
+    if (marker == std::string::npos) {
+      return false;
+    }
+    *location = line.substr(0, marker);
+    size_t pos = line.find("resident:", marker);
+    if (pos == std::string::npos) {
+      return false;
+    }
+    pos += strlen("resident:");
+    while (pos < line.size()) {
+      uint32_t start;
+      uint32_t end;
+      int consumed = 0;
+      if (sscanf(line.c_str() + pos, " [%u,%u)%n", &start, &end, &consumed) != 2) {
+        break;
+      }
+      ranges->emplace_back(start, end);
+      pos += consumed;
+    }
+    return !ranges->empty();
+  }
+
+  // Converts a page-access profile dumped by the runtime into startup method
+  // flags in the reference profile. Background dexopt can run this before a
+  // profile guided compilation, so that dexlayout reorders each dex file
+  // according to the page order measured on this device.
+  int ImportPageAccessProfile() {
+    // Validate parameters for this command.
+    if (apk_files_.empty() && apks_fd_.empty()) {
+      Usage("APK files must be specified");
+    }
+    if (dex_locations_.empty()) {
+      Usage("DEX locations must be specified");
+    }
+    if (reference_profile_file_.empty() && !FdIsValid(reference_profile_file_fd_)) {
+      Usage("Reference profile must be specified with --reference-profile-file or "
+            "--reference-profile-file-fd");
+    }
+    // Open the profile output file.
+    int fd = OpenReferenceProfile();
+    if (!FdIsValid(fd)) {
+      return -1;
+    }
+    // Read the page-access profile dumped by the runtime.
+    std::unique_ptr<std::vector<std::string>>
+        lines(ReadCommentedInputFromFile<std::vector<std::string>>(
+            import_page_access_profile_file_.c_str(), nullptr));  // No post-processing.
+
+    // Open the dex files the page ranges refer to.
+    std::vector<std::unique_ptr<const DexFile>> dex_files;
+    OpenApkFilesFromLocations(&dex_files);
+
+    ProfileCompilationInfo info;
+    for (const std::string& line : *lines) {
+      std::string location;
+      std::vector<std::pair<uint32_t, uint32_t>> page_ranges;
+      if (!ParsePageAccessLine(line, &location, &page_ranges)) {
+        continue;
+      }
+      const std::string base_key = ProfileCompilationInfo::GetProfileDexFileBaseKey(location);
+      for (const std::unique_ptr<const DexFile>& dex_file : dex_files) {
+        if (ProfileCompilationInfo::GetProfileDexFileBaseKey(dex_file->GetLocation()) !=
+                base_key) {
+          continue;
+        }
+        // Mark the methods whose code items start on a touched page as startup,
+        // and record the classes they belong to for the type_id/class_def
+        // ordering in dexlayout.
+        std::vector<ProfileMethodInfo> methods;
+        std::set<dex::TypeIndex> classes;
+        for (ClassAccessor accessor : dex_file->GetClasses()) {
+          bool touched = false;
+          for (const ClassAccessor::Method& method : accessor.GetMethods()) {
+            const uint32_t code_item_offset = method.GetCodeItemOffset();
+            if (code_item_offset == 0u) {
+              continue;
+            }
+            const uint32_t page = code_item_offset / kPageSize;
+            for (const auto& range : page_ranges) {
+              if (range.first <= page && page < range.second) {
+                methods.push_back(ProfileMethodInfo(method.GetReference()));
+                touched = true;
+                break;
+              }
+            }
+          }
+          if (touched) {
+            classes.insert(accessor.GetClassIdx());
+          }
+        }
+        info.AddMethods(methods, ProfileCompilationInfo::MethodHotness::kFlagStartup);
+        info.AddClassesForDex(dex_file.get(), classes.begin(), classes.end());
+      }
+    }
+
+    // Write the profile file. The caller merges it into the app profile with a
+    // regular profman merge, so stale page data ages out with the profiles.
+    CHECK(info.Save(fd));
+    if (close(fd) < 0) {
+      PLOG(WARNING) << "Failed to close descriptor";
+    }
+    return 0;
+  }
+
   bool ShouldCreateBootImageProfile() const {
     return generate_boot_image_profile_;
   }
@@ -1511,6 +1650,7 @@ class ProfMan final {
   BootImageOptions boot_image_options_;
   std::string test_profile_;
   std::string create_profile_from_file_;
+  std::string import_page_access_profile_file_;
   uint16_t test_profile_num_dex_;
   uint16_t test_profile_method_percerntage_;
   uint16_t test_profile_class_percentage_;
@@ -1547,6 +1687,9 @@ static int profman(int argc, char** argv) {
   if (profman.ShouldCreateProfile()) {
     return profman.CreateProfile();
   }
+  if (profman.ShouldImportPageAccessProfile()) {
+    return profman.ImportPageAccessProfile();
+  }
 
   if (profman.ShouldCreateBootImageProfile()) {
     return profman.CreateBootImageProfile();
@@ -69,10 +69,19 @@ bool AotClassLinker::InitializeClass(Thread* self,
   }
 
   // When in strict_mode, don't initialize a class if it belongs to boot but not initialized.
+  // As an exception, allow classes where the initialization cannot have observable effects:
+  // a verified class with no static fields and no class initializer is initialized by merely
+  // updating its status, so it does not matter whether this happens at compile time or at
+  // runtime. This mirrors the reasoning behind permitting app dependencies without <clinit>.
   if (strict_mode && klass->IsBootStrapClassLoaded()) {
-    runtime->AbortTransactionAndThrowAbortError(self, "Can't resolve "
-        + klass->PrettyTypeOf() + " because it is an uninitialized boot class.");
-    return false;
+    bool trivially_initializable = klass->IsVerified() &&
+        klass->NumStaticFields() == 0u &&
+        klass->FindClassInitializer(GetImagePointerSize()) == nullptr;
+    if (!trivially_initializable) {
+      runtime->AbortTransactionAndThrowAbortError(self, "Can't resolve "
+          + klass->PrettyTypeOf() + " because it is an uninitialized boot class.");
+      return false;
+    }
   }
 
   // Don't initialize klass if it's superclass is not initialized, because superclass might abort
@@ -96,34 +96,36 @@ bool NullPointerHandler::Action(int sig ATTRIBUTE_UNUSED, siginfo_t* info, void*
 }
 
 // A suspend check is done using the following instruction sequence:
-//      0xf7223228: f9405640  ldr x0, [x18, #168]
+//      0xf7223228: f9405670  ldr x16, [x19, #168]
 // .. some intervening instructions
-//      0xf7223230: f9400000  ldr x0, [x0]
+//      0xf7223230: f9400210  ldr x16, [x16]
 
-// The offset from r18 is Thread::ThreadSuspendTriggerOffset().
+// The offset from the thread register (x19) is Thread::ThreadSuspendTriggerOffset().
+// The scratch register is whichever one the code generator picked (IP0 or IP1).
 // To check for a suspend check, we examine the instructions that caused
-// the fault (at PC-4 and PC).
+// the fault (at PC and up to 80 bytes before it).
 bool SuspensionHandler::Action(int sig ATTRIBUTE_UNUSED, siginfo_t* info ATTRIBUTE_UNUSED,
                                void* context) {
-  // These are the instructions to check for.  The first one is the ldr x0,[r18,#xxx]
-  // where xxx is the offset of the suspend trigger.
-  uint32_t checkinst1 = 0xf9400240 |
-      (Thread::ThreadSuspendTriggerOffset<PointerSize::k64>().Int32Value() << 7);
-  uint32_t checkinst2 = 0xf9400000;
-
   struct ucontext *uc = reinterpret_cast<struct ucontext *>(context);
   struct sigcontext *sc = reinterpret_cast<struct sigcontext*>(&uc->uc_mcontext);
   uint8_t* ptr2 = reinterpret_cast<uint8_t*>(sc->pc);
   uint8_t* ptr1 = ptr2 - 4;
   VLOG(signals) << "checking suspend";
 
+  // The faulting instruction must be "ldr xT, [xT]" for some register T.
   uint32_t inst2 = *reinterpret_cast<uint32_t*>(ptr2);
-  VLOG(signals) << "inst2: " << std::hex << inst2 << " checkinst2: " << checkinst2;
-  if (inst2 != checkinst2) {
+  VLOG(signals) << "inst2: " << std::hex << inst2;
+  if ((inst2 & 0xfffffc00u) != 0xf9400000u || ((inst2 >> 5) & 0x1fu) != (inst2 & 0x1fu)) {
     // Second instruction is not good, not ours.
     return false;
   }
 
+  // The first instruction is "ldr xT, [x19, #xxx]" where xxx is the offset of the
+  // suspend trigger and T matches the faulting load.
+  uint32_t checkinst1 = 0xf9400000u |
+      ((Thread::ThreadSuspendTriggerOffset<PointerSize::k64>().Uint32Value() >> 3) << 10) |
+      (19u << 5) | (inst2 & 0x1fu);
+
   // The first instruction can a little bit up the stream due to load hoisting
   // in the compiler.
   uint8_t* limit = ptr1 - 80;   // Compiler will hoist to a max of 20 instructions.
@@ -142,7 +144,7 @@ bool SuspensionHandler::Action(int sig ATTRIBUTE_UNUSED, siginfo_t* info ATTRIBU
     // This is a suspend check.  Arrange for the signal handler to return to
     // art_quick_implicit_suspend.  Also set LR so that after the suspend check it
     // will resume the instruction (current PC + 4).  PC points to the
-    // ldr x0,[x0,#0] instruction (r0 will be 0, set by the trigger).
+    // "ldr xT, [xT]" instruction (xT holds nullptr, set by the trigger).
 
     sc->regs[30] = sc->pc + 4;
     sc->pc = reinterpret_cast<uintptr_t>(art_quick_implicit_suspend);
@@ -21,6 +21,8 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <atomic>
+
 #include "unwindstack/Regs.h"
 #include "unwindstack/RegsGetLocal.h"
 #include "unwindstack/Memory.h"
@@ -43,6 +45,10 @@ namespace art {
 // gcstress this isn't a huge deal.
 #if defined(__linux__)
 
+// Incremented whenever a native library is loaded so that the per-thread cached
+// maps can be reparsed lazily instead of on every failed unwind.
+static std::atomic<uint64_t> g_maps_generation(1u);
+
 struct UnwindHelper : public TLSData {
   static constexpr const char* kTlsKey = "UnwindHelper::kTlsKey";
 
@@ -51,6 +57,7 @@ struct UnwindHelper : public TLSData {
         jit_(memory_),
         dex_(memory_),
         unwinder_(max_depth, &maps_, memory_) {
+    maps_generation_ = g_maps_generation.load(std::memory_order_acquire);
     CHECK(maps_.Parse());
     unwinder_.SetJitDebug(&jit_, unwindstack::Regs::CurrentArch());
     unwinder_.SetDexFiles(&dex_, unwindstack::Regs::CurrentArch());
@@ -59,7 +66,18 @@ struct UnwindHelper : public TLSData {
   }
 
   // Reparse process mmaps to detect newly loaded libraries.
-  bool Reparse() { return maps_.Reparse(); }
+  bool Reparse() {
+    maps_generation_ = g_maps_generation.load(std::memory_order_acquire);
+    return maps_.Reparse();
+  }
+
+  // Reparse the maps up front if a native library has been loaded since the
+  // last parse, so that the first unwind afterwards does not fail and retry.
+  void ReparseIfStale() {
+    if (maps_generation_ != g_maps_generation.load(std::memory_order_acquire)) {
+      Reparse();
+    }
+  }
 
   static UnwindHelper* Get(Thread* self, size_t max_depth) {
     UnwindHelper* tls = reinterpret_cast<UnwindHelper*>(self->GetCustomTLS(kTlsKey));
@@ -73,6 +91,7 @@ struct UnwindHelper : public TLSData {
   unwindstack::Unwinder* Unwinder() { return &unwinder_; }
 
  private:
+  uint64_t maps_generation_;
   unwindstack::LocalUpdatableMaps maps_;
   std::shared_ptr<unwindstack::Memory> memory_;
   unwindstack::JitDebug jit_;
@@ -80,7 +99,12 @@ struct UnwindHelper : public TLSData {
   unwindstack::Unwinder unwinder_;
 };
 
+void BacktraceCollector::NotifyNativeLibraryLoaded() {
+  g_maps_generation.fetch_add(1u, std::memory_order_release);
+}
+
 void BacktraceCollector::Collect() {
+  UnwindHelper::Get(Thread::Current(), max_depth_)->ReparseIfStale();
   if (!CollectImpl()) {
     // Reparse process mmaps to detect newly loaded libraries and retry.
     UnwindHelper::Get(Thread::Current(), max_depth_)->Reparse();
@@ -125,6 +149,8 @@ bool BacktraceCollector::CollectImpl() {
 #warning "Backtrace collector is not implemented. GCStress cannot be used."
 #pragma clang diagnostic pop
 
+void BacktraceCollector::NotifyNativeLibraryLoaded() {}
+
 // We only have an implementation for linux. On other plaforms just return nothing. This is not
 // really correct but we only use this for hashing and gcstress so it's not too big a deal.
 void BacktraceCollector::Collect() {
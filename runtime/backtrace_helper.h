@@ -35,6 +35,11 @@ class BacktraceCollector {
   // Collect the backtrace, do not call more than once.
   void Collect();
 
+  // Mark the cached per-thread maps as stale because a native library has been
+  // loaded. The next Collect() on each thread reparses the maps up front instead
+  // of paying a failed unwind and retry.
+  static void NotifyNativeLibraryLoaded();
+
  private:
   // Try to collect backtrace. Returns false on failure.
   // It is used to retry backtrace on temporary failure.
@@ -96,6 +96,9 @@ enum LockLevel : uint8_t {
   kTracingUniqueMethodsLock,
   kTracingStreamingLock,
   kClassLoaderClassesLock,
+  // Per-worker deque locks of WorkStealingThreadPool; may be acquired while holding the pool's
+  // task_queue_lock_ (kDefaultMutexLevel).
+  kWorkStealingQueueLock,
   kDefaultMutexLevel,
   kDexLock,
   kMarkSweepLargeObjectLock,
@@ -105,9 +105,15 @@ Arena* MemMapArenaPool::AllocArena(size_t size) {
   Arena* ret = nullptr;
   {
     std::lock_guard<std::mutex> lock(lock_);
-    if (free_arenas_ != nullptr && LIKELY(free_arenas_->Size() >= size)) {
-      ret = free_arenas_;
-      free_arenas_ = free_arenas_->next_;
+    // First-fit scan of the retained arenas. Checking only the list head would force
+    // a new mapping whenever an undersized arena sits at the head, even with suitable
+    // arenas retained behind it.
+    for (Arena** before = &free_arenas_; *before != nullptr; before = &(*before)->next_) {
+      if (LIKELY((*before)->Size() >= size)) {
+        ret = *before;
+        *before = ret->next_;
+        break;
+      }
     }
   }
   if (ret == nullptr) {
@@ -120,8 +126,21 @@ Arena* MemMapArenaPool::AllocArena(size_t size) {
 void MemMapArenaPool::TrimMaps() {
   ScopedTrace trace(__PRETTY_FUNCTION__);
   std::lock_guard<std::mutex> lock(lock_);
-  for (Arena* arena = free_arenas_; arena != nullptr; arena = arena->next_) {
-    arena->Release();
+  Arena** before = &free_arenas_;
+  while (*before != nullptr) {
+    Arena* arena = *before;
+    if (arena->Size() > arena_allocator::kArenaDefaultSize) {
+      // Unmap retained oversized arenas: they were created for a single outsized
+      // request and are unlikely to be asked for again, but they keep their address
+      // space reserved even after madvise.
+      *before = arena->next_;
+      delete arena;
+    } else {
+      // Default-sized arenas are kept with their pages released, so the allocation
+      // fast path stays free of mmap churn.
+      arena->Release();
+      before = &arena->next_;
+    }
   }
 }
 
@@ -24,6 +24,7 @@
 #include "android-base/stringprintf.h"
 
 #include "base/atomic.h"
+#include "base/bit_utils.h"
 #include "base/logging.h"
 #include "base/systrace.h"
 #include "base/time_utils.h"
@@ -185,23 +186,21 @@ BaseMutex::BaseMutex(const char* name, LockLevel level)
     : name_(name),
       level_(level),
       should_respond_to_empty_checkpoint_request_(false) {
-  if (kLogLockContentions) {
-    ScopedAllMutexesLock mu(this);
-    std::set<BaseMutex*>** all_mutexes_ptr = &gAllMutexData->all_mutexes;
-    if (*all_mutexes_ptr == nullptr) {
-      // We leak the global set of all mutexes to avoid ordering issues in global variable
-      // construction/destruction.
-      *all_mutexes_ptr = new std::set<BaseMutex*>();
-    }
-    (*all_mutexes_ptr)->insert(this);
+  // The registry of all mutexes is maintained unconditionally: it backs both the optional full
+  // contention log and the always-on contention statistics.
+  ScopedAllMutexesLock mu(this);
+  std::set<BaseMutex*>** all_mutexes_ptr = &gAllMutexData->all_mutexes;
+  if (*all_mutexes_ptr == nullptr) {
+    // We leak the global set of all mutexes to avoid ordering issues in global variable
+    // construction/destruction.
+    *all_mutexes_ptr = new std::set<BaseMutex*>();
   }
+  (*all_mutexes_ptr)->insert(this);
 }
 
 BaseMutex::~BaseMutex() {
-  if (kLogLockContentions) {
-    ScopedAllMutexesLock mu(this);
-    gAllMutexData->all_mutexes->erase(this);
-  }
+  ScopedAllMutexesLock mu(this);
+  gAllMutexData->all_mutexes->erase(this);
 }
 
 void BaseMutex::DumpAll(std::ostream& os) {
@@ -317,6 +316,53 @@ void BaseMutex::RecordContention(uint64_t blocked_tid,
   }
 }
 
+uint64_t BaseMutex::RecordFutexWaitBegin() {
+  const uint64_t count =
+      contention_stats_.futex_wait_count.fetch_add(1, std::memory_order_relaxed);
+  constexpr uint64_t kSampleMask = (1u << ContentionStats::kWaitTimeSampleShift) - 1u;
+  return ((count & kSampleMask) == 0u) ? NanoTime() : 0u;
+}
+
+void BaseMutex::RecordFutexWaitEnd(uint64_t sample_start_ns) {
+  if (LIKELY(sample_start_ns == 0u)) {
+    return;
+  }
+  const uint64_t wait_us = (NanoTime() - sample_start_ns) / 1000u;
+  const size_t bucket = (wait_us == 0u)
+      ? 0u
+      : std::min(static_cast<size_t>(MostSignificantBit(wait_us)),
+                 ContentionStats::kWaitTimeBuckets - 1u);
+  contention_stats_.wait_time_buckets[bucket].fetch_add(1u, std::memory_order_relaxed);
+}
+
+void BaseMutex::DumpContentionStats(std::ostream& os) const {
+  const uint64_t waits = contention_stats_.futex_wait_count.load(std::memory_order_relaxed);
+  if (waits == 0u) {
+    return;
+  }
+  os << name_ << ": futex waits=" << waits << " sampled wait histogram (us):";
+  for (size_t i = 0; i < ContentionStats::kWaitTimeBuckets; ++i) {
+    const uint32_t count = contention_stats_.wait_time_buckets[i].load(std::memory_order_relaxed);
+    if (count != 0u) {
+      os << " [" << (UINT64_C(1) << i) << "us]=" << count;
+    }
+  }
+  os << "\n";
+}
+
+void BaseMutex::DumpAllContentionStats(std::ostream& os) {
+  os << "Lock contention (always-on, sampled):\n";
+  ScopedAllMutexesLock mu(reinterpret_cast<const BaseMutex*>(-1));
+  std::set<BaseMutex*>* all_mutexes = gAllMutexData->all_mutexes;
+  if (all_mutexes == nullptr) {
+    // No mutexes have been created yet during at startup.
+    return;
+  }
+  for (const BaseMutex* mutex : *all_mutexes) {
+    mutex->DumpContentionStats(os);
+  }
+}
+
 void BaseMutex::DumpContention(std::ostream& os) const {
   if (kLogLockContentions) {
     const ContentionLogData* data = contention_log_data_;
@@ -443,6 +489,7 @@ void Mutex::ExclusiveLock(Thread* self) {
           if (UNLIKELY(should_respond_to_empty_checkpoint_request_)) {
             self->CheckEmptyCheckpointFromMutex();
           }
+          const uint64_t wait_sample_start = RecordFutexWaitBegin();
           do {
             if (futex(state_and_contenders_.Address(), FUTEX_WAIT_PRIVATE, cur_state,
                       nullptr, nullptr, 0) != 0) {
@@ -459,6 +506,7 @@ void Mutex::ExclusiveLock(Thread* self) {
             // futex wakeups as a result of repeatedly decrementing and incrementing contenders.
             cur_state = state_and_contenders_.load(std::memory_order_relaxed);
           } while ((cur_state & kHeldMask) != 0);
+          RecordFutexWaitEnd(wait_sample_start);
           decrement_contenders();
         }
       }
@@ -522,12 +570,11 @@ bool Mutex::ExclusiveTryLock(Thread* self) {
   return true;
 }
 
-bool Mutex::ExclusiveTryLockWithSpinning(Thread* self) {
+bool Mutex::ExclusiveTryLockWithSpinning(Thread* self, int max_spins) {
   // Spin a small number of times, since this affects our ability to respond to suspension
   // requests. We spin repeatedly only if the mutex repeatedly becomes available and unavailable
   // in rapid succession, and then we will typically not spin for the maximal period.
-  const int kMaxSpins = 5;
-  for (int i = 0; i < kMaxSpins; ++i) {
+  for (int i = 0; i < max_spins; ++i) {
     if (ExclusiveTryLock(self)) {
       return true;
     }
@@ -699,6 +746,7 @@ void ReaderWriterMutex::ExclusiveLock(Thread* self) {
         if (UNLIKELY(should_respond_to_empty_checkpoint_request_)) {
           self->CheckEmptyCheckpointFromMutex();
         }
+        const uint64_t wait_sample_start = RecordFutexWaitBegin();
         if (futex(state_.Address(), FUTEX_WAIT_PRIVATE, cur_state, nullptr, nullptr, 0) != 0) {
           // EAGAIN and EINTR both indicate a spurious failure, try again from the beginning.
           // We don't use TEMP_FAILURE_RETRY so we can intentionally retry to acquire the lock.
@@ -706,6 +754,7 @@ void ReaderWriterMutex::ExclusiveLock(Thread* self) {
             PLOG(FATAL) << "futex wait failed for " << name_;
           }
         }
+        RecordFutexWaitEnd(wait_sample_start);
         SleepIfRuntimeDeleted(self);
         num_contenders_.fetch_sub(1);
       }
@@ -778,8 +827,10 @@ bool ReaderWriterMutex::ExclusiveLockWithTimeout(Thread* self, int64_t ms, int32
         if (UNLIKELY(should_respond_to_empty_checkpoint_request_)) {
           self->CheckEmptyCheckpointFromMutex();
         }
+        const uint64_t wait_sample_start = RecordFutexWaitBegin();
         if (futex(state_.Address(), FUTEX_WAIT_PRIVATE, cur_state, &rel_ts, nullptr, 0) != 0) {
           if (errno == ETIMEDOUT) {
+            RecordFutexWaitEnd(wait_sample_start);
             num_contenders_.fetch_sub(1);
             return false;  // Timed out.
           } else if ((errno != EAGAIN) && (errno != EINTR)) {
@@ -789,6 +840,7 @@ bool ReaderWriterMutex::ExclusiveLockWithTimeout(Thread* self, int64_t ms, int32
             PLOG(FATAL) << "timed futex wait failed for " << name_;
           }
         }
+        RecordFutexWaitEnd(wait_sample_start);
         SleepIfRuntimeDeleted(self);
         num_contenders_.fetch_sub(1);
       }
@@ -822,11 +874,13 @@ void ReaderWriterMutex::HandleSharedLockContention(Thread* self, int32_t cur_sta
     if (UNLIKELY(should_respond_to_empty_checkpoint_request_)) {
       self->CheckEmptyCheckpointFromMutex();
     }
+    const uint64_t wait_sample_start = RecordFutexWaitBegin();
     if (futex(state_.Address(), FUTEX_WAIT_PRIVATE, cur_state, nullptr, nullptr, 0) != 0) {
       if (errno != EAGAIN && errno != EINTR) {
         PLOG(FATAL) << "futex wait failed for " << name_;
       }
     }
+    RecordFutexWaitEnd(wait_sample_start);
     SleepIfRuntimeDeleted(self);
     num_contenders_.fetch_sub(1);
   }
@@ -70,7 +70,9 @@ constexpr bool kLogLockContentions = false;
 #endif
 constexpr size_t kContentionLogSize = 4;
 constexpr size_t kContentionLogDataSize = kLogLockContentions ? 1 : 0;
-constexpr size_t kAllMutexDataSize = kLogLockContentions ? 1 : 0;
+// The registry of all mutexes is always maintained: besides the full contention log above, it
+// backs the always-on contention statistics (see BaseMutex::ContentionStats).
+constexpr size_t kAllMutexDataSize = 1;
 
 // Base class for all Mutex implementations
 class BaseMutex {
@@ -115,6 +117,13 @@ class BaseMutex {
   void RecordContention(uint64_t blocked_tid, uint64_t owner_tid, uint64_t nano_time_blocked);
   void DumpContention(std::ostream& os) const;
 
+  // Record a contended futex wait for the always-on statistics. Returns the start time when this
+  // wait is part of the timing sample, 0 when it is not. Cheap enough for production builds: one
+  // relaxed increment per wait and a clock read for one wait in 2^kWaitTimeSampleShift.
+  uint64_t RecordFutexWaitBegin();
+  void RecordFutexWaitEnd(uint64_t sample_start_ns);
+  void DumpContentionStats(std::ostream& os) const;
+
   const char* const name_;
 
   // A log entry that records contention but makes no guarantee that either tid will be held live.
@@ -138,10 +147,29 @@ class BaseMutex {
   };
   ContentionLogData contention_log_data_[kContentionLogDataSize];
 
+  // Always-on contention statistics, unlike the full contention log above which needs a
+  // kLogLockContentions build. Updated with relaxed atomics on the contended slow path only;
+  // uncontended acquisitions never touch them.
+  struct ContentionStats {
+    static constexpr size_t kWaitTimeBuckets = 16u;
+    // Only every 2^kWaitTimeSampleShift-th futex wait is timed.
+    static constexpr uint32_t kWaitTimeSampleShift = 4u;
+
+    // Number of times a thread went into a futex wait on this mutex.
+    Atomic<uint64_t> futex_wait_count;
+    // Histogram of sampled wait times: bucket i counts waits of [2^i, 2^(i+1)) microseconds,
+    // with the last bucket open-ended.
+    Atomic<uint32_t> wait_time_buckets[kWaitTimeBuckets];
+  };
+  ContentionStats contention_stats_;
+
   const LockLevel level_;  // Support for lock hierarchy.
   bool should_respond_to_empty_checkpoint_request_;
 
  public:
+  // Dump the always-on contention statistics of every live mutex that has ever blocked.
+  static void DumpAllContentionStats(std::ostream& os);
+
   bool HasEverContended() const {
     if (kLogLockContentions) {
       return contention_log_data_->contention_count.load(std::memory_order_seq_cst) > 0;
@@ -184,7 +212,9 @@ class LOCKABLE Mutex : public BaseMutex {
   bool ExclusiveTryLock(Thread* self) TRY_ACQUIRE(true);
   bool TryLock(Thread* self) TRY_ACQUIRE(true) { return ExclusiveTryLock(self); }
   // Equivalent to ExclusiveTryLock, but retry for a short period before giving up.
-  bool ExclusiveTryLockWithSpinning(Thread* self) TRY_ACQUIRE(true);
+  // As above, but spin up to max_spins brief wait rounds for the mutex to become free before
+  // giving up. Callers with knowledge of the expected hold time can tune the spin effort.
+  bool ExclusiveTryLockWithSpinning(Thread* self, int max_spins = 5) TRY_ACQUIRE(true);
 
   // Release exclusive access.
   void ExclusiveUnlock(Thread* self) RELEASE();
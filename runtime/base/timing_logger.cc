@@ -126,6 +126,16 @@ void CumulativeLogger::DumpHistogram(std::ostream &os) const {
     // We don't expect DumpHistogram to be called often, so it is not performance critical.
     histogram->CreateHistogram(&cumulative_data);
     histogram->PrintConfidenceIntervals(os, 0.99, cumulative_data);
+    os << histogram->Name() << " percentiles: p50="
+       << PrettyDuration(static_cast<uint64_t>(
+              histogram->Percentile(0.50, cumulative_data) * histogram->AdjustFactor()))
+       << " p90="
+       << PrettyDuration(static_cast<uint64_t>(
+              histogram->Percentile(0.90, cumulative_data) * histogram->AdjustFactor()))
+       << " p99="
+       << PrettyDuration(static_cast<uint64_t>(
+              histogram->Percentile(0.99, cumulative_data) * histogram->AdjustFactor()))
+       << "\n";
   }
   os << "Done Dumping histograms\n";
 }
@@ -80,6 +80,7 @@
 #include "gc/scoped_gc_critical_section.h"
 #include "gc/space/image_space.h"
 #include "gc/space/space-inl.h"
+#include "gc/task_processor.h"
 #include "gc_root-inl.h"
 #include "handle_scope-inl.h"
 #include "hidden_api.h"
@@ -2461,6 +2462,40 @@ void ClassLinker::VisitClassesWithoutClassesLock(ClassVisitor* visitor) {
   }
 }
 
+class AssignTypeCheckBitstringVisitor : public ClassVisitor {
+ public:
+  explicit AssignTypeCheckBitstringVisitor(Thread* self) : self_(self) {}
+
+  bool operator()(ObjPtr<mirror::Class> klass) override REQUIRES_SHARED(Locks::mutator_lock_) {
+    // Interfaces, arrays and proxies never use the bitstring path; see HSharpening.
+    if (klass->IsResolved() &&
+        !klass->IsErroneous() &&
+        !klass->IsInterface() &&
+        !klass->IsArrayClass() &&
+        !klass->IsPrimitive() &&
+        !klass->IsProxyClass()) {
+      MutexLock subtype_check_lock(self_, *Locks::subtype_check_lock_);
+      // An overflowed class simply keeps using the IsAssignableFrom walk.
+      SubtypeCheck<ObjPtr<mirror::Class>>::EnsureAssigned(klass);
+    }
+    return true;
+  }
+
+ private:
+  Thread* const self_;
+};
+
+void ClassLinker::AssignTypeCheckBitstrings(Thread* self) {
+  if (!kBitstringSubtypeCheckEnabled) {
+    return;
+  }
+  ScopedTrace trace(__FUNCTION__);
+  // Visit without the classes lock so that subtype_check_lock_ can be taken per class. Classes
+  // loaded while the visit is in progress may be missed; they keep the lazy assignment path.
+  AssignTypeCheckBitstringVisitor visitor(self);
+  VisitClassesWithoutClassesLock(&visitor);
+}
+
 ClassLinker::~ClassLinker() {
   Thread* const self = Thread::Current();
   for (const ClassLoaderData& data : class_loaders_) {
@@ -2934,8 +2969,52 @@ ObjPtr<mirror::Class> ClassLinker::FindClassInBaseDexClassLoaderClassPath(
       << "Unexpected class loader for descriptor " << descriptor;
 
   ObjPtr<mirror::Class> ret;
+  // For multidex entries backed by the same oat file, one probe of the oat file's
+  // merged type lookup table replaces a probe per dex file. The dex files of an
+  // oat file appear in the class path in the oat file's order, so remembering a
+  // miss (or a hit in a later dex file) lets us skip the intermediate entries.
+  const OatFile* merged_miss_oat_file = nullptr;
+  const OatDexFile* merged_hit_oat_dex_file = nullptr;
+  uint32_t merged_hit_class_def_idx = dex::kDexNoIndex;
   auto define_class = [&](const DexFile* cp_dex_file) REQUIRES_SHARED(Locks::mutator_lock_) {
-    const dex::ClassDef* dex_class_def = OatDexFile::FindClassDef(*cp_dex_file, descriptor, hash);
+    const OatDexFile* oat_dex_file = cp_dex_file->GetOatDexFile();
+    const OatFile* oat_file = (oat_dex_file != nullptr) ? oat_dex_file->GetOatFile() : nullptr;
+    if (merged_hit_oat_dex_file != nullptr &&
+        oat_dex_file != merged_hit_oat_dex_file &&
+        oat_file != merged_hit_oat_dex_file->GetOatFile()) {
+      // Left the oat file without visiting the dex file the merged table reported;
+      // the class path does not list all of the oat file's dex files. Ignore the hit.
+      merged_hit_oat_dex_file = nullptr;
+    }
+    const dex::ClassDef* dex_class_def;
+    if (oat_file != nullptr && oat_file == merged_miss_oat_file) {
+      return true;  // The merged table already reported a miss for this oat file.
+    } else if (merged_hit_oat_dex_file != nullptr) {
+      if (oat_dex_file != merged_hit_oat_dex_file) {
+        return true;  // Skip forward to the dex file the merged table reported.
+      }
+      dex_class_def = &cp_dex_file->GetClassDef(merged_hit_class_def_idx);
+      merged_hit_oat_dex_file = nullptr;
+    } else if (oat_file != nullptr && oat_file->GetOatDexFiles().size() >= 2u) {
+      const OatDexFile* found_oat_dex_file;
+      uint32_t found_class_def_idx;
+      if (!oat_file->FindClassDefAcrossDexFiles(
+              descriptor, hash, &found_oat_dex_file, &found_class_def_idx)) {
+        // No merged table available, probe the per-dex table.
+        dex_class_def = OatDexFile::FindClassDef(*cp_dex_file, descriptor, hash);
+      } else if (found_oat_dex_file == nullptr) {
+        merged_miss_oat_file = oat_file;
+        return true;  // Not defined by any dex file in this oat file.
+      } else if (found_oat_dex_file != oat_dex_file) {
+        merged_hit_oat_dex_file = found_oat_dex_file;
+        merged_hit_class_def_idx = found_class_def_idx;
+        return true;  // Defined by a later dex file in this oat file.
+      } else {
+        dex_class_def = &cp_dex_file->GetClassDef(found_class_def_idx);
+      }
+    } else {
+      dex_class_def = OatDexFile::FindClassDef(*cp_dex_file, descriptor, hash);
+    }
     if (dex_class_def != nullptr) {
       ObjPtr<mirror::Class> klass = DefineClass(soa.Self(),
                                                 descriptor,
@@ -8686,6 +8765,152 @@ ObjPtr<mirror::Class> ClassLinker::DoResolveType(dex::TypeIndex type_idx,
   return resolved;
 }
 
+size_t ClassLinker::ResolveTypes(Thread* self,
+                                 Handle<mirror::DexCache> dex_cache,
+                                 Handle<mirror::ClassLoader> class_loader,
+                                 ArrayRef<const dex::TypeIndex> type_indices) {
+  DCHECK(dex_cache != nullptr);
+  DCHECK(!self->IsExceptionPending());
+  const DexFile* const dex_file = dex_cache->GetDexFile();
+  size_t resolved_count = 0u;
+  for (dex::TypeIndex type_idx : type_indices) {
+    ObjPtr<mirror::Class> resolved = dex_cache->GetResolvedType(type_idx);
+    if (resolved == nullptr) {
+      // In a preloaded batch most unresolved types are already loaded, e.g. as the superclass
+      // or an interface of an earlier entry. Probe the class table by descriptor first so that
+      // those only pay for the lookup and the dex cache store rather than the full FindClass
+      // path with its lock handoffs.
+      const char* descriptor = dex_file->StringByTypeIdx(type_idx);
+      ObjPtr<mirror::Class> klass =
+          LookupClass(self, descriptor, ComputeModifiedUtf8Hash(descriptor), class_loader.Get());
+      if (klass != nullptr && klass->IsResolved()) {
+        dex_cache->SetResolvedType(type_idx, klass);
+        resolved = klass;
+      } else {
+        resolved = DoResolveType(type_idx, dex_cache, class_loader);
+        if (resolved == nullptr) {
+          // Continue with the remaining types; preloading is best effort.
+          DCHECK(self->IsExceptionPending());
+          self->ClearException();
+          continue;
+        }
+      }
+    }
+    ++resolved_count;
+  }
+  return resolved_count;
+}
+
+static void* RunPreloadStartupClassesThread(void* arg) {
+  std::unique_ptr<std::string> profile_file(reinterpret_cast<std::string*>(arg));
+  Runtime* runtime = Runtime::Current();
+  bool attached = runtime->AttachCurrentThread("Startup class preloader",
+                                               /*as_daemon=*/ true,
+                                               runtime->GetSystemThreadGroup(),
+                                               /*create_peer=*/ true);
+  if (!attached) {
+    CHECK(runtime->IsShuttingDown(Thread::Current()));
+    return nullptr;
+  }
+  ProfileCompilationInfo profile_info;
+  if (profile_info.Load(*profile_file, /*clear_if_invalid=*/ false)) {
+    Thread* self = Thread::Current();
+    ScopedObjectAccess soa(self);
+    runtime->GetClassLinker()->PreloadStartupClasses(self, profile_info);
+  } else {
+    VLOG(class_linker) << "Not preloading startup classes: could not load profile "
+                       << *profile_file;
+  }
+  runtime->DetachCurrentThread();
+  return nullptr;
+}
+
+void ClassLinker::PreloadStartupClassesAsync(const std::string& profile_file) {
+  // The thread owns the copy of the file name and frees it on exit.
+  std::string* arg = new std::string(profile_file);
+  pthread_t pthread;
+  CHECK_PTHREAD_CALL(pthread_create,
+                     (&pthread, nullptr, &RunPreloadStartupClassesThread, arg),
+                     "startup class preloader thread");
+  CHECK_PTHREAD_CALL(pthread_detach, (pthread), "startup class preloader thread");
+}
+
+void ClassLinker::PreloadStartupClasses(Thread* self,
+                                        const ProfileCompilationInfo& profile_info) {
+  VariableSizedHandleScope hs(self);
+  // Map each registered class table back to its class loader so that dex caches can
+  // be paired with the right loader below. Decoding the weak roots into handles keeps
+  // the loaders alive for the duration of the preload, which is fine: we are about to
+  // resolve classes for them anyway. The boot class path uses the null loader and has
+  // no entry in class_loaders_.
+  std::unordered_map<const ClassTable*, Handle<mirror::ClassLoader>> loaders;
+  const ClassTable* boot_table;
+  {
+    ReaderMutexLock mu(self, *Locks::classlinker_classes_lock_);
+    boot_table = boot_class_table_.get();
+    for (const ClassLoaderData& data : class_loaders_) {
+      ObjPtr<mirror::ClassLoader> loader =
+          ObjPtr<mirror::ClassLoader>::DownCast(self->DecodeJObject(data.weak_root));
+      if (loader != nullptr) {
+        loaders.emplace(data.class_table, hs.NewHandle(loader));
+      }
+    }
+  }
+  // Snapshot the registered dex files with their dex caches and class loaders.
+  struct PreloadEntry {
+    const DexFile* dex_file;
+    Handle<mirror::DexCache> dex_cache;
+    Handle<mirror::ClassLoader> class_loader;
+  };
+  std::vector<PreloadEntry> entries;
+  {
+    ReaderMutexLock mu(self, *Locks::dex_lock_);
+    for (const DexCacheData& data : dex_caches_) {
+      if (!data.IsValid()) {
+        continue;
+      }
+      ObjPtr<mirror::DexCache> dex_cache = DecodeDexCacheLocked(self, &data);
+      if (dex_cache == nullptr) {
+        // The dex cache has been unloaded.
+        continue;
+      }
+      auto it = loaders.find(data.class_table);
+      if (it == loaders.end() && data.class_table != boot_table) {
+        // The class loader has been unloaded in the meantime.
+        continue;
+      }
+      Handle<mirror::ClassLoader> class_loader =
+          (it != loaders.end()) ? it->second : hs.NewHandle<mirror::ClassLoader>(nullptr);
+      entries.push_back(PreloadEntry{data.dex_file, hs.NewHandle(dex_cache), class_loader});
+    }
+  }
+  // Bulk-resolve the startup classes of each dex file the profile covers.
+  for (const PreloadEntry& entry : entries) {
+    std::set<dex::TypeIndex> class_set;
+    std::set<uint16_t> hot_methods;
+    std::set<uint16_t> startup_methods;
+    std::set<uint16_t> post_startup_methods;
+    if (!profile_info.GetClassesAndMethods(*entry.dex_file,
+                                           &class_set,
+                                           &hot_methods,
+                                           &startup_methods,
+                                           &post_startup_methods)) {
+      // The dex file is not in the profile or its checksum does not match.
+      continue;
+    }
+    if (class_set.empty()) {
+      continue;
+    }
+    std::vector<dex::TypeIndex> types(class_set.begin(), class_set.end());
+    size_t resolved = ResolveTypes(self,
+                                   entry.dex_cache,
+                                   entry.class_loader,
+                                   ArrayRef<const dex::TypeIndex>(types));
+    VLOG(class_linker) << "Preloaded " << resolved << " of " << types.size()
+                       << " startup classes from " << entry.dex_file->GetLocation();
+  }
+}
+
 ArtMethod* ClassLinker::FindResolvedMethod(ObjPtr<mirror::Class> klass,
                                            ObjPtr<mirror::DexCache> dex_cache,
                                            ObjPtr<mirror::ClassLoader> class_loader,
@@ -9790,6 +10015,26 @@ void ClassLinker::InsertDexFileInToClassLoader(ObjPtr<mirror::Object> dex_file,
   }
 }
 
+class ClassLinker::ReclaimClassLoadersTask : public gc::HeapTask {
+ public:
+  ReclaimClassLoadersTask(ClassLinker* class_linker, std::vector<ClassLoaderData>&& to_delete)
+      : gc::HeapTask(NanoTime()),
+        class_linker_(class_linker),
+        to_delete_(std::move(to_delete)) {}
+
+  void Run(Thread* self) override {
+    ScopedObjectAccess soa(self);
+    for (const ClassLoaderData& data : to_delete_) {
+      // CHA unloading analysis and SingleImplementaion cleanups are required.
+      class_linker_->DeleteClassLoader(self, data, /*cleanup_cha=*/ true);
+    }
+  }
+
+ private:
+  ClassLinker* const class_linker_;
+  std::vector<ClassLoaderData> to_delete_;
+};
+
 void ClassLinker::CleanupClassLoaders() {
   Thread* const self = Thread::Current();
   std::vector<ClassLoaderData> to_delete;
@@ -9810,9 +10055,20 @@ void ClassLinker::CleanupClassLoaders() {
       }
     }
   }
-  for (ClassLoaderData& data : to_delete) {
-    // CHA unloading analysis and SingleImplementaion cleanups are required.
-    DeleteClassLoader(self, data, /*cleanup_cha=*/ true);
+  if (to_delete.empty()) {
+    return;
+  }
+  // Freeing a large loader's metadata (LinearAlloc, ClassTable, JIT code and CHA
+  // cleanup) can take a while, so hand it to the heap task processor instead of
+  // extending the GC phase that noticed the dead loaders. The loaders are already
+  // detached from class_loaders_, so nothing can resolve classes through them in
+  // the meantime, and DeleteClassLoader itself invalidates any compiled code and
+  // CHA assumptions that still reference the dying metadata.
+  ReclaimClassLoadersTask* task = new ReclaimClassLoadersTask(this, std::move(to_delete));
+  if (!Runtime::Current()->GetHeap()->AddHeapTask(task)) {
+    // No task processor (early startup, shutdown or AOT compilation); free in place.
+    task->Run(self);
+    task->Finalize();
   }
 }
 
@@ -26,6 +26,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/array_ref.h"
 #include "base/enums.h"
 #include "base/mutex.h"
 #include "base/intrusive_forward_list.h"
@@ -89,6 +90,7 @@ class InternTable;
 class LinearAlloc;
 class OatFile;
 template<class T> class ObjectLock;
+class ProfileCompilationInfo;
 class Runtime;
 class ScopedObjectAccessAlreadyRunnable;
 template<size_t kNumReferences> class PACKED(4) StackHandleScope;
@@ -287,6 +289,32 @@ class ClassLinker {
       REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!Locks::dex_lock_, !Roles::uninterruptible_);
 
+  // Resolve a batch of types from the DexFile associated with the given DexCache, storing the
+  // results in the DexCache. Intended for startup class preloading where many types from the
+  // same dex file are resolved back to back: already-resolved entries are skipped with a single
+  // dex cache probe and already-loaded classes bypass the full FindClass path. Resolution
+  // failures are cleared and resolution continues with the remaining types. Returns the number
+  // of types resolved successfully.
+  size_t ResolveTypes(Thread* self,
+                      Handle<mirror::DexCache> dex_cache,
+                      Handle<mirror::ClassLoader> class_loader,
+                      ArrayRef<const dex::TypeIndex> type_indices)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!Locks::dex_lock_, !Roles::uninterruptible_);
+
+  // Spawn a detached background thread that loads the given profile and bulk-resolves
+  // the startup classes it records via PreloadStartupClasses. Enabled with
+  // -XX:PreloadStartupClasses:true; triggered when the app's profile is registered so
+  // that startup classes are loaded in one prefetched batch instead of through serial
+  // demand-loading misses.
+  static void PreloadStartupClassesAsync(const std::string& profile_file);
+
+  // Best-effort resolution of the startup classes recorded in the given profile for
+  // all currently registered dex files, pairing each dex cache with its class loader.
+  void PreloadStartupClasses(Thread* self, const ProfileCompilationInfo& profile_info)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!Locks::dex_lock_, !Locks::classlinker_classes_lock_, !Roles::uninterruptible_);
+
   // Look up a resolved type with the given index from the DexFile associated with the given
   // `referrer`, storing the result in the DexCache. The `referrer` is used to identify the
   // target DexCache and ClassLoader to use for lookup.
@@ -476,6 +504,14 @@ class ClassLinker {
       REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!Locks::dex_lock_);
 
+  // Eagerly assign type check bitstrings (see SubtypeCheck) to the loaded class hierarchy so
+  // that checkcast/instanceof compiled against these classes can use the bitstring fast path
+  // instead of waiting for a lazy assignment at JIT compile time. Intended to run once class
+  // loading has settled (after startup); a no-op if bitstring subtype checks are disabled.
+  void AssignTypeCheckBitstrings(Thread* self)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!Locks::subtype_check_lock_, !Locks::dex_lock_);
+
   void VisitClassRoots(RootVisitor* visitor, VisitRootFlags flags)
       REQUIRES(!Locks::classlinker_classes_lock_, !Locks::trace_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -857,6 +893,11 @@ class ClassLinker {
   void DeleteClassLoader(Thread* self, const ClassLoaderData& data, bool cleanup_cha)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Background task that frees the metadata of unloaded class loaders, so that
+  // large loaders do not extend the GC phase that found them dead. See
+  // CleanupClassLoaders.
+  class ReclaimClassLoadersTask;
+
   void VisitClassesInternal(ClassVisitor* visitor)
       REQUIRES_SHARED(Locks::classlinker_classes_lock_, Locks::mutator_lock_);
 
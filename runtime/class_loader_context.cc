@@ -16,7 +16,11 @@
 
 #include "class_loader_context.h"
 
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <unordered_map>
 
 #include <android-base/parseint.h>
 #include <android-base/strings.h>
@@ -400,14 +404,119 @@ ClassLoaderContext::ClassLoaderInfo* ClassLoaderContext::ParseInternal(
 
 // Opens requested class path files and appends them to opened_dex_files. If the dex files have
 // been stripped, this opens them from their oat files (which get added to opened_oat_files).
+// Process-wide cache of dex file checksums used by OpenDexFiles when only the checksums are
+// needed. Keyed by the dex file path; an entry is ignored (and replaced) when the file's mtime
+// or size no longer matches, so a repeated context validation for an unchanged classpath is a
+// hash lookup instead of opening the file again.
+class DexFileChecksumCache {
+ public:
+  static DexFileChecksumCache& Instance() {
+    static DexFileChecksumCache cache;
+    return cache;
+  }
+
+  // Appends the cached multidex locations and checksums for `location` if the cache holds an
+  // entry matching (mtime, size). Returns whether there was a match.
+  bool Lookup(const std::string& location,
+              int64_t mtime,
+              int64_t size,
+              std::vector<std::string>* dex_locations,
+              std::vector<uint32_t>* checksums) {
+    MutexLock mu(Thread::Current(), lock_);
+    auto it = entries_.find(location);
+    if (it == entries_.end() || it->second.mtime != mtime || it->second.size != size) {
+      return false;
+    }
+    dex_locations->insert(
+        dex_locations->end(), it->second.dex_locations.begin(), it->second.dex_locations.end());
+    checksums->insert(checksums->end(), it->second.checksums.begin(), it->second.checksums.end());
+    return true;
+  }
+
+  void Store(const std::string& location,
+             int64_t mtime,
+             int64_t size,
+             std::vector<std::string> dex_locations,
+             std::vector<uint32_t> checksums) {
+    MutexLock mu(Thread::Current(), lock_);
+    entries_[location] = Entry{ mtime, size, std::move(dex_locations), std::move(checksums) };
+  }
+
+ private:
+  struct Entry {
+    int64_t mtime;
+    int64_t size;
+    std::vector<std::string> dex_locations;
+    std::vector<uint32_t> checksums;
+  };
+
+  DexFileChecksumCache() : lock_("Dex file checksum cache lock") {}
+
+  Mutex lock_;
+  std::unordered_map<std::string, Entry> entries_ GUARDED_BY(lock_);
+};
+
+// Reads the multidex locations and checksums for the dex file(s) at `location`, serving them
+// from DexFileChecksumCache when the file is unchanged. On a miss the dex files are opened just
+// long enough to read the checksums and are closed again.
+static bool ReadDexFileChecksums(const ArtDexFileLoader& dex_file_loader,
+                                 InstructionSet isa,
+                                 const std::string& location,
+                                 std::vector<std::string>* dex_locations,
+                                 std::vector<uint32_t>* checksums) {
+  struct stat sbuf;
+  const bool have_stat = (TEMP_FAILURE_RETRY(stat(location.c_str(), &sbuf)) == 0);
+  const int64_t mtime = have_stat ? static_cast<int64_t>(sbuf.st_mtime) : 0;
+  const int64_t size = have_stat ? static_cast<int64_t>(sbuf.st_size) : 0;
+  DexFileChecksumCache& cache = DexFileChecksumCache::Instance();
+  if (have_stat && cache.Lookup(location, mtime, size, dex_locations, checksums)) {
+    return true;
+  }
+
+  std::vector<std::unique_ptr<const DexFile>> dex_files;
+  std::string error_msg;
+  if (!dex_file_loader.Open(location.c_str(),
+                            location.c_str(),
+                            /*verify=*/ false,
+                            /*verify_checksum=*/ true,
+                            &error_msg,
+                            &dex_files)) {
+    // The dex file may have been stripped; fall back to the checksums recorded in its oat file,
+    // mirroring the full OpenDexFiles path below.
+    OatFileAssistant oat_file_assistant(location.c_str(), isa, false);
+    std::unique_ptr<OatFile> oat_file(oat_file_assistant.GetBestOatFile());
+    if (oat_file == nullptr || !OatFileAssistant::LoadDexFiles(*oat_file, location, &dex_files)) {
+      return false;
+    }
+  }
+
+  std::vector<std::string> new_locations;
+  std::vector<uint32_t> new_checksums;
+  for (const std::unique_ptr<const DexFile>& dex_file : dex_files) {
+    new_locations.push_back(dex_file->GetLocation());
+    new_checksums.push_back(dex_file->GetLocationChecksum());
+  }
+  dex_locations->insert(dex_locations->end(), new_locations.begin(), new_locations.end());
+  checksums->insert(checksums->end(), new_checksums.begin(), new_checksums.end());
+  if (have_stat) {
+    cache.Store(location, mtime, size, std::move(new_locations), std::move(new_checksums));
+  }
+  return true;
+}
+
 bool ClassLoaderContext::OpenDexFiles(InstructionSet isa,
                                       const std::string& classpath_dir,
-                                      const std::vector<int>& fds) {
+                                      const std::vector<int>& fds,
+                                      bool only_read_checksums) {
   if (dex_files_open_attempted_) {
     // Do not attempt to re-open the files if we already tried.
     return dex_files_open_result_;
   }
 
+  // With explicit file descriptors there is no path to key the checksum cache on; just open the
+  // dex files as usual.
+  only_read_checksums = only_read_checksums && fds.empty();
+
   dex_files_open_attempted_ = true;
   // Assume we can open all dex files. If not, we will set this to false as we go.
   dex_files_open_result_ = true;
@@ -432,6 +541,9 @@ bool ClassLoaderContext::OpenDexFiles(InstructionSet isa,
     DCHECK(info->type != kInMemoryDexClassLoader) << __FUNCTION__ << " not supported for IMC";
 
     size_t opened_dex_files_index = info->opened_dex_files.size();
+    // Multidex locations and checksums collected when `only_read_checksums` is set.
+    std::vector<std::string> read_locations;
+    std::vector<uint32_t> read_checksums;
     for (const std::string& cp_elem : info->classpath) {
       // If path is relative, append it to the provided base directory.
       std::string location = cp_elem;
@@ -454,6 +566,16 @@ bool ClassLoaderContext::OpenDexFiles(InstructionSet isa,
         DCHECK_GE(fd, 0);
       }
 
+      if (only_read_checksums) {
+        DCHECK_LT(fd, 0);
+        if (!ReadDexFileChecksums(
+                dex_file_loader, isa, location, &read_locations, &read_checksums)) {
+          LOG(WARNING) << "Could not read dex file checksums for location: " << location;
+          dex_files_open_result_ = false;
+        }
+        continue;
+      }
+
       std::string error_msg;
       // When opening the dex files from the context we expect their checksum to match their
       // contents. So pass true to verify_checksum.
@@ -509,10 +631,15 @@ bool ClassLoaderContext::OpenDexFiles(InstructionSet isa,
     info->original_classpath = std::move(info->classpath);
     info->classpath.clear();
     info->checksums.clear();
-    for (size_t k = opened_dex_files_index; k < info->opened_dex_files.size(); k++) {
-      std::unique_ptr<const DexFile>& dex = info->opened_dex_files[k];
-      info->classpath.push_back(dex->GetLocation());
-      info->checksums.push_back(dex->GetLocationChecksum());
+    if (only_read_checksums) {
+      info->classpath = std::move(read_locations);
+      info->checksums = std::move(read_checksums);
+    } else {
+      for (size_t k = opened_dex_files_index; k < info->opened_dex_files.size(); k++) {
+        std::unique_ptr<const DexFile>& dex = info->opened_dex_files[k];
+        info->classpath.push_back(dex->GetLocation());
+        info->checksums.push_back(dex->GetLocationChecksum());
+      }
     }
     AddToWorkList(info, work_list);
   }
@@ -691,19 +818,23 @@ void ClassLoaderContext::EncodeContextInternal(const ClassLoaderInfo& info,
     }
   }
 
-  for (size_t k = 0; k < info.opened_dex_files.size(); k++) {
-    const std::unique_ptr<const DexFile>& dex_file = info.opened_dex_files[k];
+  // If the dex files were not kept open (OpenDexFiles ran in checksums-only mode), the
+  // classpath already holds the individual multidex locations with their checksums.
+  const bool use_classpath = info.opened_dex_files.empty() && !info.classpath.empty();
+  const size_t num_dex_files =
+      use_classpath ? info.classpath.size() : info.opened_dex_files.size();
+  for (size_t k = 0; k < num_dex_files; k++) {
+    std::string location =
+        use_classpath ? info.classpath[k] : info.opened_dex_files[k]->GetLocation();
     if (for_dex2oat) {
       // dex2oat only needs the base location. It cannot accept multidex locations.
       // So ensure we only add each file once.
-      bool new_insert = seen_locations.insert(
-          DexFileLoader::GetBaseLocation(dex_file->GetLocation())).second;
+      bool new_insert = seen_locations.insert(DexFileLoader::GetBaseLocation(location)).second;
       if (!new_insert) {
         continue;
       }
     }
 
-    std::string location = dex_file->GetLocation();
     // If there is a stored class loader remap, fix up the multidex strings.
     if (!remap.empty()) {
       std::string base_dex_location = DexFileLoader::GetBaseLocation(location);
@@ -715,7 +846,8 @@ void ClassLoaderContext::EncodeContextInternal(const ClassLoaderInfo& info,
 
     // dex2oat does not need the checksums.
     if (!for_dex2oat) {
-      checksums.push_back(dex_file->GetLocationChecksum());
+      checksums.push_back(use_classpath ? info.checksums[k]
+                                        : info.opened_dex_files[k]->GetLocationChecksum());
     }
   }
   EncodeClassPath(base_dir, locations, checksums, info.type, out);
@@ -81,9 +81,17 @@ class ClassLoaderContext {
   // TODO(calin): we're forced to complicate the flow in this class with a different
   // OpenDexFiles step because the current dex2oat flow requires the dex files be opened before
   // the class loader is created. Consider reworking the dex2oat part.
+  //
+  // If `only_read_checksums` is true, the dex files are not kept open; only the multidex
+  // locations and checksums are recorded (which is all that encoding and context verification
+  // need). In this mode the checksums are served from a process-wide cache keyed by the dex
+  // file path and invalidated on mtime/size changes, so that repeatedly validating the same
+  // class loader context does not re-read the classpath from disk. Callers that need the
+  // actual dex files (e.g. dex2oat compiling against the context) must not set it.
   bool OpenDexFiles(InstructionSet isa,
                     const std::string& classpath_dir,
-                    const std::vector<int>& context_fds = std::vector<int>());
+                    const std::vector<int>& context_fds = std::vector<int>(),
+                    bool only_read_checksums = false);
 
   // Remove the specified compilation sources from all classpaths present in this context.
   // Should only be called before the first call to OpenDexFiles().
@@ -22,15 +22,29 @@
 
 namespace art {
 
-ClassTable::ClassTable() : lock_("Class loader classes", kClassLoaderClassesLock) {
+ClassTable::ClassTable() : lock_("Class loader classes", kClassLoaderClassesLock),
+                           frozen_sets_(nullptr) {
   Runtime* const runtime = Runtime::Current();
   classes_.push_back(ClassSet(runtime->GetHashTableMinLoadFactor(),
                               runtime->GetHashTableMaxLoadFactor()));
 }
 
+void ClassTable::PublishFrozenSets() {
+  std::unique_ptr<std::vector<ClassSet*>> snapshot(new std::vector<ClassSet*>());
+  // All sets but the back one are frozen and safe to search without the lock.
+  for (size_t i = 0; i + 1 < classes_.size(); ++i) {
+    snapshot->push_back(&classes_[i]);
+  }
+  // Release ordering pairs with the acquire load in Lookup so that readers observe the fully
+  // constructed snapshot.
+  frozen_sets_.store(snapshot.get(), std::memory_order_release);
+  retired_frozen_sets_.push_back(std::move(snapshot));
+}
+
 void ClassTable::FreezeSnapshot() {
   WriterMutexLock mu(Thread::Current(), lock_);
   classes_.push_back(ClassSet());
+  PublishFrozenSets();
 }
 
 bool ClassTable::Contains(ObjPtr<mirror::Class> klass) {
@@ -117,8 +131,26 @@ size_t ClassTable::NumReferencedNonZygoteClasses() const {
 
 ObjPtr<mirror::Class> ClassTable::Lookup(const char* descriptor, size_t hash) {
   DescriptorHashPair pair(descriptor, hash);
+  // Search the frozen sets without acquiring the lock. This covers almost all lookups for
+  // classes in the boot image and in zygote snapshots, leaving only the mutable set at the
+  // back to be searched under the reader lock.
+  const std::vector<ClassSet*>* const frozen_sets =
+      frozen_sets_.load(std::memory_order_acquire);
+  if (frozen_sets != nullptr) {
+    for (ClassSet* class_set : *frozen_sets) {
+      auto it = class_set->FindWithHash(pair, hash);
+      if (it != class_set->end()) {
+        return it->Read();
+      }
+    }
+  }
   ReaderMutexLock mu(Thread::Current(), lock_);
   for (ClassSet& class_set : classes_) {
+    // Skip the sets already searched through the snapshot. New sets may have been added since
+    // the snapshot was loaded, so match by identity rather than by position.
+    if (frozen_sets != nullptr && ContainsElement(*frozen_sets, &class_set)) {
+      continue;
+    }
     auto it = class_set.FindWithHash(pair, hash);
     if (it != class_set.end()) {
       return it->Read();
@@ -284,6 +316,7 @@ size_t ClassTable::ReadFromMemory(uint8_t* ptr) {
 void ClassTable::AddClassSet(ClassSet&& set) {
   WriterMutexLock mu(Thread::Current(), lock_);
   classes_.insert(classes_.begin(), std::move(set));
+  PublishFrozenSets();
 }
 
 void ClassTable::ClearStrongRoots() {
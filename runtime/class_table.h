@@ -17,11 +17,14 @@
 #ifndef ART_RUNTIME_CLASS_TABLE_H_
 #define ART_RUNTIME_CLASS_TABLE_H_
 
+#include <deque>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base/allocator.h"
+#include "base/atomic.h"
 #include "base/hash_set.h"
 #include "base/macros.h"
 #include "base/mutex.h"
@@ -283,10 +286,24 @@ class ClassTable {
       REQUIRES(lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Publish a new snapshot of the frozen class sets for lock-free lookups. Must be called
+  // whenever the number or order of class sets changes.
+  void PublishFrozenSets() REQUIRES(lock_);
+
   // Lock to guard inserting and removing.
   mutable ReaderWriterMutex lock_;
-  // We have a vector to help prevent dirty pages after the zygote forks by calling FreezeSnapshot.
-  std::vector<ClassSet> classes_ GUARDED_BY(lock_);
+  // We have multiple class sets to help prevent dirty pages after the zygote forks by calling
+  // FreezeSnapshot. A deque is used instead of a vector so that adding a new set does not
+  // relocate the existing ones, which lock-free readers may be searching concurrently.
+  std::deque<ClassSet> classes_ GUARDED_BY(lock_);
+  // Snapshot of the frozen class sets, i.e. all but the mutable set at the back of classes_.
+  // Frozen sets are never structurally modified (only their atomic slots are updated in place by
+  // the GC), so readers may search them without holding lock_. Rebuilt under the writer lock by
+  // PublishFrozenSets; superseded snapshots are retired rather than freed since racing readers
+  // may still be iterating them.
+  Atomic<const std::vector<ClassSet*>*> frozen_sets_;
+  std::vector<std::unique_ptr<const std::vector<ClassSet*>>> retired_frozen_sets_
+      GUARDED_BY(lock_);
   // Extra strong roots that can be either dex files or dex caches. Dex files used by the class
   // loader which may not be owned by the class loader must be held strongly live. Also dex caches
   // are held live to prevent them being unloading once they have classes in them.
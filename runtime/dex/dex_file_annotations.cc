@@ -18,10 +18,14 @@
 
 #include <stdlib.h>
 
+#include <unordered_map>
+#include <vector>
+
 #include "android-base/stringprintf.h"
 
 #include "art_field-inl.h"
 #include "art_method-inl.h"
+#include "base/mutex.h"
 #include "base/sdk_version.h"
 #include "class_linker-inl.h"
 #include "class_root.h"
@@ -262,24 +266,88 @@ bool SkipAnnotationValue(const DexFile& dex_file, const uint8_t** annotation_ptr
   return true;
 }
 
+// Cache of flattened encoded_annotation structures, keyed by their address in
+// the mapped dex file. Element lookups otherwise re-decode the LEB128 stream
+// and skip over every preceding value on each query, and reflection-heavy
+// frameworks query the same annotations repeatedly. Entries hold pointers into
+// dex data, so they must be purged before a dex file is deleted (see
+// PurgeDecodedAnnotationCache), like the interpreter caches.
+class DecodedAnnotationCache {
+ public:
+  DecodedAnnotationCache() : lock_("Decoded annotation cache lock") {}
+
+  // Returns the encoded_value of the element named `name`, or null if the
+  // annotation has no such element.
+  const uint8_t* FindElement(const DexFile& dex_file, const uint8_t* annotation, const char* name)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    MutexLock mu(Thread::Current(), lock_);
+    auto it = cache_.find(annotation);
+    if (it == cache_.end()) {
+      const uint8_t* cursor = annotation;
+      DecodeUnsignedLeb128(&cursor);  // unused type_index
+      uint32_t size = DecodeUnsignedLeb128(&cursor);
+      std::vector<Element> elements;
+      elements.reserve(size);
+      for (; size != 0u; --size) {
+        uint32_t element_name_index = DecodeUnsignedLeb128(&cursor);
+        elements.push_back(Element { element_name_index, cursor });
+        if (!SkipAnnotationValue(dex_file, &cursor)) {
+          return nullptr;
+        }
+      }
+      if (cache_.size() == kMaxEntries) {
+        // Crude eviction; working sets rarely get this large.
+        cache_.clear();
+      }
+      it = cache_.emplace(annotation, std::move(elements)).first;
+    }
+    for (const Element& element : it->second) {
+      const char* element_name =
+          dex_file.GetStringData(dex_file.GetStringId(dex::StringIndex(element.name_index)));
+      if (strcmp(name, element_name) == 0) {
+        return element.value;
+      }
+    }
+    return nullptr;
+  }
+
+  void RemoveEntriesForDexFile(const DexFile* dex_file) {
+    MutexLock mu(Thread::Current(), lock_);
+    const uint8_t* begin = dex_file->Begin();
+    const uint8_t* end = begin + dex_file->Size();
+    for (auto it = cache_.begin(); it != cache_.end(); ) {
+      if (begin <= it->first && it->first < end) {
+        it = cache_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+ private:
+  // One element of a flattened encoded_annotation: the element name string
+  // index and a pointer to its encoded_value in the dex file.
+  struct Element {
+    uint32_t name_index;
+    const uint8_t* value;
+  };
+
+  static constexpr size_t kMaxEntries = 1024;
+
+  Mutex lock_;
+  std::unordered_map<const uint8_t*, std::vector<Element>> cache_ GUARDED_BY(lock_);
+};
+
+DecodedAnnotationCache* GetDecodedAnnotationCache() {
+  static DecodedAnnotationCache cache;
+  return &cache;
+}
+
 const uint8_t* SearchEncodedAnnotation(const DexFile& dex_file,
                                        const uint8_t* annotation,
                                        const char* name)
     REQUIRES_SHARED(Locks::mutator_lock_) {
-  DecodeUnsignedLeb128(&annotation);  // unused type_index
-  uint32_t size = DecodeUnsignedLeb128(&annotation);
-
-  while (size != 0) {
-    uint32_t element_name_index = DecodeUnsignedLeb128(&annotation);
-    const char* element_name =
-        dex_file.GetStringData(dex_file.GetStringId(dex::StringIndex(element_name_index)));
-    if (strcmp(name, element_name) == 0) {
-      return annotation;
-    }
-    SkipAnnotationValue(dex_file, &annotation);
-    size--;
-  }
-  return nullptr;
+  return GetDecodedAnnotationCache()->FindElement(dex_file, annotation, name);
 }
 
 static const AnnotationSetItem* FindAnnotationSetForMethod(const DexFile& dex_file,
@@ -1779,6 +1847,10 @@ int32_t GetLineNumFromPC(const DexFile* dex_file, ArtMethod* method, uint32_t re
   return line_num;
 }
 
+void PurgeDecodedAnnotationCache(const DexFile* dex_file) {
+  GetDecodedAnnotationCache()->RemoveEntriesForDexFile(dex_file);
+}
+
 template<bool kTransactionActive>
 void RuntimeEncodedStaticFieldValueIterator::ReadValueToField(ArtField* field) const {
   DCHECK(dex_cache_ != nullptr);
@@ -139,6 +139,10 @@ bool IsClassAnnotationPresent(Handle<mirror::Class> klass,
 int32_t GetLineNumFromPC(const DexFile* dex_file, ArtMethod* method, uint32_t rel_pc)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
+// Drop cached decoded annotation data pointing into `dex_file`. Must be called
+// before deleting a dex file while the runtime keeps running.
+void PurgeDecodedAnnotationCache(const DexFile* dex_file);
+
 // Annotations iterator.
 class RuntimeEncodedStaticFieldValueIterator : public EncodedStaticFieldValueIterator {
  public:
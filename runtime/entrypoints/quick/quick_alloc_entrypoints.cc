@@ -40,7 +40,12 @@ static ALWAYS_INLINE inline mirror::Object* artAllocObjectFromCode(
     Thread* self) REQUIRES_SHARED(Locks::mutator_lock_) {
   ScopedQuickEntrypointChecks sqec(self);
   DCHECK(klass != nullptr);
-  if (kUseTlabFastPath && !kInstrumented && allocator_type == gc::kAllocatorTypeTLAB) {
+  // Both TLAB allocators use the same thread-local bump pointer, so the fast path is
+  // shared; the assembly entrypoints do the same for the region TLAB allocator.
+  if (kUseTlabFastPath &&
+      !kInstrumented &&
+      (allocator_type == gc::kAllocatorTypeTLAB ||
+       allocator_type == gc::kAllocatorTypeRegionTLAB)) {
     // The "object size alloc fast path" is set when the class is
     // visibly initialized, objects are fixed size and non-finalizable.
     // Otherwise, the value is too large for the size check to succeed.
@@ -16,15 +16,34 @@
 
 #include "mirror/class-inl.h"
 #include "mirror/object-inl.h"
+#include "thread-inl.h"
+#include "type_check_cache.h"
 
 namespace art {
 
+static size_t IsAssignableMemoized(mirror::Class* klass, mirror::Class* ref_class)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  Thread* self = Thread::Current();
+  TypeCheckCache* cache = self->GetTypeCheckCache();
+  size_t result;
+  if (cache->Get(ref_class, klass, &result)) {
+    return result;
+  }
+  result = klass->IsAssignableFrom(ref_class) ? 1 : 0;
+  // Do not insert new entries while the GC is sweeping the cache; we could
+  // cache a pointer the sweep has already visited.
+  if (!kUseReadBarrier || self->GetWeakRefAccessEnabled()) {
+    cache->Set(ref_class, klass, result);
+  }
+  return result;
+}
+
 // Assignable test for code, won't throw.  Null and equality tests already performed
 extern "C" size_t artIsAssignableFromCode(mirror::Class* klass, mirror::Class* ref_class)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   DCHECK(klass != nullptr);
   DCHECK(ref_class != nullptr);
-  return klass->IsAssignableFrom(ref_class) ? 1 : 0;
+  return IsAssignableMemoized(klass, ref_class);
 }
 
 // Is assignable test for code, won't throw.  Null and equality test already performed.
@@ -32,7 +51,7 @@ extern "C" size_t artInstanceOfFromCode(mirror::Object* obj, mirror::Class* ref_
     REQUIRES_SHARED(Locks::mutator_lock_) {
   DCHECK(obj != nullptr);
   DCHECK(ref_class != nullptr);
-  return obj->InstanceOf(ref_class) ? 1 : 0;
+  return IsAssignableMemoized(ref_class, obj->GetClass().Ptr());
 }
 
 }  // namespace art
@@ -837,18 +837,29 @@ extern "C" uint64_t artQuickProxyInvokeHandler(
   DCHECK_GT(args.size(), 0U) << proxy_method->PrettyMethod();
   args.erase(args.begin());
 
-  // Convert proxy method into expected interface method.
-  ArtMethod* interface_method = proxy_method->FindOverriddenMethod(kRuntimePointerSize);
-  DCHECK(interface_method != nullptr) << proxy_method->PrettyMethod();
-  DCHECK(!interface_method->IsProxyMethod()) << interface_method->PrettyMethod();
   self->EndAssertNoThreadSuspension(old_cause);
   DCHECK_EQ(Runtime::Current()->GetClassLinker()->GetImagePointerSize(), kRuntimePointerSize);
   DCHECK(!Runtime::Current()->IsActiveTransaction());
+  // Invocations of the same proxy method are typically repeated (e.g. RPC stubs),
+  // so reuse the reflective interface method object from the last proxy call on
+  // this thread instead of looking it up and allocating a fresh one every time.
+  // Sharing the Method instance across calls matches the reference implementation,
+  // where generated proxies pass Method objects cached in static fields.
   ObjPtr<mirror::Method> interface_reflect_method =
-      mirror::Method::CreateFromArtMethod<kRuntimePointerSize, false>(soa.Self(), interface_method);
+      self->GetCachedProxyInvokeMethod(proxy_method);
   if (interface_reflect_method == nullptr) {
-    soa.Self()->AssertPendingOOMException();
-    return 0;
+    // Convert proxy method into expected interface method.
+    ArtMethod* interface_method = proxy_method->FindOverriddenMethod(kRuntimePointerSize);
+    DCHECK(interface_method != nullptr) << proxy_method->PrettyMethod();
+    DCHECK(!interface_method->IsProxyMethod()) << interface_method->PrettyMethod();
+    interface_reflect_method =
+        mirror::Method::CreateFromArtMethod<kRuntimePointerSize, false>(soa.Self(),
+                                                                        interface_method);
+    if (interface_reflect_method == nullptr) {
+      soa.Self()->AssertPendingOOMException();
+      return 0;
+    }
+    self->CacheProxyInvokeMethod(proxy_method, interface_reflect_method);
   }
   jobject interface_method_jobj = soa.AddLocalReference<jobject>(interface_reflect_method);
 
@@ -1192,12 +1203,23 @@ static void DumpB74410240DebugData(ArtMethod** sp) REQUIRES_SHARED(Locks::mutato
       tag = "encoded ";
       caller = inline_info.GetArtMethod();
     } else {
-      uint32_t method_index = code_info.GetMethodIndexOf(inline_info);
+      MethodInfo method_info = code_info.GetMethodInfoOf(inline_info);
+      uint32_t method_index = method_info.GetMethodIndex();
       if (dex_pc == static_cast<uint32_t>(-1)) {
         tag = "special ";
         CHECK(inline_info.Equals(inline_infos.back()));
         caller = jni::DecodeArtMethod(WellKnownClasses::java_lang_String_charAt);
         CHECK_EQ(caller->GetDexMethodIndex(), method_index);
+      } else if (method_info.GetDexFileIndexKind() == MethodInfo::kBootClassPath) {
+        tag = "boot classpath ";
+        const std::vector<const DexFile*>& boot_class_path = class_linker->GetBootClassPath();
+        uint32_t dex_file_index = method_info.GetDexFileIndex();
+        CHECK_LT(dex_file_index, boot_class_path.size());
+        ObjPtr<mirror::DexCache> dex_cache =
+            class_linker->FindDexCache(Thread::Current(), *boot_class_path[dex_file_index]);
+        caller = class_linker->LookupResolvedMethod(
+            method_index, dex_cache, /* class_loader= */ nullptr);
+        CHECK(caller != nullptr);
       } else {
         ObjPtr<mirror::DexCache> dex_cache = caller->GetDexCache();
         ObjPtr<mirror::ClassLoader> class_loader = caller->GetClassLoader();
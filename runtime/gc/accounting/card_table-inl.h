@@ -19,6 +19,12 @@
 
 #include "card_table.h"
 
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include <android-base/logging.h>
 
 #include "base/atomic.h"
@@ -77,6 +83,41 @@ inline size_t CardTable::Scan(ContinuousSpaceBitmap* bitmap,
     ++card_cur;
   }
 
+#if defined(__ARM_NEON) || defined(__SSE2__)
+  // Vectorized scan: test 16 cards per load and use the count of trailing zeros in the
+  // resulting mask to jump directly to the next card of at least minimum_age.
+  static constexpr size_t kCardsPerVector = 16;
+  uint8_t* const vector_end =
+      card_cur + (static_cast<size_t>(card_end - card_cur) / kCardsPerVector) * kCardsPerVector;
+  while (card_cur < vector_end) {
+#if defined(__ARM_NEON)
+    const uint8x16_t chunk = vld1q_u8(card_cur);
+    const uint8x16_t cmp = vcgeq_u8(chunk, vdupq_n_u8(minimum_age));
+    // Narrow each 8-bit lane of the compare result to 4 bits to form a 64-bit mask.
+    uint64_t mask = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4)), 0);
+    static constexpr size_t kMaskBitsPerCard = 4;
+#else
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(card_cur));
+    const __m128i min_age = _mm_set1_epi8(static_cast<char>(minimum_age));
+    // There is no unsigned byte compare; a byte is >= minimum_age iff max(byte, minimum_age)
+    // equals the byte.
+    uint64_t mask = static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(chunk, min_age), chunk)));
+    static constexpr size_t kMaskBitsPerCard = 1;
+#endif
+    while (mask != 0) {
+      const size_t card_index = CTZ(mask) / kMaskBitsPerCard;
+      uint8_t* card = card_cur + card_index;
+      DCHECK_GE(*card, minimum_age);
+      uintptr_t start = reinterpret_cast<uintptr_t>(AddrFromCard(card));
+      bitmap->VisitMarkedRange(start, start + kCardSize, visitor);
+      ++cards_scanned;
+      mask &= ~(((UINT64_C(1) << kMaskBitsPerCard) - 1) << (card_index * kMaskBitsPerCard));
+    }
+    card_cur += kCardsPerVector;
+  }
+#else
   uint8_t* aligned_end = card_end -
       (reinterpret_cast<uintptr_t>(card_end) & (sizeof(uintptr_t) - 1));
 
@@ -108,9 +149,10 @@ inline size_t CardTable::Scan(ContinuousSpaceBitmap* bitmap,
     }
   }
   exit_for:
-
-  // Handle any unaligned cards at the end.
   card_cur = reinterpret_cast<uint8_t*>(word_end);
+#endif
+
+  // Handle any remaining cards at the end.
   while (card_cur < card_end) {
     if (*card_cur >= minimum_age) {
       uintptr_t start = reinterpret_cast<uintptr_t>(AddrFromCard(card_cur));
@@ -57,7 +57,17 @@ class CardTable {
 
   // Set the card associated with the given address to `kCardDirty`.
   ALWAYS_INLINE void MarkCard(const void *addr) {
-    *CardFromAddr(addr) = kCardDirty;
+    uint8_t* card_addr = CardFromAddr(addr);
+    // Check before write: most marks hit an already-dirty card, and skipping the
+    // store keeps the card's cache line in shared state instead of ping-ponging
+    // it between threads that write to neighbouring objects. Skipping on a stale
+    // read of `kCardDirty` is benign: the collector only ages or clears cards
+    // around a checkpoint or pause, which orders the card value for subsequent
+    // reads, so a racing skip is equivalent to a dirty store that landed just
+    // before the collector's transition.
+    if (*card_addr != kCardDirty) {
+      *card_addr = kCardDirty;
+    }
   }
 
   // Is the object on a dirty card?
@@ -420,29 +420,31 @@ void ModUnionTableReferenceCache::UpdateAndMarkReferences(MarkObjectVisitor* vis
   bool has_target_reference;
   ModUnionReferenceVisitor add_visitor(this, visitor, &cards_references, &has_target_reference);
   CardSet new_cleared_cards;
+  // Every card in this table belongs to space_, so resolve the live bitmap once instead of
+  // searching the continuous space list for each card.
+  ContinuousSpaceBitmap* const live_bitmap = space_->GetLiveBitmap();
   for (uint8_t* card : cleared_cards_) {
     // Clear and re-compute alloc space references associated with this card.
     cards_references.clear();
     has_target_reference = false;
     uintptr_t start = reinterpret_cast<uintptr_t>(card_table->AddrFromCard(card));
     uintptr_t end = start + CardTable::kCardSize;
-    space::ContinuousSpace* space =
-        heap_->FindContinuousSpaceFromObject(reinterpret_cast<mirror::Object*>(start), false);
-    DCHECK(space != nullptr);
-    ContinuousSpaceBitmap* live_bitmap = space->GetLiveBitmap();
+    DCHECK(space_->HasAddress(reinterpret_cast<mirror::Object*>(start)))
+        << reinterpret_cast<void*>(start) << " " << *space_;
     live_bitmap->VisitMarkedRange(start, end, add_visitor);
-    // Update the corresponding references for the card.
+    // Update the corresponding references for the card. Move the scratch vector into the
+    // table instead of copying it; it is cleared again at the top of the loop.
     auto found = references_.find(card);
     if (found == references_.end()) {
       // Don't add card for an empty reference array.
       if (!cards_references.empty()) {
-        references_.Put(card, cards_references);
+        references_.Put(card, std::move(cards_references));
       }
     } else {
       if (cards_references.empty()) {
         references_.erase(found);
       } else {
-        found->second = cards_references;
+        found->second = std::move(cards_references);
       }
     }
     if (has_target_reference) {
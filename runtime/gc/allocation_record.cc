@@ -24,6 +24,8 @@
 #include "object_callbacks.h"
 #include "stack.h"
 
+#include <random>
+
 #include <android-base/properties.h>
 
 namespace art {
@@ -39,6 +41,14 @@ const char* AllocRecord::GetClassDescriptor(std::string* storage) const {
   return klass_.IsNull() ? "null" : klass_.Read()->GetDescriptor(storage);
 }
 
+// Byte budget left until the current thread takes its next sample, when sampling is enabled.
+// Signed so that one allocation larger than the remaining budget still triggers the sample.
+static thread_local ssize_t tl_bytes_until_sample = 0;
+
+void AllocRecordObjectMap::SetSampleIntervalBytes(size_t bytes) {
+  sample_interval_bytes_ = bytes;
+}
+
 void AllocRecordObjectMap::SetMaxStackDepth(size_t max_stack_depth) {
   // Log fatal since this should already be checked when calling VMDebug.setAllocTrackerStackDepth.
   CHECK_LE(max_stack_depth, kMaxSupportedStackDepth)
@@ -153,11 +163,16 @@ void AllocRecordObjectMap::SetAllocTrackingEnabled(bool enable) {
       }
       CHECK(records != nullptr);
       records->SetMaxStackDepth(heap->GetAllocTrackerStackDepth());
+      records->SetSampleIntervalBytes(heap->GetAllocTrackerSampleInterval());
       size_t sz = sizeof(AllocRecordStackTraceElement) * records->max_stack_depth_ +
                   sizeof(AllocRecord) + sizeof(AllocRecordStackTrace);
       LOG(INFO) << "Enabling alloc tracker (" << records->alloc_record_max_ << " entries of "
                 << records->max_stack_depth_ << " frames, taking up to "
                 << PrettySize(sz * records->alloc_record_max_) << ")";
+      if (records->sample_interval_bytes_ != 0u) {
+        LOG(INFO) << "Alloc tracker sampling ~1 allocation per "
+                  << PrettySize(records->sample_interval_bytes_) << " allocated";
+      }
     }
     Runtime::Current()->GetInstrumentation()->InstrumentQuickAllocEntryPoints();
     {
@@ -185,6 +200,23 @@ void AllocRecordObjectMap::SetAllocTrackingEnabled(bool enable) {
 void AllocRecordObjectMap::RecordAllocation(Thread* self,
                                             ObjPtr<mirror::Object>* obj,
                                             size_t byte_count) {
+  const size_t sample_interval = sample_interval_bytes_;
+  if (sample_interval != 0u) {
+    tl_bytes_until_sample -= static_cast<ssize_t>(byte_count);
+    if (LIKELY(tl_bytes_until_sample > 0)) {
+      // Skip this allocation: unsampled allocations pay neither the stack walk nor the tracker
+      // lock, which is what keeps sampled tracking cheap enough for production.
+      return;
+    }
+    // Draw the distance to the next sample from an exponential distribution so that every byte
+    // has the same probability of being sampled regardless of object size (Poisson sampling, as
+    // in tcmalloc's heap profiler).
+    static thread_local std::minstd_rand tl_rng(std::random_device{}());
+    std::exponential_distribution<double> distribution(
+        1.0 / static_cast<double>(sample_interval));
+    tl_bytes_until_sample = static_cast<ssize_t>(distribution(tl_rng)) + 1;
+  }
+
   // Get stack trace outside of lock in case there are allocations during the stack walk.
   // b/27858645.
   AllocRecordStackTrace trace;
@@ -233,12 +233,21 @@ class AllocRecordObjectMap {
       entries_.pop_front();
     }
     entries_.push_back(EntryPair(GcRoot<mirror::Object>(obj), std::move(record)));
+    ++total_recorded_allocations_;
   }
 
   size_t Size() const REQUIRES_SHARED(Locks::alloc_tracker_lock_) {
     return entries_.size();
   }
 
+  // Monotonic count of all allocations ever recorded, including ones whose entries have since
+  // been evicted from the ring buffer. Used as an epoch by incremental heap dumps: the last
+  // (GetTotalRecordedAllocations() - epoch) entries of the list are the ones recorded since
+  // the epoch was read.
+  uint64_t GetTotalRecordedAllocations() const REQUIRES_SHARED(Locks::alloc_tracker_lock_) {
+    return total_recorded_allocations_;
+  }
+
   size_t GetRecentAllocationSize() const REQUIRES_SHARED(Locks::alloc_tracker_lock_) {
     CHECK_LE(recent_record_max_, alloc_record_max_);
     size_t sz = entries_.size();
@@ -299,12 +308,18 @@ class AllocRecordObjectMap {
   size_t alloc_record_max_ GUARDED_BY(Locks::alloc_tracker_lock_) = kDefaultNumAllocRecords;
   size_t recent_record_max_ GUARDED_BY(Locks::alloc_tracker_lock_) = kDefaultNumRecentRecords;
   size_t max_stack_depth_ = kDefaultAllocStackDepth;
+  // Average number of allocated bytes between two recorded allocations, 0 to record every
+  // allocation. Like max_stack_depth_ this is written under the lock while tracking is being
+  // enabled and read racily on the allocation path; stale reads only mis-time a sample.
+  size_t sample_interval_bytes_ = 0;
   bool allow_new_record_ GUARDED_BY(Locks::alloc_tracker_lock_) = true;
+  uint64_t total_recorded_allocations_ GUARDED_BY(Locks::alloc_tracker_lock_) = 0;
   ConditionVariable new_record_condition_ GUARDED_BY(Locks::alloc_tracker_lock_);
   // see the comment in typedef of EntryList
   EntryList entries_ GUARDED_BY(Locks::alloc_tracker_lock_);
 
   void SetMaxStackDepth(size_t max_stack_depth) REQUIRES(Locks::alloc_tracker_lock_);
+  void SetSampleIntervalBytes(size_t bytes) REQUIRES(Locks::alloc_tracker_lock_);
 };
 
 }  // namespace gc
@@ -80,6 +80,9 @@ ConcurrentCopying::ConcurrentCopying(Heap* heap,
       gc_mark_stack_(accounting::ObjectStack::Create("concurrent copying gc mark stack",
                                                      kDefaultGcMarkStackSize,
                                                      kDefaultGcMarkStackSize)),
+      gc_drain_stack_(accounting::ObjectStack::Create("concurrent copying gc drain stack",
+                                                      kDefaultGcMarkStackSize,
+                                                      kDefaultGcMarkStackSize)),
       use_generational_cc_(use_generational_cc),
       young_gen_(young_gen),
       rb_mark_bit_stack_(accounting::ObjectStack::Create("rb copying gc mark stack",
@@ -2114,23 +2117,24 @@ bool ConcurrentCopying::ProcessMarkStackOnce() {
       CHECK_EQ(pooled_mark_stacks_.size(), kMarkStackPoolSize);
     }
     while (true) {
-      std::vector<mirror::Object*> refs;
       {
-        // Copy refs with lock. Note the number of refs should be small.
+        // Swap the shared stack for the empty drain stack with the lock held, so the lock is
+        // held for O(1) time instead of copying out every ref while mutators wait to push.
         MutexLock mu(thread_running_gc_, mark_stack_lock_);
         if (gc_mark_stack_->IsEmpty()) {
           break;
         }
-        for (StackReference<mirror::Object>* p = gc_mark_stack_->Begin();
-             p != gc_mark_stack_->End(); ++p) {
-          refs.push_back(p->AsMirrorPtr());
-        }
-        gc_mark_stack_->Reset();
+        DCHECK(gc_drain_stack_->IsEmpty());
+        std::swap(gc_mark_stack_, gc_drain_stack_);
       }
-      for (mirror::Object* ref : refs) {
-        ProcessMarkStackRef(ref);
+      // Process the drained refs without the lock. Newly pushed refs go to the (now empty)
+      // shared stack and are picked up on the next iteration.
+      for (StackReference<mirror::Object>* p = gc_drain_stack_->Begin();
+           p != gc_drain_stack_->End(); ++p) {
+        ProcessMarkStackRef(p->AsMirrorPtr());
         ++count;
       }
+      gc_drain_stack_->Reset();
     }
   } else {
     CHECK_EQ(static_cast<uint32_t>(mark_stack_mode),
@@ -2182,8 +2186,12 @@ size_t ConcurrentCopying::ProcessThreadLocalMarkStacks(bool disable_weak_ref_acc
       processor(to_ref);
       ++count;
     }
-    {
-      MutexLock mu(thread_running_gc_, mark_stack_lock_);
+  }
+  // Return the drained stacks to the pool with a single lock acquisition instead of one
+  // acquisition per stack.
+  {
+    MutexLock mu(thread_running_gc_, mark_stack_lock_);
+    for (accounting::AtomicStack<mirror::Object>* mark_stack : mark_stacks) {
       if (pooled_mark_stacks_.size() >= kMarkStackPoolSize) {
         // The pool has enough. Delete it.
         delete mark_stack;
@@ -333,6 +333,10 @@ class ConcurrentCopying : public GarbageCollector {
   space::RegionSpace* region_space_;      // The underlying region space.
   std::unique_ptr<Barrier> gc_barrier_;
   std::unique_ptr<accounting::ObjectStack> gc_mark_stack_;
+  // Empty stack that gc_mark_stack_ is swapped with under mark_stack_lock_ when draining the
+  // shared mark stack mode, so mutators pushing refs only contend with an O(1) swap instead of
+  // an O(n) copy of the stack contents. Only accessed by the thread running the GC.
+  std::unique_ptr<accounting::ObjectStack> gc_drain_stack_;
 
   // If true, enable generational collection when using the Concurrent Copying
   // (CC) collector, i.e. use sticky-bit CC for minor collections and (full) CC
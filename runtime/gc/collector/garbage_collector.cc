@@ -271,6 +271,18 @@ uint64_t GarbageCollector::GetTotalPausedTimeNs() {
   return pause_histogram_.AdjustedSum();
 }
 
+uint64_t GarbageCollector::GetPausePercentileNs(double percentile) {
+  MutexLock mu(Thread::Current(), pause_histogram_lock_);
+  if (pause_histogram_.SampleSize() == 0) {
+    return 0;
+  }
+  Histogram<uint64_t>::CumulativeData cumulative_data;
+  pause_histogram_.CreateHistogram(&cumulative_data);
+  // The pause histogram stores adjusted (microsecond) values; convert back to nanoseconds.
+  return static_cast<uint64_t>(
+      pause_histogram_.Percentile(percentile, cumulative_data) * pause_histogram_.AdjustFactor());
+}
+
 void GarbageCollector::DumpPerformanceInfo(std::ostream& os) {
   const CumulativeLogger& logger = GetCumulativeTimings();
   const size_t iterations = logger.GetIterations();
@@ -288,6 +300,16 @@ void GarbageCollector::DumpPerformanceInfo(std::ostream& os) {
       Histogram<uint64_t>::CumulativeData cumulative_data;
       pause_histogram_.CreateHistogram(&cumulative_data);
       pause_histogram_.PrintConfidenceIntervals(os, 0.99, cumulative_data);
+      os << GetName() << " pause percentiles: p50="
+         << PrettyDuration(pause_histogram_.Percentile(0.50, cumulative_data) *
+                           pause_histogram_.AdjustFactor())
+         << " p90="
+         << PrettyDuration(pause_histogram_.Percentile(0.90, cumulative_data) *
+                           pause_histogram_.AdjustFactor())
+         << " p99="
+         << PrettyDuration(pause_histogram_.Percentile(0.99, cumulative_data) *
+                           pause_histogram_.AdjustFactor())
+         << "\n";
     }
   }
 #if defined(__linux__)
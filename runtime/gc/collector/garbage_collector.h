@@ -85,6 +85,10 @@ class GarbageCollector : public RootVisitor, public IsMarkedVisitor, public Mark
     return total_thread_cpu_time_ns_;
   }
   uint64_t GetTotalPausedTimeNs() REQUIRES(!pause_histogram_lock_);
+  // Returns the given percentile (in [0.0, 1.0]) of the recorded GC pause times in
+  // nanoseconds, or 0 if no pauses have been recorded yet. Used by the runtime stats surface
+  // in addition to the textual dump.
+  uint64_t GetPausePercentileNs(double percentile) REQUIRES(!pause_histogram_lock_);
   int64_t GetTotalFreedBytes() const {
     return total_freed_bytes_;
   }
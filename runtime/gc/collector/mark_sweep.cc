@@ -53,6 +53,18 @@ namespace collector {
 // Performance options.
 static constexpr bool kUseRecursiveMark = false;
 static constexpr bool kUseMarkStackPrefetch = true;
+// Depth of the software-pipelined prefetch FIFO used when draining mark stacks. Objects are
+// prefetched when pushed onto the FIFO and only scanned that many pops later, which gives the
+// prefetch enough distance to cover the miss latency of pointer chasing through the object
+// graph.
+static constexpr size_t kMarkStackPrefetchFifoSize = 8;
+// Issues prefetches for the first two cache lines of an about-to-be-scanned object; reference
+// arrays and larger instances are read past the first line by the scan visitor.
+static inline void PrefetchObjectForScan(mirror::Object* obj) {
+  const uint8_t* addr = reinterpret_cast<const uint8_t*>(obj);
+  __builtin_prefetch(addr);
+  __builtin_prefetch(addr + 64);
+}
 static constexpr size_t kSweepArrayChunkFreeSize = 1024;
 static constexpr bool kPreCleanCards = true;
 
@@ -797,16 +809,14 @@ class MarkSweep::MarkStackTask : public Task {
       REQUIRES(Locks::heap_bitmap_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_) {
     ScanObjectParallelVisitor visitor(this);
-    // TODO: Tune this.
-    static const size_t kFifoSize = 4;
-    BoundedFifoPowerOfTwo<mirror::Object*, kFifoSize> prefetch_fifo;
+    BoundedFifoPowerOfTwo<mirror::Object*, kMarkStackPrefetchFifoSize> prefetch_fifo;
     for (;;) {
       mirror::Object* obj = nullptr;
       if (kUseMarkStackPrefetch) {
-        while (mark_stack_pos_ != 0 && prefetch_fifo.size() < kFifoSize) {
+        while (mark_stack_pos_ != 0 && prefetch_fifo.size() < kMarkStackPrefetchFifoSize) {
           mirror::Object* const mark_stack_obj = mark_stack_[--mark_stack_pos_].AsMirrorPtr();
           DCHECK(mark_stack_obj != nullptr);
-          __builtin_prefetch(mark_stack_obj);
+          PrefetchObjectForScan(mark_stack_obj);
           prefetch_fifo.push_back(mark_stack_obj);
         }
         if (UNLIKELY(prefetch_fifo.empty())) {
@@ -1419,16 +1429,14 @@ void MarkSweep::ProcessMarkStack(bool paused) {
       mark_stack_->Size() >= kMinimumParallelMarkStackSize) {
     ProcessMarkStackParallel(thread_count);
   } else {
-    // TODO: Tune this.
-    static const size_t kFifoSize = 4;
-    BoundedFifoPowerOfTwo<mirror::Object*, kFifoSize> prefetch_fifo;
+    BoundedFifoPowerOfTwo<mirror::Object*, kMarkStackPrefetchFifoSize> prefetch_fifo;
     for (;;) {
       mirror::Object* obj = nullptr;
       if (kUseMarkStackPrefetch) {
-        while (!mark_stack_->IsEmpty() && prefetch_fifo.size() < kFifoSize) {
+        while (!mark_stack_->IsEmpty() && prefetch_fifo.size() < kMarkStackPrefetchFifoSize) {
           mirror::Object* mark_stack_obj = mark_stack_->PopBack();
           DCHECK(mark_stack_obj != nullptr);
-          __builtin_prefetch(mark_stack_obj);
+          PrefetchObjectForScan(mark_stack_obj);
           prefetch_fifo.push_back(mark_stack_obj);
         }
         if (prefetch_fifo.empty()) {
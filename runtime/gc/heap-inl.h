@@ -104,6 +104,21 @@ inline mirror::Object* Heap::AllocObjectWithAllocator(Thread* self,
       // fragmentation.
       pre_object_allocated();
     }
+    if (kCheckLargeObject &&
+        allocator != kAllocatorTypeNonMoving &&
+        UNLIKELY(ShouldAllocPinnedArray(klass, byte_count))) {
+      // AllocPinnedArray can suspend and will recall PreObjectAllocated if needed.
+      ScopedAllowThreadSuspension ats;
+      obj = AllocPinnedArray<kInstrumented, PreFenceVisitor>(self, &klass, byte_count,
+                                                             pre_fence_visitor);
+      if (obj != nullptr) {
+        return obj.Ptr();
+      }
+      // The non-moving space is full; clear the OOM exception and fall through to allocate a
+      // movable array, which merely costs JNI a copy again.
+      self->ClearException();
+      pre_object_allocated();
+    }
     if (IsTLABAllocator(allocator)) {
       byte_count = RoundUp(byte_count, space::BumpPointerSpace::kAlignment);
     }
@@ -184,6 +199,8 @@ inline mirror::Object* Heap::AllocObjectWithAllocator(Thread* self,
         size_t num_bytes_allocated_before =
             num_bytes_allocated_.fetch_add(bytes_tl_bulk_allocated, std::memory_order_relaxed);
         new_num_bytes_allocated = num_bytes_allocated_before + bytes_tl_bulk_allocated;
+        total_bytes_allocated_by_allocator_[allocator].fetch_add(bytes_tl_bulk_allocated,
+                                                                 std::memory_order_relaxed);
         // Only trace when we get an increase in the number of bytes allocated. This happens when
         // obtaining a new TLAB and isn't often enough to hurt performance according to golem.
         if (region_space_) {
@@ -280,6 +297,18 @@ inline mirror::Object* Heap::AllocLargeObject(Thread* self,
                                                                          pre_fence_visitor);
 }
 
+template <bool kInstrumented, typename PreFenceVisitor>
+inline mirror::Object* Heap::AllocPinnedArray(Thread* self,
+                                              ObjPtr<mirror::Class>* klass,
+                                              size_t byte_count,
+                                              const PreFenceVisitor& pre_fence_visitor) {
+  // Save and restore the class in case it moves.
+  StackHandleScope<1> hs(self);
+  auto klass_wrapper = hs.NewHandleWrapper(klass);
+  return AllocObjectWithAllocator<kInstrumented, false, PreFenceVisitor>(
+      self, *klass, byte_count, GetCurrentNonMovingAllocator(), pre_fence_visitor);
+}
+
 template <const bool kInstrumented, const bool kGrow>
 inline mirror::Object* Heap::TryToAllocate(Thread* self,
                                            AllocatorType allocator_type,
@@ -426,6 +455,14 @@ inline bool Heap::ShouldAllocLargeObject(ObjPtr<mirror::Class> c, size_t byte_co
   return byte_count >= large_object_threshold_ && (c->IsPrimitiveArray() || c->IsStringClass());
 }
 
+inline bool Heap::ShouldAllocPinnedArray(ObjPtr<mirror::Class> c, size_t byte_count) const {
+  // Primitive arrays that JNI has been observed copying are allocated non-movable so that
+  // Get<Type>ArrayElements can hand out the array data directly. The threshold starts out
+  // disabled and is lowered by NotifyJniArrayElementsCopied().
+  size_t threshold = jni_pinned_array_threshold_.load(std::memory_order_relaxed);
+  return UNLIKELY(byte_count >= threshold) && c->IsPrimitiveArray();
+}
+
 inline bool Heap::IsOutOfMemoryOnAllocation(AllocatorType allocator_type,
                                             size_t alloc_size,
                                             bool grow) {
@@ -144,6 +144,20 @@ static constexpr bool kDumpRosAllocStatsOnSigQuit = false;
 
 static const char* kRegionSpaceName = "main space (region space)";
 
+std::ostream& operator<<(std::ostream& os, const AllocatorType& rhs) {
+  switch (rhs) {
+    case kAllocatorTypeBumpPointer: return os << "BumpPointer";
+    case kAllocatorTypeTLAB: return os << "TLAB";
+    case kAllocatorTypeRosAlloc: return os << "RosAlloc";
+    case kAllocatorTypeDlMalloc: return os << "DlMalloc";
+    case kAllocatorTypeNonMoving: return os << "NonMoving";
+    case kAllocatorTypeLOS: return os << "LargeObject";
+    case kAllocatorTypeRegion: return os << "Region";
+    case kAllocatorTypeRegionTLAB: return os << "RegionTLAB";
+  }
+  return os << "AllocatorType[" << static_cast<int>(rhs) << "]";
+}
+
 // If true, we log all GCs in the both the foreground and background. Used for debugging.
 static constexpr bool kLogAllGCs = false;
 
@@ -268,6 +282,7 @@ Heap::Heap(size_t initial_size,
       zygote_creation_lock_("zygote creation lock", kZygoteCreationLock),
       zygote_space_(nullptr),
       large_object_threshold_(large_object_threshold),
+      jni_pinned_array_threshold_(std::numeric_limits<size_t>::max()),
       disable_thread_flip_count_(0),
       thread_flip_running_(false),
       collector_type_running_(kCollectorTypeNone),
@@ -289,6 +304,7 @@ Heap::Heap(size_t initial_size,
       native_bytes_registered_(0),
       old_native_bytes_allocated_(0),
       native_objects_notified_(0),
+      native_urgency_ewma_(0.0f),
       num_bytes_freed_revoke_(0),
       verify_missing_card_marks_(false),
       verify_system_weaks_(false),
@@ -319,6 +335,7 @@ Heap::Heap(size_t initial_size,
       foreground_heap_growth_multiplier_(foreground_heap_growth_multiplier),
       stop_for_native_allocs_(stop_for_native_allocs),
       total_wait_time_(0),
+      total_cleared_references_(0),
       verify_object_mode_(kVerifyObjectModeDisabled),
       disable_moving_gc_count_(0),
       semi_space_collector_(nullptr),
@@ -345,8 +362,10 @@ Heap::Heap(size_t initial_size,
       gc_count_rate_histogram_("gc count rate histogram", 1U, kGcCountRateMaxBucketCount),
       blocking_gc_count_rate_histogram_("blocking gc count rate histogram", 1U,
                                         kGcCountRateMaxBucketCount),
+      gc_phase_hint_(GcPhaseHint::kNone),
       alloc_tracking_enabled_(false),
       alloc_record_depth_(AllocRecordObjectMap::kDefaultAllocStackDepth),
+      alloc_tracker_sample_interval_(0u),
       backtrace_lock_(nullptr),
       seen_backtrace_count_(0u),
       unique_backtrace_count_(0u),
@@ -1008,10 +1027,32 @@ void Heap::UpdateProcessState(ProcessState old_process_state, ProcessState new_p
   }
 }
 
+void Heap::NotifyGcPhaseHint(GcPhaseHint hint) {
+  gc_phase_hint_.store(hint, std::memory_order_relaxed);
+  switch (hint) {
+    case GcPhaseHint::kLatencyCritical:
+      // Same immediate response as becoming jank perceptible: make sure the foreground collector
+      // is active and grow the heap so allocation does not run into a blocking GC mid-phase.
+      RequestCollectorTransition(foreground_collector_type_, 0);
+      GrowHeapOnJankPerceptibleSwitch();
+      break;
+    case GcPhaseHint::kIdleCompaction:
+      // Compact right away. For kCollectorTypeCC and kCollectorTypeHomogeneousSpaceCompact
+      // backgrounds this performs a full compaction without transitioning the collector, see
+      // UpdateProcessState.
+      RequestCollectorTransition(background_collector_type_, 0);
+      break;
+    case GcPhaseHint::kNone:
+    case GcPhaseHint::kThroughput:
+      // Nothing immediate; the regular heuristics apply from here on.
+      break;
+  }
+}
+
 void Heap::CreateThreadPool() {
   const size_t num_threads = std::max(parallel_gc_threads_, conc_gc_threads_);
   if (num_threads != 0) {
-    thread_pool_.reset(new ThreadPool("Heap thread pool", num_threads));
+    thread_pool_.reset(new WorkStealingThreadPool("Heap thread pool", num_threads));
   }
 }
 
@@ -1161,6 +1202,13 @@ void Heap::DumpGcPerformanceInfo(std::ostream& os) {
   uint64_t total_objects_allocated = GetObjectsAllocatedEver();
   os << "Total number of allocations " << total_objects_allocated << "\n";
   os << "Total bytes allocated " << PrettySize(GetBytesAllocatedEver()) << "\n";
+  for (size_t i = 0; i <= kAllocatorTypeRegionTLAB; ++i) {
+    const AllocatorType allocator = static_cast<AllocatorType>(i);
+    const uint64_t bytes = GetBytesAllocatedEverForAllocator(allocator);
+    if (bytes != 0u) {
+      os << "Total bytes allocated by " << allocator << " " << PrettySize(bytes) << "\n";
+    }
+  }
   os << "Total bytes freed " << PrettySize(GetBytesFreedEver()) << "\n";
   os << "Free memory " << PrettySize(GetFreeMemory()) << "\n";
   os << "Free memory until GC " << PrettySize(GetFreeMemoryUntilGC()) << "\n";
@@ -1176,6 +1224,8 @@ void Heap::DumpGcPerformanceInfo(std::ostream& os) {
   os << "Total GC time: " << PrettyDuration(GetGcTime()) << "\n";
   os << "Total blocking GC count: " << GetBlockingGcCount() << "\n";
   os << "Total blocking GC time: " << PrettyDuration(GetBlockingGcTime()) << "\n";
+  os << "Total references enqueued to reference queue daemons: "
+     << GetTotalClearedReferences() << "\n";
 
   {
     MutexLock mu(Thread::Current(), *gc_complete_lock_);
@@ -1443,6 +1493,9 @@ void Heap::Trim(Thread* self) {
   TrimSpaces(self);
   // Trim arenas that may have been used by JIT or verifier.
   runtime->GetArenaPool()->TrimMaps();
+  // The JIT keeps its compiler metadata arenas in a separate pool; trim those too so
+  // that arenas retained after a compilation burst do not hold on to their pages.
+  runtime->GetJitArenaPool()->TrimMaps();
 }
 
 class TrimIndirectReferenceTableClosure : public Closure {
@@ -3201,12 +3254,13 @@ void Heap::SwapStacks() {
 void Heap::RevokeAllThreadLocalAllocationStacks(Thread* self) {
   // This must be called only during the pause.
   DCHECK(Locks::mutator_lock_->IsExclusiveHeld(self));
+  // Holding the shutdown lock blocks Register() and the suspend-all pause blocks Unregister(),
+  // so the thread list cannot change and we do not need to copy it under thread_list_lock_ in
+  // every GC cycle.
   MutexLock mu(self, *Locks::runtime_shutdown_lock_);
-  MutexLock mu2(self, *Locks::thread_list_lock_);
-  std::list<Thread*> thread_list = Runtime::Current()->GetThreadList()->GetList();
-  for (Thread* t : thread_list) {
+  Runtime::Current()->GetThreadList()->ForEachThreadDuringSuspendAll([](Thread* t) {
     t->RevokeThreadLocalAllocationStack();
-  }
+  });
 }
 
 void Heap::AssertThreadLocalBuffersAreRevoked(Thread* thread) {
@@ -3482,6 +3536,20 @@ void Heap::SetIdealFootprint(size_t target_footprint) {
   target_footprint_.store(target_footprint, std::memory_order_relaxed);
 }
 
+void Heap::NotifyJniArrayElementsCopied(size_t byte_count) {
+  if (byte_count < kMinJniPinnedArrayThreshold || !IsMovingGc(foreground_collector_type_)) {
+    // Small copies are cheap, and without a moving collector arrays never need pinning.
+    return;
+  }
+  // Lower the pinning threshold to the smallest array JNI has copied so far.
+  size_t old_threshold = jni_pinned_array_threshold_.load(std::memory_order_relaxed);
+  while (old_threshold > byte_count &&
+         !jni_pinned_array_threshold_.compare_exchange_weak(old_threshold,
+                                                            byte_count,
+                                                            std::memory_order_relaxed)) {
+  }
+}
+
 bool Heap::IsMovableObject(ObjPtr<mirror::Object> obj) const {
   if (kMovingCollector) {
     space::Space* space = FindContinuousSpaceFromObject(obj.Ptr(), true);
@@ -3719,6 +3787,13 @@ void Heap::ConcurrentGC(Thread* self, GcCause cause, bool force_full) {
       // If forcing full and next gc type is sticky, override with a non-sticky type.
       if (force_full && next_gc_type == collector::kGcTypeSticky) {
         next_gc_type = NonStickyGcType();
+      } else if (GetGcPhaseHint() == GcPhaseHint::kLatencyCritical &&
+                 !gc_plan_.empty() &&
+                 gc_plan_[0] == collector::kGcTypeSticky) {
+        // A latency-critical phase prefers the cheap sticky collection even when the heuristics
+        // scheduled a larger one; the deferred work runs once the phase hint changes. If the
+        // sticky collection cannot reclaim enough, the fallback loop below still escalates.
+        next_gc_type = collector::kGcTypeSticky;
       }
       if (CollectGarbageInternal(next_gc_type, cause, false) == collector::kGcTypeNone) {
         for (collector::GcType gc_type : gc_plan_) {
@@ -3820,6 +3895,22 @@ void Heap::RequestTrim(Thread* self) {
   task_processor_->AddTask(self, added_task);
 }
 
+void Heap::RecordClearedReferences(Thread* self, size_t count) {
+  total_cleared_references_.fetch_add(count, std::memory_order_relaxed);
+  if (count >= kMinClearedReferencesForGcBoost &&
+      IsGcConcurrent() &&
+      CanAddHeapTask(self) &&
+      concurrent_gc_pending_.CompareAndSetStrongSequentiallyConsistent(false, true)) {
+    // A large batch was just handed to the daemons. Objects they finalize stay reachable
+    // until a later collection observes the cleared sentinels, so schedule a follow-up
+    // full collection, delayed to give the daemons time to drain their queues.
+    VLOG(gc) << "Scheduling follow-up GC for finalizer backlog of " << count << " references";
+    task_processor_->AddTask(self, new ConcurrentGCTask(NanoTime() + kFinalizerBacklogGcWait,
+                                                        kGcCauseBackground,
+                                                        /*force_full=*/ true));
+  }
+}
+
 void Heap::IncrementNumberOfBytesFreedRevoke(size_t freed_bytes_revoke) {
   size_t previous_num_bytes_freed_revoke =
       num_bytes_freed_revoke_.fetch_add(freed_bytes_revoke, std::memory_order_relaxed);
@@ -3894,6 +3985,15 @@ static constexpr size_t kNewNativeDiscountFactor = 2;
 // running out of memory.
 static constexpr float kStopForNativeFactor = 4.0;
 
+// If the smoothed urgency exceeds this, native pressure has been sustained across several
+// checks and the requested concurrent collection is escalated from the default (typically
+// sticky) to a full one.
+static constexpr float kFullGcForNativeFactor = 2.0;
+
+// Weight divisor for the exponentially-weighted urgency average: each check moves the
+// average 1/4 of the way towards the instantaneous urgency.
+static constexpr float kNativeUrgencyEwmaDivisor = 4.0;
+
 // Return the ratio of the weighted native + java allocated bytes to its target value.
 // A return value > 1.0 means we should collect. Significantly larger values mean we're falling
 // behind.
@@ -3928,9 +4028,18 @@ inline void Heap::CheckGCForNative(Thread* self) {
   bool is_gc_concurrent = IsGcConcurrent();
   size_t current_native_bytes = GetNativeBytes();
   float gc_urgency = NativeMemoryOverTarget(current_native_bytes, is_gc_concurrent);
+  // Fold the instantaneous urgency into the exponentially-weighted average.
+  float smoothed_urgency = native_urgency_ewma_.load(std::memory_order_relaxed);
+  smoothed_urgency += (gc_urgency - smoothed_urgency) / kNativeUrgencyEwmaDivisor;
+  native_urgency_ewma_.store(smoothed_urgency, std::memory_order_relaxed);
   if (UNLIKELY(gc_urgency >= 1.0)) {
     if (is_gc_concurrent) {
-      RequestConcurrentGC(self, kGcCauseForNativeAlloc, /*force_full=*/true);
+      // Respond proportionally: a transient burst gets the collection the GC would run
+      // next anyway (typically sticky), while pressure sustained long enough to lift the
+      // smoothed urgency escalates to a full collection. The emergency stop below still
+      // acts on the instantaneous urgency.
+      bool force_full = smoothed_urgency >= kFullGcForNativeFactor;
+      RequestConcurrentGC(self, kGcCauseForNativeAlloc, force_full);
       if (gc_urgency > kStopForNativeFactor
           && current_native_bytes > stop_for_native_allocs_) {
         // We're in danger of running out of memory due to rampant native allocation.
@@ -4166,6 +4275,30 @@ void Heap::RemoveGcPauseListener() {
   gc_pause_listener_.store(nullptr, std::memory_order_relaxed);
 }
 
+size_t Heap::ComputeTunedTlabSize(Thread* self) {
+  const uint64_t now = NanoTime();
+  const uint64_t last_refill = self->GetLastTlabRefillNs();
+  self->SetLastTlabRefillNs(now);
+  size_t tlab_size = self->GetNextTlabSize();
+  if (tlab_size == 0) {
+    // First refill for this thread, start from the default size.
+    self->SetNextTlabSize(kDefaultTLABSize);
+    return kDefaultTLABSize;
+  }
+  const uint64_t refill_interval = now - last_refill;
+  if (refill_interval < kTLABRefillFastThreshold) {
+    // The thread is allocating fast; give it a bigger TLAB so it takes the slow path less
+    // often.
+    tlab_size = std::min(tlab_size * 2, kMaxTLABSize);
+  } else if (refill_interval > kTLABRefillSlowThreshold) {
+    // The thread allocates rarely; shrink its TLAB to reduce fragmentation from unused
+    // buffer tails at GC time.
+    tlab_size = std::max(tlab_size / 2, kMinTLABSize);
+  }
+  self->SetNextTlabSize(tlab_size);
+  return tlab_size;
+}
+
 mirror::Object* Heap::AllocWithNewTLAB(Thread* self,
                                        size_t alloc_size,
                                        bool grow,
@@ -4189,7 +4322,7 @@ mirror::Object* Heap::AllocWithNewTLAB(Thread* self,
     DCHECK_LE(alloc_size, self->TlabSize());
   } else if (allocator_type == kAllocatorTypeTLAB) {
     DCHECK(bump_pointer_space_ != nullptr);
-    const size_t new_tlab_size = alloc_size + kDefaultTLABSize;
+    const size_t new_tlab_size = alloc_size + ComputeTunedTlabSize(self);
     if (UNLIKELY(IsOutOfMemoryOnAllocation(allocator_type, new_tlab_size, grow))) {
       return nullptr;
     }
@@ -121,6 +121,20 @@ enum HomogeneousSpaceCompactResult {
   kErrorVMShuttingDown,
 };
 
+// Application-provided GC phase hints, finer grained than the binary jank
+// perceptible/imperceptible process state. See Heap::NotifyGcPhaseHint.
+enum class GcPhaseHint {
+  // No hint; use the regular process-state driven heuristics.
+  kNone,
+  // A latency-critical phase (e.g. scrolling): prefer cheap sticky collections and give the heap
+  // headroom so allocation does not run into a blocking GC mid-phase.
+  kLatencyCritical,
+  // A throughput phase (e.g. bulk background work): run whatever collection the heuristics pick.
+  kThroughput,
+  // An idle phase: compact now, like a background collector transition.
+  kIdleCompaction,
+};
+
 // If true, use rosalloc/RosAllocSpace instead of dlmalloc/DlMallocSpace
 static constexpr bool kUseRosAlloc = true;
 
@@ -142,11 +156,22 @@ class Heap {
   static constexpr size_t kDefaultLongPauseLogThreshold = MsToNs(5);
   static constexpr size_t kDefaultLongGCLogThreshold = MsToNs(100);
   static constexpr size_t kDefaultTLABSize = 32 * KB;
+  // Bounds for the per-thread TLAB size auto-tuning in AllocWithNewTLAB. A thread that
+  // exhausts its TLAB within kTLABRefillFastThreshold gets a doubled TLAB (up to
+  // kMaxTLABSize), one that takes longer than kTLABRefillSlowThreshold gets a halved one
+  // (down to kMinTLABSize).
+  static constexpr size_t kMinTLABSize = 8 * KB;
+  static constexpr size_t kMaxTLABSize = 256 * KB;
+  static constexpr uint64_t kTLABRefillFastThreshold = MsToNs(1);
+  static constexpr uint64_t kTLABRefillSlowThreshold = MsToNs(100);
   static constexpr double kDefaultTargetUtilization = 0.75;
   static constexpr double kDefaultHeapGrowthMultiplier = 2.0;
   // Primitive arrays larger than this size are put in the large object space.
   static constexpr size_t kMinLargeObjectThreshold = 3 * kPageSize;
   static constexpr size_t kDefaultLargeObjectThreshold = kMinLargeObjectThreshold;
+  // Smallest JNI element copy that may cause subsequent primitive arrays of the same size to be
+  // allocated in the non-moving space; smaller copies are cheaper than fragmenting that space.
+  static constexpr size_t kMinJniPinnedArrayThreshold = 64 * KB;
   // Whether or not parallel GC is enabled. If not, then we never create the thread pool.
   static constexpr bool kDefaultEnableParallelGC = false;
   static uint8_t* const kPreferredAllocSpaceBegin;
@@ -178,6 +203,14 @@ class Heap {
 
   // How often we allow heap trimming to happen (nanoseconds).
   static constexpr uint64_t kHeapTrimWait = MsToNs(5000);
+  // Number of cleared references handed to the reference queue daemons by a single
+  // collection above which we schedule a follow-up collection: finalized objects stay
+  // reachable until a later collection observes their cleared sentinels, so a heavy
+  // finalizer backlog retains memory for a full GC period otherwise.
+  static constexpr size_t kMinClearedReferencesForGcBoost = 4096;
+  // How long to wait before the follow-up collection, giving the daemons time to drain
+  // their queues (nanoseconds).
+  static constexpr uint64_t kFinalizerBacklogGcWait = MsToNs(2000);
   // How long we wait after a transition request to perform a collector transition (nanoseconds).
   static constexpr uint64_t kCollectorTransitionWait = MsToNs(5000);
   // Whether the transition-wait applies or not. Zero wait will stress the
@@ -301,6 +334,11 @@ class Heap {
   void CheckPreconditionsForAllocObject(ObjPtr<mirror::Class> c, size_t byte_count)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Called by JNI when Get<Type>ArrayElements has to copy the elements of a movable primitive
+  // array out of the heap. Lowers the threshold above which future primitive arrays are allocated
+  // in the non-moving space, so equally large arrays can be handed out without copy-in/copy-out.
+  void NotifyJniArrayElementsCopied(size_t byte_count);
+
   // Inform the garbage collector of a non-malloc allocated native memory that might become
   // reclaimable in the future as a result of Java garbage collection.
   void RegisterNativeAllocation(JNIEnv* env, size_t bytes)
@@ -475,6 +513,17 @@ class Heap {
   void UpdateProcessState(ProcessState old_process_state, ProcessState new_process_state)
       REQUIRES(!*pending_task_lock_, !*gc_complete_lock_, !process_state_update_lock_);
 
+  // Record an application phase hint and react to it right away: latency-critical phases get the
+  // jank-perceptible treatment (foreground collector, grown heap), idle phases trigger a
+  // background-style compaction. The hint also biases concurrent GC scheduling until it is
+  // replaced, see ConcurrentGC. Hints refine rather than replace the process state heuristics.
+  void NotifyGcPhaseHint(GcPhaseHint hint)
+      REQUIRES(!*pending_task_lock_, !*gc_complete_lock_, !process_state_update_lock_);
+
+  GcPhaseHint GetGcPhaseHint() const {
+    return gc_phase_hint_.load(std::memory_order_relaxed);
+  }
+
   bool HaveContinuousSpaces() const NO_THREAD_SAFETY_ANALYSIS {
     // No lock since vector empty is thread safe.
     return !continuous_spaces_.empty();
@@ -530,6 +579,17 @@ class Heap {
   // Record the bytes freed by thread-local buffer revoke.
   void RecordFreeRevoke();
 
+  // Record how many cleared references a collection handed to the reference queue
+  // daemons. Schedules a delayed follow-up collection when the batch is large enough
+  // that the finalizer daemon will measurably lag behind.
+  void RecordClearedReferences(Thread* self, size_t count)
+      REQUIRES(!*pending_task_lock_);
+
+  // Total number of cleared references handed to the reference queue daemons.
+  uint64_t GetTotalClearedReferences() const {
+    return total_cleared_references_.load(std::memory_order_relaxed);
+  }
+
   accounting::CardTable* GetCardTable() const {
     return card_table_.get();
   }
@@ -560,6 +620,14 @@ class Heap {
   // Returns the total number of bytes allocated since the heap was created.
   uint64_t GetBytesAllocatedEver() const;
 
+  // Monotonic count of bytes ever handed out by the given allocator (region, large object,
+  // non-moving, ...). A single relaxed atomic load, so this is safe for hot telemetry paths;
+  // the result is approximate while threads are allocating since TLAB allocators account whole
+  // TLABs when they are handed out.
+  uint64_t GetBytesAllocatedEverForAllocator(AllocatorType allocator) const {
+    return total_bytes_allocated_by_allocator_[allocator].load(std::memory_order_relaxed);
+  }
+
   // Returns the total number of objects freed since the heap was created.
   // With default memory order, this should be viewed only as a hint.
   uint64_t GetObjectsFreedEver(std::memory_order mo = std::memory_order_relaxed) const {
@@ -666,9 +734,10 @@ class Heap {
       REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(Locks::heap_bitmap_lock_);
 
-  // Revoke all the thread-local allocation stacks.
+  // Revoke all the thread-local allocation stacks. Does not need the thread list lock: the
+  // suspend-all pause and the runtime shutdown lock together keep the thread list stable.
   void RevokeAllThreadLocalAllocationStacks(Thread* self)
-      REQUIRES(Locks::mutator_lock_, !Locks::runtime_shutdown_lock_, !Locks::thread_list_lock_);
+      REQUIRES(Locks::mutator_lock_, !Locks::runtime_shutdown_lock_);
 
   // Mark all the objects in the allocation stack in the specified bitmap.
   // TODO: Refactor?
@@ -866,6 +935,16 @@ class Heap {
     alloc_record_depth_ = alloc_record_depth;
   }
 
+  // Average number of allocated bytes between two sampled allocation records, 0 to record every
+  // allocation. Applied the next time allocation tracking is enabled.
+  size_t GetAllocTrackerSampleInterval() const {
+    return alloc_tracker_sample_interval_;
+  }
+
+  void SetAllocTrackerSampleInterval(size_t bytes) {
+    alloc_tracker_sample_interval_ = bytes;
+  }
+
   AllocRecordObjectMap* GetAllocationRecords() const REQUIRES(Locks::alloc_tracker_lock_) {
     return allocation_records_.get();
   }
@@ -987,6 +1066,8 @@ class Heap {
   }
   bool ShouldAllocLargeObject(ObjPtr<mirror::Class> c, size_t byte_count) const
       REQUIRES_SHARED(Locks::mutator_lock_);
+  bool ShouldAllocPinnedArray(ObjPtr<mirror::Class> c, size_t byte_count) const
+      REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Checks whether we should garbage collect:
   ALWAYS_INLINE bool ShouldConcurrentGCForJava(size_t new_num_bytes_allocated);
@@ -1013,6 +1094,17 @@ class Heap {
       REQUIRES(!*gc_complete_lock_, !*pending_task_lock_,
                !*backtrace_lock_, !process_state_update_lock_);
 
+  // Allocates a primitive array in the non-moving space so its elements can be handed to JNI
+  // without copying. Slow path like AllocLargeObject; not force-inlined either.
+  template <bool kInstrumented, typename PreFenceVisitor>
+  mirror::Object* AllocPinnedArray(Thread* self,
+                                   ObjPtr<mirror::Class>* klass,
+                                   size_t byte_count,
+                                   const PreFenceVisitor& pre_fence_visitor)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!*gc_complete_lock_, !*pending_task_lock_,
+               !*backtrace_lock_, !process_state_update_lock_);
+
   // Handles Allocate()'s slow allocation path with GC involved after
   // an initial allocation attempt failed.
   mirror::Object* AllocateInternalWithGc(Thread* self,
@@ -1057,6 +1149,10 @@ class Heap {
                                    size_t* bytes_tl_bulk_allocated)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Returns the auto-tuned TLAB size for self based on how quickly the thread has been
+  // exhausting its previous TLABs, bounded by [kMinTLABSize, kMaxTLABSize].
+  size_t ComputeTunedTlabSize(Thread* self);
+
   void ThrowOutOfMemoryError(Thread* self, size_t byte_count, AllocatorType allocator_type)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -1313,6 +1409,11 @@ class Heap {
   // Minimum allocation size of large object.
   size_t large_object_threshold_;
 
+  // Primitive arrays at least this large are allocated in the non-moving space so their elements
+  // can be passed to JNI without copying. Starts out disabled (SIZE_MAX) and is lowered by
+  // NotifyJniArrayElementsCopied() when JNI actually copies an array of that size.
+  Atomic<size_t> jni_pinned_array_threshold_;
+
   // Guards access to the state of GC, associated conditional variable is used to signal when a GC
   // completes.
   Mutex* gc_complete_lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
@@ -1380,6 +1481,11 @@ class Heap {
   // TLABS in their entirety, even if they have not yet been parceled out.
   Atomic<size_t> num_bytes_allocated_;
 
+  // Monotonic number of bytes ever handed out by each allocator, bumped at the same TLAB-refill
+  // granularity as num_bytes_allocated_ so it stays off the per-object fast path. Always on,
+  // unlike the legacy RuntimeStats counters which are gated by -Xstats.
+  Atomic<uint64_t> total_bytes_allocated_by_allocator_[kAllocatorTypeRegionTLAB + 1] = {};
+
   // Number of registered native bytes allocated. Adjusted after each RegisterNativeAllocation and
   // RegisterNativeFree. Used to  help determine when to trigger GC for native allocations. Should
   // not include bytes allocated through the system malloc, since those are implicitly included.
@@ -1392,6 +1498,12 @@ class Heap {
   // Allows us to check for GC only roughly every kNotifyNativeInterval allocations.
   Atomic<uint32_t> native_objects_notified_;
 
+  // Exponentially-weighted average of the native GC urgency over recent CheckGCForNative
+  // calls. Distinguishes a transient allocation burst, which barely moves the average, from
+  // sustained native pressure, which warrants escalating to a full collection. Updated with
+  // a racy read-modify-write; a lost update only delays the average by one check.
+  Atomic<float> native_urgency_ewma_;
+
   // Number of bytes freed by thread local buffer revokes. This will
   // cancel out the ahead-of-time bulk counting of bytes allocated in
   // rosalloc thread-local buffers.  It is temporarily accumulated
@@ -1497,6 +1609,10 @@ class Heap {
   // Total time which mutators are paused or waiting for GC to complete.
   uint64_t total_wait_time_;
 
+  // Total number of cleared references handed to the reference queue daemons, so that
+  // finalizer daemon workload is visible in the GC performance dump.
+  Atomic<uint64_t> total_cleared_references_;
+
   // The current state of heap verification, may be enabled or disabled.
   VerifyObjectMode verify_object_mode_;
 
@@ -1573,10 +1689,14 @@ class Heap {
   // The histogram of the number of blocking GC invocations per window duration.
   Histogram<uint64_t> blocking_gc_count_rate_histogram_ GUARDED_BY(gc_complete_lock_);
 
+  // Last application phase hint, kNone when the application has not provided one.
+  std::atomic<GcPhaseHint> gc_phase_hint_;
+
   // Allocation tracking support
   Atomic<bool> alloc_tracking_enabled_;
   std::unique_ptr<AllocRecordObjectMap> allocation_records_;
   size_t alloc_record_depth_;
+  size_t alloc_tracker_sample_interval_;
 
   // GC stress related data structures.
   Mutex* backtrace_lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
@@ -16,12 +16,17 @@
 
 #include "reference_processor.h"
 
+#include <deque>
+#include <limits>
+
 #include "art_field-inl.h"
 #include "base/mutex.h"
 #include "base/time_utils.h"
 #include "base/utils.h"
 #include "class_root.h"
+#include "collector/concurrent_copying.h"
 #include "collector/garbage_collector.h"
+#include "heap.h"
 #include "jni/java_vm_ext.h"
 #include "mirror/class-inl.h"
 #include "mirror/object-inl.h"
@@ -39,6 +44,31 @@ namespace gc {
 
 static constexpr bool kAsyncReferenceQueueAdd = false;
 
+// Minimum number of references in a queue before sharding it across the GC thread pool pays for
+// the task setup and merge overhead.
+static constexpr size_t kMinRefsForParallelClearing = 512;
+
+class ClearWhiteReferencesTask : public Task {
+ public:
+  ClearWhiteReferencesTask(ReferenceQueue* shard,
+                           ReferenceQueue* cleared_out,
+                           collector::GarbageCollector* collector)
+      : shard_(shard), cleared_out_(cleared_out), collector_(collector) {}
+
+  void Run(Thread* self ATTRIBUTE_UNUSED) override NO_THREAD_SAFETY_ANALYSIS {
+    shard_->ClearWhiteReferences(cleared_out_, collector_);
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  ReferenceQueue* const shard_;
+  ReferenceQueue* const cleared_out_;
+  collector::GarbageCollector* const collector_;
+};
+
 ReferenceProcessor::ReferenceProcessor()
     : collector_(nullptr),
       preserving_references_(false),
@@ -110,7 +140,15 @@ ObjPtr<mirror::Object> ReferenceProcessor::GetReferent(Thread* self,
     }
     // Try to see if the referent is already marked by using the is_marked_callback. We can return
     // it to the mutator as long as the GC is not preserving references.
-    if (LIKELY(collector_ != nullptr)) {
+    collector::GarbageCollector* collector = collector_;
+    if (kUseReadBarrier && collector == nullptr) {
+      // Reference processing has not taken over yet, but weak ref access can only be
+      // disabled while the concurrent copying collector is finishing marking. Objects
+      // it has already marked have their liveness decided, so answer from its mark
+      // state instead of blocking until weak ref access is re-enabled.
+      collector = Runtime::Current()->GetHeap()->ConcurrentCopyingCollector();
+    }
+    if (LIKELY(collector != nullptr)) {
       // If it's null it means not marked, but it could become marked if the referent is reachable
       // by finalizer referents. So we cannot return in this case and must block. Otherwise, we
       // can return it to the mutator as long as the GC is not preserving references, in which
@@ -120,7 +158,7 @@ ObjPtr<mirror::Object> ReferenceProcessor::GetReferent(Thread* self,
       // Use the cached referent instead of calling GetReferent since other threads could call
       // Reference.clear() after we did the null check resulting in a null pointer being
       // incorrectly passed to IsMarked. b/33569625
-      ObjPtr<mirror::Object> forwarded_ref = collector_->IsMarked(referent.Ptr());
+      ObjPtr<mirror::Object> forwarded_ref = collector->IsMarked(referent.Ptr());
       if (forwarded_ref != nullptr) {
         // Non null means that it is marked.
         if (!preserving_references_ ||
@@ -149,6 +187,51 @@ void ReferenceProcessor::StopPreservingReferences(Thread* self) {
   condition_.Broadcast(self);
 }
 
+void ReferenceProcessor::ClearWhiteReferencesParallel(ReferenceQueue* queue,
+                                                      collector::GarbageCollector* collector,
+                                                      Thread* self) {
+  Heap* heap = Runtime::Current()->GetHeap();
+  ThreadPool* thread_pool = heap->GetThreadPool();
+  // Use less threads if we are in a background state (non jank perceptible) since we want to leave
+  // more CPU time for the foreground apps, matching MarkSweep::GetThreadCount.
+  const size_t thread_count =
+      (thread_pool == nullptr || !Runtime::Current()->InJankPerceptibleProcessState())
+          ? 1u
+          : heap->GetParallelGCThreadCount() + 1;
+  const size_t num_refs = queue->GetLength();
+  if (thread_count <= 1 || num_refs < kMinRefsForParallelClearing) {
+    queue->ClearWhiteReferences(&cleared_references_, collector);
+    return;
+  }
+  // Shard the queue across the workers. The shard queues are only touched by a single thread at a
+  // time so they do not need the enqueue lock.
+  std::deque<ReferenceQueue> shards;
+  std::deque<ReferenceQueue> cleared_shards;
+  for (size_t i = 0; i < thread_count; ++i) {
+    shards.emplace_back(nullptr);
+    cleared_shards.emplace_back(nullptr);
+  }
+  const size_t refs_per_shard = num_refs / thread_count + 1;
+  for (size_t i = 0; i < thread_count; ++i) {
+    queue->TransferReferences(&shards[i], refs_per_shard);
+  }
+  DCHECK(queue->IsEmpty());
+  for (size_t i = 0; i < thread_count; ++i) {
+    thread_pool->AddTask(self, new ClearWhiteReferencesTask(&shards[i],
+                                                            &cleared_shards[i],
+                                                            collector));
+  }
+  thread_pool->SetMaxActiveWorkers(thread_count - 1);
+  thread_pool->StartWorkers(self);
+  thread_pool->Wait(self, true, true);
+  thread_pool->StopWorkers(self);
+  // Merge the per-worker cleared queues into the shared cleared queue.
+  for (ReferenceQueue& cleared_shard : cleared_shards) {
+    cleared_shard.TransferReferences(&cleared_references_,
+                                     std::numeric_limits<size_t>::max());
+  }
+}
+
 // Process reference class instances and schedule finalizations.
 void ReferenceProcessor::ProcessReferences(bool concurrent,
                                            TimingLogger* timings,
@@ -190,8 +273,8 @@ void ReferenceProcessor::ProcessReferences(bool concurrent,
     }
   }
   // Clear all remaining soft and weak references with white referents.
-  soft_reference_queue_.ClearWhiteReferences(&cleared_references_, collector);
-  weak_reference_queue_.ClearWhiteReferences(&cleared_references_, collector);
+  ClearWhiteReferencesParallel(&soft_reference_queue_, collector, self);
+  ClearWhiteReferencesParallel(&weak_reference_queue_, collector, self);
   {
     TimingLogger::ScopedTiming t2(concurrent ? "EnqueueFinalizerReferences" :
         "(Paused)EnqueueFinalizerReferences", timings);
@@ -206,10 +289,10 @@ void ReferenceProcessor::ProcessReferences(bool concurrent,
     }
   }
   // Clear all finalizer referent reachable soft and weak references with white referents.
-  soft_reference_queue_.ClearWhiteReferences(&cleared_references_, collector);
-  weak_reference_queue_.ClearWhiteReferences(&cleared_references_, collector);
+  ClearWhiteReferencesParallel(&soft_reference_queue_, collector, self);
+  ClearWhiteReferencesParallel(&weak_reference_queue_, collector, self);
   // Clear all phantom references with white referents.
-  phantom_reference_queue_.ClearWhiteReferences(&cleared_references_, collector);
+  ClearWhiteReferencesParallel(&phantom_reference_queue_, collector, self);
   // At this point all reference queues other than the cleared references should be empty.
   DCHECK(soft_reference_queue_.IsEmpty());
   DCHECK(weak_reference_queue_.IsEmpty());
@@ -297,10 +380,12 @@ SelfDeletingTask* ReferenceProcessor::CollectClearedReferences(Thread* self) {
   std::unique_ptr<SelfDeletingTask> result(new FunctionTask([](Thread*) {}));
   // When a runtime isn't started there are no reference queues to care about so ignore.
   if (!cleared_references_.IsEmpty()) {
+    size_t count = 0;
     if (LIKELY(Runtime::Current()->IsStarted())) {
       jobject cleared_references;
       {
         ReaderMutexLock mu(self, *Locks::mutator_lock_);
+        count = cleared_references_.GetLength();
         cleared_references = self->GetJniEnv()->GetVm()->AddGlobalRef(
             self, cleared_references_.GetList());
       }
@@ -314,6 +399,11 @@ SelfDeletingTask* ReferenceProcessor::CollectClearedReferences(Thread* self) {
       }
     }
     cleared_references_.Clear();
+    if (count != 0u) {
+      // Let the heap know how much work was handed to the reference queue daemons so
+      // it can schedule a follow-up collection behind a heavy finalizer backlog.
+      Runtime::Current()->GetHeap()->RecordClearedReferences(self, count);
+    }
   }
   return result.release();
 }
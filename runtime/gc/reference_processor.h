@@ -81,6 +81,13 @@ class ReferenceProcessor {
 
  private:
   bool SlowPathEnabled() REQUIRES_SHARED(Locks::mutator_lock_);
+  // Clear white references in queue, sharding the work across the heap thread pool workers with
+  // per-worker output queues that get merged into cleared_references_ at the end. Falls back to
+  // the single threaded path when there is no thread pool or the queue is small.
+  void ClearWhiteReferencesParallel(ReferenceQueue* queue,
+                                    collector::GarbageCollector* collector,
+                                    Thread* self)
+      REQUIRES_SHARED(Locks::mutator_lock_);
   // Called by ProcessReferences.
   void DisableSlowPath(Thread* self) REQUIRES(Locks::reference_processor_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
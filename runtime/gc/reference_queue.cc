@@ -152,6 +152,18 @@ void ReferenceQueue::ClearWhiteReferences(ReferenceQueue* cleared_references,
   }
 }
 
+size_t ReferenceQueue::TransferReferences(ReferenceQueue* dest, size_t max_count) {
+  size_t count = 0;
+  while (count < max_count && !IsEmpty()) {
+    // DequeuePendingReference clears the pending next field, so the reference is unprocessed
+    // again and may be re-enqueued on the destination queue. The read barrier state is left
+    // untouched here; it is reset when the destination queue is drained.
+    dest->EnqueueReference(DequeuePendingReference());
+    ++count;
+  }
+  return count;
+}
+
 void ReferenceQueue::EnqueueFinalizerReferences(ReferenceQueue* cleared_references,
                                                 collector::GarbageCollector* collector) {
   while (!IsEmpty()) {
@@ -95,6 +95,12 @@ class ReferenceQueue {
                             collector::GarbageCollector* collector)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Move up to max_count references from this queue to dest. Used by the parallel reference
+  // processing mode to shard a queue across the GC thread pool workers. Not thread safe, only
+  // called while reference processing exclusively owns both queues.
+  size_t TransferReferences(ReferenceQueue* dest, size_t max_count)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   void Dump(std::ostream& os) const REQUIRES_SHARED(Locks::mutator_lock_);
   size_t GetLength() const REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -1424,6 +1424,14 @@ class ImageSpace::Loader {
       // Nothing to fix up.
       return true;
     }
+    // We are about to walk every object page of the image. For a directly mapped image,
+    // ask the kernel to read the file-backed pages ahead asynchronously, so that the
+    // serial fixup pass below does not stall on a synchronous page fault for each page.
+    // (For decompressed images the pages are already resident and this is a no-op.)
+    if (Runtime::Current()->MadviseWillNeedImageSpaces()) {
+      CHECK_NE(madvise(target_base, image_header->GetImageSize(), MADV_WILLNEED), -1)
+          << "madvise failed";
+    }
     ScopedDebugDisallowReadBarriers sddrb(Thread::Current());
 
     using ForwardObject = ForwardAddress<RelocationRange, RelocationRange>;
@@ -2802,6 +2810,15 @@ class ImageSpace::BootImageLoader {
     if (base_diff64 == 0 && current_diff64 == 0) {
       return;
     }
+    // The patching passes below write to every object page of these spaces (every object
+    // header holds a class reference that needs to be adjusted). Ask the kernel to read
+    // the file-backed pages ahead asynchronously, so that the serial walk does not stall
+    // on a synchronous page fault for each page.
+    if (Runtime::Current()->MadviseWillNeedImageSpaces()) {
+      for (const std::unique_ptr<ImageSpace>& space : spaces) {
+        CHECK_NE(madvise(space->Begin(), space->Size(), MADV_WILLNEED), -1) << "madvise failed";
+      }
+    }
     uint32_t base_diff = static_cast<uint32_t>(base_diff64);
     uint32_t current_diff = static_cast<uint32_t>(current_diff64);
 
@@ -3751,61 +3768,117 @@ void ImageSpace::Dump(std::ostream& os) const {
       << ",name=\"" << GetName() << "\"]";
 }
 
-bool ImageSpace::ValidateOatFile(const OatFile& oat_file, std::string* error_msg) {
-  const ArtDexFileLoader dex_file_loader;
-  for (const OatDexFile* oat_dex_file : oat_file.GetOatDexFiles()) {
-    const std::string& dex_file_location = oat_dex_file->GetDexFileLocation();
-
-    // Skip multidex locations - These will be checked when we visit their
-    // corresponding primary non-multidex location.
-    if (DexFileLoader::IsMultiDexLocation(dex_file_location.c_str())) {
-      continue;
-    }
+// Check the dex file checksums recorded for one primary (non-multidex) oat dex file
+// against the corresponding file on disk, including any related multidex entries.
+static bool ValidateOatDexFileChecksums(const OatFile& oat_file,
+                                        const OatDexFile* oat_dex_file,
+                                        const ArtDexFileLoader& dex_file_loader,
+                                        /*out*/std::string* error_msg) {
+  const std::string& dex_file_location = oat_dex_file->GetDexFileLocation();
+  DCHECK(!DexFileLoader::IsMultiDexLocation(dex_file_location.c_str()));
+
+  std::vector<uint32_t> checksums;
+  if (!dex_file_loader.GetMultiDexChecksums(dex_file_location.c_str(), &checksums, error_msg)) {
+    *error_msg = StringPrintf("ValidateOatFile failed to get checksums of dex file '%s' "
+                              "referenced by oat file %s: %s",
+                              dex_file_location.c_str(),
+                              oat_file.GetLocation().c_str(),
+                              error_msg->c_str());
+    return false;
+  }
+  CHECK(!checksums.empty());
+  if (checksums[0] != oat_dex_file->GetDexFileLocationChecksum()) {
+    *error_msg = StringPrintf("ValidateOatFile found checksum mismatch between oat file "
+                              "'%s' and dex file '%s' (0x%x != 0x%x)",
+                              oat_file.GetLocation().c_str(),
+                              dex_file_location.c_str(),
+                              oat_dex_file->GetDexFileLocationChecksum(),
+                              checksums[0]);
+    return false;
+  }
 
-    std::vector<uint32_t> checksums;
-    if (!dex_file_loader.GetMultiDexChecksums(dex_file_location.c_str(), &checksums, error_msg)) {
-      *error_msg = StringPrintf("ValidateOatFile failed to get checksums of dex file '%s' "
-                                "referenced by oat file %s: %s",
-                                dex_file_location.c_str(),
+  // Verify checksums for any related multidex entries.
+  for (size_t i = 1; i < checksums.size(); i++) {
+    std::string multi_dex_location = DexFileLoader::GetMultiDexLocation(
+        i,
+        dex_file_location.c_str());
+    const OatDexFile* multi_dex = oat_file.GetOatDexFile(multi_dex_location.c_str(),
+                                                         nullptr,
+                                                         error_msg);
+    if (multi_dex == nullptr) {
+      *error_msg = StringPrintf("ValidateOatFile oat file '%s' is missing entry '%s'",
                                 oat_file.GetLocation().c_str(),
-                                error_msg->c_str());
+                                multi_dex_location.c_str());
       return false;
     }
-    CHECK(!checksums.empty());
-    if (checksums[0] != oat_dex_file->GetDexFileLocationChecksum()) {
+
+    if (checksums[i] != multi_dex->GetDexFileLocationChecksum()) {
       *error_msg = StringPrintf("ValidateOatFile found checksum mismatch between oat file "
                                 "'%s' and dex file '%s' (0x%x != 0x%x)",
                                 oat_file.GetLocation().c_str(),
-                                dex_file_location.c_str(),
-                                oat_dex_file->GetDexFileLocationChecksum(),
-                                checksums[0]);
+                                multi_dex_location.c_str(),
+                                multi_dex->GetDexFileLocationChecksum(),
+                                checksums[i]);
       return false;
     }
+  }
+  return true;
+}
 
-    // Verify checksums for any related multidex entries.
-    for (size_t i = 1; i < checksums.size(); i++) {
-      std::string multi_dex_location = DexFileLoader::GetMultiDexLocation(
-          i,
-          dex_file_location.c_str());
-      const OatDexFile* multi_dex = oat_file.GetOatDexFile(multi_dex_location.c_str(),
-                                                           nullptr,
-                                                           error_msg);
-      if (multi_dex == nullptr) {
-        *error_msg = StringPrintf("ValidateOatFile oat file '%s' is missing entry '%s'",
-                                  oat_file.GetLocation().c_str(),
-                                  multi_dex_location.c_str());
-        return false;
+bool ImageSpace::ValidateOatFile(const OatFile& oat_file, std::string* error_msg) {
+  const ArtDexFileLoader dex_file_loader;
+  // Collect the primary oat dex files. Multidex locations are checked together with
+  // their corresponding primary non-multidex location.
+  std::vector<const OatDexFile*> primary_oat_dex_files;
+  for (const OatDexFile* oat_dex_file : oat_file.GetOatDexFiles()) {
+    if (DexFileLoader::IsMultiDexLocation(oat_dex_file->GetDexFileLocation().c_str())) {
+      continue;
+    }
+    primary_oat_dex_files.push_back(oat_dex_file);
+  }
+
+  Thread* const self = Thread::Current();
+  if (primary_oat_dex_files.size() >= 2u && self != nullptr) {
+    // Each component reads its own dex or zip file to get the checksums, so the
+    // validations are mostly independent I/O and can be overlapped on the thread
+    // pool, just like the image block decompression above.
+    Runtime::ScopedThreadPoolUsage stpu;
+    ThreadPool* const pool = stpu.GetThreadPool();
+    if (pool != nullptr) {
+      const size_t count = primary_oat_dex_files.size();
+      std::vector<std::string> error_msgs(count);
+      // Note: avoid std::vector<bool>; the workers write their slots concurrently.
+      std::vector<uint8_t> results(count, 0u);
+      for (size_t i = 0; i != count; ++i) {
+        auto function = [&, i](Thread*) {
+          results[i] = ValidateOatDexFileChecksums(
+              oat_file, primary_oat_dex_files[i], dex_file_loader, &error_msgs[i]) ? 1u : 0u;
+        };
+        pool->AddTask(self, new FunctionTask(std::move(function)));
       }
-
-      if (checksums[i] != multi_dex->GetDexFileLocationChecksum()) {
-        *error_msg = StringPrintf("ValidateOatFile found checksum mismatch between oat file "
-                                  "'%s' and dex file '%s' (0x%x != 0x%x)",
-                                  oat_file.GetLocation().c_str(),
-                                  multi_dex_location.c_str(),
-                                  multi_dex->GetDexFileLocationChecksum(),
-                                  checksums[i]);
-        return false;
+      {
+        ScopedTrace trace("Waiting for oat file validation");
+        if (self->GetState() == kRunnable) {
+          // Go to native since we don't want to suspend while holding the mutator lock.
+          ScopedThreadSuspension sts(self, kNative);
+          pool->Wait(self, true, false);
+        } else {
+          pool->Wait(self, true, false);
+        }
+      }
+      for (size_t i = 0; i != count; ++i) {
+        if (results[i] == 0u) {
+          *error_msg = std::move(error_msgs[i]);
+          return false;
+        }
       }
+      return true;
+    }
+  }
+
+  for (const OatDexFile* oat_dex_file : primary_oat_dex_files) {
+    if (!ValidateOatDexFileChecksums(oat_file, oat_dex_file, dex_file_loader, error_msg)) {
+      return false;
     }
   }
   return true;
@@ -133,18 +133,51 @@ LargeObjectMapSpace* LargeObjectMapSpace::Create(const std::string& name) {
   }
 }
 
+MemMap LargeObjectMapSpace::TakeCachedMemMap(size_t size) {
+  auto it = cached_mem_maps_.find(size);
+  if (it == cached_mem_maps_.end()) {
+    return MemMap::Invalid();
+  }
+  MemMap mem_map = std::move(it->second);
+  cached_mem_maps_.erase(it);
+  DCHECK_GE(cached_mem_map_bytes_, mem_map.BaseSize());
+  cached_mem_map_bytes_ -= mem_map.BaseSize();
+  return mem_map;
+}
+
+void LargeObjectMapSpace::CacheMemMap(MemMap&& mem_map) {
+  const size_t map_size = mem_map.BaseSize();
+  if (cached_mem_map_bytes_ + map_size > kMaxCachedMemMapBytes) {
+    // Cache is full; let the map destructor munmap it.
+    return;
+  }
+  // Release the pages back to the kernel and guarantee zeroed memory for the next allocation
+  // reusing this map.
+  ZeroAndReleasePages(mem_map.Begin(), mem_map.Size());
+  cached_mem_map_bytes_ += map_size;
+  cached_mem_maps_.emplace(map_size, std::move(mem_map));
+}
+
 mirror::Object* LargeObjectMapSpace::Alloc(Thread* self, size_t num_bytes,
                                            size_t* bytes_allocated, size_t* usable_size,
                                            size_t* bytes_tl_bulk_allocated) {
-  std::string error_msg;
-  MemMap mem_map = MemMap::MapAnonymous("large object space allocation",
-                                        num_bytes,
-                                        PROT_READ | PROT_WRITE,
-                                        /*low_4gb=*/ true,
-                                        &error_msg);
-  if (UNLIKELY(!mem_map.IsValid())) {
-    LOG(WARNING) << "Large object allocation failed: " << error_msg;
-    return nullptr;
+  MemMap mem_map = MemMap::Invalid();
+  {
+    // Check the size-class cache of freed maps before paying for an mmap syscall.
+    MutexLock mu(self, lock_);
+    mem_map = TakeCachedMemMap(RoundUp(num_bytes, kPageSize));
+  }
+  if (!mem_map.IsValid()) {
+    std::string error_msg;
+    mem_map = MemMap::MapAnonymous("large object space allocation",
+                                   num_bytes,
+                                   PROT_READ | PROT_WRITE,
+                                   /*low_4gb=*/ true,
+                                   &error_msg);
+    if (UNLIKELY(!mem_map.IsValid())) {
+      LOG(WARNING) << "Large object allocation failed: " << error_msg;
+      return nullptr;
+    }
   }
   mirror::Object* const obj = reinterpret_cast<mirror::Object*>(mem_map.Begin());
   const size_t allocation_size = mem_map.BaseSize();
@@ -201,6 +234,7 @@ size_t LargeObjectMapSpace::Free(Thread* self, mirror::Object* ptr) {
   size_t allocation_size = map_size;
   num_bytes_allocated_ -= allocation_size;
   --num_objects_allocated_;
+  CacheMemMap(std::move(it->second.mem_map));
   large_objects_.erase(it);
   return allocation_size;
 }
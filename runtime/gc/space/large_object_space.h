@@ -24,6 +24,7 @@
 #include "space.h"
 #include "thread-current-inl.h"
 
+#include <map>
 #include <set>
 #include <vector>
 
@@ -178,8 +179,20 @@ class LargeObjectMapSpace : public LargeObjectSpace {
       REQUIRES(!lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Take a cached memory map of exactly `size` bytes, or an invalid MemMap if none is cached.
+  MemMap TakeCachedMemMap(size_t size) REQUIRES(lock_);
+  // Cache the memory map of a freed large object for reuse by Alloc(), releasing its pages
+  // back to the kernel, or drop (munmap) it if the cache is full.
+  void CacheMemMap(MemMap&& mem_map) REQUIRES(lock_);
+
   AllocationTrackingSafeMap<mirror::Object*, LargeObject, kAllocatorTagLOSMaps> large_objects_
       GUARDED_BY(lock_);
+
+  // Freed large object maps bucketed by their exact (page-aligned) size for reuse, avoiding an
+  // munmap/mmap syscall pair per large object churn. Bounded by kMaxCachedMemMapBytes.
+  static constexpr size_t kMaxCachedMemMapBytes = 16 * MB;
+  std::multimap<size_t, MemMap> cached_mem_maps_ GUARDED_BY(lock_);
+  size_t cached_mem_map_bytes_ GUARDED_BY(lock_) = 0;
 };
 
 // A continuous large object space with a free-list to handle holes.
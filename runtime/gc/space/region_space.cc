@@ -19,10 +19,14 @@
 #include "bump_pointer_space.h"
 #include "base/dumpable.h"
 #include "base/logging.h"
+#include "gc/accounting/card_table-inl.h"
 #include "gc/accounting/read_barrier_table.h"
+#include "gc/heap.h"
 #include "mirror/class-inl.h"
 #include "mirror/object-inl.h"
+#include "runtime.h"
 #include "thread_list.h"
+#include "thread_pool.h"
 
 namespace art {
 namespace gc {
@@ -32,6 +36,19 @@ namespace space {
 // value of the region size, evaculate the region.
 static constexpr uint kEvacuateLivePercentThreshold = 75U;
 
+// If true, skip evacuating hot, heavily-mutated regions (as estimated from the dirty cards
+// covering the region) which still hold a non-trivial amount of live data. Such regions tend
+// to be re-dirtied immediately after the copy, so evacuating them buys little compaction win
+// for the copied bytes.
+static constexpr bool kEvacuationRespectsMutationRate = true;
+
+// Dirty-card percentage at or above which a region counts as heavily mutated.
+static constexpr uint kHotRegionDirtyCardPercentThreshold = 50U;
+
+// Minimum live percentage for the mutation-rate heuristic to apply. Regions with less live
+// data than this are cheap to copy and are always evacuated based on the live ratio alone.
+static constexpr uint kHotRegionMinLivePercent = 25U;
+
 // Whether we protect the unused and cleared regions.
 static constexpr bool kProtectClearedRegions = kIsDebugBuild;
 
@@ -217,10 +234,36 @@ bool RegionSpace::Region::GetUseGenerationalCC() {
   return art::Runtime::Current()->GetHeap()->GetUseGenerationalCC();
 }
 
-inline bool RegionSpace::Region::ShouldBeEvacuated(EvacMode evac_mode) {
+uint RegionSpace::Region::DirtyCardPercent(accounting::CardTable* card_table) const {
+  uint8_t* const top = Top();
+  if (top == Begin()) {
+    return 0U;
+  }
+  uint8_t* card = card_table->CardFromAddr(Begin());
+  uint8_t* const card_end =
+      card_table->CardFromAddr(AlignUp(top, accounting::CardTable::kCardSize));
+  const size_t num_cards = card_end - card;
+  DCHECK_NE(num_cards, 0U);
+  size_t dirty_cards = 0U;
+  for (; card != card_end; ++card) {
+    if (*card == accounting::CardTable::kCardDirty) {
+      ++dirty_cards;
+    }
+  }
+  return dirty_cards * 100U / num_cards;
+}
+
+inline bool RegionSpace::Region::ShouldBeEvacuated(EvacMode evac_mode,
+                                                   accounting::CardTable* card_table) {
   // Evacuation mode `kEvacModeNewlyAllocated` is only used during sticky-bit CC collections.
   DCHECK(GetUseGenerationalCC() || (evac_mode != kEvacModeNewlyAllocated));
   DCHECK((IsAllocated() || IsLarge()) && IsInToSpace());
+  // A region pinned by a JNI critical section must stay in place regardless of the
+  // evacuation mode, including `kEvacModeForceAll`: native code holds a raw pointer into
+  // it (see RegionSpace::TryPinObject).
+  if (UNLIKELY(IsPinned())) {
+    return false;
+  }
   // The region should be evacuated if:
   // - the evacuation is forced (`evac_mode == kEvacModeForceAll`); or
   // - the region was allocated after the start of the previous GC (newly allocated region); or
@@ -278,6 +321,16 @@ inline bool RegionSpace::Region::ShouldBeEvacuated(EvacMode evac_mode) {
         // there's no live objects due to rounding (there may be a
         // few).
         result = (live_bytes_ * 100U < kEvacuateLivePercentThreshold * bytes_allocated);
+        if (kEvacuationRespectsMutationRate &&
+            result &&
+            card_table != nullptr &&
+            live_bytes_ * 100U >= kHotRegionMinLivePercent * bytes_allocated &&
+            DirtyCardPercent(card_table) >= kHotRegionDirtyCardPercentThreshold) {
+          // The region is below the live-percent threshold but hot: most of its cards have
+          // been dirtied since the last GC cycle, so its survivors are likely to be mutated
+          // again right away. Keep it in place as unevacuated from-space instead of copying.
+          result = false;
+        }
       } else {
         DCHECK(IsLarge());
         result = (live_bytes_ == 0U);
@@ -324,6 +377,36 @@ void RegionSpace::ZeroLiveBytesForLargeObject(mirror::Object* obj) {
   }
 }
 
+bool RegionSpace::TryPinObject(mirror::Object* ref) {
+  if (!HasAddress(ref)) {
+    return false;
+  }
+  Region* r = RefToRegionUnlocked(ref);
+  if (!r->IsLarge()) {
+    return false;
+  }
+  // A large object starts at the beginning of its (head) region. Pinning the head region is
+  // sufficient: large tail regions always follow the head region's evacuation decision (see
+  // RegionSpace::SetFromSpace).
+  DCHECK_ALIGNED(ref, kRegionSize);
+  r->Pin();
+  return true;
+}
+
+bool RegionSpace::TryUnpinObject(mirror::Object* ref) {
+  if (!HasAddress(ref)) {
+    return false;
+  }
+  Region* r = RefToRegionUnlocked(ref);
+  if (!r->IsLarge()) {
+    return false;
+  }
+  // The pin taken out by the matching TryPinObject() call prevented the object from moving,
+  // so this is necessarily the same (still large) region.
+  r->Unpin();
+  return true;
+}
+
 // Determine which regions to evacuate and mark them as
 // from-space. Mark the rest as unevacuated from-space.
 void RegionSpace::SetFromSpace(accounting::ReadBarrierTable* rb_table,
@@ -341,6 +424,11 @@ void RegionSpace::SetFromSpace(accounting::ReadBarrierTable* rb_table,
   // them during the thread-flip.
   partial_tlabs_.clear();
 
+  // Used by the mutation-rate evacuation heuristic; see Region::ShouldBeEvacuated().
+  accounting::CardTable* const card_table = kEvacuationRespectsMutationRate
+      ? art::Runtime::Current()->GetHeap()->GetCardTable()
+      : nullptr;
+
   // Counter for the number of expected large tail regions following a large region.
   size_t num_expected_large_tails = 0U;
   // Flag to store whether the previously seen large region has been evacuated.
@@ -360,7 +448,7 @@ void RegionSpace::SetFromSpace(accounting::ReadBarrierTable* rb_table,
         DCHECK((state == RegionState::kRegionStateAllocated ||
                 state == RegionState::kRegionStateLarge) &&
                type == RegionType::kRegionTypeToSpace);
-        bool should_evacuate = r->ShouldBeEvacuated(evac_mode);
+        bool should_evacuate = r->ShouldBeEvacuated(evac_mode, card_table);
         bool is_newly_allocated = r->IsNewlyAllocated();
         if (should_evacuate) {
           r->SetAsFromSpace();
@@ -498,13 +586,34 @@ void RegionSpace::ClearFromSpace(/* out */ uint64_t* cleared_bytes,
     }
   }
 
-  // Madvise the memory ranges.
-  for (const auto &iter : madvise_list) {
-    ZeroAndProtectRegion(iter.first, iter.second);
+  // Madvise the memory ranges. The ranges are disjoint, so when several were gathered
+  // and the heap has a thread pool, release them in parallel; for large from-spaces the
+  // release of the ranges dominates the reclaim phase.
+  auto clear_range = [this, clear_bitmap](uint8_t* range_begin, uint8_t* range_end) {
+    ZeroAndProtectRegion(range_begin, range_end);
     if (clear_bitmap) {
       GetLiveBitmap()->ClearRange(
-          reinterpret_cast<mirror::Object*>(iter.first),
-          reinterpret_cast<mirror::Object*>(iter.second));
+          reinterpret_cast<mirror::Object*>(range_begin),
+          reinterpret_cast<mirror::Object*>(range_end));
+    }
+  };
+  Thread* const self = Thread::Current();
+  ThreadPool* const thread_pool = Runtime::Current()->GetHeap()->GetThreadPool();
+  if (thread_pool != nullptr && madvise_list.size() > 1u) {
+    for (const auto& iter : madvise_list) {
+      uint8_t* const range_begin = iter.first;
+      uint8_t* const range_end = iter.second;
+      thread_pool->AddTask(self, new FunctionTask(
+          [clear_range, range_begin, range_end](Thread* thread ATTRIBUTE_UNUSED) {
+            clear_range(range_begin, range_end);
+          }));
+    }
+    thread_pool->StartWorkers(self);
+    thread_pool->Wait(self, /*do_work=*/ true, /*may_hold_locks=*/ true);
+    thread_pool->StopWorkers(self);
+  } else {
+    for (const auto& iter : madvise_list) {
+      clear_range(iter.first, iter.second);
     }
   }
   madvise_list.clear();
@@ -946,6 +1055,7 @@ void RegionSpace::Region::Dump(std::ostream& os) const {
      << " state=" << state_
      << " type=" << type_
      << " objects_allocated=" << objects_allocated_
+     << " pinned_count=" << pinned_count_
      << " alloc_time=" << alloc_time_
      << " live_bytes=" << live_bytes_;
 
@@ -1005,6 +1115,7 @@ void RegionSpace::Region::Clear(bool zero_and_release_pages) {
   state_ = RegionState::kRegionStateFree;
   type_ = RegionType::kRegionTypeNone;
   objects_allocated_.store(0, std::memory_order_relaxed);
+  pinned_count_.store(0, std::memory_order_relaxed);
   alloc_time_ = 0;
   live_bytes_ = static_cast<size_t>(-1);
   if (zero_and_release_pages) {
@@ -29,6 +29,7 @@ namespace art {
 namespace gc {
 
 namespace accounting {
+class CardTable;
 class ReadBarrierTable;
 }  // namespace accounting
 
@@ -272,6 +273,18 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
     return false;
   }
 
+  // Pin `ref` so that the region backing it is excluded from future evacuation decisions,
+  // allowing native code to hold a raw pointer to its data across GC cycles (used by the
+  // JNI Get/ReleasePrimitiveArrayCritical fast path). Only large objects can be pinned: a
+  // large object has its region(s) to itself, so the pin keeps no unrelated objects from
+  // being compacted, and the region's "large" state is stable while the object is alive,
+  // which lets the release path deduce that the matching get used a pin.
+  // Returns true if the object was pinned, false if it is not pinnable.
+  bool TryPinObject(mirror::Object* ref) REQUIRES_SHARED(Locks::mutator_lock_);
+  // Undo one successful TryPinObject() call. Returns true if `ref` is a pinnable object
+  // (and thus a pin was taken out on its region by the matching TryPinObject() call).
+  bool TryUnpinObject(mirror::Object* ref) REQUIRES_SHARED(Locks::mutator_lock_);
+
   bool IsInToSpace(mirror::Object* ref) {
     if (HasAddress(ref)) {
       Region* r = RefToRegionUnlocked(ref);
@@ -393,6 +406,7 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
           top_(nullptr),
           end_(nullptr),
           objects_allocated_(0),
+          pinned_count_(0),
           alloc_time_(0),
           is_newly_allocated_(false),
           is_a_tlab_(false),
@@ -407,6 +421,7 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
       state_ = RegionState::kRegionStateFree;
       type_ = RegionType::kRegionTypeNone;
       objects_allocated_.store(0, std::memory_order_relaxed);
+      pinned_count_.store(0, std::memory_order_relaxed);
       alloc_time_ = 0;
       live_bytes_ = static_cast<size_t>(-1);
       is_newly_allocated_ = false;
@@ -478,6 +493,21 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
       live_bytes_ = 0;
     }
 
+    // Whether a JNI critical section holds a raw pointer into this region. Pinned regions
+    // must never be chosen for evacuation; see ShouldBeEvacuated().
+    bool IsPinned() const {
+      return pinned_count_.load(std::memory_order_relaxed) != 0u;
+    }
+
+    void Pin() {
+      pinned_count_.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    void Unpin() {
+      size_t old_count = pinned_count_.fetch_sub(1u, std::memory_order_relaxed);
+      DCHECK_GT(old_count, 0u);
+    }
+
     // Large-tail allocated.
     bool IsLargeTail() const {
       bool is_large_tail = (state_ == RegionState::kRegionStateLargeTail);
@@ -550,7 +580,14 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
     }
 
     // Return whether this region should be evacuated. Used by RegionSpace::SetFromSpace.
-    ALWAYS_INLINE bool ShouldBeEvacuated(EvacMode evac_mode);
+    // `card_table` is used to estimate the region's mutation rate; heavily-mutated ("hot")
+    // regions with a non-trivial amount of live data are not worth copying since their
+    // survivors are likely to be written (and their cards re-dirtied) right after the copy.
+    ALWAYS_INLINE bool ShouldBeEvacuated(EvacMode evac_mode, accounting::CardTable* card_table);
+
+    // Percentage of card table cards covering [Begin(), Top()) that are dirty. Used by
+    // ShouldBeEvacuated() as a proxy for the region's mutation rate.
+    uint DirtyCardPercent(accounting::CardTable* card_table) const;
 
     void AddLiveBytes(size_t live_bytes) {
       DCHECK(GetUseGenerationalCC() || IsInUnevacFromSpace());
@@ -621,6 +658,10 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
     // objects_allocated_ is accessed using memory_order_relaxed. Treat as approximate when there
     // are concurrent updates.
     Atomic<size_t> objects_allocated_;  // The number of objects allocated.
+    // Number of JNI critical sections holding raw pointers into this region. Mutators
+    // update this with relaxed atomics while holding the mutator lock shared; evacuation
+    // decisions read it during the flip pause (with the mutator lock held exclusively).
+    Atomic<size_t> pinned_count_;
     uint32_t alloc_time_;               // The allocation time of the region.
     // Note that newly allocated and evacuated regions use -1 as
     // special value for `live_bytes_`.
@@ -201,10 +201,23 @@ inline MutableHandle<T> VariableSizedHandleScope::NewHandle(T* object) {
   return NewHandle(ObjPtr<T>(object));
 }
 
+inline void* VariableSizedHandleScope::AcquireLocalScopeStorage() {
+  static_assert(kMaxLocalScopeSize >= sizeof(void*), "Storage blocks hold the free list links");
+  void* storage = self_->TryGetLocalScopeStorage();
+  return (storage != nullptr) ? storage : ::operator new(kMaxLocalScopeSize);
+}
+
+inline void VariableSizedHandleScope::ReleaseLocalScopeStorage(LocalScopeType* scope) {
+  scope->~LocalScopeType();
+  if (!self_->CacheLocalScopeStorage(scope)) {
+    ::operator delete(scope);
+  }
+}
+
 template<class MirrorType>
 inline MutableHandle<MirrorType> VariableSizedHandleScope::NewHandle(ObjPtr<MirrorType> ptr) {
   if (current_scope_->RemainingSlots() == 0) {
-    current_scope_ = new LocalScopeType(current_scope_);
+    current_scope_ = new (AcquireLocalScopeStorage()) LocalScopeType(current_scope_);
   }
   return current_scope_->NewHandle(ptr);
 }
@@ -220,10 +233,10 @@ inline VariableSizedHandleScope::VariableSizedHandleScope(Thread* const self)
 inline VariableSizedHandleScope::~VariableSizedHandleScope() {
   BaseHandleScope* top_handle_scope = self_->PopHandleScope();
   DCHECK_EQ(top_handle_scope, this);
-  // Don't delete first_scope_ since it is not heap allocated.
+  // Don't release first_scope_ since it is not heap allocated.
   while (current_scope_ != &first_scope_) {
     LocalScopeType* next = down_cast<LocalScopeType*>(current_scope_->GetLink());
-    delete current_scope_;
+    ReleaseLocalScopeStorage(current_scope_);
     current_scope_ = next;
   }
 }
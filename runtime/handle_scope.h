@@ -270,6 +270,12 @@ class VariableSizedHandleScope : public BaseHandleScope {
   // Linked list of fixed size handle scopes.
   using LocalScopeType = FixedSizeHandleScope<kNumReferencesPerScope>;
   static_assert(sizeof(LocalScopeType) <= kMaxLocalScopeSize, "Unexpected size of LocalScopeType");
+
+  // Storage for overflow local scopes comes from a small per-thread pool of retired scopes,
+  // falling back to the allocator; JNI-heavy threads overflow scopes at a high rate.
+  ALWAYS_INLINE void* AcquireLocalScopeStorage();
+  ALWAYS_INLINE void ReleaseLocalScopeStorage(LocalScopeType* scope);
+
   LocalScopeType* current_scope_;
   LocalScopeType first_scope_;
 
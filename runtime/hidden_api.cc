@@ -22,6 +22,8 @@
 #include "art_method-inl.h"
 #include "base/dumpable.h"
 #include "base/file_utils.h"
+#include "base/mutex.h"
+#include "base/safe_map.h"
 #include "class_root.h"
 #include "dex/class_accessor-inl.h"
 #include "dex/dex_file_loader.h"
@@ -378,6 +380,45 @@ static void VisitMembers(const DexFile& dex_file,
   accessor.VisitMethods(fn_visit, fn_visit);
 }
 
+// Cache of decoded dex hiddenapi flags, keyed by member pointer. Allowed
+// accesses are memoized by adding kAccPublicApi to the member's runtime access
+// flags, but denied accesses are not, so code which repeatedly probes the same
+// hidden member via reflection or JNI would otherwise pay the linear class def
+// scan in GetDexFlags on every access. The decoded flags are a pure property
+// of the (immutable) dex file, and the keys are native ArtField/ArtMethod
+// pointers of boot classpath classes which are never moved or unloaded, so
+// entries never need to be invalidated.
+class DexFlagsCache {
+ public:
+  DexFlagsCache() : lock_("hidden API dex flags cache lock", kGenericBottomLock) {}
+
+  bool Lookup(const void* member, /*out*/ uint32_t* flags) REQUIRES(!lock_) {
+    MutexLock mu(Thread::Current(), lock_);
+    auto it = cache_.find(member);
+    if (it == cache_.end()) {
+      return false;
+    }
+    *flags = it->second;
+    return true;
+  }
+
+  void Insert(const void* member, uint32_t flags) REQUIRES(!lock_) {
+    MutexLock mu(Thread::Current(), lock_);
+    // Two threads may decode the same member concurrently; they compute the
+    // same value, so overwriting is benign.
+    cache_.Overwrite(member, flags);
+  }
+
+ private:
+  Mutex lock_;
+  SafeMap<const void*, uint32_t> cache_ GUARDED_BY(lock_);
+};
+
+static DexFlagsCache& GetDexFlagsCache() {
+  static DexFlagsCache cache;
+  return cache;
+}
+
 template<typename T>
 uint32_t GetDexFlags(T* member) REQUIRES_SHARED(Locks::mutator_lock_) {
   static_assert(std::is_same<T, ArtField>::value || std::is_same<T, ArtMethod>::value);
@@ -388,6 +429,12 @@ uint32_t GetDexFlags(T* member) REQUIRES_SHARED(Locks::mutator_lock_) {
   ObjPtr<mirror::Class> declaring_class = member->GetDeclaringClass();
   DCHECK(!declaring_class.IsNull()) << "Attempting to access a runtime method";
 
+  DexFlagsCache& cache = GetDexFlagsCache();
+  uint32_t cached_flags = 0u;
+  if (cache.Lookup(member, &cached_flags)) {
+    return cached_flags;
+  }
+
   ApiList flags;
   DCHECK(!flags.IsValid());
 
@@ -439,7 +486,9 @@ uint32_t GetDexFlags(T* member) REQUIRES_SHARED(Locks::mutator_lock_) {
 
   CHECK(flags.IsValid()) << "Could not find hiddenapi flags for "
       << Dumpable<MemberSignature>(MemberSignature(member));
-  return flags.GetDexFlags();
+  uint32_t dex_flags = flags.GetDexFlags();
+  cache.Insert(member, dex_flags);
+  return dex_flags;
 }
 
 template<typename T>
@@ -211,6 +211,8 @@ class MemberSignature {
 
 // Locates hiddenapi flags for `field` in the corresponding dex file.
 // NB: This is an O(N) operation, linear with the number of members in the class def.
+// The result is memoized in a process-wide cache, so only the first lookup of
+// a given member pays this cost.
 template<typename T>
 uint32_t GetDexFlags(T* member) REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -361,6 +363,9 @@ ALWAYS_INLINE inline uint32_t GetRuntimeFlags(ArtMethod* method)
       case Intrinsics::kFP16GreaterEquals:
       case Intrinsics::kFP16Less:
       case Intrinsics::kFP16LessEquals:
+      case Intrinsics::kFP16Compare:
+      case Intrinsics::kFP16Min:
+      case Intrinsics::kFP16Max:
       case Intrinsics::kFP16ToFloat:
       case Intrinsics::kFP16ToHalf:
       case Intrinsics::kFP16Rint:
@@ -440,7 +445,8 @@ inline bool ShouldDenyAccessToMember(T* member,
 
       // Decode hidden API access flags from the dex file.
       // This is an O(N) operation scaling with the number of fields/methods
-      // in the class. Only do this on slow path and only do it once.
+      // in the class, so only do this on the slow path. Repeated accesses to
+      // the same denied member hit the decoded flags cache instead.
       ApiList api_list(detail::GetDexFlags(member));
       DCHECK(api_list.IsValid());
 
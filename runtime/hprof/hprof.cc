@@ -34,6 +34,7 @@
 #include <unistd.h>
 
 #include <set>
+#include <vector>
 
 #include <android-base/logging.h>
 #include <android-base/stringprintf.h>
@@ -432,13 +433,20 @@ class VectorEndianOuputput final : public EndianOutputBuffered {
 
 #define __ output_->
 
+// Allocation record epoch of the last successful delta dump. The next delta dump emits only
+// objects whose allocation records are newer than this. Dumps run under ScopedSuspendAll, so
+// at most one dump mutates this at a time.
+static uint64_t g_last_delta_dump_epoch GUARDED_BY(Locks::alloc_tracker_lock_) = 0;
+
 class Hprof : public SingleRootVisitor {
  public:
-  Hprof(const char* output_filename, int fd, bool direct_to_ddms)
+  Hprof(const char* output_filename, int fd, bool direct_to_ddms, bool delta)
       : filename_(output_filename),
         fd_(fd),
-        direct_to_ddms_(direct_to_ddms) {
-    LOG(INFO) << "hprof: heap dump \"" << filename_ << "\" starting...";
+        direct_to_ddms_(direct_to_ddms),
+        delta_(delta) {
+    LOG(INFO) << "hprof: " << (delta_ ? "delta " : "") << "heap dump \"" << filename_
+              << "\" starting...";
   }
 
   void Dump()
@@ -448,6 +456,13 @@ class Hprof : public SingleRootVisitor {
       MutexLock mu(Thread::Current(), *Locks::alloc_tracker_lock_);
       if (Runtime::Current()->GetHeap()->IsAllocTrackingEnabled()) {
         PopulateAllocationTrackingTraces();
+        if (delta_) {
+          CollectDeltaObjects();
+        }
+      } else if (delta_) {
+        LOG(WARNING) << "hprof: delta dump requested but allocation tracking is disabled; "
+                     << "dumping the full heap";
+        delta_ = false;
       }
     }
 
@@ -476,6 +491,12 @@ class Hprof : public SingleRootVisitor {
     }
 
     if (okay) {
+      if (delta_) {
+        // Only advance the epoch once the dump has actually been written, so a failed dump
+        // does not lose the objects it should have covered.
+        MutexLock mu(Thread::Current(), *Locks::alloc_tracker_lock_);
+        g_last_delta_dump_epoch = delta_epoch_;
+      }
       const uint64_t duration = NanoTime() - start_ns_;
       LOG(INFO) << "hprof: heap dump completed (" << PrettySize(RoundUp(overall_size, KB))
                 << ") in " << PrettyDuration(duration)
@@ -527,11 +548,19 @@ class Hprof : public SingleRootVisitor {
     simple_roots_.clear();
     runtime->VisitRoots(this);
     runtime->VisitImageRoots(this);
-    auto dump_object = [this](mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
-      DCHECK(obj != nullptr);
-      DumpHeapObject(obj);
-    };
-    runtime->GetHeap()->VisitObjectsPaused(dump_object);
+    if (delta_) {
+      // Only dump the objects allocated since the last delta dump. The roots above are still
+      // emitted in full so the reader can tell which of them are live.
+      for (mirror::Object* obj : delta_objects_) {
+        DumpHeapObject(obj);
+      }
+    } else {
+      auto dump_object = [this](mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+        DCHECK(obj != nullptr);
+        DumpHeapObject(obj);
+      };
+      runtime->GetHeap()->VisitObjectsPaused(dump_object);
+    }
     output_->StartNewRecord(HPROF_TAG_HEAP_DUMP_END, kHprofTime);
     output_->EndRecord();
   }
@@ -870,12 +899,44 @@ class Hprof : public SingleRootVisitor {
     total_objects_with_stack_trace_ = count;
   }
 
+  void CollectDeltaObjects()
+      REQUIRES(Locks::mutator_lock_, Locks::alloc_tracker_lock_) {
+    gc::AllocRecordObjectMap* records = Runtime::Current()->GetHeap()->GetAllocationRecords();
+    CHECK(records != nullptr);
+    delta_epoch_ = records->GetTotalRecordedAllocations();
+    uint64_t new_records = delta_epoch_ - g_last_delta_dump_epoch;
+    if (new_records > records->Size()) {
+      // The record ring buffer wrapped since the last delta dump, so some allocations made
+      // since then have been evicted and cannot be dumped.
+      LOG(WARNING) << "hprof: " << (new_records - records->Size())
+                   << " allocation records evicted since the last delta dump; "
+                   << "the delta is incomplete";
+      new_records = records->Size();
+    }
+    // Records are appended in allocation order, so the newest new_records entries are exactly
+    // the ones recorded since the last dump. Entries whose weak object root has been cleared
+    // are allocations that have already died; there is no object left to dump for them.
+    auto it = records->RBegin();
+    for (uint64_t i = 0; i < new_records; ++i, ++it) {
+      mirror::Object* obj = it->first.Read();
+      if (obj != nullptr) {
+        delta_objects_.push_back(obj);
+      }
+    }
+  }
+
   // If direct_to_ddms_ is set, "filename_" and "fd" will be ignored.
   // Otherwise, "filename_" must be valid, though if "fd" >= 0 it will
   // only be used for debug messages.
   std::string filename_;
   int fd_;
   bool direct_to_ddms_;
+  bool delta_;
+
+  // For delta dumps: the allocation record epoch of this dump and the still-live objects
+  // allocated since the previous dump, collected before the two output passes.
+  uint64_t delta_epoch_ = 0u;
+  std::vector<mirror::Object*> delta_objects_;
 
   uint64_t start_ns_ = NanoTime();
 
@@ -1594,11 +1655,7 @@ void Hprof::VisitRoot(mirror::Object* obj, const RootInfo& info) {
   MarkRootObject(obj, nullptr, xlate[info.GetType()], info.GetThreadId());
 }
 
-// If "direct_to_ddms" is true, the other arguments are ignored, and data is
-// sent directly to DDMS.
-// If "fd" is >= 0, the output will be written to that file descriptor.
-// Otherwise, "filename" is used to create an output file.
-void DumpHeap(const char* filename, int fd, bool direct_to_ddms) {
+static void DumpHeapInternal(const char* filename, int fd, bool direct_to_ddms, bool delta) {
   CHECK(filename != nullptr);
   Thread* self = Thread::Current();
   // Need to take a heap dump while GC isn't running. See the comment in Heap::VisitObjects().
@@ -1607,9 +1664,21 @@ void DumpHeap(const char* filename, int fd, bool direct_to_ddms) {
                                   gc::kGcCauseHprof,
                                   gc::kCollectorTypeHprof);
   ScopedSuspendAll ssa(__FUNCTION__, true /* long suspend */);
-  Hprof hprof(filename, fd, direct_to_ddms);
+  Hprof hprof(filename, fd, direct_to_ddms, delta);
   hprof.Dump();
 }
 
+// If "direct_to_ddms" is true, the other arguments are ignored, and data is
+// sent directly to DDMS.
+// If "fd" is >= 0, the output will be written to that file descriptor.
+// Otherwise, "filename" is used to create an output file.
+void DumpHeap(const char* filename, int fd, bool direct_to_ddms) {
+  DumpHeapInternal(filename, fd, direct_to_ddms, /*delta=*/ false);
+}
+
+void DumpHeapDelta(const char* filename, int fd, bool direct_to_ddms) {
+  DumpHeapInternal(filename, fd, direct_to_ddms, /*delta=*/ true);
+}
+
 }  // namespace hprof
 }  // namespace art
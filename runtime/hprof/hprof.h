@@ -23,6 +23,12 @@ namespace hprof {
 
 void DumpHeap(const char* filename, int fd, bool direct_to_ddms);
 
+// Like DumpHeap, but only dumps objects allocated since the previous call to DumpHeapDelta
+// (or since allocation tracking was enabled, for the first call). Requires allocation tracking
+// (DDMS recent allocation tracking) to be enabled; falls back to a full dump otherwise.
+// Coverage is bounded by the allocation record ring buffer size.
+void DumpHeapDelta(const char* filename, int fd, bool direct_to_ddms);
+
 }  // namespace hprof
 
 }  // namespace art
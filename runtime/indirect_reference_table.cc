@@ -38,6 +38,13 @@ static constexpr bool kDebugIRT = false;
 // Maximum table size we allow.
 static constexpr size_t kMaxTableSizeInBytes = 128 * MB;
 
+// Virtual address space reserved up front for resizable tables. Anonymous pages are only
+// committed on first touch, so the reservation costs address space but no memory; in return,
+// growing the table within the reservation is a plain capacity bump instead of a
+// remap-and-copy cycle. JNI-heavy threads that repeatedly overflow their local reference
+// table otherwise pay for a new mapping and a memcpy on every doubling.
+static constexpr size_t kResizableReservationBytes = 512 * KB;
+
 const char* GetIndirectRefKindString(const IndirectRefKind& kind) {
   switch (kind) {
     case kHandleScopeOrInvalid:
@@ -79,8 +86,12 @@ IndirectReferenceTable::IndirectReferenceTable(size_t max_count,
   CHECK_LE(max_count, kMaxTableSizeInBytes / sizeof(IrtEntry));
 
   const size_t table_bytes = max_count * sizeof(IrtEntry);
+  size_t reserved_bytes = table_bytes;
+  if (resizable == ResizableCapacity::kYes && reserved_bytes < kResizableReservationBytes) {
+    reserved_bytes = kResizableReservationBytes;
+  }
   table_mem_map_ = MemMap::MapAnonymous("indirect ref table",
-                                        table_bytes,
+                                        reserved_bytes,
                                         PROT_READ | PROT_WRITE,
                                         /*low_4gb=*/ false,
                                         error_msg);
@@ -221,6 +232,13 @@ bool IndirectReferenceTable::Resize(size_t new_size, std::string* error_msg) {
   // Note: the above check also ensures that there is no overflow below.
 
   const size_t table_bytes = new_size * sizeof(IrtEntry);
+  if (table_bytes <= table_mem_map_.Size()) {
+    // The growth fits within the reserved mapping; the table does not move and no entries
+    // need to be copied. This is the common case, see kResizableReservationBytes.
+    max_entries_ = new_size;
+    return true;
+  }
+
   MemMap new_map = MemMap::MapAnonymous("indirect ref table",
                                         table_bytes,
                                         PROT_READ | PROT_WRITE,
@@ -561,27 +561,31 @@ static bool HasEvent(Instrumentation::InstrumentationEvent expected, uint32_t ev
 
 static void PotentiallyAddListenerTo(Instrumentation::InstrumentationEvent event,
                                      uint32_t events,
-                                     std::list<InstrumentationListener*>& list,
+                                     Instrumentation::ListenerArray& array,
                                      InstrumentationListener* listener,
-                                     bool* has_listener)
-    REQUIRES(Locks::mutator_lock_, !Locks::thread_list_lock_, !Locks::classlinker_classes_lock_) {
-  Locks::mutator_lock_->AssertExclusiveHeld(Thread::Current());
+                                     std::atomic<bool>* has_listener)
+    REQUIRES_SHARED(Locks::mutator_lock_)
+    REQUIRES(!Locks::thread_list_lock_, !Locks::classlinker_classes_lock_) {
   if (!HasEvent(event, events)) {
     return;
   }
-  // If there is a free slot in the list, we insert the listener in that slot.
-  // Otherwise we add it to the end of the list.
-  auto it = std::find(list.begin(), list.end(), nullptr);
-  if (it != list.end()) {
-    *it = listener;
-  } else {
-    list.push_back(listener);
+  // Publish the listener into the first free slot. The CAS guards against another thread
+  // installing a listener into the same slot concurrently; mutators iterating over the array see
+  // either the null slot or the fully published listener.
+  bool installed = false;
+  for (std::atomic<InstrumentationListener*>& slot : array) {
+    InstrumentationListener* expected = nullptr;
+    if (slot.load(std::memory_order_relaxed) == nullptr &&
+        slot.compare_exchange_strong(expected, listener, std::memory_order_release)) {
+      installed = true;
+      break;
+    }
   }
+  CHECK(installed) << "Too many instrumentation listeners for event " << event;
   Runtime::DoAndMaybeSwitchInterpreter([=](){ *has_listener = true; });
 }
 
 void Instrumentation::AddListener(InstrumentationListener* listener, uint32_t events) {
-  Locks::mutator_lock_->AssertExclusiveHeld(Thread::Current());
   PotentiallyAddListenerTo(kMethodEntered,
                            events,
                            method_entry_listeners_,
@@ -637,33 +641,38 @@ void Instrumentation::AddListener(InstrumentationListener* listener, uint32_t ev
 
 static void PotentiallyRemoveListenerFrom(Instrumentation::InstrumentationEvent event,
                                           uint32_t events,
-                                          std::list<InstrumentationListener*>& list,
+                                          Instrumentation::ListenerArray& array,
                                           InstrumentationListener* listener,
-                                          bool* has_listener)
-    REQUIRES(Locks::mutator_lock_, !Locks::thread_list_lock_, !Locks::classlinker_classes_lock_) {
-  Locks::mutator_lock_->AssertExclusiveHeld(Thread::Current());
+                                          std::atomic<bool>* has_listener)
+    REQUIRES_SHARED(Locks::mutator_lock_)
+    REQUIRES(!Locks::thread_list_lock_, !Locks::classlinker_classes_lock_) {
   if (!HasEvent(event, events)) {
     return;
   }
-  auto it = std::find(list.begin(), list.end(), listener);
-  if (it != list.end()) {
-    // Just update the entry, do not remove from the list. Removing entries in the list
-    // is unsafe when mutators are iterating over it.
-    *it = nullptr;
+  for (std::atomic<InstrumentationListener*>& slot : array) {
+    // Just null the entry, do not compact the array. Compacting is unsafe when mutators are
+    // iterating over it.
+    InstrumentationListener* expected = listener;
+    if (slot.compare_exchange_strong(expected, nullptr, std::memory_order_release)) {
+      break;
+    }
   }
 
-  // Check if the list contains any non-null listener, and update 'has_listener'.
-  for (InstrumentationListener* l : list) {
-    if (l != nullptr) {
-      Runtime::DoAndMaybeSwitchInterpreter([=](){ *has_listener = true; });
-      return;
+  // Recompute 'has_listener' under the thread list lock (taken by DoAndMaybeSwitchInterpreter) so
+  // that concurrent listener changes settle on a flag consistent with the last array update.
+  Runtime::DoAndMaybeSwitchInterpreter([&array, has_listener]() {
+    bool has = false;
+    for (const std::atomic<InstrumentationListener*>& slot : array) {
+      if (slot.load(std::memory_order_acquire) != nullptr) {
+        has = true;
+        break;
+      }
     }
-  }
-  Runtime::DoAndMaybeSwitchInterpreter([=](){ *has_listener = false; });
+    *has_listener = has;
+  });
 }
 
 void Instrumentation::RemoveListener(InstrumentationListener* listener, uint32_t events) {
-  Locks::mutator_lock_->AssertExclusiveHeld(Thread::Current());
   PotentiallyRemoveListenerFrom(kMethodEntered,
                                 events,
                                 method_entry_listeners_,
@@ -1207,7 +1216,8 @@ void Instrumentation::MethodEnterEventImpl(Thread* thread,
     Thread* self = Thread::Current();
     StackHandleScope<1> hs(self);
     Handle<mirror::Object> thiz(hs.NewHandle(this_object));
-    for (InstrumentationListener* listener : method_entry_listeners_) {
+    for (const std::atomic<InstrumentationListener*>& slot : method_entry_listeners_) {
+      InstrumentationListener* listener = slot.load(std::memory_order_acquire);
       if (listener != nullptr) {
         listener->MethodEntered(thread, thiz, method, dex_pc);
       }
@@ -1226,7 +1236,8 @@ void Instrumentation::MethodExitEventImpl(Thread* thread,
     Thread* self = Thread::Current();
     StackHandleScope<1> hs(self);
     Handle<mirror::Object> thiz(hs.NewHandle(this_object));
-    for (InstrumentationListener* listener : method_exit_listeners_) {
+    for (const std::atomic<InstrumentationListener*>& slot : method_exit_listeners_) {
+      InstrumentationListener* listener = slot.load(std::memory_order_acquire);
       if (listener != nullptr) {
         listener->MethodExited(thread, thiz, method, dex_pc, frame, return_value);
       }
@@ -1246,7 +1257,8 @@ template<> void Instrumentation::MethodExitEventImpl(Thread* thread,
     Handle<mirror::Object> thiz(hs.NewHandle(this_object));
     if (method->GetInterfaceMethodIfProxy(kRuntimePointerSize)->GetReturnTypePrimitive() !=
         Primitive::kPrimNot) {
-      for (InstrumentationListener* listener : method_exit_listeners_) {
+      for (const std::atomic<InstrumentationListener*>& slot : method_exit_listeners_) {
+        InstrumentationListener* listener = slot.load(std::memory_order_acquire);
         if (listener != nullptr) {
           listener->MethodExited(thread, thiz, method, dex_pc, frame, return_value);
         }
@@ -1267,7 +1279,8 @@ void Instrumentation::MethodUnwindEvent(Thread* thread,
     Thread* self = Thread::Current();
     StackHandleScope<1> hs(self);
     Handle<mirror::Object> thiz(hs.NewHandle(this_object));
-    for (InstrumentationListener* listener : method_unwind_listeners_) {
+    for (const std::atomic<InstrumentationListener*>& slot : method_unwind_listeners_) {
+      InstrumentationListener* listener = slot.load(std::memory_order_acquire);
       if (listener != nullptr) {
         listener->MethodUnwind(thread, thiz, method, dex_pc);
       }
@@ -1282,7 +1295,8 @@ void Instrumentation::DexPcMovedEventImpl(Thread* thread,
   Thread* self = Thread::Current();
   StackHandleScope<1> hs(self);
   Handle<mirror::Object> thiz(hs.NewHandle(this_object));
-  for (InstrumentationListener* listener : dex_pc_listeners_) {
+  for (const std::atomic<InstrumentationListener*>& slot : dex_pc_listeners_) {
+    InstrumentationListener* listener = slot.load(std::memory_order_acquire);
     if (listener != nullptr) {
       listener->DexPcMoved(thread, thiz, method, dex_pc);
     }
@@ -1293,7 +1307,8 @@ void Instrumentation::BranchImpl(Thread* thread,
                                  ArtMethod* method,
                                  uint32_t dex_pc,
                                  int32_t offset) const {
-  for (InstrumentationListener* listener : branch_listeners_) {
+  for (const std::atomic<InstrumentationListener*>& slot : branch_listeners_) {
+    InstrumentationListener* listener = slot.load(std::memory_order_acquire);
     if (listener != nullptr) {
       listener->Branch(thread, method, dex_pc, offset);
     }
@@ -1301,7 +1316,8 @@ void Instrumentation::BranchImpl(Thread* thread,
 }
 
 void Instrumentation::WatchedFramePopImpl(Thread* thread, const ShadowFrame& frame) const {
-  for (InstrumentationListener* listener : watched_frame_pop_listeners_) {
+  for (const std::atomic<InstrumentationListener*>& slot : watched_frame_pop_listeners_) {
+    InstrumentationListener* listener = slot.load(std::memory_order_acquire);
     if (listener != nullptr) {
       listener->WatchedFramePop(thread, frame);
     }
@@ -1316,7 +1332,8 @@ void Instrumentation::FieldReadEventImpl(Thread* thread,
   Thread* self = Thread::Current();
   StackHandleScope<1> hs(self);
   Handle<mirror::Object> thiz(hs.NewHandle(this_object));
-  for (InstrumentationListener* listener : field_read_listeners_) {
+  for (const std::atomic<InstrumentationListener*>& slot : field_read_listeners_) {
+    InstrumentationListener* listener = slot.load(std::memory_order_acquire);
     if (listener != nullptr) {
       listener->FieldRead(thread, thiz, method, dex_pc, field);
     }
@@ -1333,14 +1350,16 @@ void Instrumentation::FieldWriteEventImpl(Thread* thread,
   StackHandleScope<2> hs(self);
   Handle<mirror::Object> thiz(hs.NewHandle(this_object));
   if (field->IsPrimitiveType()) {
-    for (InstrumentationListener* listener : field_write_listeners_) {
+    for (const std::atomic<InstrumentationListener*>& slot : field_write_listeners_) {
+      InstrumentationListener* listener = slot.load(std::memory_order_acquire);
       if (listener != nullptr) {
         listener->FieldWritten(thread, thiz, method, dex_pc, field, field_value);
       }
     }
   } else {
     Handle<mirror::Object> val(hs.NewHandle(field_value.GetL()));
-    for (InstrumentationListener* listener : field_write_listeners_) {
+    for (const std::atomic<InstrumentationListener*>& slot : field_write_listeners_) {
+      InstrumentationListener* listener = slot.load(std::memory_order_acquire);
       if (listener != nullptr) {
         listener->FieldWritten(thread, thiz, method, dex_pc, field, val);
       }
@@ -1356,7 +1375,8 @@ void Instrumentation::ExceptionThrownEvent(Thread* thread,
   if (HasExceptionThrownListeners()) {
     DCHECK_EQ(thread->GetException(), h_exception.Get());
     thread->ClearException();
-    for (InstrumentationListener* listener : exception_thrown_listeners_) {
+    for (const std::atomic<InstrumentationListener*>& slot : exception_thrown_listeners_) {
+      InstrumentationListener* listener = slot.load(std::memory_order_acquire);
       if (listener != nullptr) {
         listener->ExceptionThrown(thread, h_exception);
       }
@@ -1375,7 +1395,8 @@ void Instrumentation::ExceptionHandledEvent(Thread* thread,
   if (HasExceptionHandledListeners()) {
     // We should have cleared the exception so that callers can detect a new one.
     DCHECK(thread->GetException() == nullptr);
-    for (InstrumentationListener* listener : exception_handled_listeners_) {
+    for (const std::atomic<InstrumentationListener*>& slot : exception_handled_listeners_) {
+      InstrumentationListener* listener = slot.load(std::memory_order_acquire);
       if (listener != nullptr) {
         listener->ExceptionHandled(thread, h_exception);
       }
@@ -19,7 +19,8 @@
 
 #include <functional>
 #include <stdint.h>
-#include <list>
+#include <array>
+#include <atomic>
 #include <memory>
 #include <unordered_set>
 #include <optional>
@@ -207,18 +208,28 @@ class Instrumentation {
     kInstrumentWithInterpreter            // execute with interpreter
   };
 
+  // Fixed-size storage for the listeners of one event kind. Entries are atomic so that listeners
+  // can be published or cleared while mutators are concurrently dispatching events; the storage
+  // itself is never resized or relinked.
+  static constexpr size_t kMaxListenersPerEvent = 16;
+  using ListenerArray = std::array<std::atomic<InstrumentationListener*>, kMaxListenersPerEvent>;
+
   Instrumentation();
 
-  // Add a listener to be notified of the masked together sent of instrumentation events. This
-  // suspend the runtime to install stubs. You are expected to hold the mutator lock as a proxy
-  // for saying you should have suspended all threads (installing stubs while threads are running
-  // will break).
+  // Add a listener to be notified of the masked together set of instrumentation events. Raising
+  // any of these events still requires the matching instrumentation level to be active (see
+  // ConfigureStubs), but the listener itself is published into an atomic slot, so listeners may
+  // be added under the shared mutator lock without suspending all threads.
   void AddListener(InstrumentationListener* listener, uint32_t events)
-      REQUIRES(Locks::mutator_lock_, !Locks::thread_list_lock_, !Locks::classlinker_classes_lock_);
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!Locks::thread_list_lock_, !Locks::classlinker_classes_lock_);
 
-  // Removes a listener possibly removing instrumentation stubs.
+  // Removes a listener. Slots are only nulled, never unlinked, so mutators concurrently iterating
+  // over the listener arrays remain valid; like AddListener this only needs the shared mutator
+  // lock.
   void RemoveListener(InstrumentationListener* listener, uint32_t events)
-      REQUIRES(Locks::mutator_lock_, !Locks::thread_list_lock_, !Locks::classlinker_classes_lock_);
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!Locks::thread_list_lock_, !Locks::classlinker_classes_lock_);
 
   // Deoptimization.
   void EnableDeoptimization()
@@ -582,7 +593,7 @@ class Instrumentation {
                !Locks::thread_list_lock_,
                !Locks::classlinker_classes_lock_);
 
-  void UpdateInterpreterHandlerTable() REQUIRES(Locks::mutator_lock_) {
+  void UpdateInterpreterHandlerTable() REQUIRES_SHARED(Locks::mutator_lock_) {
     /*
      * TUNING: Dalvik's mterp stashes the actual current handler table base in a
      * tls field.  For Arm, this enables all suspend, debug & tracing checks to be
@@ -672,67 +683,64 @@ class Instrumentation {
   bool forced_interpret_only_;
 
   // Do we have any listeners for method entry events? Short-cut to avoid taking the
-  // instrumentation_lock_.
-  bool have_method_entry_listeners_ GUARDED_BY(Locks::mutator_lock_);
+  // instrumentation_lock_. Atomic since it is updated while mutators are running.
+  std::atomic<bool> have_method_entry_listeners_;
 
   // Do we have any listeners for method exit events? Short-cut to avoid taking the
   // instrumentation_lock_.
-  bool have_method_exit_listeners_ GUARDED_BY(Locks::mutator_lock_);
+  std::atomic<bool> have_method_exit_listeners_;
 
   // Do we have any listeners for method unwind events? Short-cut to avoid taking the
   // instrumentation_lock_.
-  bool have_method_unwind_listeners_ GUARDED_BY(Locks::mutator_lock_);
+  std::atomic<bool> have_method_unwind_listeners_;
 
   // Do we have any listeners for dex move events? Short-cut to avoid taking the
   // instrumentation_lock_.
-  bool have_dex_pc_listeners_ GUARDED_BY(Locks::mutator_lock_);
+  std::atomic<bool> have_dex_pc_listeners_;
 
   // Do we have any listeners for field read events? Short-cut to avoid taking the
   // instrumentation_lock_.
-  bool have_field_read_listeners_ GUARDED_BY(Locks::mutator_lock_);
+  std::atomic<bool> have_field_read_listeners_;
 
   // Do we have any listeners for field write events? Short-cut to avoid taking the
   // instrumentation_lock_.
-  bool have_field_write_listeners_ GUARDED_BY(Locks::mutator_lock_);
+  std::atomic<bool> have_field_write_listeners_;
 
   // Do we have any exception thrown listeners? Short-cut to avoid taking the instrumentation_lock_.
-  bool have_exception_thrown_listeners_ GUARDED_BY(Locks::mutator_lock_);
+  std::atomic<bool> have_exception_thrown_listeners_;
 
   // Do we have any frame pop listeners? Short-cut to avoid taking the instrumentation_lock_.
-  bool have_watched_frame_pop_listeners_ GUARDED_BY(Locks::mutator_lock_);
+  std::atomic<bool> have_watched_frame_pop_listeners_;
 
   // Do we have any branch listeners? Short-cut to avoid taking the instrumentation_lock_.
-  bool have_branch_listeners_ GUARDED_BY(Locks::mutator_lock_);
+  std::atomic<bool> have_branch_listeners_;
 
   // Do we have any exception handled listeners? Short-cut to avoid taking the
   // instrumentation_lock_.
-  bool have_exception_handled_listeners_ GUARDED_BY(Locks::mutator_lock_);
+  std::atomic<bool> have_exception_handled_listeners_;
 
   // Contains the instrumentation level required by each client of the instrumentation identified
   // by a string key.
   typedef SafeMap<const char*, InstrumentationLevel> InstrumentationLevelTable;
   InstrumentationLevelTable requested_instrumentation_levels_ GUARDED_BY(Locks::mutator_lock_);
 
-  // The event listeners, written to with the mutator_lock_ exclusively held.
-  // Mutators must be able to iterate over these lists concurrently, that is, with listeners being
-  // added or removed while iterating. The modifying thread holds exclusive lock,
-  // so other threads cannot iterate (i.e. read the data of the list) at the same time but they
-  // do keep iterators that need to remain valid. This is the reason these listeners are std::list
-  // and not for example std::vector: the existing storage for a std::list does not move.
-  // Note that mutators cannot make a copy of these lists before iterating, as the instrumentation
-  // listeners can also be deleted concurrently.
-  // As a result, these lists are never trimmed. That's acceptable given the low number of
-  // listeners we have.
-  std::list<InstrumentationListener*> method_entry_listeners_ GUARDED_BY(Locks::mutator_lock_);
-  std::list<InstrumentationListener*> method_exit_listeners_ GUARDED_BY(Locks::mutator_lock_);
-  std::list<InstrumentationListener*> method_unwind_listeners_ GUARDED_BY(Locks::mutator_lock_);
-  std::list<InstrumentationListener*> branch_listeners_ GUARDED_BY(Locks::mutator_lock_);
-  std::list<InstrumentationListener*> dex_pc_listeners_ GUARDED_BY(Locks::mutator_lock_);
-  std::list<InstrumentationListener*> field_read_listeners_ GUARDED_BY(Locks::mutator_lock_);
-  std::list<InstrumentationListener*> field_write_listeners_ GUARDED_BY(Locks::mutator_lock_);
-  std::list<InstrumentationListener*> exception_thrown_listeners_ GUARDED_BY(Locks::mutator_lock_);
-  std::list<InstrumentationListener*> watched_frame_pop_listeners_ GUARDED_BY(Locks::mutator_lock_);
-  std::list<InstrumentationListener*> exception_handled_listeners_ GUARDED_BY(Locks::mutator_lock_);
+  // The event listeners. Mutators iterate over these arrays concurrently with listeners being
+  // added and removed, so entries are only ever written with atomic operations: adding a listener
+  // publishes it into a null slot with a release store and removing one nulls the slot out,
+  // leaving the storage itself untouched. This is what allows listeners to be toggled under the
+  // shared mutator lock instead of suspending all threads. The capacity is fixed; we only ever
+  // have a handful of listeners (debugger, method tracing, jvmti agents) and AddListener checks
+  // for overflow.
+  ListenerArray method_entry_listeners_ = {};
+  ListenerArray method_exit_listeners_ = {};
+  ListenerArray method_unwind_listeners_ = {};
+  ListenerArray branch_listeners_ = {};
+  ListenerArray dex_pc_listeners_ = {};
+  ListenerArray field_read_listeners_ = {};
+  ListenerArray field_write_listeners_ = {};
+  ListenerArray exception_thrown_listeners_ = {};
+  ListenerArray watched_frame_pop_listeners_ = {};
+  ListenerArray exception_handled_listeners_ = {};
 
   // The set of methods being deoptimized (by the debugger) which must be executed with interpreter
   // only.
@@ -741,8 +749,8 @@ class Instrumentation {
   bool deoptimization_enabled_;
 
   // Current interpreter handler table. This is updated each time the thread state flags are
-  // modified.
-  InterpreterHandlerTable interpreter_handler_table_ GUARDED_BY(Locks::mutator_lock_);
+  // modified. Atomic since listener changes update it without exclusive mutator access.
+  std::atomic<InterpreterHandlerTable> interpreter_handler_table_;
 
   // Greater than 0 if quick alloc entry points instrumented.
   size_t quick_alloc_entry_points_instrumentation_counter_;
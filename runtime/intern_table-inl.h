@@ -71,13 +71,14 @@ inline void InternTable::Table::AddInternStrings(UnorderedSet&& intern_strings,
   // Insert at the front since we add new interns into the back.
   tables_.insert(tables_.begin(),
                  InternalTable(std::move(intern_strings), is_boot_image));
+  PublishFrozenTables();
 }
 
 template <typename Visitor>
 inline void InternTable::VisitInterns(const Visitor& visitor,
                                       bool visit_boot_images,
                                       bool visit_non_boot_images) {
-  auto visit_tables = [&](std::vector<Table::InternalTable>& tables)
+  auto visit_tables = [&](std::deque<Table::InternalTable>& tables)
       NO_THREAD_SAFETY_ANALYSIS {
     for (Table::InternalTable& table : tables) {
       // Determine if we want to visit the table based on the flags..
@@ -98,7 +99,7 @@ inline void InternTable::VisitInterns(const Visitor& visitor,
 inline size_t InternTable::CountInterns(bool visit_boot_images,
                                         bool visit_non_boot_images) const {
   size_t ret = 0u;
-  auto visit_tables = [&](const std::vector<Table::InternalTable>& tables)
+  auto visit_tables = [&](const std::deque<Table::InternalTable>& tables)
       NO_THREAD_SAFETY_ANALYSIS {
     for (const Table::InternalTable& table : tables) {
       // Determine if we want to visit the table based on the flags..
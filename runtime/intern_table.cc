@@ -95,6 +95,12 @@ ObjPtr<mirror::String> InternTable::LookupWeak(Thread* self, ObjPtr<mirror::Stri
 }
 
 ObjPtr<mirror::String> InternTable::LookupStrong(Thread* self, ObjPtr<mirror::String> s) {
+  // Most strong interns live in the frozen boot image and pre-zygote tables; check those
+  // without taking the lock first.
+  ObjPtr<mirror::String> found = strong_interns_.FindFrozen(s);
+  if (found != nullptr) {
+    return found;
+  }
   MutexLock mu(self, *Locks::intern_table_lock_);
   return LookupStrongLocked(s);
 }
@@ -106,6 +112,12 @@ ObjPtr<mirror::String> InternTable::LookupStrong(Thread* self,
   Utf8String string(utf16_length,
                     utf8_data,
                     ComputeUtf16HashFromModifiedUtf8(utf8_data, utf16_length));
+  // Most strong interns live in the frozen boot image and pre-zygote tables; check those
+  // without taking the lock first.
+  ObjPtr<mirror::String> found = strong_interns_.FindFrozen(string);
+  if (found != nullptr) {
+    return found;
+  }
   MutexLock mu(self, *Locks::intern_table_lock_);
   return strong_interns_.Find(string);
 }
@@ -203,6 +215,13 @@ ObjPtr<mirror::String> InternTable::Insert(ObjPtr<mirror::String> s,
   if (s == nullptr) {
     return nullptr;
   }
+  // If the string is already strong-interned in one of the frozen tables, return it without
+  // taking the lock. This matches the strong-table check inside the loop below, which returns
+  // an existing strong intern for both strong and weak requests.
+  ObjPtr<mirror::String> frozen_strong = strong_interns_.FindFrozen(s);
+  if (frozen_strong != nullptr) {
+    return frozen_strong;
+  }
   Thread* const self = Thread::Current();
   MutexLock mu(self, *Locks::intern_table_lock_);
   if (kDebugLocking && !holding_locks) {
@@ -410,8 +429,50 @@ ObjPtr<mirror::String> InternTable::Table::Find(const Utf8String& string) {
   return nullptr;
 }
 
+ObjPtr<mirror::String> InternTable::Table::FindFrozen(ObjPtr<mirror::String> s) {
+  const std::vector<const UnorderedSet*>* const frozen =
+      frozen_tables_.load(std::memory_order_acquire);
+  if (frozen != nullptr) {
+    for (const UnorderedSet* set : *frozen) {
+      auto it = set->find(GcRoot<mirror::String>(s));
+      if (it != set->end()) {
+        return it->Read();
+      }
+    }
+  }
+  return nullptr;
+}
+
+ObjPtr<mirror::String> InternTable::Table::FindFrozen(const Utf8String& string) {
+  const std::vector<const UnorderedSet*>* const frozen =
+      frozen_tables_.load(std::memory_order_acquire);
+  if (frozen != nullptr) {
+    for (const UnorderedSet* set : *frozen) {
+      auto it = set->find(string);
+      if (it != set->end()) {
+        return it->Read();
+      }
+    }
+  }
+  return nullptr;
+}
+
+void InternTable::Table::PublishFrozenTables() {
+  std::unique_ptr<std::vector<const UnorderedSet*>> snapshot(
+      new std::vector<const UnorderedSet*>());
+  // All tables but the back one are frozen and safe to search without the lock.
+  for (size_t i = 0; i + 1 < tables_.size(); ++i) {
+    snapshot->push_back(&tables_[i].set_);
+  }
+  // Release ordering pairs with the acquire load in FindFrozen so that readers observe the
+  // fully constructed snapshot.
+  frozen_tables_.store(snapshot.get(), std::memory_order_release);
+  retired_frozen_tables_.push_back(std::move(snapshot));
+}
+
 void InternTable::Table::AddNewTable() {
   tables_.push_back(InternalTable());
+  PublishFrozenTables();
 }
 
 void InternTable::Table::Insert(ObjPtr<mirror::String> s) {
@@ -17,7 +17,12 @@
 #ifndef ART_RUNTIME_INTERN_TABLE_H_
 #define ART_RUNTIME_INTERN_TABLE_H_
 
+#include <deque>
+#include <memory>
+#include <vector>
+
 #include "base/allocator.h"
+#include "base/atomic.h"
 #include "base/hash_set.h"
 #include "base/mutex.h"
 #include "gc/weak_root_state.h"
@@ -245,6 +250,13 @@ class InternTable {
         REQUIRES(Locks::intern_table_lock_);
     ObjPtr<mirror::String> Find(const Utf8String& string) REQUIRES_SHARED(Locks::mutator_lock_)
         REQUIRES(Locks::intern_table_lock_);
+    // Find a string in the frozen tables (all but the last one) without taking the intern table
+    // lock. Frozen tables are never inserted into or erased from, so searching them only needs
+    // an acquire load of the published snapshot.
+    ObjPtr<mirror::String> FindFrozen(ObjPtr<mirror::String> s)
+        REQUIRES_SHARED(Locks::mutator_lock_);
+    ObjPtr<mirror::String> FindFrozen(const Utf8String& string)
+        REQUIRES_SHARED(Locks::mutator_lock_);
     void Insert(ObjPtr<mirror::String> s) REQUIRES_SHARED(Locks::mutator_lock_)
         REQUIRES(Locks::intern_table_lock_);
     void Remove(ObjPtr<mirror::String> s)
@@ -276,9 +288,24 @@ class InternTable {
     void AddInternStrings(UnorderedSet&& intern_strings, bool is_boot_image)
         REQUIRES(Locks::intern_table_lock_) REQUIRES_SHARED(Locks::mutator_lock_);
 
+    // Publish a new snapshot of the frozen tables for lock-free lookups. Must be called
+    // whenever the number or order of tables changes.
+    void PublishFrozenTables() REQUIRES(Locks::intern_table_lock_);
+
     // We call AddNewTable when we create the zygote to reduce private dirty pages caused by
     // modifying the zygote intern table. The back of table is modified when strings are interned.
-    std::vector<InternalTable> tables_;
+    // A deque is used instead of a vector so that adding a new table does not relocate the
+    // existing ones, which lock-free readers may be searching concurrently.
+    std::deque<InternalTable> tables_;
+    // Snapshot of the frozen tables, i.e. all but the mutable table at the back of tables_.
+    // Boot image and pre-zygote tables are never inserted into or erased from (strings are only
+    // interned into the back table and removals target strings interned after the last
+    // freeze), so readers may search them without holding the intern table lock. Rebuilt under
+    // the lock by PublishFrozenTables; superseded snapshots are retired rather than freed since
+    // racing readers may still be iterating them.
+    Atomic<const std::vector<const UnorderedSet*>*> frozen_tables_{nullptr};
+    std::vector<std::unique_ptr<const std::vector<const UnorderedSet*>>> retired_frozen_tables_
+        GUARDED_BY(Locks::intern_table_lock_);
 
     friend class InternTable;
     friend class linker::ImageWriter;
@@ -244,6 +244,14 @@ static constexpr InterpreterImplKind kInterpreterImplKind = kSwitchImplKind;
 static constexpr InterpreterImplKind kInterpreterImplKind = kMterpImplKind;
 #endif
 
+bool NeedsSwitchImplInstrumentation() {
+  // The handler table is kept in sync with listener (de)registration, so it serves
+  // as a single aggregate "any listeners installed" flag (see
+  // Instrumentation::UpdateInterpreterHandlerTable()).
+  return Runtime::Current()->GetInstrumentation()->GetInterpreterHandlerTable() ==
+      instrumentation::kAlternativeHandlerTable;
+}
+
 static inline JValue Execute(
     Thread* self,
     const CodeItemDataAccessor& accessor,
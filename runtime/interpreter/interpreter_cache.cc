@@ -15,6 +15,9 @@
  */
 
 #include "interpreter_cache.h"
+
+#include <utility>
+
 #include "thread-inl.h"
 
 namespace art {
@@ -23,6 +26,21 @@ void InterpreterCache::Clear(Thread* owning_thread) {
   DCHECK(owning_thread->GetInterpreterCache() == this);
   DCHECK(owning_thread == Thread::Current() || owning_thread->IsSuspended());
   data_.fill(Entry{});
+  victim_data_.fill(Entry{});
+}
+
+bool InterpreterCache::GetFromVictimCache(const void* key, /* out */ size_t* value) {
+  for (Entry& entry : victim_data_) {
+    if (entry.first == key) {
+      // Promote the entry back to the direct-mapped array so that the assembly
+      // fast paths can see it, demoting the entry it conflicts with.
+      Entry& main_entry = data_[IndexOf(key)];
+      std::swap(entry, main_entry);
+      *value = main_entry.second;
+      return true;
+    }
+  }
+  return false;
 }
 
 bool InterpreterCache::IsCalledFromOwningThread() {
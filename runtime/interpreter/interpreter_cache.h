@@ -53,10 +53,18 @@ class ALIGNED(16) InterpreterCache {
   // Value of 256 has around 75% cache hit rate.
   static constexpr size_t kSize = 256;
 
-  InterpreterCache() {
+  // Size of the second-level victim tier. Entries evicted from the direct-mapped
+  // array are kept here and can be found again by the C++ slow paths, which
+  // shields hot entries from conflict misses with entries sharing their index.
+  // It is probed linearly and only from C++; the assembly fast paths are
+  // unaware of it.
+  static constexpr size_t kVictimCacheSize = 8;
+
+  InterpreterCache() : victim_index_(0u) {
     // We can not use the Clear() method since the constructor will not
     // be called from the owning thread.
     data_.fill(Entry{});
+    victim_data_.fill(Entry{});
   }
 
   // Clear the whole cache. It requires the owning thread for DCHECKs.
@@ -69,21 +77,36 @@ class ALIGNED(16) InterpreterCache {
       *value = entry.second;
       return true;
     }
-    return false;
+    return GetFromVictimCache(key, value);
   }
 
   ALWAYS_INLINE void Set(const void* key, size_t value) {
     DCHECK(IsCalledFromOwningThread());
-    data_[IndexOf(key)] = Entry{key, value};
+    Entry& entry = data_[IndexOf(key)];
+    if (entry.first != nullptr && entry.first != key) {
+      // Keep the conflicting entry around in the victim tier; re-resolving it
+      // through the class linker is far more expensive than the extra copy.
+      victim_data_[victim_index_] = entry;
+      victim_index_ = (victim_index_ + 1u) % kVictimCacheSize;
+    }
+    entry = Entry{key, value};
   }
 
   std::array<Entry, kSize>& GetArray() {
     return data_;
   }
 
+  std::array<Entry, kVictimCacheSize>& GetVictimArray() {
+    return victim_data_;
+  }
+
  private:
   bool IsCalledFromOwningThread();
 
+  // Slow-path part of Get. On a hit, the entry is promoted back to the
+  // direct-mapped array and the entry it replaces is demoted in its stead.
+  bool GetFromVictimCache(const void* key, /* out */ size_t* value);
+
   static ALWAYS_INLINE size_t IndexOf(const void* key) {
     static_assert(IsPowerOfTwo(kSize), "Size must be power of two");
     size_t index = (reinterpret_cast<uintptr_t>(key) >> 2) & (kSize - 1);
@@ -92,6 +115,12 @@ class ALIGNED(16) InterpreterCache {
   }
 
   std::array<Entry, kSize> data_;
+
+  // Victim tier holding recently evicted entries, filled round-robin.
+  // It must come after `data_` as the assembly fast paths index off the
+  // start of the cache.
+  std::array<Entry, kVictimCacheSize> victim_data_;
+  size_t victim_index_;
 };
 
 }  // namespace art
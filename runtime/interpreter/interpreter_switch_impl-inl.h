@@ -50,7 +50,8 @@ namespace interpreter {
 // The function names must match the names from dex_instruction_list.h and have no arguments.
 // Return value: The handlers must return false if the instruction throws or returns (exits).
 //
-template<bool do_access_check, bool transaction_active, Instruction::Format kFormat>
+template<bool do_access_check, bool transaction_active, bool do_instrumentation,
+         Instruction::Format kFormat>
 class InstructionHandler {
  public:
 #define HANDLER_ATTRIBUTES ALWAYS_INLINE FLATTEN WARN_UNUSED REQUIRES_SHARED(Locks::mutator_lock_)
@@ -129,7 +130,7 @@ class InstructionHandler {
     if (!CheckForceReturn()) {
       return false;
     }
-    if (UNLIKELY(instrumentation->HasDexPcListeners())) {
+    if (do_instrumentation && UNLIKELY(instrumentation->HasDexPcListeners())) {
       uint8_t opcode = inst->Opcode(inst_data);
       bool is_move_result_object = (opcode == Instruction::MOVE_RESULT_OBJECT);
       JValue* save_ref = is_move_result_object ? &ctx->result_register : nullptr;
@@ -152,7 +153,7 @@ class InstructionHandler {
   }
 
   HANDLER_ATTRIBUTES bool BranchInstrumentation(int32_t offset) {
-    if (UNLIKELY(instrumentation->HasBranchListeners())) {
+    if (do_instrumentation && UNLIKELY(instrumentation->HasBranchListeners())) {
       instrumentation->Branch(self, shadow_frame.GetMethod(), dex_pc, offset);
     }
     JValue result;
@@ -314,6 +315,35 @@ class InstructionHandler {
     return true;
   }
 
+  // Superinstruction fusion for the common `const` + `if-eqz`/`if-nez` pair: when the
+  // next instruction tests the register the `const` just defined, evaluate the branch
+  // here and save one round trip through the dispatch loop. The branch executes with
+  // its own dex pc and instrumentation protocol through a handler set up for the `if`.
+  // Fusion is skipped when dex pc listeners are installed, as the fused branch does
+  // not run its Preamble().
+  HANDLER_ATTRIBUTES bool MaybeFuseConstWithIfZ(uint32_t dst, int32_t val) {
+    const Instruction* if_inst = next;  // The fall-through set up by the dispatch loop.
+    const Instruction::Code if_opcode = if_inst->Opcode();
+    if ((if_opcode != Instruction::IF_EQZ && if_opcode != Instruction::IF_NEZ) ||
+        (do_instrumentation && UNLIKELY(instrumentation->HasDexPcListeners())) ||
+        UNLIKELY(ctx->interpret_one_instruction)) {
+      return true;
+    }
+    const uint16_t if_inst_data = if_inst->Fetch16(0);
+    if (if_inst->VRegA_21t(if_inst_data) != dst) {
+      return true;
+    }
+    const uint32_t if_dex_pc = if_inst->GetDexPc(Insns());
+    shadow_frame.SetDexPC(if_dex_pc);
+    // Set up the fall-through for the not-taken case, as the dispatch loop would.
+    SetNextInstruction(if_inst->RelativeAt(Instruction::SizeInCodeUnits(Instruction::k21t)));
+    InstructionHandler<do_access_check, transaction_active, do_instrumentation, Instruction::k21t>
+        if_handler(ctx, instrumentation, self, shadow_frame, if_dex_pc, if_inst, if_inst_data,
+                   next, exit_interpreter_loop);
+    const bool cond = (if_opcode == Instruction::IF_EQZ) ? (val == 0) : (val != 0);
+    return if_handler.HandleIf(cond, if_inst->VRegB_21t());
+  }
+
   template<typename ArrayType, typename SetVRegFn>
   HANDLER_ATTRIBUTES bool HandleAGet(SetVRegFn setVReg) {
     ObjPtr<mirror::Object> a = GetVRegReference(B());
@@ -539,7 +569,7 @@ class InstructionHandler {
     if (val == 0) {
       SetVRegReference(dst, nullptr);
     }
-    return true;
+    return MaybeFuseConstWithIfZ(dst, val);
   }
 
   HANDLER_ATTRIBUTES bool CONST_16() {
@@ -549,7 +579,7 @@ class InstructionHandler {
     if (val == 0) {
       SetVRegReference(dst, nullptr);
     }
-    return true;
+    return MaybeFuseConstWithIfZ(dst, val);
   }
 
   HANDLER_ATTRIBUTES bool CONST() {
@@ -559,7 +589,7 @@ class InstructionHandler {
     if (val == 0) {
       SetVRegReference(dst, nullptr);
     }
-    return true;
+    return MaybeFuseConstWithIfZ(dst, val);
   }
 
   HANDLER_ATTRIBUTES bool CONST_HIGH16() {
@@ -1916,7 +1946,7 @@ class InstructionHandler {
 #endif
 
 #define OPCODE_CASE(OPCODE, OPCODE_NAME, NAME, FORMAT, i, a, e, v)                                \
-template<bool do_access_check, bool transaction_active>                                           \
+template<bool do_access_check, bool transaction_active, bool do_instrumentation>                  \
 ASAN_NO_INLINE static bool OP_##OPCODE_NAME(                                                      \
     SwitchImplContext* ctx,                                                                       \
     const instrumentation::Instrumentation* instrumentation,                                      \
@@ -1927,14 +1957,125 @@ ASAN_NO_INLINE static bool OP_##OPCODE_NAME(
     uint16_t inst_data,                                                                           \
     const Instruction*& next,                                                                     \
     bool& exit) REQUIRES_SHARED(Locks::mutator_lock_) {                                           \
-  InstructionHandler<do_access_check, transaction_active, Instruction::FORMAT> handler(           \
+  InstructionHandler<do_access_check, transaction_active, do_instrumentation,                     \
+                     Instruction::FORMAT> handler(                                                \
       ctx, instrumentation, self, shadow_frame, dex_pc, inst, inst_data, next, exit);             \
   return LIKELY(handler.OPCODE_NAME());                                                           \
 }
 DEX_INSTRUCTION_LIST(OPCODE_CASE)
 #undef OPCODE_CASE
 
-template<bool do_access_check, bool transaction_active>
+#if defined(ART_USE_COMPUTED_GOTO_INTERPRETER) && ART_USE_COMPUTED_GOTO_INTERPRETER
+
+// Direct-threaded variant of the dispatch loop, enabled at build time with
+// -DART_USE_COMPUTED_GOTO_INTERPRETER=1. It uses the GNU labels-as-values
+// extension so that every handler ends with its own indirect jump to the next
+// handler, giving the branch predictor one history slot per opcode instead of
+// a single shared dispatch branch. The per-opcode handler functions are the
+// same as in the switch-based variant below; only the dispatch differs.
+template<bool do_access_check, bool transaction_active, bool do_instrumentation>
+void ExecuteSwitchImplCpp(SwitchImplContext* ctx) {
+  Thread* self = ctx->self;
+  const CodeItemDataAccessor& accessor = ctx->accessor;
+  ShadowFrame& shadow_frame = ctx->shadow_frame;
+  self->VerifyStack();
+
+  uint32_t dex_pc = shadow_frame.GetDexPC();
+  const auto* const instrumentation = Runtime::Current()->GetInstrumentation();
+  const uint16_t* const insns = accessor.Insns();
+  const Instruction* next = Instruction::At(insns + dex_pc);
+
+  DCHECK(!shadow_frame.GetForceRetryInstruction())
+      << "Entered interpreter from invoke without retry instruction being handled!";
+
+  bool const interpret_one_instruction = ctx->interpret_one_instruction;
+  const Instruction* inst;
+  uint16_t inst_data;
+  bool exit = false;
+
+  static const void* const kDispatchTable[] = {
+#define OPCODE_LABEL(OPCODE, OPCODE_NAME, NAME, FORMAT, i, a, e, v) &&op_##OPCODE_NAME,
+  DEX_INSTRUCTION_LIST(OPCODE_LABEL)
+#undef OPCODE_LABEL
+  };
+
+// Per-instruction work shared by all handlers, ending in the indirect jump.
+// This mirrors one iteration head of the switch-based loop below.
+#define DISPATCH()                                                                                \
+  do {                                                                                            \
+    inst = next;                                                                                  \
+    dex_pc = inst->GetDexPc(insns);                                                               \
+    shadow_frame.SetDexPC(dex_pc);                                                                \
+    TraceExecution(shadow_frame, inst, dex_pc);                                                   \
+    if (!do_instrumentation &&                                                                    \
+        UNLIKELY(instrumentation->GetInterpreterHandlerTable() ==                                 \
+                 art::instrumentation::kAlternativeHandlerTable)) {                               \
+      /* Listeners attached while this frame was executing without per-instruction */             \
+      /* checks; restart in the instrumented implementation at the recorded pc.    */             \
+      ctx->switch_to_instrumented = true;                                                         \
+      return;                                                                                     \
+    }                                                                                             \
+    inst_data = inst->Fetch16(0);                                                                 \
+    exit = false;                                                                                 \
+    if (UNLIKELY(!InstructionHandler<do_access_check, transaction_active, do_instrumentation,     \
+                                     Instruction::kInvalidFormat>(                                \
+            ctx, instrumentation, self, shadow_frame, dex_pc, inst, inst_data, next, exit).       \
+            Preamble())) {                                                                        \
+      goto preamble_failed;                                                                       \
+    }                                                                                             \
+    goto* kDispatchTable[inst->Opcode(inst_data)];                                                \
+  } while (false)
+
+  DISPATCH();
+
+#define OPCODE_CASE(OPCODE, OPCODE_NAME, NAME, FORMAT, i, a, e, v)                                \
+  op_##OPCODE_NAME : {                                                                            \
+    DCHECK_EQ(self->IsExceptionPending(), (OPCODE == Instruction::MOVE_EXCEPTION));               \
+    next = inst->RelativeAt(Instruction::SizeInCodeUnits(Instruction::FORMAT));                   \
+    bool success = OP_##OPCODE_NAME<do_access_check, transaction_active, do_instrumentation>(     \
+        ctx, instrumentation, self, shadow_frame, dex_pc, inst, inst_data, next, exit);           \
+    if (LIKELY(success) && LIKELY(!interpret_one_instruction)) {                                  \
+      DCHECK(!exit) << NAME;                                                                      \
+      DISPATCH();                                                                                 \
+    }                                                                                             \
+    if (exit) {                                                                                   \
+      shadow_frame.SetDexPC(dex::kDexNoIndex);                                                    \
+      return;                                                                                     \
+    }                                                                                             \
+    goto check_pending_exception;                                                                 \
+  }
+  DEX_INSTRUCTION_LIST(OPCODE_CASE)
+#undef OPCODE_CASE
+
+ preamble_failed:
+  // Preamble returned false due to debugger event.
+  if (exit) {
+    shadow_frame.SetDexPC(dex::kDexNoIndex);
+    return;  // Return statement or debugger forced exit.
+  }
+ check_pending_exception:
+  if (self->IsExceptionPending()) {
+    if (!InstructionHandler<do_access_check, transaction_active, do_instrumentation,
+                            Instruction::kInvalidFormat>(
+            ctx, instrumentation, self, shadow_frame, dex_pc, inst, inst_data, next, exit).
+            HandlePendingException()) {
+      shadow_frame.SetDexPC(dex::kDexNoIndex);
+      return;  // Locally unhandled exception - return to caller.
+    }
+    // Continue execution in the catch block.
+  }
+  if (interpret_one_instruction) {
+    shadow_frame.SetDexPC(next->GetDexPc(insns));  // Record where we stopped.
+    ctx->result = ctx->result_register;
+    return;
+  }
+  DISPATCH();
+#undef DISPATCH
+}  // NOLINT(readability/fn_size)
+
+#else  // !ART_USE_COMPUTED_GOTO_INTERPRETER
+
+template<bool do_access_check, bool transaction_active, bool do_instrumentation>
 void ExecuteSwitchImplCpp(SwitchImplContext* ctx) {
   Thread* self = ctx->self;
   const CodeItemDataAccessor& accessor = ctx->accessor;
@@ -1955,9 +2096,18 @@ void ExecuteSwitchImplCpp(SwitchImplContext* ctx) {
     dex_pc = inst->GetDexPc(insns);
     shadow_frame.SetDexPC(dex_pc);
     TraceExecution(shadow_frame, inst, dex_pc);
+    if (!do_instrumentation &&
+        UNLIKELY(instrumentation->GetInterpreterHandlerTable() ==
+                 art::instrumentation::kAlternativeHandlerTable)) {
+      // Listeners attached while this frame was executing without per-instruction
+      // checks; restart in the instrumented implementation at the recorded pc.
+      ctx->switch_to_instrumented = true;
+      return;
+    }
     uint16_t inst_data = inst->Fetch16(0);
     bool exit = false;
-    if (InstructionHandler<do_access_check, transaction_active, Instruction::kInvalidFormat>(
+    if (InstructionHandler<do_access_check, transaction_active, do_instrumentation,
+                           Instruction::kInvalidFormat>(
             ctx, instrumentation, self, shadow_frame, dex_pc, inst, inst_data, next, exit).
             Preamble()) {
       switch (inst->Opcode(inst_data)) {
@@ -1965,8 +2115,9 @@ void ExecuteSwitchImplCpp(SwitchImplContext* ctx) {
         case OPCODE: {                                                                            \
           DCHECK_EQ(self->IsExceptionPending(), (OPCODE == Instruction::MOVE_EXCEPTION));         \
           next = inst->RelativeAt(Instruction::SizeInCodeUnits(Instruction::FORMAT));             \
-          bool success = OP_##OPCODE_NAME<do_access_check, transaction_active>(                   \
-              ctx, instrumentation, self, shadow_frame, dex_pc, inst, inst_data, next, exit);     \
+          bool success =                                                                          \
+              OP_##OPCODE_NAME<do_access_check, transaction_active, do_instrumentation>(         \
+                  ctx, instrumentation, self, shadow_frame, dex_pc, inst, inst_data, next, exit);\
           if (success && LIKELY(!interpret_one_instruction)) {                                    \
             DCHECK(!exit) << NAME;                                                                \
             continue;                                                                             \
@@ -1988,7 +2139,8 @@ void ExecuteSwitchImplCpp(SwitchImplContext* ctx) {
       }
     }
     if (self->IsExceptionPending()) {
-      if (!InstructionHandler<do_access_check, transaction_active, Instruction::kInvalidFormat>(
+      if (!InstructionHandler<do_access_check, transaction_active, do_instrumentation,
+                              Instruction::kInvalidFormat>(
               ctx, instrumentation, self, shadow_frame, dex_pc, inst, inst_data, next, exit).
               HandlePendingException()) {
         shadow_frame.SetDexPC(dex::kDexNoIndex);
@@ -2004,6 +2156,8 @@ void ExecuteSwitchImplCpp(SwitchImplContext* ctx) {
   }
 }  // NOLINT(readability/fn_size)
 
+#endif  // ART_USE_COMPUTED_GOTO_INTERPRETER
+
 }  // namespace interpreter
 }  // namespace art
 
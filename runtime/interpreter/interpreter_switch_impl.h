@@ -41,11 +41,18 @@ struct SwitchImplContext {
   ShadowFrame& shadow_frame;
   JValue& result_register;
   bool interpret_one_instruction;
+  // Set by the instrumentation-free implementation when listeners attach while the
+  // frame is executing; tells the wrapper to restart dispatch at the current dex pc
+  // with the instrumented implementation.
+  bool switch_to_instrumented;
   JValue result;
 };
 
-// The actual internal implementation of the switch interpreter.
-template<bool do_access_check, bool transaction_active>
+// The actual internal implementation of the switch interpreter. The variant with
+// `do_instrumentation` set to false has the per-instruction listener checks
+// compiled out and may only be used while no instrumentation listeners are
+// installed; it exits with `ctx->switch_to_instrumented` set if that changes.
+template<bool do_access_check, bool transaction_active, bool do_instrumentation>
 void ExecuteSwitchImplCpp(SwitchImplContext* ctx)
   REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -54,6 +61,10 @@ void ExecuteSwitchImplCpp(SwitchImplContext* ctx)
 extern "C" void ExecuteSwitchImplAsm(SwitchImplContext* ctx, void* impl, const uint16_t* dexpc)
   REQUIRES_SHARED(Locks::mutator_lock_);
 
+// Returns whether instrumentation listeners are installed, i.e. whether the switch
+// interpreter must run with per-instruction instrumentation checks.
+bool NeedsSwitchImplInstrumentation() REQUIRES_SHARED(Locks::mutator_lock_);
+
 // Wrapper around the switch interpreter which ensures we can unwind through it.
 template<bool do_access_check, bool transaction_active>
 ALWAYS_INLINE JValue ExecuteSwitchImpl(Thread* self, const CodeItemDataAccessor& accessor,
@@ -66,10 +77,21 @@ ALWAYS_INLINE JValue ExecuteSwitchImpl(Thread* self, const CodeItemDataAccessor&
     .shadow_frame = shadow_frame,
     .result_register = result_register,
     .interpret_one_instruction = interpret_one_instruction,
+    .switch_to_instrumented = false,
     .result = JValue(),
   };
-  void* impl = reinterpret_cast<void*>(&ExecuteSwitchImplCpp<do_access_check, transaction_active>);
   const uint16_t* dex_pc = ctx.accessor.Insns();
+  if (LIKELY(!NeedsSwitchImplInstrumentation())) {
+    void* impl = reinterpret_cast<void*>(
+        &ExecuteSwitchImplCpp<do_access_check, transaction_active, /*do_instrumentation=*/ false>);
+    ExecuteSwitchImplAsm(&ctx, impl, dex_pc);
+    if (LIKELY(!ctx.switch_to_instrumented)) {
+      return ctx.result;
+    }
+    // Listeners attached mid-method; the shadow frame holds the dex pc to resume at.
+  }
+  void* impl = reinterpret_cast<void*>(
+      &ExecuteSwitchImplCpp<do_access_check, transaction_active, /*do_instrumentation=*/ true>);
   ExecuteSwitchImplAsm(&ctx, impl, dex_pc);
   return ctx.result;
 }
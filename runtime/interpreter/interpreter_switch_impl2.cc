@@ -24,7 +24,7 @@ namespace interpreter {
 
 // Explicit definition of ExecuteSwitchImplCpp.
 template HOT_ATTR
-void ExecuteSwitchImplCpp<true, false>(SwitchImplContext* ctx);
+void ExecuteSwitchImplCpp<true, false, false>(SwitchImplContext* ctx);
 
 }  // namespace interpreter
 }  // namespace art
@@ -24,7 +24,7 @@ namespace interpreter {
 
 // Explicit definition of ExecuteSwitchImplCpp.
 template
-void ExecuteSwitchImplCpp<true, true>(SwitchImplContext* ctx);
+void ExecuteSwitchImplCpp<true, true, false>(SwitchImplContext* ctx);
 
 }  // namespace interpreter
 }  // namespace art
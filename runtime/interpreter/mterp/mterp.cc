@@ -346,10 +346,28 @@ extern "C" size_t MterpConstString(uint32_t index,
                                    ShadowFrame* shadow_frame,
                                    Thread* self)
     REQUIRES_SHARED(Locks::mutator_lock_) {
+  // Try to find the string in the small thread-local cache first (only used
+  // when nterp is not used as mterp and nterp use the cache in an incompatible
+  // way). This mostly hits for strings that are resolved once and then read in
+  // a loop, notably for boot image dex files where the string stays interned
+  // for the lifetime of the runtime. The GC updates cached entries for moved
+  // strings in Thread::SweepInterpreterCache.
+  const uint16_t* dex_pc_ptr = shadow_frame->GetDexPCPtr();
+  InterpreterCache* tls_cache = self->GetInterpreterCache();
+  size_t tls_value;
+  if (!IsNterpSupported() && LIKELY(tls_cache->Get(dex_pc_ptr, &tls_value))) {
+    shadow_frame->SetVRegReference(tgt_vreg, reinterpret_cast<mirror::String*>(tls_value));
+    return 0u;
+  }
   ObjPtr<mirror::String> s = ResolveString(self, *shadow_frame, dex::StringIndex(index));
   if (UNLIKELY(s == nullptr)) {
     return 1u;
   }
+  // Only update the cache if weak ref accesses are enabled; if they are
+  // disabled the GC may be reading the cache concurrently.
+  if (!IsNterpSupported() && (!kUseReadBarrier || self->GetWeakRefAccessEnabled())) {
+    tls_cache->Set(dex_pc_ptr, reinterpret_cast<size_t>(s.Ptr()));
+  }
   shadow_frame->SetVRegReference(tgt_vreg, s);
   return 0u;
 }
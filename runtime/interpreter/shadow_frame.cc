@@ -17,9 +17,24 @@
 #include "shadow_frame.h"
 
 #include "art_method-inl.h"
+#include "thread-current-inl.h"
 
 namespace art {
 
+ShadowFrame* ShadowFrame::CreateDeoptimizedFrame(uint32_t num_vregs,
+                                                 ShadowFrame* link,
+                                                 ArtMethod* method,
+                                                 uint32_t dex_pc) {
+  uint8_t* memory = Thread::Current()->AllocShadowFrameMemory(ComputeSize(num_vregs));
+  return CreateShadowFrameImpl(num_vregs, link, method, dex_pc, memory);
+}
+
+void ShadowFrame::DeleteDeoptimizedFrame(ShadowFrame* sf) {
+  size_t size = ComputeSize(sf->NumberOfVRegs());
+  sf->~ShadowFrame();  // Explicitly destruct.
+  Thread::Current()->FreeShadowFrameMemory(reinterpret_cast<uint8_t*>(sf), size);
+}
+
 mirror::Object* ShadowFrame::GetThisObject() const {
   ArtMethod* m = GetMethod();
   if (m->IsStatic()) {
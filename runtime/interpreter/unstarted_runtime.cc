@@ -33,6 +33,7 @@
 #include "base/casts.h"
 #include "base/enums.h"
 #include "base/macros.h"
+#include "base/mutex.h"
 #include "base/quasi_atomic.h"
 #include "base/zip_archive.h"
 #include "class_linker.h"
@@ -2016,6 +2017,43 @@ static bool tables_initialized_ = false;
 static std::unordered_map<std::string, InvokeHandler> invoke_handlers_;
 static std::unordered_map<std::string, JNIHandler> jni_handlers_;
 
+// The handler tables are keyed by pretty method name, and producing that name
+// (descriptor pretty-printing plus string hashing) dominates the dispatch cost
+// when large <clinit> graphs are interpreted at compile time. Cache the lookup
+// result per ArtMethod*, including negative results, so repeated unstarted
+// invokes of the same method become a single pointer-keyed find. ArtMethods
+// are never freed while the runtime is unstarted, so stale keys are not a
+// concern.
+static Mutex* GetDispatchCacheLock() {
+  static Mutex lock("UnstartedRuntime dispatch cache lock");
+  return &lock;
+}
+static std::unordered_map<ArtMethod*, InvokeHandler> invoke_handler_cache_;
+static std::unordered_map<ArtMethod*, JNIHandler> jni_handler_cache_;
+
+template <typename Handler>
+static bool LookupHandler(Thread* self,
+                          ArtMethod* method,
+                          const std::unordered_map<std::string, Handler>& handlers,
+                          std::unordered_map<ArtMethod*, Handler>& cache,
+                          /* out */ Handler* handler)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  {
+    MutexLock mu(self, *GetDispatchCacheLock());
+    auto it = cache.find(method);
+    if (LIKELY(it != cache.end())) {
+      *handler = it->second;
+      return *handler != nullptr;
+    }
+  }
+  std::string name(ArtMethod::PrettyMethod(method));
+  auto it = handlers.find(name);
+  *handler = (it != handlers.end()) ? it->second : nullptr;
+  MutexLock mu(self, *GetDispatchCacheLock());
+  cache.emplace(method, *handler);
+  return *handler != nullptr;
+}
+
 void UnstartedRuntime::InitializeInvokeHandlers() {
 #define UNSTARTED_DIRECT(ShortName, Sig) \
   invoke_handlers_.insert(std::make_pair(Sig, & UnstartedRuntime::Unstarted ## ShortName));
@@ -2051,16 +2089,19 @@ void UnstartedRuntime::Invoke(Thread* self, const CodeItemDataAccessor& accessor
   // problems in core libraries.
   CHECK(tables_initialized_);
 
-  std::string name(ArtMethod::PrettyMethod(shadow_frame->GetMethod()));
-  const auto& iter = invoke_handlers_.find(name);
-  if (iter != invoke_handlers_.end()) {
+  InvokeHandler handler;
+  if (LookupHandler(self,
+                    shadow_frame->GetMethod(),
+                    invoke_handlers_,
+                    invoke_handler_cache_,
+                    &handler)) {
     // Clear out the result in case it's not zeroed out.
     result->SetL(nullptr);
 
     // Push the shadow frame. This is so the failing method can be seen in abort dumps.
     self->PushShadowFrame(shadow_frame);
 
-    (*iter->second)(self, shadow_frame, result, arg_offset);
+    (*handler)(self, shadow_frame, result, arg_offset);
 
     self->PopShadowFrame();
   } else {
@@ -2072,15 +2113,14 @@ void UnstartedRuntime::Invoke(Thread* self, const CodeItemDataAccessor& accessor
 // Hand select a number of methods to be run in a not yet started runtime without using JNI.
 void UnstartedRuntime::Jni(Thread* self, ArtMethod* method, mirror::Object* receiver,
                            uint32_t* args, JValue* result) {
-  std::string name(ArtMethod::PrettyMethod(method));
-  const auto& iter = jni_handlers_.find(name);
-  if (iter != jni_handlers_.end()) {
+  JNIHandler handler;
+  if (LookupHandler(self, method, jni_handlers_, jni_handler_cache_, &handler)) {
     // Clear out the result in case it's not zeroed out.
     result->SetL(nullptr);
-    (*iter->second)(self, method, receiver, args, result);
+    (*handler)(self, method, receiver, args, result);
   } else if (Runtime::Current()->IsActiveTransaction()) {
     AbortTransactionF(self, "Attempt to invoke native method in non-started runtime: %s",
-                      name.c_str());
+                      ArtMethod::PrettyMethod(method).c_str());
   } else {
     LOG(FATAL) << "Calling native method " << ArtMethod::PrettyMethod(method) << " in an unstarted "
         "non-transactional runtime";
@@ -31,6 +31,7 @@
 #include "runtime.h"
 #include "thread-current-inl.h"
 #include "thread.h"
+#include "thread_pool.h"
 
 #include <atomic>
 #include <cstddef>
@@ -549,29 +550,67 @@ static void RepackEntries(bool compress_entries, ArrayRef<const void*> removed)
   g_jit_num_unpacked_entries = 0;
 }
 
+// Whether an asynchronous repack task is already pending on the JIT thread pool.
+static std::atomic<bool> g_jit_repack_scheduled(false);
+
+class JitRepackTask final : public Task {
+ public:
+  void Run(Thread* self) override {
+    // Clear the flag before repacking so that new entries added while we hold the
+    // lock can schedule the next round.
+    g_jit_repack_scheduled.store(false, std::memory_order_release);
+    MutexLock mu(self, g_jit_debug_lock);
+    // Same policy as the synchronous path below: pack only, unless in the zygote.
+    RepackEntries(/*compress_entries=*/ Runtime::Current()->IsZygote(),
+                  /*removed=*/ ArrayRef<const void*>());
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+};
+
 void AddNativeDebugInfoForJit(const void* code_ptr,
                               const std::vector<uint8_t>& symfile,
                               bool allow_packing) {
-  MutexLock mu(Thread::Current(), g_jit_debug_lock);
-  DCHECK_NE(symfile.size(), 0u);
-
-  CreateJITCodeEntryInternal<JitNativeInfo>(ArrayRef<const uint8_t>(symfile),
-                                            /*addr=*/ code_ptr,
-                                            /*allow_packing=*/ allow_packing,
-                                            /*is_compressed=*/ false);
-
-  VLOG(jit)
-      << "JIT mini-debug-info added"
-      << " for " << code_ptr
-      << " size=" << PrettySize(symfile.size());
-
-  // Automatically repack entries on regular basis to save space.
-  // Pack (but don't compress) recent entries - this is cheap and reduces memory use by ~4x.
-  // We delay compression until after GC since it is more expensive (and saves further ~4x).
-  // Always compress zygote, since it does not GC and we want to keep the high-water mark low.
-  if (++g_jit_num_unpacked_entries >= kJitRepackFrequency) {
-    bool is_zygote = Runtime::Current()->IsZygote();
-    RepackEntries(/*compress_entries=*/ is_zygote, /*removed=*/ ArrayRef<const void*>());
+  bool schedule_repack = false;
+  {
+    MutexLock mu(Thread::Current(), g_jit_debug_lock);
+    DCHECK_NE(symfile.size(), 0u);
+
+    CreateJITCodeEntryInternal<JitNativeInfo>(ArrayRef<const uint8_t>(symfile),
+                                              /*addr=*/ code_ptr,
+                                              /*allow_packing=*/ allow_packing,
+                                              /*is_compressed=*/ false);
+
+    VLOG(jit)
+        << "JIT mini-debug-info added"
+        << " for " << code_ptr
+        << " size=" << PrettySize(symfile.size());
+
+    // Automatically repack entries on regular basis to save space.
+    // Pack (but don't compress) recent entries - this is cheap and reduces memory use by ~4x.
+    // We delay compression until after GC since it is more expensive (and saves further ~4x).
+    // Always compress zygote, since it does not GC and we want to keep the high-water mark low.
+    if (++g_jit_num_unpacked_entries >= kJitRepackFrequency) {
+      // Repacking is expensive (particularly when a profiler keeps the ELF files large),
+      // so only publish the entry on this path and hand the repack to the JIT thread pool
+      // when there is one. No handoff data is needed: the repack task rescans the
+      // descriptor's entry list under the lock. The task must be added after releasing
+      // g_jit_debug_lock, which is near the bottom of the lock hierarchy.
+      jit::Jit* jit = Runtime::Current()->GetJit();
+      if (jit != nullptr && jit->GetThreadPool() != nullptr) {
+        schedule_repack = !g_jit_repack_scheduled.exchange(true, std::memory_order_acq_rel);
+        g_jit_num_unpacked_entries = 0;
+      } else {
+        bool is_zygote = Runtime::Current()->IsZygote();
+        RepackEntries(/*compress_entries=*/ is_zygote, /*removed=*/ ArrayRef<const void*>());
+      }
+    }
+  }
+  if (schedule_repack) {
+    ThreadPool* thread_pool = Runtime::Current()->GetJit()->GetThreadPool();
+    thread_pool->AddTask(Thread::Current(), new JitRepackTask());
   }
 }
 
@@ -91,6 +91,8 @@ JitOptions* JitOptions::CreateFromRuntimeArguments(const RuntimeArgumentMap& opt
   jit_options->use_jit_compilation_ = options.GetOrDefault(RuntimeArgumentMap::UseJitCompilation);
   jit_options->use_tiered_jit_compilation_ =
       options.GetOrDefault(RuntimeArgumentMap::UseTieredJitCompilation);
+  jit_options->use_profiled_jit_compilation_ =
+      options.GetOrDefault(RuntimeArgumentMap::UseProfiledJitCompilation);
 
   jit_options->code_cache_initial_capacity_ =
       options.GetOrDefault(RuntimeArgumentMap::JITCodeCacheInitialCapacity);
@@ -1304,7 +1306,10 @@ void Jit::RegisterDexFiles(const std::vector<std::unique_ptr<const DexFile>>& de
   }
   Runtime* runtime = Runtime::Current();
   // If the runtime is debuggable, no need to precompile methods.
-  if (runtime->IsSystemServer() &&
+  // System server always precompiles from its profile; other processes opt in
+  // with -Xuseprofiledjit:true to avoid rewarming their hot methods on every
+  // restart.
+  if ((runtime->IsSystemServer() || options_->UseProfiledJitCompilation()) &&
       UseJitCompilation() && HasImageWithProfile() &&
       !runtime->IsJavaDebuggable()) {
     thread_pool_->AddTask(Thread::Current(), new JitProfileTask(dex_files, class_loader));
@@ -1384,6 +1389,9 @@ uint32_t Jit::CompileMethodsFromBootProfile(
     dex_caches.push_back(handles.NewHandle(class_linker->FindDexCache(self, *dex_file)));
   }
 
+  // Batch the code commits of synchronously compiled methods so that one
+  // pipeline synchronizing membarrier covers all of them.
+  ScopedCodeCommitBatch batch(GetCodeCache());
   uint32_t added_to_queue = 0;
   for (const std::pair<uint32_t, uint32_t>& pair : profile_info.GetMethods()) {
     if (CompileMethodFromProfile(self,
@@ -1429,6 +1437,9 @@ uint32_t Jit::CompileMethodsFromProfile(
   StackHandleScope<1> hs(self);
   MutableHandle<mirror::DexCache> dex_cache = hs.NewHandle<mirror::DexCache>(nullptr);
   ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+  // Batch the code commits of synchronously compiled methods so that one
+  // pipeline synchronizing membarrier covers all of them.
+  ScopedCodeCommitBatch batch(GetCodeCache());
   uint32_t added_to_queue = 0u;
   for (const DexFile* dex_file : dex_files) {
     if (LocationIsOnArtModule(dex_file->GetLocation().c_str())) {
@@ -1557,11 +1568,15 @@ bool Jit::MaybeCompileMethod(Thread* self,
     if (old_count < HotMethodThreshold() && new_count >= HotMethodThreshold()) {
       if (!code_cache_->ContainsPc(method->GetEntryPointFromQuickCompiledCode())) {
         DCHECK(thread_pool_ != nullptr);
-        JitCompileTask::TaskKind kind =
-            (options_->UseTieredJitCompilation() || options_->UseBaselineCompiler())
-                ? JitCompileTask::TaskKind::kCompileBaseline
-                : JitCompileTask::TaskKind::kCompile;
-        thread_pool_->AddTask(self, new JitCompileTask(method, kind));
+        if (options_->UseTieredJitCompilation() || options_->UseBaselineCompiler()) {
+          // Baseline compilations are cheap and gate warmup latency; let them jump ahead of
+          // any queued optimizing compilations.
+          thread_pool_->AddPriorityTask(
+              self, new JitCompileTask(method, JitCompileTask::TaskKind::kCompileBaseline));
+        } else {
+          thread_pool_->AddTask(
+              self, new JitCompileTask(method, JitCompileTask::TaskKind::kCompile));
+        }
       }
     }
     if (old_count < OSRMethodThreshold() && new_count >= OSRMethodThreshold()) {
@@ -1571,7 +1586,10 @@ bool Jit::MaybeCompileMethod(Thread* self,
       DCHECK(!method->IsNative());  // No back edges reported for native methods.
       if (!code_cache_->IsOsrCompiled(method)) {
         DCHECK(thread_pool_ != nullptr);
-        thread_pool_->AddTask(
+        // A thread is stuck interpreting a hot loop until this compilation
+        // finishes, so don't let the request sit behind queued method
+        // compilations.
+        thread_pool_->AddPriorityTask(
             self, new JitCompileTask(method, JitCompileTask::TaskKind::kCompileOsr));
       }
     }
@@ -1627,6 +1645,18 @@ void Jit::MethodEntered(Thread* thread, ArtMethod* method) {
     return;
   }
 
+  if (UNLIKELY(method->IsNative()) &&
+      runtime->UseJitCompilation() &&
+      !IgnoreSamplesForMethod(method)) {
+    // A native method only enters here through the generic JNI trampoline. JNI stubs are
+    // shared between all methods with the same JniStubKey (shorty and flags), so if a
+    // matching stub has already been compiled for some other method, adopt it right away
+    // instead of paying for the generic trampoline until this method becomes hot itself.
+    if (code_cache_->AttachExistingJniStub(method, thread)) {
+      return;
+    }
+  }
+
   ProfilingInfo* profiling_info = method->GetProfilingInfo(kRuntimePointerSize);
   // Update the entrypoint if the ProfilingInfo has one. The interpreter will call it
   // instead of interpreting the method. We don't update it for instrumentation as the entrypoint
@@ -1846,8 +1876,8 @@ void Jit::EnqueueCompilationFromNterp(ArtMethod* method, Thread* self) {
   }
   if (GetCodeCache()->ContainsPc(method->GetEntryPointFromQuickCompiledCode())) {
     // If we already have compiled code for it, nterp may be stuck in a loop.
-    // Compile OSR.
-    thread_pool_->AddTask(
+    // Compile OSR, ahead of queued method compilations.
+    thread_pool_->AddPriorityTask(
         self, new JitCompileTask(method, JitCompileTask::TaskKind::kCompileOsr));
     return;
   }
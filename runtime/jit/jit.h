@@ -120,6 +120,14 @@ class JitOptions {
     return use_tiered_jit_compilation_;
   }
 
+  // Whether hot methods recorded in the app profile should be compiled when
+  // their dex files get registered, instead of waiting for them to warm up
+  // again. This trades some startup CPU for avoiding rewarmup in long-lived
+  // processes; system server always behaves this way.
+  bool UseProfiledJitCompilation() const {
+    return use_profiled_jit_compilation_;
+  }
+
   bool CanCompileBaseline() const {
     return use_tiered_jit_compilation_ ||
            use_baseline_compiler_ ||
@@ -158,6 +166,7 @@ class JitOptions {
 
   bool use_jit_compilation_;
   bool use_tiered_jit_compilation_;
+  bool use_profiled_jit_compilation_;
   bool use_baseline_compiler_;
   size_t code_cache_initial_capacity_;
   size_t code_cache_max_capacity_;
@@ -173,6 +182,7 @@ class JitOptions {
   JitOptions()
       : use_jit_compilation_(false),
         use_tiered_jit_compilation_(false),
+        use_profiled_jit_compilation_(false),
         use_baseline_compiler_(false),
         code_cache_initial_capacity_(0),
         code_cache_max_capacity_(0),
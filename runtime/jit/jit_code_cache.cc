@@ -64,6 +64,12 @@ namespace jit {
 static constexpr size_t kCodeSizeLogThreshold = 50 * KB;
 static constexpr size_t kStackMapSizeLogThreshold = 50 * KB;
 
+// Number of consecutive full collections the compiled code of a method must survive before it
+// is tenured: tenured code is no longer polled for liveness (no interpreter bounce and method
+// counter reset), so steady-state hot methods in long-lived processes stop paying for full
+// code cache collections.
+static constexpr uint16_t kFullCollectionsToTenure = 2u;
+
 class JitCodeCache::JniStubKey {
  public:
   explicit JniStubKey(ArtMethod* method) REQUIRES_SHARED(Locks::mutator_lock_)
@@ -327,6 +333,33 @@ const void* JitCodeCache::GetJniStubCode(ArtMethod* method) {
   return nullptr;
 }
 
+bool JitCodeCache::AttachExistingJniStub(ArtMethod* method, Thread* self) {
+  DCHECK(method->IsNative());
+  MutexLock mu(self, *Locks::jit_lock_);
+  auto it = jni_stubs_map_.find(JniStubKey(method));
+  if (it == jni_stubs_map_.end()) {
+    return false;
+  }
+  JniStubData* data = &it->second;
+  if (!data->IsCompiled()) {
+    // A compilation for this key is in flight; let the normal hotness path handle the method.
+    return false;
+  }
+  data->AddMethod(method);
+  OatQuickMethodHeader* method_header = OatQuickMethodHeader::FromCodePointer(data->GetCode());
+  // Update also entrypoints of other methods held by the JniStubData, as in
+  // NotifyCompilationOf(): the last JIT GC may have changed them to GenericJNI in
+  // preparation for a full GC. Methods of classes that are not yet visibly initialized
+  // keep their entrypoint (see JniStubData::UpdateEntryPoints) and retry on the next call.
+  data->UpdateEntryPoints(method_header->GetEntryPoint());
+  if (collection_in_progress_) {
+    if (!IsInZygoteExecSpace(data->GetCode())) {
+      GetLiveBitmap()->AtomicTestAndSet(FromCodeToAllocation(data->GetCode()));
+    }
+  }
+  return true;
+}
+
 const void* JitCodeCache::FindCompiledCodeForInstrumentation(ArtMethod* method) {
   // If jit-gc is still on we use the SavedEntryPoint field for doing that and so cannot use it to
   // find the instrumentation entrypoint.
@@ -353,6 +386,9 @@ const void* JitCodeCache::GetSavedEntryPointOfPreCompiledMethod(ArtMethod* metho
       auto it = saved_compiled_methods_map_.find(method);
       if (it != saved_compiled_methods_map_.end()) {
         code_ptr = it->second;
+        // The commit of this code may have been part of a batch that deferred
+        // its pipeline synchronizing membarrier.
+        private_region_.EnsureCommittedCodeIsExecutable();
       }
     }
     if (code_ptr != nullptr) {
@@ -713,16 +749,21 @@ bool JitCodeCache::Commit(Thread* self,
       JniStubData* data = &it->second;
       DCHECK(ContainsElement(data->GetMethods(), method))
           << "Entry inserted in NotifyCompilationOf() should contain this method.";
+      region->EnsureCommittedCodeIsExecutable();
       data->SetCode(code_ptr);
       data->UpdateEntryPoints(method_header->GetEntryPoint());
     } else {
       if (method->IsPreCompiled() && IsSharedRegion(*region)) {
+        // The zygote map is consulted without holding the JIT lock, so the
+        // code must be executable before it becomes visible there.
+        region->EnsureCommittedCodeIsExecutable();
         zygote_map_.Put(code_ptr, method);
       } else {
         method_code_map_.Put(code_ptr, method);
       }
       if (osr) {
         number_of_osr_compilations_++;
+        region->EnsureCommittedCodeIsExecutable();
         osr_code_map_.Put(method, code_ptr);
       } else if (NeedsClinitCheckBeforeCall(method) &&
                  !method->GetDeclaringClass()->IsVisiblyInitialized()) {
@@ -730,11 +771,14 @@ bool JitCodeCache::Commit(Thread* self,
         DCHECK(!garbage_collect_code_);
         DCHECK(method->IsPreCompiled());
         // The shared region can easily be queried. For the private region, we
-        // use a side map.
+        // use a side map. The entry point is published later from
+        // GetSavedEntryPointOfPreCompiledMethod, which issues any membarrier
+        // deferred by a code commit batch.
         if (!IsSharedRegion(*region)) {
           saved_compiled_methods_map_.Put(method, code_ptr);
         }
       } else {
+        region->EnsureCommittedCodeIsExecutable();
         Runtime::Current()->GetInstrumentation()->UpdateMethodsCode(
             method, method_header->GetEntryPoint());
       }
@@ -1149,6 +1193,12 @@ void JitCodeCache::GarbageCollectCache(Thread* self) {
           for (ProfilingInfo* info : profiling_infos_) {
             const void* entry_point = info->GetMethod()->GetEntryPointFromQuickCompiledCode();
             if (!IsInZygoteDataSpace(info) && ContainsPc(entry_point)) {
+              if (info->GetFullCollectionsSurvived() >= kFullCollectionsToTenure) {
+                // Tenured code: it kept being invoked across several full collections, so
+                // presume it stays live instead of proving it through re-invocation. Its entry
+                // point remains the compiled code, which keeps it marked during collection.
+                continue;
+              }
               info->SetSavedEntryPoint(entry_point);
               // Don't call Instrumentation::UpdateMethodsCode(), as it can check the declaring
               // class of the method. We may be concurrently running a GC which makes accessing
@@ -1279,6 +1329,12 @@ void JitCodeCache::DoCollection(Thread* self, bool collect_profiling_info) {
             // We are going to move this method back to interpreter. Clear the counter now to
             // give it a chance to be hot again.
             ClearMethodCounter(info->GetMethod(), /*was_warm=*/ true);
+            // A new compilation starts from scratch on the path to being tenured.
+            info->ResetFullCollectionsSurvived();
+          } else if (ContainsPc(ptr)) {
+            // The compiled code was invoked while we were polling (or is already tenured):
+            // it survives this full collection.
+            info->IncrementFullCollectionsSurvived();
           }
         }
       } else if (kIsDebugBuild) {
@@ -1508,11 +1564,50 @@ void JitCodeCache::GetProfiledMethods(const std::set<std::string>& dex_base_loca
                                       std::vector<ProfileMethodInfo>& methods) {
   Thread* self = Thread::Current();
   WaitUntilInlineCacheAccessible(self);
-  MutexLock mu(self, *Locks::jit_lock_);
   ScopedTrace trace(__FUNCTION__);
+
+  // Snapshot the profiling data under the lock, but keep the per-method dex file and string
+  // processing below outside of it: this walk happens on the profile saver thread and used to
+  // hold jit_lock_ for its whole duration, stalling the JIT compiler threads. The snapshot
+  // only copies plain data. The inline cache classes are safe to process after releasing the
+  // lock as we do not suspend between the snapshot and their use.
+  struct InlineCacheSnapshot {
+    uint32_t dex_pc;
+    mirror::Class* classes[InlineCache::kIndividualCacheSize];
+  };
+  struct ProfiledMethodSnapshot {
+    ArtMethod* method;
+    std::vector<InlineCacheSnapshot> caches;
+  };
   uint16_t jit_compile_threshold = Runtime::Current()->GetJITOptions()->GetCompileThreshold();
-  for (const ProfilingInfo* info : profiling_infos_) {
-    ArtMethod* method = info->GetMethod();
+  std::vector<ProfiledMethodSnapshot> snapshots;
+  {
+    MutexLock mu(self, *Locks::jit_lock_);
+    snapshots.reserve(profiling_infos_.size());
+    for (const ProfilingInfo* info : profiling_infos_) {
+      ProfiledMethodSnapshot snapshot;
+      snapshot.method = info->GetMethod();
+      // If the method didn't reach the compilation threshold don't save the inline caches.
+      // They might be incomplete and cause unnecessary deoptimizations.
+      // If the inline cache is empty the compiler will generate a regular invoke
+      // virtual/interface.
+      if (snapshot.method->GetCounter() >= jit_compile_threshold) {
+        snapshot.caches.reserve(info->number_of_inline_caches_);
+        for (size_t i = 0; i < info->number_of_inline_caches_; ++i) {
+          const InlineCache& cache = info->cache_[i];
+          InlineCacheSnapshot& cache_snapshot = snapshot.caches.emplace_back();
+          cache_snapshot.dex_pc = cache.dex_pc_;
+          for (size_t k = 0; k < InlineCache::kIndividualCacheSize; k++) {
+            cache_snapshot.classes[k] = cache.classes_[k].Read();
+          }
+        }
+      }
+      snapshots.push_back(std::move(snapshot));
+    }
+  }
+
+  for (const ProfiledMethodSnapshot& snapshot : snapshots) {
+    ArtMethod* method = snapshot.method;
     const DexFile* dex_file = method->GetDexFile();
     const std::string base_location = DexFileLoader::GetBaseLocation(dex_file->GetLocation());
     if (!ContainsElement(dex_base_locations, base_location)) {
@@ -1521,22 +1616,12 @@ void JitCodeCache::GetProfiledMethods(const std::set<std::string>& dex_base_loca
     }
     std::vector<ProfileMethodInfo::ProfileInlineCache> inline_caches;
 
-    // If the method didn't reach the compilation threshold don't save the inline caches.
-    // They might be incomplete and cause unnecessary deoptimizations.
-    // If the inline cache is empty the compiler will generate a regular invoke virtual/interface.
-    if (method->GetCounter() < jit_compile_threshold) {
-      methods.emplace_back(/*ProfileMethodInfo*/
-          MethodReference(dex_file, method->GetDexMethodIndex()), inline_caches);
-      continue;
-    }
-
-    for (size_t i = 0; i < info->number_of_inline_caches_; ++i) {
+    for (const InlineCacheSnapshot& cache : snapshot.caches) {
       std::vector<TypeReference> profile_classes;
-      const InlineCache& cache = info->cache_[i];
-      ArtMethod* caller = info->GetMethod();
+      ArtMethod* caller = method;
       bool is_missing_types = false;
       for (size_t k = 0; k < InlineCache::kIndividualCacheSize; k++) {
-        mirror::Class* cls = cache.classes_[k].Read();
+        mirror::Class* cls = cache.classes[k];
         if (cls == nullptr) {
           break;
         }
@@ -1580,7 +1665,7 @@ void JitCodeCache::GetProfiledMethods(const std::set<std::string>& dex_base_loca
       }
       if (!profile_classes.empty()) {
         inline_caches.emplace_back(/*ProfileMethodInfo::ProfileInlineCache*/
-            cache.dex_pc_, is_missing_types, profile_classes);
+            cache.dex_pc, is_missing_types, profile_classes);
       }
     }
     methods.emplace_back(/*ProfileMethodInfo*/
@@ -1874,6 +1959,17 @@ JitMemoryRegion* JitCodeCache::GetCurrentRegion() {
   return Runtime::Current()->IsZygote() ? &shared_region_ : &private_region_;
 }
 
+ScopedCodeCommitBatch::ScopedCodeCommitBatch(JitCodeCache* code_cache)
+    : region_(code_cache->GetCurrentRegion()) {
+  MutexLock mu(Thread::Current(), *Locks::jit_lock_);
+  region_->StartCodeCommitBatch();
+}
+
+ScopedCodeCommitBatch::~ScopedCodeCommitBatch() {
+  MutexLock mu(Thread::Current(), *Locks::jit_lock_);
+  region_->EndCodeCommitBatch();
+}
+
 void ZygoteMap::Initialize(uint32_t number_of_methods) {
   MutexLock mu(Thread::Current(), *Locks::jit_lock_);
   // Allocate for 40-80% capacity. This will offer OK lookup times, and termination
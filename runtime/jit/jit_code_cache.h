@@ -238,6 +238,14 @@ class JitCodeCache {
   // Return the code pointer for a JNI-compiled stub if the method is in the cache, null otherwise.
   const void* GetJniStubCode(ArtMethod* method) REQUIRES(!Locks::jit_lock_);
 
+  // If a JNI stub with a matching JniStubKey (shorty and flags) has already been compiled for
+  // some other method, attach `method` to it and update its entrypoint, so that the method
+  // leaves the generic JNI trampoline after its first invocation instead of waiting to become
+  // hot. Returns true if such a stub exists (whether or not the entrypoint could be updated).
+  bool AttachExistingJniStub(ArtMethod* method, Thread* self)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!Locks::jit_lock_);
+
   // Allocate a region for both code and data in the JIT code cache.
   // The reserved memory is left completely uninitialized.
   bool Reserve(Thread* self,
@@ -570,6 +578,21 @@ class JitCodeCache {
   DISALLOW_COPY_AND_ASSIGN(JitCodeCache);
 };
 
+// Scope during which code commits to the current region defer their pipeline
+// synchronizing membarrier, so that one membarrier can cover all methods
+// committed in the scope. Useful when committing many methods in a row, e.g.
+// when precompiling profile methods at startup.
+class ScopedCodeCommitBatch {
+ public:
+  explicit ScopedCodeCommitBatch(JitCodeCache* code_cache) REQUIRES(!Locks::jit_lock_);
+  ~ScopedCodeCommitBatch() REQUIRES(!Locks::jit_lock_);
+
+ private:
+  JitMemoryRegion* const region_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedCodeCommitBatch);
+};
+
 }  // namespace jit
 }  // namespace art
 
@@ -427,11 +427,36 @@ const uint8_t* JitMemoryRegion::CommitCode(ArrayRef<const uint8_t> reserved_code
   // based TLB shootdown. The sync-core flavor of membarrier was introduced in Linux 4.16 to
   // address this (see mbarrier(2)). The membarrier here will fail on prior kernels and on
   // platforms lacking the appropriate support.
-  art::membarrier(art::MembarrierCommand::kPrivateExpeditedSyncCore);
+  if (code_commit_batch_active_) {
+    // The entry point is not published before `EnsureCommittedCodeIsExecutable`
+    // runs, so one membarrier at the end of the batch covers all methods
+    // committed in it.
+    deferred_code_sync_pending_ = true;
+  } else {
+    art::membarrier(art::MembarrierCommand::kPrivateExpeditedSyncCore);
+  }
 
   return result;
 }
 
+void JitMemoryRegion::StartCodeCommitBatch() {
+  DCHECK(!code_commit_batch_active_);
+  code_commit_batch_active_ = true;
+}
+
+void JitMemoryRegion::EndCodeCommitBatch() {
+  DCHECK(code_commit_batch_active_);
+  code_commit_batch_active_ = false;
+  EnsureCommittedCodeIsExecutable();
+}
+
+void JitMemoryRegion::EnsureCommittedCodeIsExecutable() {
+  if (deferred_code_sync_pending_) {
+    deferred_code_sync_pending_ = false;
+    art::membarrier(art::MembarrierCommand::kPrivateExpeditedSyncCore);
+  }
+}
+
 static void FillRootTable(uint8_t* roots_data, const std::vector<Handle<mirror::Object>>& roots)
     REQUIRES(Locks::jit_lock_)
     REQUIRES_SHARED(Locks::mutator_lock_) {
@@ -63,7 +63,9 @@ class JitMemoryRegion {
         exec_pages_(),
         non_exec_pages_(),
         data_mspace_(nullptr),
-        exec_mspace_(nullptr) {}
+        exec_mspace_(nullptr),
+        code_commit_batch_active_(false),
+        deferred_code_sync_pending_(false) {}
 
   bool Initialize(size_t initial_capacity,
                   size_t max_capacity,
@@ -101,6 +103,18 @@ class JitMemoryRegion {
       REQUIRES(Locks::jit_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Batch mode for code commits. While a batch is active, the pipeline
+  // synchronizing membarrier normally issued by `CommitCode` for every method
+  // is deferred so that one membarrier can cover all methods committed in the
+  // batch. Callers must issue the deferred membarrier with
+  // `EnsureCommittedCodeIsExecutable` before publishing an entry point to
+  // other threads.
+  void StartCodeCommitBatch() REQUIRES(Locks::jit_lock_);
+  void EndCodeCommitBatch() REQUIRES(Locks::jit_lock_);
+
+  // Issue the membarrier deferred by batched code commits, if any.
+  void EnsureCommittedCodeIsExecutable() REQUIRES(Locks::jit_lock_);
+
   void ResetWritableMappings() REQUIRES(Locks::jit_lock_) {
     non_exec_pages_.ResetInForkedProcess();
     writable_data_pages_.ResetInForkedProcess();
@@ -278,6 +292,11 @@ class JitMemoryRegion {
   // The opaque mspace for allocating code.
   void* exec_mspace_ GUARDED_BY(Locks::jit_lock_);
 
+  // Whether code commits currently defer their pipeline synchronizing
+  // membarrier, and whether a batched commit still needs one.
+  bool code_commit_batch_active_ GUARDED_BY(Locks::jit_lock_);
+  bool deferred_code_sync_pending_ GUARDED_BY(Locks::jit_lock_);
+
   friend class ScopedCodeCacheWrite;  // For GetUpdatableCodeMapping
   friend class TestZygoteMemory;
 };
@@ -57,6 +57,11 @@ static_assert(ProfileCompilationInfo::kIndividualInlineCacheSize ==
 // At what priority to schedule the saver threads. 9 is the lowest foreground priority on device.
 static constexpr int kProfileSaverPthreadPriority = 9;
 
+// Maximum multiplier applied to the minimum save period when consecutive wake ups keep
+// producing deltas too small to be worth writing. Long-running apps with a stable working
+// set converge to this, cutting both wake up CPU and flash writes.
+static constexpr uint32_t kMaxSavePeriodBackoff = 16;
+
 static void SetProfileSaverThreadPriority(pthread_t thread, int priority) {
 #if defined(ART_TARGET_ANDROID)
   int result = setpriority(PRIO_PROCESS, pthread_gettid_np(thread), priority);
@@ -100,6 +105,7 @@ ProfileSaver::ProfileSaver(const ProfileSaverOptions& options,
       total_ns_of_work_(0),
       total_number_of_hot_spikes_(0),
       total_number_of_wake_ups_(0),
+      total_number_of_save_period_backoffs_(0),
       options_(options) {
   DCHECK(options_.IsEnabled());
   AddTrackedLocations(output_filename, code_paths);
@@ -155,6 +161,10 @@ void ProfileSaver::Run() {
   // exponential back off policy bounded by max_wait_without_jit.
   uint32_t max_wait_without_jit = options_.GetMinSavePeriodMs() * 16;
   uint64_t cur_wait_without_jit = options_.GetMinSavePeriodMs();
+  // Multiplier for the minimum save period, grown while wake ups keep producing deltas
+  // too small to save and reset as soon as a save makes it to disk. This adapts the
+  // cadence to how fast the app actually produces new profiling data.
+  uint32_t save_period_backoff = 1;
   // Loop for the profiled methods.
   while (!ShuttingDown(self)) {
     uint64_t sleep_start = NanoTime();
@@ -180,7 +190,7 @@ void ProfileSaver::Run() {
       // We might have been woken up by a huge number of notifications to guarantee saving.
       // If we didn't meet the minimum saving period go back to sleep (only if missed by
       // a reasonable margin).
-      uint64_t min_save_period_ns = MsToNs(options_.GetMinSavePeriodMs());
+      uint64_t min_save_period_ns = MsToNs(options_.GetMinSavePeriodMs()) * save_period_backoff;
       while (min_save_period_ns * 0.9 > sleep_time) {
         {
           MutexLock mu(self, wait_lock_);
@@ -210,6 +220,13 @@ void ProfileSaver::Run() {
       // Set the jit activity notifications to number_of_new_methods so we can wake up earlier
       // if needed.
       jit_activity_notifications_ = number_of_new_methods;
+      // The delta was too small to be worth a write; save less often until it grows again.
+      if (save_period_backoff < kMaxSavePeriodBackoff) {
+        save_period_backoff *= 2;
+        total_number_of_save_period_backoffs_++;
+      }
+    } else {
+      save_period_backoff = 1;
     }
     total_ns_of_work_ += NanoTime() - start_work;
   }
@@ -907,7 +924,9 @@ void ProfileSaver::DumpInfo(std::ostream& os) {
      << "ProfileSaver total_ms_of_sleep=" << total_ms_of_sleep_ << '\n'
      << "ProfileSaver total_ms_of_work=" << NsToMs(total_ns_of_work_) << '\n'
      << "ProfileSaver total_number_of_hot_spikes=" << total_number_of_hot_spikes_ << '\n'
-     << "ProfileSaver total_number_of_wake_ups=" << total_number_of_wake_ups_ << '\n';
+     << "ProfileSaver total_number_of_wake_ups=" << total_number_of_wake_ups_ << '\n'
+     << "ProfileSaver total_number_of_save_period_backoffs="
+     << total_number_of_save_period_backoffs_ << '\n';
 }
 
 
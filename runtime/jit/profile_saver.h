@@ -152,6 +152,7 @@ class ProfileSaver {
   // TODO(calin): replace with an actual size.
   uint64_t total_number_of_hot_spikes_;
   uint64_t total_number_of_wake_ups_;
+  uint64_t total_number_of_save_period_backoffs_;
 
   const ProfileSaverOptions options_;
 
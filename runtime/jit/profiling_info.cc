@@ -31,11 +31,15 @@ ProfilingInfo::ProfilingInfo(ArtMethod* method, const std::vector<uint32_t>& ent
         saved_entry_point_(nullptr),
         number_of_inline_caches_(entries.size()),
         current_inline_uses_(0),
+        full_collections_survived_(0),
         is_method_being_compiled_(false),
         is_osr_method_being_compiled_(false) {
   memset(&cache_, 0, number_of_inline_caches_ * sizeof(InlineCache));
   for (size_t i = 0; i < number_of_inline_caches_; ++i) {
     cache_[i].dex_pc_ = entries[i];
+    // `GetInlineCache` relies on the entries being sorted by dex pc. This holds as `Create`
+    // collects them while walking the dex instructions in order.
+    DCHECK(i == 0 || entries[i - 1u] < entries[i]);
   }
 }
 
@@ -70,18 +74,35 @@ bool ProfilingInfo::Create(Thread* self, ArtMethod* method, bool retry_allocatio
 }
 
 InlineCache* ProfilingInfo::GetInlineCache(uint32_t dex_pc) {
-  // TODO: binary search if array is too long.
-  for (size_t i = 0; i < number_of_inline_caches_; ++i) {
-    if (cache_[i].dex_pc_ == dex_pc) {
-      return &cache_[i];
+  // Binary search, the caches are sorted by dex pc (see the constructor).
+  size_t lo = 0;
+  size_t hi = number_of_inline_caches_;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2u;
+    if (cache_[mid].dex_pc_ < dex_pc) {
+      lo = mid + 1u;
+    } else {
+      hi = mid;
     }
   }
+  if (lo != number_of_inline_caches_ && cache_[lo].dex_pc_ == dex_pc) {
+    return &cache_[lo];
+  }
   LOG(FATAL) << "No inline cache found for "  << ArtMethod::PrettyMethod(method_) << "@" << dex_pc;
   UNREACHABLE();
 }
 
 void ProfilingInfo::AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls) {
   InlineCache* cache = GetInlineCache(dex_pc);
+  // If the last entry is taken the cache is full and the call site is megamorphic; return
+  // without scanning the other entries. The garbage collector may later clear some of the
+  // entries of such a cache, but we deliberately keep treating the site as megamorphic
+  // rather than re-recording receivers in the holes.
+  mirror::Class* last =
+      cache->classes_[InlineCache::kIndividualCacheSize - 1u].Read<kWithoutReadBarrier>();
+  if (ReadBarrier::IsMarked(last) != nullptr) {
+    return;
+  }
   for (size_t i = 0; i < InlineCache::kIndividualCacheSize; ++i) {
     mirror::Class* existing = cache->classes_[i].Read<kWithoutReadBarrier>();
     mirror::Class* marked = ReadBarrier::IsMarked(existing);
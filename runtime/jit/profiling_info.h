@@ -138,6 +138,23 @@ class ProfilingInfo {
     return baseline_hotness_count_;
   }
 
+  // Number of consecutive full code cache collections the compiled code of this method has
+  // survived, i.e. it was invoked again while the code cache was polling for liveness. Used by
+  // the code cache to tenure long-lived code and stop bouncing it through the interpreter.
+  uint16_t GetFullCollectionsSurvived() const {
+    return full_collections_survived_;
+  }
+
+  void IncrementFullCollectionsSurvived() {
+    if (full_collections_survived_ != std::numeric_limits<uint16_t>::max()) {
+      ++full_collections_survived_;
+    }
+  }
+
+  void ResetFullCollectionsSurvived() {
+    full_collections_survived_ = 0;
+  }
+
  private:
   ProfilingInfo(ArtMethod* method, const std::vector<uint32_t>& entries);
 
@@ -162,6 +179,9 @@ class ProfilingInfo {
   // it updates this counter so that the GC does not try to clear the inline caches.
   uint16_t current_inline_uses_;
 
+  // See GetFullCollectionsSurvived.
+  uint16_t full_collections_survived_;
+
   // Whether the ArtMethod is currently being compiled. This flag
   // is implicitly guarded by the JIT code cache lock.
   // TODO: Make the JIT code cache lock global.
@@ -22,6 +22,8 @@
 #include "android-base/stringprintf.h"
 
 #include "art_method-inl.h"
+#include "backtrace_helper.h"
+#include "base/casts.h"
 #include "base/dumpable.h"
 #include "base/mutex-inl.h"
 #include "base/sdk_version.h"
@@ -30,6 +32,7 @@
 #include "base/systrace.h"
 #include "check_jni.h"
 #include "dex/dex_file-inl.h"
+#include "dex/utf.h"
 #include "fault_handler.h"
 #include "gc/allocation_record.h"
 #include "gc/heap.h"
@@ -508,6 +511,7 @@ JavaVMExt::JavaVMExt(Runtime* runtime,
                                   (CHECK(Locks::jni_weak_globals_lock_ != nullptr),
                                    *Locks::jni_weak_globals_lock_)),
       env_hooks_(),
+      member_lookup_cache_lock_("JNI member lookup cache lock"),
       enable_allocation_tracking_delta_(
           runtime_options.GetOrDefault(RuntimeArgumentMap::GlobalRefAllocStackTraceLimit)),
       allocation_tracking_enabled_(false),
@@ -1032,6 +1036,10 @@ bool JavaVMExt::LoadNativeLibrary(JNIEnv* env,
     env->ExceptionDescribe();
     env->ExceptionClear();
   }
+
+  // The process maps changed; let cached native unwinders reparse them lazily.
+  BacktraceCollector::NotifyNativeLibraryLoaded();
+
   // Create a new entry.
   // TODO: move the locking (and more of this logic) into Libraries.
   bool created_library = false;
@@ -1150,20 +1158,136 @@ void* JavaVMExt::FindCodeForNativeMethod(ArtMethod* m) {
 }
 
 void JavaVMExt::SweepJniWeakGlobals(IsMarkedVisitor* visitor) {
-  MutexLock mu(Thread::Current(), *Locks::jni_weak_globals_lock_);
-  Runtime* const runtime = Runtime::Current();
-  for (auto* entry : weak_globals_) {
-    // Need to skip null here to distinguish between null entries and cleared weak ref entries.
-    if (!entry->IsNull()) {
-      // Since this is called by the GC, we don't need a read barrier.
-      mirror::Object* obj = entry->Read<kWithoutReadBarrier>();
-      mirror::Object* new_obj = visitor->IsMarked(obj);
-      if (new_obj == nullptr) {
-        new_obj = runtime->GetClearedJniWeakGlobal();
+  {
+    MutexLock mu(Thread::Current(), *Locks::jni_weak_globals_lock_);
+    Runtime* const runtime = Runtime::Current();
+    mirror::Object* const cleared = runtime->GetClearedJniWeakGlobal();
+    for (auto* entry : weak_globals_) {
+      // Need to skip null here to distinguish between null entries and cleared weak ref entries.
+      if (!entry->IsNull()) {
+        // Since this is called by the GC, we don't need a read barrier.
+        mirror::Object* obj = entry->Read<kWithoutReadBarrier>();
+        mirror::Object* new_obj = visitor->IsMarked(obj);
+        if (new_obj == nullptr) {
+          new_obj = cleared;
+        }
+        // Only write back entries that actually changed. Most weak globals survive a GC with an
+        // unchanged referent and rewriting them would dirty every page of the table.
+        if (new_obj != obj) {
+          *entry = GcRoot<mirror::Object>(new_obj);
+        }
+      }
+    }
+  }
+  // Sweep the member lookup cache as well: drop entries whose declaring class died and keep the
+  // surviving weak roots in sync with moving collectors so post-GC lookups keep hitting.
+  MutexLock cache_mu(Thread::Current(), member_lookup_cache_lock_);
+  for (auto it = member_lookup_cache_.begin(); it != member_lookup_cache_.end(); ) {
+    mirror::Class* klass = it->second.declaring_class.Read<kWithoutReadBarrier>();
+    mirror::Object* new_klass = visitor->IsMarked(klass);
+    if (new_klass == nullptr) {
+      it = member_lookup_cache_.erase(it);
+    } else {
+      if (new_klass != klass) {
+        it->second.declaring_class = GcRoot<mirror::Class>(down_cast<mirror::Class*>(new_klass));
       }
-      *entry = GcRoot<mirror::Object>(new_obj);
+      ++it;
+    }
+  }
+}
+
+uint32_t JavaVMExt::MemberLookupHash(const char* name,
+                                     const char* sig,
+                                     bool is_static,
+                                     bool is_field) {
+  uint32_t hash = ComputeModifiedUtf8Hash(name) * 31u + ComputeModifiedUtf8Hash(sig);
+  return (hash << 2) | (is_static ? 2u : 0u) | (is_field ? 1u : 0u);
+}
+
+void* JavaVMExt::FindCachedMember(ObjPtr<mirror::Class> klass,
+                                  const char* name,
+                                  const char* sig,
+                                  bool is_static,
+                                  bool is_field) {
+  uint32_t hash = MemberLookupHash(name, sig, is_static, is_field);
+  MutexLock mu(Thread::Current(), member_lookup_cache_lock_);
+  for (auto it = member_lookup_cache_.equal_range(hash); it.first != it.second; ++it.first) {
+    const MemberLookupCacheEntry& entry = it.first->second;
+    // Compare the class without a read barrier; the entry is updated when the class moves, so a
+    // from-space pointer can only be seen mid-collection and merely causes a miss.
+    if (entry.declaring_class.Read<kWithoutReadBarrier>() == klass.Ptr() &&
+        entry.is_static == is_static &&
+        entry.is_field == is_field &&
+        entry.name == name &&
+        entry.signature == sig) {
+      return entry.member;
     }
   }
+  return nullptr;
+}
+
+void JavaVMExt::CacheMember(ObjPtr<mirror::Class> klass,
+                            const char* name,
+                            const char* sig,
+                            bool is_static,
+                            bool is_field,
+                            void* member) {
+  uint32_t hash = MemberLookupHash(name, sig, is_static, is_field);
+  MutexLock mu(Thread::Current(), member_lookup_cache_lock_);
+  // Re-probe under the lock; a racing thread may have published the same entry already.
+  for (auto it = member_lookup_cache_.equal_range(hash); it.first != it.second; ++it.first) {
+    const MemberLookupCacheEntry& entry = it.first->second;
+    if (entry.declaring_class.Read<kWithoutReadBarrier>() == klass.Ptr() &&
+        entry.is_static == is_static &&
+        entry.is_field == is_field &&
+        entry.name == name &&
+        entry.signature == sig) {
+      DCHECK_EQ(entry.member, member);
+      return;
+    }
+  }
+  MemberLookupCacheEntry entry;
+  entry.declaring_class = GcRoot<mirror::Class>(klass);
+  entry.name = name;
+  entry.signature = sig;
+  entry.is_static = is_static;
+  entry.is_field = is_field;
+  entry.member = member;
+  member_lookup_cache_.emplace(hash, std::move(entry));
+}
+
+ArtMethod* JavaVMExt::FindCachedMethod(ObjPtr<mirror::Class> klass,
+                                       const char* name,
+                                       const char* sig,
+                                       bool is_static) {
+  return reinterpret_cast<ArtMethod*>(
+      FindCachedMember(klass, name, sig, is_static, /*is_field=*/ false));
+}
+
+void JavaVMExt::CacheMethod(ObjPtr<mirror::Class> klass,
+                            const char* name,
+                            const char* sig,
+                            bool is_static,
+                            ArtMethod* method) {
+  DCHECK(method != nullptr);
+  CacheMember(klass, name, sig, is_static, /*is_field=*/ false, method);
+}
+
+ArtField* JavaVMExt::FindCachedField(ObjPtr<mirror::Class> klass,
+                                     const char* name,
+                                     const char* sig,
+                                     bool is_static) {
+  return reinterpret_cast<ArtField*>(
+      FindCachedMember(klass, name, sig, is_static, /*is_field=*/ true));
+}
+
+void JavaVMExt::CacheField(ObjPtr<mirror::Class> klass,
+                           const char* name,
+                           const char* sig,
+                           bool is_static,
+                           ArtField* field) {
+  DCHECK(field != nullptr);
+  CacheMember(klass, name, sig, is_static, /*is_field=*/ true, field);
 }
 
 void JavaVMExt::TrimGlobals() {
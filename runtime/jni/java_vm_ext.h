@@ -19,8 +19,12 @@
 
 #include "jni.h"
 
+#include <string>
+#include <unordered_map>
+
 #include "base/macros.h"
 #include "base/mutex.h"
+#include "gc_root.h"
 #include "indirect_reference_table.h"
 #include "obj_ptr.h"
 #include "reference_table.h"
@@ -29,8 +33,10 @@ namespace art {
 
 namespace mirror {
 class Array;
+class Class;
 }  // namespace mirror
 
+class ArtField;
 class ArtMethod;
 class IsMarkedVisitor;
 class Libraries;
@@ -160,7 +166,41 @@ class JavaVMExt : public JavaVM {
 
   void SweepJniWeakGlobals(IsMarkedVisitor* visitor)
       REQUIRES_SHARED(Locks::mutator_lock_)
-      REQUIRES(!Locks::jni_weak_globals_lock_);
+      REQUIRES(!Locks::jni_weak_globals_lock_, !member_lookup_cache_lock_);
+
+  // Returns a previously cached GetMethodID lookup result for the given class, name and
+  // signature, or null on a cache miss. Only successful lookups are ever cached; callers fall
+  // back to the regular search and publish its result with CacheMethod().
+  ArtMethod* FindCachedMethod(ObjPtr<mirror::Class> klass,
+                              const char* name,
+                              const char* sig,
+                              bool is_static)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!member_lookup_cache_lock_);
+
+  void CacheMethod(ObjPtr<mirror::Class> klass,
+                   const char* name,
+                   const char* sig,
+                   bool is_static,
+                   ArtMethod* method)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!member_lookup_cache_lock_);
+
+  // GetFieldID equivalents of FindCachedMethod() and CacheMethod().
+  ArtField* FindCachedField(ObjPtr<mirror::Class> klass,
+                            const char* name,
+                            const char* sig,
+                            bool is_static)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!member_lookup_cache_lock_);
+
+  void CacheField(ObjPtr<mirror::Class> klass,
+                  const char* name,
+                  const char* sig,
+                  bool is_static,
+                  ArtField* field)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!member_lookup_cache_lock_);
 
   ObjPtr<mirror::Object> DecodeGlobal(IndirectRef ref)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -211,10 +251,42 @@ class JavaVMExt : public JavaVM {
   static jstring GetLibrarySearchPath(JNIEnv* env, jobject class_loader);
 
  private:
+  // A successfully resolved GetMethodID/GetFieldID lookup. The declaring class is held as a weak
+  // root that is swept (and updated for moving collectors) alongside the JNI weak globals.
+  // Comparisons against it deliberately skip the read barrier; the worst a concurrent moving
+  // collection can cause is a spurious cache miss.
+  struct MemberLookupCacheEntry {
+    GcRoot<mirror::Class> declaring_class;
+    std::string name;
+    std::string signature;
+    bool is_static;
+    bool is_field;
+    void* member;  // ArtMethod* or ArtField*, depending on is_field.
+  };
+
   // The constructor should not be called directly. It may leave the object in
   // an erroneous state, and the result needs to be checked.
   JavaVMExt(Runtime* runtime, const RuntimeArgumentMap& runtime_options, std::string* error_msg);
 
+  static uint32_t MemberLookupHash(const char* name, const char* sig, bool is_static, bool is_field);
+
+  void* FindCachedMember(ObjPtr<mirror::Class> klass,
+                         const char* name,
+                         const char* sig,
+                         bool is_static,
+                         bool is_field)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!member_lookup_cache_lock_);
+
+  void CacheMember(ObjPtr<mirror::Class> klass,
+                   const char* name,
+                   const char* sig,
+                   bool is_static,
+                   bool is_field,
+                   void* member)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!member_lookup_cache_lock_);
+
   // Return true if self can currently access weak globals.
   bool MayAccessWeakGlobalsUnlocked(Thread* self) const REQUIRES_SHARED(Locks::mutator_lock_);
   bool MayAccessWeakGlobals(Thread* self) const
@@ -259,6 +331,13 @@ class JavaVMExt : public JavaVM {
   // TODO Maybe move this to Runtime.
   std::vector<GetEnvHook> env_hooks_;
 
+  // Memo table for repeated GetMethodID/GetFieldID lookups, keyed by a hash of the member name,
+  // signature and kind; the declaring class is matched per entry. Entries for unloaded classes
+  // are dropped in SweepJniWeakGlobals().
+  mutable Mutex member_lookup_cache_lock_;
+  std::unordered_multimap<uint32_t, MemberLookupCacheEntry> member_lookup_cache_
+      GUARDED_BY(member_lookup_cache_lock_);
+
   size_t enable_allocation_tracking_delta_;
   std::atomic<bool> allocation_tracking_enabled_;
   std::atomic<bool> old_allocation_tracking_state_;
@@ -323,6 +323,17 @@ uintptr_t JniIdManager::EncodeGenericId(ReflectiveHandle<ArtType> t) {
     DCHECK(IsObsolete(t) || deferred_allocation_refcount_ > 0u)
         << "deferred_allocation_refcount_: " << deferred_allocation_refcount_
         << " t: " << PrettyGeneric(t);
+    if constexpr (std::is_same_v<ArtType, ArtMethod>) {
+      // Obsolete methods keep their id until the map is searched linearly below. Serve repeat
+      // encodes from the cache so agents tracing redefined code don't pay for the search on
+      // every event.
+      if (IsObsolete(t)) {
+        auto cache_it = obsolete_method_id_map_.find(t.Get());
+        if (cache_it != obsolete_method_id_map_.end()) {
+          return cache_it->second;
+        }
+      }
+    }
     // Check to see if we raced and lost to another thread.
     const std::vector<ArtType*>& vec = GetGenericMap<ArtType>();
     bool found = false;
@@ -342,6 +353,11 @@ uintptr_t JniIdManager::EncodeGenericId(ReflectiveHandle<ArtType> t) {
       DCHECK_EQ(vec[index], t.Get())
           << "Expected: " << PrettyGeneric(vec[index]) << " got " << PrettyGeneric(t)
           << " at index " << index << " (id: " << IndexToId(index) << ").";
+      if constexpr (std::is_same_v<ArtType, ArtMethod>) {
+        if (IsObsolete(t)) {
+          obsolete_method_id_map_.emplace(t.Get(), IndexToId(index));
+        }
+      }
       return IndexToId(index);
     }
   }
@@ -358,6 +374,11 @@ uintptr_t JniIdManager::EncodeGenericId(ReflectiveHandle<ArtType> t) {
           << "Failed to allocate ids array despite not being forbidden from doing so!";
       Locks::mutator_lock_->AssertExclusiveHeld(self);
     }
+    if constexpr (std::is_same_v<ArtType, ArtMethod>) {
+      if (IsObsolete(t)) {
+        obsolete_method_id_map_.emplace(t.Get(), cur_id);
+      }
+    }
   } else {
     ids->SetElementPtrSize(off, reinterpret_cast<void*>(cur_id), kRuntimePointerSize);
   }
@@ -475,6 +496,12 @@ void JniIdManager::VisitReflectiveTargets(ReflectiveValueVisitor* rvv) {
         rvv->VisitMethod(old_method, JniIdReflectiveSourceInfo(reinterpret_cast<jmethodID>(id)));
     if (old_method != new_method) {
       *it = new_method;
+      // Keep the obsolete-method id cache in sync with the moved pointer.
+      auto cache_it = obsolete_method_id_map_.find(old_method);
+      if (cache_it != obsolete_method_id_map_.end()) {
+        obsolete_method_id_map_.erase(cache_it);
+        obsolete_method_id_map_.emplace(new_method, id);
+      }
       ObjPtr<mirror::Class> old_class(old_method->GetDeclaringClass());
       ObjPtr<mirror::Class> new_class(new_method->GetDeclaringClass());
       ObjPtr<mirror::ClassExt> old_ext_data(old_class->GetExtData());
@@ -20,6 +20,7 @@
 #include <jni.h>
 
 #include <atomic>
+#include <unordered_map>
 #include <vector>
 
 #include "art_field.h"
@@ -89,6 +90,11 @@ class JniIdManager {
 
   uintptr_t next_method_id_ GUARDED_BY(Locks::jni_id_lock_) = 1u;
   std::vector<ArtMethod*> method_id_map_ GUARDED_BY(Locks::jni_id_lock_);
+  // Cache from obsolete methods to their assigned ids. Obsolete methods have no ids array on
+  // their class, so without this cache every encode of one linearly searches method_id_map_,
+  // which is on the per-event path when an agent traces code it has redefined.
+  std::unordered_map<ArtMethod*, uintptr_t> obsolete_method_id_map_
+      GUARDED_BY(Locks::jni_id_lock_);
   uintptr_t next_field_id_ GUARDED_BY(Locks::jni_id_lock_) = 1u;
   std::vector<ArtField*> field_id_map_ GUARDED_BY(Locks::jni_id_lock_);
 
@@ -37,6 +37,7 @@
 #include "fault_handler.h"
 #include "hidden_api.h"
 #include "gc/accounting/card_table-inl.h"
+#include "gc/space/region_space.h"
 #include "gc_root.h"
 #include "indirect_reference_table-inl.h"
 #include "interpreter/interpreter.h"
@@ -320,20 +321,30 @@ ArtMethod* FindMethodJNI(const ScopedObjectAccess& soa,
   if (c == nullptr) {
     return nullptr;
   }
-  ArtMethod* method = nullptr;
-  auto pointer_size = Runtime::Current()->GetClassLinker()->GetImagePointerSize();
-  if (c->IsInterface()) {
-    method = c->FindInterfaceMethod(name, sig, pointer_size);
-  } else {
-    method = c->FindClassMethod(name, sig, pointer_size);
-  }
-  if (method != nullptr && ShouldDenyAccessToMember(method, soa.Self())) {
+  JavaVMExt* vm = Runtime::Current()->GetJavaVM();
+  ArtMethod* method = vm->FindCachedMethod(c, name, sig, is_static);
+  if (method != nullptr) {
+    // Hidden API checks depend on the caller, so they cannot be baked into cache entries.
+    if (LIKELY(!ShouldDenyAccessToMember(method, soa.Self()))) {
+      return method;
+    }
     method = nullptr;
+  } else {
+    auto pointer_size = Runtime::Current()->GetClassLinker()->GetImagePointerSize();
+    if (c->IsInterface()) {
+      method = c->FindInterfaceMethod(name, sig, pointer_size);
+    } else {
+      method = c->FindClassMethod(name, sig, pointer_size);
+    }
+    if (method != nullptr && ShouldDenyAccessToMember(method, soa.Self())) {
+      method = nullptr;
+    }
   }
   if (method == nullptr || method->IsStatic() != is_static) {
     ThrowNoSuchMethodError(soa, c, name, sig, is_static ? "static" : "non-static");
     return nullptr;
   }
+  vm->CacheMethod(c, name, sig, is_static, method);
   return method;
 }
 
@@ -348,6 +359,12 @@ ArtField* FindFieldJNI(const ScopedObjectAccess& soa,
   if (c == nullptr) {
     return nullptr;
   }
+  JavaVMExt* vm = Runtime::Current()->GetJavaVM();
+  ArtField* cached_field = vm->FindCachedField(c.Get(), name, sig, is_static);
+  // Hidden API checks depend on the caller, so they cannot be baked into cache entries.
+  if (cached_field != nullptr && LIKELY(!ShouldDenyAccessToMember(cached_field, soa.Self()))) {
+    return cached_field;
+  }
   ArtField* field = nullptr;
   ObjPtr<mirror::Class> field_type;
   ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
@@ -391,6 +408,7 @@ ArtField* FindFieldJNI(const ScopedObjectAccess& soa,
                                    sig, name, c->GetDescriptor(&temp));
     return nullptr;
   }
+  vm->CacheField(c.Get(), name, sig, is_static, field);
   return field;
 }
 
@@ -2110,13 +2128,17 @@ class JNI {
     if (heap->IsMovableObject(array)) {
       if (!kUseReadBarrier) {
         heap->IncrementDisableMovingGC(soa.Self());
-      } else {
+        // Re-decode in case the object moved since IncrementDisableGC waits for GC to complete.
+        array = soa.Decode<mirror::Array>(java_array);
+      } else if (!TryPinArrayCritical(heap, array)) {
         // For the CC collector, we only need to wait for the thread flip rather than the whole GC
-        // to occur thanks to the to-space invariant.
+        // to occur thanks to the to-space invariant. Arrays large enough to have their own
+        // region(s) take an even cheaper path above: the regions are pinned against evacuation,
+        // so the raw pointer stays valid with no process-wide GC bookkeeping at all.
         heap->IncrementDisableThreadFlip(soa.Self());
+        // Re-decode in case the object moved while waiting for the thread flip to complete.
+        array = soa.Decode<mirror::Array>(java_array);
       }
-      // Re-decode in case the object moved since IncrementDisableGC waits for GC to complete.
-      array = soa.Decode<mirror::Array>(java_array);
     }
     if (is_copy != nullptr) {
       *is_copy = JNI_FALSE;
@@ -2611,7 +2633,8 @@ class JNI {
       return nullptr;
     }
     // Only make a copy if necessary.
-    if (Runtime::Current()->GetHeap()->IsMovableObject(array)) {
+    gc::Heap* heap = Runtime::Current()->GetHeap();
+    if (heap->IsMovableObject(array)) {
       if (is_copy != nullptr) {
         *is_copy = JNI_TRUE;
       }
@@ -2619,6 +2642,9 @@ class JNI {
       size_t size = array->GetLength() * component_size;
       void* data = new uint64_t[RoundUp(size, 8) / 8];
       memcpy(data, array->GetData(), size);
+      // Encourage the allocator to place future arrays of this size where they will not need to
+      // be copied in and out for JNI.
+      heap->NotifyJniArrayElementsCopied(size);
       return reinterpret_cast<ElementT*>(data);
     } else {
       if (is_copy != nullptr) {
@@ -2640,6 +2666,23 @@ class JNI {
     ReleasePrimitiveArray(soa, array, sizeof(ElementT), elements, mode);
   }
 
+  // With the concurrent copying collector, an array large enough to have its own region(s)
+  // can be handed out to a JNI critical section by pinning those regions against evacuation
+  // instead of disabling thread flips process-wide. The release path detects that a pin
+  // (rather than a thread flip disable) was used via the same stable property: a pinned
+  // array cannot move, so it is still backed by a large region when released.
+  static bool TryPinArrayCritical(gc::Heap* heap, ObjPtr<mirror::Array> array)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    gc::space::RegionSpace* region_space = heap->GetRegionSpace();
+    return region_space != nullptr && region_space->TryPinObject(array.Ptr());
+  }
+
+  static bool TryUnpinArrayCritical(gc::Heap* heap, ObjPtr<mirror::Array> array)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    gc::space::RegionSpace* region_space = heap->GetRegionSpace();
+    return region_space != nullptr && region_space->TryUnpinObject(array.Ptr());
+  }
+
   static void ReleasePrimitiveArray(ScopedObjectAccess& soa,
                                     ObjPtr<mirror::Array> array,
                                     size_t component_size,
@@ -2675,7 +2718,7 @@ class JNI {
         // Non copy to a movable object must means that we had disabled the moving GC.
         if (!kUseReadBarrier) {
           heap->DecrementDisableMovingGC(soa.Self());
-        } else {
+        } else if (!TryUnpinArrayCritical(heap, array)) {
           heap->DecrementDisableThreadFlip(soa.Self());
         }
       }
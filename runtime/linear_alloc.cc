@@ -16,11 +16,19 @@
 
 #include "linear_alloc.h"
 
+#include "base/atomic.h"
+#include "base/bit_utils.h"
 #include "thread-current-inl.h"
 
 namespace art {
 
-LinearAlloc::LinearAlloc(ArenaPool* pool) : lock_("linear alloc"), allocator_(pool) {
+// Ids are handed out starting at 1; 0 is reserved for "no buffer" in Thread.
+static Atomic<uint64_t> g_next_linear_alloc_id(1u);
+
+LinearAlloc::LinearAlloc(ArenaPool* pool)
+    : lock_("linear alloc"),
+      allocator_(pool),
+      id_(g_next_linear_alloc_id.fetch_add(1u, std::memory_order_relaxed)) {
 }
 
 void* LinearAlloc::Realloc(Thread* self, void* ptr, size_t old_size, size_t new_size) {
@@ -29,10 +37,37 @@ void* LinearAlloc::Realloc(Thread* self, void* ptr, size_t old_size, size_t new_
 }
 
 void* LinearAlloc::Alloc(Thread* self, size_t size) {
+  const size_t aligned_size = RoundUp(size, ArenaAllocator::kAlignment);
+  if (aligned_size <= kMaxThreadBufferAllocSize) {
+    return AllocFromThreadBuffer(self, aligned_size);
+  }
   MutexLock mu(self, lock_);
   return allocator_.Alloc(size);
 }
 
+void* LinearAlloc::AllocFromThreadBuffer(Thread* self, size_t aligned_size) {
+  DCHECK_ALIGNED(aligned_size, ArenaAllocator::kAlignment);
+  DCHECK_LE(aligned_size, kThreadBufferSize);
+  if (self->GetLinearAllocBufferId() == id_) {
+    uint8_t* const pos = self->GetLinearAllocBufferPos();
+    if (aligned_size <= static_cast<size_t>(self->GetLinearAllocBufferEnd() - pos)) {
+      self->SetLinearAllocBufferPos(pos + aligned_size);
+      return pos;
+    }
+  }
+  // Refill: carve a new buffer out of the shared allocator. The buffer memory stays owned by
+  // allocator_, so Contains() and GetUsedMemory() see it like any other allocation and it is
+  // released together with the allocator. Any tail left in the previous buffer is wasted, which
+  // is bounded by kMaxThreadBufferAllocSize per refill.
+  uint8_t* buffer;
+  {
+    MutexLock mu(self, lock_);
+    buffer = reinterpret_cast<uint8_t*>(allocator_.Alloc(kThreadBufferSize));
+  }
+  self->SetLinearAllocBuffer(id_, buffer + aligned_size, buffer + kThreadBufferSize);
+  return buffer;
+}
+
 void* LinearAlloc::AllocAlign16(Thread* self, size_t size) {
   MutexLock mu(self, lock_);
   return allocator_.AllocAlign16(size);
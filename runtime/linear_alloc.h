@@ -18,6 +18,7 @@
 #define ART_RUNTIME_LINEAR_ALLOC_H_
 
 #include "base/arena_allocator.h"
+#include "base/globals.h"
 #include "base/mutex.h"
 
 namespace art {
@@ -27,6 +28,12 @@ class ArenaPool;
 // TODO: Support freeing if we add poor man's class unloading.
 class LinearAlloc {
  public:
+  // Size of the per-thread buffer carved out of the shared allocator, and the largest
+  // allocation served from it. Larger allocations go straight to the shared allocator
+  // under the lock.
+  static constexpr size_t kThreadBufferSize = 16 * KB;
+  static constexpr size_t kMaxThreadBufferAllocSize = 4 * KB;
+
   explicit LinearAlloc(ArenaPool* pool);
 
   void* Alloc(Thread* self, size_t size) REQUIRES(!lock_);
@@ -54,8 +61,15 @@ class LinearAlloc {
   bool ContainsUnsafe(void* ptr) const NO_THREAD_SAFETY_ANALYSIS;
 
  private:
+  // Allocate from the calling thread's buffer, refilling it from the shared allocator if
+  // needed. `aligned_size` must already be rounded up to ArenaAllocator::kAlignment.
+  void* AllocFromThreadBuffer(Thread* self, size_t aligned_size) REQUIRES(!lock_);
+
   mutable Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
   ArenaAllocator allocator_ GUARDED_BY(lock_);
+  // Unique id used to match per-thread buffers to this allocator, see
+  // Thread::GetLinearAllocBufferId. Ids are never reused.
+  const uint64_t id_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(LinearAlloc);
 };
@@ -111,6 +111,42 @@ inline bool IsReferenceType(Primitive::Type type) {
   return type == Primitive::kPrimNot;
 }
 
+// Memoized wrappers for the MethodType checks performed on every interpreted
+// method handle invocation. A given call site compares the same (callsite, target)
+// MethodType pair each time it is executed, so the per-thread single-entry memo in
+// Thread removes the O(#parameters) parameter type walks from the steady state.
+// Only useful where both types are reused across invocations; freshly allocated
+// MethodTypes (e.g. the accessor types derived per VarHandle invoke) never hit.
+bool IsExactMatchMemoized(Thread* self,
+                          ObjPtr<mirror::MethodType> callsite_type,
+                          ObjPtr<mirror::MethodType> target_type)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  bool result;
+  if (self->GetCachedMethodTypeCheck(
+          callsite_type, target_type, /*exact_match=*/ true, &result)) {
+    DCHECK_EQ(result, callsite_type->IsExactMatch(target_type));
+    return result;
+  }
+  result = callsite_type->IsExactMatch(target_type);
+  self->CacheMethodTypeCheck(callsite_type, target_type, /*exact_match=*/ true, result);
+  return result;
+}
+
+bool IsConvertibleMemoized(Thread* self,
+                           ObjPtr<mirror::MethodType> callsite_type,
+                           ObjPtr<mirror::MethodType> target_type)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  bool result;
+  if (self->GetCachedMethodTypeCheck(
+          callsite_type, target_type, /*exact_match=*/ false, &result)) {
+    DCHECK_EQ(result, callsite_type->IsConvertible(target_type));
+    return result;
+  }
+  result = callsite_type->IsConvertible(target_type);
+  self->CacheMethodTypeCheck(callsite_type, target_type, /*exact_match=*/ false, result);
+  return result;
+}
+
 inline bool IsPrimitiveType(Primitive::Type type) {
   return !IsReferenceType(type);
 }
@@ -461,7 +497,7 @@ static inline bool MethodHandleInvokeMethod(ArtMethod* called_method,
   {
     ScopedStackedShadowFramePusher pusher(
         self, new_shadow_frame, StackedShadowFrameType::kShadowFrameUnderConstruction);
-    if (callsite_type->IsExactMatch(target_type.Get())) {
+    if (IsExactMatchMemoized(self, callsite_type.Get(), target_type.Get())) {
       // This is an exact invoke, we can take the fast path of just copying all
       // registers without performing any argument conversions.
       CopyArgumentsFromCallerFrame(shadow_frame,
@@ -491,7 +527,7 @@ static inline bool MethodHandleInvokeMethod(ArtMethod* called_method,
           return false;
         }
       } else {
-        if (!callsite_type->IsConvertible(target_type.Get())) {
+        if (!IsConvertibleMemoized(self, callsite_type.Get(), target_type.Get())) {
           ThrowWrongMethodTypeException(target_type.Get(), callsite_type.Get());
           return false;
         }
@@ -1022,7 +1058,7 @@ bool DoVarHandleInvokeTranslation(Thread* self,
     // non-exact invoke path doesn't have a similar check due to
     // transformers which have EmulatedStack frame arguments with the
     // actual method type associated with the frame.
-    if (UNLIKELY(!callsite_type->IsConvertible(method_handle->GetMethodType()))) {
+    if (UNLIKELY(!IsConvertibleMemoized(self, callsite_type.Get(), method_handle->GetMethodType()))) {
       ThrowWrongMethodTypeException(method_handle->GetMethodType(), callsite_type.Get());
       return false;
     }
@@ -1104,7 +1140,7 @@ static inline bool MethodHandleInvokeInternal(Thread* self,
   if (IsFieldAccess(handle_kind)) {
     ObjPtr<mirror::MethodType> handle_type(method_handle->GetMethodType());
     DCHECK(!callsite_type->IsExactMatch(handle_type.Ptr()));
-    if (!callsite_type->IsConvertible(handle_type.Ptr())) {
+    if (!IsConvertibleMemoized(self, callsite_type.Get(), handle_type)) {
       ThrowWrongMethodTypeException(handle_type.Ptr(), callsite_type.Get());
       return false;
     }
@@ -1144,7 +1180,7 @@ static inline bool MethodHandleInvokeExactInternal(
     REQUIRES_SHARED(Locks::mutator_lock_) {
   StackHandleScope<1> hs(self);
   Handle<mirror::MethodType> method_handle_type(hs.NewHandle(method_handle->GetMethodType()));
-  if (!callsite_type->IsExactMatch(method_handle_type.Get())) {
+  if (!IsExactMatchMemoized(self, callsite_type.Get(), method_handle_type.Get())) {
     ThrowWrongMethodTypeException(method_handle_type.Get(), callsite_type.Get());
     return false;
   }
@@ -1247,7 +1283,7 @@ bool MethodHandleInvoke(Thread* self,
                        const InstructionOperands* const operands,
                        JValue* result)
     REQUIRES_SHARED(Locks::mutator_lock_) {
-  if (UNLIKELY(callsite_type->IsExactMatch(method_handle->GetMethodType()))) {
+  if (UNLIKELY(IsExactMatchMemoized(self, callsite_type.Get(), method_handle->GetMethodType()))) {
     // A non-exact invoke that can be invoked exactly.
     return MethodHandleInvokeExactInternal(self,
                                            shadow_frame,
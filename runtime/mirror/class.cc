@@ -16,8 +16,10 @@
 
 #include "class.h"
 
+#include <tuple>
 #include <unordered_set>
 #include <string_view>
+#include <utility>
 
 #include "android-base/macros.h"
 #include "android-base/stringprintf.h"
@@ -37,6 +39,7 @@
 #include "dex/dex_file-inl.h"
 #include "dex/dex_file_annotations.h"
 #include "dex/signature-inl.h"
+#include "dex/utf.h"
 #include "dex_cache-inl.h"
 #include "gc/accounting/card_table-inl.h"
 #include "gc/heap-inl.h"
@@ -1447,6 +1450,53 @@ static bool IsMethodPreferredOver(ArtMethod* orig_method,
   return false;
 }
 
+// Binary-searches `methods` for the contiguous run of methods whose name equals
+// `name` and returns its [begin, end) indices ([0, 0) if there is none).
+// Declared methods are stored in dex method_id order, which sorts by name (as
+// code point values, like string_ids) before signature, so all overloads of a
+// name are adjacent; compare FindFieldByName in native/java_lang_Class.cc.
+// Must not be used for proxy classes: their method arrays are in interface
+// declaration order and the names live on the interface methods.
+static std::pair<size_t, size_t> FindDeclaredMethodsByName(ObjPtr<String> name,
+                                                           const ArraySlice<ArtMethod>& methods)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  const bool is_name_compressed = name->IsCompressed();
+  const uint16_t* const data = is_name_compressed ? nullptr : name->GetValue();
+  const uint8_t* const data_compressed = is_name_compressed ? name->GetValueCompressed() : nullptr;
+  const size_t length = name->GetLength();
+  auto compare = [&](const char* method_name) REQUIRES_SHARED(Locks::mutator_lock_) {
+    if (is_name_compressed) {
+      size_t method_name_length = strlen(method_name);
+      size_t min_size = (length < method_name_length) ? length : method_name_length;
+      int result = memcmp(method_name, data_compressed, min_size);
+      return (result != 0) ? result : static_cast<int>(method_name_length - length);
+    }
+    return CompareModifiedUtf8ToUtf16AsCodePointValues(method_name, data, length);
+  };
+  size_t low = 0u;
+  size_t high = methods.size();
+  while (low < high) {
+    size_t mid = (low + high) / 2u;
+    if (compare(methods[mid].GetName()) < 0) {
+      low = mid + 1u;
+    } else {
+      high = mid;
+    }
+  }
+  size_t end = low;
+  while (end != methods.size() && compare(methods[end].GetName()) == 0) {
+    ++end;
+  }
+  if (kIsDebugBuild) {
+    // Check the name ordering assumption: exactly the run's methods match.
+    for (size_t i = 0u; i != methods.size(); ++i) {
+      CHECK_EQ(compare(methods[i].GetName()) == 0, low <= i && i < end)
+          << methods[i].PrettyMethod();
+    }
+  }
+  return {low, end};
+}
+
 template <PointerSize kPointerSize, bool kTransactionActive>
 ObjPtr<Method> Class::GetDeclaredMethodInternal(
     Thread* self,
@@ -1472,14 +1522,36 @@ ObjPtr<Method> Class::GetDeclaredMethodInternal(
   constexpr hiddenapi::AccessMethod access_method = hiddenapi::AccessMethod::kNone;
   ArtMethod* result = nullptr;
   bool result_hidden = false;
-  for (auto& m : h_klass->GetDeclaredVirtualMethods(kPointerSize)) {
+  // For non-proxy classes the declared method slices are sorted by name (dex
+  // method_id order), so binary-search for the run of same-name overloads
+  // instead of resolving and comparing the name of every declared method.
+  // Proxy method arrays are in interface declaration order and keep the
+  // linear scan with an explicit name check.
+  const bool is_proxy = h_klass->IsProxyClass();
+  ArraySlice<ArtMethod> virtual_methods = h_klass->GetDeclaredVirtualMethodsSlice(kPointerSize);
+  size_t virtual_begin = 0u;
+  size_t virtual_end = virtual_methods.size();
+  if (!is_proxy) {
+    std::tie(virtual_begin, virtual_end) =
+        FindDeclaredMethodsByName(h_method_name.Get(), virtual_methods);
+  }
+  for (size_t i = virtual_begin; i != virtual_end; ++i) {
+    ArtMethod& m = virtual_methods[i];
     if (m.IsMiranda()) {
       continue;
     }
     auto* np_method = m.GetInterfaceMethodIfProxy(kPointerSize);
-    // May cause thread suspension.
-    ObjPtr<String> np_name = np_method->ResolveNameString();
-    if (!np_name->Equals(h_method_name.Get()) || !np_method->EqualParameters(h_args)) {
+    if (is_proxy) {
+      // May cause thread suspension.
+      ObjPtr<String> np_name = np_method->ResolveNameString();
+      if (!np_name->Equals(h_method_name.Get())) {
+        if (UNLIKELY(self->IsExceptionPending())) {
+          return nullptr;
+        }
+        continue;
+      }
+    }
+    if (!np_method->EqualParameters(h_args)) {
       if (UNLIKELY(self->IsExceptionPending())) {
         return nullptr;
       }
@@ -1503,19 +1575,35 @@ ObjPtr<Method> Class::GetDeclaredMethodInternal(
     DCHECK(!result->IsDirect());
     DCHECK(result->IsSynthetic());
   } else {
-    for (auto& m : h_klass->GetDirectMethods(kPointerSize)) {
+    ArraySlice<ArtMethod> direct_methods = h_klass->GetDirectMethodsSlice(kPointerSize);
+    size_t direct_begin = 0u;
+    size_t direct_end = direct_methods.size();
+    if (!is_proxy) {
+      std::tie(direct_begin, direct_end) =
+          FindDeclaredMethodsByName(h_method_name.Get(), direct_methods);
+    }
+    for (size_t i = direct_begin; i != direct_end; ++i) {
+      ArtMethod& m = direct_methods[i];
       auto modifiers = m.GetAccessFlags();
       if ((modifiers & kAccConstructor) != 0) {
         continue;
       }
       auto* np_method = m.GetInterfaceMethodIfProxy(kPointerSize);
-      // May cause thread suspension.
-      ObjPtr<String> np_name = np_method->ResolveNameString();
-      if (np_name == nullptr) {
-        self->AssertPendingException();
-        return nullptr;
+      if (is_proxy) {
+        // May cause thread suspension.
+        ObjPtr<String> np_name = np_method->ResolveNameString();
+        if (np_name == nullptr) {
+          self->AssertPendingException();
+          return nullptr;
+        }
+        if (!np_name->Equals(h_method_name.Get())) {
+          if (UNLIKELY(self->IsExceptionPending())) {
+            return nullptr;
+          }
+          continue;
+        }
       }
-      if (!np_name->Equals(h_method_name.Get()) || !np_method->EqualParameters(h_args)) {
+      if (!np_method->EqualParameters(h_args)) {
         if (UNLIKELY(self->IsExceptionPending())) {
           return nullptr;
         }
@@ -239,7 +239,7 @@ inline ObjPtr<CallSite> DexCache::SetResolvedCallSite(uint32_t call_site_idx,
 
 inline uint32_t DexCache::FieldSlotIndex(uint32_t field_idx) {
   DCHECK_LT(field_idx, GetDexFile()->NumFieldIds());
-  const uint32_t slot_idx = field_idx % kDexCacheFieldCacheSize;
+  const uint32_t slot_idx = field_idx % FieldCacheSize(GetDexFile()->NumFieldIds());
   DCHECK_LT(slot_idx, NumResolvedFields());
   return slot_idx;
 }
@@ -271,7 +271,7 @@ inline void DexCache::ClearResolvedField(uint32_t field_idx, PointerSize ptr_siz
 
 inline uint32_t DexCache::MethodSlotIndex(uint32_t method_idx) {
   DCHECK_LT(method_idx, GetDexFile()->NumMethodIds());
-  const uint32_t slot_idx = method_idx % kDexCacheMethodCacheSize;
+  const uint32_t slot_idx = method_idx % MethodCacheSize(GetDexFile()->NumMethodIds());
   DCHECK_LT(slot_idx, NumResolvedMethods());
   return slot_idx;
 }
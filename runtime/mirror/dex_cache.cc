@@ -76,11 +76,11 @@ void DexCache::InitializeDexCache(Thread* self,
   if (dex_file->NumTypeIds() < num_types) {
     num_types = dex_file->NumTypeIds();
   }
-  size_t num_fields = kDexCacheFieldCacheSize;
+  size_t num_fields = FieldCacheSize(dex_file->NumFieldIds());
   if (dex_file->NumFieldIds() < num_fields) {
     num_fields = dex_file->NumFieldIds();
   }
-  size_t num_methods = kDexCacheMethodCacheSize;
+  size_t num_methods = MethodCacheSize(dex_file->NumMethodIds());
   if (dex_file->NumMethodIds() < num_methods) {
     num_methods = dex_file->NumMethodIds();
   }
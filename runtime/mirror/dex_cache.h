@@ -145,16 +145,48 @@ class MANAGED DexCache final : public Object {
   static_assert(IsPowerOfTwo(kDexCacheStringCacheSize),
                 "String dex cache size is not a power of 2.");
 
-  // Size of field dex cache. Needs to be a power of 2 for entrypoint assumptions to hold.
+  // Minimum size of field dex cache. Needs to be a power of 2 for entrypoint assumptions
+  // to hold.
   static constexpr size_t kDexCacheFieldCacheSize = 1024;
   static_assert(IsPowerOfTwo(kDexCacheFieldCacheSize),
                 "Field dex cache size is not a power of 2.");
 
-  // Size of method dex cache. Needs to be a power of 2 for entrypoint assumptions to hold.
+  // Minimum size of method dex cache. Needs to be a power of 2 for entrypoint assumptions
+  // to hold.
   static constexpr size_t kDexCacheMethodCacheSize = 1024;
   static_assert(IsPowerOfTwo(kDexCacheMethodCacheSize),
                 "Method dex cache size is not a power of 2.");
 
+  // The method and field caches are sized to the dex file. With a fixed table, many ids of a
+  // large dex file alias to the same slot and keep evicting each other, forcing repeated trips
+  // through ClassLinker resolution. Allow up to kDexCacheIdsPerSlot ids per slot before
+  // doubling the cache, bounded by the max sizes below. All sizes stay powers of 2 so that the
+  // slot computation remains a simple mask.
+  //
+  // The IMT conflict trampolines reconstruct the method slot computation from
+  // num_resolved_methods_: when the count is smaller than MethodCacheSize() every method index
+  // fits and is its own slot, otherwise the count equals the cache size and is a power of 2
+  // usable as a mask. Keep MethodSlotIndex() and the trampolines in sync when changing this.
+  static constexpr size_t kDexCacheIdsPerSlot = 8;
+  static constexpr size_t kDexCacheFieldCacheSizeMax = 8192;
+  static_assert(IsPowerOfTwo(kDexCacheFieldCacheSizeMax),
+                "Max field dex cache size is not a power of 2.");
+  static constexpr size_t kDexCacheMethodCacheSizeMax = 8192;
+  static_assert(IsPowerOfTwo(kDexCacheMethodCacheSizeMax),
+                "Max method dex cache size is not a power of 2.");
+
+  static constexpr size_t FieldCacheSize(size_t num_field_ids) {
+    size_t size = RoundUpToPowerOfTwo(num_field_ids / kDexCacheIdsPerSlot);
+    size = (size < kDexCacheFieldCacheSize) ? kDexCacheFieldCacheSize : size;
+    return (size > kDexCacheFieldCacheSizeMax) ? kDexCacheFieldCacheSizeMax : size;
+  }
+
+  static constexpr size_t MethodCacheSize(size_t num_method_ids) {
+    size_t size = RoundUpToPowerOfTwo(num_method_ids / kDexCacheIdsPerSlot);
+    size = (size < kDexCacheMethodCacheSize) ? kDexCacheMethodCacheSize : size;
+    return (size > kDexCacheMethodCacheSizeMax) ? kDexCacheMethodCacheSizeMax : size;
+  }
+
   // Size of method type dex cache. Needs to be a power of 2 for entrypoint assumptions
   // to hold.
   static constexpr size_t kDexCacheMethodTypeCacheSize = 1024;
@@ -169,14 +201,6 @@ class MANAGED DexCache final : public Object {
     return kDexCacheStringCacheSize;
   }
 
-  static constexpr size_t StaticArtFieldSize() {
-    return kDexCacheFieldCacheSize;
-  }
-
-  static constexpr size_t StaticMethodSize() {
-    return kDexCacheMethodCacheSize;
-  }
-
   static constexpr size_t StaticMethodTypeSize() {
     return kDexCacheMethodTypeCacheSize;
   }
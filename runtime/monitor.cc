@@ -16,6 +16,8 @@
 
 #include "monitor-inl.h"
 
+#include <algorithm>
+#include <limits>
 #include <vector>
 
 #include "android-base/stringprintf.h"
@@ -79,6 +81,8 @@ static constexpr uint64_t kLongWaitMs = 100 * kDebugThresholdFudgeFactor;
 
 uint32_t Monitor::lock_profiling_threshold_ = 0;
 uint32_t Monitor::stack_dump_lock_profiling_threshold_ = 0;
+std::atomic<uint64_t> Monitor::thin_lock_contention_count_(0);
+std::atomic<uint64_t> Monitor::fat_lock_contention_count_(0);
 
 void Monitor::Init(uint32_t lock_profiling_threshold,
                    uint32_t stack_dump_lock_profiling_threshold) {
@@ -93,6 +97,7 @@ void Monitor::Init(uint32_t lock_profiling_threshold,
 Monitor::Monitor(Thread* self, Thread* owner, ObjPtr<mirror::Object> obj, int32_t hash_code)
     : monitor_lock_("a monitor lock", kMonitorLock),
       num_waiters_(0),
+      recently_locked_(true),
       owner_(owner),
       lock_count_(0),
       obj_(GcRoot<mirror::Object>(obj)),
@@ -104,6 +109,8 @@ Monitor::Monitor(Thread* self, Thread* owner, ObjPtr<mirror::Object> obj, int32_
       lock_owner_dex_pc_(0),
       lock_owner_sum_(0),
       lock_owner_request_(nullptr),
+      average_hold_time_ns_(0),
+      contended_acquire_time_ns_(0),
       monitor_id_(MonitorPool::ComputeMonitorId(this, self)) {
 #ifdef __LP64__
   DCHECK(false) << "Should not be reached in 64b";
@@ -122,6 +129,7 @@ Monitor::Monitor(Thread* self,
                  MonitorId id)
     : monitor_lock_("a monitor lock", kMonitorLock),
       num_waiters_(0),
+      recently_locked_(true),
       owner_(owner),
       lock_count_(0),
       obj_(GcRoot<mirror::Object>(obj)),
@@ -133,6 +141,8 @@ Monitor::Monitor(Thread* self,
       lock_owner_dex_pc_(0),
       lock_owner_sum_(0),
       lock_owner_request_(nullptr),
+      average_hold_time_ns_(0),
+      contended_acquire_time_ns_(0),
       monitor_id_(id) {
 #ifdef __LP64__
   next_free_ = nullptr;
@@ -416,13 +426,53 @@ std::string Monitor::PrettyContentionInfo(const std::string& owner_name,
   return oss.str();
 }
 
+int Monitor::AdaptiveSpinCount() const {
+  // The default matches the fixed spin count historically used by
+  // Mutex::ExclusiveTryLockWithSpinning when we have no hold time data yet.
+  static constexpr int kDefaultMaxSpins = 5;
+  static constexpr int kMaxAdaptiveSpins = 16;
+  static constexpr uint32_t kShortHoldNs = 5000;   // Keep spinning, release is imminent.
+  static constexpr uint32_t kLongHoldNs = 50000;   // Parking is cheaper than spinning.
+  uint32_t average = average_hold_time_ns_.load(std::memory_order_relaxed);
+  if (average == 0u) {
+    return kDefaultMaxSpins;
+  }
+  if (average <= kShortHoldNs) {
+    return kMaxAdaptiveSpins;
+  }
+  return (average >= kLongHoldNs) ? 1 : kDefaultMaxSpins;
+}
+
+void Monitor::UpdateHoldTimeEstimate(uint64_t hold_time_ns) {
+  uint32_t sample = static_cast<uint32_t>(
+      std::min<uint64_t>(hold_time_ns, std::numeric_limits<uint32_t>::max()));
+  uint32_t average = average_hold_time_ns_.load(std::memory_order_relaxed);
+  // EWMA with a weight of 1/4 for the new sample. Racy updates may drop a
+  // sample; the estimate is only a heuristic.
+  uint32_t new_average = (average == 0u) ? sample : average - (average >> 2) + (sample >> 2);
+  average_hold_time_ns_.store(std::max(new_average, 1u), std::memory_order_relaxed);
+}
+
+void Monitor::SampleHoldTimeLocked() {
+  if (contended_acquire_time_ns_ != 0u) {
+    UpdateHoldTimeEstimate(NanoTime() - contended_acquire_time_ns_);
+    contended_acquire_time_ns_ = 0u;
+  }
+}
+
+void Monitor::DumpContentionCounts(std::ostream& os) {
+  os << "Contended lock acquisitions: thin="
+     << thin_lock_contention_count_.load(std::memory_order_relaxed)
+     << " fat=" << fat_lock_contention_count_.load(std::memory_order_relaxed) << "\n";
+}
+
 bool Monitor::TryLock(Thread* self, bool spin) {
   Thread *owner = owner_.load(std::memory_order_relaxed);
   if (owner == self) {
     lock_count_++;
     CHECK_NE(lock_count_, 0u);  // Abort on overflow.
   } else {
-    bool success = spin ? monitor_lock_.ExclusiveTryLockWithSpinning(self)
+    bool success = spin ? monitor_lock_.ExclusiveTryLockWithSpinning(self, AdaptiveSpinCount())
         : monitor_lock_.ExclusiveTryLock(self);
     if (!success) {
       return false;
@@ -441,6 +491,9 @@ bool Monitor::TryLock(Thread* self, bool spin) {
 
 template <LockReason reason>
 void Monitor::Lock(Thread* self) {
+  // Note the acquisition so that the deflation pass spares this monitor; see
+  // DeflateIfIdle.
+  recently_locked_.store(true, std::memory_order_relaxed);
   bool called_monitors_callback = false;
   if (TryLock(self, /*spin=*/ true)) {
     // TODO: This preserves original behavior. Correct?
@@ -451,6 +504,7 @@ void Monitor::Lock(Thread* self) {
     return;
   }
   // Contended; not reentrant. We hold no locks, so tread carefully.
+  fat_lock_contention_count_.fetch_add(1, std::memory_order_relaxed);
   const bool log_contention = (lock_profiling_threshold_ != 0);
   uint64_t wait_start_ms = log_contention ? MilliTime() : 0;
 
@@ -622,6 +676,8 @@ void Monitor::Lock(Thread* self) {
   // We avoided touching monitor fields while suspended, so set owner_ here.
   owner_.store(self, std::memory_order_relaxed);
   DCHECK_EQ(lock_count_, 0u);
+  // Sample the hold time of this contended acquisition to tune future spinning.
+  contended_acquire_time_ns_ = NanoTime();
 
   if (ATraceEnabled()) {
     SetLockingMethodNoProxy(self);
@@ -746,6 +802,7 @@ bool Monitor::Unlock(Thread* self) {
     CheckLockOwnerRequest(self);
     AtraceMonitorUnlock();
     if (lock_count_ == 0) {
+      SampleHoldTimeLocked();
       owner_.store(nullptr, std::memory_order_relaxed);
       SignalWaiterAndReleaseMonitorLock(self);
     } else {
@@ -889,6 +946,7 @@ void Monitor::Wait(Thread* self, int64_t ms, int32_t ns,
 
     // Release the monitor lock.
     DCHECK(monitor_lock_.IsExclusiveHeld(self));
+    SampleHoldTimeLocked();
     SignalWaiterAndReleaseMonitorLock(self);
 
     // Handle the case where the thread was interrupted before we called wait().
@@ -1026,6 +1084,23 @@ bool Monitor::Deflate(Thread* self, ObjPtr<mirror::Object> obj) {
   return true;
 }
 
+bool Monitor::DeflateIfIdle(Thread* self, ObjPtr<mirror::Object> obj) {
+  DCHECK(obj != nullptr);
+  // Don't need volatile since we only deflate with mutators suspended.
+  LockWord lw(obj->GetLockWord(false));
+  if (lw.GetState() == LockWord::kFatLocked) {
+    Monitor* monitor = lw.FatLockMonitor();
+    DCHECK(monitor != nullptr);
+    // Clock-style aging: a monitor locked since the previous pass is spared
+    // once and only deflated by the next pass if it stayed idle. This keeps
+    // monitors in active use from repeatedly paying the inflation cost.
+    if (monitor->recently_locked_.exchange(false, std::memory_order_relaxed)) {
+      return false;
+    }
+  }
+  return Deflate(self, obj);
+}
+
 void Monitor::Inflate(Thread* self, Thread* owner, ObjPtr<mirror::Object> obj, int32_t hash_code) {
   DCHECK(self != nullptr);
   DCHECK(obj != nullptr);
@@ -1165,6 +1240,9 @@ ObjPtr<mirror::Object> Monitor::MonitorEnter(Thread* self,
           }
           // Contention.
           contention_count++;
+          if (contention_count == 1u) {
+            thin_lock_contention_count_.fetch_add(1, std::memory_order_relaxed);
+          }
           Runtime* runtime = Runtime::Current();
           if (contention_count <= runtime->GetMaxSpinsBeforeThinLockInflation()) {
             // TODO: Consider switching the thread state to kWaitingForLockInflation when we are
@@ -1595,80 +1673,99 @@ uint32_t Monitor::GetOwnerThreadId() {
   }
 }
 
-MonitorList::MonitorList()
+MonitorList::MonitorList() {
+}
+
+MonitorList::Shard::Shard()
     : allow_new_monitors_(true), monitor_list_lock_("MonitorList lock", kMonitorListLock),
       monitor_add_condition_("MonitorList disallow condition", monitor_list_lock_) {
 }
 
 MonitorList::~MonitorList() {
   Thread* self = Thread::Current();
-  MutexLock mu(self, monitor_list_lock_);
-  // Release all monitors to the pool.
-  // TODO: Is it an invariant that *all* open monitors are in the list? Then we could
-  // clear faster in the pool.
-  MonitorPool::ReleaseMonitors(self, &list_);
+  for (Shard& shard : shards_) {
+    MutexLock mu(self, shard.monitor_list_lock_);
+    // Release all monitors to the pool.
+    // TODO: Is it an invariant that *all* open monitors are in the list? Then we could
+    // clear faster in the pool.
+    MonitorPool::ReleaseMonitors(self, &shard.list_);
+  }
 }
 
 void MonitorList::DisallowNewMonitors() {
   CHECK(!kUseReadBarrier);
-  MutexLock mu(Thread::Current(), monitor_list_lock_);
-  allow_new_monitors_ = false;
+  Thread* self = Thread::Current();
+  for (Shard& shard : shards_) {
+    MutexLock mu(self, shard.monitor_list_lock_);
+    shard.allow_new_monitors_ = false;
+  }
 }
 
 void MonitorList::AllowNewMonitors() {
   CHECK(!kUseReadBarrier);
   Thread* self = Thread::Current();
-  MutexLock mu(self, monitor_list_lock_);
-  allow_new_monitors_ = true;
-  monitor_add_condition_.Broadcast(self);
+  for (Shard& shard : shards_) {
+    MutexLock mu(self, shard.monitor_list_lock_);
+    shard.allow_new_monitors_ = true;
+    shard.monitor_add_condition_.Broadcast(self);
+  }
 }
 
 void MonitorList::BroadcastForNewMonitors() {
   Thread* self = Thread::Current();
-  MutexLock mu(self, monitor_list_lock_);
-  monitor_add_condition_.Broadcast(self);
+  for (Shard& shard : shards_) {
+    MutexLock mu(self, shard.monitor_list_lock_);
+    shard.monitor_add_condition_.Broadcast(self);
+  }
 }
 
 void MonitorList::Add(Monitor* m) {
   Thread* self = Thread::Current();
-  MutexLock mu(self, monitor_list_lock_);
+  Shard& shard = ShardFor(m);
+  MutexLock mu(self, shard.monitor_list_lock_);
   // CMS needs this to block for concurrent reference processing because an object allocated during
   // the GC won't be marked and concurrent reference processing would incorrectly clear the JNI weak
   // ref. But CC (kUseReadBarrier == true) doesn't because of the to-space invariant.
-  while (!kUseReadBarrier && UNLIKELY(!allow_new_monitors_)) {
+  while (!kUseReadBarrier && UNLIKELY(!shard.allow_new_monitors_)) {
     // Check and run the empty checkpoint before blocking so the empty checkpoint will work in the
     // presence of threads blocking for weak ref access.
-    self->CheckEmptyCheckpointFromWeakRefAccess(&monitor_list_lock_);
-    monitor_add_condition_.WaitHoldingLocks(self);
+    self->CheckEmptyCheckpointFromWeakRefAccess(&shard.monitor_list_lock_);
+    shard.monitor_add_condition_.WaitHoldingLocks(self);
   }
-  list_.push_front(m);
+  shard.list_.push_front(m);
 }
 
 void MonitorList::SweepMonitorList(IsMarkedVisitor* visitor) {
   Thread* self = Thread::Current();
-  MutexLock mu(self, monitor_list_lock_);
-  for (auto it = list_.begin(); it != list_.end(); ) {
-    Monitor* m = *it;
-    // Disable the read barrier in GetObject() as this is called by GC.
-    ObjPtr<mirror::Object> obj = m->GetObject<kWithoutReadBarrier>();
-    // The object of a monitor can be null if we have deflated it.
-    ObjPtr<mirror::Object> new_obj = obj != nullptr ? visitor->IsMarked(obj.Ptr()) : nullptr;
-    if (new_obj == nullptr) {
-      VLOG(monitor) << "freeing monitor " << m << " belonging to unmarked object "
-                    << obj;
-      MonitorPool::ReleaseMonitor(self, m);
-      it = list_.erase(it);
-    } else {
-      m->SetObject(new_obj);
-      ++it;
+  for (Shard& shard : shards_) {
+    MutexLock mu(self, shard.monitor_list_lock_);
+    for (auto it = shard.list_.begin(); it != shard.list_.end(); ) {
+      Monitor* m = *it;
+      // Disable the read barrier in GetObject() as this is called by GC.
+      ObjPtr<mirror::Object> obj = m->GetObject<kWithoutReadBarrier>();
+      // The object of a monitor can be null if we have deflated it.
+      ObjPtr<mirror::Object> new_obj = obj != nullptr ? visitor->IsMarked(obj.Ptr()) : nullptr;
+      if (new_obj == nullptr) {
+        VLOG(monitor) << "freeing monitor " << m << " belonging to unmarked object "
+                      << obj;
+        MonitorPool::ReleaseMonitor(self, m);
+        it = shard.list_.erase(it);
+      } else {
+        m->SetObject(new_obj);
+        ++it;
+      }
     }
   }
 }
 
 size_t MonitorList::Size() {
   Thread* self = Thread::Current();
-  MutexLock mu(self, monitor_list_lock_);
-  return list_.size();
+  size_t size = 0u;
+  for (Shard& shard : shards_) {
+    MutexLock mu(self, shard.monitor_list_lock_);
+    size += shard.list_.size();
+  }
+  return size;
 }
 
 class MonitorDeflateVisitor : public IsMarkedVisitor {
@@ -1677,7 +1774,7 @@ class MonitorDeflateVisitor : public IsMarkedVisitor {
 
   mirror::Object* IsMarked(mirror::Object* object) override
       REQUIRES_SHARED(Locks::mutator_lock_) {
-    if (Monitor::Deflate(self_, object)) {
+    if (Monitor::DeflateIfIdle(self_, object)) {
       DCHECK_NE(object->GetLockWord(true).GetState(), LockWord::kFatLocked);
       ++deflate_count_;
       // If we deflated, return null so that the monitor gets removed from the array.
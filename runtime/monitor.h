@@ -148,6 +148,9 @@ class Monitor {
     return monitor_id_;
   }
 
+  // Print the global contended-acquisition counts for thin and fat locks.
+  static void DumpContentionCounts(std::ostream& os);
+
   // Inflate the lock on obj. May fail to inflate for spurious reasons, always re-check.
   static void InflateThinLocked(Thread* self, Handle<mirror::Object> obj, LockWord lock_word,
                                 uint32_t hash_code) REQUIRES_SHARED(Locks::mutator_lock_);
@@ -158,6 +161,13 @@ class Monitor {
   static bool Deflate(Thread* self, ObjPtr<mirror::Object> obj)
       REQUIRES_SHARED(Locks::mutator_lock_) NO_THREAD_SAFETY_ANALYSIS;
 
+  // Like Deflate, but spares monitors that were locked since the previous
+  // deflation pass. Used by MonitorList::DeflateMonitors so that monitors in
+  // active use do not bounce between fat and thin state, while monitors that
+  // stay idle across two passes are returned to the thin-lock fast path.
+  static bool DeflateIfIdle(Thread* self, ObjPtr<mirror::Object> obj)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
 #ifndef __LP64__
   void* operator new(size_t size) {
     // Align Monitor* as per the monitor ID field size in the lock word.
@@ -304,10 +314,27 @@ class Monitor {
       REQUIRES_SHARED(Locks::mutator_lock_);
   ALWAYS_INLINE static void AtraceMonitorUnlock();
 
+  // Returns how many brief spin rounds TryLock should attempt before parking,
+  // based on the observed hold times of this monitor. Short critical sections
+  // are worth spinning for; long ones are not.
+  int AdaptiveSpinCount() const;
+
+  // Fold a contended hold time sample into average_hold_time_ns_.
+  void UpdateHoldTimeEstimate(uint64_t hold_time_ns);
+
+  // If the current acquisition was sampled, record its hold time and clear the
+  // sample. Called by the owner when giving up the monitor.
+  void SampleHoldTimeLocked() REQUIRES(monitor_lock_);
+
   static uint32_t lock_profiling_threshold_;
   static uint32_t stack_dump_lock_profiling_threshold_;
   static bool capture_method_eagerly_;
 
+  // Global counts of contended lock acquisitions, split by lock word state at
+  // the time of contention. Exposed through DumpContentionCounts().
+  static std::atomic<uint64_t> thin_lock_contention_count_;
+  static std::atomic<uint64_t> fat_lock_contention_count_;
+
   // Holding the monitor N times is represented by holding monitor_lock_ N times.
   Mutex monitor_lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
 
@@ -318,6 +345,12 @@ class Monitor {
   // monitor acquisition. Prevents deflation.
   std::atomic<size_t> num_waiters_;
 
+  // Set on every fat-path lock acquisition (and at inflation, which is itself
+  // triggered by use) and cleared by the deflation pass. A monitor locked
+  // since the previous pass is spared once, so only monitors idle across two
+  // consecutive passes are deflated (see DeflateIfIdle).
+  std::atomic<bool> recently_locked_;
+
   // Which thread currently owns the lock? monitor_lock_ only keeps the tid.
   // Only set while holding monitor_lock_. Non-locking readers only use it to
   // compare to self or for debugging.
@@ -342,6 +375,15 @@ class Monitor {
   // Stored object hash code, generated lazily by GetHashCode.
   AtomicInteger hash_code_;
 
+  // Exponentially weighted moving average of how long contended acquisitions
+  // of this monitor held it, in nanoseconds. Updated by the owner on release,
+  // read without ordering by contenders to tune their spin effort.
+  std::atomic<uint32_t> average_hold_time_ns_;
+
+  // Time at which the current owner acquired the monitor after contention, or
+  // 0 if this acquisition is not sampled. Only accessed by the owner.
+  uint64_t contended_acquire_time_ns_ GUARDED_BY(monitor_lock_);
+
   // Data structure used to remember the method and dex pc of a recent holder of the
   // lock. Used for tracing and contention reporting. Setting these is expensive, since it
   // involves a partial stack walk. We set them only as follows, to minimize the cost:
@@ -433,28 +475,47 @@ class MonitorList {
   MonitorList();
   ~MonitorList();
 
-  void Add(Monitor* m) REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!monitor_list_lock_);
+  void Add(Monitor* m) REQUIRES_SHARED(Locks::mutator_lock_);
 
-  void SweepMonitorList(IsMarkedVisitor* visitor)
-      REQUIRES(!monitor_list_lock_) REQUIRES_SHARED(Locks::mutator_lock_);
-  void DisallowNewMonitors() REQUIRES(!monitor_list_lock_);
-  void AllowNewMonitors() REQUIRES(!monitor_list_lock_);
-  void BroadcastForNewMonitors() REQUIRES(!monitor_list_lock_);
+  void SweepMonitorList(IsMarkedVisitor* visitor) REQUIRES_SHARED(Locks::mutator_lock_);
+  void DisallowNewMonitors();
+  void AllowNewMonitors();
+  void BroadcastForNewMonitors();
   // Returns how many monitors were deflated.
-  size_t DeflateMonitors() REQUIRES(!monitor_list_lock_) REQUIRES(Locks::mutator_lock_);
-  size_t Size() REQUIRES(!monitor_list_lock_);
+  size_t DeflateMonitors() REQUIRES(Locks::mutator_lock_);
+  size_t Size();
 
   typedef std::list<Monitor*, TrackingAllocator<Monitor*, kAllocatorTagMonitorList>> Monitors;
 
  private:
-  // During sweeping we may free an object and on a separate thread have an object created using
-  // the newly freed memory. That object may then have its lock-word inflated and a monitor created.
-  // If we allow new monitor registration during sweeping this monitor may be incorrectly freed as
-  // the object wasn't marked when sweeping began.
-  bool allow_new_monitors_ GUARDED_BY(monitor_list_lock_);
-  Mutex monitor_list_lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
-  ConditionVariable monitor_add_condition_ GUARDED_BY(monitor_list_lock_);
-  Monitors list_ GUARDED_BY(monitor_list_lock_);
+  // The global list of inflated monitors is sharded so that inflation storms and
+  // GC sweeping do not all serialize on a single mutex. Each shard has its own
+  // lock, disallow flag and list; a monitor always lives in the shard selected
+  // by hashing its pointer, so per-shard sweeping covers every monitor exactly
+  // once. All shard locks share the kMonitorListLock level and are only ever
+  // held one at a time.
+  static constexpr size_t kShardCount = 8;
+
+  struct Shard {
+    Shard();
+
+    // During sweeping we may free an object and on a separate thread have an object created
+    // using the newly freed memory. That object may then have its lock-word inflated and a
+    // monitor created. If we allow new monitor registration during sweeping this monitor may be
+    // incorrectly freed as the object wasn't marked when sweeping began.
+    bool allow_new_monitors_ GUARDED_BY(monitor_list_lock_);
+    Mutex monitor_list_lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
+    ConditionVariable monitor_add_condition_ GUARDED_BY(monitor_list_lock_);
+    Monitors list_ GUARDED_BY(monitor_list_lock_);
+  };
+
+  Shard& ShardFor(Monitor* m) {
+    // Monitors are at least 8-byte aligned, so drop the alignment bits to spread
+    // neighbouring monitors over different shards.
+    return shards_[(reinterpret_cast<uintptr_t>(m) >> 3) % kShardCount];
+  }
+
+  Shard shards_[kShardCount];
 
   friend class Monitor;
   DISALLOW_COPY_AND_ASSIGN(MonitorList);
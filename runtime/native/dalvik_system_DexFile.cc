@@ -35,6 +35,7 @@
 #include "dex/art_dex_file_loader.h"
 #include "dex/descriptors_names.h"
 #include "dex/dex_file-inl.h"
+#include "dex/dex_file_annotations.h"
 #include "dex/dex_file_loader.h"
 #include "handle_scope-inl.h"
 #include "jit/debugger_interface.h"
@@ -322,6 +323,29 @@ static jobject DexFile_openDexFileNative(JNIEnv* env,
                                                                   dex_elements,
                                                                   /*out*/ &oat_file,
                                                                   /*out*/ &error_msgs);
+
+  // If dexopt has not run for this dex file (no oat file, or one without
+  // verification data), every class would otherwise be verified inline at its
+  // first use. Queue the classes for the background verification thread now,
+  // so on-demand loads mostly find already-verified classes.
+  if (class_loader != nullptr &&
+      !dex_files.empty() &&
+      (oat_file == nullptr ||
+       !CompilerFilter::IsVerificationEnabled(oat_file->GetCompilerFilter()))) {
+    std::unique_ptr<ClassLoaderContext> context =
+        ClassLoaderContext::CreateContextForClassLoader(class_loader, dex_elements);
+    if (context != nullptr && context->OpenDexFiles(kRuntimeISA, /*classpath_dir=*/ "")) {
+      std::string class_loader_context = context->EncodeContextForOatFile(/*base_dir=*/ "");
+      Runtime::Current()->GetOatFileManager().RunBackgroundVerification(
+          MakeNonOwningPointerVector(dex_files),
+          class_loader,
+          class_loader_context.c_str());
+    } else {
+      VLOG(class_linker) << "Could not establish class loader context for background "
+                         << "verification of " << sourceName.c_str();
+    }
+  }
+
   return CreateCookieFromOatFileManagerResult(env, dex_files, oat_file, error_msgs);
 }
 
@@ -399,6 +423,7 @@ static jboolean DexFile_closeDexFile(JNIEnv* env, jclass, jobject cookie) {
         if (!class_linker->IsDexFileRegistered(soa.Self(), *dex_file)) {
           // Clear the element in the array so that we can call close again.
           long_dex_files->Set(i, 0);
+          annotations::PurgeDecodedAnnotationCache(dex_file);
           delete dex_file;
         } else {
           all_deleted = false;
@@ -72,6 +72,8 @@ OatHeader::OatHeader(InstructionSet instruction_set,
       dex_file_count_(dex_file_count),
       oat_dex_files_offset_(0),
       executable_offset_(0),
+      startup_code_begin_(0),
+      startup_code_end_(0),
       jni_dlsym_lookup_trampoline_offset_(0),
       jni_dlsym_lookup_critical_trampoline_offset_(0),
       quick_generic_jni_trampoline_offset_(0),
@@ -198,6 +200,27 @@ void OatHeader::SetExecutableOffset(uint32_t executable_offset) {
   executable_offset_ = executable_offset;
 }
 
+uint32_t OatHeader::GetStartupCodeBegin() const {
+  DCHECK(IsValid());
+  return startup_code_begin_;
+}
+
+uint32_t OatHeader::GetStartupCodeEnd() const {
+  DCHECK(IsValid());
+  DCHECK_GE(startup_code_end_, startup_code_begin_);
+  return startup_code_end_;
+}
+
+void OatHeader::SetStartupCodeRange(uint32_t begin, uint32_t end) {
+  DCHECK(IsValid());
+  DCHECK_LE(begin, end);
+  DCHECK_EQ(startup_code_begin_, 0u);
+  DCHECK_EQ(startup_code_end_, 0u);
+
+  startup_code_begin_ = begin;
+  startup_code_end_ = end;
+}
+
 static const void* GetTrampoline(const OatHeader& header, uint32_t offset) {
   return (offset != 0u) ? reinterpret_cast<const uint8_t*>(&header) + offset : nullptr;
 }
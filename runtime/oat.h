@@ -32,8 +32,8 @@ class InstructionSetFeatures;
 class PACKED(4) OatHeader {
  public:
   static constexpr std::array<uint8_t, 4> kOatMagic { { 'o', 'a', 't', '\n' } };
-  // Last oat version changed reason: Change ClassStatus bits with kVerifiedNeedsAccessChecks.
-  static constexpr std::array<uint8_t, 4> kOatVersion { { '1', '8', '3', '\0' } };
+  // Last oat version changed reason: Record startup code range in the oat header.
+  static constexpr std::array<uint8_t, 4> kOatVersion { { '1', '8', '6', '\0' } };
 
   static constexpr const char* kDex2OatCmdLineKey = "dex2oat-cmdline";
   static constexpr const char* kDebuggableKey = "debuggable";
@@ -69,6 +69,14 @@ class PACKED(4) OatHeader {
   uint32_t GetExecutableOffset() const;
   void SetExecutableOffset(uint32_t executable_offset);
 
+  // Range of compiled code belonging to methods the profile marked as
+  // startup or hot, grouped together by the oat writer's method layout.
+  // Both offsets are relative to the start of the oat file; the range is
+  // empty if the file was compiled without a profile.
+  uint32_t GetStartupCodeBegin() const;
+  uint32_t GetStartupCodeEnd() const;
+  void SetStartupCodeRange(uint32_t begin, uint32_t end);
+
   const void* GetJniDlsymLookupTrampoline() const;
   uint32_t GetJniDlsymLookupTrampolineOffset() const;
   void SetJniDlsymLookupTrampolineOffset(uint32_t offset);
@@ -125,6 +133,8 @@ class PACKED(4) OatHeader {
   uint32_t dex_file_count_;
   uint32_t oat_dex_files_offset_;
   uint32_t executable_offset_;
+  uint32_t startup_code_begin_;
+  uint32_t startup_code_end_;
   uint32_t jni_dlsym_lookup_trampoline_offset_;
   uint32_t jni_dlsym_lookup_critical_trampoline_offset_;
   uint32_t quick_generic_jni_trampoline_offset_;
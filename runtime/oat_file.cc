@@ -24,6 +24,7 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <limits>
 #include <sstream>
 #include <type_traits>
 #include <sys/stat.h>
@@ -38,6 +39,8 @@
 
 #include "arch/instruction_set_features.h"
 #include "art_method.h"
+#include "base/bit_utils.h"
+#include "base/casts.h"
 #include "base/bit_vector.h"
 #include "base/enums.h"
 #include "base/file_utils.h"
@@ -1723,9 +1726,143 @@ OatFile::OatFile(const std::string& location, bool is_executable)
 }
 
 OatFile::~OatFile() {
+  delete merged_type_lookup_table_.load(std::memory_order_relaxed);
   STLDeleteElements(&oat_dex_files_storage_);
 }
 
+// Cross-dex class lookup index for multidex oat files. The per-dex TypeLookupTables
+// answer "does this dex file define the descriptor?", so a classpath miss costs one
+// probe per dex file. This index merges all of them into a single open-addressing
+// hash table over the full 32-bit descriptor hash, mapping to the defining dex file
+// and class def index, so that one probe covers the whole oat file. Matches are
+// confirmed against the per-dex table, which compares the actual descriptor, so
+// 32-bit hash collisions between different descriptors are benign.
+class OatFile::MergedTypeLookupTable {
+ public:
+  static const MergedTypeLookupTable* Create(const OatFile* oat_file) {
+    const std::vector<const OatDexFile*>& oat_dex_files = oat_file->GetOatDexFiles();
+    size_t num_classes = 0u;
+    for (const OatDexFile* oat_dex_file : oat_dex_files) {
+      const TypeLookupTable& table = oat_dex_file->GetTypeLookupTable();
+      if (!table.Valid()) {
+        return new MergedTypeLookupTable();  // Invalid, callers fall back to per-dex probing.
+      }
+      table.Visit([&](const char* descriptor ATTRIBUTE_UNUSED, uint32_t class_def_idx) {
+        DCHECK_LE(class_def_idx, std::numeric_limits<uint16_t>::max());
+        ++num_classes;
+      });
+    }
+    if (num_classes == 0u || oat_dex_files.size() > std::numeric_limits<uint16_t>::max()) {
+      return new MergedTypeLookupTable();
+    }
+    // Size for a load factor of at most 50%; this also guarantees an empty slot
+    // so that probe loops terminate.
+    std::unique_ptr<MergedTypeLookupTable> table(
+        new MergedTypeLookupTable(oat_file, RoundUpToPowerOfTwo(num_classes * 2u)));
+    for (size_t i = 0u, size = oat_dex_files.size(); i != size; ++i) {
+      oat_dex_files[i]->GetTypeLookupTable().Visit(
+          [&](const char* descriptor, uint32_t class_def_idx) {
+            table->Insert(ComputeModifiedUtf8Hash(descriptor),
+                          dchecked_integral_cast<uint16_t>(i),
+                          dchecked_integral_cast<uint16_t>(class_def_idx));
+          });
+    }
+    return table.release();
+  }
+
+  bool Valid() const {
+    return entries_ != nullptr;
+  }
+
+  // Find the dex file defining the class with the given descriptor. Returns null and
+  // sets `*out_class_def_idx` to dex::kDexNoIndex if no dex file in the oat file
+  // defines it.
+  const OatDexFile* Lookup(const char* descriptor,
+                           uint32_t hash,
+                           /*out*/ uint32_t* out_class_def_idx) const {
+    DCHECK(Valid());
+    for (uint32_t slot = hash & mask_; ; slot = (slot + 1u) & mask_) {
+      const Entry& entry = entries_[slot];
+      if (entry.dex_file_index == kEmptySlot) {
+        *out_class_def_idx = dex::kDexNoIndex;
+        return nullptr;
+      }
+      if (entry.hash == hash) {
+        // Confirm the match; the per-dex table compares the full descriptor.
+        const OatDexFile* oat_dex_file = oat_file_->GetOatDexFiles()[entry.dex_file_index];
+        const uint32_t class_def_idx =
+            oat_dex_file->GetTypeLookupTable().Lookup(descriptor, hash);
+        if (class_def_idx != dex::kDexNoIndex) {
+          DCHECK_EQ(class_def_idx, entry.class_def_index);
+          *out_class_def_idx = class_def_idx;
+          return oat_dex_file;
+        }
+      }
+    }
+  }
+
+ private:
+  struct Entry {
+    uint32_t hash;
+    uint16_t dex_file_index;
+    uint16_t class_def_index;
+  };
+
+  static constexpr uint16_t kEmptySlot = std::numeric_limits<uint16_t>::max();
+
+  MergedTypeLookupTable() : oat_file_(nullptr), mask_(0u) {}
+
+  MergedTypeLookupTable(const OatFile* oat_file, size_t num_slots)
+      : oat_file_(oat_file),
+        mask_(dchecked_integral_cast<uint32_t>(num_slots - 1u)),
+        entries_(new Entry[num_slots]) {
+    for (size_t i = 0u; i != num_slots; ++i) {
+      entries_[i].dex_file_index = kEmptySlot;
+    }
+  }
+
+  void Insert(uint32_t hash, uint16_t dex_file_index, uint16_t class_def_index) {
+    uint32_t slot = hash & mask_;
+    while (entries_[slot].dex_file_index != kEmptySlot) {
+      slot = (slot + 1u) & mask_;
+    }
+    // Note: Linear probing preserves the relative order of entries with the same hash,
+    // so a duplicate descriptor is found in its first (lowest dex file index) dex file,
+    // matching the semantics of probing the per-dex tables in order.
+    entries_[slot] = { hash, dex_file_index, class_def_index };
+  }
+
+  const OatFile* const oat_file_;
+  const uint32_t mask_;  // Number of slots - 1; the number of slots is a power of 2.
+  std::unique_ptr<Entry[]> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(MergedTypeLookupTable);
+};
+
+bool OatFile::FindClassDefAcrossDexFiles(const char* descriptor,
+                                         size_t hash,
+                                         /*out*/ const OatDexFile** out_oat_dex_file,
+                                         /*out*/ uint32_t* out_class_def_idx) const {
+  DCHECK_EQ(ComputeModifiedUtf8Hash(descriptor), hash);
+  const MergedTypeLookupTable* table = merged_type_lookup_table_.load(std::memory_order_acquire);
+  if (UNLIKELY(table == nullptr)) {
+    const MergedTypeLookupTable* new_table = MergedTypeLookupTable::Create(this);
+    const MergedTypeLookupTable* expected = nullptr;
+    if (merged_type_lookup_table_.compare_exchange_strong(
+            expected, new_table, std::memory_order_release, std::memory_order_acquire)) {
+      table = new_table;
+    } else {
+      delete new_table;  // Lost the race; use the table installed by the other thread.
+      table = expected;
+    }
+  }
+  if (!table->Valid()) {
+    return false;
+  }
+  *out_oat_dex_file = table->Lookup(descriptor, static_cast<uint32_t>(hash), out_class_def_idx);
+  return true;
+}
+
 const OatHeader& OatFile::GetOatHeader() const {
   return *reinterpret_cast<const OatHeader*>(Begin());
 }
@@ -17,6 +17,7 @@
 #ifndef ART_RUNTIME_OAT_FILE_H_
 #define ART_RUNTIME_OAT_FILE_H_
 
+#include <atomic>
 #include <list>
 #include <string>
 #include <string_view>
@@ -309,6 +310,18 @@ class OatFile {
     return oat_dex_files_storage_;
   }
 
+  // Find the dex file in this oat file that defines a class with the given descriptor
+  // using a single probe of a lazily-built index that merges the type lookup tables
+  // of all contained dex files. On a usable index, returns true and stores the defining
+  // OatDexFile and class def index (or nullptr and dex::kDexNoIndex if no dex file in
+  // this oat file defines the class). Returns false if the index could not be built,
+  // e.g. because a dex file has no type lookup table; callers then need to fall back
+  // to probing the per-dex tables.
+  bool FindClassDefAcrossDexFiles(const char* descriptor,
+                                  size_t hash,
+                                  /*out*/ const OatDexFile** out_oat_dex_file,
+                                  /*out*/ uint32_t* out_class_def_idx) const;
+
   size_t Size() const {
     return End() - Begin();
   }
@@ -426,6 +439,13 @@ class OatFile {
   // Owning storage for the OatDexFile objects.
   std::vector<const OatDexFile*> oat_dex_files_storage_;
 
+  // Cross-dex class lookup index merging the type lookup tables of all dex files,
+  // built on first use by FindClassDefAcrossDexFiles(). An invalid table is stored
+  // if the index could not be built, so that the failure is not re-detected on
+  // every lookup.
+  class MergedTypeLookupTable;
+  mutable std::atomic<const MergedTypeLookupTable*> merged_type_lookup_table_{nullptr};
+
   // NOTE: We use a std::string_view as the key type to avoid a memory allocation on every
   // lookup with a const char* key. The std::string_view doesn't own its backing storage,
   // therefore we're using the OatFile's stored dex location as the backing storage
@@ -16,6 +16,7 @@
 
 #include "oat_file_assistant.h"
 
+#include <atomic>
 #include <sstream>
 
 #include <sys/stat.h>
@@ -27,7 +28,9 @@
 #include "base/file_utils.h"
 #include "base/logging.h"  // For VLOG.
 #include "base/macros.h"
+#include "base/mutex.h"
 #include "base/os.h"
+#include "base/safe_map.h"
 #include "base/stl_util.h"
 #include "base/string_view_cpp20.h"
 #include "base/systrace.h"
@@ -44,6 +47,7 @@
 #include "oat.h"
 #include "runtime.h"
 #include "scoped_thread_state_change-inl.h"
+#include "thread_pool.h"
 #include "vdex_file.h"
 
 namespace art {
@@ -53,6 +57,98 @@ using android::base::StringPrintf;
 static constexpr const char* kAnonymousDexPrefix = "Anonymous-DexFile@";
 static constexpr const char* kVdexExtension = ".vdex";
 
+namespace {
+
+// Process-wide cache of GetDexOptNeeded() results.
+//
+// Computing the result opens and validates the oat, vdex and dex files, which is expensive
+// enough to matter for callers that query the same dex location repeatedly. The cache is
+// keyed by the query parameters and every hit is revalidated by comparing stat()
+// fingerprints of the files the result was derived from, so artifacts replaced by dexopt
+// or package installation invalidate the entry without any file watching.
+class DexOptNeededCache {
+ public:
+  DexOptNeededCache() : lock_("OatFileAssistant dexopt-needed cache lock") {}
+
+  struct FileFingerprint {
+    bool exists = false;
+    dev_t dev = 0;
+    ino_t ino = 0;
+    off_t size = 0;
+    int64_t mtime_ns = 0;
+
+    bool Equals(const FileFingerprint& other) const {
+      return exists == other.exists &&
+             dev == other.dev &&
+             ino == other.ino &&
+             size == other.size &&
+             mtime_ns == other.mtime_ns;
+    }
+  };
+
+  static FileFingerprint FingerprintFile(const std::string& filename) {
+    FileFingerprint fp;
+    struct stat sbuf;
+    if (!filename.empty() && TEMP_FAILURE_RETRY(stat(filename.c_str(), &sbuf)) == 0) {
+      fp.exists = true;
+      fp.dev = sbuf.st_dev;
+      fp.ino = sbuf.st_ino;
+      fp.size = sbuf.st_size;
+      fp.mtime_ns = sbuf.st_mtim.tv_sec * INT64_C(1000000000) + sbuf.st_mtim.tv_nsec;
+    }
+    return fp;
+  }
+
+  bool Lookup(const std::string& key, /*out*/ int* result) {
+    MutexLock mu(Thread::Current(), lock_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      return false;
+    }
+    for (const std::pair<std::string, FileFingerprint>& file : it->second.files) {
+      if (!FingerprintFile(file.first).Equals(file.second)) {
+        entries_.erase(it);
+        return false;
+      }
+    }
+    *result = it->second.result;
+    return true;
+  }
+
+  void Store(const std::string& key, const std::vector<std::string>& filenames, int result) {
+    Entry entry;
+    entry.result = result;
+    entry.files.reserve(filenames.size());
+    for (const std::string& filename : filenames) {
+      entry.files.emplace_back(filename, FingerprintFile(filename));
+    }
+    MutexLock mu(Thread::Current(), lock_);
+    if (entries_.size() >= kMaxEntries) {
+      // Rarely hit in practice; flushing everything keeps the bookkeeping trivial.
+      entries_.clear();
+    }
+    entries_.Overwrite(key, std::move(entry));
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 64;
+
+  struct Entry {
+    std::vector<std::pair<std::string, FileFingerprint>> files;
+    int result = 0;
+  };
+
+  Mutex lock_;
+  SafeMap<std::string, Entry> entries_ GUARDED_BY(lock_);
+};
+
+DexOptNeededCache* GetDexOptNeededCache() {
+  static DexOptNeededCache* cache = new DexOptNeededCache();  // Deliberately leaked.
+  return cache;
+}
+
+}  // namespace
+
 std::ostream& operator << (std::ostream& stream, const OatFileAssistant::OatStatus status) {
   switch (status) {
     case OatFileAssistant::kOatCannotOpen:
@@ -189,16 +285,52 @@ int OatFileAssistant::GetDexOptNeeded(CompilerFilter::Filter target,
                                       const std::vector<int>& context_fds,
                                       bool profile_changed,
                                       bool downgrade) {
+  // When all inputs are plain files, the result is determined by the on-disk artifacts
+  // (the boot image is fixed for the process lifetime), so it can be answered from the
+  // process-wide cache after the first resolution.
+  const bool cacheable = !UseFdToReadFiles() && context_fds.empty();
+  std::string cache_key;
+  std::vector<std::string> cache_files;
+  if (cacheable) {
+    std::string context_spec = (class_loader_context != nullptr)
+        ? class_loader_context->EncodeContextForDex2oat(/*base_dir=*/ "")
+        : "<null>";
+    cache_key = StringPrintf("%s %s %s %d%d%d%d %s",
+                             dex_location_.c_str(),
+                             GetInstructionSetString(isa_),
+                             CompilerFilter::NameOfFilter(target).c_str(),
+                             profile_changed ? 1 : 0,
+                             downgrade ? 1 : 0,
+                             load_executable_ ? 1 : 0,
+                             only_load_system_executable_ ? 1 : 0,
+                             context_spec.c_str());
+    cache_files.push_back(dex_location_);
+    for (OatFileInfo* file_info : {&odex_, &oat_}) {
+      const std::string* filename = file_info->Filename();
+      if (filename != nullptr) {
+        cache_files.push_back(*filename);
+        cache_files.push_back(GetVdexFilename(*filename));
+      }
+    }
+    int cached_result;
+    if (GetDexOptNeededCache()->Lookup(cache_key, &cached_result)) {
+      return cached_result;
+    }
+  }
+
   OatFileInfo& info = GetBestInfo();
   DexOptNeeded dexopt_needed = info.GetDexOptNeeded(target,
                                                     class_loader_context,
                                                     context_fds,
                                                     profile_changed,
                                                     downgrade);
-  if (info.IsOatLocation() || dexopt_needed == kDex2OatFromScratch) {
-    return dexopt_needed;
+  int result = (info.IsOatLocation() || dexopt_needed == kDex2OatFromScratch)
+      ? static_cast<int>(dexopt_needed)
+      : -static_cast<int>(dexopt_needed);
+  if (cacheable) {
+    GetDexOptNeededCache()->Store(cache_key, cache_files, result);
   }
-  return -dexopt_needed;
+  return result;
 }
 
 bool OatFileAssistant::IsUpToDate() {
@@ -270,23 +402,17 @@ bool OatFileAssistant::LoadDexFiles(
     const OatFile &oat_file,
     const std::string& dex_location,
     std::vector<std::unique_ptr<const DexFile>>* out_dex_files) {
-  // Load the main dex file.
+  // Collect the oat dex file for the main dex file and all multidex entries.
   std::string error_msg;
+  std::vector<const OatDexFile*> oat_dex_files;
   const OatDexFile* oat_dex_file = oat_file.GetOatDexFile(
       dex_location.c_str(), nullptr, &error_msg);
   if (oat_dex_file == nullptr) {
     LOG(WARNING) << error_msg;
     return false;
   }
+  oat_dex_files.push_back(oat_dex_file);
 
-  std::unique_ptr<const DexFile> dex_file = oat_dex_file->OpenDexFile(&error_msg);
-  if (dex_file.get() == nullptr) {
-    LOG(WARNING) << "Failed to open dex file from oat dex file: " << error_msg;
-    return false;
-  }
-  out_dex_files->push_back(std::move(dex_file));
-
-  // Load the rest of the multidex entries
   for (size_t i = 1;; i++) {
     std::string multidex_dex_location = DexFileLoader::GetMultiDexLocation(i, dex_location.c_str());
     oat_dex_file = oat_file.GetOatDexFile(multidex_dex_location.c_str(), nullptr);
@@ -294,15 +420,51 @@ bool OatFileAssistant::LoadDexFiles(
       // There are no more multidex entries to load.
       break;
     }
+    oat_dex_files.push_back(oat_dex_file);
+  }
+
+  // Open the dex files. When there are multidex entries and the runtime thread pool is
+  // available, open the secondary entries on the pool while this thread opens the main
+  // dex file; opening only reads the oat dex file data, so the tasks are independent.
+  std::vector<std::unique_ptr<const DexFile>> dex_files(oat_dex_files.size());
+  std::atomic<bool> any_failed(false);
+  auto open_dex_file = [&](size_t i) {
+    std::string local_error_msg;
+    dex_files[i] = oat_dex_files[i]->OpenDexFile(&local_error_msg);
+    if (dex_files[i] == nullptr) {
+      LOG(WARNING) << "Failed to open dex file from oat dex file: " << local_error_msg;
+      any_failed.store(true, std::memory_order_release);
+    }
+  };
+  Thread* const self = Thread::Current();
+  Runtime::ScopedThreadPoolUsage stpu;
+  ThreadPool* const pool = stpu.GetThreadPool();
+  const bool use_parallel = pool != nullptr &&
+      oat_dex_files.size() >= 2u &&
+      self != nullptr &&
+      self->GetState() == kNative;
+  if (use_parallel) {
+    for (size_t i = 1; i != oat_dex_files.size(); ++i) {
+      pool->AddTask(self, new FunctionTask([&open_dex_file, i](Thread*) { open_dex_file(i); }));
+    }
+    open_dex_file(0u);
+    pool->Wait(self, /*do_work=*/ true, /*may_hold_locks=*/ false);
+  } else {
+    for (size_t i = 0; i != oat_dex_files.size() && !any_failed.load(std::memory_order_relaxed);
+         ++i) {
+      open_dex_file(i);
+    }
+  }
 
-    dex_file = oat_dex_file->OpenDexFile(&error_msg);
-    if (dex_file.get() == nullptr) {
-      LOG(WARNING) << "Failed to open dex file from oat dex file: " << error_msg;
-      return false;
+  bool result = true;
+  for (std::unique_ptr<const DexFile>& dex_file : dex_files) {
+    if (dex_file == nullptr) {
+      result = false;
+      break;
     }
     out_dex_files->push_back(std::move(dex_file));
   }
-  return true;
+  return result;
 }
 
 bool OatFileAssistant::HasOriginalDexFiles() {
@@ -918,7 +1080,12 @@ bool OatFileAssistant::OatFileInfo::ClassLoaderContextIsOkay(ClassLoaderContext*
       ? oat_file_assistant_->dex_location_.substr(0, dir_index)
       : "";
 
-  if (!context->OpenDexFiles(oat_file_assistant_->isa_, classpath_dir, context_fds)) {
+  // Only the locations and checksums are needed for the match check; keeping the dex files
+  // open is unnecessary and the checksums are memoized process-wide.
+  if (!context->OpenDexFiles(oat_file_assistant_->isa_,
+                             classpath_dir,
+                             context_fds,
+                             /*only_read_checksums=*/ true)) {
     VLOG(oat) << "ClassLoaderContext check failed: dex files from the context could not be opened";
     return false;
   }
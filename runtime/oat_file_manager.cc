@@ -16,22 +16,29 @@
 
 #include "oat_file_manager.h"
 
+#include <errno.h>
+#include <string.h>
+
 #include <memory>
 #include <queue>
 #include <vector>
+#include <sys/mman.h>
 #include <sys/stat.h>
 
 #include "android-base/stringprintf.h"
 #include "android-base/strings.h"
 
 #include "art_field-inl.h"
+#include "base/bit_utils.h"
 #include "base/bit_vector-inl.h"
 #include "base/file_utils.h"
+#include "base/globals.h"
 #include "base/logging.h"  // For VLOG.
 #include "base/mutex-inl.h"
 #include "base/sdk_version.h"
 #include "base/stl_util.h"
 #include "base/systrace.h"
+#include "class_linker-inl.h"
 #include "class_linker.h"
 #include "class_loader_context.h"
 #include "dex/art_dex_file_loader.h"
@@ -64,24 +71,94 @@ using android::base::StringPrintf;
 // If true, we attempt to load the application image if it exists.
 static constexpr bool kEnableAppImage = true;
 
+// Advise the kernel to back the executable portion of an oat file with
+// transparent huge pages. Large AOT-compiled apps carry tens of MiB of code
+// and the resulting iTLB pressure is visible in profiles; MADV_HUGEPAGE lets
+// khugepaged collapse the 2MiB-aligned part of the code section, mirroring
+// what the bionic linker does for native library text.
+static void MadviseHugePagesForOatCode(const OatFile* oat_file) {
+#ifdef __linux__
+  if (!oat_file->IsExecutable()) {
+    return;
+  }
+  static constexpr size_t kHugePageSize = 2 * MB;
+  const uint8_t* begin = oat_file->Begin() + oat_file->GetOatHeader().GetExecutableOffset();
+  const uint8_t* end = oat_file->End();
+  uint8_t* aligned_begin = AlignUp(const_cast<uint8_t*>(begin), kHugePageSize);
+  uint8_t* aligned_end = AlignDown(const_cast<uint8_t*>(end), kHugePageSize);
+  if (aligned_begin < aligned_end) {
+    // Purely advisory; failure (e.g. THP disabled on the device) is benign.
+    madvise(aligned_begin, aligned_end - aligned_begin, MADV_HUGEPAGE);
+  }
+#else
+  UNUSED(oat_file);
+#endif
+}
+
+// Start readahead for the code compiled from startup-flagged profile methods.
+// The oat writer groups that code together and records its extent in the oat
+// header, so a single MADV_WILLNEED covers it. The advice is issued on the
+// runtime thread pool so the storage latency overlaps with class loading
+// instead of stalling the first frames of compiled startup methods on page
+// faults.
+static void PrefetchStartupOatCode(const OatFile* oat_file) REQUIRES(!Locks::oat_file_manager_lock_) {
+#ifdef __linux__
+  if (!oat_file->IsExecutable()) {
+    return;
+  }
+  const OatHeader& oat_header = oat_file->GetOatHeader();
+  const uint32_t begin_offset = oat_header.GetStartupCodeBegin();
+  const uint32_t end_offset = oat_header.GetStartupCodeEnd();
+  if (begin_offset == end_offset ||
+      end_offset > static_cast<size_t>(oat_file->End() - oat_file->Begin())) {
+    return;
+  }
+  uint8_t* const begin = AlignDown(const_cast<uint8_t*>(oat_file->Begin() + begin_offset),
+                                   kPageSize);
+  uint8_t* const end = AlignUp(const_cast<uint8_t*>(oat_file->Begin() + end_offset), kPageSize);
+  auto function = [=](Thread*) {
+    // Purely advisory; failure is benign.
+    madvise(begin, end - begin, MADV_WILLNEED);
+  };
+  Thread* const self = Thread::Current();
+  Runtime::ScopedThreadPoolUsage stpu;
+  ThreadPool* const pool = stpu.GetThreadPool();
+  if (pool != nullptr) {
+    // Fire and forget; the oat file stays mapped for the lifetime of the
+    // process in practice, and a late hint on an unmapped range is harmless.
+    pool->AddTask(self, new FunctionTask(std::move(function)));
+  } else {
+    function(self);
+  }
+#else
+  UNUSED(oat_file);
+#endif
+}
+
 const OatFile* OatFileManager::RegisterOatFile(std::unique_ptr<const OatFile> oat_file) {
-  WriterMutexLock mu(Thread::Current(), *Locks::oat_file_manager_lock_);
-  CHECK(!only_use_system_oat_files_ ||
-        LocationIsOnSystem(oat_file->GetLocation().c_str()) ||
-        !oat_file->IsExecutable())
-      << "Registering a non /system oat file: " << oat_file->GetLocation();
-  DCHECK(oat_file != nullptr);
-  if (kIsDebugBuild) {
-    CHECK(oat_files_.find(oat_file) == oat_files_.end());
-    for (const std::unique_ptr<const OatFile>& existing : oat_files_) {
-      CHECK_NE(oat_file.get(), existing.get()) << oat_file->GetLocation();
-      // Check that we don't have an oat file with the same address. Copies of the same oat file
-      // should be loaded at different addresses.
-      CHECK_NE(oat_file->Begin(), existing->Begin()) << "Oat file already mapped at that location";
+  const OatFile* ret = oat_file.get();
+  {
+    WriterMutexLock mu(Thread::Current(), *Locks::oat_file_manager_lock_);
+    CHECK(!only_use_system_oat_files_ ||
+          LocationIsOnSystem(oat_file->GetLocation().c_str()) ||
+          !oat_file->IsExecutable())
+        << "Registering a non /system oat file: " << oat_file->GetLocation();
+    DCHECK(oat_file != nullptr);
+    if (kIsDebugBuild) {
+      CHECK(oat_files_.find(oat_file) == oat_files_.end());
+      for (const std::unique_ptr<const OatFile>& existing : oat_files_) {
+        CHECK_NE(oat_file.get(), existing.get()) << oat_file->GetLocation();
+        // Check that we don't have an oat file with the same address. Copies of the same oat file
+        // should be loaded at different addresses.
+        CHECK_NE(oat_file->Begin(), existing->Begin()) << "Oat file already mapped at that location";
+      }
     }
+    oat_files_.insert(std::move(oat_file));
   }
-  const OatFile* ret = oat_file.get();
-  oat_files_.insert(std::move(oat_file));
+  // Issue the advisory mmap hints outside of the lock: dispatching to the
+  // thread pool takes locks that rank above Locks::oat_file_manager_lock_.
+  MadviseHugePagesForOatCode(ret);
+  PrefetchStartupOatCode(ret);
   return ret;
 }
 
@@ -1090,6 +1167,76 @@ void OatFileManager::SetOnlyUseSystemOatFiles() {
   only_use_system_oat_files_ = true;
 }
 
+// Check which pages of the given mapping are resident and write their page index
+// ranges to `os` in address order, which for file-backed mappings is file order.
+// The runtime does not trace individual accesses, so a residency sample taken
+// once startup completes stands in for the set of pages touched during startup.
+static void DumpResidentPageRanges(const std::string& name,
+                                   const uint8_t* begin,
+                                   size_t size,
+                                   std::ostream& os) {
+  if (size == 0u) {
+    return;
+  }
+  const uint8_t* aligned_begin = AlignDown(begin, kPageSize);
+  const size_t num_pages = (begin - aligned_begin + size + kPageSize - 1u) / kPageSize;
+  std::vector<unsigned char> resident(num_pages);
+  void* address = const_cast<uint8_t*>(aligned_begin);
+  if (mincore(address, num_pages * kPageSize, resident.data()) != 0) {
+    os << name << ": mincore failed: " << strerror(errno) << "\n";
+    return;
+  }
+  size_t num_resident = 0u;
+  std::string ranges;
+  for (size_t i = 0u; i != num_pages; ) {
+    if ((resident[i] & 1u) == 0u) {
+      ++i;
+      continue;
+    }
+    const size_t start = i;
+    while (i != num_pages && (resident[i] & 1u) != 0u) {
+      ++i;
+      ++num_resident;
+    }
+    ranges += android::base::StringPrintf(" [%zu,%zu)", start, i);
+  }
+  os << name << ": " << num_resident << "/" << num_pages << " pages resident:" << ranges << "\n";
+}
+
+void OatFileManager::DumpPageAccessProfile(std::ostream& os) {
+  {
+    // Image space mappings. The heap lists spaces in load order which matches file order.
+    ScopedObjectAccess soa(Thread::Current());
+    for (gc::space::ContinuousSpace* space : Runtime::Current()->GetHeap()->GetContinuousSpaces()) {
+      if (space->IsImageSpace()) {
+        gc::space::ImageSpace* image_space = space->AsImageSpace();
+        DumpResidentPageRanges(
+            image_space->GetImageLocation(), image_space->Begin(), image_space->Size(), os);
+      }
+    }
+    // Dex file mappings. The "(dex)" lines use page indices relative to each
+    // dex file start, so layout tooling can map them back to dex item offsets
+    // without knowing the vdex container layout (see profman's
+    // --import-page-access-profile).
+    Runtime::Current()->GetClassLinker()->VisitKnownDexFiles(
+        soa.Self(),
+        [&](const DexFile* dex_file) {
+          DumpResidentPageRanges(
+              dex_file->GetLocation() + " (dex)", dex_file->Begin(), dex_file->Size(), os);
+        });
+  }
+  ReaderMutexLock mu(Thread::Current(), *Locks::oat_file_manager_lock_);
+  for (const std::unique_ptr<const OatFile>& oat_file : oat_files_) {
+    DumpResidentPageRanges(
+        oat_file->GetLocation(), oat_file->Begin(), oat_file->End() - oat_file->Begin(), os);
+    const VdexFile* vdex_file = oat_file->GetVdexFile();
+    if (vdex_file != nullptr) {
+      DumpResidentPageRanges(
+          oat_file->GetLocation() + " (vdex)", vdex_file->Begin(), vdex_file->Size(), os);
+    }
+  }
+}
+
 void OatFileManager::DumpForSigQuit(std::ostream& os) {
   ReaderMutexLock mu(Thread::Current(), *Locks::oat_file_manager_lock_);
   std::vector<const OatFile*> boot_oat_files = GetBootOatFiles();
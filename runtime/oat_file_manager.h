@@ -120,6 +120,13 @@ class OatFileManager {
 
   void DumpForSigQuit(std::ostream& os);
 
+  // Write an ordered page-residency profile of the image space and oat file
+  // mappings to `os`. Sampled when startup completes, the resident page ranges
+  // approximate the pages touched during startup and can be fed back into
+  // dexlayout and the image writer to improve file layout.
+  void DumpPageAccessProfile(std::ostream& os)
+      REQUIRES(!Locks::oat_file_manager_lock_);
+
   void SetOnlyUseSystemOatFiles();
 
   // Spawn a background thread which verifies all classes in the given dex files.
@@ -197,6 +197,14 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
           .WithType<bool>()
           .WithValueMap({{"false", false}, {"true", true}})
           .IntoKey(M::MadviseRandomAccess)
+      .Define("-XX:MadviseWillNeedImageSpaces:_")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .IntoKey(M::MadviseWillNeedImageSpaces)
+      .Define("-XX:PreloadStartupClasses:_")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .IntoKey(M::PreloadStartupClasses)
       .Define("-Xusejit:_")
           .WithType<bool>()
           .WithValueMap({{"false", false}, {"true", true}})
@@ -205,6 +213,10 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
           .WithType<bool>()
           .WithValueMap({{"false", false}, {"true", true}})
           .IntoKey(M::UseTieredJitCompilation)
+      .Define("-Xuseprofiledjit:_")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .IntoKey(M::UseProfiledJitCompilation)
       .Define("-Xjitinitialsize:_")
           .WithType<MemoryKiB>()
           .IntoKey(M::JITCodeCacheInitialCapacity)
@@ -289,8 +301,19 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-Xmethod-trace-file-size:_")
           .WithType<unsigned int>()
           .IntoKey(M::MethodTraceFileSize)
+      .Define("-Xverificationcachefile:_")
+          .WithType<std::string>()
+          .IntoKey(M::VerificationCacheFile)
       .Define("-Xmethod-trace-stream")
           .IntoKey(M::MethodTraceStreaming)
+      .Define("-Xstack-sampling")
+          .IntoKey(M::StackSampling)
+      .Define("-Xstack-sampling-file:_")
+          .WithType<std::string>()
+          .IntoKey(M::StackSamplingFile)
+      .Define("-Xstack-sampling-interval-us:_")
+          .WithType<unsigned int>()
+          .IntoKey(M::StackSamplingIntervalUs)
       .Define("-Xprofile:_")
           .WithType<TraceClockSource>()
           .WithValueMap({{"threadcpuclock", TraceClockSource::kThreadCpu},
@@ -346,6 +369,9 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-XX:GlobalRefAllocStackTraceLimit=_")  // Number of free slots to enable tracing.
           .WithType<unsigned int>()
           .IntoKey(M::GlobalRefAllocStackTraceLimit)
+      .Define("-XX:AllocTrackerSampleInterval=_")  // Average bytes between sampled allocations.
+          .WithType<unsigned int>()
+          .IntoKey(M::AllocTrackerSampleInterval)
       .Define("-XX:SlowDebug=_")
           .WithType<bool>()
           .WithValueMap({{"false", false}, {"true", true}})
@@ -776,10 +802,16 @@ void ParsedOptions::Usage(const char* fmt, ...) {
   UsageMessage(stream, "  -XX:StopForNativeAllocs=N\n");
   UsageMessage(stream, "  -XX:DumpNativeStackOnSigQuit=booleanvalue\n");
   UsageMessage(stream, "  -XX:MadviseRandomAccess:booleanvalue\n");
+  UsageMessage(stream, "  -XX:MadviseWillNeedImageSpaces:booleanvalue\n");
+  UsageMessage(stream, "  -XX:PreloadStartupClasses:booleanvalue\n");
   UsageMessage(stream, "  -XX:SlowDebug={false,true}\n");
   UsageMessage(stream, "  -Xmethod-trace\n");
   UsageMessage(stream, "  -Xmethod-trace-file:filename\n");
+  UsageMessage(stream, "  -Xverificationcachefile:filename\n");
   UsageMessage(stream, "  -Xmethod-trace-file-size:integervalue\n");
+  UsageMessage(stream, "  -Xstack-sampling\n");
+  UsageMessage(stream, "  -Xstack-sampling-file:filename\n");
+  UsageMessage(stream, "  -Xstack-sampling-interval-us:integervalue\n");
   UsageMessage(stream, "  -Xps-min-save-period-ms:integervalue\n");
   UsageMessage(stream, "  -Xps-save-resolved-classes-delay-ms:integervalue\n");
   UsageMessage(stream, "  -Xps-hot-startup-method-samples:integervalue\n");
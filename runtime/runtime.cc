@@ -157,6 +157,7 @@
 #include "runtime_common.h"
 #include "runtime_intrinsics.h"
 #include "runtime_options.h"
+#include "sampling_profiler.h"
 #include "scoped_thread_state_change-inl.h"
 #include "sigchain.h"
 #include "signal_catcher.h"
@@ -168,6 +169,7 @@
 #include "transaction.h"
 #include "vdex_file.h"
 #include "verifier/class_verifier.h"
+#include "verifier/verification_cache.h"
 #include "well_known_classes.h"
 
 #ifdef ART_TARGET_ANDROID
@@ -261,6 +263,7 @@ Runtime::Runtime()
       abort_(nullptr),
       stats_enabled_(false),
       is_running_on_memory_tool_(kRunningOnMemoryTool),
+      stack_sampling_interval_us_(0u),
       instrumentation_(),
       main_thread_group_(nullptr),
       system_thread_group_(nullptr),
@@ -413,6 +416,9 @@ Runtime::~Runtime() {
   // Shutdown any trace running.
   Trace::Shutdown();
 
+  // Stop stack sampling and dump the collected samples.
+  SamplingProfiler::Shutdown();
+
   // Report death. Clients may require a working thread, still, so do it before GC completes and
   // all non-daemon threads are done.
   {
@@ -434,6 +440,12 @@ Runtime::~Runtime() {
   DeleteThreadPool();
   CHECK(thread_pool_ == nullptr);
 
+  // Persist verification results gathered during this run. Classes verified by daemon threads
+  // after this point are simply not recorded.
+  if (verification_cache_ != nullptr) {
+    verification_cache_->Save();
+  }
+
   // Make sure our internal threads are dead before we start tearing down things they're using.
   GetRuntimeCallbacks()->StopDebugger();
   // Deletion ordering is tricky. Null out everything we've deleted.
@@ -681,6 +693,10 @@ void Runtime::PreZygoteFork() {
   if (GetJit() != nullptr) {
     GetJit()->PreZygoteFork();
   }
+  // Make sure the well-known classes are initialized before the first fork so
+  // that children inherit the initialized state instead of each running the
+  // remaining class initializers on first use. Cheap once initialization is done.
+  WellKnownClasses::EnsureClassesInitialized(Thread::Current());
   heap_->PreZygoteFork();
   PreZygoteForkNativeBridge();
 }
@@ -976,6 +992,10 @@ bool Runtime::Start() {
                  0);
   }
 
+  if (!stack_sampling_file_.empty() && stack_sampling_interval_us_ != 0u) {
+    SamplingProfiler::Start(stack_sampling_file_, stack_sampling_interval_us_);
+  }
+
   // In case we have a profile path passed as a command line argument,
   // register the current class path for profiling now. Note that we cannot do
   // this before we create the JIT and having it here is the most convenient way.
@@ -1317,6 +1337,12 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
   verify_ = runtime_options.GetOrDefault(Opt::Verify);
   allow_dex_file_fallback_ = !runtime_options.Exists(Opt::NoDexFileFallback);
 
+  if (runtime_options.Exists(Opt::VerificationCacheFile) && !IsAotCompiler()) {
+    verification_cache_.reset(new verifier::VerificationCache(
+        runtime_options.GetOrDefault(Opt::VerificationCacheFile)));
+    verification_cache_->Load();
+  }
+
   target_sdk_version_ = runtime_options.GetOrDefault(Opt::TargetSdkVersion);
 
   // Set hidden API enforcement policy. The checks are disabled by default and
@@ -1350,6 +1376,8 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
   experimental_flags_ = runtime_options.GetOrDefault(Opt::Experimental);
   is_low_memory_mode_ = runtime_options.Exists(Opt::LowMemoryMode);
   madvise_random_access_ = runtime_options.GetOrDefault(Opt::MadviseRandomAccess);
+  madvise_willneed_image_spaces_ = runtime_options.GetOrDefault(Opt::MadviseWillNeedImageSpaces);
+  preload_startup_classes_ = runtime_options.GetOrDefault(Opt::PreloadStartupClasses);
 
   jni_ids_indirection_ = runtime_options.GetOrDefault(Opt::OpaqueJniIds);
   automatically_set_jni_ids_indirection_ =
@@ -1378,6 +1406,75 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
 
   image_space_loading_order_ = runtime_options.GetOrDefault(Opt::ImageSpaceLoadingOrder);
 
+  // Several of the remaining init stages depend only on the option values parsed above,
+  // not on the heap or on each other: JDWP and JIT option handling, the arena pools and
+  // the JavaVMExt. Run them on a side thread, overlapped with the heap creation (which
+  // maps and relocates the boot image and dominates Runtime::Init), and join before the
+  // first stage that needs both. The side thread must not use Thread::Current(); the
+  // thread machinery is only set up by Thread::Startup() below. Both lanes only perform
+  // const lookups on `runtime_options`.
+  std::string java_vm_error_msg;
+  std::thread vm_init_thread([&]() {
+    jdwp_options_ = runtime_options.GetOrDefault(Opt::JdwpOptions);
+    jdwp_provider_ = CanonicalizeJdwpProvider(runtime_options.GetOrDefault(Opt::JdwpProvider),
+                                              IsJavaDebuggable());
+    switch (jdwp_provider_) {
+      case JdwpProvider::kNone: {
+        VLOG(jdwp) << "Disabling all JDWP support.";
+        if (!jdwp_options_.empty()) {
+          bool has_transport = jdwp_options_.find("transport") != std::string::npos;
+          std::string adb_connection_args =
+              std::string("  -XjdwpProvider:adbconnection -XjdwpOptions:") + jdwp_options_;
+          LOG(WARNING) << "Jdwp options given when jdwp is disabled! You probably want to enable "
+                       << "jdwp with one of:" << std::endl
+                       << "  -Xplugin:libopenjdkjvmti" << (kIsDebugBuild ? "d" : "") << ".so "
+                       << "-agentpath:libjdwp.so=" << jdwp_options_ << std::endl
+                       << (has_transport ? "" : adb_connection_args);
+        }
+        break;
+      }
+      case JdwpProvider::kAdbConnection: {
+        constexpr const char* plugin_name = kIsDebugBuild ? "libadbconnectiond.so"
+                                                          : "libadbconnection.so";
+        plugins_.push_back(Plugin::Create(plugin_name));
+        break;
+      }
+      case JdwpProvider::kUnset: {
+        LOG(FATAL) << "Illegal jdwp provider " << jdwp_provider_ << " was not filtered out!";
+      }
+    }
+    callbacks_->AddThreadLifecycleCallback(Dbg::GetThreadLifecycleCallback());
+
+    jit_options_.reset(jit::JitOptions::CreateFromRuntimeArguments(runtime_options));
+    if (IsAotCompiler()) {
+      // If we are already the compiler at this point, we must be dex2oat. Don't create the jit in
+      // this case.
+      // If runtime_options doesn't have UseJIT set to true then CreateFromRuntimeArguments returns
+      // null and we don't create the jit.
+      jit_options_->SetUseJitCompilation(false);
+      jit_options_->SetSaveProfilingInfo(false);
+    }
+
+    // Use MemMap arena pool for jit, malloc otherwise. Malloc arenas are faster to allocate but
+    // can't be trimmed as easily.
+    const bool use_malloc = IsAotCompiler();
+    if (use_malloc) {
+      arena_pool_.reset(new MallocArenaPool());
+      jit_arena_pool_.reset(new MallocArenaPool());
+    } else {
+      arena_pool_.reset(new MemMapArenaPool(/* low_4gb= */ false));
+      jit_arena_pool_.reset(new MemMapArenaPool(/* low_4gb= */ false, "CompilerMetadata"));
+    }
+
+    if (IsAotCompiler() && Is64BitInstructionSet(kRuntimeISA)) {
+      // 4gb, no malloc. Explanation in header.
+      low_4gb_arena_pool_.reset(new MemMapArenaPool(/* low_4gb= */ true));
+    }
+    linear_alloc_.reset(CreateLinearAlloc());
+
+    java_vm_ = JavaVMExt::Create(this, runtime_options, &java_vm_error_msg);
+  });
+
   heap_ = new gc::Heap(runtime_options.GetOrDefault(Opt::MemoryInitialSize),
                        runtime_options.GetOrDefault(Opt::HeapGrowthLimit),
                        runtime_options.GetOrDefault(Opt::HeapMinFree),
@@ -1419,6 +1516,11 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
                        runtime_options.Exists(Opt::DumpRegionInfoAfterGC),
                        image_space_loading_order_);
 
+  heap_->SetAllocTrackerSampleInterval(
+      runtime_options.GetOrDefault(Opt::AllocTrackerSampleInterval));
+
+  vm_init_thread.join();
+
   if (!heap_->HasBootImageSpace() && !allow_dex_file_fallback_) {
     LOG(ERROR) << "Dex file fallback disabled, cannot continue without image.";
     return false;
@@ -1426,72 +1528,21 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
 
   dump_gc_performance_on_shutdown_ = runtime_options.Exists(Opt::DumpGCPerformanceOnShutdown);
 
-  jdwp_options_ = runtime_options.GetOrDefault(Opt::JdwpOptions);
-  jdwp_provider_ = CanonicalizeJdwpProvider(runtime_options.GetOrDefault(Opt::JdwpProvider),
-                                            IsJavaDebuggable());
-  switch (jdwp_provider_) {
-    case JdwpProvider::kNone: {
-      VLOG(jdwp) << "Disabling all JDWP support.";
-      if (!jdwp_options_.empty()) {
-        bool has_transport = jdwp_options_.find("transport") != std::string::npos;
-        std::string adb_connection_args =
-            std::string("  -XjdwpProvider:adbconnection -XjdwpOptions:") + jdwp_options_;
-        LOG(WARNING) << "Jdwp options given when jdwp is disabled! You probably want to enable "
-                     << "jdwp with one of:" << std::endl
-                     << "  -Xplugin:libopenjdkjvmti" << (kIsDebugBuild ? "d" : "") << ".so "
-                     << "-agentpath:libjdwp.so=" << jdwp_options_ << std::endl
-                     << (has_transport ? "" : adb_connection_args);
-      }
-      break;
-    }
-    case JdwpProvider::kAdbConnection: {
-      constexpr const char* plugin_name = kIsDebugBuild ? "libadbconnectiond.so"
-                                                        : "libadbconnection.so";
-      plugins_.push_back(Plugin::Create(plugin_name));
-      break;
-    }
-    case JdwpProvider::kUnset: {
-      LOG(FATAL) << "Illegal jdwp provider " << jdwp_provider_ << " was not filtered out!";
-    }
-  }
-  callbacks_->AddThreadLifecycleCallback(Dbg::GetThreadLifecycleCallback());
-
-  jit_options_.reset(jit::JitOptions::CreateFromRuntimeArguments(runtime_options));
-  if (IsAotCompiler()) {
-    // If we are already the compiler at this point, we must be dex2oat. Don't create the jit in
-    // this case.
-    // If runtime_options doesn't have UseJIT set to true then CreateFromRuntimeArguments returns
-    // null and we don't create the jit.
-    jit_options_->SetUseJitCompilation(false);
-    jit_options_->SetSaveProfilingInfo(false);
-  }
-
-  // Use MemMap arena pool for jit, malloc otherwise. Malloc arenas are faster to allocate but
-  // can't be trimmed as easily.
-  const bool use_malloc = IsAotCompiler();
-  if (use_malloc) {
-    arena_pool_.reset(new MallocArenaPool());
-    jit_arena_pool_.reset(new MallocArenaPool());
-  } else {
-    arena_pool_.reset(new MemMapArenaPool(/* low_4gb= */ false));
-    jit_arena_pool_.reset(new MemMapArenaPool(/* low_4gb= */ false, "CompilerMetadata"));
-  }
-
-  if (IsAotCompiler() && Is64BitInstructionSet(kRuntimeISA)) {
-    // 4gb, no malloc. Explanation in header.
-    low_4gb_arena_pool_.reset(new MemMapArenaPool(/* low_4gb= */ true));
-  }
-  linear_alloc_.reset(CreateLinearAlloc());
-
   BlockSignals();
   InitPlatformSignalHandlers();
 
   // Change the implicit checks flags based on runtime architecture.
   switch (kRuntimeISA) {
+    case InstructionSet::kArm64:
+      // Suspend checks are implicit only on arm64: the code generator and the
+      // fault handler only support the trigger load pattern there.
+      implicit_suspend_checks_ = true;
+      implicit_null_checks_ = true;
+      implicit_so_checks_ = true;
+      break;
     case InstructionSet::kArm:
     case InstructionSet::kThumb2:
     case InstructionSet::kX86:
-    case InstructionSet::kArm64:
     case InstructionSet::kX86_64:
       implicit_null_checks_ = true;
       // Historical note: Installing stack protection was not playing well with Valgrind.
@@ -1533,9 +1584,8 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
   verifier_logging_threshold_ms_ = runtime_options.GetOrDefault(Opt::VerifierLoggingThreshold);
 
   std::string error_msg;
-  java_vm_ = JavaVMExt::Create(this, runtime_options, &error_msg);
   if (java_vm_.get() == nullptr) {
-    LOG(ERROR) << "Could not initialize JavaVMExt: " << error_msg;
+    LOG(ERROR) << "Could not initialize JavaVMExt: " << java_vm_error_msg;
     return false;
   }
 
@@ -1646,6 +1696,11 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
         Trace::TraceOutputMode::kFile;
   }
 
+  if (runtime_options.Exists(Opt::StackSampling)) {
+    stack_sampling_file_ = runtime_options.ReleaseOrDefault(Opt::StackSamplingFile);
+    stack_sampling_interval_us_ = runtime_options.GetOrDefault(Opt::StackSamplingIntervalUs);
+  }
+
   // TODO: move this to just be an Trace::Start argument
   Trace::SetDefaultClockSource(runtime_options.GetOrDefault(Opt::ProfileClock));
 
@@ -2023,6 +2078,8 @@ void Runtime::DumpForSigQuit(std::ostream& os) {
   }
   DumpDeoptimizations(os);
   TrackedAllocators::Dump(os);
+  Monitor::DumpContentionCounts(os);
+  DumpLockContention(os);
   os << "\n";
 
   thread_list_->DumpForSigQuit(os);
@@ -2035,6 +2092,10 @@ void Runtime::DumpForSigQuit(std::ostream& os) {
   }
 }
 
+void Runtime::DumpLockContention(std::ostream& os) {
+  BaseMutex::DumpAllContentionStats(os);
+}
+
 void Runtime::DumpLockHolders(std::ostream& os) {
   uint64_t mutator_lock_owner = Locks::mutator_lock_->GetExclusiveOwnerTid();
   pid_t thread_list_lock_owner = GetThreadList()->GetLockOwner();
@@ -2430,6 +2491,12 @@ void Runtime::RegisterAppInfo(const std::vector<std::string>& code_paths,
   }
 
   jit_->StartProfileSaver(profile_output_filename, code_paths);
+
+  if (ShouldPreloadStartupClasses()) {
+    // Resolve the startup classes recorded in previous runs while the app is still
+    // starting up, so that its own class lookups hit already-resolved entries.
+    GetClassLinker()->PreloadStartupClassesAsync(profile_output_filename);
+  }
 }
 
 // Transaction support.
@@ -2991,6 +3058,23 @@ class Runtime::NotifyStartupCompletedTask : public gc::HeapTask {
       }
     }
 
+    {
+      // Class loading has settled down; eagerly assign type check bitstrings to the loaded
+      // hierarchy so that code JITted from here on uses the fast checkcast/instanceof path
+      // for app classes as well.
+      ScopedTrace trace2("Assigning type check bitstrings");
+      ScopedObjectAccess soa(self);
+      runtime->GetClassLinker()->AssignTypeCheckBitstrings(self);
+    }
+
+    if (VLOG_IS_ON(startup)) {
+      // Emit a one-shot page-access profile of the image and oat file mappings.
+      // Pages resident at this point approximate the set touched during startup
+      // and the ordered ranges can be fed back into layout tools.
+      ScopedTrace trace2("Dumping page access profile");
+      runtime->GetOatFileManager().DumpPageAccessProfile(LOG_STREAM(INFO));
+    }
+
     {
       // Delete the thread pool used for app image loading since startup is assumed to be completed.
       ScopedTrace trace2("Delete thread pool");
@@ -80,6 +80,7 @@ class AgentSpec;
 }  // namespace ti
 namespace verifier {
 class MethodVerifier;
+class VerificationCache;
 enum class VerifyMode : int8_t;
 }  // namespace verifier
 class ArenaPool;
@@ -270,6 +271,9 @@ class Runtime {
 
   void DumpDeoptimizations(std::ostream& os);
   void DumpForSigQuit(std::ostream& os);
+  // Dump the always-on per-mutex contention statistics (futex-wait counts and sampled wait-time
+  // histograms); available in production builds, unlike the kLogLockContentions log.
+  void DumpLockContention(std::ostream& os);
   void DumpLockHolders(std::ostream& os);
 
   ~Runtime();
@@ -584,6 +588,12 @@ class Runtime {
   bool IsVerificationEnabled() const;
   bool IsVerificationSoftFail() const;
 
+  // Returns the persistent verification cache, or null if none was configured
+  // (-Xverificationcachefile:).
+  verifier::VerificationCache* GetVerificationCache() const {
+    return verification_cache_.get();
+  }
+
   void SetHiddenApiEnforcementPolicy(hiddenapi::EnforcementPolicy policy) {
     hidden_api_policy_ = policy;
   }
@@ -903,6 +913,19 @@ class Runtime {
     return madvise_random_access_;
   }
 
+  // Whether or not we use MADV_WILLNEED on image spaces before the relocation passes walk
+  // their pages. Disabling this avoids the read-ahead I/O burst on deployments where the
+  // page cache is under pressure during startup.
+  bool MadviseWillNeedImageSpaces() const {
+    return madvise_willneed_image_spaces_;
+  }
+
+  // Whether or not startup classes recorded in the app's profile are resolved on a
+  // background thread when the profile is registered.
+  bool ShouldPreloadStartupClasses() const {
+    return preload_startup_classes_;
+  }
+
   const std::string& GetJdwpOptions() {
     return jdwp_options_;
   }
@@ -1152,6 +1175,10 @@ class Runtime {
 
   std::unique_ptr<TraceConfig> trace_config_;
 
+  // Stack sampling profiler configuration; an empty file name means sampling is disabled.
+  std::string stack_sampling_file_;
+  uint32_t stack_sampling_interval_us_;
+
   instrumentation::Instrumentation instrumentation_;
 
   jobject main_thread_group_;
@@ -1172,6 +1199,9 @@ class Runtime {
   // If kNone, verification is disabled. kEnable by default.
   verifier::VerifyMode verify_;
 
+  // Persistent cross-run verification cache, null unless configured.
+  std::unique_ptr<verifier::VerificationCache> verification_cache_;
+
   // If true, the runtime may use dex files directly with the interpreter if an oat file is not
   // available/usable.
   bool allow_dex_file_fallback_;
@@ -1249,6 +1279,12 @@ class Runtime {
   // This is beneficial for low RAM devices since it reduces page cache thrashing.
   bool madvise_random_access_;
 
+  // Whether or not we use MADV_WILLNEED on image spaces before relocating them.
+  bool madvise_willneed_image_spaces_;
+
+  // Whether startup classes from the app's profile are preloaded in the background.
+  bool preload_startup_classes_;
+
   // Whether the application should run in safe mode, that is, interpreter only.
   bool safe_mode_;
 
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sampling_profiler.h"
+
+#include <unistd.h>
+
+#include <unordered_set>
+
+#include "art_method-inl.h"
+#include "base/os.h"
+#include "base/systrace.h"
+#include "base/time_utils.h"
+#include "base/unix_file/fd_file.h"
+#include "gc/scoped_gc_critical_section.h"
+#include "runtime.h"
+#include "scoped_thread_state_change-inl.h"
+#include "stack.h"
+#include "thread-inl.h"
+#include "thread_list.h"
+
+namespace art {
+
+SamplingProfiler* SamplingProfiler::the_profiler_ = nullptr;
+pthread_t SamplingProfiler::sampling_pthread_ = 0U;
+
+static void AppendLE(std::string* buf, uint64_t val, size_t num_bytes) {
+  for (size_t i = 0; i != num_bytes; ++i) {
+    buf->push_back(static_cast<char>(val >> (i * 8)));
+  }
+}
+
+static void GetSample(Thread* thread, void* arg) REQUIRES_SHARED(Locks::mutator_lock_) {
+  reinterpret_cast<SamplingProfiler*>(arg)->RecordSample(thread);
+}
+
+SamplingProfiler::SamplingProfiler(const std::string& output_filename, uint32_t interval_us)
+    : output_filename_(output_filename),
+      interval_us_(interval_us),
+      buffer_(kBufferCapacity),
+      cursor_(0u) {}
+
+void SamplingProfiler::Start(const std::string& output_filename, uint32_t interval_us) {
+  CHECK_NE(interval_us, 0u);
+  Thread* self = Thread::Current();
+  MutexLock mu(self, *Locks::trace_lock_);
+  if (the_profiler_ != nullptr) {
+    LOG(ERROR) << "Stack sampling already in progress, ignoring this request";
+    return;
+  }
+  the_profiler_ = new SamplingProfiler(output_filename, interval_us);
+  CHECK_PTHREAD_CALL(pthread_create, (&sampling_pthread_, nullptr, &RunSamplingThread, nullptr),
+                     "Stack sampler thread");
+}
+
+bool SamplingProfiler::IsRunning() {
+  MutexLock mu(Thread::Current(), *Locks::trace_lock_);
+  return the_profiler_ != nullptr;
+}
+
+void SamplingProfiler::Shutdown() {
+  Thread* self = Thread::Current();
+  SamplingProfiler* the_profiler;
+  pthread_t sampling_pthread;
+  {
+    MutexLock mu(self, *Locks::trace_lock_);
+    the_profiler = the_profiler_;
+    // Clearing the instance makes the sampling thread exit its loop.
+    the_profiler_ = nullptr;
+    sampling_pthread = sampling_pthread_;
+    sampling_pthread_ = 0U;
+  }
+  if (the_profiler == nullptr) {
+    return;
+  }
+  CHECK_PTHREAD_CALL(pthread_join, (sampling_pthread, nullptr), "Stack sampler shutdown");
+  the_profiler->DumpToFile();
+  delete the_profiler;
+}
+
+void* SamplingProfiler::RunSamplingThread(void* arg ATTRIBUTE_UNUSED) {
+  Runtime* runtime = Runtime::Current();
+  CHECK(runtime->AttachCurrentThread("Stack Sampler", true, runtime->GetSystemThreadGroup(),
+                                     !runtime->IsAotCompiler()));
+
+  while (true) {
+    Thread* self = Thread::Current();
+    SamplingProfiler* the_profiler;
+    uint32_t interval_us;
+    {
+      MutexLock mu(self, *Locks::trace_lock_);
+      the_profiler = the_profiler_;
+      if (the_profiler == nullptr) {
+        break;
+      }
+      interval_us = the_profiler->interval_us_;
+    }
+    usleep(interval_us);
+    ScopedTrace trace("Stack sampling");
+    {
+      // Like Trace's sampling thread, block GC while walking thread stacks to avoid deadlocking
+      // with a thread that is suspended mid-collection (see b/73624630).
+      gc::ScopedGCCriticalSection gcs(self,
+                                      gc::kGcCauseInstrumentation,
+                                      gc::kCollectorTypeInstrumentation);
+      ScopedSuspendAll ssa(__FUNCTION__);
+      MutexLock mu(self, *Locks::thread_list_lock_);
+      runtime->GetThreadList()->ForEach(GetSample, the_profiler);
+    }
+  }
+
+  runtime->DetachCurrentThread();
+  return nullptr;
+}
+
+void SamplingProfiler::RecordSample(Thread* thread) {
+  uint64_t cursor = cursor_.load(std::memory_order_relaxed);
+  Sample* sample = &buffer_[cursor % kBufferCapacity];
+  sample->timestamp_ns = NanoTime();
+  sample->tid = thread->GetTid();
+  size_t num_frames = 0;
+  StackVisitor::WalkStack(
+      [&](const StackVisitor* stack_visitor) REQUIRES_SHARED(Locks::mutator_lock_) {
+        if (num_frames == kMaxFramesPerSample) {
+          return false;
+        }
+        ArtMethod* m = stack_visitor->GetMethod();
+        // Ignore runtime frames (in particular callee save).
+        if (m != nullptr && !m->IsRuntimeMethod()) {
+          sample->frames[num_frames++] = m;
+        }
+        return true;
+      },
+      thread,
+      /* context= */ nullptr,
+      StackVisitor::StackWalkKind::kIncludeInlinedFrames);
+  sample->num_frames = static_cast<uint16_t>(num_frames);
+  // Publish the sample; a concurrent dump only reads slots below the cursor.
+  cursor_.store(cursor + 1, std::memory_order_release);
+}
+
+bool SamplingProfiler::DumpToFile() {
+  std::unique_ptr<File> file(OS::CreateEmptyFileWriteOnly(output_filename_.c_str()));
+  if (file == nullptr) {
+    PLOG(ERROR) << "Unable to open stack sample file '" << output_filename_ << "'";
+    return false;
+  }
+  uint64_t recorded = cursor_.load(std::memory_order_acquire);
+  uint64_t num_samples = std::min<uint64_t>(recorded, kBufferCapacity);
+  std::string data;
+  AppendLE(&data, kMagic, 4);
+  AppendLE(&data, kVersion, 2);
+  AppendLE(&data, kMaxFramesPerSample, 2);
+  AppendLE(&data, interval_us_, 4);
+  AppendLE(&data, num_samples, 4);
+  std::unordered_set<ArtMethod*> methods;
+  for (uint64_t i = recorded - num_samples; i != recorded; ++i) {
+    const Sample& sample = buffer_[i % kBufferCapacity];
+    AppendLE(&data, sample.timestamp_ns, 8);
+    AppendLE(&data, sample.tid, 4);
+    AppendLE(&data, sample.num_frames, 2);
+    for (size_t frame = 0; frame != sample.num_frames; ++frame) {
+      AppendLE(&data, reinterpret_cast<uintptr_t>(sample.frames[frame]), 8);
+      methods.insert(sample.frames[frame]);
+    }
+  }
+  // Resolve method names last so a consumer can stream the samples without buffering them.
+  AppendLE(&data, methods.size(), 4);
+  {
+    ScopedObjectAccess soa(Thread::Current());
+    for (ArtMethod* method : methods) {
+      std::string name = ArtMethod::PrettyMethod(method);
+      size_t length = std::min<size_t>(name.length(), 0xffffu);
+      AppendLE(&data, reinterpret_cast<uintptr_t>(method), 8);
+      AppendLE(&data, length, 2);
+      data.append(name.c_str(), length);
+    }
+  }
+  if (!file->WriteFully(data.c_str(), data.length())) {
+    PLOG(ERROR) << "Failed to write stack sample file '" << output_filename_ << "'";
+    file->Erase();
+    return false;
+  }
+  if (file->FlushCloseOrErase() != 0) {
+    PLOG(ERROR) << "Failed to flush stack sample file '" << output_filename_ << "'";
+    return false;
+  }
+  VLOG(profiler) << "Wrote " << num_samples << " stack samples (" << methods.size()
+                 << " methods) to '" << output_filename_ << "'";
+  return true;
+}
+
+}  // namespace art
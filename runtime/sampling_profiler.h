@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_SAMPLING_PROFILER_H_
+#define ART_RUNTIME_SAMPLING_PROFILER_H_
+
+#include <pthread.h>
+
+#include <string>
+#include <vector>
+
+#include "base/atomic.h"
+#include "base/locks.h"
+#include "base/macros.h"
+
+namespace art {
+
+class ArtMethod;
+class Thread;
+
+// Always-on, low-overhead stack sampler. Unlike the sampling mode of Trace, which synthesizes
+// method entry/exit events in the heavyweight method-trace format, this records raw stack
+// samples into a fixed-size ring buffer and dumps them at shutdown in a compact binary format.
+//
+// The sampling thread is the only writer of the ring buffer and publishes each sample with a
+// release store of the cursor, so the dump can read completed samples without taking a lock.
+// Once the buffer wraps, the oldest samples are overwritten; an always-on profile of the most
+// recent activity is usually what is wanted from the field.
+//
+// Dump format (all values little-endian):
+//   u32 magic, u16 version, u16 max frames per sample, u32 interval_us, u32 sample count,
+//   then for each sample: u64 timestamp_ns, u32 tid, u16 frame count, u64 method id per frame,
+//   then u32 method count, and for each method: u64 method id, u16 length, name bytes.
+class SamplingProfiler {
+ public:
+  static constexpr uint32_t kMagic = 0x30505341;  // 'ASP0' in little-endian.
+  static constexpr uint16_t kVersion = 1;
+  // Samples deeper than this are truncated to their innermost frames.
+  static constexpr size_t kMaxFramesPerSample = 32;
+  // Number of samples retained before the ring buffer wraps.
+  static constexpr size_t kBufferCapacity = 64 * 1024;
+
+  // A single stack sample. Methods are recorded innermost-first.
+  struct Sample {
+    uint64_t timestamp_ns;
+    uint32_t tid;
+    uint16_t num_frames;
+    ArtMethod* frames[kMaxFramesPerSample];
+  };
+
+  // Starts the sampling thread. Samples are written to output_filename by Shutdown().
+  static void Start(const std::string& output_filename, uint32_t interval_us)
+      REQUIRES(!Locks::trace_lock_);
+
+  // Stops the sampling thread, dumps the collected samples and deletes the profiler. No-op if
+  // the profiler was never started.
+  static void Shutdown()
+      REQUIRES(!Locks::mutator_lock_, !Locks::thread_list_lock_, !Locks::trace_lock_);
+
+  static bool IsRunning() REQUIRES(!Locks::trace_lock_);
+
+  // Records a stack sample for the given suspended thread. Called by the sampling thread only.
+  void RecordSample(Thread* thread) REQUIRES_SHARED(Locks::mutator_lock_);
+
+ private:
+  SamplingProfiler(const std::string& output_filename, uint32_t interval_us);
+
+  static void* RunSamplingThread(void* arg) REQUIRES(!Locks::trace_lock_);
+
+  bool DumpToFile() REQUIRES(!Locks::mutator_lock_);
+
+  const std::string output_filename_;
+  const uint32_t interval_us_;
+
+  // Fixed-size ring buffer of samples. The slot for sample i is i % kBufferCapacity.
+  std::vector<Sample> buffer_;
+  // Total number of samples ever recorded; incremented with a release store after the sample
+  // data has been written.
+  Atomic<uint64_t> cursor_;
+
+  // The singleton profiler, guarded like Trace's instance by the global trace lock.
+  static SamplingProfiler* the_profiler_ GUARDED_BY(Locks::trace_lock_);
+  static pthread_t sampling_pthread_;
+
+  DISALLOW_COPY_AND_ASSIGN(SamplingProfiler);
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_SAMPLING_PROFILER_H_
@@ -1006,4 +1006,68 @@ void StackVisitor::WalkStack(bool include_transitions) {
 template void StackVisitor::WalkStack<StackVisitor::CountTransitions::kYes>(bool);
 template void StackVisitor::WalkStack<StackVisitor::CountTransitions::kNo>(bool);
 
+size_t AsyncStackTrace::Capture(Thread* thread, AsyncStackFrame* frames, size_t max_frames) {
+  size_t count = 0;
+  StackVisitor::WalkStack(
+      [&](const StackVisitor* visitor) REQUIRES_SHARED(Locks::mutator_lock_) {
+        if (count == max_frames) {
+          return false;
+        }
+        ArtMethod* m = visitor->GetMethod();
+        if (m == nullptr || m->IsRuntimeMethod()) {
+          return true;
+        }
+        AsyncStackFrame& frame = frames[count++];
+        frame.method = m;
+        frame.method_header = visitor->GetCurrentOatQuickMethodHeader();
+        frame.native_pc = visitor->GetCurrentQuickFramePc();
+        if (visitor->GetCurrentShadowFrame() != nullptr) {
+          // Shadow frames know their dex pc for free and have no compiled code to map back from.
+          frame.method_header = nullptr;
+          frame.dex_pc = visitor->GetCurrentShadowFrame()->GetDexPC();
+        } else if (visitor->IsInInlinedFrame()) {
+          // The walk has already decoded the inline info of this frame, so reading the dex pc
+          // here is cheap; it cannot be recovered from the native pc alone later.
+          frame.dex_pc = visitor->GetDexPc(/* abort_on_failure= */ false);
+        } else {
+          frame.dex_pc = dex::kDexNoIndex;
+        }
+        return true;
+      },
+      thread,
+      /* context= */ nullptr,
+      StackVisitor::StackWalkKind::kIncludeInlinedFrames);
+  return count;
+}
+
+std::string AsyncStackTrace::Symbolize(const AsyncStackFrame& frame) {
+  ArtMethod* m = frame.method;
+  uint32_t dex_pc = frame.dex_pc;
+  const OatQuickMethodHeader* header = frame.method_header;
+  if (dex_pc == dex::kDexNoIndex &&
+      header != nullptr &&
+      header->IsOptimized() &&
+      !m->IsNative()) {
+    // Map the captured native pc back to a dex pc the same way ToDexPc does, without needing the
+    // (long gone) quick frame.
+    uintptr_t sought_offset = frame.native_pc - reinterpret_cast<uintptr_t>(header->GetEntryPoint());
+    CodeInfo code_info = CodeInfo::DecodeInlineInfoOnly(header);
+    StackMap stack_map = code_info.GetStackMapForNativePcOffset(sought_offset);
+    if (stack_map.IsValid()) {
+      dex_pc = stack_map.GetDexPc();
+    }
+  }
+  std::string result = m->PrettyMethod();
+  if (!m->IsNative() && dex_pc != dex::kDexNoIndex) {
+    const char* source_file = m->GetDeclaringClassSourceFile();
+    int32_t line_number = m->GetLineNumFromDexPC(dex_pc);
+    android::base::StringAppendF(&result, "(%s:%d)",
+                                 source_file != nullptr ? source_file : "unavailable",
+                                 line_number);
+  } else if (m->IsNative()) {
+    result += "(Native method)";
+  }
+  return result;
+}
+
 }  // namespace art
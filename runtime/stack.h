@@ -376,6 +376,33 @@ class StackVisitor {
   const bool check_suspended_;
 };
 
+// A raw stack frame captured by AsyncStackTrace::Capture. No symbolization has been done; the
+// method name and line information are resolved on demand by AsyncStackTrace::Symbolize.
+struct AsyncStackFrame {
+  ArtMethod* method;
+  // Null for interpreter (shadow) frames; the dex pc is then recorded directly.
+  const OatQuickMethodHeader* method_header;
+  uintptr_t native_pc;
+  uint32_t dex_pc;
+};
+
+// Captures stack traces without eager symbolization. Capture only records raw
+// (method, OatQuickMethodHeader*, native pc) triples, deferring the stack map decoding and
+// ArtMethod::PrettyMethod work to Symbolize, so a high-frequency caller (e.g. an APM agent)
+// pays the expensive part off the hot path. The captured frames stay valid for as long as the
+// methods' class loaders (and, for JITted frames, their code) are alive.
+class AsyncStackTrace {
+ public:
+  // Fills frames with up to max_frames raw frames of the given suspended thread's stack,
+  // innermost first, and returns the number of frames recorded.
+  static size_t Capture(Thread* thread, AsyncStackFrame* frames, size_t max_frames)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Resolves a captured frame to "method(SourceFile:line)" form, like Thread::DumpStack.
+  static std::string Symbolize(const AsyncStackFrame& frame)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+};
+
 }  // namespace art
 
 #endif  // ART_RUNTIME_STACK_H_
@@ -22,11 +22,29 @@
 #include "art_method.h"
 #include "base/indenter.h"
 #include "base/stats.h"
+#include "jit/jit.h"
+#include "jit/jit_code_cache.h"
 #include "oat_quick_method_header.h"
+#include "runtime.h"
 #include "scoped_thread_state_change-inl.h"
 
 namespace art {
 
+// Small per-thread, direct-mapped cache of decoded CodeInfo headers. Every stack walk
+// decodes the header of every frame it visits, and exception delivery and profiling
+// walk the same frames over and over, so the varint and bit-table decode dominates
+// those walks. Only AOT code is cached: JIT code (and with it the code info data it
+// points to) can be freed and its address reused, which would leave stale decoded
+// tables behind.
+static constexpr size_t kCodeInfoCacheSize = 8;
+
+struct CodeInfoCacheEntry {
+  const uint8_t* data = nullptr;
+  CodeInfo code_info;
+};
+
+static thread_local std::array<CodeInfoCacheEntry, kCodeInfoCacheSize> tl_code_info_cache;
+
 // The callback is used to inform the caller about memory bounds of the bit-tables.
 template<typename DecodeCallback>
 CodeInfo::CodeInfo(const uint8_t* data, size_t* num_read_bits, DecodeCallback callback) {
@@ -58,8 +76,22 @@ CodeInfo::CodeInfo(const uint8_t* data, size_t* num_read_bits, DecodeCallback ca
 CodeInfo::CodeInfo(const uint8_t* data, size_t* num_read_bits)
     : CodeInfo(data, num_read_bits, [](size_t, auto*, BitMemoryRegion){}) {}
 
-CodeInfo::CodeInfo(const OatQuickMethodHeader* header)
-    : CodeInfo(header->GetOptimizedCodeInfoPtr()) {}
+CodeInfo::CodeInfo(const OatQuickMethodHeader* header) {
+  const uint8_t* data = header->GetOptimizedCodeInfoPtr();
+  CodeInfoCacheEntry& entry =
+      tl_code_info_cache[(reinterpret_cast<uintptr_t>(data) >> 4) % kCodeInfoCacheSize];
+  if (entry.data == data) {
+    *this = entry.code_info;
+    return;
+  }
+  *this = CodeInfo(data);
+  Runtime* runtime = Runtime::Current();
+  jit::Jit* jit = (runtime != nullptr) ? runtime->GetJit() : nullptr;
+  if (jit == nullptr || !jit->GetCodeCache()->ContainsPc(header->GetCode())) {
+    entry.data = data;
+    entry.code_info = *this;
+  }
+}
 
 QuickMethodFrameInfo CodeInfo::DecodeFrameInfo(const uint8_t* data) {
   CodeInfo code_info(data);
@@ -69,7 +101,7 @@ QuickMethodFrameInfo CodeInfo::DecodeFrameInfo(const uint8_t* data) {
 }
 
 CodeInfo CodeInfo::DecodeGcMasksOnly(const OatQuickMethodHeader* header) {
-  CodeInfo code_info(header->GetOptimizedCodeInfoPtr());
+  CodeInfo code_info(header);  // Served from the per-thread decode cache when possible.
   CodeInfo copy;  // Copy to dead-code-eliminate all fields that we do not need.
   copy.stack_maps_ = code_info.stack_maps_;
   copy.register_masks_ = code_info.register_masks_;
@@ -78,7 +110,7 @@ CodeInfo CodeInfo::DecodeGcMasksOnly(const OatQuickMethodHeader* header) {
 }
 
 CodeInfo CodeInfo::DecodeInlineInfoOnly(const OatQuickMethodHeader* header) {
-  CodeInfo code_info(header->GetOptimizedCodeInfoPtr());
+  CodeInfo code_info(header);  // Served from the per-thread decode cache when possible.
   CodeInfo copy;  // Copy to dead-code-eliminate all fields that we do not need.
   copy.number_of_dex_registers_ = code_info.number_of_dex_registers_;
   copy.stack_maps_ = code_info.stack_maps_;
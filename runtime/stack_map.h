@@ -262,10 +262,17 @@ class RegisterMask : public BitTableAccessor<2> {
 
 // Method indices are not very dedup friendly.
 // Separating them greatly improves dedup efficiency of the other tables.
-class MethodInfo : public BitTableAccessor<1> {
+class MethodInfo : public BitTableAccessor<3> {
  public:
   BIT_TABLE_HEADER(MethodInfo)
   BIT_TABLE_COLUMN(0, MethodIndex)
+  BIT_TABLE_COLUMN(1, DexFileIndexKind)
+  BIT_TABLE_COLUMN(2, DexFileIndex)
+
+  // The method index is for the same dex file as the outer method's.
+  static constexpr uint32_t kSameDexFile = 0u;
+  // The method index is for the boot classpath dex file at `DexFileIndex`.
+  static constexpr uint32_t kBootClassPath = 1u;
 };
 
 /**
@@ -344,6 +351,10 @@ class CodeInfo {
     return method_infos_.GetRow(inline_info.GetMethodInfoIndex()).GetMethodIndex();
   }
 
+  MethodInfo GetMethodInfoOf(InlineInfo inline_info) const {
+    return method_infos_.GetRow(inline_info.GetMethodInfoIndex());
+  }
+
   ALWAYS_INLINE DexRegisterMap GetDexRegisterMapOf(StackMap stack_map) const {
     if (stack_map.HasDexRegisterMap()) {
       DexRegisterMap map(number_of_dex_registers_, DexRegisterLocation::Invalid());
@@ -31,6 +31,7 @@
 #include <algorithm>
 #include <bitset>
 #include <cerrno>
+#include <cstring>
 #include <iostream>
 #include <list>
 #include <sstream>
@@ -81,6 +82,7 @@
 #include "jni/jni_internal.h"
 #include "mirror/class-alloc-inl.h"
 #include "mirror/class_loader.h"
+#include "mirror/method.h"
 #include "mirror/object_array-alloc-inl.h"
 #include "mirror/object_array-inl.h"
 #include "mirror/stack_trace_element.h"
@@ -167,14 +169,28 @@ void Thread::SetIsGcMarkingAndUpdateEntrypoints(bool is_marking) {
 
 void Thread::InitTlsEntryPoints() {
   ScopedTrace trace("InitTlsEntryPoints");
-  // Insert a placeholder so we can easily tell if we call an unimplemented entry point.
-  uintptr_t* begin = reinterpret_cast<uintptr_t*>(&tlsPtr_.jni_entrypoints);
-  uintptr_t* end = reinterpret_cast<uintptr_t*>(
-      reinterpret_cast<uint8_t*>(&tlsPtr_.quick_entrypoints) + sizeof(tlsPtr_.quick_entrypoints));
-  for (uintptr_t* it = begin; it != end; ++it) {
-    *it = reinterpret_cast<uintptr_t>(UnimplementedEntryPoint);
-  }
-  InitEntryPoints(&tlsPtr_.jni_entrypoints, &tlsPtr_.quick_entrypoints);
+  // The freshly built tables are identical for every thread: InitEntryPoints only reads
+  // compile-time state, and the per-thread adjustments (read barrier marking state,
+  // allocation entrypoint switching) are applied later, when the thread is registered.
+  // Build the tables once and copy them into each new thread's TLS, which is much
+  // cheaper than the few hundred individual stores.
+  struct EntryPointsTemplate {
+    EntryPointsTemplate() {
+      // Insert a placeholder so we can easily tell if we call an unimplemented entry point.
+      uintptr_t* begin = reinterpret_cast<uintptr_t*>(&jni_entrypoints);
+      uintptr_t* end = reinterpret_cast<uintptr_t*>(
+          reinterpret_cast<uint8_t*>(&quick_entrypoints) + sizeof(quick_entrypoints));
+      for (uintptr_t* it = begin; it != end; ++it) {
+        *it = reinterpret_cast<uintptr_t>(UnimplementedEntryPoint);
+      }
+      InitEntryPoints(&jni_entrypoints, &quick_entrypoints);
+    }
+    JniEntryPoints jni_entrypoints;
+    QuickEntryPoints quick_entrypoints;
+  };
+  static const EntryPointsTemplate ep_template;
+  memcpy(&tlsPtr_.jni_entrypoints, &ep_template.jni_entrypoints, sizeof(JniEntryPoints));
+  memcpy(&tlsPtr_.quick_entrypoints, &ep_template.quick_entrypoints, sizeof(QuickEntryPoints));
 }
 
 void Thread::ResetQuickAllocEntryPointsForThread(bool is_marking) {
@@ -1546,6 +1562,26 @@ void Thread::ClearSuspendBarrier(AtomicInteger* target) {
   }
 }
 
+bool Thread::RemoveSuspendBarrier(AtomicInteger* target) {
+  // Unlike ClearSuspendBarrier, the barrier may already have been claimed by
+  // PassActiveSuspendBarriers; in that case report failure and leave the other entries alone.
+  bool found = false;
+  bool other_barriers_remain = false;
+  for (uint32_t i = 0; i < kMaxSuspendBarriers; ++i) {
+    AtomicInteger* ptr = tlsPtr_.active_suspend_barriers[i];
+    if (ptr == target) {
+      tlsPtr_.active_suspend_barriers[i] = nullptr;
+      found = true;
+    } else if (ptr != nullptr) {
+      other_barriers_remain = true;
+    }
+  }
+  if (found && !other_barriers_remain) {
+    AtomicClearFlag(kActiveSuspendBarrier);
+  }
+  return found;
+}
+
 void Thread::RunCheckpointFunction() {
   // Grab the suspend_count lock, get the next checkpoint and update all the checkpoint fields. If
   // there are no more checkpoints we will also clear the kCheckpointRequest flag.
@@ -2505,9 +2541,43 @@ Thread::~Thread() {
 
   Runtime::Current()->GetHeap()->AssertThreadLocalBuffersAreRevoked(this);
 
+  for (const std::pair<uint8_t*, size_t>& entry : shadow_frame_pool_) {
+    delete[] entry.first;
+  }
+
+  // Free the cached local scope storage blocks (see TryGetLocalScopeStorage).
+  while (tlsPtr_.local_scope_cache != nullptr) {
+    void* storage = tlsPtr_.local_scope_cache;
+    tlsPtr_.local_scope_cache = *reinterpret_cast<void**>(storage);
+    ::operator delete(storage);
+  }
+
   TearDownAlternateSignalStack();
 }
 
+uint8_t* Thread::AllocShadowFrameMemory(size_t size) {
+  DCHECK(this == Thread::Current());
+  // Prefer the most recently freed buffer, it is the most likely to be cache-hot.
+  for (size_t i = shadow_frame_pool_.size(); i != 0u; --i) {
+    if (shadow_frame_pool_[i - 1u].second == size) {
+      uint8_t* memory = shadow_frame_pool_[i - 1u].first;
+      shadow_frame_pool_.erase(shadow_frame_pool_.begin() + (i - 1u));
+      return memory;
+    }
+  }
+  return new uint8_t[size];
+}
+
+void Thread::FreeShadowFrameMemory(uint8_t* memory, size_t size) {
+  DCHECK(this == Thread::Current());
+  static constexpr size_t kMaxPooledShadowFrames = 16;
+  if (shadow_frame_pool_.size() < kMaxPooledShadowFrames) {
+    shadow_frame_pool_.emplace_back(memory, size);
+  } else {
+    delete[] memory;
+  }
+}
+
 void Thread::HandleUncaughtExceptions(ScopedObjectAccessAlreadyRunnable& soa) {
   if (!IsExceptionPending()) {
     return;
@@ -4022,6 +4092,22 @@ void Thread::VisitRoots(RootVisitor* visitor) {
     visitor->VisitRoot(reinterpret_cast<mirror::Object**>(&tlsPtr_.async_exception),
                        RootInfo(kRootNativeStack, thread_id));
   }
+  // Keep the MethodType comparison memo valid across a moving GC; the memoized
+  // results are keyed by the identity of the pair.
+  visitor->VisitRootIfNonNull(
+      reinterpret_cast<mirror::Object**>(&tlsPtr_.method_type_memo_callsite),
+      RootInfo(kRootNativeStack, thread_id));
+  visitor->VisitRootIfNonNull(
+      reinterpret_cast<mirror::Object**>(&tlsPtr_.method_type_memo_target),
+      RootInfo(kRootNativeStack, thread_id));
+  // The proxy invoke memo pins the memoized proxy class so that its method array
+  // (holding the ArtMethod used as the memo key) cannot be unloaded.
+  visitor->VisitRootIfNonNull(
+      reinterpret_cast<mirror::Object**>(&tlsPtr_.proxy_invoke_memo_class),
+      RootInfo(kRootNativeStack, thread_id));
+  visitor->VisitRootIfNonNull(
+      reinterpret_cast<mirror::Object**>(&tlsPtr_.proxy_invoke_memo_reflect_method),
+      RootInfo(kRootNativeStack, thread_id));
   visitor->VisitRootIfNonNull(&tlsPtr_.monitor_enter_object, RootInfo(kRootNativeStack, thread_id));
   tlsPtr_.jni_env->VisitJniLocalRoots(visitor, RootInfo(kRootJNILocal, thread_id));
   tlsPtr_.jni_env->VisitMonitorRoots(visitor, RootInfo(kRootJNIMonitor, thread_id));
@@ -4072,37 +4158,63 @@ void Thread::VisitRoots(RootVisitor* visitor) {
   }
 }
 
+static void SweepInterpreterCacheEntry(IsMarkedVisitor* visitor, InterpreterCache::Entry& entry)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  const Instruction* inst = reinterpret_cast<const Instruction*>(entry.first);
+  if (inst != nullptr) {
+    if (inst->Opcode() == Instruction::NEW_INSTANCE ||
+        inst->Opcode() == Instruction::CHECK_CAST ||
+        inst->Opcode() == Instruction::INSTANCE_OF ||
+        inst->Opcode() == Instruction::NEW_ARRAY ||
+        inst->Opcode() == Instruction::CONST_CLASS) {
+      mirror::Class* cls = reinterpret_cast<mirror::Class*>(entry.second);
+      if (cls == nullptr || cls == Runtime::GetWeakClassSentinel()) {
+        // Entry got deleted in a previous sweep.
+        return;
+      }
+      Runtime::ProcessWeakClass(
+          reinterpret_cast<GcRoot<mirror::Class>*>(&entry.second),
+          visitor,
+          Runtime::GetWeakClassSentinel());
+    } else if (inst->Opcode() == Instruction::CONST_STRING ||
+               inst->Opcode() == Instruction::CONST_STRING_JUMBO) {
+      mirror::Object* object = reinterpret_cast<mirror::Object*>(entry.second);
+      mirror::Object* new_object = visitor->IsMarked(object);
+      // We know the string is marked because it's a strongly-interned string that
+      // is always alive (see b/117621117 for trying to make those strings weak).
+      // The IsMarked implementation of the CMS collector returns
+      // null for newly allocated objects, but we know those haven't moved. Therefore,
+      // only update the entry if we get a different non-null string.
+      if (new_object != nullptr && new_object != object) {
+        entry.second = reinterpret_cast<size_t>(new_object);
+      }
+    }
+  }
+}
+
 void Thread::SweepInterpreterCache(IsMarkedVisitor* visitor) {
   for (InterpreterCache::Entry& entry : GetInterpreterCache()->GetArray()) {
-    const Instruction* inst = reinterpret_cast<const Instruction*>(entry.first);
-    if (inst != nullptr) {
-      if (inst->Opcode() == Instruction::NEW_INSTANCE ||
-          inst->Opcode() == Instruction::CHECK_CAST ||
-          inst->Opcode() == Instruction::INSTANCE_OF ||
-          inst->Opcode() == Instruction::NEW_ARRAY ||
-          inst->Opcode() == Instruction::CONST_CLASS) {
-        mirror::Class* cls = reinterpret_cast<mirror::Class*>(entry.second);
-        if (cls == nullptr || cls == Runtime::GetWeakClassSentinel()) {
-          // Entry got deleted in a previous sweep.
-          continue;
-        }
-        Runtime::ProcessWeakClass(
-            reinterpret_cast<GcRoot<mirror::Class>*>(&entry.second),
-            visitor,
-            Runtime::GetWeakClassSentinel());
-      } else if (inst->Opcode() == Instruction::CONST_STRING ||
-                 inst->Opcode() == Instruction::CONST_STRING_JUMBO) {
-        mirror::Object* object = reinterpret_cast<mirror::Object*>(entry.second);
-        mirror::Object* new_object = visitor->IsMarked(object);
-        // We know the string is marked because it's a strongly-interned string that
-        // is always alive (see b/117621117 for trying to make those strings weak).
-        // The IsMarked implementation of the CMS collector returns
-        // null for newly allocated objects, but we know those haven't moved. Therefore,
-        // only update the entry if we get a different non-null string.
-        if (new_object != nullptr && new_object != object) {
-          entry.second = reinterpret_cast<size_t>(new_object);
-        }
-      }
+    SweepInterpreterCacheEntry(visitor, entry);
+  }
+  for (InterpreterCache::Entry& entry : GetInterpreterCache()->GetVictimArray()) {
+    SweepInterpreterCacheEntry(visitor, entry);
+  }
+}
+
+void Thread::SweepTypeCheckCache(IsMarkedVisitor* visitor) {
+  for (TypeCheckCache::Entry& entry : GetTypeCheckCache()->GetArray()) {
+    if (entry.source == nullptr) {
+      continue;
+    }
+    mirror::Object* new_source = visitor->IsMarked(entry.source);
+    mirror::Object* new_target = visitor->IsMarked(entry.target);
+    if (new_source == nullptr || new_target == nullptr) {
+      // One of the classes is dead; the memoized result must not be found again.
+      entry = TypeCheckCache::Entry{};
+    } else {
+      // Keep the identity-based key valid across a moving GC.
+      entry.source = down_cast<mirror::Class*>(new_source);
+      entry.target = down_cast<mirror::Class*>(new_target);
     }
   }
 }
@@ -4311,6 +4423,70 @@ void Thread::ClearAllInterpreterCaches() {
   Runtime::Current()->GetThreadList()->RunCheckpoint(&closure);
 }
 
+// Bit layout of tlsPtr_.method_type_memo_results. The exact-match and convertibility
+// checks are memoized independently for the same (callsite, target) pair.
+static constexpr uintptr_t kMethodTypeMemoExactKnown = 1u << 0;
+static constexpr uintptr_t kMethodTypeMemoExactResult = 1u << 1;
+static constexpr uintptr_t kMethodTypeMemoConvertibleKnown = 1u << 2;
+static constexpr uintptr_t kMethodTypeMemoConvertibleResult = 1u << 3;
+
+bool Thread::GetCachedMethodTypeCheck(ObjPtr<mirror::MethodType> callsite_type,
+                                      ObjPtr<mirror::MethodType> target_type,
+                                      bool exact_match,
+                                      /*out*/ bool* result) {
+  DCHECK(callsite_type != nullptr);
+  DCHECK(target_type != nullptr);
+  if (tlsPtr_.method_type_memo_callsite != callsite_type.Ptr() ||
+      tlsPtr_.method_type_memo_target != target_type.Ptr()) {
+    return false;
+  }
+  const uintptr_t known_bit =
+      exact_match ? kMethodTypeMemoExactKnown : kMethodTypeMemoConvertibleKnown;
+  if ((tlsPtr_.method_type_memo_results & known_bit) == 0u) {
+    return false;
+  }
+  const uintptr_t result_bit =
+      exact_match ? kMethodTypeMemoExactResult : kMethodTypeMemoConvertibleResult;
+  *result = (tlsPtr_.method_type_memo_results & result_bit) != 0u;
+  return true;
+}
+
+void Thread::CacheMethodTypeCheck(ObjPtr<mirror::MethodType> callsite_type,
+                                  ObjPtr<mirror::MethodType> target_type,
+                                  bool exact_match,
+                                  bool result) {
+  DCHECK(callsite_type != nullptr);
+  DCHECK(target_type != nullptr);
+  if (tlsPtr_.method_type_memo_callsite != callsite_type.Ptr() ||
+      tlsPtr_.method_type_memo_target != target_type.Ptr()) {
+    tlsPtr_.method_type_memo_callsite = callsite_type.Ptr();
+    tlsPtr_.method_type_memo_target = target_type.Ptr();
+    tlsPtr_.method_type_memo_results = 0u;
+  }
+  const uintptr_t known_bit =
+      exact_match ? kMethodTypeMemoExactKnown : kMethodTypeMemoConvertibleKnown;
+  const uintptr_t result_bit =
+      exact_match ? kMethodTypeMemoExactResult : kMethodTypeMemoConvertibleResult;
+  tlsPtr_.method_type_memo_results |= known_bit | (result ? result_bit : 0u);
+}
+
+ObjPtr<mirror::Method> Thread::GetCachedProxyInvokeMethod(ArtMethod* proxy_method) {
+  DCHECK(proxy_method != nullptr);
+  if (tlsPtr_.proxy_invoke_memo_method != proxy_method) {
+    return nullptr;
+  }
+  DCHECK(tlsPtr_.proxy_invoke_memo_reflect_method != nullptr);
+  return tlsPtr_.proxy_invoke_memo_reflect_method;
+}
+
+void Thread::CacheProxyInvokeMethod(ArtMethod* proxy_method,
+                                    ObjPtr<mirror::Method> interface_method) {
+  DCHECK(proxy_method != nullptr);
+  DCHECK(interface_method != nullptr);
+  tlsPtr_.proxy_invoke_memo_method = proxy_method;
+  tlsPtr_.proxy_invoke_memo_class = proxy_method->GetDeclaringClass().Ptr();
+  tlsPtr_.proxy_invoke_memo_reflect_method = interface_method.Ptr();
+}
 
 void Thread::ReleaseLongJumpContextInternal() {
   // Each QuickExceptionHandler gets a long jump context and uses
@@ -24,6 +24,8 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/atomic.h"
 #include "base/enums.h"
@@ -44,6 +46,7 @@
 #include "runtime_globals.h"
 #include "runtime_stats.h"
 #include "thread_state.h"
+#include "type_check_cache.h"
 
 class BacktraceMap;
 
@@ -66,6 +69,8 @@ namespace mirror {
 class Array;
 class Class;
 class ClassLoader;
+class Method;
+class MethodType;
 class Object;
 template<class T> class ObjectArray;
 template<class T> class PrimitiveArray;
@@ -916,6 +921,33 @@ class Thread {
     return handle_scope;
   }
 
+  // Maximum number of retired local scope storage blocks cached per thread.
+  static constexpr size_t kMaxLocalScopeCacheSize = 8;
+
+  // Take a pooled storage block for a VariableSizedHandleScope local scope, or null if the pool
+  // is empty. Pooling avoids allocator round trips on JNI-heavy threads whose handle scopes
+  // overflow their inline storage; see VariableSizedHandleScope::NewHandle.
+  void* TryGetLocalScopeStorage() {
+    void* storage = tlsPtr_.local_scope_cache;
+    if (storage != nullptr) {
+      tlsPtr_.local_scope_cache = *reinterpret_cast<void**>(storage);
+      --tlsPtr_.local_scope_cache_size;
+    }
+    return storage;
+  }
+
+  // Return a storage block to the pool. Returns false when the pool is full; the caller then
+  // frees the block instead.
+  bool CacheLocalScopeStorage(void* storage) {
+    if (tlsPtr_.local_scope_cache_size >= kMaxLocalScopeCacheSize) {
+      return false;
+    }
+    *reinterpret_cast<void**>(storage) = tlsPtr_.local_scope_cache;
+    tlsPtr_.local_scope_cache = storage;
+    ++tlsPtr_.local_scope_cache_size;
+    return true;
+  }
+
   template<PointerSize pointer_size>
   static constexpr ThreadOffset<pointer_size> TopHandleScopeOffset() {
     return ThreadOffsetFromTlsPtr<pointer_size>(OFFSETOF_MEMBER(tls_ptr_sized_values,
@@ -1123,6 +1155,13 @@ class Thread {
   void ClearSuspendBarrier(AtomicInteger* target)
       REQUIRES(Locks::thread_suspend_count_lock_);
 
+  // Remove an installed suspend barrier without passing it. Returns true if the barrier was
+  // still installed and has been removed. Returns false if this thread has already claimed the
+  // barrier; in that case its decrement may still be in flight and the owner of the barrier
+  // memory must wait for the counter to reach zero before releasing it.
+  bool RemoveSuspendBarrier(AtomicInteger* target)
+      REQUIRES(Locks::thread_suspend_count_lock_);
+
   bool ReadFlag(ThreadFlag flag) const {
     return (tls32_.state_and_flags.as_struct.flags & flag) != 0;
   }
@@ -1161,6 +1200,62 @@ class Thread {
     DCHECK_LE(tlsPtr_.thread_local_end, tlsPtr_.thread_local_limit);
   }
 
+  // Per-thread TLAB size auto-tuning state, maintained by Heap::AllocWithNewTLAB. A next
+  // size of 0 means "not yet initialized, use the heap default". Only accessed by this thread
+  // from the allocation slow path.
+  size_t GetNextTlabSize() const {
+    return next_tlab_size_;
+  }
+  void SetNextTlabSize(size_t bytes) {
+    next_tlab_size_ = bytes;
+  }
+  uint64_t GetLastTlabRefillNs() const {
+    return last_tlab_refill_ns_;
+  }
+  void SetLastTlabRefillNs(uint64_t ns) {
+    last_tlab_refill_ns_ = ns;
+  }
+
+  // Thread-local LinearAlloc buffer state, maintained by LinearAlloc::Alloc. The id identifies
+  // which LinearAlloc the buffer was carved from; ids are never reused, so a buffer whose
+  // allocator has been destroyed simply stops matching and is replaced on the next refill.
+  // Only accessed by this thread.
+  uint64_t GetLinearAllocBufferId() const {
+    return linear_alloc_buffer_id_;
+  }
+  uint8_t* GetLinearAllocBufferPos() const {
+    return linear_alloc_buffer_pos_;
+  }
+  uint8_t* GetLinearAllocBufferEnd() const {
+    return linear_alloc_buffer_end_;
+  }
+  void SetLinearAllocBuffer(uint64_t id, uint8_t* pos, uint8_t* end) {
+    linear_alloc_buffer_id_ = id;
+    linear_alloc_buffer_pos_ = pos;
+    linear_alloc_buffer_end_ = end;
+  }
+  void SetLinearAllocBufferPos(uint8_t* pos) {
+    linear_alloc_buffer_pos_ = pos;
+  }
+
+  // Per-thread buffer of pending method trace records, maintained by Trace while
+  // streaming method tracing is active. Records are appended by this thread without
+  // locking and drained in batches under Trace::streaming_lock_. The buffer is
+  // flushed and freed when it fills up, when this thread exits or when the trace
+  // stops; see Trace::LogMethodTraceEvent.
+  uintptr_t* GetMethodTraceBuffer() const {
+    return method_trace_buffer_;
+  }
+  size_t GetMethodTraceIndex() const {
+    return method_trace_index_;
+  }
+  void SetMethodTraceBuffer(uintptr_t* buffer) {
+    method_trace_buffer_ = buffer;
+  }
+  void SetMethodTraceIndex(size_t index) {
+    method_trace_index_ = index;
+  }
+
   // Doesn't check that there is room.
   mirror::Object* AllocTlab(size_t bytes);
   void SetTlab(uint8_t* start, uint8_t* end, uint8_t* limit);
@@ -1323,6 +1418,18 @@ class Thread {
     return &interpreter_cache_;
   }
 
+  ALWAYS_INLINE TypeCheckCache* GetTypeCheckCache() {
+    return &type_check_cache_;
+  }
+
+  // Acquire memory for a deoptimized shadow frame, reusing a previously released
+  // buffer of the same size if one is pooled. See ShadowFrame::CreateDeoptimizedFrame.
+  uint8_t* AllocShadowFrameMemory(size_t size);
+
+  // Return memory obtained from AllocShadowFrameMemory to the pool, or release
+  // it to the native allocator if the pool is full.
+  void FreeShadowFrameMemory(uint8_t* memory, size_t size);
+
   // Clear all thread-local interpreter caches.
   //
   // Since the caches are keyed by memory pointer to dex instructions, this must be
@@ -1342,6 +1449,32 @@ class Thread {
     return WhichPowerOf2(InterpreterCache::kSize);
   }
 
+  // Look up the memoized result of a MethodType exact-match or convertibility check
+  // for the given pair, see method_handles.cc. Returns true and sets `*result` if the
+  // last comparison performed on this thread was for the same (callsite, target) pair.
+  bool GetCachedMethodTypeCheck(ObjPtr<mirror::MethodType> callsite_type,
+                                ObjPtr<mirror::MethodType> target_type,
+                                bool exact_match,
+                                /*out*/ bool* result) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Record the result of a MethodType comparison, replacing any memoized entry for a
+  // different pair.
+  void CacheMethodTypeCheck(ObjPtr<mirror::MethodType> callsite_type,
+                            ObjPtr<mirror::MethodType> target_type,
+                            bool exact_match,
+                            bool result) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Return the memoized reflective interface method for the last proxy method invoked
+  // on this thread, or null if `proxy_method` differs from the memoized one. See
+  // artQuickProxyInvokeHandler.
+  ObjPtr<mirror::Method> GetCachedProxyInvokeMethod(ArtMethod* proxy_method)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Memoize the reflective interface method created for an invocation of `proxy_method`,
+  // replacing any entry for a different proxy method.
+  void CacheProxyInvokeMethod(ArtMethod* proxy_method, ObjPtr<mirror::Method> interface_method)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
  private:
   explicit Thread(bool daemon);
   ~Thread() REQUIRES(!Locks::mutator_lock_, !Locks::thread_suspend_count_lock_);
@@ -1473,6 +1606,8 @@ class Thread {
 
   void SweepInterpreterCache(IsMarkedVisitor* visitor) REQUIRES_SHARED(Locks::mutator_lock_);
 
+  void SweepTypeCheckCache(IsMarkedVisitor* visitor) REQUIRES_SHARED(Locks::mutator_lock_);
+
   static bool IsAotCompiler();
 
   void ReleaseLongJumpContextInternal();
@@ -1684,7 +1819,12 @@ class Thread {
       thread_local_objects(0), mterp_current_ibase(nullptr), thread_local_alloc_stack_top(nullptr),
       thread_local_alloc_stack_end(nullptr),
       flip_function(nullptr), method_verifier(nullptr), thread_local_mark_stack(nullptr),
-      async_exception(nullptr), top_reflective_handle_scope(nullptr) {
+      async_exception(nullptr), top_reflective_handle_scope(nullptr),
+      local_scope_cache(nullptr), local_scope_cache_size(0),
+      method_type_memo_callsite(nullptr), method_type_memo_target(nullptr),
+      method_type_memo_results(0),
+      proxy_invoke_memo_method(nullptr), proxy_invoke_memo_class(nullptr),
+      proxy_invoke_memo_reflect_method(nullptr) {
       std::fill(held_mutexes, held_mutexes + kLockLevelCount, nullptr);
     }
 
@@ -1843,6 +1983,30 @@ class Thread {
 
     // Top of the linked-list for reflective-handle scopes or null if none.
     BaseReflectiveHandleScope* top_reflective_handle_scope;
+
+    // Singly linked free list of retired VariableSizedHandleScope local scope storage blocks,
+    // threaded through the blocks themselves, and its current length. See
+    // Thread::TryGetLocalScopeStorage.
+    void* local_scope_cache;
+    size_t local_scope_cache_size;
+
+    // Single-entry memo for the MethodType comparisons performed on the interpreted
+    // invoke-polymorphic paths, keyed by the identity of the last compared pair.
+    // Both pointers are visited by VisitRoots() so that the identity-based key stays
+    // valid across a moving GC. The results word packs the known/result bits for the
+    // exact-match and convertibility checks; see Thread::GetCachedMethodTypeCheck.
+    mirror::MethodType* method_type_memo_callsite;
+    mirror::MethodType* method_type_memo_target;
+    uintptr_t method_type_memo_results;
+
+    // Single-entry memo for the reflective interface method passed to the invocation
+    // handler by artQuickProxyInvokeHandler, keyed by the proxy ArtMethod. Both the
+    // reflect method and the proxy's declaring class are visited by VisitRoots(); the
+    // latter keeps the key's proxy class (and its method array) from being unloaded
+    // while memoized, so the identity-based key cannot dangle.
+    ArtMethod* proxy_invoke_memo_method;
+    mirror::Class* proxy_invoke_memo_class;
+    mirror::Method* proxy_invoke_memo_reflect_method;
   } tlsPtr_;
 
   // Small thread-local cache to be used from the interpreter.
@@ -1853,6 +2017,11 @@ class Thread {
   // All fields below this line should not be accessed by native code. This means these fields can
   // be modified, rearranged, added or removed without having to modify asm_support.h
 
+  // Small thread-local cache memoizing the non-trivial assignability checks
+  // performed by the type check entrypoints. It is keyed by the identity of the
+  // (source, target) class pair and swept by SweepTypeCheckCache.
+  TypeCheckCache type_check_cache_;
+
   // Guards the 'wait_monitor_' members.
   Mutex* wait_mutex_ DEFAULT_MUTEX_ACQUIRED_AFTER;
 
@@ -1861,6 +2030,28 @@ class Thread {
   // Pointer to the monitor lock we're currently waiting on or null if not waiting.
   Monitor* wait_monitor_ GUARDED_BY(wait_mutex_);
 
+  // TLAB size to use for this thread's next refill and the timestamp of the last refill, used
+  // by the allocation-rate based TLAB auto-tuning in Heap::AllocWithNewTLAB.
+  size_t next_tlab_size_ = 0;
+  uint64_t last_tlab_refill_ns_ = 0;
+
+  // Thread-local buffer for small LinearAlloc allocations, see LinearAlloc::Alloc. An id of 0
+  // means "no buffer".
+  uint64_t linear_alloc_buffer_id_ = 0;
+  uint8_t* linear_alloc_buffer_pos_ = nullptr;
+  uint8_t* linear_alloc_buffer_end_ = nullptr;
+
+  // Buffer of method trace records not yet written to the trace and the number of
+  // records currently in it; see GetMethodTraceBuffer().
+  uintptr_t* method_trace_buffer_ = nullptr;
+  size_t method_trace_index_ = 0;
+
+  // Pool of (buffer, size) pairs for deoptimized shadow frames, which are
+  // heap-allocated. Deoptimization creates one frame per interpreted method on
+  // the stack, so threads which deoptimize often reuse buffers instead of going
+  // back to the native allocator. Buffers are matched on exact size.
+  std::vector<std::pair<uint8_t*, size_t>> shadow_frame_pool_;
+
   // Debug disable read barrier count, only is checked for debug builds and only in the runtime.
   uint8_t debug_disallow_read_barrier_ = 0;
 
@@ -317,6 +317,46 @@ static void ThreadSuspendSleep(useconds_t delay_us) {
   }
 }
 
+#if ART_USE_FUTEXES
+// Wait on the futex doorbell of a single-thread suspend barrier. Returns when the barrier has
+// been passed, on a spurious wake-up, or after timeout_ns; the caller re-examines the thread
+// state and the overall deadline either way.
+static void WaitForSuspendBarrier(AtomicInteger* pending_threads, uint64_t timeout_ns) {
+  int32_t cur_val = pending_threads->load(std::memory_order_acquire);
+  if (cur_val <= 0) {
+    DCHECK_EQ(cur_val, 0);
+    return;
+  }
+  timespec wait_timeout;
+  InitTimeSpec(false, CLOCK_MONOTONIC, NsToMs(timeout_ns), 0, &wait_timeout);
+  if (futex(pending_threads->Address(), FUTEX_WAIT_PRIVATE, cur_val, &wait_timeout, nullptr, 0)
+      != 0) {
+    if ((errno != EAGAIN) && (errno != EINTR) && (errno != ETIMEDOUT)) {
+      PLOG(FATAL) << "futex wait for suspend barrier failed";
+    }
+  }
+}
+#endif  // ART_USE_FUTEXES
+
+// Detach a stack-allocated suspend barrier from |thread| before the barrier memory goes out of
+// scope. If the thread has already claimed the barrier its decrement may still be in flight, so
+// spin until it lands. Spinning here cannot deadlock even though we hold
+// thread_suspend_count_lock_, because Thread::PassActiveSuspendBarriers only decrements after
+// releasing that lock.
+static void RemoveOrWaitForSuspendBarrier(Thread* thread, AtomicInteger* pending_threads)
+    REQUIRES(Locks::thread_suspend_count_lock_) {
+  if (pending_threads->load(std::memory_order_relaxed) == 0) {
+    return;
+  }
+  if (thread->RemoveSuspendBarrier(pending_threads)) {
+    pending_threads->store(0, std::memory_order_relaxed);
+    return;
+  }
+  while (pending_threads->load(std::memory_order_relaxed) != 0) {
+    sched_yield();
+  }
+}
+
 size_t ThreadList::RunCheckpoint(Closure* checkpoint_function, Closure* callback) {
   Thread* self = Thread::Current();
   Locks::mutator_lock_->AssertNotExclusiveHeld(self);
@@ -891,6 +931,10 @@ Thread* ThreadList::SuspendThreadByPeer(jobject peer,
   *timed_out = false;
   Thread* const self = Thread::Current();
   Thread* suspended_thread = nullptr;
+  // Futex doorbell decremented by the target as part of suspending, letting us wait for the
+  // suspend instead of sleep-polling. Stack-allocated, so every path out of the loop below must
+  // detach it from the target before returning.
+  AtomicInteger pending_threads;
   VLOG(threads) << "SuspendThreadByPeer starting";
   while (true) {
     Thread* thread;
@@ -914,6 +958,7 @@ Thread* ThreadList::SuspendThreadByPeer(jobject peer,
                                                               nullptr,
                                                               reason);
           DCHECK(updated);
+          RemoveOrWaitForSuspendBarrier(suspended_thread, &pending_threads);
         }
         ThreadSuspendByPeerWarning(self,
                                    ::android::base::WARNING,
@@ -939,7 +984,8 @@ Thread* ThreadList::SuspendThreadByPeer(jobject peer,
           }
           CHECK(suspended_thread == nullptr);
           suspended_thread = thread;
-          bool updated = suspended_thread->ModifySuspendCount(self, +1, nullptr, reason);
+          pending_threads.store(1, std::memory_order_relaxed);
+          bool updated = suspended_thread->ModifySuspendCount(self, +1, &pending_threads, reason);
           DCHECK(updated);
           request_suspension = false;
         } else {
@@ -956,6 +1002,7 @@ Thread* ThreadList::SuspendThreadByPeer(jobject peer,
         // done.
         if (thread->IsSuspended()) {
           VLOG(threads) << "SuspendThreadByPeer thread suspended: " << *thread;
+          RemoveOrWaitForSuspendBarrier(thread, &pending_threads);
           if (ATraceEnabled()) {
             std::string name;
             thread->GetThreadName(name);
@@ -977,6 +1024,7 @@ Thread* ThreadList::SuspendThreadByPeer(jobject peer,
                                                                 nullptr,
                                                                 reason);
             DCHECK(updated);
+            RemoveOrWaitForSuspendBarrier(thread, &pending_threads);
           }
           *timed_out = true;
           return nullptr;
@@ -990,6 +1038,15 @@ Thread* ThreadList::SuspendThreadByPeer(jobject peer,
       // Release locks and come out of runnable state.
     }
     VLOG(threads) << "SuspendThreadByPeer waiting to allow thread chance to suspend";
+#if ART_USE_FUTEXES
+    if (pending_threads.load(std::memory_order_relaxed) != 0) {
+      // Wait on the doorbell rather than sleep-polling; the target wakes us when it suspends.
+      WaitForSuspendBarrier(&pending_threads, thread_suspend_timeout_ns_);
+      continue;
+    }
+#endif
+    // No barrier is installed (the caller requested the suspension themselves), so fall back to
+    // polling.
     ThreadSuspendSleep(sleep_us);
     // This may stay at 0 if sleep_us == 0, but this is WAI since we want to avoid using usleep at
     // all if possible. This shouldn't be an issue since time to suspend should always be small.
@@ -1011,6 +1068,8 @@ Thread* ThreadList::SuspendThreadByThreadId(uint32_t thread_id,
   *timed_out = false;
   Thread* suspended_thread = nullptr;
   Thread* const self = Thread::Current();
+  // Futex doorbell decremented by the target as part of suspending; see SuspendThreadByPeer.
+  AtomicInteger pending_threads;
   CHECK_NE(thread_id, kInvalidThreadId);
   VLOG(threads) << "SuspendThreadByThreadId starting";
   while (true) {
@@ -1049,7 +1108,8 @@ Thread* ThreadList::SuspendThreadByThreadId(uint32_t thread_id,
             // which will allow this thread to be suspended.
             continue;
           }
-          bool updated = thread->ModifySuspendCount(self, +1, nullptr, reason);
+          pending_threads.store(1, std::memory_order_relaxed);
+          bool updated = thread->ModifySuspendCount(self, +1, &pending_threads, reason);
           DCHECK(updated);
           suspended_thread = thread;
         } else {
@@ -1066,6 +1126,7 @@ Thread* ThreadList::SuspendThreadByThreadId(uint32_t thread_id,
         // count, or else we've waited and it has self suspended) or is the current thread, we're
         // done.
         if (thread->IsSuspended()) {
+          RemoveOrWaitForSuspendBarrier(thread, &pending_threads);
           if (ATraceEnabled()) {
             std::string name;
             thread->GetThreadName(name);
@@ -1083,6 +1144,7 @@ Thread* ThreadList::SuspendThreadByThreadId(uint32_t thread_id,
           if (suspended_thread != nullptr) {
             bool updated = thread->ModifySuspendCount(soa.Self(), -1, nullptr, reason);
             DCHECK(updated);
+            RemoveOrWaitForSuspendBarrier(thread, &pending_threads);
           }
           *timed_out = true;
           return nullptr;
@@ -1096,6 +1158,12 @@ Thread* ThreadList::SuspendThreadByThreadId(uint32_t thread_id,
       // Release locks and come out of runnable state.
     }
     VLOG(threads) << "SuspendThreadByThreadId waiting to allow thread chance to suspend";
+#if ART_USE_FUTEXES
+    if (pending_threads.load(std::memory_order_relaxed) != 0) {
+      WaitForSuspendBarrier(&pending_threads, thread_suspend_timeout_ns_);
+      continue;
+    }
+#endif
     ThreadSuspendSleep(sleep_us);
     sleep_us = std::min(sleep_us * 2, kThreadSuspendMaxSleepUs);
   }
@@ -1305,6 +1373,14 @@ void ThreadList::Unregister(Thread* self) {
   // list.
   self->Destroy();
 
+  // If tracing, write out any method trace records still buffered by this
+  // thread. This needs the mutator lock to encode method names, so it cannot
+  // wait until ~Thread.
+  if (self->GetMethodTraceBuffer() != nullptr) {
+    ScopedObjectAccess soa(self);
+    Trace::FlushThreadBuffer(self);
+  }
+
   // If tracing, remember thread id and name before thread exits.
   Trace::StoreExitingThreadInfo(self);
 
@@ -1410,6 +1486,7 @@ void ThreadList::SweepInterpreterCaches(IsMarkedVisitor* visitor) const {
   MutexLock mu(Thread::Current(), *Locks::thread_list_lock_);
   for (const auto& thread : list_) {
     thread->SweepInterpreterCache(visitor);
+    thread->SweepTypeCheckCache(visitor);
   }
 }
 
@@ -145,6 +145,26 @@ class ThreadList {
     }, &cb);
   }
 
+  // Iterates over all the threads without taking thread_list_lock_. Only valid during a
+  // suspend-all pause while additionally excluding Register(), e.g. by holding
+  // runtime_shutdown_lock_: with every registered thread's suspend count raised, no thread can
+  // pass the !IsSuspended() check in Unregister() and drop out of the list, and new threads
+  // cannot be added. Used by per-GC-cycle paths such as revoking all thread-local allocation
+  // stacks, which would otherwise serialize on the thread list lock in every cycle.
+  template<typename CallBack>
+  void ForEachThreadDuringSuspendAll(CallBack cb)
+      REQUIRES(Locks::runtime_shutdown_lock_) NO_THREAD_SAFETY_ANALYSIS {
+    Thread* self = Thread::Current();
+    Locks::mutator_lock_->AssertExclusiveHeld(self);
+    if (kIsDebugBuild) {
+      MutexLock mu(self, *Locks::thread_suspend_count_lock_);
+      DCHECK_GT(suspend_all_count_, 0);
+    }
+    for (const auto& thread : list_) {
+      cb(thread);
+    }
+  }
+
   // Add/remove current thread from list.
   void Register(Thread* self)
       REQUIRES(Locks::runtime_shutdown_lock_)
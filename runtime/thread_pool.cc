@@ -126,6 +126,17 @@ void ThreadPool::AddTask(Thread* self, Task* task) {
   }
 }
 
+void ThreadPool::AddPriorityTask(Thread* self, Task* task) {
+  MutexLock mu(self, task_queue_lock_);
+  // Queue behind other priority tasks but ahead of all regular tasks.
+  tasks_.insert(tasks_.begin() + num_priority_tasks_, task);
+  ++num_priority_tasks_;
+  // If we have any waiters, signal one.
+  if (started_ && waiting_count_ != 0) {
+    task_queue_condition_.Signal(self);
+  }
+}
+
 void ThreadPool::RemoveAllTasks(Thread* self) {
   // The ThreadPool is responsible for calling Finalize (which usually delete
   // the task memory) on all the tasks.
@@ -135,6 +146,7 @@ void ThreadPool::RemoveAllTasks(Thread* self) {
   }
   MutexLock mu(self, task_queue_lock_);
   tasks_.clear();
+  num_priority_tasks_ = 0;
 }
 
 ThreadPool::ThreadPool(const char* name,
@@ -148,6 +160,7 @@ ThreadPool::ThreadPool(const char* name,
     started_(false),
     shutting_down_(false),
     waiting_count_(0),
+    num_priority_tasks_(0),
     start_time_(0),
     total_wait_time_(0),
     creation_barier_(0),
@@ -168,12 +181,15 @@ void ThreadPool::CreateThreads() {
     while (GetThreadCount() < max_active_workers_) {
       const std::string worker_name = StringPrintf("%s worker thread %zu", name_.c_str(),
                                                    GetThreadCount());
-      threads_.push_back(
-          new ThreadPoolWorker(this, worker_name, worker_stack_size_));
+      threads_.push_back(CreateThreadPoolWorker(worker_name));
     }
   }
 }
 
+ThreadPoolWorker* ThreadPool::CreateThreadPoolWorker(const std::string& name) {
+  return new ThreadPoolWorker(this, name, worker_stack_size_);
+}
+
 void ThreadPool::WaitForWorkersToBeCreated() {
   creation_barier_.Increment(Thread::Current(), 0);
 }
@@ -265,6 +281,9 @@ Task* ThreadPool::TryGetTaskLocked() {
   if (HasOutstandingTasks()) {
     Task* task = tasks_.front();
     tasks_.pop_front();
+    if (num_priority_tasks_ != 0) {
+      --num_priority_tasks_;
+    }
     return task;
   }
   return nullptr;
@@ -301,4 +320,201 @@ void ThreadPool::SetPthreadPriority(int priority) {
   }
 }
 
+WorkStealingThreadPool::WorkStealingThreadPool(const char* name,
+                                               size_t num_threads,
+                                               bool create_peers,
+                                               size_t worker_stack_size)
+    // Create the pool without workers first: workers dispatch virtually into this class as soon
+    // as they run, which must not happen before the per-worker queues below exist.
+    : ThreadPool(name, /*num_threads=*/ 0u, create_peers, worker_stack_size),
+      pending_deque_tasks_(0u),
+      worker_threads_(num_threads) {
+  queues_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    queues_.emplace_back(new WorkerQueue());
+  }
+  for (Atomic<Thread*>& worker_thread : worker_threads_) {
+    worker_thread.store(nullptr, std::memory_order_relaxed);
+  }
+  {
+    MutexLock mu(Thread::Current(), task_queue_lock_);
+    max_active_workers_ = num_threads;
+  }
+  CreateThreads();
+}
+
+ThreadPoolWorker* WorkStealingThreadPool::CreateThreadPoolWorker(const std::string& name) {
+  ThreadPoolWorker* worker = ThreadPool::CreateThreadPoolWorker(name);
+  // Record the worker's pthread handle. GetWorkerIndex resolves a worker's index from this
+  // list rather than from threads_, because a freshly spawned worker can start dequeuing
+  // while other workers are still being constructed and appended to threads_ (and, during
+  // shutdown, after some of them have already been destroyed).
+  const size_t index = threads_.size();
+  DCHECK_LT(index, worker_threads_.size());
+  worker_threads_[index].store(nullptr, std::memory_order_relaxed);
+  worker_pthreads_.push_back(worker->pthread_);
+  return worker;
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  // Join the workers before the per-worker queues are destroyed; the base class destructor would
+  // only do so afterwards.
+  DeleteThreads();
+  RemoveAllTasks(Thread::Current());
+}
+
+void WorkStealingThreadPool::AddTaskWithAffinity(Thread* self, Task* task, size_t affinity_tag) {
+  MutexLock mu(self, task_queue_lock_);
+  if (queues_.empty() || !started_) {
+    // Zero-sized pool, or the pool has not been started yet: queue on the shared queue so that
+    // StartWorkers retains its meaning.
+    tasks_.push_back(task);
+  } else {
+    WorkerQueue* queue = queues_[affinity_tag % queues_.size()].get();
+    MutexLock queue_mu(self, queue->lock_);
+    queue->tasks_.push_back(task);
+    pending_deque_tasks_.fetch_add(1u, std::memory_order_release);
+  }
+  // If we have any waiters, signal one.
+  if (started_ && waiting_count_ != 0) {
+    task_queue_condition_.Signal(self);
+  }
+}
+
+size_t WorkStealingThreadPool::GetTaskCount(Thread* self) {
+  MutexLock mu(self, task_queue_lock_);
+  return tasks_.size() + pending_deque_tasks_.load(std::memory_order_acquire);
+}
+
+Task* WorkStealingThreadPool::GetTask(Thread* self) {
+  const size_t worker_index = GetWorkerIndex(self);
+  // Fast path: our own deque first, then steal from a victim, all without touching
+  // task_queue_lock_.
+  Task* task = PopLocalTask(worker_index);
+  if (task == nullptr && pending_deque_tasks_.load(std::memory_order_acquire) != 0u) {
+    task = StealTask(worker_index);
+  }
+  if (task != nullptr) {
+    return task;
+  }
+  // Slow path: the shared queue and the blocking wait of the base pool. TryGetTaskLocked is
+  // overridden, so a task parked on some deque also terminates the wait.
+  task = ThreadPool::GetTask(self);
+  if (task != nullptr) {
+    // While we are here anyway, pull a share of the shared queue over to our deque so that the
+    // next dequeues (ours or a thief's) need not take task_queue_lock_.
+    DonateSharedTasks(self, worker_index);
+  }
+  return task;
+}
+
+Task* WorkStealingThreadPool::TryGetTaskLocked() {
+  Task* task = ThreadPool::TryGetTaskLocked();
+  if (task != nullptr || pending_deque_tasks_.load(std::memory_order_acquire) == 0u) {
+    return task;
+  }
+  // The shared queue is empty but tasks are parked on worker deques; take one directly. This
+  // also serves consumers that are not pool workers, e.g. Wait(self, /*do_work=*/ true).
+  for (const std::unique_ptr<WorkerQueue>& queue : queues_) {
+    MutexLock mu(Thread::Current(), queue->lock_);
+    if (!queue->tasks_.empty()) {
+      task = queue->tasks_.front();
+      queue->tasks_.pop_front();
+      pending_deque_tasks_.fetch_sub(1u, std::memory_order_release);
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+bool WorkStealingThreadPool::HasOutstandingTasks() const {
+  // Tasks already distributed to worker deques count as outstanding even when the pool has been
+  // stopped, as the workers will still drain them.
+  return ThreadPool::HasOutstandingTasks() ||
+         pending_deque_tasks_.load(std::memory_order_acquire) != 0u;
+}
+
+size_t WorkStealingThreadPool::GetWorkerIndex(Thread* self) {
+  // Fast path: the worker has registered itself on an earlier dequeue.
+  const size_t num_workers = worker_threads_.size();
+  for (size_t i = 0; i < num_workers; ++i) {
+    if (worker_threads_[i].load(std::memory_order_relaxed) == self) {
+      return i;
+    }
+  }
+  // First dequeue of this worker. It may get here while CreateThreads() is still populating
+  // threads_, so resolve the index under task_queue_lock_, which CreateThreads() holds for
+  // the whole population, and cache it for the lock-free fast path above.
+  MutexLock mu(self, task_queue_lock_);
+  const pthread_t pthread = pthread_self();
+  for (size_t i = 0, size = worker_pthreads_.size(); i < size; ++i) {
+    if (pthread_equal(worker_pthreads_[i], pthread) != 0) {
+      worker_threads_[i].store(self, std::memory_order_relaxed);
+      return i;
+    }
+  }
+  LOG(FATAL) << "Thread " << *self << " is not a worker of pool " << name_;
+  UNREACHABLE();
+}
+
+Task* WorkStealingThreadPool::PopLocalTask(size_t worker_index) {
+  WorkerQueue* queue = queues_[worker_index].get();
+  MutexLock mu(Thread::Current(), queue->lock_);
+  if (queue->tasks_.empty()) {
+    return nullptr;
+  }
+  Task* task = queue->tasks_.front();
+  queue->tasks_.pop_front();
+  pending_deque_tasks_.fetch_sub(1u, std::memory_order_release);
+  return task;
+}
+
+Task* WorkStealingThreadPool::StealTask(size_t worker_index) {
+  Thread* self = Thread::Current();
+  const size_t num_queues = queues_.size();
+  for (size_t i = 1u; i < num_queues; ++i) {
+    WorkerQueue* victim = queues_[(worker_index + i) % num_queues].get();
+    std::vector<Task*> stolen;
+    {
+      MutexLock mu(self, victim->lock_);
+      const size_t size = victim->tasks_.size();
+      if (size == 0u) {
+        continue;
+      }
+      // Take the back half, rounding up so that a single task still gets stolen; the victim
+      // keeps dequeuing its older tasks from the front.
+      const size_t steal_count = (size + 1u) / 2u;
+      stolen.assign(victim->tasks_.end() - steal_count, victim->tasks_.end());
+      victim->tasks_.erase(victim->tasks_.end() - steal_count, victim->tasks_.end());
+    }
+    // Return one stolen task and park the rest on our own deque.
+    Task* task = stolen.front();
+    pending_deque_tasks_.fetch_sub(1u, std::memory_order_release);
+    if (stolen.size() > 1u) {
+      WorkerQueue* queue = queues_[worker_index].get();
+      MutexLock mu(self, queue->lock_);
+      queue->tasks_.insert(queue->tasks_.end(), stolen.begin() + 1, stolen.end());
+    }
+    return task;
+  }
+  return nullptr;
+}
+
+void WorkStealingThreadPool::DonateSharedTasks(Thread* self, size_t worker_index) {
+  MutexLock mu(self, task_queue_lock_);
+  // Only regular tasks are distributed; priority tasks stay at the front of the shared queue so
+  // that they are still picked up before any regular task.
+  const size_t movable = tasks_.size() - num_priority_tasks_;
+  const size_t move_count = std::min(movable, tasks_.size() / 2u);
+  if (move_count == 0u) {
+    return;
+  }
+  WorkerQueue* queue = queues_[worker_index].get();
+  MutexLock queue_mu(self, queue->lock_);
+  auto first = tasks_.begin() + num_priority_tasks_;
+  queue->tasks_.insert(queue->tasks_.end(), first, first + move_count);
+  tasks_.erase(first, first + move_count);
+  pending_deque_tasks_.fetch_add(move_count, std::memory_order_release);
+}
+
 }  // namespace art
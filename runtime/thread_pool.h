@@ -19,9 +19,11 @@
 
 #include <deque>
 #include <functional>
+#include <memory>
 #include <vector>
 
 #include "barrier.h"
+#include "base/atomic.h"
 #include "base/mem_map.h"
 #include "base/mutex.h"
 
@@ -101,6 +103,8 @@ class ThreadPoolWorker {
 
  private:
   friend class ThreadPool;
+  // For access to pthread_ when recording the worker-to-deque mapping.
+  friend class WorkStealingThreadPool;
   DISALLOW_COPY_AND_ASSIGN(ThreadPoolWorker);
 };
 
@@ -124,6 +128,11 @@ class ThreadPool {
   // after running it, it is the caller's responsibility.
   void AddTask(Thread* self, Task* task) REQUIRES(!task_queue_lock_);
 
+  // Add a task that is picked up before all regular tasks, keeping FIFO order among priority
+  // tasks. Used for latency-sensitive work, e.g. baseline JIT compilations which should not
+  // wait behind a backlog of optimizing compilations.
+  void AddPriorityTask(Thread* self, Task* task) REQUIRES(!task_queue_lock_);
+
   // Remove all tasks in the queue.
   void RemoveAllTasks(Thread* self) REQUIRES(!task_queue_lock_);
 
@@ -149,7 +158,7 @@ class ThreadPool {
   // When the pool was created with peers for workers, do_work must not be true (see ThreadPool()).
   void Wait(Thread* self, bool do_work, bool may_hold_locks) REQUIRES(!task_queue_lock_);
 
-  size_t GetTaskCount(Thread* self) REQUIRES(!task_queue_lock_);
+  virtual size_t GetTaskCount(Thread* self) REQUIRES(!task_queue_lock_);
 
   // Returns the total amount of workers waited for tasks.
   uint64_t GetWaitTime() const {
@@ -167,19 +176,24 @@ class ThreadPool {
   void WaitForWorkersToBeCreated();
 
  protected:
+  // Create a new pool worker; subclasses may record extra bookkeeping about it. Called by
+  // CreateThreads() with task_queue_lock_ held, before the worker is appended to threads_.
+  virtual ThreadPoolWorker* CreateThreadPoolWorker(const std::string& name)
+      REQUIRES(task_queue_lock_);
+
   // get a task to run, blocks if there are no tasks left
   virtual Task* GetTask(Thread* self) REQUIRES(!task_queue_lock_);
 
   // Try to get a task, returning null if there is none available.
   Task* TryGetTask(Thread* self) REQUIRES(!task_queue_lock_);
-  Task* TryGetTaskLocked() REQUIRES(task_queue_lock_);
+  virtual Task* TryGetTaskLocked() REQUIRES(task_queue_lock_);
 
   // Are we shutting down?
   bool IsShuttingDown() const REQUIRES(task_queue_lock_) {
     return shutting_down_;
   }
 
-  bool HasOutstandingTasks() const REQUIRES(task_queue_lock_) {
+  virtual bool HasOutstandingTasks() const REQUIRES(task_queue_lock_) {
     return started_ && !tasks_.empty();
   }
 
@@ -192,6 +206,8 @@ class ThreadPool {
   // How many worker threads are waiting on the condition.
   volatile size_t waiting_count_ GUARDED_BY(task_queue_lock_);
   std::deque<Task*> tasks_ GUARDED_BY(task_queue_lock_);
+  // Priority tasks occupy tasks_[0, num_priority_tasks_).
+  size_t num_priority_tasks_ GUARDED_BY(task_queue_lock_);
   std::vector<ThreadPoolWorker*> threads_;
   // Work balance detection.
   uint64_t start_time_ GUARDED_BY(task_queue_lock_);
@@ -203,10 +219,80 @@ class ThreadPool {
 
  private:
   friend class ThreadPoolWorker;
-  friend class WorkStealingWorker;
   DISALLOW_COPY_AND_ASSIGN(ThreadPool);
 };
 
+// A ThreadPool variant for fan-out workloads made of many small tasks, such as the Heap's
+// parallel GC work and the CompilerDriver's per-method tasks. Tasks are still submitted through
+// the shared queue, but workers pull them over in batches onto per-worker deques (each with its
+// own lock) and an idle worker steals half of a victim's deque, so dequeuing stops contending on
+// task_queue_lock_ at high core counts. Tasks queued with an affinity tag go straight to the
+// tag's worker deque, keeping related work on the same thread (and usually the same core) unless
+// it gets stolen. Tasks are not guaranteed to run in strict submission order (the base pool does
+// not guarantee this across workers either), and StopWorkers does not recall tasks that have
+// already been distributed to worker deques; use Wait to drain the pool.
+class WorkStealingThreadPool : public ThreadPool {
+ public:
+  WorkStealingThreadPool(const char* name,
+                         size_t num_threads,
+                         bool create_peers = false,
+                         size_t worker_stack_size = ThreadPoolWorker::kDefaultStackSize);
+  ~WorkStealingThreadPool() override;
+
+  // Add a task routed to the worker deque selected by `affinity_tag`; tasks sharing a tag are
+  // processed by the same worker in FIFO order unless stolen.
+  void AddTaskWithAffinity(Thread* self, Task* task, size_t affinity_tag)
+      REQUIRES(!task_queue_lock_);
+
+  size_t GetTaskCount(Thread* self) override REQUIRES(!task_queue_lock_);
+
+ protected:
+  ThreadPoolWorker* CreateThreadPoolWorker(const std::string& name) override
+      REQUIRES(task_queue_lock_);
+  Task* GetTask(Thread* self) override REQUIRES(!task_queue_lock_);
+  Task* TryGetTaskLocked() override REQUIRES(task_queue_lock_);
+  bool HasOutstandingTasks() const override REQUIRES(task_queue_lock_);
+
+ private:
+  struct WorkerQueue {
+    WorkerQueue() : lock_("work stealing worker queue lock", kWorkStealingQueueLock) {}
+
+    Mutex lock_;
+    std::deque<Task*> tasks_ GUARDED_BY(lock_);
+  };
+
+  // Map a pool worker back to the index of its deque. The first call by each worker resolves
+  // the index under task_queue_lock_ and caches it in worker_threads_; later calls are
+  // lock-free.
+  size_t GetWorkerIndex(Thread* self) REQUIRES(!task_queue_lock_);
+
+  // Pop the front of this worker's own deque.
+  Task* PopLocalTask(size_t worker_index);
+
+  // Steal half of the first non-empty victim deque (rounding up); one stolen task is returned
+  // and the remainder is parked on this worker's deque.
+  Task* StealTask(size_t worker_index);
+
+  // Move a share of the regular (non-priority) tasks of the shared queue onto this worker's
+  // deque, so that subsequent dequeues do not need task_queue_lock_.
+  void DonateSharedTasks(Thread* self, size_t worker_index) REQUIRES(!task_queue_lock_);
+
+  // Number of tasks currently parked on worker deques.
+  Atomic<size_t> pending_deque_tasks_;
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+
+  // Thread of each worker, written once by the worker itself on its first dequeue (see
+  // GetWorkerIndex). Fixed size, so the lock-free fast path never observes a reallocation.
+  std::vector<Atomic<Thread*>> worker_threads_;
+
+  // pthread handle of each worker, recorded at worker creation. Lets a worker resolve its own
+  // index without inspecting other ThreadPoolWorker objects, which may not be fully
+  // constructed yet, or may already be destroyed during shutdown.
+  std::vector<pthread_t> worker_pthreads_ GUARDED_BY(task_queue_lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(WorkStealingThreadPool);
+};
+
 }  // namespace art
 
 #endif  // ART_RUNTIME_THREAD_POOL_H_
@@ -484,6 +484,13 @@ void Trace::StopTracing(bool finish_tracing, bool flush_file) {
             instrumentation::Instrumentation::kMethodExited |
             instrumentation::Instrumentation::kMethodUnwind);
         runtime->GetInstrumentation()->DisableMethodTracing(kTracerInstrumentationKey);
+        if (the_trace->trace_output_mode_ == TraceOutputMode::kStreaming) {
+          // All threads are suspended and no more events will be logged; write
+          // out the records still sitting in per-thread buffers.
+          MutexLock tl_mu(self, *Locks::thread_list_lock_);
+          MutexLock s_mu(self, *the_trace->streaming_lock_);
+          runtime->GetThreadList()->ForEach(ReleaseThreadBufferCallback, the_trace);
+        }
       }
     }
     // At this point, code may read buf_ as it's writers are shutdown
@@ -889,28 +896,6 @@ void Trace::LogMethodTraceEvent(Thread* thread, ArtMethod* method,
   // same pointer value.
   method = method->GetNonObsoleteMethod();
 
-  // Advance cur_offset_ atomically.
-  int32_t new_offset;
-  int32_t old_offset = 0;
-
-  // In the non-streaming case, we do a busy loop here trying to get
-  // an offset to write our record and advance cur_offset_ for the
-  // next use.
-  if (trace_output_mode_ != TraceOutputMode::kStreaming) {
-    // Although multiple threads can call this method concurrently,
-    // the compare_exchange_weak here is still atomic (by definition).
-    // A succeeding update is visible to other cores when they pass
-    // through this point.
-    old_offset = cur_offset_.load(std::memory_order_relaxed);  // Speculative read
-    do {
-      new_offset = old_offset + GetRecordSize(clock_source_);
-      if (static_cast<size_t>(new_offset) > buffer_size_) {
-        overflow_ = true;
-        return;
-      }
-    } while (!cur_offset_.compare_exchange_weak(old_offset, new_offset, std::memory_order_relaxed));
-  }
-
   TraceAction action = kTraceMethodEnter;
   switch (event) {
     case instrumentation::Instrumentation::kMethodEntered:
@@ -926,24 +911,90 @@ void Trace::LogMethodTraceEvent(Thread* thread, ArtMethod* method,
       UNIMPLEMENTED(FATAL) << "Unexpected event: " << event;
   }
 
+  if (trace_output_mode_ == TraceOutputMode::kStreaming) {
+    if (trace_mode_ == TraceMode::kMethodTracing) {
+      // Method tracing events are generated by the thread they describe, so the
+      // record can be buffered thread-locally and the streaming lock is only
+      // needed when a full batch is drained.
+      DCHECK_EQ(thread, Thread::Current());
+      MethodTraceRecord* records =
+          reinterpret_cast<MethodTraceRecord*>(thread->GetMethodTraceBuffer());
+      if (records == nullptr) {
+        records = new MethodTraceRecord[kPerThreadBufferedRecords];
+        thread->SetMethodTraceBuffer(reinterpret_cast<uintptr_t*>(records));
+      }
+      size_t index = thread->GetMethodTraceIndex();
+      records[index] = { method, action, thread_clock_diff, wall_clock_diff };
+      ++index;
+      thread->SetMethodTraceIndex(index);
+      if (index == kPerThreadBufferedRecords) {
+        MutexLock mu(thread, *streaming_lock_);
+        DrainThreadRecords(thread);
+      }
+    } else {
+      // In sampling mode, events for all threads are logged by the sampling
+      // thread, so per-thread buffering does not apply; write them out directly.
+      MutexLock mu(Thread::Current(), *streaming_lock_);
+      WriteStreamingEvent(thread, method, action, thread_clock_diff, wall_clock_diff);
+    }
+    return;
+  }
+
+  // Advance cur_offset_ atomically.
+  int32_t new_offset;
+  int32_t old_offset;
+
+  // In the non-streaming case, we do a busy loop here trying to get
+  // an offset to write our record and advance cur_offset_ for the
+  // next use.
+  // Although multiple threads can call this method concurrently,
+  // the compare_exchange_weak here is still atomic (by definition).
+  // A succeeding update is visible to other cores when they pass
+  // through this point.
+  old_offset = cur_offset_.load(std::memory_order_relaxed);  // Speculative read
+  do {
+    new_offset = old_offset + GetRecordSize(clock_source_);
+    if (static_cast<size_t>(new_offset) > buffer_size_) {
+      overflow_ = true;
+      return;
+    }
+  } while (!cur_offset_.compare_exchange_weak(old_offset, new_offset, std::memory_order_relaxed));
+
   uint32_t method_value = EncodeTraceMethodAndAction(method, action);
 
-  // Write data into the tracing buffer (if not streaming) or into a
-  // small buffer on the stack (if streaming) which we'll put into the
-  // tracing buffer below.
+  // Write data into the tracing buffer.
   //
   // These writes to the tracing buffer are synchronised with the
   // future reads that (only) occur under FinishTracing(). The callers
   // of FinishTracing() acquire locks and (implicitly) synchronise
   // the buffer memory.
-  uint8_t* ptr;
-  static constexpr size_t kPacketSize = 14U;  // The maximum size of data in a packet.
-  uint8_t stack_buf[kPacketSize];             // Space to store a packet when in streaming mode.
-  if (trace_output_mode_ == TraceOutputMode::kStreaming) {
-    ptr = stack_buf;
-  } else {
-    ptr = buf_.get() + old_offset;
+  uint8_t* ptr = buf_.get() + old_offset;
+
+  Append2LE(ptr, thread->GetTid());
+  Append4LE(ptr + 2, method_value);
+  ptr += 6;
+
+  if (UseThreadCpuClock()) {
+    Append4LE(ptr, thread_clock_diff);
+    ptr += 4;
+  }
+  if (UseWallClock()) {
+    Append4LE(ptr, wall_clock_diff);
   }
+}
+
+void Trace::WriteStreamingEvent(Thread* thread,
+                                ArtMethod* method,
+                                TraceAction action,
+                                uint32_t thread_clock_diff,
+                                uint32_t wall_clock_diff) {
+  uint32_t method_value = EncodeTraceMethodAndAction(method, action);
+
+  // Write the record into a small buffer on the stack, which we'll put into the
+  // tracing buffer below.
+  static constexpr size_t kPacketSize = 14U;  // The maximum size of data in a packet.
+  uint8_t stack_buf[kPacketSize];
+  uint8_t* ptr = stack_buf;
 
   Append2LE(ptr, thread->GetTid());
   Append4LE(ptr + 2, method_value);
@@ -958,32 +1009,78 @@ void Trace::LogMethodTraceEvent(Thread* thread, ArtMethod* method,
   }
   static_assert(kPacketSize == 2 + 4 + 4 + 4, "Packet size incorrect.");
 
-  if (trace_output_mode_ == TraceOutputMode::kStreaming) {
-    MutexLock mu(Thread::Current(), *streaming_lock_);  // To serialize writing.
-    if (RegisterMethod(method)) {
-      // Write a special block with the name.
-      std::string method_line(GetMethodLine(method));
-      uint8_t buf2[5];
-      Append2LE(buf2, 0);
-      buf2[2] = kOpNewMethod;
-      Append2LE(buf2 + 3, static_cast<uint16_t>(method_line.length()));
-      WriteToBuf(buf2, sizeof(buf2));
-      WriteToBuf(reinterpret_cast<const uint8_t*>(method_line.c_str()), method_line.length());
-    }
-    if (RegisterThread(thread)) {
-      // It might be better to postpone this. Threads might not have received names...
-      std::string thread_name;
-      thread->GetThreadName(thread_name);
-      uint8_t buf2[7];
-      Append2LE(buf2, 0);
-      buf2[2] = kOpNewThread;
-      Append2LE(buf2 + 3, static_cast<uint16_t>(thread->GetTid()));
-      Append2LE(buf2 + 5, static_cast<uint16_t>(thread_name.length()));
-      WriteToBuf(buf2, sizeof(buf2));
-      WriteToBuf(reinterpret_cast<const uint8_t*>(thread_name.c_str()), thread_name.length());
-    }
-    WriteToBuf(stack_buf, sizeof(stack_buf));
+  if (RegisterMethod(method)) {
+    // Write a special block with the name.
+    std::string method_line(GetMethodLine(method));
+    uint8_t buf2[5];
+    Append2LE(buf2, 0);
+    buf2[2] = kOpNewMethod;
+    Append2LE(buf2 + 3, static_cast<uint16_t>(method_line.length()));
+    WriteToBuf(buf2, sizeof(buf2));
+    WriteToBuf(reinterpret_cast<const uint8_t*>(method_line.c_str()), method_line.length());
+  }
+  if (RegisterThread(thread)) {
+    // It might be better to postpone this. Threads might not have received names...
+    std::string thread_name;
+    thread->GetThreadName(thread_name);
+    uint8_t buf2[7];
+    Append2LE(buf2, 0);
+    buf2[2] = kOpNewThread;
+    Append2LE(buf2 + 3, static_cast<uint16_t>(thread->GetTid()));
+    Append2LE(buf2 + 5, static_cast<uint16_t>(thread_name.length()));
+    WriteToBuf(buf2, sizeof(buf2));
+    WriteToBuf(reinterpret_cast<const uint8_t*>(thread_name.c_str()), thread_name.length());
+  }
+  WriteToBuf(stack_buf, sizeof(stack_buf));
+}
+
+void Trace::DrainThreadRecords(Thread* thread) {
+  MethodTraceRecord* records =
+      reinterpret_cast<MethodTraceRecord*>(thread->GetMethodTraceBuffer());
+  DCHECK(records != nullptr);
+  size_t count = thread->GetMethodTraceIndex();
+  for (size_t i = 0; i != count; ++i) {
+    WriteStreamingEvent(thread,
+                        records[i].method,
+                        records[i].action,
+                        records[i].thread_clock_diff,
+                        records[i].wall_clock_diff);
+  }
+  thread->SetMethodTraceIndex(0);
+}
+
+void Trace::ReleaseThreadBuffer(Thread* thread) {
+  uintptr_t* buffer = thread->GetMethodTraceBuffer();
+  if (buffer == nullptr) {
+    return;
+  }
+  DrainThreadRecords(thread);
+  delete[] reinterpret_cast<MethodTraceRecord*>(buffer);
+  thread->SetMethodTraceBuffer(nullptr);
+}
+
+void Trace::ReleaseThreadBufferCallback(Thread* thread, void* arg) {
+  reinterpret_cast<Trace*>(arg)->ReleaseThreadBuffer(thread);
+}
+
+void Trace::FlushThreadBuffer(Thread* self) {
+  DCHECK_EQ(self, Thread::Current());
+  uintptr_t* buffer = self->GetMethodTraceBuffer();
+  if (buffer == nullptr) {
+    return;
+  }
+  MutexLock mu(self, *Locks::trace_lock_);
+  if (the_trace_ != nullptr) {
+    MutexLock smu(self, *the_trace_->streaming_lock_);
+    the_trace_->DrainThreadRecords(self);
   }
+  // If the trace has been stopped concurrently, StopTracing has either already
+  // written the buffered records out or they are dropped together with the rest
+  // of the unflushed data; either way the buffer is no longer needed. The
+  // exclusive mutator lock held while StopTracing drains the buffers orders its
+  // accesses with ours.
+  delete[] reinterpret_cast<MethodTraceRecord*>(buffer);
+  self->SetMethodTraceBuffer(nullptr);
 }
 
 void Trace::GetVisitedMethods(size_t buf_size,
@@ -233,6 +233,15 @@ class Trace final : public instrumentation::InstrumentationListener {
   // Save id and name of a thread before it exits.
   static void StoreExitingThreadInfo(Thread* thread);
 
+  // Write out and release the calling thread's buffered trace records, if any.
+  // Called on thread exit, before the thread is removed from the thread list.
+  // NO_THREAD_SAFETY_ANALYSIS for the same reason as StopTracing: the analysis
+  // cannot see that the locks of the trace instance read under trace_lock_ are
+  // not already held.
+  static void FlushThreadBuffer(Thread* self)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!Locks::trace_lock_) NO_THREAD_SAFETY_ANALYSIS;
+
   static TraceOutputMode GetOutputMode() REQUIRES(!Locks::trace_lock_);
   static TraceMode GetMode() REQUIRES(!Locks::trace_lock_);
   static size_t GetBufferSize() REQUIRES(!Locks::trace_lock_);
@@ -267,6 +276,45 @@ class Trace final : public instrumentation::InstrumentationListener {
                            uint32_t thread_clock_diff, uint32_t wall_clock_diff)
       REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!unique_methods_lock_, !streaming_lock_);
 
+  // A trace event held in a per-thread buffer in streaming mode until the buffer
+  // is drained, at which point it is encoded and written to the trace.
+  struct MethodTraceRecord {
+    ArtMethod* method;
+    TraceAction action;
+    uint32_t thread_clock_diff;
+    uint32_t wall_clock_diff;
+  };
+
+  // Number of records in each per-thread buffer. Threads only take streaming_lock_
+  // once their buffer fills up, so this bounds the lock acquisitions (and the
+  // cache-line contention on the shared buffer) to one per this many events.
+  static constexpr size_t kPerThreadBufferedRecords = 512;
+
+  // Encode a single trace event and write it to the trace buffer, together with
+  // the method and thread name blocks it needs. Used directly in sampling mode,
+  // where events for all threads are logged by the sampling thread, and when
+  // draining a per-thread buffer in method tracing mode.
+  void WriteStreamingEvent(Thread* thread,
+                           ArtMethod* method,
+                           TraceAction action,
+                           uint32_t thread_clock_diff,
+                           uint32_t wall_clock_diff)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(streaming_lock_) REQUIRES(!unique_methods_lock_);
+
+  // Write out all records buffered by `thread` and reset its buffer index.
+  void DrainThreadRecords(Thread* thread)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(streaming_lock_) REQUIRES(!unique_methods_lock_);
+
+  // Drain `thread`'s buffered records and free the buffer. Used when the trace
+  // stops, for every thread still registered.
+  void ReleaseThreadBuffer(Thread* thread)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(streaming_lock_) REQUIRES(!unique_methods_lock_);
+  static void ReleaseThreadBufferCallback(Thread* thread, void* arg)
+      REQUIRES_SHARED(Locks::mutator_lock_) NO_THREAD_SAFETY_ANALYSIS;
+
   // Methods to output traced methods and threads.
   void GetVisitedMethods(size_t end_offset, std::set<ArtMethod*>* visited_methods)
       REQUIRES(!unique_methods_lock_);
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_TYPE_CHECK_CACHE_H_
+#define ART_RUNTIME_TYPE_CHECK_CACHE_H_
+
+#include <array>
+
+#include "base/bit_utils.h"
+#include "base/macros.h"
+
+namespace art {
+
+namespace mirror {
+class Class;
+}  // namespace mirror
+
+// Small thread-local cache memoizing non-trivial assignability checks.
+//
+// Compiled code only calls into the runtime once the inline fast paths
+// (null check, exact match, single-level super class check, ...) have
+// failed, so every call to the slow path pays for a super class chain or
+// interface table walk. Megamorphic `instanceof`/`check-cast` sites
+// against non-final classes take the slow path repeatedly for a small
+// set of (source, target) pairs; caching the last seen pairs turns those
+// walks into three loads and two compares.
+//
+// Entries hold raw class pointers and are treated as system weaks: the
+// GC updates or evicts them in Thread::SweepTypeCheckCache. All other
+// operations must be done from the owning thread, or at a point when the
+// owning thread is suspended.
+class TypeCheckCache {
+ public:
+  struct Entry {
+    mirror::Class* source;
+    mirror::Class* target;
+    size_t result;
+  };
+
+  static constexpr size_t kSize = 16;
+
+  TypeCheckCache() {
+    data_.fill(Entry{});
+  }
+
+  void Clear() {
+    data_.fill(Entry{});
+  }
+
+  // Returns true and sets `*result` if the cache knows whether `source` is
+  // assignable to `target`. A hit keyed on identical pointers is valid even
+  // while a moving GC is running: stale from-space entries can not compare
+  // equal to the to-space references the mutator holds, and the memory of
+  // dead classes is not reused before the sweep has cleared the entry.
+  ALWAYS_INLINE bool Get(mirror::Class* source, mirror::Class* target, /*out*/ size_t* result) {
+    Entry& entry = data_[IndexOf(source, target)];
+    if (LIKELY(entry.source == source && entry.target == target)) {
+      *result = entry.result;
+      return true;
+    }
+    return false;
+  }
+
+  ALWAYS_INLINE void Set(mirror::Class* source, mirror::Class* target, size_t result) {
+    data_[IndexOf(source, target)] = Entry{source, target, result};
+  }
+
+  std::array<Entry, kSize>& GetArray() {
+    return data_;
+  }
+
+ private:
+  static ALWAYS_INLINE size_t IndexOf(mirror::Class* source, mirror::Class* target) {
+    static_assert(IsPowerOfTwo(kSize), "Size must be power of two");
+    size_t index = ((reinterpret_cast<uintptr_t>(source) >> 3) ^
+                    (reinterpret_cast<uintptr_t>(target) >> 3)) & (kSize - 1);
+    DCHECK_LT(index, kSize);
+    return index;
+  }
+
+  std::array<Entry, kSize> data_;
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_TYPE_CHECK_CACHE_H_
@@ -97,7 +97,7 @@ inline size_t DexCacheArraysLayout::MethodOffset(uint32_t method_idx) const {
 }
 
 inline size_t DexCacheArraysLayout::MethodsSize(size_t num_elements) const {
-  size_t cache_size = mirror::DexCache::kDexCacheMethodCacheSize;
+  size_t cache_size = mirror::DexCache::MethodCacheSize(num_elements);
   if (num_elements < cache_size) {
     cache_size = num_elements;
   }
@@ -133,7 +133,7 @@ inline size_t DexCacheArraysLayout::FieldOffset(uint32_t field_idx) const {
 }
 
 inline size_t DexCacheArraysLayout::FieldsSize(size_t num_elements) const {
-  size_t cache_size = mirror::DexCache::kDexCacheFieldCacheSize;
+  size_t cache_size = mirror::DexCache::FieldCacheSize(num_elements);
   if (num_elements < cache_size) {
     cache_size = num_elements;
   }
@@ -20,6 +20,7 @@
 #include <sys/stat.h>  // for mkdir()
 
 #include <memory>
+#include <optional>
 #include <unordered_set>
 
 #include <android-base/logging.h>
@@ -39,6 +40,7 @@
 #include "gc/space/image_space.h"
 #include "quicken_info.h"
 #include "runtime.h"
+#include "thread_pool.h"
 #include "verifier/verifier_deps.h"
 
 namespace art {
@@ -180,7 +182,7 @@ std::unique_ptr<VdexFile> VdexFile::OpenAtAddress(uint8_t* mmap_addr,
     return nullptr;
   }
 
-  if (unquicken && vdex->HasDexSection()) {
+  if (unquicken && vdex->HasDexSection() && !vdex->GetQuickeningInfo().empty()) {
     std::vector<std::unique_ptr<const DexFile>> unique_ptr_dex_files;
     if (!vdex->OpenAllDexFiles(&unique_ptr_dex_files, error_msg)) {
       return nullptr;
@@ -254,7 +256,7 @@ bool VdexFile::OpenAllDexFiles(std::vector<std::unique_ptr<const DexFile>>* dex_
 void VdexFile::UnquickenInPlace(bool decompile_return_instruction) const {
   CHECK_NE(mmap_.GetProtect() & PROT_WRITE, 0)
       << "File not mapped writable. Cannot unquicken! " << mmap_;
-  if (HasDexSection()) {
+  if (HasDexSection() && !GetQuickeningInfo().empty()) {
     std::vector<std::unique_ptr<const DexFile>> unique_ptr_dex_files;
     std::string error_msg;
     if (!OpenAllDexFiles(&unique_ptr_dex_files, &error_msg)) {
@@ -270,12 +272,33 @@ void VdexFile::UnquickenInPlace(bool decompile_return_instruction) const {
 
 void VdexFile::Unquicken(const std::vector<const DexFile*>& target_dex_files,
                          bool decompile_return_instruction) const {
+  // The dex files are decompiled independently of each other, so spread them
+  // over the runtime thread pool if one is available. This matters on the
+  // debugger-attach path where Runtime::DeoptimizeBootImage() de-quickens all
+  // loaded vdex files synchronously before the app can resume.
+  Thread* const self = Thread::Current();
+  ThreadPool* pool = nullptr;
+  std::optional<Runtime::ScopedThreadPoolUsage> stpu;
+  if (Runtime::Current() != nullptr && target_dex_files.size() >= 2u) {
+    stpu.emplace();
+    pool = stpu->GetThreadPool();
+  }
   const uint8_t* source_dex = GetNextDexFileData(nullptr);
   for (const DexFile* target_dex : target_dex_files) {
-    UnquickenDexFile(*target_dex, source_dex, decompile_return_instruction);
+    auto function = [this, target_dex, source_dex, decompile_return_instruction](Thread*) {
+      UnquickenDexFile(*target_dex, source_dex, decompile_return_instruction);
+    };
+    if (pool != nullptr) {
+      pool->AddTask(self, new FunctionTask(std::move(function)));
+    } else {
+      function(self);
+    }
     source_dex = GetNextDexFileData(source_dex);
   }
   DCHECK(source_dex == nullptr);
+  if (pool != nullptr) {
+    pool->Wait(self, /*do_work=*/ true, /*may_hold_locks=*/ false);
+  }
 }
 
 uint32_t VdexFile::GetQuickeningInfoTableOffset(const uint8_t* source_dex_begin) const {
@@ -327,18 +350,23 @@ void VdexFile::UnquickenDexFile(const DexFile& target_dex_file,
                                                                   quickening_info));
   for (ClassAccessor class_accessor : target_dex_file.GetClasses()) {
     for (const ClassAccessor::Method& method : class_accessor.GetMethods()) {
+      // Consult the quickening info table before looking at the code item. Offset
+      // being 0 means not quickened, and in that case the code item must not be
+      // touched at all: this keeps the dex pages of methods without quickened
+      // code clean so they are only faulted in when actually executed, instead
+      // of paying a sequential read of the whole dex section here.
+      const uint32_t offset = accessor.GetOffset(method.GetIndex());
+      if (offset == 0u) {
+        continue;
+      }
       const dex::CodeItem* code_item = method.GetCodeItem();
       if (code_item != nullptr && unquickened_code_item.emplace(code_item).second) {
-        const uint32_t offset = accessor.GetOffset(method.GetIndex());
-        // Offset being 0 means not quickened.
-        if (offset != 0u) {
-          ArrayRef<const uint8_t> quicken_data = GetQuickeningInfoAt(quickening_info, offset);
-          optimizer::ArtDecompileDEX(
-              target_dex_file,
-              *code_item,
-              quicken_data,
-              decompile_return_instruction);
-        }
+        ArrayRef<const uint8_t> quicken_data = GetQuickeningInfoAt(quickening_info, offset);
+        optimizer::ArtDecompileDEX(
+            target_dex_file,
+            *code_item,
+            quicken_data,
+            decompile_return_instruction);
       }
     }
   }
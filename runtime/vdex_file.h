@@ -316,6 +316,8 @@ class VdexFile {
   // decompiled to RETURN_VOID instructions using the slower ClassAccessor instead of the faster
   // QuickeningInfoIterator.
   // Always unquickens using the vdex dex files as the source for quicken tables.
+  // Individual dex files are decompiled in parallel on the runtime thread pool
+  // when one is available.
   void Unquicken(const std::vector<const DexFile*>& target_dex_files,
                  bool decompile_return_instruction) const;
 
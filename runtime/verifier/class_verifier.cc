@@ -16,6 +16,10 @@
 
 #include "class_verifier.h"
 
+#include <unistd.h>
+
+#include <algorithm>
+
 #include <android-base/logging.h>
 #include <android-base/stringprintf.h>
 
@@ -23,6 +27,7 @@
 #include "base/enums.h"
 #include "base/locks.h"
 #include "base/logging.h"
+#include "base/scoped_arena_allocator.h"
 #include "base/systrace.h"
 #include "base/utils.h"
 #include "class_linker.h"
@@ -33,13 +38,17 @@
 #include "dex/dex_file-inl.h"
 #include "handle.h"
 #include "handle_scope-inl.h"
+#include "jni/java_vm_ext.h"
 #include "method_verifier-inl.h"
 #include "mirror/class-inl.h"
 #include "mirror/dex_cache.h"
 #include "runtime.h"
+#include "scoped_thread_state_change-inl.h"
 #include "thread.h"
+#include "thread_pool.h"
 #include "verifier/method_verifier.h"
 #include "verifier/reg_type_cache.h"
+#include "verifier/verification_cache.h"
 
 namespace art {
 namespace verifier {
@@ -64,6 +73,137 @@ class StandardVerifyCallback : public VerifierCallback {
   }
 };
 
+// Minimum number of methods in a class before verification is fanned out to a thread pool.
+// Parallel verification only pays off for unusually large (typically generated) classes; for
+// ordinary classes the thread pool costs more than it saves.
+static constexpr size_t kMinMethodsForParallelVerification = 1024u;
+// Cap on the number of worker threads used for parallel method verification.
+static constexpr size_t kMaxParallelVerificationThreads = 4u;
+
+// Pre-resolved per-method verification work item, see ClassVerifier::VerifyClass.
+struct MethodVerificationJob {
+  uint32_t method_idx;
+  const dex::CodeItem* code_item;
+  uint32_t access_flags;
+  ArtMethod* resolved_method;
+};
+
+// Merge a per-method verification result into the accumulated class result, appending to the
+// class failure message for hard failures.
+static void MergeMethodVerificationResult(const DexFile* dex_file,
+                                          const dex::ClassDef& class_def,
+                                          const MethodVerifier::FailureData& result,
+                                          const std::string& hard_failure_msg,
+                                          MethodVerifier::FailureData* failure_data,
+                                          std::string* error) {
+  if (result.kind == FailureKind::kHardFailure) {
+    if (failure_data->kind == FailureKind::kHardFailure) {
+      // If we logged an error before, we need a newline.
+      *error += "\n";
+    } else {
+      // If we didn't log a hard failure before, print the header of the message.
+      *error += "Verifier rejected class ";
+      *error += PrettyDescriptor(dex_file->GetClassDescriptor(class_def));
+      *error += ":";
+    }
+    *error += " ";
+    *error += hard_failure_msg;
+  }
+  failure_data->Merge(result);
+}
+
+// State shared by the method verification tasks of one class.
+struct ParallelVerificationState {
+  ParallelVerificationState(const DexFile* dex_file,
+                            const dex::ClassDef* class_def,
+                            jobject dex_cache,
+                            jobject class_loader,
+                            CompilerCallbacks* callbacks,
+                            VerifierCallback* verifier_callback,
+                            bool allow_soft_failures,
+                            HardFailLogMode log_level,
+                            uint32_t api_level,
+                            std::string* error)
+      : lock("Parallel method verification lock"),
+        dex_file(dex_file),
+        class_def(class_def),
+        dex_cache(dex_cache),
+        class_loader(class_loader),
+        callbacks(callbacks),
+        verifier_callback(verifier_callback),
+        allow_soft_failures(allow_soft_failures),
+        log_level(log_level),
+        api_level(api_level),
+        error(error) {}
+
+  void MergeResult(Thread* self,
+                   const MethodVerifier::FailureData& result,
+                   const std::string& hard_failure_msg) REQUIRES(!lock) {
+    MutexLock mu(self, lock);
+    MergeMethodVerificationResult(dex_file, *class_def, result, hard_failure_msg,
+                                  &failure_data, error);
+  }
+
+  Mutex lock;
+  const DexFile* const dex_file;
+  const dex::ClassDef* const class_def;
+  const jobject dex_cache;
+  const jobject class_loader;
+  CompilerCallbacks* const callbacks;
+  VerifierCallback* const verifier_callback;
+  const bool allow_soft_failures;
+  const HardFailLogMode log_level;
+  const uint32_t api_level;
+  MethodVerifier::FailureData failure_data GUARDED_BY(lock);
+  std::string* const error GUARDED_BY(lock);
+};
+
+class VerifyMethodTask final : public Task {
+ public:
+  VerifyMethodTask(ParallelVerificationState* state, const MethodVerificationJob& job)
+      : state_(state), job_(job) {}
+
+  void Run(Thread* self) override {
+    ScopedObjectAccess soa(self);
+    StackHandleScope<2> hs(self);
+    Handle<mirror::DexCache> dex_cache(
+        hs.NewHandle(soa.Decode<mirror::DexCache>(state_->dex_cache)));
+    Handle<mirror::ClassLoader> class_loader(
+        hs.NewHandle(soa.Decode<mirror::ClassLoader>(state_->class_loader)));
+    std::string hard_failure_msg;
+    MethodVerifier::FailureData result =
+        MethodVerifier::VerifyMethod(self,
+                                     Runtime::Current()->GetClassLinker(),
+                                     Runtime::Current()->GetArenaPool(),
+                                     /* shared_arena_stack= */ nullptr,
+                                     job_.method_idx,
+                                     state_->dex_file,
+                                     dex_cache,
+                                     class_loader,
+                                     *state_->class_def,
+                                     job_.code_item,
+                                     job_.resolved_method,
+                                     job_.access_flags,
+                                     state_->callbacks,
+                                     state_->verifier_callback,
+                                     state_->allow_soft_failures,
+                                     state_->log_level,
+                                     /*need_precise_constants=*/ false,
+                                     state_->api_level,
+                                     Runtime::Current()->IsAotCompiler(),
+                                     &hard_failure_msg);
+    state_->MergeResult(self, result, hard_failure_msg);
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  ParallelVerificationState* const state_;
+  const MethodVerificationJob job_;
+};
+
 FailureKind ClassVerifier::ReverifyClass(Thread* self,
                                          ObjPtr<mirror::Class> klass,
                                          HardFailLogMode log_level,
@@ -76,14 +216,19 @@ FailureKind ClassVerifier::ReverifyClass(Thread* self,
   // will wait until we can update them while everything is suspended.
   class DelayedVerifyCallback : public VerifierCallback {
    public:
+    DelayedVerifyCallback() : lock_("DelayedVerifyCallback lock") {}
+    // The callback may be invoked concurrently when method verification runs on a thread pool.
     void SetDontCompile(ArtMethod* m, bool value) override REQUIRES_SHARED(Locks::mutator_lock_) {
+      MutexLock mu(Thread::Current(), lock_);
       dont_compiles_.push_back({ m, value });
     }
     void SetMustCountLocks(ArtMethod* m, bool value) override
         REQUIRES_SHARED(Locks::mutator_lock_) {
+      MutexLock mu(Thread::Current(), lock_);
       count_locks_.push_back({ m, value });
     }
     void UpdateFlags(bool skip_access_checks) REQUIRES(Locks::mutator_lock_) {
+      MutexLock mu(Thread::Current(), lock_);
       for (auto it : count_locks_) {
         VLOG(verifier_debug) << "Setting " << it.first->PrettyMethod() << " count locks to "
                              << it.second;
@@ -108,8 +253,9 @@ FailureKind ClassVerifier::ReverifyClass(Thread* self,
     }
 
    private:
-    std::vector<std::pair<ArtMethod*, bool>> dont_compiles_;
-    std::vector<std::pair<ArtMethod*, bool>> count_locks_;
+    Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
+    std::vector<std::pair<ArtMethod*, bool>> dont_compiles_ GUARDED_BY(lock_);
+    std::vector<std::pair<ArtMethod*, bool>> count_locks_ GUARDED_BY(lock_);
   };
   DelayedVerifyCallback dvc;
   FailureKind res = CommonVerifyClass(self,
@@ -137,15 +283,33 @@ FailureKind ClassVerifier::VerifyClass(Thread* self,
   if (klass->IsVerified()) {
     return FailureKind::kNoFailure;
   }
+  // Consult the persistent verification cache, if one is configured. A hit means this exact
+  // class (same dex checksum and class def index) verified with no failures in a previous run,
+  // so method verification can be skipped just like for classes preverified in a vdex file.
+  // The cache is only used at runtime where there are no compiler callbacks to feed.
+  Runtime* const runtime = Runtime::Current();
+  VerificationCache* const verification_cache = runtime->GetVerificationCache();
+  const bool use_verification_cache =
+      verification_cache != nullptr && callbacks == nullptr && klass->GetClassDef() != nullptr;
+  if (use_verification_cache &&
+      verification_cache->IsVerified(klass->GetDexFile().GetLocationChecksum(),
+                                     klass->GetDexClassDefIndex())) {
+    return FailureKind::kNoFailure;
+  }
   StandardVerifyCallback svc;
-  return CommonVerifyClass(self,
-                           klass,
-                           callbacks,
-                           &svc,
-                           allow_soft_failures,
-                           log_level,
-                           api_level,
-                           error);
+  FailureKind result = CommonVerifyClass(self,
+                                         klass,
+                                         callbacks,
+                                         &svc,
+                                         allow_soft_failures,
+                                         log_level,
+                                         api_level,
+                                         error);
+  if (use_verification_cache && result == FailureKind::kNoFailure) {
+    verification_cache->Add(klass->GetDexFile().GetLocationChecksum(),
+                            klass->GetDexClassDefIndex());
+  }
+  return result;
 }
 
 FailureKind ClassVerifier::CommonVerifyClass(Thread* self,
@@ -245,8 +409,13 @@ FailureKind ClassVerifier::VerifyClass(Thread* self,
 
   int64_t previous_method_idx[2] = { -1, -1 };
   MethodVerifier::FailureData failure_data;
-  ClassLinker* const linker = Runtime::Current()->GetClassLinker();
+  Runtime* const runtime = Runtime::Current();
+  ClassLinker* const linker = runtime->GetClassLinker();
 
+  // Collect and resolve the methods to verify up front, skipping duplicate method indexes the
+  // same way in the sequential and parallel paths. Resolution touches class linker locks and is
+  // cheap compared to verification, so it stays sequential.
+  std::vector<MethodVerificationJob> jobs;
   for (const ClassAccessor::Method& method : accessor.GetMethods()) {
     int64_t* previous_idx = &previous_method_idx[method.IsStaticOrDirect() ? 0u : 1u];
     self->AllowThreadSuspension();
@@ -267,41 +436,84 @@ FailureKind ClassVerifier::VerifyClass(Thread* self,
     } else {
       DCHECK(resolved_method->GetDeclaringClassUnchecked() != nullptr) << type;
     }
-    std::string hard_failure_msg;
-    MethodVerifier::FailureData result =
-        MethodVerifier::VerifyMethod(self,
-                                     linker,
-                                     Runtime::Current()->GetArenaPool(),
-                                     method_idx,
-                                     dex_file,
-                                     dex_cache,
-                                     class_loader,
-                                     class_def,
-                                     method.GetCodeItem(),
-                                     resolved_method,
-                                     method.GetAccessFlags(),
-                                     callbacks,
-                                     verifier_callback,
-                                     allow_soft_failures,
-                                     log_level,
-                                     /*need_precise_constants=*/ false,
-                                     api_level,
-                                     Runtime::Current()->IsAotCompiler(),
-                                     &hard_failure_msg);
-    if (result.kind == FailureKind::kHardFailure) {
-      if (failure_data.kind == FailureKind::kHardFailure) {
-        // If we logged an error before, we need a newline.
-        *error += "\n";
-      } else {
-        // If we didn't log a hard failure before, print the header of the message.
-        *error += "Verifier rejected class ";
-        *error += PrettyDescriptor(dex_file->GetClassDescriptor(class_def));
-        *error += ":";
-      }
-      *error += " ";
-      *error += hard_failure_msg;
+    jobs.push_back(
+        { method_idx, method.GetCodeItem(), method.GetAccessFlags(), resolved_method });
+  }
+
+  if (jobs.size() >= kMinMethodsForParallelVerification && !runtime->IsAotCompiler()) {
+    // Fan the methods out to a thread pool. Each method is verified with its own MethodVerifier
+    // (and thus its own RegTypeCache arena), so the only shared state is the merged result.
+    // This only triggers for unusually large classes; dex2oat keeps its own parallelism across
+    // classes instead.
+    JavaVMExt* const vm = runtime->GetJavaVM();
+    jobject dex_cache_ref = vm->AddGlobalRef(self, dex_cache.Get());
+    jobject class_loader_ref = vm->AddGlobalRef(self, class_loader.Get());
+    ParallelVerificationState state(dex_file,
+                                    &class_def,
+                                    dex_cache_ref,
+                                    class_loader_ref,
+                                    callbacks,
+                                    verifier_callback,
+                                    allow_soft_failures,
+                                    log_level,
+                                    api_level,
+                                    error);
+    const size_t thread_count =
+        std::min(kMaxParallelVerificationThreads,
+                 static_cast<size_t>(std::max(1L, sysconf(_SC_NPROCESSORS_CONF) - 1L)));
+    ThreadPool pool("Method verification pool", thread_count);
+    for (const MethodVerificationJob& job : jobs) {
+      pool.AddTask(self, new VerifyMethodTask(&state, job));
+    }
+    pool.StartWorkers(self);
+    {
+      // Release the mutator lock while waiting so that the GC can still suspend everything,
+      // including the workers at their suspension points.
+      ScopedThreadSuspension sts(self, kNative);
+      pool.Wait(self, true, true);
+    }
+    vm->DeleteGlobalRef(self, dex_cache_ref);
+    vm->DeleteGlobalRef(self, class_loader_ref);
+    {
+      MutexLock mu(self, state.lock);
+      failure_data.Merge(state.failure_data);
+    }
+  } else {
+    // Share one arena stack across all the methods of the class. Each MethodVerifier still gets
+    // its own ScopedArenaAllocator frame (popped when the verifier dies), but the underlying
+    // arenas stay checked out from the pool instead of being released and re-acquired per method.
+    ArenaStack arena_stack(runtime->GetArenaPool());
+    for (const MethodVerificationJob& job : jobs) {
+      self->AllowThreadSuspension();
+      std::string hard_failure_msg;
+      MethodVerifier::FailureData result =
+          MethodVerifier::VerifyMethod(self,
+                                       linker,
+                                       runtime->GetArenaPool(),
+                                       &arena_stack,
+                                       job.method_idx,
+                                       dex_file,
+                                       dex_cache,
+                                       class_loader,
+                                       class_def,
+                                       job.code_item,
+                                       job.resolved_method,
+                                       job.access_flags,
+                                       callbacks,
+                                       verifier_callback,
+                                       allow_soft_failures,
+                                       log_level,
+                                       /*need_precise_constants=*/ false,
+                                       api_level,
+                                       runtime->IsAotCompiler(),
+                                       &hard_failure_msg);
+      MergeMethodVerificationResult(dex_file,
+                                    class_def,
+                                    result,
+                                    hard_failure_msg,
+                                    &failure_data,
+                                    error);
     }
-    failure_data.Merge(result);
   }
 
   if (failure_data.kind == FailureKind::kNoFailure) {
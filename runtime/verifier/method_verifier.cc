@@ -153,6 +153,7 @@ class MethodVerifier final : public ::art::verifier::MethodVerifier {
   MethodVerifier(Thread* self,
                  ClassLinker* class_linker,
                  ArenaPool* arena_pool,
+                 ArenaStack* shared_arena_stack,
                  const DexFile* dex_file,
                  const dex::CodeItem* code_item,
                  uint32_t method_idx,
@@ -172,6 +173,7 @@ class MethodVerifier final : public ::art::verifier::MethodVerifier {
      : art::verifier::MethodVerifier(self,
                                      class_linker,
                                      arena_pool,
+                                     shared_arena_stack,
                                      dex_file,
                                      code_item,
                                      method_idx,
@@ -5063,6 +5065,7 @@ const RegType& MethodVerifier<kVerifierDebug>::DetermineCat1Constant(int32_t val
 MethodVerifier::MethodVerifier(Thread* self,
                                ClassLinker* class_linker,
                                ArenaPool* arena_pool,
+                               ArenaStack* shared_arena_stack,
                                const DexFile* dex_file,
                                const dex::CodeItem* code_item,
                                uint32_t dex_method_idx,
@@ -5072,7 +5075,7 @@ MethodVerifier::MethodVerifier(Thread* self,
                                bool aot_mode)
     : self_(self),
       arena_stack_(arena_pool),
-      allocator_(&arena_stack_),
+      allocator_(shared_arena_stack != nullptr ? shared_arena_stack : &arena_stack_),
       reg_types_(class_linker, can_load_classes, allocator_, allow_thread_suspension),
       reg_table_(allocator_),
       work_insn_idx_(dex::kDexNoIndex),
@@ -5098,6 +5101,7 @@ MethodVerifier::~MethodVerifier() {
 MethodVerifier::FailureData MethodVerifier::VerifyMethod(Thread* self,
                                                          ClassLinker* class_linker,
                                                          ArenaPool* arena_pool,
+                                                         ArenaStack* shared_arena_stack,
                                                          uint32_t method_idx,
                                                          const DexFile* dex_file,
                                                          Handle<mirror::DexCache> dex_cache,
@@ -5118,6 +5122,7 @@ MethodVerifier::FailureData MethodVerifier::VerifyMethod(Thread* self,
     return VerifyMethod<true>(self,
                               class_linker,
                               arena_pool,
+                              shared_arena_stack,
                               method_idx,
                               dex_file,
                               dex_cache,
@@ -5138,6 +5143,7 @@ MethodVerifier::FailureData MethodVerifier::VerifyMethod(Thread* self,
     return VerifyMethod<false>(self,
                                class_linker,
                                arena_pool,
+                               shared_arena_stack,
                                method_idx,
                                dex_file,
                                dex_cache,
@@ -5174,6 +5180,7 @@ template <bool kVerifierDebug>
 MethodVerifier::FailureData MethodVerifier::VerifyMethod(Thread* self,
                                                          ClassLinker* class_linker,
                                                          ArenaPool* arena_pool,
+                                                         ArenaStack* shared_arena_stack,
                                                          uint32_t method_idx,
                                                          const DexFile* dex_file,
                                                          Handle<mirror::DexCache> dex_cache,
@@ -5196,6 +5203,7 @@ MethodVerifier::FailureData MethodVerifier::VerifyMethod(Thread* self,
   impl::MethodVerifier<kVerifierDebug> verifier(self,
                                                 class_linker,
                                                 arena_pool,
+                                                shared_arena_stack,
                                                 dex_file,
                                                 code_item,
                                                 method_idx,
@@ -5351,6 +5359,7 @@ MethodVerifier* MethodVerifier::CalculateVerificationInfo(
       new impl::MethodVerifier<false>(self,
                                       Runtime::Current()->GetClassLinker(),
                                       Runtime::Current()->GetArenaPool(),
+                                      /* shared_arena_stack= */ nullptr,
                                       method->GetDexFile(),
                                       method->GetCodeItem(),
                                       method->GetDexMethodIndex(),
@@ -5398,6 +5407,7 @@ MethodVerifier* MethodVerifier::VerifyMethodAndDump(Thread* self,
       self,
       Runtime::Current()->GetClassLinker(),
       Runtime::Current()->GetArenaPool(),
+      /* shared_arena_stack= */ nullptr,
       dex_file,
       code_item,
       dex_method_idx,
@@ -5439,6 +5449,7 @@ void MethodVerifier::FindLocksAtDexPc(
   impl::MethodVerifier<false> verifier(hs.Self(),
                                        Runtime::Current()->GetClassLinker(),
                                        Runtime::Current()->GetArenaPool(),
+                                       /* shared_arena_stack= */ nullptr,
                                        m->GetDexFile(),
                                        m->GetCodeItem(),
                                        m->GetDexMethodIndex(),
@@ -5478,6 +5489,7 @@ MethodVerifier* MethodVerifier::CreateVerifier(Thread* self,
   return new impl::MethodVerifier<false>(self,
                                          Runtime::Current()->GetClassLinker(),
                                          Runtime::Current()->GetArenaPool(),
+                                         /* shared_arena_stack= */ nullptr,
                                          dex_file,
                                          code_item,
                                          method_idx,
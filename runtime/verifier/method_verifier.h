@@ -213,9 +213,15 @@ class MethodVerifier {
   }
 
  protected:
+  // If `shared_arena_stack` is non-null, all scoped allocations (including the RegTypeCache)
+  // are made on that stack instead of the verifier's own `arena_stack_`. Callers verifying
+  // many methods back-to-back can pass a shared stack so that the arenas acquired from the
+  // pool are retained across verifier instances instead of being released and re-acquired
+  // for every method. The shared stack must outlive the verifier and uses of it must nest.
   MethodVerifier(Thread* self,
                  ClassLinker* class_linker,
                  ArenaPool* arena_pool,
+                 ArenaStack* shared_arena_stack,
                  const DexFile* dex_file,
                  const dex::CodeItem* code_item,
                  uint32_t dex_method_idx,
@@ -249,6 +255,7 @@ class MethodVerifier {
   static FailureData VerifyMethod(Thread* self,
                                   ClassLinker* class_linker,
                                   ArenaPool* arena_pool,
+                                  ArenaStack* shared_arena_stack,
                                   uint32_t method_idx,
                                   const DexFile* dex_file,
                                   Handle<mirror::DexCache> dex_cache,
@@ -271,6 +278,7 @@ class MethodVerifier {
   static FailureData VerifyMethod(Thread* self,
                                   ClassLinker* class_linker,
                                   ArenaPool* arena_pool,
+                                  ArenaStack* shared_arena_stack,
                                   uint32_t method_idx,
                                   const DexFile* dex_file,
                                   Handle<mirror::DexCache> dex_cache,
@@ -314,7 +322,8 @@ class MethodVerifier {
   // The thread we're verifying on.
   Thread* const self_;
 
-  // Arena allocator.
+  // Arena allocator. `arena_stack_` is bypassed (and stays empty) when the verifier was
+  // constructed with a shared arena stack; `allocator_` always points at the stack in use.
   ArenaStack arena_stack_;
   ScopedArenaAllocator allocator_;
 
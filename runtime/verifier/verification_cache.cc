@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "verification_cache.h"
+
+#include <string.h>
+
+#include <memory>
+#include <vector>
+
+#include <android-base/logging.h>
+
+#include "base/os.h"
+#include "base/unix_file/fd_file.h"
+#include "thread-current-inl.h"
+
+namespace art {
+namespace verifier {
+
+VerificationCache::VerificationCache(const std::string& filename)
+    : filename_(filename),
+      lock_("Verification cache lock") {}
+
+bool VerificationCache::Load() {
+  std::unique_ptr<File> file(OS::OpenFileForReading(filename_.c_str()));
+  if (file == nullptr) {
+    // Not an error: the cache is created on the first Save.
+    return false;
+  }
+  const int64_t length = file->GetLength();
+  if (length < static_cast<int64_t>(kHeaderSize) ||
+      (static_cast<size_t>(length) - kHeaderSize) % sizeof(uint64_t) != 0u) {
+    LOG(WARNING) << "Ignoring verification cache with invalid size: " << filename_;
+    return false;
+  }
+  std::vector<uint8_t> data(length);
+  if (!file->ReadFully(data.data(), length)) {
+    PLOG(WARNING) << "Failed to read verification cache: " << filename_;
+    return false;
+  }
+  uint32_t header[2];
+  memcpy(header, data.data(), kHeaderSize);
+  if (header[0] != kMagic || header[1] != kVersion) {
+    LOG(WARNING) << "Ignoring verification cache with unexpected magic or version: " << filename_;
+    return false;
+  }
+  const size_t num_entries = (static_cast<size_t>(length) - kHeaderSize) / sizeof(uint64_t);
+  MutexLock mu(Thread::Current(), lock_);
+  for (size_t i = 0; i != num_entries; ++i) {
+    uint64_t key;
+    memcpy(&key, data.data() + kHeaderSize + i * sizeof(uint64_t), sizeof(uint64_t));
+    verified_classes_.insert(key);
+  }
+  return true;
+}
+
+bool VerificationCache::Save() {
+  std::vector<uint64_t> entries;
+  {
+    MutexLock mu(Thread::Current(), lock_);
+    if (!dirty_) {
+      return true;
+    }
+    entries.assign(verified_classes_.begin(), verified_classes_.end());
+    dirty_ = false;
+  }
+  std::unique_ptr<File> file(OS::CreateEmptyFileWriteOnly(filename_.c_str()));
+  if (file == nullptr) {
+    PLOG(WARNING) << "Failed to open verification cache for writing: " << filename_;
+    return false;
+  }
+  const uint32_t header[2] = { kMagic, kVersion };
+  if (!file->WriteFully(header, sizeof(header)) ||
+      !file->WriteFully(entries.data(), entries.size() * sizeof(uint64_t))) {
+    PLOG(WARNING) << "Failed to write verification cache: " << filename_;
+    file->Erase();
+    return false;
+  }
+  if (file->FlushCloseOrErase() != 0) {
+    PLOG(WARNING) << "Failed to flush verification cache: " << filename_;
+    return false;
+  }
+  return true;
+}
+
+bool VerificationCache::IsVerified(uint32_t dex_checksum, uint32_t class_def_index) {
+  MutexLock mu(Thread::Current(), lock_);
+  return verified_classes_.count(MakeKey(dex_checksum, class_def_index)) != 0u;
+}
+
+void VerificationCache::Add(uint32_t dex_checksum, uint32_t class_def_index) {
+  MutexLock mu(Thread::Current(), lock_);
+  if (verified_classes_.insert(MakeKey(dex_checksum, class_def_index)).second) {
+    dirty_ = true;
+  }
+}
+
+}  // namespace verifier
+}  // namespace art
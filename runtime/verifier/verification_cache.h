@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_VERIFIER_VERIFICATION_CACHE_H_
+#define ART_RUNTIME_VERIFIER_VERIFICATION_CACHE_H_
+
+#include <string>
+#include <unordered_set>
+
+#include "base/macros.h"
+#include "base/mutex.h"
+
+namespace art {
+namespace verifier {
+
+// On-disk cache of successful class verification results, keyed by dex file checksum and class
+// def index. Used to skip re-verifying classes from dex files that do not change between runs
+// but are not AOT compiled (e.g. dynamically delivered code). Only classes that verified with
+// no failures at all are recorded; soft failures must be diagnosed again on every run.
+class VerificationCache {
+ public:
+  explicit VerificationCache(const std::string& filename);
+
+  // Load the cache contents from disk. A missing or corrupt file leaves the cache empty and
+  // returns false; the file is recreated on the next Save.
+  bool Load() REQUIRES(!lock_);
+
+  // Write the cache back to disk if any entries were added since loading.
+  bool Save() REQUIRES(!lock_);
+
+  bool IsVerified(uint32_t dex_checksum, uint32_t class_def_index) REQUIRES(!lock_);
+
+  void Add(uint32_t dex_checksum, uint32_t class_def_index) REQUIRES(!lock_);
+
+ private:
+  static constexpr uint32_t kMagic = 0x66726576;  // 'verf', little endian.
+  static constexpr uint32_t kVersion = 1u;
+  static constexpr size_t kHeaderSize = 2u * sizeof(uint32_t);
+
+  static uint64_t MakeKey(uint32_t dex_checksum, uint32_t class_def_index) {
+    return (static_cast<uint64_t>(dex_checksum) << 32) | class_def_index;
+  }
+
+  const std::string filename_;
+  mutable Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
+  std::unordered_set<uint64_t> verified_classes_ GUARDED_BY(lock_);
+  // Whether entries were added since the last Load or Save.
+  bool dirty_ GUARDED_BY(lock_) = false;
+
+  DISALLOW_COPY_AND_ASSIGN(VerificationCache);
+};
+
+}  // namespace verifier
+}  // namespace art
+
+#endif  // ART_RUNTIME_VERIFIER_VERIFICATION_CACHE_H_
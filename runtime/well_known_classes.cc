@@ -27,6 +27,7 @@
 #include "class_linker.h"
 #include "entrypoints/quick/quick_entrypoints_enum.h"
 #include "entrypoints/runtime_asm_entrypoints.h"
+#include "handle_scope-inl.h"
 #include "hidden_api.h"
 #include "jni/jni_internal.h"
 #include "jni_id_type.h"
@@ -503,6 +504,68 @@ void WellKnownClasses::HandleJniIdTypeChange(JNIEnv* env) {
   WellKnownClasses::LateInit(env);
 }
 
+void WellKnownClasses::EnsureClassesInitialized(Thread* self) {
+  ScopedObjectAccess soa(self);
+  ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+  StackHandleScope<1u> hs(self);
+  MutableHandle<mirror::Class> h_klass = hs.NewHandle<mirror::Class>(nullptr);
+  for (jclass klass : {
+      dalvik_annotation_optimization_CriticalNative,
+      dalvik_annotation_optimization_FastNative,
+      dalvik_system_BaseDexClassLoader,
+      dalvik_system_DelegateLastClassLoader,
+      dalvik_system_DexClassLoader,
+      dalvik_system_DexFile,
+      dalvik_system_DexPathList,
+      dalvik_system_DexPathList__Element,
+      dalvik_system_EmulatedStackFrame,
+      dalvik_system_InMemoryDexClassLoader,
+      dalvik_system_PathClassLoader,
+      dalvik_system_VMRuntime,
+      java_lang_BootClassLoader,
+      java_lang_ClassLoader,
+      java_lang_ClassNotFoundException,
+      java_lang_Daemons,
+      java_lang_Error,
+      java_lang_IllegalAccessError,
+      java_lang_NoClassDefFoundError,
+      java_lang_Object,
+      java_lang_OutOfMemoryError,
+      java_lang_reflect_InvocationTargetException,
+      java_lang_reflect_Parameter,
+      java_lang_reflect_Proxy,
+      java_lang_RuntimeException,
+      java_lang_StackOverflowError,
+      java_lang_String,
+      java_lang_StringFactory,
+      java_lang_System,
+      java_lang_Thread,
+      java_lang_ThreadGroup,
+      java_lang_Throwable,
+      java_nio_ByteBuffer,
+      java_nio_DirectByteBuffer,
+      java_util_Collections,
+      java_util_function_Consumer,
+      libcore_reflect_AnnotationFactory,
+      libcore_reflect_AnnotationMember,
+      libcore_util_EmptyArray,
+      org_apache_harmony_dalvik_ddmc_Chunk,
+      org_apache_harmony_dalvik_ddmc_DdmServer }) {
+    if (klass == nullptr) {
+      continue;  // Init has not run yet.
+    }
+    h_klass.Assign(soa.Decode<mirror::Class>(klass));
+    if (!class_linker->EnsureInitialized(self,
+                                         h_klass,
+                                         /*can_init_fields=*/ true,
+                                         /*can_init_parents=*/ true)) {
+      // Initialization can legitimately fail, e.g. if a class initializer throws.
+      // Leave the class for initialization on first use in the child.
+      self->ClearException();
+    }
+  }
+}
+
 void WellKnownClasses::Clear() {
   dalvik_annotation_optimization_CriticalNative = nullptr;
   dalvik_annotation_optimization_FastNative = nullptr;
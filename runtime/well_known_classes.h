@@ -24,6 +24,7 @@
 namespace art {
 
 class ArtMethod;
+class Thread;
 
 namespace mirror {
 class Class;
@@ -42,6 +43,12 @@ struct WellKnownClasses {
 
   static void HandleJniIdTypeChange(JNIEnv* env);
 
+  // Eagerly initialize the classes cached above. Run in the zygote after preload so
+  // that forked children inherit the initialized state through copy-on-write pages
+  // instead of each running the remaining class initializers on first use. Fast
+  // no-op for classes that are already initialized.
+  static void EnsureClassesInitialized(Thread* self) REQUIRES(!Locks::mutator_lock_);
+
   static void InitStringInit(ObjPtr<mirror::Class> string_class,
                              ObjPtr<mirror::Class> string_builder_class)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -193,6 +193,24 @@ class SignalChain {
     }
   }
 
+  // Return a claimed signal to the user's handler. Called when the last special
+  // handler is removed: delivering straight to the user's handler is cheaper
+  // than interposing (no chain walk and no extra sigprocmask per delivery,
+  // which matters for high-frequency signals like a profiler's SIGPROF), and
+  // a later claim re-registers the chain.
+  void Unclaim(int signo) {
+    claimed_ = false;
+#if defined(__BIONIC__)
+    linked_sigaction64(signo, &action_, nullptr);
+#else
+    linked_sigaction(signo, &action_, nullptr);
+#endif
+  }
+
+  bool HasSpecialHandlers() {
+    return special_handlers_[0].sc_sigaction != nullptr;
+  }
+
   // Register the signal chain with the kernel if needed.
   void Register(int signo) {
 #if defined(__BIONIC__)
@@ -505,6 +523,9 @@ extern "C" void RemoveSpecialSignalHandlerFn(int signal, bool (*fn)(int, siginfo
   }
 
   chains[signal].RemoveSpecialHandler(fn);
+  if (!chains[signal].HasSpecialHandlers()) {
+    chains[signal].Unclaim(signal);
+  }
 }
 
 extern "C" void EnsureFrontOfChain(int signal) {
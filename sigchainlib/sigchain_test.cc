@@ -238,3 +238,30 @@ TEST_F(SigchainTest, EnsureFrontOfChain) {
   ASSERT_EQ(1, called);
   called = 0;
 }
+
+// Removing the last special handler should install the user's handler directly
+// with the kernel again, instead of interposing deliveries forever.
+TEST_F(SigchainTest, RemovingLastSpecialHandlerUnclaims) {
+  static sig_atomic_t called = 0;
+  struct sigaction action = {};
+  action.sa_handler = [](int) { called = 1; };
+  ASSERT_EQ(0, sigaction(SIGPROF, &action, nullptr));
+
+  art::SigchainAction sc_action = {
+      .sc_sigaction = [](int, siginfo_t*, void*) -> bool { return false; },
+      .sc_mask = {},
+      .sc_flags = 0,
+  };
+  art::AddSpecialSignalHandlerFn(SIGPROF, &sc_action);
+  art::RemoveSpecialSignalHandlerFn(SIGPROF, sc_action.sc_sigaction);
+
+  // The query goes straight to the kernel once the signal is no longer claimed,
+  // so this only matches if the user's handler was actually reinstalled.
+  struct sigaction registered = {};
+  ASSERT_EQ(0, sigaction(SIGPROF, nullptr, &registered));
+  ASSERT_EQ(action.sa_handler, registered.sa_handler);
+
+  raise(SIGPROF);
+  ASSERT_EQ(1, called);
+  called = 0;
+}